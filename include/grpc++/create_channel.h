@@ -68,6 +68,26 @@ std::shared_ptr<Channel> CreateCustomChannel(
     const std::shared_ptr<ChannelCredentials>& creds,
     const ChannelArguments& args);
 
+/// Like \a CreateCustomChannel, but consults a process-wide cache first: if a
+/// channel previously created through this function for an equivalent
+/// (target, credentials object, arguments) triple is still alive, it is
+/// returned instead of building a new channel (with its own resolver, load
+/// balancer and connections). Sharing is opt-in precisely because callers of
+/// \a CreateChannel may rely on getting independent connections.
+///
+/// Credentials are compared by object identity, so callers must reuse the
+/// same \a ChannelCredentials instance to share a channel. Channel arguments
+/// are normalized before comparison; pointer-valued arguments are compared by
+/// address.
+///
+/// The cache holds no reference of its own: a cached channel lives exactly as
+/// long as the application holds a returned \a shared_ptr to it, and a new
+/// channel is created once all such references are gone.
+std::shared_ptr<Channel> CreateSharedChannel(
+    const grpc::string& target,
+    const std::shared_ptr<ChannelCredentials>& creds,
+    const ChannelArguments& args);
+
 }  // namespace grpc
 
 #endif  // GRPCXX_CREATE_CHANNEL_H
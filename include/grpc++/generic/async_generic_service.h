@@ -36,6 +36,7 @@
 
 #include <grpc++/support/async_stream.h>
 #include <grpc++/support/byte_buffer.h>
+#include <grpc++/support/string_ref.h>
 
 struct grpc_server;
 
@@ -46,15 +47,35 @@ typedef ServerAsyncReaderWriter<ByteBuffer, ByteBuffer>
 
 class GenericServerContext final : public ServerContext {
  public:
-  const grpc::string& method() const { return method_; }
-  const grpc::string& host() const { return host_; }
+  GenericServerContext() : has_call_details_(false), materialized_(false) {}
+  ~GenericServerContext();
+
+  /// Name of the method being invoked. Materializes (and caches) copies of
+  /// the underlying call details slices on first use; prefer \a method_ref
+  /// where a view suffices.
+  const grpc::string& method() const;
+  const grpc::string& host() const;
+
+  /// Zero-copy views of the method name / host of the call, backed directly
+  /// by the call details slices. Valid for the lifetime of this context.
+  /// Useful for proxies that only inspect prefixes and would otherwise pay a
+  /// string copy per call.
+  string_ref method_ref() const;
+  string_ref host_ref() const;
 
  private:
   friend class Server;
   friend class ServerInterface;
 
-  grpc::string method_;
-  grpc::string host_;
+  /// Takes ownership of one ref on each slice
+  void TakeCallDetails(grpc_slice method, grpc_slice host);
+
+  grpc_slice method_slice_;
+  grpc_slice host_slice_;
+  bool has_call_details_;
+  mutable bool materialized_;
+  mutable grpc::string method_;
+  mutable grpc::string host_;
 };
 
 class AsyncGenericService final {
@@ -59,6 +59,8 @@ template <class W, class R>
 class ClientAsyncReaderWriter;
 template <class R>
 class ClientAsyncResponseReader;
+template <class InputMessage, class OutputMessage>
+class CallbackUnaryCallImpl;
 
 /// Codegen interface for \a grpc::Channel.
 class ChannelInterface {
@@ -116,6 +118,8 @@ class ChannelInterface {
                                   ClientContext* context,
                                   const InputMessage& request,
                                   OutputMessage* result);
+  template <class InputMessage, class OutputMessage>
+  friend class ::grpc::CallbackUnaryCallImpl;
   friend class ::grpc::RpcMethod;
   virtual Call CreateCall(const RpcMethod& method, ClientContext* context,
                           CompletionQueue* cq) = 0;
@@ -53,6 +53,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <grpc++/impl/codegen/config.h>
 #include <grpc++/impl/codegen/core_codegen_interface.h>
@@ -76,6 +77,8 @@ class ChannelInterface;
 class CompletionQueue;
 class CallCredentials;
 class RpcMethod;
+template <class InputMessage, class OutputMessage>
+class CallbackUnaryCallImpl;
 template <class R>
 class ClientReader;
 template <class W>
@@ -164,12 +167,28 @@ class InteropClientContextInspector;
 /// compression options, can be made persistant at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs
+/// without calling \a Reset between them.
 class ClientContext {
  public:
   ClientContext();
   ~ClientContext();
 
+  /// Make this context usable for another rpc, recycling its allocations.
+  ///
+  /// May only be called once any previous rpc on this context has fully
+  /// completed (its final status received, or the call never started); it
+  /// must not race with any other use of the context. Per-call state - the
+  /// bound call, received metadata and auth context - is dropped, with the
+  /// received-metadata arrays keeping their grown storage so a context
+  /// recycled at a steady header count allocates nothing per call.
+  /// Caller configuration (deadline, authority, credentials, wait-for-ready
+  /// and idempotency bits, compression and metadata added with
+  /// \a AddMetadata) is preserved deliberately: a high-rate caller sends
+  /// the same headers on every call. Adjust or clear those explicitly when
+  /// the next call differs.
+  void Reset();
+
   /// Create a new \a ClientContext as a child of an incoming server call,
   /// according to \a options (\see PropagationOptions).
   ///
@@ -383,6 +402,8 @@ class ClientContext {
                                   ClientContext* context,
                                   const InputMessage& request,
                                   OutputMessage* result);
+  template <class InputMessage, class OutputMessage>
+  friend class ::grpc::CallbackUnaryCallImpl;
 
   grpc_call* call() const { return call_; }
   void set_call(grpc_call* call, const std::shared_ptr<Channel>& channel);
@@ -424,6 +445,35 @@ class ClientContext {
   bool initial_metadata_corked_;
 };
 
+/// A free list of reusable \a ClientContext instances for callers that burn
+/// through contexts at high rates. \a Get hands out a context (constructing
+/// one only when the pool is empty) and \a Recycle resets it and returns it
+/// to the pool, so steady-state traffic reuses fully grown contexts instead
+/// of paying construction and teardown per rpc. The pool owns idle contexts
+/// and deletes them with the pool; contexts handed out must be recycled (or
+/// deleted by the caller) before the pool is destroyed. Thread-safe.
+class ClientContextPool {
+ public:
+  ClientContextPool() {}
+  ~ClientContextPool();
+
+  /// Take a context from the pool, or construct one if the pool is empty.
+  ClientContext* Get();
+
+  /// \a ClientContext::Reset \a context and return it to the pool. The
+  /// reuse contract of \a Reset applies: the context's previous rpc must
+  /// have fully completed.
+  void Recycle(ClientContext* context);
+
+ private:
+  // Disallow copy and assign.
+  ClientContextPool(const ClientContextPool&);
+  ClientContextPool& operator=(const ClientContextPool&);
+
+  std::mutex mu_;
+  std::vector<ClientContext*> free_;
+};
+
 }  // namespace grpc
 
 #endif  // GRPCXX_IMPL_CODEGEN_CLIENT_CONTEXT_H
@@ -34,6 +34,9 @@
 #ifndef GRPCXX_IMPL_CODEGEN_CLIENT_UNARY_CALL_H
 #define GRPCXX_IMPL_CODEGEN_CLIENT_UNARY_CALL_H
 
+#include <functional>
+#include <utility>
+
 #include <grpc++/impl/codegen/call.h>
 #include <grpc++/impl/codegen/channel_interface.h>
 #include <grpc++/impl/codegen/config.h>
@@ -82,6 +85,87 @@ Status BlockingUnaryCall(ChannelInterface* channel, const RpcMethod& method,
   return status;
 }
 
+/// Self-owned op set backing \a CallbackUnaryCall. When the batch completes,
+/// FinalizeResult runs the callback right on the thread that is driving the
+/// completion queue and swallows the event (returns false), so no tag ever
+/// reaches the application and no dispatch hop is paid. Deletes itself once
+/// the callback has been extracted.
+template <class InputMessage, class OutputMessage>
+class CallbackUnaryCallImpl
+    : public CallOpSet<CallOpSendInitialMetadata, CallOpSendMessage,
+                       CallOpRecvInitialMetadata,
+                       CallOpRecvMessage<OutputMessage>, CallOpClientSendClose,
+                       CallOpClientRecvStatus> {
+  typedef CallOpSet<CallOpSendInitialMetadata, CallOpSendMessage,
+                    CallOpRecvInitialMetadata, CallOpRecvMessage<OutputMessage>,
+                    CallOpClientSendClose, CallOpClientRecvStatus>
+      OpSet;
+
+ public:
+  static void Start(ChannelInterface* channel, const RpcMethod& method,
+                    ClientContext* context, const InputMessage& request,
+                    OutputMessage* result, CompletionQueue* cq,
+                    std::function<void(Status)> on_done) {
+    CallbackUnaryCallImpl* ops = new CallbackUnaryCallImpl(std::move(on_done));
+    Status status = ops->SendMessage(request);
+    if (!status.ok()) {
+      // Serialization failed: report inline on the caller's thread
+      std::function<void(Status)> cb = std::move(ops->on_done_);
+      delete ops;
+      cb(status);
+      return;
+    }
+    Call call(channel->CreateCall(method, context, cq));
+    ops->SendInitialMetadata(context->send_initial_metadata_,
+                             context->initial_metadata_flags());
+    ops->RecvInitialMetadata(context);
+    ops->RecvMessage(result);
+    ops->ClientSendClose();
+    ops->ClientRecvStatus(context, &ops->status_);
+    call.PerformOps(ops);
+  }
+
+  bool FinalizeResult(void** tag, bool* status) override {
+    OpSet::FinalizeResult(tag, status);
+    if (!this->got_message && status_.ok()) {
+      status_ = Status(StatusCode::UNIMPLEMENTED,
+                       "No message returned for unary request");
+    }
+    std::function<void(Status)> cb = std::move(on_done_);
+    Status call_status = status_;
+    delete this;
+    cb(call_status);
+    return false;
+  }
+
+ private:
+  explicit CallbackUnaryCallImpl(std::function<void(Status)> on_done)
+      : on_done_(std::move(on_done)) {}
+
+  Status status_;
+  std::function<void(Status)> on_done_;
+};
+
+/// Perform a unary call whose completion invokes \a on_done directly on the
+/// thread driving \a cq (via \a Next or \a AsyncNext), rather than surfacing
+/// a tag for the application to dispatch. This elides the reactor hop - and
+/// the context switch it usually implies - on latency-critical paths; when
+/// the operation completes on the thread that is polling \a cq, the core
+/// hands the completion straight back without ever queuing an event.
+///
+/// Some completion queue must still be driven for the call to make progress;
+/// \a cq fills that role exactly as for tag-based async calls. \a on_done
+/// may run on any thread driving \a cq, or on the caller's own thread if the
+/// request cannot be serialized.
+template <class InputMessage, class OutputMessage>
+void CallbackUnaryCall(ChannelInterface* channel, const RpcMethod& method,
+                       ClientContext* context, const InputMessage& request,
+                       OutputMessage* result, CompletionQueue* cq,
+                       std::function<void(Status)> on_done) {
+  CallbackUnaryCallImpl<InputMessage, OutputMessage>::Start(
+      channel, method, context, request, result, cq, std::move(on_done));
+}
+
 }  // namespace grpc
 
 #endif  // GRPCXX_IMPL_CODEGEN_CLIENT_UNARY_CALL_H
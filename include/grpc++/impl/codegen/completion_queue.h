@@ -152,6 +152,35 @@ class CompletionQueue : private GrpcLibraryCodegen {
                                            GPR_CLOCK_REALTIME)) != SHUTDOWN);
   }
 
+  /// A single completed event, as read by \a NextBatch.
+  struct Event {
+    void* tag;  ///< The event's tag, as \a Next would have returned it.
+    bool ok;    ///< The event's outcome, as \a Next would have returned it.
+  };
+
+  /// Read a batch of events from the queue, blocking up to \a deadline (or
+  /// the queue's shutdown) for the first one. Once an event is available, any
+  /// further completions that are already ready are drained into \a events
+  /// without blocking again, amortizing the locking and polling costs of
+  /// \a AsyncNext across all ready events. At most 64 events are read per
+  /// call regardless of \a max_events.
+  ///
+  /// \param events[out] Array with room for at least \a max_events entries.
+  /// \param max_events[in] Maximum number of events to read. Must be > 0.
+  /// \param num_events[out] Upon GOT_EVENT, the number of entries of
+  /// \a events that were filled in.
+  /// \param deadline[in] How long to block in wait for the first event.
+  ///
+  /// \return GOT_EVENT if at least one event was read, otherwise TIMEOUT or
+  /// SHUTDOWN (in which case *num_events is zero).
+  template <typename T>
+  NextStatus NextBatch(Event* events, size_t max_events, size_t* num_events,
+                       const T& deadline) {
+    TimePoint<T> deadline_tp(deadline);
+    return NextBatchInternal(events, max_events, num_events,
+                             deadline_tp.raw_time());
+  }
+
   /// Request the shutdown of the queue.
   ///
   /// \warning This method must be called at some point if this completion queue
@@ -230,6 +259,9 @@ class CompletionQueue : private GrpcLibraryCodegen {
 
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
 
+  NextStatus NextBatchInternal(Event* events, size_t max_events,
+                               size_t* num_events, gpr_timespec deadline);
+
   /// Wraps \a grpc_completion_queue_pluck.
   /// \warning Must not be mixed with calls to \a Next.
   bool Pluck(CompletionQueueTag* tag) {
@@ -55,6 +55,15 @@ class MetadataMap {
     }
   }
 
+  /// Forget received metadata while keeping the grown backing array, so a
+  /// recycled context reaches a steady state where receiving metadata costs
+  /// no allocation. The entries reference call-owned memory and are freed
+  /// with the call; only the array storage is retained here.
+  void Reset() {
+    map_.clear();
+    arr_.count = 0;
+  }
+
   std::multimap<grpc::string_ref, grpc::string_ref> *map() { return &map_; }
   const std::multimap<grpc::string_ref, grpc::string_ref> *map() const {
     return &map_;
@@ -54,6 +54,64 @@ class GrpcBufferWriterPeer;
 
 const int kGrpcBufferWriterMaxBufferLength = 1024 * 1024;
 
+const size_t kGrpcSerializationSlabSize = 8192;
+const size_t kGrpcSerializationSlabPoolMaxSlabs = 32;
+
+// A process-wide freelist of fixed-size serialization slabs.  A serialized
+// message is handed to the transport in a slice whose destroy callback
+// returns the slab here once the last reference is dropped, so steady-state
+// streaming serializes into a few recycled slabs instead of allocating a
+// fresh buffer per message.  The freelist is threaded through the first
+// word of each free slab, so the pool itself allocates nothing.
+class SerializationSlabPool {
+ public:
+  static SerializationSlabPool* instance() {
+    static SerializationSlabPool pool;
+    return &pool;
+  }
+
+  void* Get() {
+    g_core_codegen_interface->gpr_mu_lock(&mu_);
+    void* slab = free_list_;
+    if (slab != nullptr) {
+      free_list_ = *static_cast<void**>(slab);
+      num_free_--;
+    }
+    g_core_codegen_interface->gpr_mu_unlock(&mu_);
+    if (slab == nullptr) {
+      slab = g_core_codegen_interface->gpr_malloc(kGrpcSerializationSlabSize);
+    }
+    return slab;
+  }
+
+  void Return(void* slab) {
+    g_core_codegen_interface->gpr_mu_lock(&mu_);
+    if (num_free_ < kGrpcSerializationSlabPoolMaxSlabs) {
+      *static_cast<void**>(slab) = free_list_;
+      free_list_ = slab;
+      num_free_++;
+      slab = nullptr;
+    }
+    g_core_codegen_interface->gpr_mu_unlock(&mu_);
+    if (slab != nullptr) {
+      g_core_codegen_interface->gpr_free(slab);
+    }
+  }
+
+ private:
+  SerializationSlabPool() : free_list_(nullptr), num_free_(0) {
+    g_core_codegen_interface->gpr_mu_init(&mu_);
+  }
+  gpr_mu mu_;
+  void* free_list_;
+  size_t num_free_;
+};
+
+// Slice destroy callback for slab-backed slices.
+inline void ReturnSerializationSlab(void* slab) {
+  SerializationSlabPool::instance()->Return(slab);
+}
+
 class GrpcBufferWriter : public ::grpc::protobuf::io::ZeroCopyOutputStream {
  public:
   explicit GrpcBufferWriter(grpc_byte_buffer** bp, int block_size)
@@ -133,22 +191,23 @@ class GrpcBufferReader : public ::grpc::protobuf::io::ZeroCopyInputStream {
       return false;
     }
     if (backup_count_ > 0) {
-      *data = GRPC_SLICE_START_PTR(slice_) + GRPC_SLICE_LENGTH(slice_) -
+      *data = GRPC_SLICE_START_PTR(*slice_) + GRPC_SLICE_LENGTH(*slice_) -
               backup_count_;
       GPR_CODEGEN_ASSERT(backup_count_ <= INT_MAX);
       *size = (int)backup_count_;
       backup_count_ = 0;
       return true;
     }
-    if (!g_core_codegen_interface->grpc_byte_buffer_reader_next(&reader_,
+    // Pointing to the internal slice avoids a ref/unref pair per slice read;
+    // the slice stays valid for as long as the byte buffer does.
+    if (!g_core_codegen_interface->grpc_byte_buffer_reader_peek(&reader_,
                                                                 &slice_)) {
       return false;
     }
-    g_core_codegen_interface->grpc_slice_unref(slice_);
-    *data = GRPC_SLICE_START_PTR(slice_);
+    *data = GRPC_SLICE_START_PTR(*slice_);
     // On win x64, int is only 32bit
-    GPR_CODEGEN_ASSERT(GRPC_SLICE_LENGTH(slice_) <= INT_MAX);
-    byte_count_ += * size = (int)GRPC_SLICE_LENGTH(slice_);
+    GPR_CODEGEN_ASSERT(GRPC_SLICE_LENGTH(*slice_) <= INT_MAX);
+    byte_count_ += * size = (int)GRPC_SLICE_LENGTH(*slice_);
     return true;
   }
 
@@ -179,7 +238,7 @@ class GrpcBufferReader : public ::grpc::protobuf::io::ZeroCopyInputStream {
   int64_t byte_count_;
   int64_t backup_count_;
   grpc_byte_buffer_reader reader_;
-  grpc_slice slice_;
+  grpc_slice* slice_;
   Status status_;
 };
 
@@ -191,7 +250,21 @@ Status GenericSerialize(const grpc::protobuf::Message& msg,
       "BufferWriter must be a subclass of io::ZeroCopyOutputStream");
   *own_buffer = true;
   int byte_size = msg.ByteSize();
-  if (byte_size <= internal::kGrpcBufferWriterMaxBufferLength) {
+  if ((size_t)byte_size <= internal::kGrpcSerializationSlabSize) {
+    // Serialize into a recycled slab.  The slice's destroy callback puts
+    // the slab back in the pool when the transport drops its last
+    // reference, so consecutive messages on a stream reuse the same
+    // memory.
+    void* slab = internal::SerializationSlabPool::instance()->Get();
+    GPR_CODEGEN_ASSERT(
+        static_cast<uint8_t*>(slab) + byte_size ==
+        msg.SerializeWithCachedSizesToArray(static_cast<uint8_t*>(slab)));
+    grpc_slice slice = g_core_codegen_interface->grpc_slice_new_with_user_data(
+        slab, (size_t)byte_size, internal::ReturnSerializationSlab, slab);
+    *bp = g_core_codegen_interface->grpc_raw_byte_buffer_create(&slice, 1);
+    g_core_codegen_interface->grpc_slice_unref(slice);
+    return g_core_codegen_interface->ok();
+  } else if (byte_size <= internal::kGrpcBufferWriterMaxBufferLength) {
     grpc_slice slice = g_core_codegen_interface->grpc_slice_malloc(byte_size);
     GPR_CODEGEN_ASSERT(
         GRPC_SLICE_END_PTR(slice) ==
@@ -216,6 +289,24 @@ Status GenericDeserialize(grpc_byte_buffer* buffer,
   if (buffer == nullptr) {
     return Status(StatusCode::INTERNAL, "No payload");
   }
+  if (buffer->type == GRPC_BB_RAW &&
+      buffer->data.raw.compression == GRPC_COMPRESS_NONE &&
+      buffer->data.raw.slice_buffer.count == 1) {
+    // Contiguous uncompressed payload (the common case for small
+    // messages): parse straight out of the slice. The decoder sees the
+    // exact message size up front instead of discovering it chunk by
+    // chunk through the stream interface, and no reader needs to be set
+    // up or torn down.
+    const grpc_slice& slice = buffer->data.raw.slice_buffer.slices[0];
+    GPR_CODEGEN_ASSERT(GRPC_SLICE_LENGTH(slice) <= INT_MAX);
+    Status result = g_core_codegen_interface->ok();
+    if (!msg->ParseFromArray(GRPC_SLICE_START_PTR(slice),
+                             (int)GRPC_SLICE_LENGTH(slice))) {
+      result = Status(StatusCode::INTERNAL, msg->InitializationErrorString());
+    }
+    g_core_codegen_interface->grpc_byte_buffer_destroy(buffer);
+    return result;
+  }
   Status result = g_core_codegen_interface->ok();
   {
     BufferReader reader(buffer);
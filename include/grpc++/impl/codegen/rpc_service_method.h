@@ -34,6 +34,7 @@
 #ifndef GRPCXX_IMPL_CODEGEN_RPC_SERVICE_METHOD_H
 #define GRPCXX_IMPL_CODEGEN_RPC_SERVICE_METHOD_H
 
+#include <atomic>
 #include <climits>
 #include <functional>
 #include <map>
@@ -73,7 +74,10 @@ class RpcServiceMethod : public RpcMethod {
   /// Takes ownership of the handler
   RpcServiceMethod(const char* name, RpcMethod::RpcType type,
                    MethodHandler* handler)
-      : RpcMethod(name, type), server_tag_(nullptr), handler_(handler) {}
+      : RpcMethod(name, type),
+        server_tag_(nullptr),
+        handler_(handler),
+        inline_budget_usec_(0) {}
 
   void set_server_tag(void* tag) { server_tag_ = tag; }
   void* server_tag() const { return server_tag_; }
@@ -82,9 +86,26 @@ class RpcServiceMethod : public RpcMethod {
   void ResetHandler() { handler_.reset(); }
   void SetHandler(MethodHandler* handler) { handler_.reset(handler); }
 
+  /// Declare the (synchronous) handler safe to run inline on the polling
+  /// thread, with a per-call time budget of \a budget_usec microseconds.
+  /// A budget of zero (the default) means the handler is not inline-safe.
+  void SetInlineExecution(int budget_usec) {
+    inline_budget_usec_.store(budget_usec, std::memory_order_relaxed);
+  }
+  /// Inline time budget in microseconds; zero if not inline-safe
+  int inline_budget_usec() const {
+    return inline_budget_usec_.load(std::memory_order_relaxed);
+  }
+  /// Permanently revoke inline execution for this method (called when a
+  /// handler invocation exceeds its declared budget)
+  void DemoteInline() {
+    inline_budget_usec_.store(0, std::memory_order_relaxed);
+  }
+
  private:
   void* server_tag_;
   std::unique_ptr<MethodHandler> handler_;
+  std::atomic<int> inline_budget_usec_;
 };
 
 }  // namespace grpc
@@ -36,6 +36,7 @@
 
 #include <condition_variable>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -110,6 +111,16 @@ class Server final : public ServerInterface, private GrpcLibraryCodegen {
     return health_check_service_.get();
   }
 
+  /// Occupancy snapshot of the dedicated sync execution pool \a pool_name
+  /// (see \a ServerBuilder::AddSyncMethodPool), e.g. for load shedding:
+  /// \a busy_threads is the number of threads currently running handlers,
+  /// \a polling_threads the number polling for new calls, and
+  /// \a max_threads the pool's thread cap (-1 if uncapped). Returns false
+  /// if no such pool was configured.
+  bool GetSyncMethodPoolStats(const grpc::string& pool_name,
+                              int* busy_threads, int* polling_threads,
+                              int* max_threads);
+
  private:
   friend class AsyncGenericService;
   friend class ServerBuilder;
@@ -150,10 +161,20 @@ class Server final : public ServerInterface, private GrpcLibraryCodegen {
   ///
   /// \param sync_cq_timeout_msec The timeout to use when calling AsyncNext() on
   /// server completion queues passed via sync_server_cqs param.
+  ///
+  /// \param sync_max_threads The maximum number of threads (polling plus
+  /// working) per server completion queue (used only in case of sync server).
+  /// -1 means no limit.
+  ///
+  /// \param sync_cpu_sets Per-completion-queue CPU sets: the threads of cq i
+  /// are pinned to sync_cpu_sets[i % sync_cpu_sets.size()]. Empty means
+  /// unbound (used only in case of sync server).
   Server(int max_message_size, ChannelArguments* args,
          std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
              sync_server_cqs,
-         int min_pollers, int max_pollers, int sync_cq_timeout_msec);
+         int min_pollers, int max_pollers, int sync_cq_timeout_msec,
+         int sync_max_threads,
+         const std::vector<std::vector<int>>& sync_cpu_sets);
 
   /// Register a service. This call does not take ownership of the service.
   /// The service must exist for the lifetime of the Server instance.
@@ -211,6 +232,33 @@ class Server final : public ServerInterface, private GrpcLibraryCodegen {
   /// the \a sync_server_cqs)
   std::vector<std::unique_ptr<SyncRequestThreadManager>> sync_req_mgrs_;
 
+  /// Inline-execution time budgets (in microseconds) for sync methods,
+  /// keyed by fully qualified method name. Filled in by \a ServerBuilder
+  /// before services are registered and applied in \a RegisterService
+  std::map<grpc::string, int> sync_method_inline_budgets_;
+
+  /// Create a dedicated execution pool for a group of sync methods, with
+  /// its own (already core-registered) completion queue and thread
+  /// manager. Called by \a ServerBuilder before services are registered
+  void AddSyncMethodPool(const grpc::string& name, int max_threads,
+                         std::unique_ptr<ServerCompletionQueue> cq,
+                         int min_pollers, int max_pollers,
+                         int cq_timeout_msec);
+
+  /// Entries at the front of \a sync_req_mgrs_ serve the shared sync
+  /// completion queues; managers past this boundary belong to dedicated
+  /// method pools and only arm their own methods
+  size_t num_shared_sync_mgrs_;
+
+  /// Completion queues owned by dedicated method pools, and the index of
+  /// each pool's manager within \a sync_req_mgrs_
+  std::vector<std::unique_ptr<ServerCompletionQueue>> sync_pool_cqs_;
+  std::map<grpc::string, size_t> sync_pool_index_;
+
+  /// Pool assignments for sync methods, keyed by fully qualified method
+  /// name. Filled in by \a ServerBuilder before services are registered
+  std::map<grpc::string, grpc::string> sync_method_pools_;
+
   // Sever status
   std::mutex mu_;
   bool started_;
@@ -73,10 +73,11 @@ class ServerBuilder {
 
   /// Options for synchronous servers.
   enum SyncServerOption {
-    NUM_CQS,         ///< Number of completion queues.
-    MIN_POLLERS,     ///< Minimum number of polling threads.
-    MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    NUM_CQS,          ///< Number of completion queues.
+    MIN_POLLERS,      ///< Minimum number of polling threads.
+    MAX_POLLERS,      ///< Maximum number of polling threads.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    MAX_THREADS       ///< Maximum number of threads per completion queue.
   };
 
   /// Register a service. This call does not take ownership of the service.
@@ -138,6 +139,47 @@ class ServerBuilder {
   /// Only useful if this is a Synchronous server.
   ServerBuilder& SetSyncServerOption(SyncServerOption option, int value);
 
+  /// Only useful if this is a Synchronous server. Pins the threads of the
+  /// i-th server completion queue to the CPU ids in
+  /// \a cpu_sets[i % cpu_sets.size()]. On multi-socket machines, handing
+  /// each completion queue a set of CPUs from a single NUMA node keeps
+  /// completion delivery node-local: accepted connections are bound to the
+  /// accepting queue's pollset and request matching prefers that queue, so
+  /// pinning its threads is enough to partition traffic per node. An empty
+  /// vector (the default) leaves all threads unbound; ignored on platforms
+  /// without thread affinity support.
+  ServerBuilder& SetSyncServerCpuSets(
+      const std::vector<std::vector<int>>& cpu_sets);
+
+  /// Only useful if this is a Synchronous server. Declares the handler for
+  /// the fully qualified \a method (e.g. "/pkg.Service/Method") short
+  /// enough to run inline on the polling thread: the server then skips
+  /// resuming or spawning a replacement poller for calls to it, which
+  /// removes a thread handoff from the critical path of sub-100us
+  /// handlers. \a budget_usec is the promised per-call bound in
+  /// microseconds; if a call ever exceeds it the method is permanently
+  /// demoted back to pool execution (with a log line), so a mis-declared
+  /// method degrades to today's behavior rather than stalling polling.
+  /// Only mark handlers that never block on I/O, locks or downstream RPCs.
+  ServerBuilder& SetSyncMethodInlineBudget(const grpc::string& method,
+                                           int budget_usec);
+
+  /// Only useful if this is a Synchronous server. Creates a dedicated
+  /// execution pool named \a pool with its own completion queue and at
+  /// most \a max_threads worker threads (-1 for no cap). Methods assigned
+  /// to the pool via \a SetSyncMethodPool are served exclusively by its
+  /// threads, so a slow method cannot occupy the shared workers and
+  /// starve unrelated methods - and conversely, a saturated shared pool
+  /// cannot delay the pooled method. Pool occupancy is observable via
+  /// \a Server::GetSyncMethodPoolStats for load shedding.
+  ServerBuilder& AddSyncMethodPool(const grpc::string& pool, int max_threads);
+
+  /// Assigns the sync handler for the fully qualified \a method
+  /// (e.g. "/pkg.Service/Method") to the execution pool \a pool, which
+  /// must have been created with \a AddSyncMethodPool.
+  ServerBuilder& SetSyncMethodPool(const grpc::string& method,
+                                   const grpc::string& pool);
+
   /// Add a channel argument (an escape hatch to tuning core library parameters
   /// directly)
   template <class T>
@@ -214,7 +256,8 @@ class ServerBuilder {
         : num_cqs(GPR_MAX(1, gpr_cpu_num_cores())),
           min_pollers(1),
           max_pollers(2),
-          cq_timeout_msec(10000) {}
+          cq_timeout_msec(10000),
+          max_threads(-1) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -229,6 +272,14 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Maximum number of threads (polling plus working) per completion
+    /// queue. -1 means no limit.
+    int max_threads;
+
+    /// Per-completion-queue CPU sets; cq i is pinned to
+    /// cpu_sets[i % cpu_sets.size()]. Empty means unbound.
+    std::vector<std::vector<int>> cpu_sets;
   };
 
   typedef std::unique_ptr<grpc::string> HostString;
@@ -248,6 +299,15 @@ class ServerBuilder {
 
   SyncServerSettings sync_server_settings_;
 
+  /// Inline-execution budgets for sync methods, keyed by fully qualified
+  /// method name; handed to the server before service registration
+  std::map<grpc::string, int> sync_inline_budgets_;
+
+  /// Dedicated sync execution pools (pool name -> thread cap) and the
+  /// method assignments to them (method name -> pool name)
+  std::map<grpc::string, int> sync_pool_threads_;
+  std::map<grpc::string, grpc::string> sync_method_pools_;
+
   /// List of completion queues added via \a AddCompletionQueue method.
   std::vector<ServerCompletionQueue*> cqs_;
 
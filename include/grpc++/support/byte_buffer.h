@@ -38,6 +38,7 @@
 #include <grpc++/support/config.h>
 #include <grpc++/support/slice.h>
 #include <grpc++/support/status.h>
+#include <grpc++/support/string_ref.h>
 #include <grpc/byte_buffer.h>
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
@@ -66,6 +67,36 @@ class ByteBuffer final {
   /// Dump (read) the buffer contents into \a slices.
   Status Dump(std::vector<Slice>* slices) const;
 
+  /// Number of slices backing the buffer. Zero for an empty buffer.
+  size_t SliceCount() const {
+    return buffer_ == nullptr ? 0 : buffer_->data.raw.slice_buffer.count;
+  }
+
+  /// Borrow a view of the bytes of slice \a i (i < SliceCount()). The view
+  /// takes no reference and is valid only while this buffer is alive and
+  /// unmodified. Unlike \a Dump there is no vector allocation or ref
+  /// traffic, so passthrough code can inspect messages for free.
+  string_ref SliceView(size_t i) const {
+    GPR_ASSERT(buffer_ != nullptr && buffer_->type == GRPC_BB_RAW &&
+               i < buffer_->data.raw.slice_buffer.count);
+    const grpc_slice* s = &buffer_->data.raw.slice_buffer.slices[i];
+    return string_ref(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(*s)),
+                      GRPC_SLICE_LENGTH(*s));
+  }
+
+  /// \a SliceView by index syntax.
+  string_ref operator[](size_t i) const { return SliceView(i); }
+
+  /// Contiguous fast path: when the payload is backed by a single slice
+  /// (the common case for small messages), stores a view of the whole
+  /// payload in \a view and returns true. Multi-slice buffers return
+  /// false; iterate \a SliceView or fall back to \a Dump for those.
+  bool TryContiguousView(string_ref* view) const {
+    if (SliceCount() != 1) return false;
+    *view = SliceView(0);
+    return true;
+  }
+
   /// Remove all data.
   void Clear();
 
@@ -34,7 +34,11 @@
 #ifndef GRPCXX_SUPPORT_SLICE_H
 #define GRPCXX_SUPPORT_SLICE_H
 
+#include <grpc++/impl/serialization_traits.h>
 #include <grpc++/support/config.h>
+#include <grpc++/support/status.h>
+#include <grpc/byte_buffer.h>
+#include <grpc/byte_buffer_reader.h>
 #include <grpc/slice.h>
 
 namespace grpc {
@@ -86,6 +90,49 @@ class Slice final {
   grpc_slice slice_;
 };
 
+/// Passthrough serializer for raw slice payloads. A method taking or
+/// returning a \a Slice moves bytes by reference counting only: sending
+/// wraps the slice in a byte buffer without copying, and receiving an
+/// uncompressed single-slice payload (the common case) steals the
+/// transport's slice outright. Useful for proxies that forward payloads
+/// without parsing them.
+template <>
+class SerializationTraits<Slice, void> {
+ public:
+  static Status Serialize(const Slice& source, grpc_byte_buffer** buffer,
+                          bool* own_buffer) {
+    grpc_slice slice = source.c_slice();
+    *buffer = grpc_raw_byte_buffer_create(&slice, 1);
+    grpc_slice_unref(slice);
+    *own_buffer = true;
+    return Status::OK;
+  }
+  static Status Deserialize(grpc_byte_buffer* byte_buffer, Slice* dest) {
+    if (byte_buffer == nullptr) {
+      return Status(StatusCode::INTERNAL, "No payload");
+    }
+    if (byte_buffer->type == GRPC_BB_RAW &&
+        byte_buffer->data.raw.compression == GRPC_COMPRESS_NONE &&
+        byte_buffer->data.raw.slice_buffer.count == 1) {
+      *dest = Slice(byte_buffer->data.raw.slice_buffer.slices[0],
+                    Slice::ADD_REF);
+      grpc_byte_buffer_destroy(byte_buffer);
+      return Status::OK;
+    }
+    // Compressed or fragmented payload: flatten through the reader
+    grpc_byte_buffer_reader reader;
+    if (!grpc_byte_buffer_reader_init(&reader, byte_buffer)) {
+      grpc_byte_buffer_destroy(byte_buffer);
+      return Status(StatusCode::INTERNAL,
+                    "Couldn't initialize byte buffer reader");
+    }
+    *dest = Slice(grpc_byte_buffer_reader_readall(&reader), Slice::STEAL_REF);
+    grpc_byte_buffer_reader_destroy(&reader);
+    grpc_byte_buffer_destroy(byte_buffer);
+    return Status::OK;
+  }
+};
+
 }  // namespace grpc
 
 #endif  // GRPCXX_SUPPORT_SLICE_H
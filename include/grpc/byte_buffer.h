@@ -53,10 +53,26 @@ GRPCAPI grpc_byte_buffer *grpc_raw_byte_buffer_create(grpc_slice *slices,
  * used to generate the data in \a slices.
  *
  * Increases the reference count for all \a slices processed. The user is
- * responsible for invoking grpc_byte_buffer_destroy on the returned instance.*/
+ * responsible for invoking grpc_byte_buffer_destroy on the returned instance.
+ *
+ * Sending such a buffer forwards the payload still-compressed: the message is
+ * framed as compressed and the compression filter does not touch it again.
+ * Proxies can use this together with grpc_byte_buffer_compression to relay a
+ * received message without a decompress/recompress round trip, provided the
+ * outbound call uses the same grpc-encoding; grpc_call_start_batch rejects
+ * the message if the algorithm is disabled on the channel or the peer has
+ * declared it does not accept it. */
 GRPCAPI grpc_byte_buffer *grpc_raw_compressed_byte_buffer_create(
     grpc_slice *slices, size_t nslices, grpc_compression_algorithm compression);
 
+/** Returns the compression algorithm the data in \a bb is compressed with, or
+ * GRPC_COMPRESS_NONE if it is uncompressed. Received messages carry their
+ * wire compression here until the payload is inspected through a reader
+ * (which decompresses), so proxies can test this to forward the compressed
+ * bytes as-is. */
+GRPCAPI grpc_compression_algorithm grpc_byte_buffer_compression(
+    grpc_byte_buffer *bb);
+
 /** Copies input byte buffer \a bb.
  *
  * Increases the reference count of all the source slices. The user is
@@ -87,6 +103,15 @@ GRPCAPI void grpc_byte_buffer_reader_destroy(grpc_byte_buffer_reader *reader);
 GRPCAPI int grpc_byte_buffer_reader_next(grpc_byte_buffer_reader *reader,
                                          grpc_slice *slice);
 
+/** EXPERIMENTAL API - This function may be removed and changed, in the future.
+ *
+ * Updates \a slice with the next piece of data from from \a reader and returns
+ * 1. Returns 0 at the end of the stream. All the slices returned through this
+ * API are owned by the internal byte buffer and copying them results in
+ * undefined behavior. */
+GRPCAPI int grpc_byte_buffer_reader_peek(grpc_byte_buffer_reader *reader,
+                                         grpc_slice **slice);
+
 /** Merge all data from \a reader into single slice */
 GRPCAPI grpc_slice
 grpc_byte_buffer_reader_readall(grpc_byte_buffer_reader *reader);
@@ -41,6 +41,7 @@
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/impl/codegen/propagation_bits.h>
 #include <grpc/slice.h>
+#include <grpc/support/histogram.h>
 #include <grpc/support/time.h>
 #include <stddef.h>
 
@@ -126,6 +127,27 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue *cq,
                                               gpr_timespec deadline,
                                               void *reserved);
 
+/** Like grpc_completion_queue_next, but reads up to max_events events in a
+    single call. Blocks until at least one event is available, the completion
+    queue is being shut down, or deadline is reached; any additional
+    completions that are already ready are then drained into 'events' without
+    blocking or polling again, amortizing the lock and pollset costs of
+    grpc_completion_queue_next across the batch.
+
+    events[0] is filled in exactly as grpc_completion_queue_next would fill
+    its return value (including GRPC_QUEUE_TIMEOUT and GRPC_QUEUE_SHUTDOWN);
+    subsequent slots only ever hold GRPC_OP_COMPLETE events. Returns the
+    number of events written, which is always at least 1. max_events must be
+    at least 1.
+
+    Only usable with completion queues of type GRPC_CQ_NEXT, and subject to
+    the same restriction on mixing with grpc_completion_queue_pluck. */
+GRPCAPI size_t grpc_completion_queue_next_batch(grpc_completion_queue *cq,
+                                                grpc_event *events,
+                                                size_t max_events,
+                                                gpr_timespec deadline,
+                                                void *reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -247,6 +269,25 @@ GRPCAPI grpc_call_error grpc_call_start_batch(grpc_call *call,
                                               const grpc_op *ops, size_t nops,
                                               void *tag, void *reserved);
 
+/** EXPERIMENTAL API - subject to change.
+
+    Create and start many client calls in one library entry: equivalent to
+    grpc_channel_create_call plus grpc_call_start_batch for each entry, with
+    every completion delivered to \a cq, but sharing a single execution
+    context so the deferred work generated by all entries is flushed once
+    per submission rather than once per call. Intended for wide unary
+    fan-outs where fixed per-call entry costs dominate.
+
+    Entries are processed in order, stopping at the first failure, whose
+    error is returned. entries[i].call is set for every entry that was
+    reached and must be destroyed by the caller; as with
+    grpc_call_start_batch, a completion is delivered against an entry's tag
+    only if its batch was accepted - for a failed entry (and any entry after
+    it) no event will arrive. */
+GRPCAPI grpc_call_error grpc_start_scatter_calls(
+    grpc_completion_queue *cq, grpc_scatter_call_entry *entries,
+    size_t num_entries, void *reserved);
+
 /** Returns a newly allocated string representing the endpoint to which this
     call is communicating with. The string is in the uri format accepted by
     grpc_channel_create.
@@ -424,6 +465,61 @@ GRPCAPI void grpc_server_destroy(grpc_server *server);
     thread-safety issues raised by it should not be of concern. */
 GRPCAPI int grpc_tracer_set_enabled(const char *name, int enabled);
 
+/** Number of event counters maintained by the always-on stats subsystem. */
+GRPCAPI size_t grpc_stats_counter_count(void);
+
+/** Returns the name of event counter \a which (< grpc_stats_counter_count()),
+    or NULL if \a which is out of range. */
+GRPCAPI const char *grpc_stats_counter_name(size_t which);
+
+/** Collects the current value of every event counter into \a counters, which
+    must have room for grpc_stats_counter_count() elements. Counters are
+    monotonic over the life of the process; values are summed across cpus at
+    collection time and may lag concurrent increments slightly. */
+GRPCAPI void grpc_stats_collect(uint64_t *counters);
+
+/** A point-in-time view of one transport's state, published periodically by
+    the transport itself and readable without perturbing the data path. */
+typedef struct grpc_transport_snapshot {
+  int is_client;
+  /** number of streams currently open on the transport */
+  uint32_t stream_count;
+  /** transport-level flow control windows, in bytes */
+  int64_t outgoing_window;
+  int64_t incoming_window;
+  /** 0 idle, non-zero writing (see grpc_chttp2_write_state) */
+  int write_state;
+  /** see grpc_chttp2_keepalive_state */
+  int keepalive_state;
+} grpc_transport_snapshot;
+
+/** Number of transports currently registered for introspection. */
+GRPCAPI size_t grpc_transport_snapshot_count(void);
+
+/** Copies up to \a max_snapshots transport snapshots into \a snapshots and
+    returns how many were written. Snapshots may lag the live transport
+    slightly; collection never blocks transport progress. */
+GRPCAPI size_t grpc_transport_snapshots_collect(
+    grpc_transport_snapshot *snapshots, size_t max_snapshots);
+
+/** Blocked-time attribution for one transport's flow-control stalls: how
+    long streams spent unable to write because the connection-level window
+    was exhausted (stalled_by_transport) versus their own stream window
+    (stalled_by_stream). */
+typedef struct grpc_transport_stall_report {
+  int is_client;
+  /** histograms of per-stall blocked time, in microseconds; owned by the
+      caller, destroy each with gpr_histogram_destroy */
+  gpr_histogram *stalled_by_transport;
+  gpr_histogram *stalled_by_stream;
+} grpc_transport_stall_report;
+
+/** Copies blocked-time reports for up to \a max_reports transports into
+    \a reports and returns how many were written. Allocates the histograms
+    in each written report; collection never blocks transport progress. */
+GRPCAPI size_t grpc_transport_stall_reports_collect(
+    grpc_transport_stall_report *reports, size_t max_reports);
+
 /** Check whether a metadata key is legal (will be accepted by core) */
 GRPCAPI int grpc_header_key_is_legal(grpc_slice slice);
 
@@ -97,4 +97,15 @@
 gpr_atm gpr_atm_no_barrier_clamped_add(gpr_atm *value, gpr_atm delta,
                                        gpr_atm min, gpr_atm max);
 
+/** A gpr_atm that owns its cachelines outright: the padding on both sides
+    guarantees that no neighboring field shares a line with the counter, no
+    matter how the containing struct is allocated. Use for heavily contended
+    counters where false sharing measurably hurts; everything else should
+    stay a plain gpr_atm. */
+typedef struct gpr_atm_padded {
+  char pad_before[GPR_CACHELINE_SIZE];
+  gpr_atm counter;
+  char pad_after[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+} gpr_atm_padded;
+
 #endif /* GRPC_IMPL_CODEGEN_ATM_H */
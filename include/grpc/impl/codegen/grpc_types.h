@@ -159,6 +159,16 @@ typedef struct {
 /** Maximum number of concurrent incoming streams to allow on a http2
     connection. Int valued. */
 #define GRPC_ARG_MAX_CONCURRENT_STREAMS "grpc.max_concurrent_streams"
+/** If non-zero, adapt the MAX_CONCURRENT_STREAMS limit a server connection
+    advertises to observed load, so that overload pushes back on clients as
+    stream-admission control instead of deepening in-process queues. The
+    value is the ceiling: the server halves the advertised limit whenever an
+    incoming call has to queue waiting for an application request slot, and
+    raises it again one step at a time while calls are matched immediately.
+    Int valued; 0 (the default) keeps the static advertisement. Server side
+    only. */
+#define GRPC_ARG_ADAPTIVE_MAX_CONCURRENT_STREAMS \
+  "grpc.experimental.adaptive_max_concurrent_streams"
 /** Maximum message length that the channel can receive. Int valued, bytes.
     -1 means unlimited. */
 #define GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH "grpc.max_receive_message_length"
@@ -177,6 +187,16 @@ typedef struct {
 /** Grace period after the chennel reaches its max age. Int valued,
    milliseconds. INT_MAX means unlimited. */
 #define GRPC_ARG_MAX_CONNECTION_AGE_GRACE_MS "grpc.max_connection_age_grace_ms"
+/** Maximum number of concurrent pending (not yet completed) handshakes a
+    server will allow before dropping new connections at accept time. Int
+    valued, defaults to 1024. */
+#define GRPC_ARG_MAX_PENDING_HANDSHAKES "grpc.max_pending_handshakes"
+/** Number of connections whose shutdown ops (GOAWAY or disconnect) are
+    issued per flush when a server broadcasts shutdown to its channels.
+    Smaller values spread the drain of a busy server over more iterations.
+    Int valued, defaults to 256. */
+#define GRPC_ARG_SERVER_SHUTDOWN_DRAIN_BATCH_SIZE \
+  "grpc.server_shutdown_drain_batch_size"
 /** Enable/disable support for per-message compression. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0. */
 #define GRPC_ARG_ENABLE_PER_MESSAGE_COMPRESSION "grpc.per_message_compression"
@@ -267,10 +287,24 @@ typedef struct {
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, assign accepted connections to the pollset keyed by the CPU
+    the accepting thread is running on, instead of round-robin. Together with
+    GRPC_ARG_ALLOW_REUSEPORT (which clones one listener per pollset, letting
+    the kernel steer accepts to a local poller) this keeps a connection's
+    polling on the socket/node that accepted it. */
+#define GRPC_ARG_SERVER_CPU_POLLSET_AFFINITY \
+  "grpc.experimental.server_cpu_pollset_affinity"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
 #define GRPC_ARG_RESOURCE_QUOTA "grpc.resource_quota"
+/** A pointer to a grpc_slice_allocator_plugin supplying the slices that
+    endpoint reads land in, so incoming message payloads are written directly
+    into application-owned pooled memory and handed back through
+    grpc_byte_buffer without a copy (use grpc_slice_allocator_plugin_arg() to
+    construct the arg). */
+#define GRPC_ARG_READ_SLICE_ALLOCATOR \
+  "grpc.experimental.read_slice_allocator"
 /** If non-zero, expand wildcard addresses to a list of local addresses. */
 #define GRPC_ARG_EXPAND_WILDCARD_ADDRS "grpc.expand_wildcard_addrs"
 /** Service config data in JSON form. Not intended for use outside of tests. */
@@ -296,6 +330,76 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/** Channel arg (bool) to read into a ring of fixed-size slab slices (of
+    GRPC_ARG_TCP_READ_CHUNK_SIZE bytes each) with a single scatter recvmsg,
+    recycling untouched slabs across reads, instead of allocating one
+    variable-size slice per read. */
+#define GRPC_ARG_TCP_POOLED_READ_SLABS "grpc.experimental.tcp_pooled_read_slabs"
+/** Channel arg (bool): if non-zero, assemble each received message into a
+    single contiguous slice (one sequential copy) instead of leaving it as the
+    chain of transport-sized slices it arrived in. Helps deserialize-heavy
+    services whose parsers walk message bytes many times. */
+#define GRPC_ARG_CONTIGUOUS_RECV_MESSAGES \
+  "grpc.experimental.contiguous_recv_messages"
+/** Channel arg (integer): number of messages the call layer may read and
+    buffer ahead of application demand on each call. Hides the
+    ask-then-deliver round trip between successive application reads on a
+    stream, and returns transport flow-control credit as soon as a message's
+    bytes arrive instead of when the application asks for them. 0 (the
+    default) disables read-ahead. Buffered messages cost memory: size this
+    against expected message sizes. */
+#define GRPC_ARG_RECV_MESSAGE_PREFETCH \
+  "grpc.experimental.recv_message_prefetch"
+/** Channel arg (bool) to enable zero-copy TCP sends (Linux MSG_ZEROCOPY) for
+    large writes. Has no effect on platforms or kernels without MSG_ZEROCOPY
+    support. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_tx_zerocopy_enabled"
+/** Channel arg (integer) setting the smallest write (in bytes) that goes down
+    the zero-copy path when GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED is set; smaller
+    writes still use the copying path since page pinning costs more than the
+    copy for them. */
+#define GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_tx_zerocopy_send_bytes_threshold"
+/** Channel arg (integer): if non-zero, set TCP_NOTSENT_LOWAT on the socket to
+    this many bytes and cap each write burst to roughly the same amount. Keeps
+    the kernel send buffer shallow so the transport picks which frames to send
+    with fresh priority information instead of behind megabytes of queued
+    bytes. Ignored on platforms without TCP_NOTSENT_LOWAT. */
+#define GRPC_ARG_TCP_NOTSENT_LOWAT "grpc.experimental.tcp_notsent_lowat"
+/** Channel arg (integer, seconds): if non-zero, arm kernel TCP keepalive on
+    the connection's socket: SO_KEEPALIVE with TCP_KEEPIDLE set to this many
+    seconds of idleness before probing begins. While kernel liveness is armed
+    the transport skips HTTP/2 keepalive pings (unless
+    GRPC_ARG_KEEPALIVE_TIME_MS is set explicitly), so dead-peer detection
+    costs no process wakeups. Intended for trusted intra-datacenter links. */
+#define GRPC_ARG_TCP_KEEPALIVE_TIME_S "grpc.experimental.tcp_keepalive_time"
+/** Channel arg (integer, seconds): interval between kernel keepalive probes
+    (TCP_KEEPINTVL); 0 or unset keeps the kernel default. */
+#define GRPC_ARG_TCP_KEEPALIVE_INTERVAL_S \
+  "grpc.experimental.tcp_keepalive_interval"
+/** Channel arg (integer): unanswered kernel keepalive probes before the
+    connection is dropped (TCP_KEEPCNT); 0 or unset keeps the kernel
+    default. */
+#define GRPC_ARG_TCP_KEEPALIVE_PROBES "grpc.experimental.tcp_keepalive_probes"
+/** Channel arg (integer, milliseconds): how long transmitted data may stay
+    unacknowledged before the kernel closes the connection
+    (TCP_USER_TIMEOUT); 0 or unset keeps the kernel default. */
+#define GRPC_ARG_TCP_USER_TIMEOUT_MS "grpc.experimental.tcp_user_timeout_ms"
+/** If non-zero, poll this connection's socket ahead of ordinary sockets on
+    every polling iteration. A hint: honored only by event engines that
+    implement a priority tier (currently epoll1 on Linux). Intended for a
+    small number of latency-critical connections; marking many connections
+    high-priority makes the tier meaningless. */
+#define GRPC_ARG_TCP_PRIORITY_POLLING "grpc.experimental.tcp_priority_polling"
+/** Channel arg (integer, microseconds): if non-zero, spend up to this long
+    busy-polling for this connection's traffic before blocking. Sets
+    SO_BUSY_POLL on the socket (best-effort: needs CAP_NET_ADMIN on most
+    kernels, failure is logged and ignored) and additionally lets event
+    engines that support it spin before blocking in the poller (currently
+    epoll1 on Linux). Trades a core's worth of CPU for wakeup latency:
+    intended for dedicated ultra-low-latency deployments only. */
+#define GRPC_ARG_TCP_BUSY_POLL_US "grpc.experimental.tcp_busy_poll_us"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_timeout_ms"
@@ -551,6 +655,29 @@ typedef struct grpc_op {
   } data;
 } grpc_op;
 
+/** One entry of a scatter-call submission: see grpc_start_scatter_calls. */
+typedef struct grpc_scatter_call_entry {
+  /** Channel to create the call on */
+  grpc_channel *channel;
+  /** Optional parent (server) call to propagate properties from, under
+      \a propagation_mask: as in grpc_channel_create_call */
+  grpc_call *parent_call;
+  uint32_t propagation_mask;
+  /** Method to call, with optional host override; both need only live
+      through the submission */
+  grpc_slice method;
+  const grpc_slice *host;
+  gpr_timespec deadline;
+  /** Batch to start on the newly created call, completing against
+      \a tag: as in grpc_call_start_batch */
+  const grpc_op *ops;
+  size_t num_ops;
+  void *tag;
+  /** Output: the created call, owned by the caller; NULL for entries never
+      reached because an earlier entry failed */
+  grpc_call *call;
+} grpc_scatter_call_entry;
+
 /** Information requested from the channel. */
 typedef struct {
   /** If non-NULL, will be set to point to a string indicating the LB
@@ -341,6 +341,13 @@ typedef unsigned __int64 uint64_t;
 
 #define GPR_CACHELINE_SIZE (1 << GPR_CACHELINE_SIZE_LOG)
 
+/* Annotation convention for false-sharing-prone structs: place a
+   GPR_CACHELINE_PAD member on either side of fields written from multiple
+   threads. A full line of padding on each side keeps the field off every
+   other field's cacheline regardless of how the containing struct is
+   allocated or aligned. \a n keeps member names unique within a struct. */
+#define GPR_CACHELINE_PAD(n) char cacheline_pad_##n[GPR_CACHELINE_SIZE]
+
 /* scrub GCC_ATOMIC if it's not available on this compiler */
 #if defined(GPR_GCC_ATOMIC) && !defined(__ATOMIC_RELAXED)
 #undef GPR_GCC_ATOMIC
@@ -34,6 +34,7 @@
 #ifndef GRPC_SUPPORT_AVL_H
 #define GRPC_SUPPORT_AVL_H
 
+#include <grpc/support/atm.h>
 #include <grpc/support/sync.h>
 
 /** internal node of an AVL tree */
@@ -94,4 +95,59 @@ GPRAPI int gpr_avl_maybe_get(gpr_avl avl, void *key, void **value);
 /** Return 1 if avl is empty, 0 otherwise */
 GPRAPI int gpr_avl_is_empty(gpr_avl avl);
 
+/** A read-optimized ordered map for read-mostly registries: lookups binary
+    search a flat sorted array (one contiguous allocation, no pointer
+    chasing), and mutations build a fresh array that is swapped in atomically.
+    Readers announce themselves on an epoch counter; a mutator retires the
+    previous array only once every reader that could see it has left, so gets
+    take no lock and never block behind a mutation.
+
+    Uses the same vtable as gpr_avl. Gets may run concurrently from any
+    thread; mutations are thread compatible (callers serialize them, as the
+    current gpr_avl registry users already do). */
+
+typedef struct gpr_flatmap_entry {
+  void *key;
+  void *value;
+} gpr_flatmap_entry;
+
+typedef struct gpr_flatmap_snapshot {
+  size_t count;
+  gpr_flatmap_entry entries[1]; /* actually [count]; allocated inline */
+} gpr_flatmap_snapshot;
+
+typedef struct gpr_flatmap {
+  const gpr_avl_vtable *vtable;
+  gpr_atm snapshot; /* gpr_flatmap_snapshot*, swapped with release */
+  gpr_atm epoch;
+  gpr_atm readers[2]; /* in-flight readers per epoch parity */
+} gpr_flatmap;
+
+/** A batch of mutations applied with a single snapshot rebuild and swap */
+typedef struct gpr_flatmap_batch {
+  gpr_flatmap *map;
+  gpr_flatmap_entry *entries;
+  size_t count;
+  size_t capacity;
+} gpr_flatmap_batch;
+
+GPRAPI void gpr_flatmap_init(gpr_flatmap *map, const gpr_avl_vtable *vtable);
+/** Destroy map; no gets or mutations may be in flight */
+GPRAPI void gpr_flatmap_destroy(gpr_flatmap *map);
+/** Lookup key; returns a vtable-copied value (caller owns the copy), or NULL
+    if not found. Lock free; safe against concurrent mutation */
+GPRAPI void *gpr_flatmap_get(gpr_flatmap *map, void *key);
+/** Add (key, value), replacing any existing entry; takes ownership of both */
+GPRAPI void gpr_flatmap_add(gpr_flatmap *map, void *key, void *value);
+/** Remove key if present; key is a needle only and is not consumed */
+GPRAPI void gpr_flatmap_remove(gpr_flatmap *map, void *key);
+
+/** Begin a mutation batch: further adds/removes apply to a private copy and
+    become visible (and pay the array rebuild) once, at commit */
+GPRAPI void gpr_flatmap_batch_begin(gpr_flatmap *map, gpr_flatmap_batch *batch);
+GPRAPI void gpr_flatmap_batch_add(gpr_flatmap_batch *batch, void *key,
+                                  void *value);
+GPRAPI void gpr_flatmap_batch_remove(gpr_flatmap_batch *batch, void *key);
+GPRAPI void gpr_flatmap_batch_commit(gpr_flatmap_batch *batch);
+
 #endif /* GRPC_SUPPORT_AVL_H */
@@ -72,6 +72,25 @@ GPRAPI void gpr_histogram_merge_contents(gpr_histogram *histogram,
                                          double max_seen, double sum,
                                          double sum_of_squares, double count);
 
+/** A histogram safe for concurrent recording from many threads: values land
+   in one of several cacheline-separated stripes (selected by current cpu),
+   so recorders rarely touch the same memory. Bucketing is identical to
+   gpr_histogram. Reading requires merging a snapshot into a plain
+   gpr_histogram via gpr_histogram_striped_snapshot. */
+typedef struct gpr_histogram_striped gpr_histogram_striped;
+
+GPRAPI gpr_histogram_striped *gpr_histogram_striped_create(
+    double resolution, double max_bucket_start);
+GPRAPI void gpr_histogram_striped_destroy(gpr_histogram_striped *h);
+GPRAPI void gpr_histogram_striped_add(gpr_histogram_striped *h, double x);
+
+/** Merges the current contents of \a h into \a dst, which must have been
+   created with the same resolution and max_bucket_start. May run
+   concurrently with gpr_histogram_striped_add. Returns 0 on shape mismatch,
+   1 on success. */
+GPRAPI int gpr_histogram_striped_snapshot(gpr_histogram_striped *h,
+                                          gpr_histogram *dst);
+
 #ifdef __cplusplus
 }
 #endif
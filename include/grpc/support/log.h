@@ -98,6 +98,17 @@ typedef struct {
 typedef void (*gpr_log_func)(gpr_log_func_args *args);
 GPRAPI void gpr_set_log_function(gpr_log_func func);
 
+/** Asynchronous logging: when enabled, gpr_log calls enqueue the formatted
+   message and return immediately; a background thread performs the actual
+   write. Each log site (file:line) is token-bucket rate limited and the
+   queue is bounded, so a log storm cannot stall the calling thread on the
+   write syscall - excess messages are counted and reported, not written.
+   Must be enabled/disabled while no other thread is logging. */
+GPRAPI void gpr_log_async_init(void);
+GPRAPI void gpr_log_async_shutdown(void);
+/** Number of messages dropped so far by rate limiting or queue overflow */
+GPRAPI size_t gpr_log_async_messages_dropped(void);
+
 /** abort() the process if x is zero, having written a line to the log.
 
    Intended for internal invariants.  If the error can be recovered from,
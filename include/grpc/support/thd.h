@@ -77,6 +77,12 @@ GPRAPI int gpr_thd_options_is_detached(const gpr_thd_options *options);
 /** Returns non-zero if the option joinable is set. */
 GPRAPI int gpr_thd_options_is_joinable(const gpr_thd_options *options);
 
+/** Bind the calling thread to the given set of CPU ids (e.g. to keep all of
+   a completion queue's threads on one NUMA node). Returns non-zero on
+   success. On platforms without thread affinity support this is a no-op
+   that returns 0, leaving the thread unbound. */
+GPRAPI int gpr_thd_bind_cpus(const int *cpus, size_t ncpus);
+
 /** Returns the identifier of the current thread. */
 GPRAPI gpr_thd_id gpr_thd_currentid(void);
 
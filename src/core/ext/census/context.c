@@ -35,6 +35,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/useful.h>
 #include <stdbool.h>
 #include <string.h>
@@ -108,6 +109,45 @@ struct raw_tag {
 #define CENSUS_TAG_DELETED CENSUS_TAG_RESERVED
 #define CENSUS_TAG_IS_DELETED(flags) (flags & CENSUS_TAG_DELETED)
 
+// Key/value memory blocks are refcounted so that copying a tag set - the
+// common case when propagating an unchanged context to a child call - shares
+// the block copy-on-write instead of duplicating it. The refcount lives just
+// in front of the bytes kvm points at.
+struct kvm_block {
+  gpr_refcount refs;
+};
+
+static char *kvm_alloc(size_t size) {
+  struct kvm_block *block = gpr_malloc(sizeof(struct kvm_block) + size);
+  gpr_ref_init(&block->refs, 1);
+  return (char *)(block + 1);
+}
+
+static char *kvm_ref(char *kvm) {
+  if (kvm != NULL) gpr_ref(&(((struct kvm_block *)kvm) - 1)->refs);
+  return kvm;
+}
+
+static void kvm_unref(char *kvm) {
+  if (kvm == NULL) return;
+  struct kvm_block *block = ((struct kvm_block *)kvm) - 1;
+  if (gpr_unref(&block->refs)) gpr_free(block);
+}
+
+static bool kvm_is_shared(char *kvm) {
+  return kvm != NULL &&
+         !gpr_ref_is_unique(&(((struct kvm_block *)kvm) - 1)->refs);
+}
+
+// Ensure tags->kvm is exclusively owned before it is mutated.
+static void tag_set_make_unique(struct tag_set *tags) {
+  if (!kvm_is_shared(tags->kvm)) return;
+  char *fresh = kvm_alloc(tags->kvm_size);
+  memcpy(fresh, tags->kvm, tags->kvm_used);
+  kvm_unref(tags->kvm);
+  tags->kvm = fresh;
+}
+
 // Primary representation of a context. Composed of 2 underlying tag_set
 // structs, one each for propagated and local (non-propagated) tags. This is
 // to efficiently support tag encoding/decoding.
@@ -115,8 +155,16 @@ struct raw_tag {
 struct census_context {
   struct tag_set tags[2];
   census_context_status status;
+  // Wire encoding of the propagated tags, precomputed at creation time (the
+  // context is immutable afterwards) so propagating to a child call is a
+  // plain copy in census_context_encode.
+  char *encoded;
+  size_t encoded_size;
 };
 
+// Builds context->encoded; defined next to the encoding functions below.
+static void context_cache_encoding(census_context *context);
+
 // Indices into the tags member of census_context
 #define PROPAGATED_TAGS 0
 #define LOCAL_TAGS 1
@@ -153,11 +201,11 @@ static char *decode_tag(struct raw_tag *tag, char *header, int offset) {
   return header + tag->value_len;
 }
 
-// Make a copy (in 'to') of an existing tag_set.
+// Make a copy (in 'to') of an existing tag_set. The key/value memory is
+// shared copy-on-write rather than duplicated.
 static void tag_set_copy(struct tag_set *to, const struct tag_set *from) {
   memcpy(to, from, sizeof(struct tag_set));
-  to->kvm = gpr_malloc(to->kvm_size);
-  memcpy(to->kvm, from->kvm, from->kvm_used);
+  kvm_ref(to->kvm);
 }
 
 // Delete a tag from a tag_set, if it exists (returns true if it did).
@@ -170,6 +218,11 @@ static bool tag_set_delete_tag(struct tag_set *tags, const char *key,
     kvp = decode_tag(&tag, kvp, 0);
     if (CENSUS_TAG_IS_DELETED(tag.flags)) continue;
     if ((key_len == tag.key_len) && (memcmp(key, tag.key, key_len) == 0)) {
+      if (kvm_is_shared(tags->kvm)) {
+        ptrdiff_t flag_offset = (char *)flags - tags->kvm;
+        tag_set_make_unique(tags);
+        flags = (uint8_t *)(tags->kvm + flag_offset);
+      }
       *flags |= CENSUS_TAG_DELETED;
       tags->ntags--;
       return true;
@@ -199,10 +252,12 @@ static bool tag_set_add_tag(struct tag_set *tags, const census_tag *tag,
   if (tags->kvm_used + tag_size > tags->kvm_size) {
     // allocate new memory if needed
     tags->kvm_size += 2 * CENSUS_MAX_TAG_KV_LEN + TAG_HEADER_SIZE;
-    char *new_kvm = gpr_malloc(tags->kvm_size);
+    char *new_kvm = kvm_alloc(tags->kvm_size);
     if (tags->kvm_used > 0) memcpy(new_kvm, tags->kvm, tags->kvm_used);
-    gpr_free(tags->kvm);
+    kvm_unref(tags->kvm);
     tags->kvm = new_kvm;
+  } else {
+    tag_set_make_unique(tags);
   }
   char *kvp = tags->kvm + tags->kvm_used;
   *kvp++ = (char)key_len;
@@ -254,6 +309,7 @@ static void context_modify_tag(census_context *context, const census_tag *tag,
 //    appropriate amount.
 static void tag_set_flatten(struct tag_set *tags) {
   if (tags->ntags == tags->ntags_alloc) return;
+  tag_set_make_unique(tags);
   bool found_deleted = false;  // found a deleted tag.
   char *kvp = tags->kvm;
   char *dbase = NULL;  // record location of deleted tag
@@ -298,6 +354,8 @@ census_context *census_context_create(const census_context *base,
     tag_set_copy(&context->tags[PROPAGATED_TAGS], &base->tags[PROPAGATED_TAGS]);
     tag_set_copy(&context->tags[LOCAL_TAGS], &base->tags[LOCAL_TAGS]);
     memset(&context->status, 0, sizeof(context->status));
+    context->encoded = NULL;
+    context->encoded_size = 0;
   }
   // Walk over the additional tags and, for those that aren't invalid, modify
   // the context to add/replace/delete as required.
@@ -327,6 +385,7 @@ census_context *census_context_create(const census_context *base,
   tag_set_flatten(&context->tags[LOCAL_TAGS]);
   context->status.n_propagated_tags = context->tags[PROPAGATED_TAGS].ntags;
   context->status.n_local_tags = context->tags[LOCAL_TAGS].ntags;
+  context_cache_encoding(context);
   if (status) {
     *status = &context->status;
   }
@@ -339,8 +398,9 @@ const census_context_status *census_context_get_status(
 }
 
 void census_context_destroy(census_context *context) {
-  gpr_free(context->tags[PROPAGATED_TAGS].kvm);
-  gpr_free(context->tags[LOCAL_TAGS].kvm);
+  kvm_unref(context->tags[PROPAGATED_TAGS].kvm);
+  kvm_unref(context->tags[LOCAL_TAGS].kvm);
+  gpr_free(context->encoded);
   gpr_free(context);
 }
 
@@ -448,9 +508,22 @@ static size_t tag_set_encode(const struct tag_set *tags, char *buffer,
   return ENCODED_HEADER_SIZE + tags->kvm_used;
 }
 
+static void context_cache_encoding(census_context *context) {
+  const struct tag_set *tags = &context->tags[PROPAGATED_TAGS];
+  context->encoded_size =
+      ENCODED_HEADER_SIZE + (tags->ntags == 0 ? 0 : tags->kvm_used);
+  context->encoded = gpr_malloc(context->encoded_size);
+  GPR_ASSERT(tag_set_encode(tags, context->encoded, context->encoded_size) ==
+             context->encoded_size);
+}
+
 size_t census_context_encode(const census_context *context, char *buffer,
                              size_t buf_size) {
-  return tag_set_encode(&context->tags[PROPAGATED_TAGS], buffer, buf_size);
+  if (buf_size < context->encoded_size) {
+    return 0;
+  }
+  memcpy(buffer, context->encoded, context->encoded_size);
+  return context->encoded_size;
 }
 
 // Decode a tag set.
@@ -474,7 +547,7 @@ static void tag_set_decode(struct tag_set *tags, const char *buffer,
   }
   tags->kvm_used = size - header_size;
   tags->kvm_size = tags->kvm_used + CENSUS_MAX_TAG_KV_LEN;
-  tags->kvm = gpr_malloc(tags->kvm_size);
+  tags->kvm = kvm_alloc(tags->kvm_size);
   if (tag_header_size != TAG_HEADER_SIZE) {
     // something new in the tag information. I don't understand it, so
     // don't copy it over.
@@ -505,5 +578,6 @@ census_context *census_context_decode(const char *buffer, size_t size) {
   }
   memset(&context->status, 0, sizeof(context->status));
   context->status.n_propagated_tags = context->tags[PROPAGATED_TAGS].ntags;
+  context_cache_encoding(context);
   return context;
 }
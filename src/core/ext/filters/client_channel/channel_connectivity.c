@@ -201,7 +201,7 @@ static void watcher_timer_init(grpc_exec_ctx *exec_ctx, void *arg,
 
   grpc_timer_init(exec_ctx, &wa->w->alarm,
                   gpr_convert_clock_type(wa->deadline, GPR_CLOCK_MONOTONIC),
-                  &wa->w->on_timeout, gpr_now(GPR_CLOCK_MONOTONIC));
+                  &wa->w->on_timeout, grpc_exec_ctx_now(exec_ctx));
   gpr_free(wa);
 }
 
@@ -57,6 +57,7 @@
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/murmur_hash.h"
 #include "src/core/lib/support/string.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -167,6 +168,182 @@ static void *method_parameters_create_from_json(const grpc_json *json) {
   return value;
 }
 
+/*************************************************************************
+ * SERVICE CONFIG MEMOIZATION
+ */
+
+typedef struct {
+  bool retry_throttling;
+  int retry_max_milli_tokens;
+  int retry_milli_token_ratio;
+} service_config_parsing_state;
+
+static void parse_retry_throttle_params(const grpc_json *field, void *arg) {
+  service_config_parsing_state *parsing_state = arg;
+  if (strcmp(field->key, "retryThrottling") == 0) {
+    if (parsing_state->retry_throttling) return;  // Duplicate.
+    if (field->type != GRPC_JSON_OBJECT) return;
+    int max_milli_tokens = 0;
+    int milli_token_ratio = 0;
+    for (grpc_json *sub_field = field->child; sub_field != NULL;
+         sub_field = sub_field->next) {
+      if (sub_field->key == NULL) return;
+      if (strcmp(sub_field->key, "maxTokens") == 0) {
+        if (max_milli_tokens != 0) return;  // Duplicate.
+        if (sub_field->type != GRPC_JSON_NUMBER) return;
+        max_milli_tokens = gpr_parse_nonnegative_int(sub_field->value);
+        if (max_milli_tokens == -1) return;
+        max_milli_tokens *= 1000;
+      } else if (strcmp(sub_field->key, "tokenRatio") == 0) {
+        if (milli_token_ratio != 0) return;  // Duplicate.
+        if (sub_field->type != GRPC_JSON_NUMBER) return;
+        // We support up to 3 decimal digits.
+        size_t whole_len = strlen(sub_field->value);
+        uint32_t multiplier = 1;
+        uint32_t decimal_value = 0;
+        const char *decimal_point = strchr(sub_field->value, '.');
+        if (decimal_point != NULL) {
+          whole_len = (size_t)(decimal_point - sub_field->value);
+          multiplier = 1000;
+          size_t decimal_len = strlen(decimal_point + 1);
+          if (decimal_len > 3) decimal_len = 3;
+          if (!gpr_parse_bytes_to_uint32(decimal_point + 1, decimal_len,
+                                         &decimal_value)) {
+            return;
+          }
+          uint32_t decimal_multiplier = 1;
+          for (size_t i = 0; i < (3 - decimal_len); ++i) {
+            decimal_multiplier *= 10;
+          }
+          decimal_value *= decimal_multiplier;
+        }
+        uint32_t whole_value;
+        if (!gpr_parse_bytes_to_uint32(sub_field->value, whole_len,
+                                       &whole_value)) {
+          return;
+        }
+        milli_token_ratio = (int)((whole_value * multiplier) + decimal_value);
+        if (milli_token_ratio <= 0) return;
+      }
+    }
+    parsing_state->retry_throttling = true;
+    parsing_state->retry_max_milli_tokens = max_milli_tokens;
+    parsing_state->retry_milli_token_ratio = milli_token_ratio;
+  }
+}
+
+/** Parse artifacts of one service config JSON string, shared by refcount
+    across every channel whose resolver reports that exact string. An
+    unchanged push from the control plane thus costs a hash compare and a
+    strcmp instead of a JSON parse and a method-table rebuild. */
+typedef struct service_config_memo {
+  gpr_refcount refs;
+  uint32_t hash;
+  char *json;
+  /** maps method names to method_parameters; may be NULL */
+  grpc_slice_hash_table *method_params_table;
+  /** parsed retryThrottling params; combined with each channel's server
+      name to look up its retry throttle data */
+  bool retry_throttling;
+  int retry_max_milli_tokens;
+  int retry_milli_token_ratio;
+  struct service_config_memo *next;
+} service_config_memo;
+
+static gpr_mu g_service_config_memo_mu;
+static service_config_memo *g_service_config_memos;
+
+void grpc_service_config_memo_init(void) {
+  gpr_mu_init(&g_service_config_memo_mu);
+}
+
+void grpc_service_config_memo_shutdown(void) {
+  /* memos are held only by channels, all of which are gone by now */
+  GPR_ASSERT(g_service_config_memos == NULL);
+  gpr_mu_destroy(&g_service_config_memo_mu);
+}
+
+static service_config_memo *service_config_memo_lookup_locked(
+    uint32_t hash, const char *json) {
+  for (service_config_memo *memo = g_service_config_memos; memo != NULL;
+       memo = memo->next) {
+    if (memo->hash == hash && strcmp(memo->json, json) == 0) return memo;
+  }
+  return NULL;
+}
+
+static void service_config_memo_unref(grpc_exec_ctx *exec_ctx,
+                                      service_config_memo *memo) {
+  /* the lock makes the drop to zero atomic with removal from the list, so a
+     concurrent lookup cannot revive a dying memo */
+  gpr_mu_lock(&g_service_config_memo_mu);
+  if (!gpr_unref(&memo->refs)) {
+    gpr_mu_unlock(&g_service_config_memo_mu);
+    return;
+  }
+  service_config_memo **pp = &g_service_config_memos;
+  while (*pp != memo) pp = &(*pp)->next;
+  *pp = memo->next;
+  gpr_mu_unlock(&g_service_config_memo_mu);
+  if (memo->method_params_table != NULL) {
+    grpc_slice_hash_table_unref(exec_ctx, memo->method_params_table);
+  }
+  gpr_free(memo->json);
+  gpr_free(memo);
+}
+
+/** Returns a ref to the memo for \a json, parsing it only if no channel
+    already holds an identical config. Returns NULL if \a json does not
+    parse. */
+static service_config_memo *service_config_memo_get(grpc_exec_ctx *exec_ctx,
+                                                    const char *json) {
+  uint32_t hash =
+      gpr_murmur_hash3(json, strlen(json), 0x5eacfc15 /* seed */);
+  gpr_mu_lock(&g_service_config_memo_mu);
+  service_config_memo *memo = service_config_memo_lookup_locked(hash, json);
+  if (memo != NULL) {
+    gpr_ref(&memo->refs);
+    gpr_mu_unlock(&g_service_config_memo_mu);
+    return memo;
+  }
+  gpr_mu_unlock(&g_service_config_memo_mu);
+  /* parse outside the lock */
+  grpc_service_config *service_config = grpc_service_config_create(json);
+  if (service_config == NULL) return NULL;
+  memo = gpr_zalloc(sizeof(*memo));
+  gpr_ref_init(&memo->refs, 1);
+  memo->hash = hash;
+  memo->json = gpr_strdup(json);
+  service_config_parsing_state parsing_state;
+  memset(&parsing_state, 0, sizeof(parsing_state));
+  grpc_service_config_parse_global_params(
+      service_config, parse_retry_throttle_params, &parsing_state);
+  memo->retry_throttling = parsing_state.retry_throttling;
+  memo->retry_max_milli_tokens = parsing_state.retry_max_milli_tokens;
+  memo->retry_milli_token_ratio = parsing_state.retry_milli_token_ratio;
+  memo->method_params_table = grpc_service_config_create_method_config_table(
+      exec_ctx, service_config, method_parameters_create_from_json,
+      method_parameters_free);
+  grpc_service_config_destroy(service_config);
+  gpr_mu_lock(&g_service_config_memo_mu);
+  service_config_memo *existing = service_config_memo_lookup_locked(hash, json);
+  if (existing != NULL) {
+    /* lost a race against another channel parsing the same config */
+    gpr_ref(&existing->refs);
+    gpr_mu_unlock(&g_service_config_memo_mu);
+    if (memo->method_params_table != NULL) {
+      grpc_slice_hash_table_unref(exec_ctx, memo->method_params_table);
+    }
+    gpr_free(memo->json);
+    gpr_free(memo);
+    return existing;
+  }
+  memo->next = g_service_config_memos;
+  g_service_config_memos = memo;
+  gpr_mu_unlock(&g_service_config_memo_mu);
+  return memo;
+}
+
 struct external_connectivity_watcher;
 
 /*************************************************************************
@@ -189,8 +366,22 @@ typedef struct client_channel_channel_data {
   grpc_lb_policy *lb_policy;
   /** retry throttle data */
   grpc_server_retry_throttle_data *retry_throttle_data;
+  /** memoized parse of the current service config; holding this ref keeps
+      the shared parse alive so identical resolver pushes stay cheap */
+  service_config_memo *service_config_memo;
   /** maps method names to method_parameters structs */
   grpc_slice_hash_table *method_params_table;
+  /** one-entry cache over \a method_params_table: the last path looked up and
+      its result (which may legitimately be NULL). Repeated calls to the same
+      method skip the table; flushed whenever the table is swapped out */
+  bool method_params_cache_valid;
+  grpc_slice method_params_cache_path;
+  method_parameters *method_params_cache_value;
+  /** one-entry cache over LB picks: the connected subchannel returned by the
+      last successful pick, populated only when the active policy's picks are
+      call-invariant (\a cacheable_picks, e.g. pick_first). Owns a ref;
+      flushed whenever the policy or its connectivity state changes */
+  grpc_connected_subchannel *pick_cache;
   /** incoming resolver result - set by resolver.next() */
   grpc_channel_args *resolver_result;
   /** a list of closures that are all waiting for config to come in */
@@ -219,6 +410,25 @@ typedef struct client_channel_channel_data {
   char *info_service_config_json;
 } channel_data;
 
+static void method_params_cache_flush_locked(grpc_exec_ctx *exec_ctx,
+                                             channel_data *chand) {
+  if (chand->method_params_cache_valid) {
+    grpc_slice_unref_internal(exec_ctx, chand->method_params_cache_path);
+    if (chand->method_params_cache_value != NULL) {
+      method_parameters_unref(chand->method_params_cache_value);
+    }
+    chand->method_params_cache_valid = false;
+  }
+}
+
+static void pick_cache_flush_locked(grpc_exec_ctx *exec_ctx,
+                                    channel_data *chand) {
+  if (chand->pick_cache != NULL) {
+    GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, chand->pick_cache, "pick_cache");
+    chand->pick_cache = NULL;
+  }
+}
+
 /** We create one watcher for each new lb_policy that is returned from a
     resolver, to watch for state changes from the lb_policy. When a state
     change is seen, we update the channel, and create a new watcher. */
@@ -266,6 +476,8 @@ static void on_lb_policy_state_changed_locked(grpc_exec_ctx *exec_ctx,
   grpc_connectivity_state publish_state = w->state;
   /* check if the notification is for the latest policy */
   if (w->lb_policy == w->chand->lb_policy) {
+    /* the policy may now pick differently */
+    pick_cache_flush_locked(exec_ctx, w->chand);
     if (publish_state == GRPC_CHANNEL_SHUTDOWN && w->chand->resolver != NULL) {
       publish_state = GRPC_CHANNEL_TRANSIENT_FAILURE;
       grpc_resolver_channel_saw_error_locked(exec_ctx, w->chand->resolver);
@@ -298,65 +510,6 @@ static void watch_lb_policy_locked(grpc_exec_ctx *exec_ctx, channel_data *chand,
                                                &w->on_changed);
 }
 
-typedef struct {
-  char *server_name;
-  grpc_server_retry_throttle_data *retry_throttle_data;
-} service_config_parsing_state;
-
-static void parse_retry_throttle_params(const grpc_json *field, void *arg) {
-  service_config_parsing_state *parsing_state = arg;
-  if (strcmp(field->key, "retryThrottling") == 0) {
-    if (parsing_state->retry_throttle_data != NULL) return;  // Duplicate.
-    if (field->type != GRPC_JSON_OBJECT) return;
-    int max_milli_tokens = 0;
-    int milli_token_ratio = 0;
-    for (grpc_json *sub_field = field->child; sub_field != NULL;
-         sub_field = sub_field->next) {
-      if (sub_field->key == NULL) return;
-      if (strcmp(sub_field->key, "maxTokens") == 0) {
-        if (max_milli_tokens != 0) return;  // Duplicate.
-        if (sub_field->type != GRPC_JSON_NUMBER) return;
-        max_milli_tokens = gpr_parse_nonnegative_int(sub_field->value);
-        if (max_milli_tokens == -1) return;
-        max_milli_tokens *= 1000;
-      } else if (strcmp(sub_field->key, "tokenRatio") == 0) {
-        if (milli_token_ratio != 0) return;  // Duplicate.
-        if (sub_field->type != GRPC_JSON_NUMBER) return;
-        // We support up to 3 decimal digits.
-        size_t whole_len = strlen(sub_field->value);
-        uint32_t multiplier = 1;
-        uint32_t decimal_value = 0;
-        const char *decimal_point = strchr(sub_field->value, '.');
-        if (decimal_point != NULL) {
-          whole_len = (size_t)(decimal_point - sub_field->value);
-          multiplier = 1000;
-          size_t decimal_len = strlen(decimal_point + 1);
-          if (decimal_len > 3) decimal_len = 3;
-          if (!gpr_parse_bytes_to_uint32(decimal_point + 1, decimal_len,
-                                         &decimal_value)) {
-            return;
-          }
-          uint32_t decimal_multiplier = 1;
-          for (size_t i = 0; i < (3 - decimal_len); ++i) {
-            decimal_multiplier *= 10;
-          }
-          decimal_value *= decimal_multiplier;
-        }
-        uint32_t whole_value;
-        if (!gpr_parse_bytes_to_uint32(sub_field->value, whole_len,
-                                       &whole_value)) {
-          return;
-        }
-        milli_token_ratio = (int)((whole_value * multiplier) + decimal_value);
-        if (milli_token_ratio <= 0) return;
-      }
-    }
-    parsing_state->retry_throttle_data =
-        grpc_retry_throttle_map_get_data_for_server(
-            parsing_state->server_name, max_milli_tokens, milli_token_ratio);
-  }
-}
-
 // Wrap a closure associated with \a lb_policy. The associated callback (\a
 // wrapped_on_pick_closure_cb) is responsible for unref'ing \a lb_policy after
 // scheduling \a wrapped_closure.
@@ -393,11 +546,12 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
   grpc_slice_hash_table *method_params_table = NULL;
   grpc_connectivity_state state = GRPC_CHANNEL_TRANSIENT_FAILURE;
   bool exit_idle = false;
+  bool policy_updated = false;
   grpc_error *state_error =
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("No load balancing policy");
   char *service_config_json = NULL;
-  service_config_parsing_state parsing_state;
-  memset(&parsing_state, 0, sizeof(parsing_state));
+  service_config_memo *new_service_config_memo = NULL;
+  grpc_server_retry_throttle_data *retry_throttle_data = NULL;
 
   if (chand->resolver_result != NULL) {
     // Find LB policy name.
@@ -433,45 +587,60 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
     // Use pick_first if nothing was specified and we didn't select grpclb
     // above.
     if (lb_policy_name == NULL) lb_policy_name = "pick_first";
-    // Instantiate LB policy.
+    // Instantiate LB policy.  If the existing policy is of the same kind
+    // and knows how to update itself in place, hand it the new addresses
+    // instead of recreating it, so that established connections and
+    // subchannel state survive the resolver result.
     grpc_lb_policy_args lb_policy_args;
     lb_policy_args.args = chand->resolver_result;
     lb_policy_args.client_channel_factory = chand->client_channel_factory;
     lb_policy_args.combiner = chand->combiner;
-    lb_policy =
-        grpc_lb_policy_create(exec_ctx, lb_policy_name, &lb_policy_args);
+    if (chand->lb_policy != NULL &&
+        chand->lb_policy->vtable->update_locked != NULL &&
+        chand->info_lb_policy_name != NULL &&
+        strcmp(chand->info_lb_policy_name, lb_policy_name) == 0) {
+      lb_policy = chand->lb_policy;
+      policy_updated = true;
+      grpc_lb_policy_update_locked(exec_ctx, lb_policy, &lb_policy_args);
+    } else {
+      lb_policy =
+          grpc_lb_policy_create(exec_ctx, lb_policy_name, &lb_policy_args);
+    }
     if (lb_policy != NULL) {
       GRPC_LB_POLICY_REF(lb_policy, "config_change");
       GRPC_ERROR_UNREF(state_error);
       state = grpc_lb_policy_check_connectivity_locked(exec_ctx, lb_policy,
                                                        &state_error);
     }
-    // Find service config.
+    // Find service config.  The parse is memoized: if any channel already
+    // holds this exact config string, we reuse its method table and
+    // retryThrottling params instead of re-parsing the JSON.
     channel_arg =
         grpc_channel_args_find(chand->resolver_result, GRPC_ARG_SERVICE_CONFIG);
     if (channel_arg != NULL) {
       GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
       service_config_json = gpr_strdup(channel_arg->value.string);
-      grpc_service_config *service_config =
-          grpc_service_config_create(service_config_json);
-      if (service_config != NULL) {
-        channel_arg =
-            grpc_channel_args_find(chand->resolver_result, GRPC_ARG_SERVER_URI);
-        GPR_ASSERT(channel_arg != NULL);
-        GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
-        grpc_uri *uri =
-            grpc_uri_parse(exec_ctx, channel_arg->value.string, true);
-        GPR_ASSERT(uri->path[0] != '\0');
-        parsing_state.server_name =
-            uri->path[0] == '/' ? uri->path + 1 : uri->path;
-        grpc_service_config_parse_global_params(
-            service_config, parse_retry_throttle_params, &parsing_state);
-        parsing_state.server_name = NULL;
-        grpc_uri_destroy(uri);
-        method_params_table = grpc_service_config_create_method_config_table(
-            exec_ctx, service_config, method_parameters_create_from_json,
-            method_parameters_free);
-        grpc_service_config_destroy(service_config);
+      new_service_config_memo =
+          service_config_memo_get(exec_ctx, service_config_json);
+      if (new_service_config_memo != NULL) {
+        if (new_service_config_memo->retry_throttling) {
+          channel_arg = grpc_channel_args_find(chand->resolver_result,
+                                               GRPC_ARG_SERVER_URI);
+          GPR_ASSERT(channel_arg != NULL);
+          GPR_ASSERT(channel_arg->type == GRPC_ARG_STRING);
+          grpc_uri *uri =
+              grpc_uri_ref_parsed(exec_ctx, channel_arg->value.string, true);
+          GPR_ASSERT(uri->path[0] != '\0');
+          retry_throttle_data = grpc_retry_throttle_map_get_data_for_server(
+              uri->path[0] == '/' ? uri->path + 1 : uri->path,
+              new_service_config_memo->retry_max_milli_tokens,
+              new_service_config_memo->retry_milli_token_ratio);
+          grpc_uri_unref(uri);
+        }
+        if (new_service_config_memo->method_params_table != NULL) {
+          method_params_table = grpc_slice_hash_table_ref(
+              new_service_config_memo->method_params_table);
+        }
       }
     }
     // Before we clean up, save a copy of lb_policy_name, since it might
@@ -482,7 +651,7 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
     chand->resolver_result = NULL;
   }
 
-  if (lb_policy != NULL) {
+  if (lb_policy != NULL && !policy_updated) {
     grpc_pollset_set_add_pollset_set(exec_ctx, lb_policy->interested_parties,
                                      chand->interested_parties);
   }
@@ -492,22 +661,32 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
     gpr_free(chand->info_lb_policy_name);
     chand->info_lb_policy_name = lb_policy_name;
   }
-  old_lb_policy = chand->lb_policy;
-  chand->lb_policy = lb_policy;
+  old_lb_policy = NULL;
+  if (!policy_updated) {
+    old_lb_policy = chand->lb_policy;
+    chand->lb_policy = lb_policy;
+  }
   if (service_config_json != NULL) {
     gpr_free(chand->info_service_config_json);
     chand->info_service_config_json = service_config_json;
   }
   gpr_mu_unlock(&chand->info_mu);
+  /* the new resolver result may change what the policy would pick */
+  pick_cache_flush_locked(exec_ctx, chand);
 
   if (chand->retry_throttle_data != NULL) {
     grpc_server_retry_throttle_data_unref(chand->retry_throttle_data);
   }
-  chand->retry_throttle_data = parsing_state.retry_throttle_data;
+  chand->retry_throttle_data = retry_throttle_data;
+  if (chand->service_config_memo != NULL) {
+    service_config_memo_unref(exec_ctx, chand->service_config_memo);
+  }
+  chand->service_config_memo = new_service_config_memo;
   if (chand->method_params_table != NULL) {
     grpc_slice_hash_table_unref(exec_ctx, chand->method_params_table);
   }
   chand->method_params_table = method_params_table;
+  method_params_cache_flush_locked(exec_ctx, chand);
   if (lb_policy != NULL) {
     grpc_closure_list_sched(exec_ctx, &chand->waiting_for_config_closures);
   } else if (chand->resolver == NULL /* disconnected */) {
@@ -525,7 +704,7 @@ static void on_resolver_result_changed_locked(grpc_exec_ctx *exec_ctx,
   if (error == GRPC_ERROR_NONE && chand->resolver) {
     set_channel_connectivity_state_locked(
         exec_ctx, chand, state, GRPC_ERROR_REF(state_error), "new_lb+resolver");
-    if (lb_policy != NULL) {
+    if (lb_policy != NULL && !policy_updated) {
       watch_lb_policy_locked(exec_ctx, chand, lb_policy, state);
     }
     GRPC_CHANNEL_STACK_REF(chand->owning_stack, "resolver");
@@ -610,6 +789,7 @@ static void start_transport_op_locked(grpc_exec_ctx *exec_ctx, void *arg,
                                          chand->interested_parties);
         GRPC_LB_POLICY_UNREF(exec_ctx, chand->lb_policy, "channel");
         chand->lb_policy = NULL;
+        pick_cache_flush_locked(exec_ctx, chand);
       }
     }
     GRPC_ERROR_UNREF(op->disconnect_with_error);
@@ -667,6 +847,7 @@ static grpc_error *cc_init_channel_elem(grpc_exec_ctx *exec_ctx,
   GPR_ASSERT(elem->filter == &grpc_client_channel_filter);
   // Initialize data members.
   chand->combiner = grpc_combiner_create(NULL);
+  chand->method_params_cache_valid = false;
   gpr_mu_init(&chand->info_mu);
   gpr_mu_init(&chand->external_connectivity_watcher_list_mu);
 
@@ -750,14 +931,19 @@ static void cc_destroy_channel_elem(grpc_exec_ctx *exec_ctx,
                                      chand->interested_parties);
     GRPC_LB_POLICY_UNREF(exec_ctx, chand->lb_policy, "channel");
   }
+  pick_cache_flush_locked(exec_ctx, chand);
   gpr_free(chand->info_lb_policy_name);
   gpr_free(chand->info_service_config_json);
   if (chand->retry_throttle_data != NULL) {
     grpc_server_retry_throttle_data_unref(chand->retry_throttle_data);
   }
+  if (chand->service_config_memo != NULL) {
+    service_config_memo_unref(exec_ctx, chand->service_config_memo);
+  }
   if (chand->method_params_table != NULL) {
     grpc_slice_hash_table_unref(exec_ctx, chand->method_params_table);
   }
+  method_params_cache_flush_locked(exec_ctx, chand);
   grpc_connectivity_state_destroy(exec_ctx, &chand->state_tracker);
   grpc_pollset_set_destroy(exec_ctx, chand->interested_parties);
   GRPC_COMBINER_UNREF(exec_ctx, chand->combiner, "client_channel");
@@ -884,8 +1070,20 @@ static bool set_call_method_params_from_service_config_locked(
         grpc_server_retry_throttle_data_ref(chand->retry_throttle_data);
   }
   if (chand->method_params_table != NULL) {
-    calld->method_params = grpc_method_config_table_get(
-        exec_ctx, chand->method_params_table, calld->path);
+    if (chand->method_params_cache_valid &&
+        grpc_slice_eq(chand->method_params_cache_path, calld->path)) {
+      calld->method_params = chand->method_params_cache_value;
+    } else {
+      calld->method_params = grpc_method_config_table_get(
+          exec_ctx, chand->method_params_table, calld->path);
+      method_params_cache_flush_locked(exec_ctx, chand);
+      chand->method_params_cache_valid = true;
+      chand->method_params_cache_path = grpc_slice_ref_internal(calld->path);
+      chand->method_params_cache_value =
+          calld->method_params == NULL
+              ? NULL
+              : method_parameters_ref(calld->method_params);
+    }
     if (calld->method_params != NULL) {
       method_parameters_ref(calld->method_params);
       if (gpr_time_cmp(calld->method_params->timeout,
@@ -941,7 +1139,7 @@ static void subchannel_ready_locked(grpc_exec_ctx *exec_ctx, void *arg,
         GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
             "Cancelled before creating subchannel", &error, 1);
     /* if due to deadline, attach the deadline exceeded status to the error */
-    if (gpr_time_cmp(calld->deadline, gpr_now(GPR_CLOCK_MONOTONIC)) < 0) {
+    if (gpr_time_cmp(calld->deadline, grpc_exec_ctx_now(exec_ctx)) < 0) {
       cancellation_error =
           grpc_error_set_int(cancellation_error, GRPC_ERROR_INT_GRPC_STATUS,
                              GRPC_STATUS_DEADLINE_EXCEEDED);
@@ -1055,6 +1253,15 @@ static bool pick_subchannel_locked(
 
   if (chand->lb_policy != NULL) {
     apply_final_configuration_locked(exec_ctx, elem);
+    /* Fast path: the current policy's picks are call-invariant and we have
+       one cached. wait_for_ready only matters for picks that cannot complete
+       immediately, so it doesn't factor in here. */
+    if (chand->pick_cache != NULL) {
+      *connected_subchannel =
+          GRPC_CONNECTED_SUBCHANNEL_REF(chand->pick_cache, "picked");
+      GPR_TIMER_END("pick_subchannel", 0);
+      return true;
+    }
     grpc_lb_policy *lb_policy = chand->lb_policy;
     GRPC_LB_POLICY_REF(lb_policy, "pick_subchannel");
     // If the application explicitly set wait_for_ready, use that.
@@ -1095,6 +1302,12 @@ static bool pick_subchannel_locked(
       GRPC_LB_POLICY_UNREF(exec_ctx, w_on_pick_arg->lb_policy,
                            "pick_subchannel_wrapping");
       gpr_free(w_on_pick_arg);
+      /* remember the result for following calls if the policy allows it */
+      if (lb_policy->vtable->cacheable_picks &&
+          *connected_subchannel != NULL) {
+        chand->pick_cache =
+            GRPC_CONNECTED_SUBCHANNEL_REF(*connected_subchannel, "pick_cache");
+      }
     }
     GRPC_LB_POLICY_UNREF(exec_ctx, lb_policy, "pick_subchannel");
     GPR_TIMER_END("pick_subchannel", 0);
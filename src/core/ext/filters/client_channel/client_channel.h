@@ -50,6 +50,11 @@
 
 extern const grpc_channel_filter grpc_client_channel_filter;
 
+/* Initializes/shuts down the process-wide cache of memoized service config
+   parses shared across channels */
+void grpc_service_config_memo_init(void);
+void grpc_service_config_memo_shutdown(void);
+
 grpc_connectivity_state grpc_client_channel_check_connectivity_state(
     grpc_exec_ctx *exec_ctx, grpc_channel_element *elem, int try_to_connect);
 
@@ -59,6 +59,15 @@ typedef struct http_connect_handshaker {
   gpr_mu mu;
 
   bool shutdown;
+  // The request write and response read are issued concurrently, so we
+  // track their completion separately.  The handshake is done only once
+  // both have finished, since the next handshaker must not start using
+  // the endpoint while our write is still in flight.
+  bool write_done;
+  bool response_complete;
+  // Set once on_handshake_done has been scheduled, so that racing
+  // endpoint callbacks do not invoke it a second time.
+  bool notified;
   // Endpoint and read buffer to destroy after a shutdown.
   grpc_endpoint* endpoint_to_destroy;
   grpc_slice_buffer* read_buffer_to_destroy;
@@ -132,8 +141,13 @@ static void handshake_failed_locked(grpc_exec_ctx* exec_ctx,
     // http_connect_handshaker_shutdown() do nothing.
     handshaker->shutdown = true;
   }
-  // Invoke callback.
-  grpc_closure_sched(exec_ctx, handshaker->on_handshake_done, error);
+  // Invoke callback, unless another callback already beat us to it.
+  if (!handshaker->notified) {
+    handshaker->notified = true;
+    grpc_closure_sched(exec_ctx, handshaker->on_handshake_done, error);
+  } else {
+    GRPC_ERROR_UNREF(error);
+  }
 }
 
 // Callback invoked when finished writing HTTP CONNECT request.
@@ -141,20 +155,25 @@ static void on_write_done(grpc_exec_ctx* exec_ctx, void* arg,
                           grpc_error* error) {
   http_connect_handshaker* handshaker = arg;
   gpr_mu_lock(&handshaker->mu);
+  handshaker->write_done = true;
   if (error != GRPC_ERROR_NONE || handshaker->shutdown) {
     // If the write failed or we're shutting down, clean up and invoke the
     // callback with the error.
     handshake_failed_locked(exec_ctx, handshaker, GRPC_ERROR_REF(error));
-    gpr_mu_unlock(&handshaker->mu);
-    http_connect_handshaker_unref(exec_ctx, handshaker);
-  } else {
-    // Otherwise, read the response.
-    // The read callback inherits our ref to the handshaker.
-    grpc_endpoint_read(exec_ctx, handshaker->args->endpoint,
-                       handshaker->args->read_buffer,
-                       &handshaker->response_read_closure);
-    gpr_mu_unlock(&handshaker->mu);
+  } else if (handshaker->response_complete) {
+    // The response was fully parsed before our write callback ran; the
+    // read path deferred completion to us, so finish the handshake now.
+    handshaker->shutdown = true;
+    if (!handshaker->notified) {
+      handshaker->notified = true;
+      grpc_closure_sched(exec_ctx, handshaker->on_handshake_done,
+                         GRPC_ERROR_NONE);
+    }
   }
+  // Nothing else to do on success: the read for the response was issued
+  // alongside the write, and its callback carries the handshake forward.
+  gpr_mu_unlock(&handshaker->mu);
+  http_connect_handshaker_unref(exec_ctx, handshaker);
 }
 
 // Callback invoked for reading HTTP CONNECT response.
@@ -231,8 +250,21 @@ static void on_read_done(grpc_exec_ctx* exec_ctx, void* arg,
     handshake_failed_locked(exec_ctx, handshaker, error);
     goto done;
   }
-  // Success.  Invoke handshake-done callback.
-  grpc_closure_sched(exec_ctx, handshaker->on_handshake_done, error);
+  // Success.
+  handshaker->response_complete = true;
+  if (!handshaker->write_done) {
+    // The write of the request is still in flight, so the endpoint is not
+    // yet safe to hand to the next handshaker; on_write_done will finish
+    // the handshake when it runs.
+    gpr_mu_unlock(&handshaker->mu);
+    http_connect_handshaker_unref(exec_ctx, handshaker);
+    return;
+  }
+  // Invoke handshake-done callback.
+  if (!handshaker->notified) {
+    handshaker->notified = true;
+    grpc_closure_sched(exec_ctx, handshaker->on_handshake_done, error);
+  }
 done:
   // Set shutdown to true so that subsequent calls to
   // http_connect_handshaker_shutdown() do nothing.
@@ -336,10 +368,16 @@ static void http_connect_handshaker_do_handshake(
     gpr_free(header_strings[i]);
   }
   gpr_free(header_strings);
-  // Take a new ref to be held by the write callback.
+  // Take new refs to be held by the write and read callbacks.
+  gpr_ref(&handshaker->refcount);
   gpr_ref(&handshaker->refcount);
+  // Issue the read for the response concurrently with the write of the
+  // request, so that a proxy that answers quickly does not have to wait
+  // for our write callback to run before we start consuming its response.
   grpc_endpoint_write(exec_ctx, args->endpoint, &handshaker->write_buffer,
                       &handshaker->request_done_closure);
+  grpc_endpoint_read(exec_ctx, args->endpoint, args->read_buffer,
+                     &handshaker->response_read_closure);
   gpr_mu_unlock(&handshaker->mu);
 }
 
@@ -370,6 +408,12 @@ static grpc_handshaker* grpc_http_connect_handshaker_create() {
 static void handshaker_factory_add_handshakers(
     grpc_exec_ctx* exec_ctx, grpc_handshaker_factory* factory,
     const grpc_channel_args* args, grpc_handshake_manager* handshake_mgr) {
+  // If no proxy is configured, don't add ourselves to the chain at all:
+  // the common direct-connect path then skips a handshaker allocation and
+  // a closure round trip per connection.
+  if (grpc_channel_args_find(args, GRPC_ARG_HTTP_CONNECT_SERVER) == NULL) {
+    return;
+  }
   grpc_handshake_manager_add(handshake_mgr,
                              grpc_http_connect_handshaker_create());
 }
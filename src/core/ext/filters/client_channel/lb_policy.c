@@ -166,3 +166,10 @@ grpc_connectivity_state grpc_lb_policy_check_connectivity_locked(
   return policy->vtable->check_connectivity_locked(exec_ctx, policy,
                                                    connectivity_error);
 }
+
+void grpc_lb_policy_update_locked(grpc_exec_ctx *exec_ctx,
+                                  grpc_lb_policy *policy,
+                                  const struct grpc_lb_policy_args *args) {
+  GPR_ASSERT(policy->vtable->update_locked != NULL);
+  policy->vtable->update_locked(exec_ctx, policy, args);
+}
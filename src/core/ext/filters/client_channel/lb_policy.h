@@ -43,6 +43,10 @@
 typedef struct grpc_lb_policy grpc_lb_policy;
 typedef struct grpc_lb_policy_vtable grpc_lb_policy_vtable;
 
+/* Defined in lb_policy_factory.h, which includes this header. The struct tag
+   is forward declared here to avoid the circular include. */
+struct grpc_lb_policy_args;
+
 struct grpc_lb_policy {
   const grpc_lb_policy_vtable *vtable;
   gpr_atm ref_pair;
@@ -105,6 +109,20 @@ struct grpc_lb_policy_vtable {
                                         grpc_lb_policy *policy,
                                         grpc_connectivity_state *state,
                                         grpc_closure *closure);
+
+  /** Update the policy in place with a new address list from the resolver,
+      carrying over state for addresses present in both the old and new
+      lists. May be NULL, in which case the client channel replaces the
+      policy wholesale on every resolver result. (struct tag used to avoid
+      a circular include of lb_policy_factory.h) */
+  void (*update_locked)(grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
+                        const struct grpc_lb_policy_args *args);
+
+  /** true if \a pick_locked ignores the per-call pick arguments and returns
+      the same result for every call until the policy's connectivity state
+      changes (e.g. pick_first). Allows the client channel to cache the last
+      pick and reuse it without consulting the policy again. */
+  bool cacheable_picks;
 };
 
 /*#define GRPC_LB_POLICY_REFCOUNT_DEBUG*/
@@ -207,4 +225,10 @@ grpc_connectivity_state grpc_lb_policy_check_connectivity_locked(
     grpc_exec_ctx *exec_ctx, grpc_lb_policy *policy,
     grpc_error **connectivity_error);
 
+/** Update \a policy in place with the address list in \a args. Only valid
+    for policies whose vtable provides \a update_locked. */
+void grpc_lb_policy_update_locked(grpc_exec_ctx *exec_ctx,
+                                  grpc_lb_policy *policy,
+                                  const struct grpc_lb_policy_args *args);
+
 #endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_H */
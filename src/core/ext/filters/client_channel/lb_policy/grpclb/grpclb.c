@@ -332,6 +332,12 @@ typedef struct glb_lb_policy {
    * Otherwise, we delegate to the RR policy. */
   size_t serverlist_index;
 
+  /** raw bytes of the last response that carried a serverlist:
+   * byte-identical balancer pushes (the overwhelmingly common case) are
+   * recognized and dropped before nanopb decoding even starts */
+  bool last_serverlist_response_valid;
+  grpc_slice last_serverlist_response;
+
   /** list of picks that are waiting on RR's policy connectivity */
   pending_pick *pending_picks;
 
@@ -1015,6 +1021,9 @@ static void glb_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
   if (glb_policy->serverlist != NULL) {
     grpc_grpclb_destroy_serverlist(glb_policy->serverlist);
   }
+  if (glb_policy->last_serverlist_response_valid) {
+    grpc_slice_unref_internal(exec_ctx, glb_policy->last_serverlist_response);
+  }
   gpr_free(glb_policy);
 }
 
@@ -1528,11 +1537,29 @@ static void lb_on_response_received_locked(grpc_exec_ctx *exec_ctx, void *arg,
       }
       grpc_grpclb_initial_response_destroy(response);
       glb_policy->seen_initial_response = true;
+    } else if (glb_policy->last_serverlist_response_valid &&
+               grpc_slice_eq(glb_policy->last_serverlist_response,
+                             response_slice)) {
+      /* byte-identical push: skip decoding and all downstream work */
+      if (GRPC_TRACER_ON(grpc_lb_glb_trace)) {
+        gpr_log(GPR_INFO,
+                "Serverlist response bytes identical to the previous "
+                "response, skipping decode.");
+      }
     } else {
       grpc_grpclb_serverlist *serverlist =
           grpc_grpclb_response_parse_serverlist(response_slice);
       if (serverlist != NULL) {
         GPR_ASSERT(glb_policy->lb_call != NULL);
+        /* memoize the raw bytes so the next identical push is dropped
+         * before decoding */
+        if (glb_policy->last_serverlist_response_valid) {
+          grpc_slice_unref_internal(exec_ctx,
+                                    glb_policy->last_serverlist_response);
+        }
+        glb_policy->last_serverlist_response =
+            grpc_slice_ref_internal(response_slice);
+        glb_policy->last_serverlist_response_valid = true;
         if (GRPC_TRACER_ON(grpc_lb_glb_trace)) {
           gpr_log(GPR_INFO, "Serverlist with %lu servers received",
                   (unsigned long)serverlist->num_servers);
@@ -1548,8 +1575,11 @@ static void lb_on_response_received_locked(grpc_exec_ctx *exec_ctx, void *arg,
 
         /* update serverlist */
         if (serverlist->num_servers > 0) {
-          if (grpc_grpclb_serverlist_equals(glb_policy->serverlist,
-                                            serverlist)) {
+          /* round_robin does not care about ordering, so a reordered but
+           * otherwise identical serverlist need not trigger a handover
+           * either */
+          if (grpc_grpclb_serverlist_set_equals(glb_policy->serverlist,
+                                                serverlist)) {
             if (GRPC_TRACER_ON(grpc_lb_glb_trace)) {
               gpr_log(GPR_INFO,
                       "Incoming server list identical to current, ignoring.");
@@ -1678,7 +1708,9 @@ static const grpc_lb_policy_vtable glb_lb_policy_vtable = {
     glb_ping_one_locked,
     glb_exit_idle_locked,
     glb_check_connectivity_locked,
-    glb_notify_on_state_change_locked};
+    glb_notify_on_state_change_locked,
+    NULL /* update_locked */,
+    false /* cacheable_picks: picks carry per-call LB tokens */};
 
 static void glb_factory_ref(grpc_lb_policy_factory *factory) {}
 
@@ -35,6 +35,8 @@
 #include "third_party/nanopb/pb_decode.h"
 #include "third_party/nanopb/pb_encode.h"
 
+#include <stdlib.h>
+
 #include <grpc/support/alloc.h>
 
 /* invoked once for every Server in ServerList */
@@ -248,6 +250,50 @@ bool grpc_grpclb_server_equals(const grpc_grpclb_server *lhs,
   return memcmp(lhs, rhs, sizeof(grpc_grpclb_server)) == 0;
 }
 
+static int server_ptr_compare(const void *a, const void *b) {
+  return memcmp(*(const grpc_grpclb_server *const *)a,
+                *(const grpc_grpclb_server *const *)b,
+                sizeof(grpc_grpclb_server));
+}
+
+bool grpc_grpclb_serverlist_set_equals(const grpc_grpclb_serverlist *lhs,
+                                       const grpc_grpclb_serverlist *rhs) {
+  if (lhs == NULL || rhs == NULL) {
+    return false;
+  }
+  if (lhs->num_servers != rhs->num_servers) {
+    return false;
+  }
+  /* fast path: identical ordering */
+  size_t i;
+  for (i = 0; i < lhs->num_servers; i++) {
+    if (!grpc_grpclb_server_equals(lhs->servers[i], rhs->servers[i])) break;
+  }
+  if (i == lhs->num_servers) {
+    return true;
+  }
+  /* compare order-insensitively via sorted copies of the pointer arrays */
+  const size_t ptrs_size = lhs->num_servers * sizeof(grpc_grpclb_server *);
+  grpc_grpclb_server **lhs_sorted = gpr_malloc(ptrs_size);
+  grpc_grpclb_server **rhs_sorted = gpr_malloc(ptrs_size);
+  memcpy(lhs_sorted, lhs->servers, ptrs_size);
+  memcpy(rhs_sorted, rhs->servers, ptrs_size);
+  qsort(lhs_sorted, lhs->num_servers, sizeof(*lhs_sorted),
+        server_ptr_compare);
+  qsort(rhs_sorted, rhs->num_servers, sizeof(*rhs_sorted),
+        server_ptr_compare);
+  bool equal = true;
+  for (i = 0; i < lhs->num_servers; i++) {
+    if (!grpc_grpclb_server_equals(lhs_sorted[i], rhs_sorted[i])) {
+      equal = false;
+      break;
+    }
+  }
+  gpr_free(lhs_sorted);
+  gpr_free(rhs_sorted);
+  return equal;
+}
+
 int grpc_grpclb_duration_compare(const grpc_grpclb_duration *lhs,
                                  const grpc_grpclb_duration *rhs) {
   GPR_ASSERT(lhs && rhs);
@@ -85,6 +85,12 @@ grpc_grpclb_serverlist *grpc_grpclb_serverlist_copy(
 bool grpc_grpclb_serverlist_equals(const grpc_grpclb_serverlist *lhs,
                                    const grpc_grpclb_serverlist *rhs);
 
+/** Like \a grpc_grpclb_serverlist_equals, but compares the servers as an
+ * unordered set and ignores \a expiration_interval. Use to decide whether a
+ * new serverlist actually changes the set of backends to pick over */
+bool grpc_grpclb_serverlist_set_equals(const grpc_grpclb_serverlist *lhs,
+                                       const grpc_grpclb_serverlist *rhs);
+
 bool grpc_grpclb_server_equals(const grpc_grpclb_server *lhs,
                                const grpc_grpclb_server *rhs);
 
@@ -388,7 +388,9 @@ static const grpc_lb_policy_vtable pick_first_lb_policy_vtable = {
     pf_ping_one_locked,
     pf_exit_idle_locked,
     pf_check_connectivity_locked,
-    pf_notify_on_state_change_locked};
+    pf_notify_on_state_change_locked,
+    NULL /* update_locked */,
+    true /* cacheable_picks */};
 
 static void pick_first_factory_ref(grpc_lb_policy_factory *factory) {}
 
@@ -34,34 +34,28 @@
 /** Round Robin Policy.
  *
  * This policy keeps:
- * - A circular list of ready (connected) subchannels, the *readylist*. An empty
- *   readylist consists solely of its root (dummy) node.
- * - A pointer to the last element picked from the readylist, the *lastpick*.
- *   Initially set to point to the readylist's root.
+ * - An array with all the subchannels created from the addresses received at
+ *   creation time.
+ * - An immutable snapshot of the indexes of the subchannels currently in
+ *   READY state, the *ready snapshot*. It is rebuilt (under the combiner)
+ *   whenever a subchannel enters or leaves READY and published with an atomic
+ *   pointer store.
+ * - A monotonically increasing pick counter.
  *
  * Behavior:
- * - When a subchannel connects, it's *prepended* to the readylist's root node.
- *   Ie, if readylist = A <-> B <-> ROOT <-> C
- *                      ^                    ^
- *                      |____________________|
- *   and subchannel D becomes connected, the addition of D to the readylist
- *   results in  readylist = A <-> B <-> D <-> ROOT <-> C
- *                           ^                          ^
- *                           |__________________________|
- * - When a subchannel disconnects, it's removed from the readylist. If the
- *   subchannel being removed was the most recently picked, the *lastpick*
- *   pointer moves to the removed node's previous element. Note that if the
- *   readylist only had one element, this is still legal, as the lastpick would
- *   point to the dummy root node, for an empty readylist.
- * - Upon picking, *lastpick* is updated to point to the returned (connected)
- *   subchannel. Note that it's possible that the selected subchannel becomes
- *   disconnected in the interim between the selection and the actual usage of
- *   the subchannel by the caller.
+ * - Upon picking, the pick counter is advanced with an atomic fetch-add and
+ *   used to index (modulo its size) into the ready snapshot, making picks O(1)
+ *   regardless of the number of subchannels. Note that it's possible that the
+ *   selected subchannel becomes disconnected in the interim between the
+ *   selection and the actual usage of the subchannel by the caller.
+ * - Connectivity state changes are processed under the combiner and result in
+ *   a new snapshot being published; picks never observe a half-built one.
  */
 
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel.h"
@@ -121,8 +115,24 @@ typedef struct {
   void *user_data;
   /** vtable to operate over \a user_data */
   const grpc_lb_user_data_vtable *user_data_vtable;
+  /** true if the entry was shed by \a rr_update_locked; its watcher has been
+   * cancelled and \a rr_connectivity_changed_locked will release it when the
+   * cancellation notification arrives */
+  bool removed;
 } subchannel_data;
 
+/** Immutable set of the indexes (into the policy's subchannel array) of the
+ * subchannels in READY state. Rebuilt under the combiner whenever a subchannel
+ * enters or leaves READY and published with an atomic pointer store. */
+typedef struct ready_snapshot {
+  /** number of entries in \a ready_indexes. Always > 0: an empty snapshot is
+   * represented by a NULL pointer instead */
+  size_t num_ready;
+  /** indexes of the READY subchannels, in subchannel array order. Points into
+   * the same allocation, right past this struct */
+  size_t *ready_indexes;
+} ready_snapshot;
+
 struct round_robin_lb_policy {
   /** base policy: must be first */
   grpc_lb_policy base;
@@ -130,9 +140,11 @@ struct round_robin_lb_policy {
   /** total number of addresses received at creation time */
   size_t num_addresses;
 
-  /** all our subchannels */
+  /** all our subchannels. Entries are individually allocated so that they
+   * (and the connectivity watchers bound to them) survive address-list
+   * updates intact */
   size_t num_subchannels;
-  subchannel_data *subchannels;
+  subchannel_data **subchannels;
 
   /** how many subchannels are in state READY */
   size_t num_ready;
@@ -151,58 +163,71 @@ struct round_robin_lb_policy {
   /** our connectivity state tracker */
   grpc_connectivity_state_tracker state_tracker;
 
-  // Index into subchannels for last pick.
-  size_t last_ready_subchannel_index;
+  // Atomically published pointer to the current ready_snapshot, or 0 if no
+  // subchannel is READY.
+  gpr_atm ready_snapshot;
+  // Number of picks handed out so far; indexes into the snapshot modulo its
+  // size.
+  gpr_atm pick_counter;
 };
 
-/** Returns the index into p->subchannels of the next subchannel in
- * READY state, or p->num_subchannels if no subchannel is READY.
- *
- * Note that this function does *not* update p->last_ready_subchannel_index.
- * The caller must do that if it returns a pick. */
-static size_t get_next_ready_subchannel_index_locked(
-    const round_robin_lb_policy *p) {
-  if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
-    gpr_log(GPR_INFO,
-            "[RR: %p] getting next ready subchannel, "
-            "last_ready_subchannel_index=%lu",
-            p, (unsigned long)p->last_ready_subchannel_index);
-  }
-  for (size_t i = 0; i < p->num_subchannels; ++i) {
-    const size_t index =
-        (i + p->last_ready_subchannel_index + 1) % p->num_subchannels;
-    if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
-      gpr_log(GPR_DEBUG, "[RR %p] checking index %lu: state=%d", p,
-              (unsigned long)index,
-              p->subchannels[index].curr_connectivity_state);
-    }
-    if (p->subchannels[index].curr_connectivity_state == GRPC_CHANNEL_READY) {
-      if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
-        gpr_log(GPR_DEBUG, "[RR %p] found next ready subchannel at index %lu",
-                p, (unsigned long)index);
+/** Rebuilds the ready snapshot from the current connectivity states and
+ * publishes it, replacing (and freeing) the previous one. Freeing the old
+ * snapshot right away is safe because picks run under the same combiner that
+ * called us; a truly concurrent reader would require deferred reclamation. */
+static void update_ready_snapshot_locked(round_robin_lb_policy *p) {
+  ready_snapshot *snapshot = NULL;
+  if (p->num_ready > 0) {
+    snapshot = gpr_malloc(sizeof(*snapshot) + p->num_ready * sizeof(size_t));
+    snapshot->num_ready = 0;
+    snapshot->ready_indexes = (size_t *)(snapshot + 1);
+    for (size_t i = 0; i < p->num_subchannels; i++) {
+      if (p->subchannels[i]->curr_connectivity_state == GRPC_CHANNEL_READY) {
+        snapshot->ready_indexes[snapshot->num_ready++] = i;
       }
-      return index;
     }
+    GPR_ASSERT(snapshot->num_ready == p->num_ready);
   }
+  ready_snapshot *old =
+      (ready_snapshot *)gpr_atm_acq_load(&p->ready_snapshot);
+  gpr_atm_rel_store(&p->ready_snapshot, (gpr_atm)snapshot);
+  gpr_free(old);
   if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
-    gpr_log(GPR_DEBUG, "[RR %p] no subchannels in ready state", p);
+    gpr_log(GPR_DEBUG, "[RR %p] published ready snapshot with %lu subchannels",
+            (void *)p, (unsigned long)(snapshot == NULL ? 0
+                                                        : snapshot->num_ready));
   }
-  return p->num_subchannels;
 }
 
-// Sets p->last_ready_subchannel_index to last_ready_index.
-static void update_last_ready_subchannel_index_locked(round_robin_lb_policy *p,
-                                                      size_t last_ready_index) {
-  GPR_ASSERT(last_ready_index < p->num_subchannels);
-  p->last_ready_subchannel_index = last_ready_index;
+/** Returns the index into p->subchannels of the next subchannel in READY
+ * state, or p->num_subchannels if no subchannel is READY. Consumes one slot
+ * in the rotation. */
+static size_t pick_ready_subchannel_index(round_robin_lb_policy *p) {
+  ready_snapshot *snapshot =
+      (ready_snapshot *)gpr_atm_acq_load(&p->ready_snapshot);
+  if (snapshot == NULL) {
+    if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
+      gpr_log(GPR_DEBUG, "[RR %p] no subchannels in ready state", (void *)p);
+    }
+    return p->num_subchannels;
+  }
+  const size_t position = (size_t)gpr_atm_full_fetch_add(&p->pick_counter, 1);
+  const size_t index = snapshot->ready_indexes[position % snapshot->num_ready];
   if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
-    gpr_log(GPR_DEBUG,
-            "[RR: %p] setting last_ready_subchannel_index=%lu (SC %p, CSC %p)",
-            (void *)p, (unsigned long)last_ready_index,
-            (void *)p->subchannels[last_ready_index].subchannel,
-            (void *)grpc_subchannel_get_connected_subchannel(
-                p->subchannels[last_ready_index].subchannel));
+    gpr_log(GPR_DEBUG, "[RR %p] found next ready subchannel at index %lu",
+            (void *)p, (unsigned long)index);
   }
+  return index;
+}
+
+/** Like \a pick_ready_subchannel_index, but doesn't advance the rotation.
+ * Used for pings, which shouldn't perturb the distribution of picks. */
+static size_t peek_ready_subchannel_index(round_robin_lb_policy *p) {
+  ready_snapshot *snapshot =
+      (ready_snapshot *)gpr_atm_acq_load(&p->ready_snapshot);
+  if (snapshot == NULL) return p->num_subchannels;
+  const size_t position = (size_t)gpr_atm_no_barrier_load(&p->pick_counter);
+  return snapshot->ready_indexes[position % snapshot->num_ready];
 }
 
 static void rr_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
@@ -211,7 +236,7 @@ static void rr_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
     gpr_log(GPR_DEBUG, "Destroying Round Robin policy at %p", (void *)pol);
   }
   for (size_t i = 0; i < p->num_subchannels; i++) {
-    subchannel_data *sd = &p->subchannels[i];
+    subchannel_data *sd = p->subchannels[i];
     if (sd->subchannel != NULL) {
       GRPC_SUBCHANNEL_UNREF(exec_ctx, sd->subchannel, "rr_destroy");
       if (sd->user_data != NULL) {
@@ -219,8 +244,10 @@ static void rr_destroy(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
         sd->user_data_vtable->destroy(exec_ctx, sd->user_data);
       }
     }
+    gpr_free(sd);
   }
   grpc_connectivity_state_destroy(exec_ctx, &p->state_tracker);
+  gpr_free((ready_snapshot *)gpr_atm_acq_load(&p->ready_snapshot));
   gpr_free(p->subchannels);
   gpr_free(p);
 }
@@ -244,7 +271,7 @@ static void rr_shutdown_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol) {
       exec_ctx, &p->state_tracker, GRPC_CHANNEL_SHUTDOWN,
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Channel Shutdown"), "rr_shutdown");
   for (size_t i = 0; i < p->num_subchannels; i++) {
-    subchannel_data *sd = &p->subchannels[i];
+    subchannel_data *sd = p->subchannels[i];
     if (sd->subchannel != NULL) {
       grpc_subchannel_notify_on_state_change(exec_ctx, sd->subchannel, NULL,
                                              NULL,
@@ -305,7 +332,7 @@ static void start_picking_locked(grpc_exec_ctx *exec_ctx,
                                  round_robin_lb_policy *p) {
   p->started_picking = true;
   for (size_t i = 0; i < p->num_subchannels; i++) {
-    subchannel_data *sd = &p->subchannels[i];
+    subchannel_data *sd = p->subchannels[i];
     if (sd->subchannel != NULL) {
       GRPC_LB_POLICY_WEAK_REF(&p->base, "rr_connectivity");
       grpc_subchannel_notify_on_state_change(
@@ -332,10 +359,10 @@ static int rr_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
   if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO, "Round Robin %p trying to pick", (void *)pol);
   }
-  const size_t next_ready_index = get_next_ready_subchannel_index_locked(p);
+  const size_t next_ready_index = pick_ready_subchannel_index(p);
   if (next_ready_index < p->num_subchannels) {
     /* readily available, report right away */
-    subchannel_data *sd = &p->subchannels[next_ready_index];
+    subchannel_data *sd = p->subchannels[next_ready_index];
     *target = GRPC_CONNECTED_SUBCHANNEL_REF(
         grpc_subchannel_get_connected_subchannel(sd->subchannel), "rr_picked");
     if (user_data != NULL) {
@@ -346,8 +373,6 @@ static int rr_pick_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
               "[RR PICK] TARGET <-- CONNECTED SUBCHANNEL %p (INDEX %lu)",
               (void *)*target, (unsigned long)next_ready_index);
     }
-    /* only advance the last picked pointer if the selection was used */
-    update_last_ready_subchannel_index_locked(p, next_ready_index);
     return 1;
   } else {
     /* no pick currently available. Save for later in list of pending picks */
@@ -445,6 +470,18 @@ static void rr_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
                                            grpc_error *error) {
   subchannel_data *sd = arg;
   round_robin_lb_policy *p = sd->policy;
+  // If the entry was shed by an address-list update, its watcher was
+  // cancelled and can no longer fire: release the entry now.
+  if (sd->removed) {
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, sd->subchannel, "rr_update_removed");
+    if (sd->user_data != NULL) {
+      GPR_ASSERT(sd->user_data_vtable != NULL);
+      sd->user_data_vtable->destroy(exec_ctx, sd->user_data);
+    }
+    gpr_free(sd);
+    GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "rr_connectivity");
+    return;
+  }
   // Now that we're inside the combiner, copy the pending connectivity
   // state (which was set by the connectivity state watcher) to
   // curr_connectivity_state, which is what we use inside of the combiner.
@@ -461,8 +498,13 @@ static void rr_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
     GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "rr_connectivity");
     return;
   }
-  // Update state counters and determine new overall state.
+  // Update state counters, publish a new ready snapshot if the READY
+  // membership changed, and determine new overall state.
   update_state_counters_locked(sd);
+  if (sd->prev_connectivity_state == GRPC_CHANNEL_READY ||
+      sd->curr_connectivity_state == GRPC_CHANNEL_READY) {
+    update_ready_snapshot_locked(p);
+  }
   sd->prev_connectivity_state = sd->curr_connectivity_state;
   grpc_connectivity_state new_connectivity_state =
       update_lb_connectivity_status_locked(exec_ctx, sd, GRPC_ERROR_REF(error));
@@ -488,18 +530,14 @@ static void rr_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
     /* unref the "rr_connectivity" weak ref from start_picking */
     GRPC_LB_POLICY_WEAK_UNREF(exec_ctx, &p->base, "rr_connectivity");
   } else {
-    if (sd->curr_connectivity_state == GRPC_CHANNEL_READY) {
+    if (sd->curr_connectivity_state == GRPC_CHANNEL_READY &&
+        p->pending_picks != NULL) {
       /* at this point we know there's at least one suitable subchannel. Go
        * ahead and pick one and notify the pending suitors in
        * p->pending_picks. This preemtively replicates rr_pick()'s actions. */
-      const size_t next_ready_index = get_next_ready_subchannel_index_locked(p);
+      const size_t next_ready_index = pick_ready_subchannel_index(p);
       GPR_ASSERT(next_ready_index < p->num_subchannels);
-      subchannel_data *selected = &p->subchannels[next_ready_index];
-      if (p->pending_picks != NULL) {
-        /* if the selected subchannel is going to be used for the pending
-         * picks, update the last picked pointer */
-        update_last_ready_subchannel_index_locked(p, next_ready_index);
-      }
+      subchannel_data *selected = p->subchannels[next_ready_index];
       pending_pick *pp;
       while ((pp = p->pending_picks)) {
         p->pending_picks = pp->next;
@@ -527,6 +565,172 @@ static void rr_connectivity_changed_locked(grpc_exec_ctx *exec_ctx, void *arg,
   }
 }
 
+/** Creates a subchannel for \a address using the factory and channel args in
+ * \a args. Returns NULL if the factory declines. */
+static grpc_subchannel *subchannel_for_address(grpc_exec_ctx *exec_ctx,
+                                               const grpc_lb_policy_args *args,
+                                               const grpc_lb_address *address) {
+  static const char *keys_to_remove[] = {GRPC_ARG_SUBCHANNEL_ADDRESS};
+  grpc_subchannel_args sc_args;
+  memset(&sc_args, 0, sizeof(grpc_subchannel_args));
+  grpc_arg addr_arg = grpc_create_subchannel_address_arg(&address->address);
+  grpc_channel_args *new_args = grpc_channel_args_copy_and_add_and_remove(
+      args->args, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove), &addr_arg,
+      1);
+  gpr_free(addr_arg.value.string);
+  sc_args.args = new_args;
+  grpc_subchannel *subchannel = grpc_client_channel_factory_create_subchannel(
+      exec_ctx, args->client_channel_factory, &sc_args);
+  grpc_channel_args_destroy(exec_ctx, new_args);
+  return subchannel;
+}
+
+/** Allocates and initializes a subchannel_data owning a ref to
+ * \a subchannel, registering its connectivity watcher if picking has
+ * started. */
+static subchannel_data *subchannel_data_create(
+    grpc_exec_ctx *exec_ctx, round_robin_lb_policy *p,
+    grpc_subchannel *subchannel,
+    const grpc_lb_user_data_vtable *user_data_vtable, void *user_data,
+    grpc_combiner *combiner) {
+  subchannel_data *sd = gpr_zalloc(sizeof(*sd));
+  sd->policy = p;
+  sd->subchannel = subchannel;
+  /* use some sentinel value outside of the range of grpc_connectivity_state
+   * to signal an undefined previous state. We won't be referring to this
+   * value again and it'll be overwritten after the first call to
+   * rr_connectivity_changed */
+  sd->prev_connectivity_state = GRPC_CHANNEL_INIT;
+  sd->curr_connectivity_state = GRPC_CHANNEL_IDLE;
+  sd->user_data_vtable = user_data_vtable;
+  if (sd->user_data_vtable != NULL) {
+    sd->user_data = sd->user_data_vtable->copy(user_data);
+  }
+  grpc_closure_init(&sd->connectivity_changed_closure,
+                    rr_connectivity_changed_locked, sd,
+                    grpc_combiner_scheduler(combiner, false));
+  if (p->started_picking) {
+    GRPC_LB_POLICY_WEAK_REF(&p->base, "rr_connectivity");
+    grpc_subchannel_notify_on_state_change(
+        exec_ctx, sd->subchannel, p->base.interested_parties,
+        &sd->pending_connectivity_state_unsafe,
+        &sd->connectivity_changed_closure);
+  }
+  return sd;
+}
+
+/** Sheds \a sd from the policy. If its watcher is active the entry is only
+ * marked removed here; the final release happens in
+ * \a rr_connectivity_changed_locked once the cancellation notification
+ * arrives. */
+static void remove_subchannel_locked(grpc_exec_ctx *exec_ctx,
+                                     round_robin_lb_policy *p,
+                                     subchannel_data *sd) {
+  if (sd->subchannel == NULL) {
+    /* already went through SHUTDOWN in rr_connectivity_changed_locked; the
+     * entry is inert */
+    gpr_free(sd);
+    return;
+  }
+  /* uncount the state the entry was last counted under. Entries that never
+   * saw a connectivity change (prev still at the sentinel) were never
+   * counted */
+  if (sd->prev_connectivity_state != GRPC_CHANNEL_INIT) {
+    if (sd->curr_connectivity_state == GRPC_CHANNEL_READY) {
+      GPR_ASSERT(p->num_ready > 0);
+      --p->num_ready;
+    } else if (sd->curr_connectivity_state ==
+               GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      GPR_ASSERT(p->num_transient_failures > 0);
+      --p->num_transient_failures;
+    } else if (sd->curr_connectivity_state == GRPC_CHANNEL_IDLE) {
+      GPR_ASSERT(p->num_idle > 0);
+      --p->num_idle;
+    }
+  }
+  if (p->started_picking) {
+    sd->removed = true;
+    grpc_subchannel_notify_on_state_change(exec_ctx, sd->subchannel, NULL,
+                                           NULL,
+                                           &sd->connectivity_changed_closure);
+  } else {
+    /* no watcher was ever registered: release directly */
+    GRPC_SUBCHANNEL_UNREF(exec_ctx, sd->subchannel, "rr_update_removed");
+    if (sd->user_data != NULL) {
+      GPR_ASSERT(sd->user_data_vtable != NULL);
+      sd->user_data_vtable->destroy(exec_ctx, sd->user_data);
+    }
+    gpr_free(sd);
+  }
+}
+
+static void rr_update_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
+                             const grpc_lb_policy_args *args) {
+  round_robin_lb_policy *p = (round_robin_lb_policy *)pol;
+  if (p->shutdown) return;
+  const grpc_arg *arg =
+      grpc_channel_args_find(args->args, GRPC_ARG_LB_ADDRESSES);
+  if (arg == NULL || arg->type != GRPC_ARG_POINTER) return;
+  grpc_lb_addresses *addresses = arg->value.pointer.p;
+  size_t num_addrs = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (!addresses->addresses[i].is_balancer) ++num_addrs;
+  }
+  subchannel_data **new_subchannels =
+      num_addrs == 0 ? NULL
+                     : gpr_zalloc(sizeof(*new_subchannels) * num_addrs);
+  size_t new_count = 0;
+  size_t num_carried = 0;
+  for (size_t i = 0; i < addresses->num_addresses; i++) {
+    if (addresses->addresses[i].is_balancer) continue;
+    grpc_subchannel *subchannel =
+        subchannel_for_address(exec_ctx, args, &addresses->addresses[i]);
+    if (subchannel == NULL) continue;
+    /* the subchannel index yields one object per distinct address, so a
+     * pointer match identifies an address present in both lists: carry the
+     * entry - connectivity state, watcher and all - over unchanged */
+    subchannel_data *sd = NULL;
+    for (size_t j = 0; j < p->num_subchannels; j++) {
+      subchannel_data *old_sd = p->subchannels[j];
+      if (old_sd != NULL && old_sd->subchannel == subchannel) {
+        sd = old_sd;
+        p->subchannels[j] = NULL;
+        break;
+      }
+    }
+    if (sd != NULL) {
+      /* the carried-over entry already owns a ref; drop the one just taken */
+      GRPC_SUBCHANNEL_UNREF(exec_ctx, subchannel, "rr_update_duplicate");
+      ++num_carried;
+    } else {
+      sd = subchannel_data_create(exec_ctx, p, subchannel,
+                                  addresses->user_data_vtable,
+                                  addresses->addresses[i].user_data,
+                                  args->combiner);
+    }
+    new_subchannels[new_count++] = sd;
+  }
+  /* shed the entries whose address disappeared */
+  size_t num_removed = 0;
+  for (size_t j = 0; j < p->num_subchannels; j++) {
+    if (p->subchannels[j] != NULL) {
+      remove_subchannel_locked(exec_ctx, p, p->subchannels[j]);
+      ++num_removed;
+    }
+  }
+  gpr_free(p->subchannels);
+  p->subchannels = new_subchannels;
+  p->num_subchannels = new_count;
+  p->num_addresses = num_addrs;
+  update_ready_snapshot_locked(p);
+  if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
+    gpr_log(GPR_DEBUG,
+            "[RR %p] updated: %lu subchannels (%lu carried over, %lu removed)",
+            (void *)p, (unsigned long)new_count, (unsigned long)num_carried,
+            (unsigned long)num_removed);
+  }
+}
+
 static grpc_connectivity_state rr_check_connectivity_locked(
     grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol, grpc_error **error) {
   round_robin_lb_policy *p = (round_robin_lb_policy *)pol;
@@ -545,9 +749,9 @@ static void rr_notify_on_state_change_locked(grpc_exec_ctx *exec_ctx,
 static void rr_ping_one_locked(grpc_exec_ctx *exec_ctx, grpc_lb_policy *pol,
                                grpc_closure *closure) {
   round_robin_lb_policy *p = (round_robin_lb_policy *)pol;
-  const size_t next_ready_index = get_next_ready_subchannel_index_locked(p);
+  const size_t next_ready_index = peek_ready_subchannel_index(p);
   if (next_ready_index < p->num_subchannels) {
-    subchannel_data *selected = &p->subchannels[next_ready_index];
+    subchannel_data *selected = p->subchannels[next_ready_index];
     grpc_connected_subchannel *target = GRPC_CONNECTED_SUBCHANNEL_REF(
         grpc_subchannel_get_connected_subchannel(selected->subchannel),
         "rr_picked");
@@ -568,7 +772,9 @@ static const grpc_lb_policy_vtable round_robin_lb_policy_vtable = {
     rr_ping_one_locked,
     rr_exit_idle_locked,
     rr_check_connectivity_locked,
-    rr_notify_on_state_change_locked};
+    rr_notify_on_state_change_locked,
+    rr_update_locked,
+    false /* cacheable_picks: each pick advances the rotation */};
 
 static void round_robin_factory_ref(grpc_lb_policy_factory *factory) {}
 
@@ -598,23 +804,13 @@ static grpc_lb_policy *round_robin_create(grpc_exec_ctx *exec_ctx,
   p->num_addresses = num_addrs;
   p->subchannels = gpr_zalloc(sizeof(*p->subchannels) * num_addrs);
 
-  grpc_subchannel_args sc_args;
   size_t subchannel_index = 0;
   for (size_t i = 0; i < addresses->num_addresses; i++) {
     /* Skip balancer addresses, since we only know how to handle backends. */
     if (addresses->addresses[i].is_balancer) continue;
 
-    static const char *keys_to_remove[] = {GRPC_ARG_SUBCHANNEL_ADDRESS};
-    memset(&sc_args, 0, sizeof(grpc_subchannel_args));
-    grpc_arg addr_arg =
-        grpc_create_subchannel_address_arg(&addresses->addresses[i].address);
-    grpc_channel_args *new_args = grpc_channel_args_copy_and_add_and_remove(
-        args->args, keys_to_remove, GPR_ARRAY_SIZE(keys_to_remove), &addr_arg,
-        1);
-    gpr_free(addr_arg.value.string);
-    sc_args.args = new_args;
-    grpc_subchannel *subchannel = grpc_client_channel_factory_create_subchannel(
-        exec_ctx, args->client_channel_factory, &sc_args);
+    grpc_subchannel *subchannel =
+        subchannel_for_address(exec_ctx, args, &addresses->addresses[i]);
     if (GRPC_TRACER_ON(grpc_lb_round_robin_trace)) {
       char *address_uri =
           grpc_sockaddr_to_uri(&addresses->addresses[i].address);
@@ -622,27 +818,11 @@ static grpc_lb_policy *round_robin_create(grpc_exec_ctx *exec_ctx,
               (unsigned long)subchannel_index, (void *)subchannel, address_uri);
       gpr_free(address_uri);
     }
-    grpc_channel_args_destroy(exec_ctx, new_args);
 
     if (subchannel != NULL) {
-      subchannel_data *sd = &p->subchannels[subchannel_index];
-      sd->policy = p;
-      sd->subchannel = subchannel;
-      /* use some sentinel value outside of the range of grpc_connectivity_state
-       * to signal an undefined previous state. We won't be referring to this
-       * value again and it'll be overwritten after the first call to
-       * rr_connectivity_changed */
-      sd->prev_connectivity_state = GRPC_CHANNEL_INIT;
-      sd->curr_connectivity_state = GRPC_CHANNEL_IDLE;
-      sd->user_data_vtable = addresses->user_data_vtable;
-      if (sd->user_data_vtable != NULL) {
-        sd->user_data =
-            sd->user_data_vtable->copy(addresses->addresses[i].user_data);
-      }
-      grpc_closure_init(&sd->connectivity_changed_closure,
-                        rr_connectivity_changed_locked, sd,
-                        grpc_combiner_scheduler(args->combiner, false));
-      ++subchannel_index;
+      p->subchannels[subchannel_index++] = subchannel_data_create(
+          exec_ctx, p, subchannel, addresses->user_data_vtable,
+          addresses->addresses[i].user_data, args->combiner);
     }
   }
   if (subchannel_index == 0) {
@@ -653,10 +833,6 @@ static grpc_lb_policy *round_robin_create(grpc_exec_ctx *exec_ctx,
   }
   p->num_subchannels = subchannel_index;
 
-  // Initialize the last pick index to the last subchannel, so that the
-  // first pick will start at the beginning of the list.
-  p->last_ready_subchannel_index = subchannel_index - 1;
-
   grpc_lb_policy_init(&p->base, &round_robin_lb_policy_vtable, args->combiner);
   grpc_connectivity_state_init(&p->state_tracker, GRPC_CHANNEL_IDLE,
                                "round_robin");
@@ -323,12 +323,15 @@ static grpc_resolver_factory *dns_ares_resolver_factory_create() {
 
 void grpc_resolver_dns_ares_init(void) {
   char *resolver = gpr_getenv("GRPC_DNS_RESOLVER");
-  /* TODO(zyc): Turn on c-ares based resolver by default after the address
-     sorter and the CNAME support are added. */
-  if (resolver != NULL && gpr_stricmp(resolver, "ares") == 0) {
+  /* c-ares drives queries through iomgr pollsets, so it is the default
+     grpc_resolve_address engine whenever it is compiled in: no thread ever
+     blocks in getaddrinfo(). GRPC_DNS_RESOLVER=native opts back into the
+     getaddrinfo()-on-executor path. */
+  if (resolver == NULL || gpr_stricmp(resolver, "native") != 0) {
     grpc_error *error = grpc_ares_init();
     if (error != GRPC_ERROR_NONE) {
       GRPC_LOG_IF_ERROR("ares_library_init() failed", error);
+      gpr_free(resolver);
       return;
     }
     grpc_resolve_address = grpc_resolve_address_ares;
@@ -339,7 +342,7 @@ void grpc_resolver_dns_ares_init(void) {
 
 void grpc_resolver_dns_ares_shutdown(void) {
   char *resolver = gpr_getenv("GRPC_DNS_RESOLVER");
-  if (resolver != NULL && gpr_stricmp(resolver, "ares") == 0) {
+  if (resolver == NULL || gpr_stricmp(resolver, "native") != 0) {
     grpc_ares_cleanup();
   }
   gpr_free(resolver);
@@ -54,11 +54,17 @@
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/sockaddr_utils.h"
 #include "src/core/lib/support/string.h"
 
 static gpr_once g_basic_init = GPR_ONCE_INIT;
 static gpr_mu g_init_mu;
+static int g_init_count;
+
+/** How long a successful resolution stays fresh. ares_gethostbyname does not
+    surface the records' TTLs, so a fixed window stands in for them. */
+#define GRPC_ARES_RESOLUTION_CACHE_FRESHNESS_SECONDS 30
 
 typedef struct grpc_ares_request {
   /** indicates the DNS server to use, if specified */
@@ -87,7 +93,52 @@ typedef struct grpc_ares_request {
   grpc_error *error;
 } grpc_ares_request;
 
-static void do_basic_init(void) { gpr_mu_init(&g_init_mu); }
+/** A request waiting on an in-flight query for the same name, so that
+    channels sharing a target share one wire query instead of racing. */
+typedef struct res_cache_waiter {
+  grpc_closure *on_done;
+  grpc_resolved_addresses **addrs_out;
+  struct res_cache_waiter *next;
+} res_cache_waiter;
+
+/** Process-wide cache of resolution results, keyed by the name and default
+    port handed to \a grpc_dns_lookup_ares. Fresh results are served without
+    touching the network; stale results are served immediately while a single
+    revalidating query refreshes the entry in the background. Queries against
+    an explicitly specified DNS server bypass the cache. */
+typedef struct res_cache_entry {
+  char *name;
+  char *default_port;
+  /** last successful result, or NULL before the first success */
+  grpc_resolved_addresses *addrs;
+  /** monotonic time at which \a addrs stops being fresh */
+  gpr_timespec expiry;
+  /** is a query for this name in flight? */
+  bool resolving;
+  /** storage for the in-flight query's result */
+  grpc_resolved_addresses *pending_addrs;
+  /** fires when the in-flight query completes */
+  grpc_closure on_resolved;
+  /** requests to complete when the in-flight query does */
+  res_cache_waiter *waiters;
+  struct res_cache_entry *next;
+} res_cache_entry;
+
+static gpr_mu g_res_cache_mu;
+static res_cache_entry *g_res_cache;
+/** Pollset set for background revalidating queries.  By the time such a
+    query is in flight the caller's on_done has already run, so the
+    caller's interested_parties may be destroyed at any moment; the cache
+    polls through its own set instead.  Created on first use and never
+    destroyed, like the mutex above: in-flight queries reference it from
+    their event drivers with no completion signal to order a teardown
+    against. */
+static grpc_pollset_set *g_res_cache_pollset_set;
+
+static void do_basic_init(void) {
+  gpr_mu_init(&g_init_mu);
+  gpr_mu_init(&g_res_cache_mu);
+}
 
 static uint16_t strhtons(const char *port) {
   if (strcmp(port, "http") == 0) {
@@ -197,11 +248,12 @@ static void on_done_cb(void *arg, int status, int timeouts,
   grpc_ares_request_unref(NULL, r);
 }
 
-void grpc_dns_lookup_ares(grpc_exec_ctx *exec_ctx, const char *dns_server,
-                          const char *name, const char *default_port,
-                          grpc_pollset_set *interested_parties,
-                          grpc_closure *on_done,
-                          grpc_resolved_addresses **addrs) {
+static void grpc_dns_lookup_ares_impl(grpc_exec_ctx *exec_ctx,
+                                      const char *dns_server, const char *name,
+                                      const char *default_port,
+                                      grpc_pollset_set *interested_parties,
+                                      grpc_closure *on_done,
+                                      grpc_resolved_addresses **addrs) {
   grpc_error *error = GRPC_ERROR_NONE;
   /* TODO(zyc): Enable tracing after #9603 is checked in */
   /* if (grpc_dns_trace) {
@@ -294,6 +346,132 @@ error_cleanup:
   gpr_free(port);
 }
 
+static grpc_resolved_addresses *res_addrs_copy(
+    const grpc_resolved_addresses *src) {
+  grpc_resolved_addresses *dst = gpr_malloc(sizeof(*dst));
+  dst->naddrs = src->naddrs;
+  dst->addrs = gpr_malloc(sizeof(*dst->addrs) * src->naddrs);
+  memcpy(dst->addrs, src->addrs, sizeof(*dst->addrs) * src->naddrs);
+  return dst;
+}
+
+static bool str_eq_nullable(const char *a, const char *b) {
+  if (a == NULL || b == NULL) return a == b;
+  return strcmp(a, b) == 0;
+}
+
+/** Finds the cache entry for (\a name, \a default_port), creating it on first
+    use. Requires \a g_res_cache_mu. */
+static res_cache_entry *res_cache_find_locked(const char *name,
+                                              const char *default_port) {
+  res_cache_entry *entry;
+  for (entry = g_res_cache; entry != NULL; entry = entry->next) {
+    if (strcmp(entry->name, name) == 0 &&
+        str_eq_nullable(entry->default_port, default_port)) {
+      return entry;
+    }
+  }
+  entry = gpr_zalloc(sizeof(*entry));
+  entry->name = gpr_strdup(name);
+  entry->default_port = gpr_strdup(default_port);
+  entry->next = g_res_cache;
+  g_res_cache = entry;
+  return entry;
+}
+
+/** Called when the single in-flight query for a cache entry completes.
+    Refreshes the entry on success and fans the outcome out to all waiters. */
+static void res_cache_on_resolved(grpc_exec_ctx *exec_ctx, void *arg,
+                                  grpc_error *error) {
+  res_cache_entry *entry = arg;
+  gpr_mu_lock(&g_res_cache_mu);
+  entry->resolving = false;
+  if (entry->pending_addrs != NULL) {
+    if (entry->addrs != NULL) {
+      grpc_resolved_addresses_destroy(entry->addrs);
+    }
+    entry->addrs = entry->pending_addrs;
+    entry->pending_addrs = NULL;
+    entry->expiry = gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_seconds(GRPC_ARES_RESOLUTION_CACHE_FRESHNESS_SECONDS,
+                              GPR_TIMESPAN));
+  }
+  res_cache_waiter *waiters = entry->waiters;
+  entry->waiters = NULL;
+  /* Waiters only queue up when the entry holds no previous result, so a
+     failed query hands them NULL addresses and the query's error. */
+  while (waiters != NULL) {
+    res_cache_waiter *w = waiters;
+    waiters = w->next;
+    if (entry->addrs != NULL) {
+      *w->addrs_out = res_addrs_copy(entry->addrs);
+      grpc_closure_sched(exec_ctx, w->on_done, GRPC_ERROR_NONE);
+    } else {
+      *w->addrs_out = NULL;
+      grpc_closure_sched(exec_ctx, w->on_done, GRPC_ERROR_REF(error));
+    }
+    gpr_free(w);
+  }
+  gpr_mu_unlock(&g_res_cache_mu);
+}
+
+void grpc_dns_lookup_ares(grpc_exec_ctx *exec_ctx, const char *dns_server,
+                          const char *name, const char *default_port,
+                          grpc_pollset_set *interested_parties,
+                          grpc_closure *on_done,
+                          grpc_resolved_addresses **addrs) {
+  /* Queries against an explicitly specified server must hit that server. */
+  if (dns_server != NULL) {
+    grpc_dns_lookup_ares_impl(exec_ctx, dns_server, name, default_port,
+                              interested_parties, on_done, addrs);
+    return;
+  }
+  gpr_mu_lock(&g_res_cache_mu);
+  res_cache_entry *entry = res_cache_find_locked(name, default_port);
+  if (entry->addrs != NULL) {
+    /* Serve from the cache without a round trip; a stale entry additionally
+       gets one revalidating query in the background so the next consumer
+       observes fresh addresses. */
+    bool fresh = gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), entry->expiry) < 0;
+    *addrs = res_addrs_copy(entry->addrs);
+    bool start_revalidation = !fresh && !entry->resolving;
+    if (start_revalidation) {
+      entry->resolving = true;
+      if (g_res_cache_pollset_set == NULL) {
+        g_res_cache_pollset_set = grpc_pollset_set_create();
+      }
+    }
+    gpr_mu_unlock(&g_res_cache_mu);
+    grpc_closure_sched(exec_ctx, on_done, GRPC_ERROR_NONE);
+    if (start_revalidation) {
+      grpc_dns_lookup_ares_impl(exec_ctx, NULL, name, default_port,
+                                g_res_cache_pollset_set, &entry->on_resolved,
+                                &entry->pending_addrs);
+    }
+    return;
+  }
+  /* No result yet: join the in-flight query if there is one, so channels
+     sharing a target share a single wire query. */
+  res_cache_waiter *waiter = gpr_malloc(sizeof(*waiter));
+  waiter->on_done = on_done;
+  waiter->addrs_out = addrs;
+  waiter->next = entry->waiters;
+  entry->waiters = waiter;
+  bool start_query = !entry->resolving;
+  if (start_query) {
+    entry->resolving = true;
+    grpc_closure_init(&entry->on_resolved, res_cache_on_resolved, entry,
+                      grpc_schedule_on_exec_ctx);
+  }
+  gpr_mu_unlock(&g_res_cache_mu);
+  if (start_query) {
+    grpc_dns_lookup_ares_impl(exec_ctx, NULL, name, default_port,
+                              interested_parties, &entry->on_resolved,
+                              &entry->pending_addrs);
+  }
+}
+
 void grpc_resolve_address_ares_impl(grpc_exec_ctx *exec_ctx, const char *name,
                                     const char *default_port,
                                     grpc_pollset_set *interested_parties,
@@ -311,6 +489,7 @@ void (*grpc_resolve_address_ares)(
 grpc_error *grpc_ares_init(void) {
   gpr_once_init(&g_basic_init, do_basic_init);
   gpr_mu_lock(&g_init_mu);
+  ++g_init_count;
   int status = ares_library_init(ARES_LIB_INIT_ALL);
   gpr_mu_unlock(&g_init_mu);
 
@@ -325,10 +504,33 @@ grpc_error *grpc_ares_init(void) {
   return GRPC_ERROR_NONE;
 }
 
+/** Drops all cached resolution results. Entries with a query still in flight
+    are kept: their completion closure will run and must find them alive. */
+static void res_cache_flush(void) {
+  gpr_mu_lock(&g_res_cache_mu);
+  res_cache_entry **pp = &g_res_cache;
+  while (*pp != NULL) {
+    res_cache_entry *entry = *pp;
+    if (entry->resolving) {
+      pp = &entry->next;
+      continue;
+    }
+    *pp = entry->next;
+    GPR_ASSERT(entry->waiters == NULL);
+    if (entry->addrs != NULL) grpc_resolved_addresses_destroy(entry->addrs);
+    gpr_free(entry->name);
+    gpr_free(entry->default_port);
+    gpr_free(entry);
+  }
+  gpr_mu_unlock(&g_res_cache_mu);
+}
+
 void grpc_ares_cleanup(void) {
   gpr_mu_lock(&g_init_mu);
+  bool last_cleanup = --g_init_count == 0;
   ares_library_cleanup();
   gpr_mu_unlock(&g_init_mu);
+  if (last_cleanup) res_cache_flush();
 }
 
 #endif /* GRPC_ARES == 1 && !defined(GRPC_UV) */
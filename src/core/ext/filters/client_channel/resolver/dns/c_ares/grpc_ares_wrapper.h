@@ -51,6 +51,12 @@ extern void (*grpc_resolve_address_ares)(grpc_exec_ctx *exec_ctx,
                                          grpc_closure *on_done,
                                          grpc_resolved_addresses **addresses);
 
+/* As above, but use \a dns_server if non-NULL instead of the system
+   configuration. Results are cached process-wide by (\a addr, \a
+   default_port): a fresh cached result is served without a network round
+   trip, a stale one is served immediately while a single background query
+   revalidates it, and concurrent lookups of an uncached name share one
+   query. Lookups with an explicit \a dns_server bypass the cache. */
 void grpc_dns_lookup_ares(grpc_exec_ctx *exec_ctx, const char *dns_server,
                           const char *addr, const char *default_port,
                           grpc_pollset_set *interested_parties,
@@ -114,12 +114,12 @@ static grpc_resolver_factory *resolve_factory(grpc_exec_ctx *exec_ctx,
   grpc_resolver_factory *factory = NULL;
 
   GPR_ASSERT(uri != NULL);
-  *uri = grpc_uri_parse(exec_ctx, target, 1);
+  *uri = grpc_uri_ref_parsed(exec_ctx, target, 1);
   factory = lookup_factory_by_uri(*uri);
   if (factory == NULL) {
-    grpc_uri_destroy(*uri);
+    grpc_uri_unref(*uri);
     gpr_asprintf(canonical_target, "%s%s", g_default_resolver_prefix, target);
-    *uri = grpc_uri_parse(exec_ctx, *canonical_target, 1);
+    *uri = grpc_uri_ref_parsed(exec_ctx, *canonical_target, 1);
     factory = lookup_factory_by_uri(*uri);
     if (factory == NULL) {
       grpc_uri_destroy(grpc_uri_parse(exec_ctx, target, 0));
@@ -148,7 +148,7 @@ grpc_resolver *grpc_resolver_create(grpc_exec_ctx *exec_ctx, const char *target,
   resolver_args.combiner = combiner;
   resolver =
       grpc_resolver_factory_create_resolver(exec_ctx, factory, &resolver_args);
-  grpc_uri_destroy(uri);
+  grpc_uri_unref(uri);
   gpr_free(canonical_target);
   return resolver;
 }
@@ -159,7 +159,7 @@ char *grpc_get_default_authority(grpc_exec_ctx *exec_ctx, const char *target) {
   grpc_resolver_factory *factory =
       resolve_factory(exec_ctx, target, &uri, &canonical_target);
   char *authority = grpc_resolver_factory_get_default_authority(factory, uri);
-  grpc_uri_destroy(uri);
+  grpc_uri_unref(uri);
   gpr_free(canonical_target);
   return authority;
 }
@@ -169,6 +169,6 @@ char *grpc_resolver_factory_add_default_prefix_if_needed(
   grpc_uri *uri = NULL;
   char *canonical_target = NULL;
   resolve_factory(exec_ctx, target, &uri, &canonical_target);
-  grpc_uri_destroy(uri);
+  grpc_uri_unref(uri);
   return canonical_target == NULL ? gpr_strdup(target) : canonical_target;
 }
@@ -39,6 +39,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
 #include <grpc/support/avl.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 
@@ -46,17 +47,61 @@
 // server_retry_throttle_data
 //
 
+// Maximum number of stripes the token counter is split into.
+#define MAX_TOKEN_STRIPES 8
+
+// One stripe of the token counter, padded so that stripes hammered by
+// different cores do not share a cacheline.
+typedef struct {
+  gpr_atm milli_tokens;
+  char padding[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+} token_stripe;
+
 struct grpc_server_retry_throttle_data {
   gpr_refcount refs;
   int max_milli_tokens;
   int milli_token_ratio;
-  gpr_atm milli_tokens;
+  // The token counter is striped by CPU to avoid cacheline ping-pong at
+  // high failure rates.  Each stripe holds an equal share of
+  // max_milli_tokens and decisions are made against the local stripe, but
+  // tokens migrate between stripes when load is uneven: a drained stripe
+  // borrows from its peers before throttling, and a full stripe spills
+  // success credits into its peers.  The stripes together therefore
+  // always track the global token count.
+  size_t num_stripes;
+  int stripe_max_milli_tokens;
   // A pointer to the replacement for this grpc_server_retry_throttle_data
   // entry.  If non-NULL, then this entry is stale and must not be used.
   // We hold a reference to the replacement.
   gpr_atm replacement;
+  // Points just past this struct; allocated in the same block.
+  token_stripe* stripes;
 };
 
+static size_t compute_num_stripes(int max_milli_tokens) {
+  size_t num_stripes = gpr_cpu_num_cores();
+  if (num_stripes > MAX_TOKEN_STRIPES) num_stripes = MAX_TOKEN_STRIPES;
+  // Keep at least one whole token per stripe.
+  size_t max_useful = (size_t)(max_milli_tokens / 1000);
+  if (max_useful == 0) max_useful = 1;
+  if (num_stripes > max_useful) num_stripes = max_useful;
+  return num_stripes;
+}
+
+static token_stripe* current_stripe(
+    grpc_server_retry_throttle_data* throttle_data) {
+  return &throttle_data->stripes[gpr_cpu_current_cpu() %
+                                 throttle_data->num_stripes];
+}
+
+static int total_milli_tokens(grpc_server_retry_throttle_data* throttle_data) {
+  int total = 0;
+  for (size_t i = 0; i < throttle_data->num_stripes; ++i) {
+    total += (int)gpr_atm_acq_load(&throttle_data->stripes[i].milli_tokens);
+  }
+  return total;
+}
+
 static void get_replacement_throttle_data_if_needed(
     grpc_server_retry_throttle_data** throttle_data) {
   while (true) {
@@ -68,17 +113,62 @@ static void get_replacement_throttle_data_if_needed(
   }
 }
 
+// Moves up to \a needed milli-tokens from the other stripes into
+// \a stripe and returns the amount actually moved.  Donors are drained
+// with a CAS so the total token count across stripes is conserved.
+static int borrow_milli_tokens(grpc_server_retry_throttle_data* throttle_data,
+                               token_stripe* stripe, int needed) {
+  int borrowed = 0;
+  for (size_t i = 0;
+       i < throttle_data->num_stripes && borrowed < needed; ++i) {
+    token_stripe* donor = &throttle_data->stripes[i];
+    if (donor == stripe) continue;
+    for (;;) {
+      gpr_atm donor_tokens = gpr_atm_acq_load(&donor->milli_tokens);
+      gpr_atm take = donor_tokens;
+      if (take > (gpr_atm)(needed - borrowed)) {
+        take = (gpr_atm)(needed - borrowed);
+      }
+      if (take <= 0) break;
+      if (gpr_atm_full_cas(&donor->milli_tokens, donor_tokens,
+                           donor_tokens - take)) {
+        borrowed += (int)take;
+        break;
+      }
+    }
+  }
+  if (borrowed > 0) {
+    gpr_atm_no_barrier_clamped_add(
+        &stripe->milli_tokens, (gpr_atm)borrowed, (gpr_atm)0,
+        (gpr_atm)throttle_data->stripe_max_milli_tokens);
+  }
+  return borrowed;
+}
+
 bool grpc_server_retry_throttle_data_record_failure(
     grpc_server_retry_throttle_data* throttle_data) {
   // First, check if we are stale and need to be replaced.
   get_replacement_throttle_data_if_needed(&throttle_data);
-  // We decrement milli_tokens by 1000 (1 token) for each failure.
+  // We decrement milli_tokens by 1000 (1 token) for each failure, touching
+  // only the current CPU's stripe.
+  token_stripe* stripe = current_stripe(throttle_data);
+  const int threshold = throttle_data->stripe_max_milli_tokens / 2;
   const int new_value = (int)gpr_atm_no_barrier_clamped_add(
-      &throttle_data->milli_tokens, (gpr_atm)-1000, (gpr_atm)0,
-      (gpr_atm)throttle_data->max_milli_tokens);
+      &stripe->milli_tokens, (gpr_atm)-1000, (gpr_atm)0,
+      (gpr_atm)throttle_data->stripe_max_milli_tokens);
   // Retries are allowed as long as the new value is above the threshold
-  // (max_milli_tokens / 2).
-  return new_value > throttle_data->max_milli_tokens / 2;
+  // (stripe_max_milli_tokens / 2), the stripe's share of the global
+  // max_milli_tokens / 2 threshold.
+  if (new_value > threshold) return true;
+  // The local stripe is at or below its threshold, but that may just mean
+  // the load is concentrated on this CPU while the rest of the budget
+  // sits idle in the other stripes.  Refill the stripe from its peers
+  // before deciding to throttle; if the budget really is exhausted
+  // globally there is nothing to borrow and the answer stays no.
+  const int borrowed = borrow_milli_tokens(
+      throttle_data, stripe,
+      throttle_data->stripe_max_milli_tokens - new_value);
+  return new_value + borrowed > threshold;
 }
 
 void grpc_server_retry_throttle_data_record_success(
@@ -86,9 +176,27 @@ void grpc_server_retry_throttle_data_record_success(
   // First, check if we are stale and need to be replaced.
   get_replacement_throttle_data_if_needed(&throttle_data);
   // We increment milli_tokens by milli_token_ratio for each success.
-  gpr_atm_no_barrier_clamped_add(
-      &throttle_data->milli_tokens, (gpr_atm)throttle_data->milli_token_ratio,
-      (gpr_atm)0, (gpr_atm)throttle_data->max_milli_tokens);
+  // Whatever does not fit in the local stripe spills into the others, so
+  // credits earned on one CPU are not dropped while another stripe has
+  // room for them.
+  const size_t start =
+      gpr_cpu_current_cpu() % throttle_data->num_stripes;
+  int amount = throttle_data->milli_token_ratio;
+  for (size_t i = 0; i < throttle_data->num_stripes && amount > 0; ++i) {
+    token_stripe* stripe =
+        &throttle_data->stripes[(start + i) % throttle_data->num_stripes];
+    for (;;) {
+      gpr_atm tokens = gpr_atm_acq_load(&stripe->milli_tokens);
+      gpr_atm room =
+          (gpr_atm)throttle_data->stripe_max_milli_tokens - tokens;
+      if (room <= 0) break;
+      gpr_atm add = room < (gpr_atm)amount ? room : (gpr_atm)amount;
+      if (gpr_atm_full_cas(&stripe->milli_tokens, tokens, tokens + add)) {
+        amount -= (int)add;
+        break;
+      }
+    }
+  }
 }
 
 grpc_server_retry_throttle_data* grpc_server_retry_throttle_data_ref(
@@ -113,25 +221,33 @@ void grpc_server_retry_throttle_data_unref(
 static grpc_server_retry_throttle_data* grpc_server_retry_throttle_data_create(
     int max_milli_tokens, int milli_token_ratio,
     grpc_server_retry_throttle_data* old_throttle_data) {
-  grpc_server_retry_throttle_data* throttle_data =
-      gpr_malloc(sizeof(*throttle_data));
-  memset(throttle_data, 0, sizeof(*throttle_data));
+  const size_t num_stripes = compute_num_stripes(max_milli_tokens);
+  grpc_server_retry_throttle_data* throttle_data = gpr_malloc(
+      sizeof(*throttle_data) + sizeof(token_stripe) * num_stripes);
+  memset(throttle_data, 0,
+         sizeof(*throttle_data) + sizeof(token_stripe) * num_stripes);
   gpr_ref_init(&throttle_data->refs, 1);
   throttle_data->max_milli_tokens = max_milli_tokens;
   throttle_data->milli_token_ratio = milli_token_ratio;
-  int initial_milli_tokens = max_milli_tokens;
+  throttle_data->num_stripes = num_stripes;
+  throttle_data->stripe_max_milli_tokens =
+      max_milli_tokens / (int)num_stripes;
+  throttle_data->stripes = (token_stripe*)(throttle_data + 1);
+  int initial_stripe_milli_tokens = throttle_data->stripe_max_milli_tokens;
   // If there was a pre-existing entry for this server name, initialize
   // the token count by scaling proportionately to the old data.  This
   // ensures that if we're already throttling retries on the old scale,
   // we will start out doing the same thing on the new one.
   if (old_throttle_data != NULL) {
-    double token_fraction =
-        (int)gpr_atm_acq_load(&old_throttle_data->milli_tokens) /
-        (double)old_throttle_data->max_milli_tokens;
-    initial_milli_tokens = (int)(token_fraction * max_milli_tokens);
+    double token_fraction = total_milli_tokens(old_throttle_data) /
+                            (double)old_throttle_data->max_milli_tokens;
+    initial_stripe_milli_tokens =
+        (int)(token_fraction * throttle_data->stripe_max_milli_tokens);
+  }
+  for (size_t i = 0; i < num_stripes; ++i) {
+    gpr_atm_rel_store(&throttle_data->stripes[i].milli_tokens,
+                      (gpr_atm)initial_stripe_milli_tokens);
   }
-  gpr_atm_rel_store(&throttle_data->milli_tokens,
-                    (gpr_atm)initial_milli_tokens);
   // If there was a pre-existing entry, mark it as stale and give it a
   // pointer to the new entry, which is its replacement.
   if (old_throttle_data != NULL) {
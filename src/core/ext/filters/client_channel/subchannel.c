@@ -65,13 +65,17 @@
 #define GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS 120
 #define GRPC_SUBCHANNEL_RECONNECT_JITTER 0.2
 
-#define GET_CONNECTED_SUBCHANNEL(subchannel, barrier)      \
+#define GRPC_SUBCHANNEL_MAX_STRIPES 32
+
+#define GET_STRIPE(subchannel, idx, barrier)               \
   ((grpc_connected_subchannel *)(gpr_atm_##barrier##_load( \
-      &(subchannel)->connected_subchannel)))
+      &(subchannel)->stripes[idx])))
 
 typedef struct {
   grpc_closure closure;
   grpc_subchannel *subchannel;
+  /** the stripe this watcher is watching */
+  grpc_connected_subchannel *connection;
   grpc_connectivity_state connectivity_state;
 } state_watcher;
 
@@ -115,8 +119,15 @@ struct grpc_subchannel {
       being setup */
   grpc_pollset_set *pollset_set;
 
-  /** active connection, or null; of type grpc_connected_subchannel */
-  gpr_atm connected_subchannel;
+  /** number of parallel connections ("stripes") to maintain */
+  size_t num_stripes;
+  /** active connections, each of type grpc_connected_subchannel or null;
+      slots fill in order as connections are established */
+  gpr_atm *stripes;
+  /** number of stripes currently holding a connection */
+  gpr_atm num_connected_stripes;
+  /** round-robin cursor for spreading calls over connected stripes */
+  gpr_atm next_stripe;
 
   /** mutex protecting remaining elements */
   gpr_mu mu;
@@ -215,6 +226,7 @@ static void subchannel_destroy(grpc_exec_ctx *exec_ctx, void *arg,
   grpc_connector_unref(exec_ctx, c->connector);
   grpc_pollset_set_destroy(exec_ctx, c->pollset_set);
   grpc_subchannel_key_destroy(exec_ctx, c->key);
+  gpr_free(c->stripes);
   gpr_free(c);
 }
 
@@ -264,7 +276,6 @@ grpc_subchannel *grpc_subchannel_ref_from_weak_ref(
 }
 
 static void disconnect(grpc_exec_ctx *exec_ctx, grpc_subchannel *c) {
-  grpc_connected_subchannel *con;
   grpc_subchannel_index_unregister(exec_ctx, c->key, c);
   gpr_mu_lock(&c->mu);
   GPR_ASSERT(!c->disconnected);
@@ -272,10 +283,12 @@ static void disconnect(grpc_exec_ctx *exec_ctx, grpc_subchannel *c) {
   grpc_connector_shutdown(
       exec_ctx, c->connector,
       GRPC_ERROR_CREATE_FROM_STATIC_STRING("Subchannel disconnected"));
-  con = GET_CONNECTED_SUBCHANNEL(c, no_barrier);
-  if (con != NULL) {
-    GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, con, "connection");
-    gpr_atm_no_barrier_store(&c->connected_subchannel, (gpr_atm)0xdeadbeef);
+  for (size_t i = 0; i < c->num_stripes; i++) {
+    grpc_connected_subchannel *con = GET_STRIPE(c, i, no_barrier);
+    if (con != NULL) {
+      GRPC_CONNECTED_SUBCHANNEL_UNREF(exec_ctx, con, "connection");
+      gpr_atm_no_barrier_store(&c->stripes[i], (gpr_atm)0xdeadbeef);
+    }
   }
   gpr_mu_unlock(&c->mu);
 }
@@ -352,11 +365,16 @@ grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
                     grpc_schedule_on_exec_ctx);
   grpc_connectivity_state_init(&c->state_tracker, GRPC_CHANNEL_IDLE,
                                "subchannel");
+  // A subchannel may be watched by many channels at once; batch the
+  // notification fan-out so that an update storm does not serialize one
+  // watcher at a time under the subchannel's lock.
+  grpc_connectivity_state_enable_batched_notifications(&c->state_tracker);
   int initial_backoff_ms =
       GRPC_SUBCHANNEL_INITIAL_CONNECT_BACKOFF_SECONDS * 1000;
   int min_backoff_ms = GRPC_SUBCHANNEL_RECONNECT_MIN_BACKOFF_SECONDS * 1000;
   int max_backoff_ms = GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS * 1000;
   bool fixed_reconnect_backoff = false;
+  int num_stripes = 1;
   if (c->args) {
     for (size_t i = 0; i < c->args->num_args; i++) {
       if (0 == strcmp(c->args->args[i].key,
@@ -384,9 +402,16 @@ grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
         initial_backoff_ms = grpc_channel_arg_get_integer(
             &c->args->args[i],
             (grpc_integer_options){initial_backoff_ms, 100, INT_MAX});
+      } else if (0 == strcmp(c->args->args[i].key,
+                             GRPC_ARG_SUBCHANNEL_STRIPE_COUNT)) {
+        num_stripes = grpc_channel_arg_get_integer(
+            &c->args->args[i],
+            (grpc_integer_options){1, 1, GRPC_SUBCHANNEL_MAX_STRIPES});
       }
     }
   }
+  c->num_stripes = (size_t)num_stripes;
+  c->stripes = gpr_zalloc(sizeof(*c->stripes) * c->num_stripes);
   gpr_backoff_init(
       &c->backoff_state, initial_backoff_ms,
       fixed_reconnect_backoff ? 1.0
@@ -398,19 +423,23 @@ grpc_subchannel *grpc_subchannel_create(grpc_exec_ctx *exec_ctx,
   return grpc_subchannel_index_register(exec_ctx, key, c);
 }
 
-static void continue_connect_locked(grpc_exec_ctx *exec_ctx,
-                                    grpc_subchannel *c) {
+static void start_connect_locked(grpc_exec_ctx *exec_ctx, grpc_subchannel *c) {
   grpc_connect_in_args args;
 
   args.interested_parties = c->pollset_set;
   args.deadline = c->next_attempt;
   args.channel_args = c->args;
 
+  grpc_connector_connect(exec_ctx, c->connector, &args, &c->connecting_result,
+                         &c->connected);
+}
+
+static void continue_connect_locked(grpc_exec_ctx *exec_ctx,
+                                    grpc_subchannel *c) {
   grpc_connectivity_state_set(exec_ctx, &c->state_tracker,
                               GRPC_CHANNEL_CONNECTING, GRPC_ERROR_NONE,
                               "state_change");
-  grpc_connector_connect(exec_ctx, c->connector, &args, &c->connecting_result,
-                         &c->connected);
+  start_connect_locked(exec_ctx, c);
 }
 
 grpc_connectivity_state grpc_subchannel_check_connectivity(grpc_subchannel *c,
@@ -452,7 +481,7 @@ static void on_alarm(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
   if (error == GRPC_ERROR_NONE) {
     gpr_log(GPR_INFO, "Failed to connect to channel, retrying");
     c->next_attempt =
-        gpr_backoff_step(&c->backoff_state, gpr_now(GPR_CLOCK_MONOTONIC));
+        gpr_backoff_step(&c->backoff_state, grpc_exec_ctx_now(exec_ctx));
     continue_connect_locked(exec_ctx, c);
     gpr_mu_unlock(&c->mu);
   } else {
@@ -474,8 +503,9 @@ static void maybe_start_connecting_locked(grpc_exec_ctx *exec_ctx,
     return;
   }
 
-  if (GET_CONNECTED_SUBCHANNEL(c, no_barrier) != NULL) {
-    /* Already connected: don't restart */
+  if (gpr_atm_no_barrier_load(&c->num_connected_stripes) > 0) {
+    /* Already connected: don't restart. Additional stripes are filled from
+       the publish path, not from here. */
     return;
   }
 
@@ -487,7 +517,7 @@ static void maybe_start_connecting_locked(grpc_exec_ctx *exec_ctx,
   c->connecting = true;
   GRPC_SUBCHANNEL_WEAK_REF(c, "connecting");
 
-  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  gpr_timespec now = grpc_exec_ctx_now(exec_ctx);
   if (!c->backoff_begun) {
     c->backoff_begun = true;
     c->next_attempt = gpr_backoff_begin(&c->backoff_state, now);
@@ -573,8 +603,7 @@ static void subchannel_on_child_state_changed(grpc_exec_ctx *exec_ctx, void *p,
                               "reflect_child");
   if (sw->connectivity_state != GRPC_CHANNEL_SHUTDOWN) {
     grpc_connected_subchannel_notify_on_state_change(
-        exec_ctx, GET_CONNECTED_SUBCHANNEL(c, no_barrier), NULL,
-        &sw->connectivity_state, &sw->closure);
+        exec_ctx, sw->connection, NULL, &sw->connectivity_state, &sw->closure);
     GRPC_SUBCHANNEL_WEAK_REF(c, "state_watcher");
     sw = NULL;
   }
@@ -649,6 +678,7 @@ static bool publish_transport_locked(grpc_exec_ctx *exec_ctx,
   /* initialize state watcher */
   sw_subchannel = gpr_malloc(sizeof(*sw_subchannel));
   sw_subchannel->subchannel = c;
+  sw_subchannel->connection = con;
   sw_subchannel->connectivity_state = GRPC_CHANNEL_READY;
   grpc_closure_init(&sw_subchannel->closure, subchannel_on_child_state_changed,
                     sw_subchannel, grpc_schedule_on_exec_ctx);
@@ -660,25 +690,40 @@ static bool publish_transport_locked(grpc_exec_ctx *exec_ctx,
     return false;
   }
 
-  /* publish */
+  /* publish into the next empty stripe */
+  size_t stripe = (size_t)gpr_atm_no_barrier_load(&c->num_connected_stripes);
+  GPR_ASSERT(stripe < c->num_stripes);
   /* TODO(ctiller): this full barrier seems to clear up a TSAN failure.
                     I'd have expected the rel_cas below to be enough, but
                     seemingly it's not.
                     Re-evaluate if we really need this. */
   gpr_atm_full_barrier();
-  GPR_ASSERT(gpr_atm_rel_cas(&c->connected_subchannel, 0, (gpr_atm)con));
+  GPR_ASSERT(gpr_atm_rel_cas(&c->stripes[stripe], 0, (gpr_atm)con));
+  gpr_atm_rel_store(&c->num_connected_stripes, (gpr_atm)(stripe + 1));
 
-  /* setup subchannel watching connected subchannel for changes; subchannel
-     ref for connecting is donated to the state watcher */
+  /* setup subchannel watching connected subchannel for changes */
   GRPC_SUBCHANNEL_WEAK_REF(c, "state_watcher");
-  GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c, "connecting");
   grpc_connected_subchannel_notify_on_state_change(
       exec_ctx, con, c->pollset_set, &sw_subchannel->connectivity_state,
       &sw_subchannel->closure);
 
-  /* signal completion */
-  grpc_connectivity_state_set(exec_ctx, &c->state_tracker, GRPC_CHANNEL_READY,
-                              GRPC_ERROR_NONE, "connected");
+  /* signal completion once the first stripe is up; calls can start while the
+     remaining stripes are still being dialed */
+  if (stripe == 0) {
+    grpc_connectivity_state_set(exec_ctx, &c->state_tracker, GRPC_CHANNEL_READY,
+                                GRPC_ERROR_NONE, "connected");
+  }
+
+  if (stripe + 1 < c->num_stripes) {
+    /* keep dialing until every stripe has a connection; the "connecting"
+       weak ref is carried over to the next attempt */
+    c->connecting = true;
+    c->next_attempt =
+        gpr_backoff_begin(&c->backoff_state, grpc_exec_ctx_now(exec_ctx));
+    start_connect_locked(exec_ctx, c);
+  } else {
+    GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c, "connecting");
+  }
   return true;
 }
 
@@ -695,6 +740,12 @@ static void subchannel_connected(grpc_exec_ctx *exec_ctx, void *arg,
     /* do nothing, transport was published */
   } else if (c->disconnected) {
     GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c, "connecting");
+  } else if (gpr_atm_no_barrier_load(&c->num_connected_stripes) > 0) {
+    /* a stripe beyond the first failed to come up: run with the stripes we
+       have rather than disturbing the established connection's state */
+    const char *errmsg = grpc_error_string(error);
+    gpr_log(GPR_INFO, "Stripe connect failed: %s", errmsg);
+    GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, c, "connecting");
   } else {
     grpc_connectivity_state_set(
         exec_ctx, &c->state_tracker, GRPC_CHANNEL_TRANSIENT_FAILURE,
@@ -767,7 +818,13 @@ void grpc_subchannel_call_process_op(grpc_exec_ctx *exec_ctx,
 
 grpc_connected_subchannel *grpc_subchannel_get_connected_subchannel(
     grpc_subchannel *c) {
-  return GET_CONNECTED_SUBCHANNEL(c, acq);
+  size_t num_connected = (size_t)gpr_atm_acq_load(&c->num_connected_stripes);
+  if (num_connected == 0) return NULL;
+  size_t idx = 0;
+  if (num_connected > 1) {
+    idx = (size_t)gpr_atm_full_fetch_add(&c->next_stripe, 1) % num_connected;
+  }
+  return GET_STRIPE(c, idx, acq);
 }
 
 grpc_error *grpc_connected_subchannel_create_call(
@@ -804,10 +861,11 @@ grpc_call_stack *grpc_subchannel_call_get_call_stack(
 
 static void grpc_uri_to_sockaddr(grpc_exec_ctx *exec_ctx, const char *uri_str,
                                  grpc_resolved_address *addr) {
-  grpc_uri *uri = grpc_uri_parse(exec_ctx, uri_str, 0 /* suppress_errors */);
+  grpc_uri *uri =
+      grpc_uri_ref_parsed(exec_ctx, uri_str, 0 /* suppress_errors */);
   GPR_ASSERT(uri != NULL);
   if (!grpc_parse_uri(uri, addr)) memset(addr, 0, sizeof(*addr));
-  grpc_uri_destroy(uri);
+  grpc_uri_unref(uri);
 }
 
 void grpc_get_subchannel_address_arg(grpc_exec_ctx *exec_ctx,
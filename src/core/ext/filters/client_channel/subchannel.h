@@ -44,6 +44,12 @@
 // Channel arg containing a grpc_resolved_address to connect to.
 #define GRPC_ARG_SUBCHANNEL_ADDRESS "grpc.subchannel_address"
 
+// Channel arg (integer) giving the number of parallel connections ("stripes")
+// a subchannel maintains to its address. Calls are spread round-robin across
+// the connected stripes, relieving the per-connection HTTP/2 flow control and
+// transport combiner bottlenecks. Defaults to 1.
+#define GRPC_ARG_SUBCHANNEL_STRIPE_COUNT "grpc.subchannel_stripe_count"
+
 /** A (sub-)channel that knows how to connect to exactly one target
     address. Provides a target for load balancing. */
 typedef struct grpc_subchannel grpc_subchannel;
@@ -37,44 +37,62 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
-#include <grpc/support/avl.h>
 #include <grpc/support/string_util.h>
-#include <grpc/support/tls.h>
 
 #include "src/core/lib/channel/channel_args.h"
-
-// a map of subchannel_key --> subchannel, used for detecting connections
-// to the same destination in order to share them
-static gpr_avl g_subchannel_index;
-
-static gpr_mu g_mu;
+#include "src/core/lib/support/murmur_hash.h"
+
+// A sharded hash map of subchannel_key --> subchannel, used for detecting
+// connections to the same destination in order to share them. Keys carry a
+// digest computed once at creation; operations only lock the shard owning
+// that digest, so index churn on one shard never blocks lookups on another.
+
+// Shards are selected by the top bits of the digest, buckets by the bottom
+// bits, so the two are decorrelated.
+#define SHARD_COUNT 16
+// Initial buckets per shard; must be a power of two. Each shard doubles its
+// bucket array whenever its entry count reaches the bucket count.
+#define INITIAL_SHARD_BUCKETS 8
+
+typedef struct index_entry {
+  struct index_entry *next;
+  grpc_subchannel_key *key;
+  // weak ref ("subchannel_index")
+  grpc_subchannel *subchannel;
+} index_entry;
+
+typedef struct {
+  gpr_mu mu;
+  index_entry **buckets;
+  size_t num_buckets;
+  size_t num_entries;
+} index_shard;
+
+static index_shard g_shards[SHARD_COUNT];
 
 struct grpc_subchannel_key {
   grpc_connector *connector;
   grpc_subchannel_args args;
+  // digest of the fields above; computed once at creation
+  uint32_t hash;
 };
 
-GPR_TLS_DECL(subchannel_index_exec_ctx);
-
-static void enter_ctx(grpc_exec_ctx *exec_ctx) {
-  GPR_ASSERT(gpr_tls_get(&subchannel_index_exec_ctx) == 0);
-  gpr_tls_set(&subchannel_index_exec_ctx, (intptr_t)exec_ctx);
-}
-
-static void leave_ctx(grpc_exec_ctx *exec_ctx) {
-  GPR_ASSERT(gpr_tls_get(&subchannel_index_exec_ctx) == (intptr_t)exec_ctx);
-  gpr_tls_set(&subchannel_index_exec_ctx, 0);
-}
-
-static grpc_exec_ctx *current_ctx() {
-  grpc_exec_ctx *c = (grpc_exec_ctx *)gpr_tls_get(&subchannel_index_exec_ctx);
-  GPR_ASSERT(c != NULL);
-  return c;
+static uint32_t subchannel_key_hash(const grpc_subchannel_key *k) {
+  uint32_t h = gpr_murmur_hash3(&k->connector, sizeof(k->connector), 0);
+  if (k->args.filter_count > 0) {
+    h = gpr_murmur_hash3(k->args.filters,
+                         k->args.filter_count * sizeof(*k->args.filters), h);
+  }
+  if (k->args.args != NULL) {
+    uint32_t args_hash = grpc_channel_args_hash(k->args.args);
+    h = gpr_murmur_hash3(&args_hash, sizeof(args_hash), h);
+  }
+  return h;
 }
 
-static grpc_subchannel_key *create_key(
-    grpc_connector *connector, const grpc_subchannel_args *args,
-    grpc_channel_args *(*copy_channel_args)(const grpc_channel_args *args)) {
+static grpc_subchannel_key *create_key(grpc_connector *connector,
+                                       const grpc_subchannel_args *args,
+                                       const grpc_channel_args *interned_args) {
   grpc_subchannel_key *k = gpr_malloc(sizeof(*k));
   k->connector = grpc_connector_ref(connector);
   k->args.filter_count = args->filter_count;
@@ -86,17 +104,19 @@ static grpc_subchannel_key *create_key(
   } else {
     k->args.filters = NULL;
   }
-  k->args.args = copy_channel_args(args->args);
+  k->args.args = interned_args;
+  k->hash = subchannel_key_hash(k);
   return k;
 }
 
 grpc_subchannel_key *grpc_subchannel_key_create(
     grpc_connector *connector, const grpc_subchannel_args *args) {
-  return create_key(connector, args, grpc_channel_args_normalize);
+  return create_key(connector, args, grpc_channel_args_intern(args->args));
 }
 
 static grpc_subchannel_key *subchannel_key_copy(grpc_subchannel_key *k) {
-  return create_key(k->connector, &k->args, grpc_channel_args_copy);
+  return create_key(k->connector, &k->args,
+                    grpc_channel_args_intern_ref(k->args.args));
 }
 
 static int subchannel_key_compare(grpc_subchannel_key *a,
@@ -110,163 +130,174 @@ static int subchannel_key_compare(grpc_subchannel_key *a,
                a->args.filter_count * sizeof(*a->args.filters));
     if (c != 0) return c;
   }
-  return grpc_channel_args_compare(a->args.args, b->args.args);
+  /* both sides hold interned args: equal args are the same pointer */
+  return GPR_ICMP(a->args.args, b->args.args);
 }
 
 void grpc_subchannel_key_destroy(grpc_exec_ctx *exec_ctx,
                                  grpc_subchannel_key *k) {
   grpc_connector_unref(exec_ctx, k->connector);
   gpr_free((grpc_channel_args *)k->args.filters);
-  grpc_channel_args_destroy(exec_ctx, (grpc_channel_args *)k->args.args);
+  grpc_channel_args_intern_unref(exec_ctx, k->args.args);
   gpr_free(k);
 }
 
-static void sck_avl_destroy(void *p) {
-  grpc_subchannel_key_destroy(current_ctx(), p);
-}
-
-static void *sck_avl_copy(void *p) { return subchannel_key_copy(p); }
-
-static long sck_avl_compare(void *a, void *b) {
-  return subchannel_key_compare(a, b);
+static index_shard *shard_for_key(const grpc_subchannel_key *key) {
+  return &g_shards[(key->hash >> 28) % SHARD_COUNT];
 }
 
-static void scv_avl_destroy(void *p) {
-  GRPC_SUBCHANNEL_WEAK_UNREF(current_ctx(), p, "subchannel_index");
+/** Returns the location of the entry matching \a key within its bucket, or
+    the location of the terminating NULL if no entry matches. */
+static index_entry **shard_lookup_locked(index_shard *shard,
+                                         grpc_subchannel_key *key) {
+  index_entry **pentry =
+      &shard->buckets[key->hash & (shard->num_buckets - 1)];
+  while (*pentry != NULL) {
+    if ((*pentry)->key->hash == key->hash &&
+        subchannel_key_compare((*pentry)->key, key) == 0) {
+      break;
+    }
+    pentry = &(*pentry)->next;
+  }
+  return pentry;
 }
 
-static void *scv_avl_copy(void *p) {
-  GRPC_SUBCHANNEL_WEAK_REF(p, "subchannel_index");
-  return p;
+static void shard_grow_locked(index_shard *shard) {
+  const size_t new_count = shard->num_buckets * 2;
+  index_entry **new_buckets = gpr_zalloc(sizeof(*new_buckets) * new_count);
+  for (size_t i = 0; i < shard->num_buckets; i++) {
+    index_entry *entry = shard->buckets[i];
+    while (entry != NULL) {
+      index_entry *next = entry->next;
+      index_entry **bucket = &new_buckets[entry->key->hash & (new_count - 1)];
+      entry->next = *bucket;
+      *bucket = entry;
+      entry = next;
+    }
+  }
+  gpr_free(shard->buckets);
+  shard->buckets = new_buckets;
+  shard->num_buckets = new_count;
 }
 
-static const gpr_avl_vtable subchannel_avl_vtable = {
-    .destroy_key = sck_avl_destroy,
-    .copy_key = sck_avl_copy,
-    .compare_keys = sck_avl_compare,
-    .destroy_value = scv_avl_destroy,
-    .copy_value = scv_avl_copy};
-
 void grpc_subchannel_index_init(void) {
-  g_subchannel_index = gpr_avl_create(&subchannel_avl_vtable);
-  gpr_mu_init(&g_mu);
-  gpr_tls_init(&subchannel_index_exec_ctx);
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    index_shard *shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->buckets =
+        gpr_zalloc(sizeof(*shard->buckets) * INITIAL_SHARD_BUCKETS);
+    shard->num_buckets = INITIAL_SHARD_BUCKETS;
+    shard->num_entries = 0;
+  }
 }
 
 void grpc_subchannel_index_shutdown(void) {
-  gpr_mu_destroy(&g_mu);
-  gpr_avl_unref(g_subchannel_index);
-  gpr_tls_destroy(&subchannel_index_exec_ctx);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    index_shard *shard = &g_shards[i];
+    for (size_t b = 0; b < shard->num_buckets; b++) {
+      index_entry *entry = shard->buckets[b];
+      while (entry != NULL) {
+        index_entry *next = entry->next;
+        grpc_subchannel_key_destroy(&exec_ctx, entry->key);
+        GRPC_SUBCHANNEL_WEAK_UNREF(&exec_ctx, entry->subchannel,
+                                   "subchannel_index");
+        gpr_free(entry);
+        entry = next;
+      }
+    }
+    gpr_free(shard->buckets);
+    gpr_mu_destroy(&shard->mu);
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
 }
 
 grpc_subchannel *grpc_subchannel_index_find(grpc_exec_ctx *exec_ctx,
                                             grpc_subchannel_key *key) {
-  enter_ctx(exec_ctx);
-
-  // Lock, and take a reference to the subchannel index.
-  // We don't need to do the search under a lock as avl's are immutable.
-  gpr_mu_lock(&g_mu);
-  gpr_avl index = gpr_avl_ref(g_subchannel_index);
-  gpr_mu_unlock(&g_mu);
-
+  index_shard *shard = shard_for_key(key);
+  gpr_mu_lock(&shard->mu);
+  index_entry *entry = *shard_lookup_locked(shard, key);
   grpc_subchannel *c =
-      GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(gpr_avl_get(index, key), "index_find");
-  gpr_avl_unref(index);
-
-  leave_ctx(exec_ctx);
+      entry == NULL ? NULL : GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(
+                                 entry->subchannel, "index_find");
+  gpr_mu_unlock(&shard->mu);
   return c;
 }
 
 grpc_subchannel *grpc_subchannel_index_register(grpc_exec_ctx *exec_ctx,
                                                 grpc_subchannel_key *key,
                                                 grpc_subchannel *constructed) {
-  enter_ctx(exec_ctx);
-
+  index_shard *shard = shard_for_key(key);
   grpc_subchannel *c = NULL;
-  bool need_to_unref_constructed;
-
-  while (c == NULL) {
-    need_to_unref_constructed = false;
-
-    // Compare and swap loop:
-    // - take a reference to the current index
-    gpr_mu_lock(&g_mu);
-    gpr_avl index = gpr_avl_ref(g_subchannel_index);
-    gpr_mu_unlock(&g_mu);
-
-    // - Check to see if a subchannel already exists
-    c = gpr_avl_get(index, key);
-    if (c != NULL) {
-      c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(c, "index_register");
+  // displaced dying entry, if any; released outside the lock since weak
+  // unrefs may run arbitrary destruction code
+  grpc_subchannel *displaced_subchannel = NULL;
+  grpc_subchannel_key *displaced_key = NULL;
+
+  gpr_mu_lock(&shard->mu);
+  index_entry **pentry = shard_lookup_locked(shard, key);
+  index_entry *entry = *pentry;
+  if (entry != NULL) {
+    // a subchannel is already registered for this key; try to use it
+    c = GRPC_SUBCHANNEL_REF_FROM_WEAK_REF(entry->subchannel, "index_register");
+    if (c == NULL) {
+      // the registered subchannel is mid-destruction (no strong refs left):
+      // displace it and register \a constructed in its stead
+      displaced_subchannel = entry->subchannel;
+      displaced_key = entry->key;
+      *pentry = entry->next;
+      gpr_free(entry);
+      shard->num_entries--;
     }
-    if (c != NULL) {
-      // yes -> we're done
-      need_to_unref_constructed = true;
-    } else {
-      // no -> update the avl and compare/swap
-      gpr_avl updated =
-          gpr_avl_add(gpr_avl_ref(index), subchannel_key_copy(key),
-                      GRPC_SUBCHANNEL_WEAK_REF(constructed, "index_register"));
-
-      // it may happen (but it's expected to be unlikely)
-      // that some other thread has changed the index:
-      // compare/swap here to check that, and retry as necessary
-      gpr_mu_lock(&g_mu);
-      if (index.root == g_subchannel_index.root) {
-        GPR_SWAP(gpr_avl, updated, g_subchannel_index);
-        c = constructed;
-      }
-      gpr_mu_unlock(&g_mu);
-
-      gpr_avl_unref(updated);
+  }
+  if (c == NULL) {
+    entry = gpr_malloc(sizeof(*entry));
+    entry->key = subchannel_key_copy(key);
+    entry->subchannel =
+        GRPC_SUBCHANNEL_WEAK_REF(constructed, "subchannel_index");
+    index_entry **bucket =
+        &shard->buckets[key->hash & (shard->num_buckets - 1)];
+    entry->next = *bucket;
+    *bucket = entry;
+    if (++shard->num_entries >= shard->num_buckets) {
+      shard_grow_locked(shard);
     }
-    gpr_avl_unref(index);
+    c = constructed;
   }
+  gpr_mu_unlock(&shard->mu);
 
-  leave_ctx(exec_ctx);
-
-  if (need_to_unref_constructed) {
+  if (displaced_subchannel != NULL) {
+    grpc_subchannel_key_destroy(exec_ctx, displaced_key);
+    GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, displaced_subchannel,
+                               "subchannel_index");
+  }
+  if (c != constructed) {
     GRPC_SUBCHANNEL_UNREF(exec_ctx, constructed, "index_register");
   }
-
   return c;
 }
 
 void grpc_subchannel_index_unregister(grpc_exec_ctx *exec_ctx,
                                       grpc_subchannel_key *key,
                                       grpc_subchannel *constructed) {
-  enter_ctx(exec_ctx);
-
-  bool done = false;
-  while (!done) {
-    // Compare and swap loop:
-    // - take a reference to the current index
-    gpr_mu_lock(&g_mu);
-    gpr_avl index = gpr_avl_ref(g_subchannel_index);
-    gpr_mu_unlock(&g_mu);
-
-    // Check to see if this key still refers to the previously
-    // registered subchannel
-    grpc_subchannel *c = gpr_avl_get(index, key);
-    if (c != constructed) {
-      gpr_avl_unref(index);
-      break;
-    }
-
-    // compare and swap the update (some other thread may have
-    // mutated the index behind us)
-    gpr_avl updated = gpr_avl_remove(gpr_avl_ref(index), key);
-
-    gpr_mu_lock(&g_mu);
-    if (index.root == g_subchannel_index.root) {
-      GPR_SWAP(gpr_avl, updated, g_subchannel_index);
-      done = true;
-    }
-    gpr_mu_unlock(&g_mu);
-
-    gpr_avl_unref(updated);
-    gpr_avl_unref(index);
+  index_shard *shard = shard_for_key(key);
+  grpc_subchannel_key *old_key = NULL;
+
+  gpr_mu_lock(&shard->mu);
+  index_entry **pentry = shard_lookup_locked(shard, key);
+  index_entry *entry = *pentry;
+  // check that this key still refers to the previously registered
+  // subchannel: it may have been displaced by a concurrent register
+  if (entry != NULL && entry->subchannel == constructed) {
+    old_key = entry->key;
+    *pentry = entry->next;
+    gpr_free(entry);
+    shard->num_entries--;
   }
+  gpr_mu_unlock(&shard->mu);
 
-  leave_ctx(exec_ctx);
+  if (old_key != NULL) {
+    grpc_subchannel_key_destroy(exec_ctx, old_key);
+    GRPC_SUBCHANNEL_WEAK_UNREF(exec_ctx, constructed, "subchannel_index");
+  }
 }
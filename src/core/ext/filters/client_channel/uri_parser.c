@@ -40,10 +40,12 @@
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
 #include "src/core/lib/slice/percent_encoding.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
+#include "src/core/lib/support/murmur_hash.h"
 #include "src/core/lib/support/string.h"
 
 /** a size_t default value... maps to all 1's */
@@ -314,6 +316,8 @@ const char *grpc_uri_get_query_arg(const grpc_uri *uri, const char *key) {
 
 void grpc_uri_destroy(grpc_uri *uri) {
   if (!uri) return;
+  /* cached uris are shared: they must be released via grpc_uri_unref */
+  GPR_ASSERT(uri->cache_entry == NULL);
   gpr_free(uri->scheme);
   gpr_free(uri->authority);
   gpr_free(uri->path);
@@ -327,3 +331,132 @@ void grpc_uri_destroy(grpc_uri *uri) {
   gpr_free(uri->fragment);
   gpr_free(uri);
 }
+
+/* Process-wide cache of parsed uris keyed by target string. Targets are
+   immutable and workloads typically open many channels to a handful of
+   them, so one parse serves resolver creation, every re-resolution attempt
+   and subchannel keying. The cache holds one ref on each entry; entries are
+   evicted (only when no caller still references them) to keep the table
+   bounded */
+
+typedef struct uri_cache_entry {
+  char *uri_text;
+  grpc_uri *uri;
+  gpr_refcount refs; /* includes the cache's own ref */
+  struct uri_cache_entry *next;
+} uri_cache_entry;
+
+#define URI_CACHE_NUM_BUCKETS 32
+#define URI_CACHE_MAX_ENTRIES 64
+
+static gpr_mu g_uri_cache_mu;
+static uri_cache_entry *g_uri_cache_buckets[URI_CACHE_NUM_BUCKETS];
+static size_t g_uri_cache_count;
+
+void grpc_uri_cache_init(void) {
+  gpr_mu_init(&g_uri_cache_mu);
+  memset(g_uri_cache_buckets, 0, sizeof(g_uri_cache_buckets));
+  g_uri_cache_count = 0;
+}
+
+static void uri_cache_entry_unref(uri_cache_entry *entry) {
+  if (gpr_unref(&entry->refs)) {
+    entry->uri->cache_entry = NULL;
+    grpc_uri_destroy(entry->uri);
+    gpr_free(entry->uri_text);
+    gpr_free(entry);
+  }
+}
+
+void grpc_uri_cache_shutdown(void) {
+  for (size_t i = 0; i < URI_CACHE_NUM_BUCKETS; i++) {
+    uri_cache_entry *entry = g_uri_cache_buckets[i];
+    while (entry != NULL) {
+      uri_cache_entry *next = entry->next;
+      uri_cache_entry_unref(entry);
+      entry = next;
+    }
+    g_uri_cache_buckets[i] = NULL;
+  }
+  g_uri_cache_count = 0;
+  gpr_mu_destroy(&g_uri_cache_mu);
+}
+
+static size_t uri_cache_bucket(const char *uri_text) {
+  return gpr_murmur_hash3(uri_text, strlen(uri_text), 0xa5a5a5a5u) %
+         URI_CACHE_NUM_BUCKETS;
+}
+
+/* must hold g_uri_cache_mu */
+static grpc_uri *uri_cache_lookup_locked(const char *uri_text, size_t bucket) {
+  for (uri_cache_entry *entry = g_uri_cache_buckets[bucket]; entry != NULL;
+       entry = entry->next) {
+    if (0 == strcmp(entry->uri_text, uri_text)) {
+      gpr_ref(&entry->refs);
+      return entry->uri;
+    }
+  }
+  return NULL;
+}
+
+/* drop the first entry no caller references any more; returns true if one
+   was found. Must hold g_uri_cache_mu */
+static bool uri_cache_evict_locked(void) {
+  for (size_t i = 0; i < URI_CACHE_NUM_BUCKETS; i++) {
+    for (uri_cache_entry **entry = &g_uri_cache_buckets[i]; *entry != NULL;
+         entry = &(*entry)->next) {
+      if (gpr_ref_is_unique(&(*entry)->refs)) {
+        uri_cache_entry *evicted = *entry;
+        *entry = evicted->next;
+        g_uri_cache_count--;
+        uri_cache_entry_unref(evicted);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+grpc_uri *grpc_uri_ref_parsed(grpc_exec_ctx *exec_ctx, const char *uri_text,
+                              bool suppress_errors) {
+  size_t bucket = uri_cache_bucket(uri_text);
+  gpr_mu_lock(&g_uri_cache_mu);
+  grpc_uri *uri = uri_cache_lookup_locked(uri_text, bucket);
+  gpr_mu_unlock(&g_uri_cache_mu);
+  if (uri != NULL) return uri;
+  /* parse outside the lock: it allocates and may log */
+  uri = grpc_uri_parse(exec_ctx, uri_text, suppress_errors);
+  if (uri == NULL) return NULL;
+  gpr_mu_lock(&g_uri_cache_mu);
+  grpc_uri *raced = uri_cache_lookup_locked(uri_text, bucket);
+  if (raced != NULL) {
+    gpr_mu_unlock(&g_uri_cache_mu);
+    grpc_uri_destroy(uri);
+    return raced;
+  }
+  if (g_uri_cache_count >= URI_CACHE_MAX_ENTRIES &&
+      !uri_cache_evict_locked()) {
+    /* every entry is still referenced: hand out an uncached parse */
+    gpr_mu_unlock(&g_uri_cache_mu);
+    return uri;
+  }
+  uri_cache_entry *entry = gpr_malloc(sizeof(*entry));
+  entry->uri_text = gpr_strdup(uri_text);
+  entry->uri = uri;
+  gpr_ref_init(&entry->refs, 2); /* cache + caller */
+  entry->next = g_uri_cache_buckets[bucket];
+  g_uri_cache_buckets[bucket] = entry;
+  g_uri_cache_count++;
+  uri->cache_entry = entry;
+  gpr_mu_unlock(&g_uri_cache_mu);
+  return uri;
+}
+
+void grpc_uri_unref(grpc_uri *uri) {
+  if (uri == NULL) return;
+  if (uri->cache_entry == NULL) {
+    grpc_uri_destroy(uri);
+    return;
+  }
+  uri_cache_entry_unref(uri->cache_entry);
+}
@@ -49,12 +49,32 @@ typedef struct {
   /** Split each query part by '='. NULL if not present. */
   char **query_parts_values;
   char *fragment;
+  /** bookkeeping for the process-wide parse cache; NULL for uris owned
+      directly by a grpc_uri_parse caller. See grpc_uri_ref_parsed */
+  void *cache_entry;
 } grpc_uri;
 
 /** parse a uri, return NULL on failure */
 grpc_uri *grpc_uri_parse(grpc_exec_ctx *exec_ctx, const char *uri_text,
                          bool suppress_errors);
 
+/** Shared, refcounted parse of \a uri_text from a process-wide cache keyed
+    by the target string, so resolver creation, re-resolution and subchannel
+    keying against the same (immutable) target share a single parse. Returns
+    NULL on parse failure; failures are not cached. The result must be
+    treated as immutable and released with grpc_uri_unref, never passed to
+    grpc_uri_destroy */
+grpc_uri *grpc_uri_ref_parsed(grpc_exec_ctx *exec_ctx, const char *uri_text,
+                              bool suppress_errors);
+
+/** release a uri obtained from grpc_uri_ref_parsed (uris from
+    grpc_uri_parse are also accepted, and simply destroyed) */
+void grpc_uri_unref(grpc_uri *uri);
+
+/** parse cache lifecycle, called from the client channel plugin */
+void grpc_uri_cache_init(void);
+void grpc_uri_cache_shutdown(void);
+
 /** return the part of a query string after the '=' in "?key=xxx&...", or NULL
  * if key is not present */
 const char *grpc_uri_get_query_arg(const grpc_uri *uri, const char *key);
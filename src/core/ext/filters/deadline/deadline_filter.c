@@ -55,23 +55,15 @@ static void timer_callback(grpc_exec_ctx* exec_ctx, void* arg,
   grpc_call_element* elem = arg;
   grpc_deadline_state* deadline_state = elem->call_data;
   if (error != GRPC_ERROR_CANCELLED) {
-    grpc_call_element_signal_error(
-        exec_ctx, elem,
-        grpc_error_set_int(
-            GRPC_ERROR_CREATE_FROM_STATIC_STRING("Deadline Exceeded"),
-            GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED));
+    grpc_call_element_signal_error(exec_ctx, elem,
+                                   GRPC_ERROR_DEADLINE_EXCEEDED);
   }
   GRPC_CALL_STACK_UNREF(exec_ctx, deadline_state->call_stack, "deadline_timer");
 }
 
-// Starts the deadline timer.
-static void start_timer_if_needed(grpc_exec_ctx* exec_ctx,
-                                  grpc_call_element* elem,
-                                  gpr_timespec deadline) {
-  deadline = gpr_convert_clock_type(deadline, GPR_CLOCK_MONOTONIC);
-  if (gpr_time_cmp(deadline, gpr_inf_future(GPR_CLOCK_MONOTONIC)) == 0) {
-    return;
-  }
+// Arms the deadline timer.  deadline must be finite and monotonic.
+static void start_timer(grpc_exec_ctx* exec_ctx, grpc_call_element* elem,
+                        gpr_timespec deadline) {
   grpc_deadline_state* deadline_state = elem->call_data;
   grpc_deadline_timer_state cur_state;
   grpc_closure* closure = NULL;
@@ -110,12 +102,142 @@ retry:
   GPR_ASSERT(closure);
   GRPC_CALL_STACK_REF(deadline_state->call_stack, "deadline_timer");
   grpc_timer_init(exec_ctx, &deadline_state->timer, deadline, closure,
-                  gpr_now(GPR_CLOCK_MONOTONIC));
+                  grpc_exec_ctx_now(exec_ctx));
+}
+
+//
+// Deferred timer arming
+//
+// Most calls complete long before their deadline, so arming a timer at
+// call init and cancelling it at completion pays two timer-shard
+// operations per call for a timer that virtually never fires.  Calls
+// whose deadline is comfortably far away are parked on a global list
+// instead; a single sweep timer ticks once per period and arms the real
+// per-call timer only for calls that have outlived a grace period.
+// Calls that complete while parked just unlink themselves.
+//
+
+// How often the sweep runs, and how long a call must survive before its
+// deadline timer is armed.
+#define DEADLINE_SWEEP_PERIOD_SECONDS 1
+// Only park calls whose deadline is at least this many sweep periods
+// away: a parked call is armed at most two periods after init, and the
+// real timer must be in place well before the deadline.
+#define DEADLINE_LAZY_ARM_MIN_PERIODS 3
+
+static gpr_mu g_sweep_mu;
+static grpc_deadline_state* g_sweep_list = NULL;
+static bool g_sweep_armed = false;
+static grpc_timer g_sweep_timer;
+static grpc_closure g_sweep_closure;
+
+// Unlinks the entry without clearing in_sweep_list: the flag doubles as
+// the synchronization point with the completion path, so the sweep keeps
+// it set until the real timer is armed.
+static void sweep_list_remove_locked(grpc_deadline_state* deadline_state) {
+  if (deadline_state->sweep_prev == NULL) {
+    g_sweep_list = deadline_state->sweep_next;
+  } else {
+    deadline_state->sweep_prev->sweep_next = deadline_state->sweep_next;
+  }
+  if (deadline_state->sweep_next != NULL) {
+    deadline_state->sweep_next->sweep_prev = deadline_state->sweep_prev;
+  }
+}
+
+static void arm_sweep_locked(grpc_exec_ctx* exec_ctx) {
+  if (g_sweep_armed) return;
+  g_sweep_armed = true;
+  gpr_timespec now = grpc_exec_ctx_now(exec_ctx);
+  grpc_timer_init(
+      exec_ctx, &g_sweep_timer,
+      gpr_time_add(now, gpr_time_from_seconds(DEADLINE_SWEEP_PERIOD_SECONDS,
+                                              GPR_TIMESPAN)),
+      &g_sweep_closure, now);
+}
+
+static void sweep_callback(grpc_exec_ctx* exec_ctx, void* arg,
+                           grpc_error* error) {
+  gpr_mu_lock(&g_sweep_mu);
+  g_sweep_armed = false;
+  if (error == GRPC_ERROR_NONE) {
+    gpr_timespec now = grpc_exec_ctx_now(exec_ctx);
+    grpc_deadline_state* deadline_state = g_sweep_list;
+    while (deadline_state != NULL) {
+      grpc_deadline_state* next = deadline_state->sweep_next;
+      if (gpr_time_cmp(now, deadline_state->arm_after) >= 0) {
+        sweep_list_remove_locked(deadline_state);
+        // The parked ref keeps the call stack alive here; start_timer takes
+        // its own ref.  Clearing in_sweep_list only after the timer is
+        // armed forces a racing completion through the mutex, so it always
+        // observes either a parked entry or an armed (cancellable) timer.
+        start_timer(exec_ctx, deadline_state->elem, deadline_state->deadline);
+        gpr_atm_rel_store(&deadline_state->in_sweep_list, 0);
+        GRPC_CALL_STACK_UNREF(exec_ctx, deadline_state->call_stack,
+                              "deadline_parked");
+      }
+      deadline_state = next;
+    }
+    if (g_sweep_list != NULL) arm_sweep_locked(exec_ctx);
+  }
+  gpr_mu_unlock(&g_sweep_mu);
+}
+
+// Starts the deadline timer, deferring the actual arming for calls whose
+// deadline is far enough away that they will very likely complete first.
+static void start_timer_if_needed(grpc_exec_ctx* exec_ctx,
+                                  grpc_call_element* elem,
+                                  gpr_timespec deadline) {
+  deadline = gpr_convert_clock_type(deadline, GPR_CLOCK_MONOTONIC);
+  if (gpr_time_cmp(deadline, gpr_inf_future(GPR_CLOCK_MONOTONIC)) == 0) {
+    return;
+  }
+  grpc_deadline_state* deadline_state = elem->call_data;
+  gpr_timespec now = grpc_exec_ctx_now(exec_ctx);
+  if (gpr_time_cmp(gpr_time_sub(deadline, now),
+                   gpr_time_from_seconds(DEADLINE_SWEEP_PERIOD_SECONDS *
+                                             DEADLINE_LAZY_ARM_MIN_PERIODS,
+                                         GPR_TIMESPAN)) < 0) {
+    // Tight deadline: arm immediately for exact enforcement.
+    start_timer(exec_ctx, elem, deadline);
+    return;
+  }
+  deadline_state->elem = elem;
+  deadline_state->deadline = deadline;
+  deadline_state->arm_after = gpr_time_add(
+      now, gpr_time_from_seconds(DEADLINE_SWEEP_PERIOD_SECONDS, GPR_TIMESPAN));
+  // Parked entries hold a call stack ref so the sweep never races with
+  // call stack destruction; whoever unparks the entry releases it.
+  GRPC_CALL_STACK_REF(deadline_state->call_stack, "deadline_parked");
+  gpr_mu_lock(&g_sweep_mu);
+  deadline_state->sweep_prev = NULL;
+  deadline_state->sweep_next = g_sweep_list;
+  if (g_sweep_list != NULL) g_sweep_list->sweep_prev = deadline_state;
+  g_sweep_list = deadline_state;
+  gpr_atm_rel_store(&deadline_state->in_sweep_list, 1);
+  arm_sweep_locked(exec_ctx);
+  gpr_mu_unlock(&g_sweep_mu);
 }
 
 // Cancels the deadline timer.
 static void cancel_timer_if_needed(grpc_exec_ctx* exec_ctx,
                                    grpc_deadline_state* deadline_state) {
+  if (gpr_atm_acq_load(&deadline_state->in_sweep_list)) {
+    gpr_mu_lock(&g_sweep_mu);
+    if (gpr_atm_acq_load(&deadline_state->in_sweep_list)) {
+      // Still parked: the timer was never armed, so there is nothing to
+      // cancel beyond unlinking and dropping the parked ref.
+      sweep_list_remove_locked(deadline_state);
+      gpr_atm_rel_store(&deadline_state->in_sweep_list, 0);
+      gpr_mu_unlock(&g_sweep_mu);
+      GRPC_CALL_STACK_UNREF(exec_ctx, deadline_state->call_stack,
+                            "deadline_parked");
+      return;
+    }
+    // The sweep armed the timer before we took the mutex; fall through to
+    // the normal cancellation path.
+    gpr_mu_unlock(&g_sweep_mu);
+  }
   if (gpr_atm_rel_cas(&deadline_state->timer_state, GRPC_DEADLINE_STATE_PENDING,
                       GRPC_DEADLINE_STATE_FINISHED)) {
     grpc_timer_cancel(exec_ctx, &deadline_state->timer);
@@ -362,6 +484,11 @@ static bool maybe_add_deadline_filter(grpc_exec_ctx* exec_ctx,
 }
 
 void grpc_deadline_filter_init(void) {
+  gpr_mu_init(&g_sweep_mu);
+  g_sweep_list = NULL;
+  g_sweep_armed = false;
+  grpc_closure_init(&g_sweep_closure, sweep_callback, NULL,
+                    grpc_schedule_on_exec_ctx);
   grpc_channel_init_register_stage(
       GRPC_CLIENT_DIRECT_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
       maybe_add_deadline_filter, (void*)&grpc_client_deadline_filter);
@@ -370,4 +497,8 @@ void grpc_deadline_filter_init(void) {
       maybe_add_deadline_filter, (void*)&grpc_server_deadline_filter);
 }
 
-void grpc_deadline_filter_shutdown(void) {}
+void grpc_deadline_filter_shutdown(void) {
+  // iomgr shutdown has already fired the sweep timer with
+  // GRPC_ERROR_CANCELLED if it was armed, and no calls remain.
+  gpr_mu_destroy(&g_sweep_mu);
+}
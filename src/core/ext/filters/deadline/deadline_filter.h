@@ -49,6 +49,18 @@ typedef struct grpc_deadline_state {
   gpr_atm timer_state;
   grpc_timer timer;
   grpc_closure timer_callback;
+  // Lazy arming: calls whose deadline is comfortably far away do not get
+  // a timer at init.  They are parked on a global list instead, and a
+  // shared sweep timer arms the real per-call timer only once the call
+  // has outlived a grace period; calls that complete before then (the
+  // overwhelmingly common case) never touch the timer shards at all.
+  // These fields are owned by the sweep machinery in deadline_filter.c.
+  grpc_call_element* elem;
+  gpr_timespec deadline;
+  gpr_timespec arm_after;
+  struct grpc_deadline_state* sweep_next;
+  struct grpc_deadline_state* sweep_prev;
+  gpr_atm in_sweep_list;
   // Closure to invoke when the call is complete.
   // We use this to cancel the timer.
   grpc_closure on_complete;
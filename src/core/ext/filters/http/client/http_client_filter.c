@@ -58,6 +58,12 @@ typedef struct call_data {
   grpc_linked_mdelem content_type;
   grpc_linked_mdelem user_agent;
 
+  /* the headers this filter always sends, pre-chained at call creation from
+     the channel's mdelems so that hc_mutate_op splices each group into the
+     outgoing batch with a single pointer link */
+  grpc_mdelem_list header_prefix;
+  grpc_mdelem_list header_suffix;
+
   grpc_metadata_batch *recv_initial_metadata;
   grpc_metadata_batch *recv_trailing_metadata;
   uint8_t *payload_bytes;
@@ -384,26 +390,18 @@ static grpc_error *hc_mutate_op(grpc_exec_ctx *exec_ctx,
                       GRPC_BATCH_USER_AGENT);
 
     /* Send : prefixed headers, which have to be before any application
-       layer headers. */
-    error = grpc_metadata_batch_add_head(
-        exec_ctx, op->payload->send_initial_metadata.send_initial_metadata,
-        &calld->method, method);
-    if (error != GRPC_ERROR_NONE) return error;
-    error = grpc_metadata_batch_add_head(
-        exec_ctx, op->payload->send_initial_metadata.send_initial_metadata,
-        &calld->scheme, channeld->static_scheme);
-    if (error != GRPC_ERROR_NONE) return error;
-    error = grpc_metadata_batch_add_tail(
-        exec_ctx, op->payload->send_initial_metadata.send_initial_metadata,
-        &calld->te_trailers, GRPC_MDELEM_TE_TRAILERS);
-    if (error != GRPC_ERROR_NONE) return error;
-    error = grpc_metadata_batch_add_tail(
+       layer headers. Only the method varies per call: patch it into the
+       pre-chained prefix and splice both groups in. */
+    calld->method.md = method;
+    error = grpc_metadata_batch_link_list_head(
         exec_ctx, op->payload->send_initial_metadata.send_initial_metadata,
-        &calld->content_type, GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC);
+        &calld->header_prefix);
     if (error != GRPC_ERROR_NONE) return error;
-    error = grpc_metadata_batch_add_tail(
+    /* the batch owns a ref once the suffix is linked */
+    calld->user_agent.md = GRPC_MDELEM_REF(channeld->user_agent);
+    error = grpc_metadata_batch_link_list_tail(
         exec_ctx, op->payload->send_initial_metadata.send_initial_metadata,
-        &calld->user_agent, GRPC_MDELEM_REF(channeld->user_agent));
+        &calld->header_suffix);
     if (error != GRPC_ERROR_NONE) return error;
   }
 
@@ -454,6 +452,7 @@ static grpc_error *init_call_elem(grpc_exec_ctx *exec_ctx,
                                   grpc_call_element *elem,
                                   const grpc_call_element_args *args) {
   call_data *calld = elem->call_data;
+  channel_data *channeld = elem->channel_data;
   calld->on_done_recv_initial_metadata = NULL;
   calld->on_done_recv_trailing_metadata = NULL;
   calld->on_complete = NULL;
@@ -472,6 +471,21 @@ static grpc_error *init_call_elem(grpc_exec_ctx *exec_ctx,
                     grpc_schedule_on_exec_ctx);
   grpc_closure_init(&calld->send_done, send_done, elem,
                     grpc_schedule_on_exec_ctx);
+  /* Pre-chain the headers added to every call so hc_mutate_op only has to
+     splice them. POST is a placeholder: hc_mutate_op sets the actual method
+     once it is known. The user-agent ref is taken at splice time. */
+  memset(&calld->header_prefix, 0, sizeof(calld->header_prefix));
+  memset(&calld->header_suffix, 0, sizeof(calld->header_suffix));
+  grpc_mdelem_list_add_tail(&calld->header_prefix, &calld->scheme,
+                            channeld->static_scheme);
+  grpc_mdelem_list_add_tail(&calld->header_prefix, &calld->method,
+                            GRPC_MDELEM_METHOD_POST);
+  grpc_mdelem_list_add_tail(&calld->header_suffix, &calld->te_trailers,
+                            GRPC_MDELEM_TE_TRAILERS);
+  grpc_mdelem_list_add_tail(&calld->header_suffix, &calld->content_type,
+                            GRPC_MDELEM_CONTENT_TYPE_APPLICATION_SLASH_GRPC);
+  grpc_mdelem_list_add_tail(&calld->header_suffix, &calld->user_agent,
+                            channeld->user_agent);
   return GRPC_ERROR_NONE;
 }
 
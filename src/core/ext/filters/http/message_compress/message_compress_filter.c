@@ -56,6 +56,13 @@
 
 #define CANCELLED_BIT ((gpr_atm)1)
 
+/* Adaptive compression bypass: after this many consecutive messages that
+   failed to save at least 1/8th of their size, the stream stops compressing
+   for ADAPTIVE_COMPRESSION_PROBE_INTERVAL messages, then compresses one
+   message to probe whether the payload has become compressible again. */
+#define ADAPTIVE_COMPRESSION_POOR_STREAK_LIMIT 3
+#define ADAPTIVE_COMPRESSION_PROBE_INTERVAL 64
+
 typedef struct call_data {
   grpc_slice_buffer slices; /**< Buffers up input slices to be compressed */
   grpc_linked_mdelem compression_algorithm_storage;
@@ -84,6 +91,15 @@ typedef struct call_data {
   grpc_closure *post_send;
   grpc_closure send_done;
   grpc_closure got_slice;
+
+  /** Compression context kept for the lifetime of the stream so compressor
+   * state is reset between messages rather than rebuilt (lazily created on
+   * the first compressed message) */
+  grpc_msg_compress_context *compress_ctx;
+  /** Consecutive messages that compressed poorly (adaptive bypass) */
+  uint32_t poor_compression_streak;
+  /** Messages left to send uncompressed before probing compression again */
+  uint32_t bypass_remaining;
 } call_data;
 
 typedef struct channel_data {
@@ -195,13 +211,17 @@ static void finish_send_message(grpc_exec_ctx *exec_ctx,
   int did_compress;
   grpc_slice_buffer tmp;
   grpc_slice_buffer_init(&tmp);
-  did_compress = grpc_msg_compress(exec_ctx, calld->compression_algorithm,
-                                   &calld->slices, &tmp);
+  if (calld->compress_ctx == NULL) {
+    calld->compress_ctx =
+        grpc_msg_compress_context_create(calld->compression_algorithm);
+  }
+  did_compress =
+      grpc_msg_compress_ctx(exec_ctx, calld->compress_ctx, &calld->slices, &tmp);
+  const size_t before_size = calld->slices.length;
+  const size_t after_size = tmp.length;
   if (did_compress) {
     if (GRPC_TRACER_ON(grpc_compression_trace)) {
       char *algo_name;
-      const size_t before_size = calld->slices.length;
-      const size_t after_size = tmp.length;
       const float savings_ratio = 1.0f - (float)after_size / (float)before_size;
       GPR_ASSERT(grpc_compression_algorithm_name(calld->compression_algorithm,
                                                  &algo_name));
@@ -223,6 +243,17 @@ static void finish_send_message(grpc_exec_ctx *exec_ctx,
     }
   }
 
+  /* Track how well this stream compresses: a run of poorly compressing
+     messages turns compression off for a while (see the adaptive bypass in
+     compress_start_transport_stream_op_batch). */
+  if (did_compress && after_size * 8 <= before_size * 7) {
+    calld->poor_compression_streak = 0;
+  } else if (++calld->poor_compression_streak >=
+             ADAPTIVE_COMPRESSION_POOR_STREAK_LIMIT) {
+    calld->bypass_remaining = ADAPTIVE_COMPRESSION_PROBE_INTERVAL;
+    calld->poor_compression_streak = 0;
+  }
+
   grpc_slice_buffer_destroy_internal(exec_ctx, &tmp);
 
   grpc_slice_buffer_stream_init(&calld->replacement_stream, &calld->slices,
@@ -343,6 +374,14 @@ static void compress_start_transport_stream_op_batch(
         if (!skip_compression(elem,
                               op->payload->send_message.send_message->flags,
                               cur == HAS_COMPRESSION_ALGORITHM)) {
+          if (calld->bypass_remaining > 0) {
+            /* Recent messages on this stream compressed poorly: send this
+               one uncompressed and count down to the next probe. */
+            calld->bypass_remaining--;
+            grpc_msg_compress_record_uncompressed(calld->compression_algorithm);
+            grpc_call_next_op(exec_ctx, elem, op);
+            break;
+          }
           calld->send_op = op;
           calld->send_length = op->payload->send_message.send_message->length;
           calld->send_flags = op->payload->send_message.send_message->flags;
@@ -394,6 +433,7 @@ static void destroy_call_elem(grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
   /* grab pointers to our data from the call element */
   call_data *calld = elem->call_data;
   grpc_slice_buffer_destroy_internal(exec_ctx, &calld->slices);
+  grpc_msg_compress_context_destroy(calld->compress_ctx);
   gpr_atm imstate =
       gpr_atm_no_barrier_load(&calld->send_initial_metadata_state);
   if (imstate & CANCELLED_BIT) {
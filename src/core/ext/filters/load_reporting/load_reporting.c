@@ -38,6 +38,7 @@
 
 #include <grpc/load_reporting.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/sync.h>
 
 #include "src/core/ext/filters/load_reporting/load_reporting.h"
@@ -72,6 +73,26 @@ grpc_arg grpc_load_reporting_enable_arg() {
   return arg;
 }
 
+static gpr_atm g_collector_fn;
+static gpr_atm g_collector_user_data;
+
+void grpc_load_reporting_register_collector(
+    grpc_load_reporting_collector_fn collector, void *user_data) {
+  /* user_data must be visible before the fn that implies it */
+  gpr_atm_no_barrier_store(&g_collector_user_data, (gpr_atm)user_data);
+  gpr_atm_rel_store(&g_collector_fn, (gpr_atm)collector);
+}
+
+grpc_load_reporting_collector_fn grpc_load_reporting_collector(
+    void **user_data) {
+  grpc_load_reporting_collector_fn collector =
+      (grpc_load_reporting_collector_fn)gpr_atm_acq_load(&g_collector_fn);
+  if (collector != NULL) {
+    *user_data = (void *)gpr_atm_no_barrier_load(&g_collector_user_data);
+  }
+  return collector;
+}
+
 /* Plugin registration */
 
 void grpc_load_reporting_plugin_init(void) {
@@ -70,4 +70,35 @@ typedef struct grpc_load_reporting_call_data {
 /** Return a \a grpc_arg enabling load reporting */
 grpc_arg grpc_load_reporting_enable_arg();
 
+/** A compact per-call cost record accumulated by the load_reporting filter.
+ * Completed calls append one of these to a per-channel buffer; the buffer is
+ * handed to the registered collector in batches, so the collector's locking
+ * is paid once per batch instead of once per call. */
+typedef struct grpc_load_reporting_cost_record {
+  intptr_t channel_id;
+  intptr_t call_id;
+  grpc_status_code final_status;
+  gpr_timespec latency;
+  uint64_t bytes_sent;     /**< outgoing data+header+framing bytes */
+  uint64_t bytes_received; /**< incoming data+header+framing bytes */
+} grpc_load_reporting_cost_record;
+
+/** Collector invoked with batches of completed-call cost records. Called
+ * outside any filter lock. \a records is only valid for the duration of the
+ * invocation. */
+typedef void (*grpc_load_reporting_collector_fn)(
+    const grpc_load_reporting_cost_record *records, size_t num_records,
+    void *user_data);
+
+/** Register a process-wide batch collector. A NULL \a collector disables
+ * collection entirely: the filter's completion path then does no
+ * aggregation work at all. */
+void grpc_load_reporting_register_collector(
+    grpc_load_reporting_collector_fn collector, void *user_data);
+
+/** The currently registered collector (NULL if none), for the filter. On a
+ * non-NULL return \a *user_data holds the registered argument. */
+grpc_load_reporting_collector_fn grpc_load_reporting_collector(
+    void **user_data);
+
 #endif /* GRPC_CORE_EXT_FILTERS_LOAD_REPORTING_LOAD_REPORTING_H */
@@ -65,10 +65,55 @@ typedef struct call_data {
   grpc_metadata_batch *recv_initial_metadata;
 } call_data;
 
+/* completed-call cost records held back per channel and delivered to the
+   collector as a batch; see grpc_load_reporting_register_collector */
+#define LR_COST_RECORD_BATCH_SIZE 64
+
 typedef struct channel_data {
   intptr_t id; /**< an id unique to the channel */
+  gpr_mu mu;   /**< guards the pending batch below */
+  size_t num_pending;
+  grpc_load_reporting_cost_record pending[LR_COST_RECORD_BATCH_SIZE];
 } channel_data;
 
+/* Append one cost record; when the batch fills, hand a copy to the
+   collector outside the lock. The per-call cost is one short critical
+   section and a struct copy. */
+static void append_cost_record(
+    channel_data *chand, const grpc_load_reporting_cost_record *record) {
+  void *user_data;
+  grpc_load_reporting_collector_fn collector =
+      grpc_load_reporting_collector(&user_data);
+  if (collector == NULL) return;
+  grpc_load_reporting_cost_record batch[LR_COST_RECORD_BATCH_SIZE];
+  size_t batch_count = 0;
+  gpr_mu_lock(&chand->mu);
+  chand->pending[chand->num_pending++] = *record;
+  if (chand->num_pending == LR_COST_RECORD_BATCH_SIZE) {
+    memcpy(batch, chand->pending, sizeof(batch));
+    batch_count = chand->num_pending;
+    chand->num_pending = 0;
+  }
+  gpr_mu_unlock(&chand->mu);
+  if (batch_count > 0) collector(batch, batch_count, user_data);
+}
+
+/* Deliver any partial batch (channel teardown) */
+static void flush_cost_records(channel_data *chand) {
+  void *user_data;
+  grpc_load_reporting_collector_fn collector =
+      grpc_load_reporting_collector(&user_data);
+  if (collector == NULL) return;
+  grpc_load_reporting_cost_record batch[LR_COST_RECORD_BATCH_SIZE];
+  size_t batch_count;
+  gpr_mu_lock(&chand->mu);
+  batch_count = chand->num_pending;
+  memcpy(batch, chand->pending, batch_count * sizeof(*batch));
+  chand->num_pending = 0;
+  gpr_mu_unlock(&chand->mu);
+  if (batch_count > 0) collector(batch, batch_count, user_data);
+}
+
 static void on_initial_md_ready(grpc_exec_ctx *exec_ctx, void *user_data,
                                 grpc_error *err) {
   grpc_call_element *elem = user_data;
@@ -127,17 +172,23 @@ static void destroy_call_elem(grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
                               const grpc_call_final_info *final_info,
                               grpc_closure *ignored) {
   call_data *calld = elem->call_data;
-
-  /* TODO(dgq): do something with the data
   channel_data *chand = elem->channel_data;
-  grpc_load_reporting_call_data lr_call_data = {GRPC_LR_POINT_CALL_DESTRUCTION,
-                                                (intptr_t)chand->id,
-                                                (intptr_t)calld->id,
-                                                final_info,
-                                                calld->initial_md_string,
-                                                calld->trailing_md_string,
-                                                calld->service_method};
-  */
+
+  if (final_info != NULL) {
+    const grpc_transport_one_way_stats *in =
+        &final_info->stats.transport_stream_stats.incoming;
+    const grpc_transport_one_way_stats *out =
+        &final_info->stats.transport_stream_stats.outgoing;
+    grpc_load_reporting_cost_record record = {
+        .channel_id = chand->id,
+        .call_id = calld->id,
+        .final_status = final_info->final_status,
+        .latency = final_info->stats.latency,
+        .bytes_sent = out->data_bytes + out->header_bytes + out->framing_bytes,
+        .bytes_received =
+            in->data_bytes + in->header_bytes + in->framing_bytes};
+    append_cost_record(chand, &record);
+  }
 
   if (calld->have_initial_md_string) {
     grpc_slice_unref_internal(exec_ctx, calld->initial_md_string);
@@ -158,16 +209,8 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
 
   channel_data *chand = elem->channel_data;
   chand->id = (intptr_t)args->channel_stack;
-
-  /* TODO(dgq): do something with the data
-  grpc_load_reporting_call_data lr_call_data = {GRPC_LR_POINT_CHANNEL_CREATION,
-                                                (intptr_t)chand,
-                                                0,
-                                                NULL,
-                                                NULL,
-                                                NULL,
-                                                NULL};
-                                                */
+  gpr_mu_init(&chand->mu);
+  chand->num_pending = 0;
 
   return GRPC_ERROR_NONE;
 }
@@ -175,17 +218,9 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
 /* Destructor for channel data */
 static void destroy_channel_elem(grpc_exec_ctx *exec_ctx,
                                  grpc_channel_element *elem) {
-  /* TODO(dgq): do something with the data
   channel_data *chand = elem->channel_data;
-  grpc_load_reporting_call_data lr_call_data = {
-      GRPC_LR_POINT_CHANNEL_DESTRUCTION,
-      (intptr_t)chand->id,
-      0,
-      NULL,
-      NULL,
-      NULL,
-      NULL};
-  */
+  flush_cost_records(chand);
+  gpr_mu_destroy(&chand->mu);
 }
 
 static grpc_filtered_mdelem lr_trailing_md_filter(grpc_exec_ctx *exec_ctx,
@@ -47,6 +47,10 @@
 #define DEFAULT_MAX_CONNECTION_IDLE_MS INT_MAX
 #define MAX_CONNECTION_AGE_JITTER 0.1
 
+/* How often the shared idleness sweep runs.  An idle channel is closed
+   within one sweep period of its max_connection_idle elapsing. */
+#define MAX_AGE_IDLE_SWEEP_PERIOD_SECONDS 1
+
 #define MAX_CONNECTION_AGE_INTEGER_OPTIONS \
   (grpc_integer_options) { DEFAULT_MAX_CONNECTION_AGE_MS, 1, INT_MAX }
 #define MAX_CONNECTION_IDLE_INTEGER_OPTIONS \
@@ -67,9 +71,17 @@ typedef struct channel_data {
   /* The timer for checking if the max-aged channel has uesed up the grace
      period */
   grpc_timer max_age_grace_timer;
-  /* The timer for checking if the channel's idle duration reaches
-     max_connection_idle */
-  grpc_timer max_idle_timer;
+  /* Millisecond timestamp (monotonic clock) of the moment the channel last
+     became idle; only meaningful while there are no active calls.  Written
+     with an atomic store on every call end and read by the shared idleness
+     sweep, so call-count transitions never touch the timer shards. */
+  gpr_atm idle_start_millis;
+  /* Entry in the global idle-sweep registry; guarded by g_idle_mu.  A
+     registered channel holds a channel stack ref, released when the
+     connectivity watcher sees GRPC_CHANNEL_SHUTDOWN and unregisters it. */
+  struct channel_data* idle_next;
+  struct channel_data* idle_prev;
+  bool in_idle_list;
   /* Allowed max time a channel may have no outstanding rpcs */
   gpr_timespec max_connection_idle;
   /* Allowed max time a channel may exist */
@@ -101,32 +113,114 @@ typedef struct channel_data {
   gpr_atm call_count;
 } channel_data;
 
-/* Increase the nubmer of active calls. Before the increasement, if there are no
-   calls, the max_idle_timer should be cancelled. */
-static void increase_call_count(grpc_exec_ctx* exec_ctx, channel_data* chand) {
-  if (gpr_atm_full_fetch_add(&chand->call_count, 1) == 0) {
-    grpc_timer_cancel(exec_ctx, &chand->max_idle_timer);
+static gpr_mu g_idle_mu;
+static channel_data* g_idle_list = NULL;
+static bool g_idle_sweep_armed = false;
+static grpc_timer g_idle_sweep_timer;
+static grpc_closure g_idle_sweep_closure;
+
+static void arm_idle_sweep_locked(grpc_exec_ctx* exec_ctx) {
+  if (g_idle_sweep_armed) return;
+  g_idle_sweep_armed = true;
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  grpc_timer_init(
+      exec_ctx, &g_idle_sweep_timer,
+      gpr_time_add(now, gpr_time_from_seconds(MAX_AGE_IDLE_SWEEP_PERIOD_SECONDS,
+                                              GPR_TIMESPAN)),
+      &g_idle_sweep_closure, now);
+}
+
+/* One coarse sweep over all registered channels replaces the per-channel
+   idle timer: instead of arming and cancelling a timer on every
+   call-count transition, idleness is decided here from a passively
+   recorded timestamp. */
+static void idle_sweep_callback(grpc_exec_ctx* exec_ctx, void* arg,
+                                grpc_error* error) {
+  gpr_mu_lock(&g_idle_mu);
+  g_idle_sweep_armed = false;
+  if (error == GRPC_ERROR_NONE) {
+    gpr_atm now_millis =
+        (gpr_atm)gpr_time_to_millis(gpr_now(GPR_CLOCK_MONOTONIC));
+    for (channel_data* chand = g_idle_list; chand != NULL;
+         chand = chand->idle_next) {
+      gpr_atm idle_start = gpr_atm_no_barrier_load(&chand->idle_start_millis);
+      if (idle_start == 0 ||
+          now_millis - idle_start <
+              (gpr_atm)gpr_time_to_millis(chand->max_connection_idle)) {
+        continue;
+      }
+      /* The CAS both rechecks that the channel is still idle and blocks the
+         sweep from closing it twice: close_max_idle_channel leaves the
+         count elevated for good, exactly as it did when the idle timer
+         fired.  Registered channels hold a stack ref, so taking another one
+         here is safe. */
+      if (gpr_atm_full_cas(&chand->call_count, 0, 1)) {
+        GRPC_CHANNEL_STACK_REF(chand->channel_stack, "max_age max_idle_timer");
+        grpc_closure_sched(exec_ctx, &chand->close_max_idle_channel,
+                           GRPC_ERROR_NONE);
+      }
+    }
+    if (g_idle_list != NULL) arm_idle_sweep_locked(exec_ctx);
   }
+  gpr_mu_unlock(&g_idle_mu);
 }
 
-/* Decrease the nubmer of active calls. After the decrement, if there are no
-   calls, the max_idle_timer should be started. */
-static void decrease_call_count(grpc_exec_ctx* exec_ctx, channel_data* chand) {
-  if (gpr_atm_full_fetch_add(&chand->call_count, -1) == 1) {
-    GRPC_CHANNEL_STACK_REF(chand->channel_stack, "max_age max_idle_timer");
-    grpc_timer_init(
-        exec_ctx, &chand->max_idle_timer,
-        gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC), chand->max_connection_idle),
-        &chand->close_max_idle_channel, gpr_now(GPR_CLOCK_MONOTONIC));
+static void register_idle_channel(grpc_exec_ctx* exec_ctx,
+                                  channel_data* chand) {
+  GRPC_CHANNEL_STACK_REF(chand->channel_stack, "max_age idle_sweep");
+  gpr_mu_lock(&g_idle_mu);
+  chand->in_idle_list = true;
+  chand->idle_prev = NULL;
+  chand->idle_next = g_idle_list;
+  if (g_idle_list != NULL) g_idle_list->idle_prev = chand;
+  g_idle_list = chand;
+  arm_idle_sweep_locked(exec_ctx);
+  gpr_mu_unlock(&g_idle_mu);
+}
+
+static void unregister_idle_channel(grpc_exec_ctx* exec_ctx,
+                                    channel_data* chand) {
+  gpr_mu_lock(&g_idle_mu);
+  if (!chand->in_idle_list) {
+    gpr_mu_unlock(&g_idle_mu);
+    return;
   }
+  chand->in_idle_list = false;
+  if (chand->idle_prev == NULL) {
+    g_idle_list = chand->idle_next;
+  } else {
+    chand->idle_prev->idle_next = chand->idle_next;
+  }
+  if (chand->idle_next != NULL) {
+    chand->idle_next->idle_prev = chand->idle_prev;
+  }
+  gpr_mu_unlock(&g_idle_mu);
+  GRPC_CHANNEL_STACK_UNREF(exec_ctx, chand->channel_stack,
+                           "max_age idle_sweep");
+}
+
+/* Increase the nubmer of active calls.  The channel stops being idle, which
+   the sweep observes through the call count itself. */
+static void increase_call_count(grpc_exec_ctx* exec_ctx, channel_data* chand) {
+  gpr_atm_full_fetch_add(&chand->call_count, 1);
+}
+
+/* Decrease the nubmer of active calls, recording when the channel became
+   idle.  The timestamp is stored before the decrement, so once the sweep
+   observes a zero count the timestamp it reads is current. */
+static void decrease_call_count(grpc_exec_ctx* exec_ctx, channel_data* chand) {
+  gpr_atm_no_barrier_store(
+      &chand->idle_start_millis,
+      (gpr_atm)gpr_time_to_millis(gpr_now(GPR_CLOCK_MONOTONIC)));
+  gpr_atm_full_fetch_add(&chand->call_count, -1);
 }
 
 static void start_max_idle_timer_after_init(grpc_exec_ctx* exec_ctx, void* arg,
                                             grpc_error* error) {
   channel_data* chand = arg;
-  /* Decrease call_count. If there are no active calls at this time,
-     max_idle_timer will start here. If the number of active calls is not 0,
-     max_idle_timer will start after all the active calls end. */
+  /* Decrease call_count. If there are no active calls at this time, the
+     channel becomes visible to the idle sweep here. If the number of active
+     calls is not 0, it becomes visible after all the active calls end. */
   decrease_call_count(exec_ctx, chand);
   GRPC_CHANNEL_STACK_UNREF(exec_ctx, chand->channel_stack,
                            "max_age start_max_idle_timer_after_init");
@@ -253,10 +347,10 @@ static void channel_connectivity_changed(grpc_exec_ctx* exec_ctx, void* arg,
       chand->max_age_grace_timer_pending = false;
     }
     gpr_mu_unlock(&chand->max_age_timer_mu);
-    /* If there are no active calls, this increasement will cancel
-       max_idle_timer, and prevent max_idle_timer from being started in the
-       future. */
+    /* This increasement makes the channel permanently non-idle in the eyes
+       of the sweep, so it will never be closed for idleness from here on. */
     increase_call_count(exec_ctx, chand);
+    unregister_idle_channel(exec_ctx, chand);
   }
 }
 
@@ -379,11 +473,14 @@ static grpc_error* init_channel_elem(grpc_exec_ctx* exec_ctx,
                        GRPC_ERROR_NONE);
   }
 
-  /* Initialize the number of calls as 1, so that the max_idle_timer will not
-     start until start_max_idle_timer_after_init is invoked. */
+  /* Initialize the number of calls as 1, so that the idle sweep considers
+     the channel busy until start_max_idle_timer_after_init is invoked. */
   gpr_atm_rel_store(&chand->call_count, 1);
+  gpr_atm_no_barrier_store(&chand->idle_start_millis, 0);
+  chand->in_idle_list = false;
   if (gpr_time_cmp(chand->max_connection_idle, gpr_inf_future(GPR_TIMESPAN)) !=
       0) {
+    register_idle_channel(exec_ctx, chand);
     GRPC_CHANNEL_STACK_REF(chand->channel_stack,
                            "max_age start_max_idle_timer_after_init");
     grpc_closure_sched(exec_ctx, &chand->start_max_idle_timer_after_init,
@@ -431,9 +528,14 @@ static bool maybe_add_max_age_filter(grpc_exec_ctx* exec_ctx,
 }
 
 void grpc_max_age_filter_init(void) {
+  gpr_mu_init(&g_idle_mu);
+  g_idle_list = NULL;
+  g_idle_sweep_armed = false;
+  grpc_closure_init(&g_idle_sweep_closure, idle_sweep_callback, NULL,
+                    grpc_schedule_on_exec_ctx);
   grpc_channel_init_register_stage(GRPC_SERVER_CHANNEL,
                                    GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
                                    maybe_add_max_age_filter, NULL);
 }
 
-void grpc_max_age_filter_shutdown(void) {}
+void grpc_max_age_filter_shutdown(void) { gpr_mu_destroy(&g_idle_mu); }
@@ -281,17 +281,12 @@ static bool maybe_add_message_size_filter(grpc_exec_ctx* exec_ctx,
                                           void* arg) {
   const grpc_channel_args* channel_args =
       grpc_channel_stack_builder_get_channel_arguments(builder);
-  bool enable = false;
-  message_size_limits lim = get_message_size_limits(channel_args);
-  if (lim.max_send_size != -1 || lim.max_recv_size != -1) {
-    enable = true;
-  }
+  // Flat limits from channel args are enforced inline by the call surface
+  // (see call.c), so the filter frame is only needed when a service config
+  // may carry tighter per-method limits.
   const grpc_arg* a =
       grpc_channel_args_find(channel_args, GRPC_ARG_SERVICE_CONFIG);
   if (a != NULL) {
-    enable = true;
-  }
-  if (enable) {
     return grpc_channel_stack_builder_prepend_filter(
         builder, &grpc_message_size_filter, NULL, NULL);
   } else {
@@ -35,6 +35,7 @@
 
 #include <grpc/grpc.h>
 
+#include <limits.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
@@ -55,6 +56,25 @@
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/server.h"
 
+#define DEFAULT_MAX_PENDING_HANDSHAKES 1024
+/* A single source address may not hold more than this fraction of the
+   pending handshake budget, so one misbehaving peer cannot starve the
+   rest of the fleet during a connection storm. */
+#define PER_SOURCE_PENDING_HANDSHAKES_DIVISOR 4
+/* Handshake deadlines, in seconds. The short one applies once more than
+   half the pending budget is in use, shedding stalled handshakes early
+   instead of letting them hold memory for the full timeout. */
+#define HANDSHAKE_TIMEOUT_SECS 120
+#define OVERLOADED_HANDSHAKE_TIMEOUT_SECS 20
+
+/* Count of pending handshakes from one source address; guarded by
+   server_state.mu. */
+typedef struct pending_source {
+  char *host;
+  size_t count;
+  struct pending_source *next;
+} pending_source;
+
 typedef struct {
   grpc_server *server;
   grpc_tcp_server *tcp_server;
@@ -64,6 +84,9 @@ typedef struct {
   grpc_closure tcp_server_shutdown_complete;
   grpc_closure *server_destroy_listener_done;
   grpc_handshake_manager *pending_handshake_mgrs;
+  size_t pending_handshake_count;
+  size_t max_pending_handshakes;
+  pending_source *pending_sources;
 } server_state;
 
 typedef struct {
@@ -71,8 +94,72 @@ typedef struct {
   grpc_pollset *accepting_pollset;
   grpc_tcp_server_acceptor *acceptor;
   grpc_handshake_manager *handshake_mgr;
+  char *peer_host;
 } server_connection_state;
 
+/* Returns the source host of \a tcp (peer string minus the trailing port),
+   or NULL if it cannot be determined. */
+static char *extract_peer_host(grpc_endpoint *tcp) {
+  char *peer = grpc_endpoint_get_peer(tcp);
+  if (peer == NULL) return NULL;
+  char *last_colon = strrchr(peer, ':');
+  if (last_colon != NULL) *last_colon = '\0';
+  return peer;
+}
+
+static pending_source *pending_source_find_locked(server_state *state,
+                                                  const char *host) {
+  pending_source *s;
+  for (s = state->pending_sources; s != NULL; s = s->next) {
+    if (strcmp(s->host, host) == 0) return s;
+  }
+  return NULL;
+}
+
+static void pending_source_add_locked(server_state *state, const char *host) {
+  pending_source *s = pending_source_find_locked(state, host);
+  if (s == NULL) {
+    s = gpr_malloc(sizeof(*s));
+    s->host = gpr_strdup(host);
+    s->count = 0;
+    s->next = state->pending_sources;
+    state->pending_sources = s;
+  }
+  s->count++;
+}
+
+static void pending_source_remove_locked(server_state *state,
+                                         const char *host) {
+  pending_source **prev = &state->pending_sources;
+  pending_source *s;
+  for (s = state->pending_sources; s != NULL; prev = &s->next, s = s->next) {
+    if (strcmp(s->host, host) == 0) {
+      if (--s->count == 0) {
+        *prev = s->next;
+        gpr_free(s->host);
+        gpr_free(s);
+      }
+      return;
+    }
+  }
+}
+
+/* Decides under state->mu whether a new connection may start handshaking. */
+static bool admit_connection_locked(server_state *state,
+                                    const char *peer_host) {
+  if (state->pending_handshake_count >= state->max_pending_handshakes) {
+    return false;
+  }
+  if (peer_host != NULL) {
+    pending_source *s = pending_source_find_locked(state, peer_host);
+    size_t per_source_limit = state->max_pending_handshakes /
+                              PER_SOURCE_PENDING_HANDSHAKES_DIVISOR;
+    if (per_source_limit == 0) per_source_limit = 1;
+    if (s != NULL && s->count >= per_source_limit) return false;
+  }
+  return true;
+}
+
 static void on_handshake_done(grpc_exec_ctx *exec_ctx, void *arg,
                               grpc_error *error) {
   grpc_handshaker_args *args = arg;
@@ -113,10 +200,16 @@ static void on_handshake_done(grpc_exec_ctx *exec_ctx, void *arg,
   grpc_handshake_manager_pending_list_remove(
       &connection_state->server_state->pending_handshake_mgrs,
       connection_state->handshake_mgr);
+  connection_state->server_state->pending_handshake_count--;
+  if (connection_state->peer_host != NULL) {
+    pending_source_remove_locked(connection_state->server_state,
+                                 connection_state->peer_host);
+  }
   gpr_mu_unlock(&connection_state->server_state->mu);
   grpc_handshake_manager_destroy(exec_ctx, connection_state->handshake_mgr);
   grpc_tcp_server_unref(exec_ctx, connection_state->server_state->tcp_server);
   gpr_free(connection_state->acceptor);
+  gpr_free(connection_state->peer_host);
   gpr_free(connection_state);
 }
 
@@ -124,17 +217,30 @@ static void on_accept(grpc_exec_ctx *exec_ctx, void *arg, grpc_endpoint *tcp,
                       grpc_pollset *accepting_pollset,
                       grpc_tcp_server_acceptor *acceptor) {
   server_state *state = arg;
+  char *peer_host = extract_peer_host(tcp);
   gpr_mu_lock(&state->mu);
-  if (state->shutdown) {
+  if (state->shutdown || !admit_connection_locked(state, peer_host)) {
+    bool shutdown = state->shutdown;
     gpr_mu_unlock(&state->mu);
+    if (!shutdown) {
+      /* Over the pending handshake budget: drop the newest connection so
+         overload degrades gracefully instead of ballooning memory. */
+      gpr_log(GPR_DEBUG, "Dropping connection from %s: handshake budget",
+              peer_host != NULL ? peer_host : "(unknown)");
+    }
     grpc_endpoint_shutdown(exec_ctx, tcp, GRPC_ERROR_NONE);
     grpc_endpoint_destroy(exec_ctx, tcp);
     gpr_free(acceptor);
+    gpr_free(peer_host);
     return;
   }
   grpc_handshake_manager *handshake_mgr = grpc_handshake_manager_create();
   grpc_handshake_manager_pending_list_add(&state->pending_handshake_mgrs,
                                           handshake_mgr);
+  state->pending_handshake_count++;
+  if (peer_host != NULL) pending_source_add_locked(state, peer_host);
+  const bool overloaded =
+      state->pending_handshake_count > state->max_pending_handshakes / 2;
   gpr_mu_unlock(&state->mu);
   grpc_tcp_server_ref(state->tcp_server);
   server_connection_state *connection_state =
@@ -143,12 +249,14 @@ static void on_accept(grpc_exec_ctx *exec_ctx, void *arg, grpc_endpoint *tcp,
   connection_state->accepting_pollset = accepting_pollset;
   connection_state->acceptor = acceptor;
   connection_state->handshake_mgr = handshake_mgr;
+  connection_state->peer_host = peer_host;
   grpc_handshakers_add(exec_ctx, HANDSHAKER_SERVER, state->args,
                        connection_state->handshake_mgr);
-  // TODO(roth): We should really get this timeout value from channel
-  // args instead of hard-coding it.
   const gpr_timespec deadline = gpr_time_add(
-      gpr_now(GPR_CLOCK_MONOTONIC), gpr_time_from_seconds(120, GPR_TIMESPAN));
+      gpr_now(GPR_CLOCK_MONOTONIC),
+      gpr_time_from_seconds(overloaded ? OVERLOADED_HANDSHAKE_TIMEOUT_SECS
+                                       : HANDSHAKE_TIMEOUT_SECS,
+                            GPR_TIMESPAN));
   grpc_handshake_manager_do_handshake(exec_ctx, connection_state->handshake_mgr,
                                       tcp, state->args, deadline, acceptor,
                                       on_handshake_done, connection_state);
@@ -237,6 +345,9 @@ grpc_error *grpc_chttp2_server_add_port(grpc_exec_ctx *exec_ctx,
   state->tcp_server = tcp_server;
   state->args = args;
   state->shutdown = true;
+  state->max_pending_handshakes = (size_t)grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args, GRPC_ARG_MAX_PENDING_HANDSHAKES),
+      (grpc_integer_options){DEFAULT_MAX_PENDING_HANDSHAKES, 1, INT_MAX});
   gpr_mu_init(&state->mu);
 
   const size_t naddrs = resolved->naddrs;
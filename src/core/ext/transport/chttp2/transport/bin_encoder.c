@@ -71,12 +71,14 @@ grpc_slice grpc_chttp2_base64_encode(grpc_slice input) {
   char *out = (char *)GRPC_SLICE_START_PTR(output);
   size_t i;
 
-  /* encode full triplets */
+  /* encode full triplets: pack the 24 input bits into a register and peel
+     off four 6-bit indices */
   for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
+    uint32_t packed = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+    out[0] = alphabet[packed >> 18];
+    out[1] = alphabet[(packed >> 12) & 0x3f];
+    out[2] = alphabet[(packed >> 6) & 0x3f];
+    out[3] = alphabet[packed & 0x3f];
     out += 4;
     in += 3;
   }
@@ -110,7 +112,7 @@ grpc_slice grpc_chttp2_huffman_compress(grpc_slice input) {
   uint8_t *in;
   uint8_t *out;
   grpc_slice output;
-  uint32_t temp = 0;
+  uint64_t temp = 0;
   uint32_t temp_length = 0;
 
   nbits = 0;
@@ -128,12 +130,25 @@ grpc_slice grpc_chttp2_huffman_compress(grpc_slice input) {
     temp |= grpc_chttp2_huffsyms[sym].bits;
     temp_length += grpc_chttp2_huffsyms[sym].length;
 
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = (uint8_t)(temp >> temp_length);
+    /* with a 64-bit accumulator (residual < 32 bits, symbols <= 30 bits) we
+       can always buffer a whole symbol and flush aligned 32-bit chunks,
+       instead of dribbling the accumulator out byte-at-a-time */
+    if (temp_length >= 32) {
+      temp_length -= 32;
+      uint32_t w = (uint32_t)(temp >> temp_length);
+      out[0] = (uint8_t)(w >> 24);
+      out[1] = (uint8_t)(w >> 16);
+      out[2] = (uint8_t)(w >> 8);
+      out[3] = (uint8_t)(w);
+      out += 4;
     }
   }
 
+  while (temp_length > 8) {
+    temp_length -= 8;
+    *out++ = (uint8_t)(temp >> temp_length);
+  }
+
   if (temp_length) {
     /* NB: the following integer arithmetic operation needs to be in its
      * expanded form due to the "integral promotion" performed (see section
@@ -149,15 +164,22 @@ grpc_slice grpc_chttp2_huffman_compress(grpc_slice input) {
 }
 
 typedef struct {
-  uint32_t temp;
+  uint64_t temp;
   uint32_t temp_length;
   uint8_t *out;
 } huff_out;
 
 static void enc_flush_some(huff_out *out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = (uint8_t)(out->temp >> out->temp_length);
+  /* flush aligned 32-bit chunks; the residual (< 32 bits) stays buffered in
+     the 64-bit accumulator so each enc_add2 below needs at most one store */
+  while (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    uint32_t w = (uint32_t)(out->temp >> out->temp_length);
+    out->out[0] = (uint8_t)(w >> 24);
+    out->out[1] = (uint8_t)(w >> 16);
+    out->out[2] = (uint8_t)(w >> 8);
+    out->out[3] = (uint8_t)(w);
+    out->out += 4;
   }
 }
 
@@ -224,6 +246,11 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(grpc_slice input) {
     }
   }
 
+  while (out.temp_length > 8) {
+    out.temp_length -= 8;
+    *out.out++ = (uint8_t)(out.temp >> out.temp_length);
+  }
+
   if (out.temp_length) {
     /* NB: the following integer arithmetic operation needs to be in its
      * expanded form due to the "integral promotion" performed (see section
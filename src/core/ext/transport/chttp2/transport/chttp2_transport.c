@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <grpc/grpc.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
@@ -183,6 +184,130 @@ static void keepalive_watchdog_fired_locked(grpc_exec_ctx *exec_ctx, void *arg,
 static void reset_byte_stream(grpc_exec_ctx *exec_ctx, void *arg,
                               grpc_error *error);
 
+/*******************************************************************************
+ * TRANSPORT INTROSPECTION
+ */
+
+/* Process-wide registry of live transports backing
+   grpc_transport_snapshots_collect(). The list links are guarded by
+   g_snapshot_registry_mu; the snapshot fields themselves are plain atomics
+   published from the combiner and read with relaxed loads, so collection
+   never blocks (or is blocked by) the data path. */
+static gpr_once g_snapshot_registry_once = GPR_ONCE_INIT;
+static gpr_mu g_snapshot_registry_mu;
+static grpc_chttp2_transport *g_snapshot_registry_head = NULL;
+static size_t g_snapshot_registry_count = 0;
+
+static void snapshot_registry_init(void) {
+  gpr_mu_init(&g_snapshot_registry_mu);
+}
+
+/* Called from the combiner (which owns all the fields read here) whenever
+   something interesting changed: O(1), a handful of relaxed stores. */
+static void publish_transport_snapshot(grpc_chttp2_transport *t) {
+  gpr_atm_no_barrier_store(&t->snapshot.is_client, t->is_client);
+  gpr_atm_no_barrier_store(
+      &t->snapshot.stream_count,
+      (gpr_atm)grpc_chttp2_stream_map_size(&t->stream_map));
+  gpr_atm_no_barrier_store(&t->snapshot.outgoing_window,
+                           (gpr_atm)t->outgoing_window);
+  gpr_atm_no_barrier_store(&t->snapshot.incoming_window,
+                           (gpr_atm)t->incoming_window);
+  gpr_atm_no_barrier_store(&t->snapshot.write_state, (gpr_atm)t->write_state);
+  gpr_atm_no_barrier_store(&t->snapshot.keepalive_state,
+                           (gpr_atm)t->keepalive_state);
+}
+
+static void snapshot_registry_add(grpc_chttp2_transport *t) {
+  gpr_once_init(&g_snapshot_registry_once, snapshot_registry_init);
+  gpr_mu_lock(&g_snapshot_registry_mu);
+  t->snapshot_prev = NULL;
+  t->snapshot_next = g_snapshot_registry_head;
+  if (g_snapshot_registry_head != NULL) {
+    g_snapshot_registry_head->snapshot_prev = t;
+  }
+  g_snapshot_registry_head = t;
+  g_snapshot_registry_count++;
+  gpr_mu_unlock(&g_snapshot_registry_mu);
+}
+
+static void snapshot_registry_remove(grpc_chttp2_transport *t) {
+  gpr_mu_lock(&g_snapshot_registry_mu);
+  if (t->snapshot_prev != NULL) {
+    t->snapshot_prev->snapshot_next = t->snapshot_next;
+  } else {
+    g_snapshot_registry_head = t->snapshot_next;
+  }
+  if (t->snapshot_next != NULL) {
+    t->snapshot_next->snapshot_prev = t->snapshot_prev;
+  }
+  g_snapshot_registry_count--;
+  gpr_mu_unlock(&g_snapshot_registry_mu);
+}
+
+size_t grpc_transport_snapshot_count(void) {
+  size_t count;
+  gpr_once_init(&g_snapshot_registry_once, snapshot_registry_init);
+  gpr_mu_lock(&g_snapshot_registry_mu);
+  count = g_snapshot_registry_count;
+  gpr_mu_unlock(&g_snapshot_registry_mu);
+  return count;
+}
+
+size_t grpc_transport_snapshots_collect(grpc_transport_snapshot *snapshots,
+                                        size_t max_snapshots) {
+  size_t n = 0;
+  grpc_chttp2_transport *t;
+  gpr_once_init(&g_snapshot_registry_once, snapshot_registry_init);
+  gpr_mu_lock(&g_snapshot_registry_mu);
+  for (t = g_snapshot_registry_head; t != NULL && n < max_snapshots;
+       t = t->snapshot_next) {
+    snapshots[n].is_client =
+        (int)gpr_atm_no_barrier_load(&t->snapshot.is_client);
+    snapshots[n].stream_count =
+        (uint32_t)gpr_atm_no_barrier_load(&t->snapshot.stream_count);
+    snapshots[n].outgoing_window =
+        (int64_t)gpr_atm_no_barrier_load(&t->snapshot.outgoing_window);
+    snapshots[n].incoming_window =
+        (int64_t)gpr_atm_no_barrier_load(&t->snapshot.incoming_window);
+    snapshots[n].write_state =
+        (int)gpr_atm_no_barrier_load(&t->snapshot.write_state);
+    snapshots[n].keepalive_state =
+        (int)gpr_atm_no_barrier_load(&t->snapshot.keepalive_state);
+    n++;
+  }
+  gpr_mu_unlock(&g_snapshot_registry_mu);
+  return n;
+}
+
+size_t grpc_transport_stall_reports_collect(
+    grpc_transport_stall_report *reports, size_t max_reports) {
+  size_t n = 0;
+  grpc_chttp2_transport *t;
+  gpr_once_init(&g_snapshot_registry_once, snapshot_registry_init);
+  gpr_mu_lock(&g_snapshot_registry_mu);
+  /* transports unregister before destroying their histograms, and do so
+     under the registry mutex, so everything reachable here is live; the
+     striped histograms are safe to snapshot against concurrent adds */
+  for (t = g_snapshot_registry_head; t != NULL && n < max_reports;
+       t = t->snapshot_next) {
+    reports[n].is_client = t->is_client;
+    reports[n].stalled_by_transport =
+        gpr_histogram_create(GRPC_CHTTP2_STALL_HISTOGRAM_RESOLUTION,
+                             GRPC_CHTTP2_STALL_HISTOGRAM_MAX_USEC);
+    gpr_histogram_striped_snapshot(t->stalled_by_transport_hist,
+                                   reports[n].stalled_by_transport);
+    reports[n].stalled_by_stream =
+        gpr_histogram_create(GRPC_CHTTP2_STALL_HISTOGRAM_RESOLUTION,
+                             GRPC_CHTTP2_STALL_HISTOGRAM_MAX_USEC);
+    gpr_histogram_striped_snapshot(t->stalled_by_stream_hist,
+                                   reports[n].stalled_by_stream);
+    n++;
+  }
+  gpr_mu_unlock(&g_snapshot_registry_mu);
+  return n;
+}
+
 /*******************************************************************************
  * CONSTRUCTION/DESTRUCTION/REFCOUNTING
  */
@@ -191,10 +316,17 @@ static void destruct_transport(grpc_exec_ctx *exec_ctx,
                                grpc_chttp2_transport *t) {
   size_t i;
 
+  snapshot_registry_remove(t);
+
+  gpr_histogram_striped_destroy(t->stalled_by_transport_hist);
+  gpr_histogram_striped_destroy(t->stalled_by_stream_hist);
+
   grpc_endpoint_destroy(exec_ctx, t->ep);
 
   grpc_slice_buffer_destroy_internal(exec_ctx, &t->qbuf);
 
+  gpr_mpscq_destroy(&t->op_staging_queue);
+
   grpc_slice_buffer_destroy_internal(exec_ctx, &t->outbuf);
   grpc_chttp2_hpack_compressor_destroy(exec_ctx, &t->hpack_compressor);
 
@@ -282,6 +414,8 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
 
   grpc_slice_buffer_init(&t->qbuf);
 
+  gpr_mpscq_init(&t->op_staging_queue);
+
   grpc_slice_buffer_init(&t->outbuf);
   grpc_chttp2_hpack_compressor_init(&t->hpack_compressor);
 
@@ -403,6 +537,12 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   }
   t->keepalive_permit_without_calls = g_default_keepalive_permit_without_calls;
 
+  /* when the endpoint's socket carries kernel TCP keepalive, application
+     level pings are redundant for dead-peer detection unless explicitly
+     requested */
+  bool kernel_liveness_armed = false;
+  bool explicit_keepalive_time = false;
+
   if (channel_args) {
     for (i = 0; i < channel_args->num_args; i++) {
       if (0 == strcmp(channel_args->args[i].key,
@@ -475,6 +615,13 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
         t->keepalive_time = value == INT_MAX
                                 ? gpr_inf_future(GPR_TIMESPAN)
                                 : gpr_time_from_millis(value, GPR_TIMESPAN);
+        explicit_keepalive_time = true;
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_KEEPALIVE_TIME_S)) {
+        kernel_liveness_armed =
+            grpc_channel_arg_get_integer(
+                &channel_args->args[i],
+                (grpc_integer_options){0, 0, INT_MAX}) > 0;
       } else if (0 == strcmp(channel_args->args[i].key,
                              GRPC_ARG_KEEPALIVE_TIMEOUT_MS)) {
         const int value = grpc_channel_arg_get_integer(
@@ -551,6 +698,12 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
   t->ping_recv_state.last_ping_recv_time = gpr_inf_past(GPR_CLOCK_MONOTONIC);
   t->ping_recv_state.ping_strikes = 0;
 
+  t->keepalive_last_read_time = gpr_now(GPR_CLOCK_MONOTONIC);
+
+  if (kernel_liveness_armed && !explicit_keepalive_time) {
+    t->keepalive_time = gpr_inf_future(GPR_TIMESPAN);
+  }
+
   /* Start keepalive pings */
   if (gpr_time_cmp(t->keepalive_time, gpr_inf_future(GPR_TIMESPAN)) != 0) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
@@ -565,6 +718,15 @@ static void init_transport(grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t,
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED;
   }
 
+  publish_transport_snapshot(t);
+  t->stalled_by_transport_hist =
+      gpr_histogram_striped_create(GRPC_CHTTP2_STALL_HISTOGRAM_RESOLUTION,
+                                   GRPC_CHTTP2_STALL_HISTOGRAM_MAX_USEC);
+  t->stalled_by_stream_hist =
+      gpr_histogram_striped_create(GRPC_CHTTP2_STALL_HISTOGRAM_RESOLUTION,
+                                   GRPC_CHTTP2_STALL_HISTOGRAM_MAX_USEC);
+  snapshot_registry_add(t);
+
   grpc_chttp2_initiate_write(exec_ctx, t, false, "init");
   post_benign_reclaimer(exec_ctx, t);
 }
@@ -672,13 +834,12 @@ static int init_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
   grpc_chttp2_data_parser_init(&s->data_parser);
   grpc_slice_buffer_init(&s->flow_controlled_buffer);
   s->deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
-  grpc_closure_init(&s->complete_fetch_locked, complete_fetch_locked, s,
-                    grpc_schedule_on_exec_ctx);
   grpc_slice_buffer_init(&s->unprocessed_incoming_frames_buffer);
   grpc_slice_buffer_init(&s->frame_storage);
   s->pending_byte_stream = false;
-  grpc_closure_init(&s->reset_byte_stream, reset_byte_stream, s,
-                    grpc_combiner_scheduler(t->combiner, false));
+  /* complete_fetch_locked and reset_byte_stream are initialized lazily at
+     their first use: many streams never fetch a send message or receive a
+     byte stream, so there is no point setting the closures up here */
 
   GRPC_CHTTP2_REF_TRANSPORT(t, "stream");
 
@@ -968,6 +1129,8 @@ static void write_action_end_locked(grpc_exec_ctx *exec_ctx, void *tp,
 
   grpc_chttp2_end_write(exec_ctx, t, GRPC_ERROR_REF(error));
 
+  publish_transport_snapshot(t);
+
   GRPC_CHTTP2_UNREF_TRANSPORT(exec_ctx, t, "writing");
   GPR_TIMER_END("terminate_writing_with_lock", 0);
 }
@@ -1197,8 +1360,11 @@ static void continue_fetching_send_locked(grpc_exec_ctx *exec_ctx,
       }
       s->fetching_send_message = NULL;
       return; /* early out */
-    } else if (grpc_byte_stream_next(exec_ctx, s->fetching_send_message,
-                                     UINT32_MAX, &s->complete_fetch_locked)) {
+    } else if (grpc_byte_stream_next(
+                   exec_ctx, s->fetching_send_message, UINT32_MAX,
+                   grpc_closure_init(&s->complete_fetch_locked,
+                                     complete_fetch_locked, s,
+                                     grpc_schedule_on_exec_ctx))) {
       grpc_byte_stream_pull(exec_ctx, s->fetching_send_message,
                             &s->fetching_slice);
       add_fetched_slice_locked(exec_ctx, t, s);
@@ -1292,6 +1458,13 @@ static void perform_stream_op_locked(grpc_exec_ctx *exec_ctx, void *stream_op,
     s->send_initial_metadata_finished = add_closure_barrier(on_complete);
     s->send_initial_metadata =
         op_payload->send_initial_metadata.send_initial_metadata;
+    /* adopt the stream's write scheduling class before it is first queued as
+       writable; once queued, the class sticks until the stream is requeued */
+    if (!s->included[GRPC_CHTTP2_LIST_WRITABLE] &&
+        !s->included[GRPC_CHTTP2_LIST_WRITABLE_HIGH] &&
+        !s->included[GRPC_CHTTP2_LIST_WRITABLE_BULK]) {
+      s->write_priority = op_payload->send_initial_metadata.write_priority;
+    }
     const size_t metadata_size =
         grpc_metadata_batch_size(s->send_initial_metadata);
     const size_t metadata_peer_limit =
@@ -1485,6 +1658,23 @@ static void perform_stream_op_locked(grpc_exec_ctx *exec_ctx, void *stream_op,
   GRPC_CHTTP2_STREAM_UNREF(exec_ctx, s, "perform_stream_op");
 }
 
+/* drain every staged stream op batch in one combiner acquisition */
+static void op_staging_drain_locked(grpc_exec_ctx *exec_ctx, void *tp,
+                                    grpc_error *error_ignored) {
+  grpc_chttp2_transport *t = tp;
+  /* clear the flag before detaching the queue: a producer pushing after the
+     detach then schedules a fresh drain instead of relying on this one */
+  gpr_atm_rel_store(&t->op_staging_active, 0);
+  gpr_mpscq_node *n = gpr_mpscq_pop_all(&t->op_staging_queue);
+  while (n != NULL) {
+    /* next_data heads grpc_closure, so the node doubles as the closure */
+    grpc_closure *cl = (grpc_closure *)n;
+    n = (gpr_mpscq_node *)gpr_atm_no_barrier_load(&n->next);
+    perform_stream_op_locked(exec_ctx, cl->cb_arg, GRPC_ERROR_NONE);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(exec_ctx, t, "op_staging");
+}
+
 static void perform_stream_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
                               grpc_stream *gs,
                               grpc_transport_stream_op_batch *op) {
@@ -1500,12 +1690,19 @@ static void perform_stream_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
 
   op->handler_private.extra_arg = gs;
   GRPC_CHTTP2_STREAM_REF(s, "perform_stream_op");
-  grpc_closure_sched(
-      exec_ctx,
-      grpc_closure_init(
-          &op->handler_private.closure, perform_stream_op_locked, op,
-          grpc_combiner_scheduler(t->combiner, op->covered_by_poller)),
-      GRPC_ERROR_NONE);
+  grpc_closure_init(&op->handler_private.closure, perform_stream_op_locked, op,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mpscq_push(&t->op_staging_queue,
+                 &op->handler_private.closure.next_data.atm_next);
+  if (gpr_atm_full_cas(&t->op_staging_active, 0, 1)) {
+    GRPC_CHTTP2_REF_TRANSPORT(t, "op_staging");
+    grpc_closure_sched(
+        exec_ctx,
+        grpc_closure_init(
+            &t->op_staging_drain_locked, op_staging_drain_locked, t,
+            grpc_combiner_scheduler(t->combiner, op->covered_by_poller)),
+        GRPC_ERROR_NONE);
+  }
   GPR_TIMER_END("perform_stream_op", 0);
 }
 
@@ -1622,6 +1819,11 @@ static void perform_transport_op_locked(grpc_exec_ctx *exec_ctx,
                      op->send_ping);
   }
 
+  if (op->max_concurrent_streams != 0) {
+    push_setting(exec_ctx, t, GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+                 op->max_concurrent_streams);
+  }
+
   if (close_transport != GRPC_ERROR_NONE) {
     close_transport_locked(exec_ctx, t, close_transport);
   }
@@ -2225,6 +2427,9 @@ static void read_action_locked(grpc_exec_ctx *exec_ctx, void *tp,
   GPR_SWAP(grpc_error *, err, error);
   GRPC_ERROR_UNREF(err);
   if (!t->closed) {
+    if (t->read_buffer.count > 0) {
+      t->keepalive_last_read_time = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
     GPR_TIMER_BEGIN("reading_action.parse", 0);
     size_t i = 0;
     grpc_error *errors[3] = {GRPC_ERROR_REF(error), GRPC_ERROR_NONE,
@@ -2278,6 +2483,8 @@ static void read_action_locked(grpc_exec_ctx *exec_ctx, void *tp,
   }
   grpc_slice_buffer_reset_and_unref_internal(exec_ctx, &t->read_buffer);
 
+  publish_transport_snapshot(t);
+
   if (keep_reading) {
     grpc_endpoint_read(exec_ctx, t->ep, &t->read_buffer,
                        &t->read_action_locked);
@@ -2401,8 +2608,20 @@ static void init_keepalive_ping_locked(grpc_exec_ctx *exec_ctx, void *arg,
   if (t->destroying || t->closed) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_DYING;
   } else if (error == GRPC_ERROR_NONE) {
-    if (t->keepalive_permit_without_calls ||
-        grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    gpr_timespec time_since_read =
+        gpr_time_sub(now, t->keepalive_last_read_time);
+    if (gpr_time_cmp(time_since_read, t->keepalive_time) < 0) {
+      /* the connection has been read from within the last keepalive period,
+         so it is demonstrably alive: skip the ping and re-arm for one
+         keepalive period after the last read */
+      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
+      grpc_timer_init(
+          exec_ctx, &t->keepalive_ping_timer,
+          gpr_time_add(t->keepalive_last_read_time, t->keepalive_time),
+          &t->init_keepalive_ping_locked, now);
+    } else if (t->keepalive_permit_without_calls ||
+               grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_PINGING;
       GRPC_CHTTP2_REF_TRANSPORT(t, "keepalive ping end");
       send_ping_locked(exec_ctx, t, GRPC_CHTTP2_PING_ON_NEXT_WRITE,
@@ -2556,6 +2775,21 @@ static void incoming_byte_stream_update_flow_control(grpc_exec_ctx *exec_ctx,
     max_recv_bytes = 0;
   }
 
+  /* when bdp probing is on, floor the lookahead at the transport's bdp
+     estimate so a single fast stream can keep a long fat pipe full even if
+     the application asks for one small message at a time; the grant stays
+     bounded by the quota through the usual resource-user accounting */
+  if (t->enable_bdp_probe) {
+    int64_t estimate = -1;
+    if (grpc_bdp_estimator_get_estimate(&t->bdp_estimator, &estimate)) {
+      uint32_t bdp_lookahead = (uint32_t)GPR_CLAMP(
+          estimate, 0, (int64_t)(UINT32_MAX - initial_window_size));
+      if (max_recv_bytes < bdp_lookahead) {
+        max_recv_bytes = bdp_lookahead;
+      }
+    }
+  }
+
   /* add some small lookahead to keep pipelines flowing */
   GPR_ASSERT(max_recv_bytes <= UINT32_MAX - initial_window_size);
   if (s->incoming_window_delta < max_recv_bytes && !s->read_closed) {
@@ -2768,10 +3002,17 @@ grpc_chttp2_incoming_byte_stream *grpc_chttp2_incoming_byte_stream_create(
   incoming_byte_stream->base.flags = flags;
   incoming_byte_stream->base.next = incoming_byte_stream_next;
   incoming_byte_stream->base.pull = incoming_byte_stream_pull;
+  /* deframing yields one slice per frame; the generic pull_buffer loop
+     already drains every synchronously available frame in one call */
+  incoming_byte_stream->base.pull_buffer = NULL;
   incoming_byte_stream->base.destroy = incoming_byte_stream_destroy;
   gpr_ref_init(&incoming_byte_stream->refs, 2);
   incoming_byte_stream->transport = t;
   incoming_byte_stream->stream = s;
+  /* every reset_byte_stream scheduling point is downstream of a byte stream
+     created here, so this is the closure's lazy initialization site */
+  grpc_closure_init(&s->reset_byte_stream, reset_byte_stream, s,
+                    grpc_combiner_scheduler(t->combiner, false));
   s->byte_stream_error = GRPC_ERROR_NONE;
   return incoming_byte_stream;
 }
@@ -48,6 +48,7 @@
 #include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_table.h"
 #include "src/core/ext/transport/chttp2/transport/varint.h"
+#include "src/core/lib/debug/trace.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/transport/metadata.h"
@@ -62,8 +63,18 @@
 /* if the probability of this item being seen again is < 1/x then don't add
    it to the table */
 #define ONE_ON_ADD_PROBABILITY 128
+/* a value seen at least this often (within filter decay) has demonstrably
+   repeated and is indexed regardless of its share of total traffic */
+#define ELEM_REPEAT_ADD_THRESHOLD 2
+/* a key must be sighted this often before we judge its volatility */
+#define KEY_VOLATILITY_MIN_SAMPLES 8
+/* a key is volatile if its current value repeats in fewer than one in this
+   many sightings of the key: such values never enter the table */
+#define KEY_VOLATILITY_FACTOR 8
 /* don't consider adding anything bigger than this to the hpack table */
 #define MAX_DECODER_SPACE_USAGE 512
+/* largest header block (in bytes) kept in the encoded-batch cache */
+#define MAX_CACHED_BATCH_BYTES 1024
 
 static grpc_slice_refcount terminal_slice_refcount = {NULL, NULL};
 static const grpc_slice terminal_slice = {&terminal_slice_refcount,
@@ -179,6 +190,8 @@ static uint8_t *add_tiny_header_data(framer_state *st, size_t len) {
 }
 
 static void evict_entry(grpc_chttp2_hpack_compressor *c) {
+  c->stat_evictions++;
+  c->table_state++;
   c->tail_remote_index++;
   GPR_ASSERT(c->tail_remote_index > 0);
   GPR_ASSERT(c->table_size >=
@@ -194,6 +207,9 @@ static void evict_entry(grpc_chttp2_hpack_compressor *c) {
 static void add_elem(grpc_exec_ctx *exec_ctx, grpc_chttp2_hpack_compressor *c,
                      grpc_mdelem elem) {
   GPR_ASSERT(GRPC_MDELEM_IS_INTERNED(elem));
+  c->stat_adds++;
+
+  c->table_state++;
 
   uint32_t key_hash = grpc_slice_hash(GRPC_MDKEY(elem));
   uint32_t value_hash = grpc_slice_hash(GRPC_MDVALUE(elem));
@@ -286,6 +302,7 @@ static void add_elem(grpc_exec_ctx *exec_ctx, grpc_chttp2_hpack_compressor *c,
 
 static void emit_indexed(grpc_chttp2_hpack_compressor *c, uint32_t elem_index,
                          framer_state *st) {
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_HITS);
   uint32_t len = GRPC_CHTTP2_VARINT_LENGTH(elem_index, 1);
   GRPC_CHTTP2_WRITE_VARINT(elem_index, 1, 0x80, add_tiny_header_data(st, len),
                            len);
@@ -454,12 +471,14 @@ static void hpack_enc(grpc_exec_ctx *exec_ctx, grpc_chttp2_hpack_compressor *c,
   elem_hash = GRPC_MDSTR_KV_HASH(key_hash, value_hash);
 
   inc_filter(HASH_FRAGMENT_1(elem_hash), &c->filter_elems_sum, c->filter_elems);
+  inc_filter(HASH_FRAGMENT_1(key_hash), &c->filter_keys_sum, c->filter_keys);
 
   /* is this elem currently in the decoders table? */
 
   if (grpc_mdelem_eq(c->entries_elems[HASH_FRAGMENT_2(elem_hash)], elem) &&
       c->indices_elems[HASH_FRAGMENT_2(elem_hash)] > c->tail_remote_index) {
     /* HIT: complete element (first cuckoo hash) */
+    c->stat_indexed_hits++;
     emit_indexed(c, dynidx(c, c->indices_elems[HASH_FRAGMENT_2(elem_hash)]),
                  st);
     return;
@@ -468,16 +487,25 @@ static void hpack_enc(grpc_exec_ctx *exec_ctx, grpc_chttp2_hpack_compressor *c,
   if (grpc_mdelem_eq(c->entries_elems[HASH_FRAGMENT_3(elem_hash)], elem) &&
       c->indices_elems[HASH_FRAGMENT_3(elem_hash)] > c->tail_remote_index) {
     /* HIT: complete element (second cuckoo hash) */
+    c->stat_indexed_hits++;
     emit_indexed(c, dynidx(c, c->indices_elems[HASH_FRAGMENT_3(elem_hash)]),
                  st);
     return;
   }
 
-  /* should this elem be in the table? */
+  /* should this elem be in the table? a key that is sighted constantly but
+     whose values essentially never repeat (per-call request ids and the
+     like) is never indexed: its entries would only evict stable ones */
+  uint32_t elem_count = c->filter_elems[HASH_FRAGMENT_1(elem_hash)];
+  uint32_t key_count = c->filter_keys[HASH_FRAGMENT_1(key_hash)];
+  bool key_is_volatile = key_count >= KEY_VOLATILITY_MIN_SAMPLES &&
+                         elem_count * KEY_VOLATILITY_FACTOR < key_count;
   decoder_space_usage = grpc_mdelem_get_size_in_hpack_table(elem);
   should_add_elem = decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
-                    c->filter_elems[HASH_FRAGMENT_1(elem_hash)] >=
-                        c->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
+                    !key_is_volatile &&
+                    (elem_count >= ELEM_REPEAT_ADD_THRESHOLD ||
+                     elem_count >= c->filter_elems_sum / ONE_ON_ADD_PROBABILITY);
+  if (key_is_volatile) c->stat_adds_skipped_volatile++;
 
   /* no hits for the elem... maybe there's a key? */
 
@@ -534,12 +562,114 @@ static void deadline_enc(grpc_exec_ctx *exec_ctx,
                          framer_state *st) {
   char timeout_str[GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE];
   grpc_mdelem mdelem;
-  grpc_http2_encode_timeout(
-      gpr_time_sub(deadline, gpr_now(deadline.clock_type)), timeout_str);
+  grpc_http2_timeout timeout = grpc_http2_quantize_timeout(
+      gpr_time_sub(deadline, gpr_now(deadline.clock_type)));
+  grpc_chttp2_hpack_cached_timeout *lru = &c->cached_timeouts[0];
+  size_t i;
+  /* deadlines quantize down to few distinct wire strings: check the cache
+     before reaching for string formatting and mdelem creation.
+     tick wraparound merely distorts eviction order, never correctness */
+  c->timeout_cache_tick++;
+  for (i = 0; i < GPR_ARRAY_SIZE(c->cached_timeouts); i++) {
+    grpc_chttp2_hpack_cached_timeout *entry = &c->cached_timeouts[i];
+    if (!GRPC_MDISNULL(entry->mdelem) &&
+        entry->timeout.value == timeout.value &&
+        entry->timeout.unit == timeout.unit) {
+      entry->last_used = c->timeout_cache_tick;
+      hpack_enc(exec_ctx, c, entry->mdelem, st);
+      return;
+    }
+    if (entry->last_used < lru->last_used) lru = entry;
+  }
+  grpc_http2_timeout_to_string(timeout, timeout_str);
   mdelem = grpc_mdelem_from_slices(exec_ctx, GRPC_MDSTR_GRPC_TIMEOUT,
                                    grpc_slice_from_copied_string(timeout_str));
   hpack_enc(exec_ctx, c, mdelem, st);
-  GRPC_MDELEM_UNREF(exec_ctx, mdelem);
+  /* remember the element in place of the least recently used entry; the
+     cache takes over our ref */
+  GRPC_MDELEM_UNREF(exec_ctx, lru->mdelem);
+  lru->timeout = timeout;
+  lru->mdelem = mdelem;
+  lru->last_used = c->timeout_cache_tick;
+}
+
+/* pick the cache slot for a sequence of elements: keyed purely on element
+   identity, which for interned elements implies identity of the bytes */
+static grpc_chttp2_hpack_encoded_batch *batch_cache_slot(
+    grpc_chttp2_hpack_compressor *c, const grpc_mdelem *elems,
+    uint32_t num_elems) {
+  uint32_t hash = num_elems;
+  uint32_t i;
+  for (i = 0; i < num_elems; i++) {
+    hash = GRPC_MDSTR_KV_HASH(hash, (uint32_t)(elems[i].payload >> 4));
+  }
+  return &c->encoded_batches[hash % GRPC_CHTTP2_HPACKC_NUM_CACHED_BATCHES];
+}
+
+static bool encoded_batch_matches(const grpc_chttp2_hpack_encoded_batch *entry,
+                                  const grpc_mdelem *elems, uint32_t num_elems,
+                                  uint32_t table_state, bool true_binary) {
+  uint32_t i;
+  if (entry->num_bytes == 0 || entry->num_elems != num_elems ||
+      entry->table_state != table_state || entry->true_binary != true_binary) {
+    return false;
+  }
+  for (i = 0; i < num_elems; i++) {
+    if (entry->elems[i].payload != elems[i].payload) return false;
+  }
+  return true;
+}
+
+/* copy the last \a num_bytes bytes of \a output into \a dst: the recorded
+   region lies beyond the current frame header, so it is contiguous header
+   block payload */
+static void copy_tail_bytes(grpc_slice_buffer *output, size_t num_bytes,
+                            uint8_t *dst) {
+  size_t idx = output->count;
+  size_t skip = 0;
+  size_t remaining = num_bytes;
+  while (remaining > 0) {
+    idx--;
+    size_t len = GRPC_SLICE_LENGTH(output->slices[idx]);
+    if (len >= remaining) {
+      skip = len - remaining;
+      remaining = 0;
+    } else {
+      remaining -= len;
+    }
+  }
+  for (; idx < output->count; idx++) {
+    grpc_slice s = output->slices[idx];
+    memcpy(dst, GRPC_SLICE_START_PTR(s) + skip, GRPC_SLICE_LENGTH(s) - skip);
+    dst += GRPC_SLICE_LENGTH(s) - skip;
+    skip = 0;
+  }
+}
+
+static void encoded_batch_record(grpc_exec_ctx *exec_ctx,
+                                 grpc_chttp2_hpack_compressor *c,
+                                 grpc_chttp2_hpack_encoded_batch *entry,
+                                 const grpc_mdelem *elems, uint32_t num_elems,
+                                 bool true_binary, framer_state *st,
+                                 size_t payload_start) {
+  size_t num_bytes = st->output->length - payload_start;
+  uint32_t i;
+  if (num_bytes == 0 || num_bytes > MAX_CACHED_BATCH_BYTES) return;
+  for (i = 0; i < entry->num_elems; i++) {
+    GRPC_MDELEM_UNREF(exec_ctx, entry->elems[i]);
+  }
+  for (i = 0; i < num_elems; i++) {
+    entry->elems[i] = GRPC_MDELEM_REF(elems[i]);
+  }
+  entry->num_elems = num_elems;
+  entry->table_state = c->table_state;
+  entry->true_binary = true_binary;
+  if (entry->cap_bytes < num_bytes) {
+    entry->bytes = gpr_realloc(entry->bytes, num_bytes);
+    entry->cap_bytes = num_bytes;
+  }
+  entry->num_bytes = num_bytes;
+  copy_tail_bytes(st->output, num_bytes, entry->bytes);
 }
 
 static uint32_t elems_for_bytes(uint32_t bytes) { return (bytes + 31) / 32; }
@@ -568,6 +698,16 @@ void grpc_chttp2_hpack_compressor_destroy(grpc_exec_ctx *exec_ctx,
     }
     GRPC_MDELEM_UNREF(exec_ctx, c->entries_elems[i]);
   }
+  for (i = 0; i < GRPC_CHTTP2_HPACKC_NUM_CACHED_BATCHES; i++) {
+    grpc_chttp2_hpack_encoded_batch *entry = &c->encoded_batches[i];
+    for (uint32_t j = 0; j < entry->num_elems; j++) {
+      GRPC_MDELEM_UNREF(exec_ctx, entry->elems[j]);
+    }
+    gpr_free(entry->bytes);
+  }
+  for (i = 0; i < GRPC_CHTTP2_HPACKC_NUM_CACHED_TIMEOUTS; i++) {
+    GRPC_MDELEM_UNREF(exec_ctx, c->cached_timeouts[i].mdelem);
+  }
   gpr_free(c->table_elem_size);
 }
 
@@ -605,6 +745,7 @@ void grpc_chttp2_hpack_compressor_set_max_table_size(
   while (c->table_size > 0 && c->table_size > max_table_size) {
     evict_entry(c);
   }
+  c->table_state++;
   c->max_table_size = max_table_size;
   c->max_table_elems = elems_for_bytes(max_table_size);
   if (c->max_table_elems > c->cap_table_elems) {
@@ -629,6 +770,9 @@ void grpc_chttp2_encode_header(grpc_exec_ctx *exec_ctx,
   framer_state st;
   grpc_linked_mdelem *l;
   gpr_timespec deadline;
+  grpc_mdelem batch_elems[GRPC_CHTTP2_HPACKC_MAX_CACHED_BATCH_ELEMS];
+  uint32_t num_batch_elems = 0;
+  bool cacheable = true;
 
   GPR_ASSERT(options->stream_id != 0);
 
@@ -640,6 +784,24 @@ void grpc_chttp2_encode_header(grpc_exec_ctx *exec_ctx,
   st.max_frame_size = options->max_frame_size;
   st.use_true_binary_metadata = options->use_true_binary_metadata;
 
+  /* is this batch eligible for the encoded-batch cache? only sequences of
+     interned elements qualify: identity of an interned element implies
+     identity of its bytes, so an identical sequence encoded against an
+     unchanged remote table yields identical output */
+  if (options->extra_metadata != NULL) {
+    /* two-batch encodes (trailers-only responses) are rare enough not to be
+       worth a cache slot */
+    cacheable = false;
+  }
+  for (l = metadata->list.head; cacheable && l; l = l->next) {
+    if (num_batch_elems == GPR_ARRAY_SIZE(batch_elems) ||
+        !GRPC_MDELEM_IS_INTERNED(l->md)) {
+      cacheable = false;
+      break;
+    }
+    batch_elems[num_batch_elems++] = l->md;
+  }
+
   /* Encode a metadata batch; store the returned values, representing
      a metadata element that needs to be unreffed back into the metadata
      slot. THIS MAY NOT BE THE SAME ELEMENT (if a decoder table slot got
@@ -649,8 +811,35 @@ void grpc_chttp2_encode_header(grpc_exec_ctx *exec_ctx,
     emit_advertise_table_size_change(c, &st);
   }
   grpc_metadata_batch_assert_ok(metadata);
-  for (l = metadata->list.head; l; l = l->next) {
-    hpack_enc(exec_ctx, c, l->md, &st);
+  grpc_chttp2_hpack_encoded_batch *cached =
+      cacheable ? batch_cache_slot(c, batch_elems, num_batch_elems) : NULL;
+  if (cached != NULL &&
+      encoded_batch_matches(cached, batch_elems, num_batch_elems,
+                            c->table_state, st.use_true_binary_metadata)) {
+    /* HIT: this exact sequence was encoded before and the remote table has
+       not changed since: replay the recorded header block */
+    add_header_data(&st, grpc_slice_from_copied_buffer((char *)cached->bytes,
+                                                       cached->num_bytes));
+  } else {
+    uint32_t table_state_before = c->table_state;
+    size_t payload_start = st.output->length;
+    for (l = metadata->list.head; l; l = l->next) {
+      hpack_enc(exec_ctx, c, l->md, &st);
+    }
+    if (options->extra_metadata != NULL) {
+      grpc_metadata_batch_assert_ok(options->extra_metadata);
+      for (l = options->extra_metadata->list.head; l; l = l->next) {
+        hpack_enc(exec_ctx, c, l->md, &st);
+      }
+    }
+    /* record for replay if encoding left the remote table untouched (so an
+       identical batch will produce identical bytes) and stayed within one
+       frame (so the payload is contiguous in the output) */
+    if (cached != NULL && c->table_state == table_state_before &&
+        st.is_first_frame) {
+      encoded_batch_record(exec_ctx, c, cached, batch_elems, num_batch_elems,
+                           st.use_true_binary_metadata, &st, payload_start);
+    }
   }
   deadline = metadata->deadline;
   if (gpr_time_cmp(deadline, gpr_inf_future(deadline.clock_type)) != 0) {
@@ -40,6 +40,7 @@
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/lib/transport/metadata.h"
 #include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/timeout_encoding.h"
 #include "src/core/lib/transport/transport.h"
 
 #define GRPC_CHTTP2_HPACKC_NUM_FILTERS 256
@@ -48,6 +49,38 @@
 #define GRPC_CHTTP2_HPACKC_INITIAL_TABLE_SIZE 4096
 /* maximum table size we'll actually use */
 #define GRPC_CHTTP2_HPACKC_MAX_TABLE_SIZE (1024 * 1024)
+/* number of recently encoded header blocks remembered for replay */
+#define GRPC_CHTTP2_HPACKC_NUM_CACHED_BATCHES 4
+/* number of encoded grpc-timeout values remembered: deadline-heavy clients
+   typically use a handful of configured deadlines, which quantize down to a
+   small set of wire strings */
+#define GRPC_CHTTP2_HPACKC_NUM_CACHED_TIMEOUTS 8
+/* largest batch (in elements) eligible for the encoded-batch cache */
+#define GRPC_CHTTP2_HPACKC_MAX_CACHED_BATCH_ELEMS 32
+
+/* a previously encoded header block: when the identical sequence of interned
+   elements is encoded again and nothing about the remote table has changed in
+   between, the recorded bytes are emitted directly instead of re-running the
+   compressor over each element */
+typedef struct {
+  grpc_mdelem elems[GRPC_CHTTP2_HPACKC_MAX_CACHED_BATCH_ELEMS];
+  uint32_t num_elems;
+  /* value of the compressor's table_state when the bytes were recorded:
+     entries recorded against an older state are stale */
+  uint32_t table_state;
+  bool true_binary;
+  uint8_t *bytes;
+  size_t num_bytes;
+  size_t cap_bytes;
+} grpc_chttp2_hpack_encoded_batch;
+
+/* a grpc-timeout mdelem remembered against its quantized timeout, so that
+   repeated deadlines skip string formatting and mdelem creation */
+typedef struct {
+  grpc_http2_timeout timeout;
+  grpc_mdelem mdelem;
+  uint32_t last_used;
+} grpc_chttp2_hpack_cached_timeout;
 
 typedef struct {
   uint32_t filter_elems_sum;
@@ -64,6 +97,9 @@ typedef struct {
   uint32_t tail_remote_index;
   uint32_t table_size;
   uint32_t table_elems;
+  /* incremented on every change to the remote table (additions, evictions,
+     size changes): guards validity of cached encoded batches */
+  uint32_t table_state;
 
   /* filter tables for elems: this tables provides an approximate
      popularity count for particular hashes, and are used to determine whether
@@ -72,6 +108,19 @@ typedef struct {
      been seen. When that count reaches max (255), all values are halved. */
   uint8_t filter_elems[GRPC_CHTTP2_HPACKC_NUM_FILTERS];
 
+  /* like filter_elems, but counting key sightings regardless of value: a key
+     seen often whose individual values almost never repeat is volatile, and
+     its values are kept out of the table entirely */
+  uint32_t filter_keys_sum;
+  uint8_t filter_keys[GRPC_CHTTP2_HPACKC_NUM_FILTERS];
+
+  /* indexing-policy counters: table churn vs. payoff, for diagnosing
+     eviction pressure */
+  uint64_t stat_adds;
+  uint64_t stat_evictions;
+  uint64_t stat_adds_skipped_volatile;
+  uint64_t stat_indexed_hits;
+
   /* entry tables for keys & elems: these tables track values that have been
      seen and *may* be in the decompressor table */
   grpc_slice entries_keys[GRPC_CHTTP2_HPACKC_NUM_VALUES];
@@ -80,6 +129,16 @@ typedef struct {
   uint32_t indices_elems[GRPC_CHTTP2_HPACKC_NUM_VALUES];
 
   uint16_t *table_elem_size;
+
+  /* cache of encoded header blocks, direct mapped by a hash of the element
+     sequence */
+  grpc_chttp2_hpack_encoded_batch
+      encoded_batches[GRPC_CHTTP2_HPACKC_NUM_CACHED_BATCHES];
+
+  /* small LRU of encoded grpc-timeout elements, keyed by quantized timeout */
+  grpc_chttp2_hpack_cached_timeout
+      cached_timeouts[GRPC_CHTTP2_HPACKC_NUM_CACHED_TIMEOUTS];
+  uint32_t timeout_cache_tick;
 } grpc_chttp2_hpack_compressor;
 
 void grpc_chttp2_hpack_compressor_init(grpc_chttp2_hpack_compressor *c);
@@ -96,6 +155,10 @@ typedef struct {
   bool use_true_binary_metadata;
   size_t max_frame_size;
   grpc_transport_one_way_stats *stats;
+  /** optional second batch encoded into the same header block, after
+      \a metadata: lets a server fold status trailers into a single
+      trailers-only HEADERS frame. NULL for a normal single-batch encode. */
+  grpc_metadata_batch *extra_metadata;
 } grpc_encode_header_options;
 
 void grpc_chttp2_encode_header(grpc_exec_ctx *exec_ctx,
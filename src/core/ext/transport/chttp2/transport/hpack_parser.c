@@ -1474,6 +1474,39 @@ static grpc_error *huff_nibble(grpc_exec_ctx *exec_ctx,
 static grpc_error *add_huff_bytes(grpc_exec_ctx *exec_ctx,
                                   grpc_chttp2_hpack_parser *p,
                                   const uint8_t *cur, const uint8_t *end) {
+  /* Fast path for non-binary strings: decoded bytes go straight into the
+     output string, so the whole input can be driven through the transition
+     tables in one tight loop, batching emitted bytes locally instead of
+     routing each one through append_string. Binary (base64) strings fall
+     through to the per-nibble path below, which tracks base64 state and can
+     fail on illegal input. */
+  if ((binary_state)p->binary == NOT_BINARY) {
+    uint8_t emitted[256];
+    size_t num_emitted = 0;
+    int16_t state = p->huff_state;
+    for (; cur != end; ++cur) {
+      int nib;
+      int16_t nibbles[2];
+      nibbles[0] = *cur >> 4;
+      nibbles[1] = *cur & 0xf;
+      for (nib = 0; nib < 2; nib++) {
+        int16_t emit = emit_sub_tbl[16 * emit_tbl[state] + nibbles[nib]];
+        state = next_sub_tbl[16 * next_tbl[state] + nibbles[nib]];
+        if (emit >= 0 && emit < 256) {
+          emitted[num_emitted++] = (uint8_t)emit;
+        }
+      }
+      if (num_emitted >= sizeof(emitted) - 2) {
+        append_bytes(p->parsing.str, emitted, num_emitted);
+        num_emitted = 0;
+      }
+    }
+    if (num_emitted > 0) {
+      append_bytes(p->parsing.str, emitted, num_emitted);
+    }
+    p->huff_state = state;
+    return GRPC_ERROR_NONE;
+  }
   for (; cur != end; ++cur) {
     grpc_error *err = huff_nibble(exec_ctx, p, *cur >> 4);
     if (err != GRPC_ERROR_NONE) return parse_error(exec_ctx, p, cur, end, err);
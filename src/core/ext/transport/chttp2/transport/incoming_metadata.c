@@ -40,11 +40,16 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+/* number of grpc_linked_mdelem slots carved out of the arena at a time */
+#define PREALLOCATED_MDELEM_BLOCK 8
+
 void grpc_chttp2_incoming_metadata_buffer_init(
     grpc_chttp2_incoming_metadata_buffer *buffer, gpr_arena *arena) {
   buffer->arena = arena;
   grpc_metadata_batch_init(&buffer->batch);
   buffer->batch.deadline = gpr_inf_future(GPR_CLOCK_REALTIME);
+  buffer->preallocated_mdelems = NULL;
+  buffer->preallocated_mdelems_remaining = 0;
 }
 
 void grpc_chttp2_incoming_metadata_buffer_destroy(
@@ -56,9 +61,14 @@ grpc_error *grpc_chttp2_incoming_metadata_buffer_add(
     grpc_exec_ctx *exec_ctx, grpc_chttp2_incoming_metadata_buffer *buffer,
     grpc_mdelem elem) {
   buffer->size += GRPC_MDELEM_LENGTH(elem);
-  return grpc_metadata_batch_add_tail(
-      exec_ctx, &buffer->batch,
-      gpr_arena_alloc(buffer->arena, sizeof(grpc_linked_mdelem)), elem);
+  if (buffer->preallocated_mdelems_remaining == 0) {
+    buffer->preallocated_mdelems = gpr_arena_alloc(
+        buffer->arena, PREALLOCATED_MDELEM_BLOCK * sizeof(grpc_linked_mdelem));
+    buffer->preallocated_mdelems_remaining = PREALLOCATED_MDELEM_BLOCK;
+  }
+  grpc_linked_mdelem *storage = buffer->preallocated_mdelems++;
+  buffer->preallocated_mdelems_remaining--;
+  return grpc_metadata_batch_add_tail(exec_ctx, &buffer->batch, storage, elem);
 }
 
 grpc_error *grpc_chttp2_incoming_metadata_buffer_replace_or_add(
@@ -40,6 +40,11 @@ typedef struct {
   gpr_arena *arena;
   grpc_metadata_batch batch;
   size_t size;  // total size of metadata
+  // block of preallocated grpc_linked_mdelem storage: headers typically
+  // arrive many at a time, so they are carved out of the arena in batches
+  // rather than one allocation per element
+  grpc_linked_mdelem *preallocated_mdelems;
+  size_t preallocated_mdelems_remaining;
 } grpc_chttp2_incoming_metadata_buffer;
 
 /** assumes everything initially zeroed */
@@ -37,6 +37,8 @@
 #include <assert.h>
 #include <stdbool.h>
 
+#include <grpc/support/histogram.h>
+
 #include "src/core/ext/transport/chttp2/transport/frame.h"
 #include "src/core/ext/transport/chttp2/transport/frame_data.h"
 #include "src/core/ext/transport/chttp2/transport/frame_goaway.h"
@@ -51,6 +53,7 @@
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/support/mpscq.h"
 #include "src/core/lib/transport/bdp_estimator.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/pid_controller.h"
@@ -59,7 +62,11 @@
 /* streams are kept in various linked lists depending on what things need to
    happen to them... this enum labels each list */
 typedef enum {
+  /** writable streams, one list per scheduling class; see
+      grpc_chttp2_list_pop_writable_stream for the service order */
   GRPC_CHTTP2_LIST_WRITABLE,
+  GRPC_CHTTP2_LIST_WRITABLE_HIGH,
+  GRPC_CHTTP2_LIST_WRITABLE_BULK,
   GRPC_CHTTP2_LIST_WRITING,
   GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT,
   GRPC_CHTTP2_LIST_STALLED_BY_STREAM,
@@ -248,6 +255,11 @@ struct grpc_chttp2_transport {
   /** various lists of streams */
   grpc_chttp2_stream_list lists[STREAM_LIST_COUNT];
 
+  /** consecutive writable-stream pops served without yielding a slot to a
+      lower scheduling class; drives the anti-starvation rotation in
+      grpc_chttp2_list_pop_writable_stream */
+  uint8_t writable_pops_since_yield;
+
   /** maps stream id to grpc_chttp2_stream objects */
   grpc_chttp2_stream_map stream_map;
 
@@ -257,6 +269,15 @@ struct grpc_chttp2_transport {
 
   grpc_closure read_action_locked;
 
+  /** stream op batches staged for the next combiner acquisition; nodes are
+      each batch's handler_private closure. one drain closure empties the
+      whole queue so that concurrent calls issuing ops cost one combiner
+      execution rather than one apiece */
+  gpr_mpscq op_staging_queue;
+  /** 1 while op_staging_drain_locked is scheduled */
+  gpr_atm op_staging_active;
+  grpc_closure op_staging_drain_locked;
+
   /** incoming read bytes */
   grpc_slice_buffer read_buffer;
 
@@ -421,8 +442,37 @@ struct grpc_chttp2_transport {
   bool keepalive_permit_without_calls;
   /** keep-alive state machine state */
   grpc_chttp2_keepalive_state keepalive_state;
+  /** when was the transport last read from? used to skip keepalive pings on
+      demonstrably-alive connections */
+  gpr_timespec keepalive_last_read_time;
+
+  /** introspection snapshot: updated with relaxed atomic stores from the
+      combiner, read lock-free by grpc_transport_snapshots_collect() so
+      scraping never touches the data path */
+  struct {
+    gpr_atm is_client;
+    gpr_atm stream_count;
+    gpr_atm outgoing_window;
+    gpr_atm incoming_window;
+    gpr_atm write_state;
+    gpr_atm keepalive_state;
+  } snapshot;
+  /** links in the process-wide transport registry (chttp2_transport.c) */
+  struct grpc_chttp2_transport *snapshot_next;
+  struct grpc_chttp2_transport *snapshot_prev;
+
+  /** blocked-time attribution for the stalled lists (microseconds per
+      stall, recorded by stream_lists.c when a stream leaves the list);
+      striped so grpc_transport_stall_reports_collect() can snapshot
+      concurrently with the combiner recording */
+  gpr_histogram_striped *stalled_by_transport_hist;
+  gpr_histogram_striped *stalled_by_stream_hist;
 };
 
+/** bucketing for the stall blocked-time histograms (values in usec) */
+#define GRPC_CHTTP2_STALL_HISTOGRAM_RESOLUTION 0.05
+#define GRPC_CHTTP2_STALL_HISTOGRAM_MAX_USEC 1e8
+
 typedef enum {
   GRPC_METADATA_NOT_PUBLISHED,
   GRPC_METADATA_SYNTHESIZED_FROM_FAKE,
@@ -440,9 +490,19 @@ struct grpc_chttp2_stream {
   grpc_chttp2_stream_link links[STREAM_LIST_COUNT];
   uint8_t included[STREAM_LIST_COUNT];
 
+  /** when this stream entered each stalled list (monotonic clock); zero
+      when it is not on the list. Feeds the transport's blocked-time
+      histograms on exit. */
+  gpr_timespec stalled_by_transport_since;
+  gpr_timespec stalled_by_stream_since;
+
   /** HTTP2 stream id for this stream, or zero if one has not been assigned */
   uint32_t id;
 
+  /** scheduling class for this stream's writes, adopted from
+      op->payload->send_initial_metadata.write_priority */
+  grpc_stream_write_priority write_priority;
+
   /** window available for us to send to peer, over or under the initial window
    * size of the transport... ie:
    * outgoing_window = outgoing_window_delta + transport.initial_window_size */
@@ -130,6 +130,23 @@ grpc_error *grpc_chttp2_perform_read(grpc_exec_ctx *exec_ctx,
     dts_fh_0:
     case GRPC_DTS_FH_0:
       GPR_ASSERT(cur < end);
+      if ((size_t)(end - cur) >= 9) {
+        /* fast path: the whole frame header is contiguous in this slice, so
+           decode it in one shot instead of walking the per-byte resumable
+           states below. Together with the frame-sized parse in
+           GRPC_DTS_FRAME this turns a read buffer full of small frames into
+           one header decode and one payload append per frame. */
+        t->incoming_frame_size = (((uint32_t)cur[0]) << 16) |
+                                 (((uint32_t)cur[1]) << 8) | ((uint32_t)cur[2]);
+        t->incoming_frame_type = cur[3];
+        t->incoming_frame_flags = cur[4];
+        t->incoming_stream_id = ((((uint32_t)cur[5]) & 0x7f) << 24) |
+                                (((uint32_t)cur[6]) << 16) |
+                                (((uint32_t)cur[7]) << 8) | ((uint32_t)cur[8]);
+        /* leave cur on the last header byte, as the slow path does */
+        cur += 8;
+        goto dts_fh_8;
+      }
       t->incoming_frame_size = ((uint32_t)*cur) << 16;
       if (++cur == end) {
         t->deframe_state = GRPC_DTS_FH_1;
@@ -195,6 +212,7 @@ grpc_error *grpc_chttp2_perform_read(grpc_exec_ctx *exec_ctx,
     case GRPC_DTS_FH_8:
       GPR_ASSERT(cur < end);
       t->incoming_stream_id |= ((uint32_t)*cur);
+    dts_fh_8:
       t->deframe_state = GRPC_DTS_FRAME;
       err = init_frame_parser(exec_ctx, t);
       if (err != GRPC_ERROR_NONE) {
@@ -34,6 +34,7 @@
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 /* core list management */
 
@@ -118,20 +119,77 @@ static bool stream_list_add(grpc_chttp2_transport *t, grpc_chttp2_stream *s,
 
 /* wrappers for specializations */
 
+/* after this many consecutive pops served from one writable class while a
+   lower class also has queued streams, yield one pop to the next non-empty
+   lower class so that bulk streams stay starvation free */
+#define GRPC_CHTTP2_WRITABLE_YIELD_EVERY 8
+
+/* writable class lists, highest priority first */
+static const grpc_chttp2_stream_list_id g_writable_classes[] = {
+    GRPC_CHTTP2_LIST_WRITABLE_HIGH, GRPC_CHTTP2_LIST_WRITABLE,
+    GRPC_CHTTP2_LIST_WRITABLE_BULK};
+
+static grpc_chttp2_stream_list_id writable_list_for_stream(
+    grpc_chttp2_stream *s) {
+  switch (s->write_priority) {
+    case GRPC_STREAM_WRITE_PRIORITY_HIGH:
+      return GRPC_CHTTP2_LIST_WRITABLE_HIGH;
+    case GRPC_STREAM_WRITE_PRIORITY_BULK:
+      return GRPC_CHTTP2_LIST_WRITABLE_BULK;
+    default:
+      return GRPC_CHTTP2_LIST_WRITABLE;
+  }
+}
+
 bool grpc_chttp2_list_add_writable_stream(grpc_chttp2_transport *t,
                                           grpc_chttp2_stream *s) {
   GPR_ASSERT(s->id != 0);
-  return stream_list_add(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  return stream_list_add(t, s, writable_list_for_stream(s));
 }
 
+/* Pop the next writable stream, serving the highest non-empty class except
+   that every GRPC_CHTTP2_WRITABLE_YIELD_EVERY-th pop is handed to the next
+   non-empty lower class. Since grpc_chttp2_begin_write writes at most one
+   data frame per pop before re-queueing a stream at the tail of its class,
+   this bounds the service ratio between classes instead of giving higher
+   classes absolute precedence. */
 bool grpc_chttp2_list_pop_writable_stream(grpc_chttp2_transport *t,
                                           grpc_chttp2_stream **s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  size_t nclasses = sizeof(g_writable_classes) / sizeof(*g_writable_classes);
+  size_t first = nclasses;
+  for (size_t i = 0; i < nclasses; i++) {
+    if (!stream_list_empty(t, g_writable_classes[i])) {
+      first = i;
+      break;
+    }
+  }
+  if (first == nclasses) {
+    *s = NULL;
+    return false;
+  }
+  size_t pick = first;
+  if (t->writable_pops_since_yield >= GRPC_CHTTP2_WRITABLE_YIELD_EVERY) {
+    for (size_t i = first + 1; i < nclasses; i++) {
+      if (!stream_list_empty(t, g_writable_classes[i])) {
+        pick = i;
+        break;
+      }
+    }
+    t->writable_pops_since_yield = 0;
+  } else {
+    t->writable_pops_since_yield++;
+  }
+  return stream_list_pop(t, s, g_writable_classes[pick]);
 }
 
 bool grpc_chttp2_list_remove_writable_stream(grpc_chttp2_transport *t,
                                              grpc_chttp2_stream *s) {
-  return stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  /* a stream sits in at most one class list, but its priority may have
+     changed since it was queued: check all of them */
+  bool removed = stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE_HIGH);
+  removed |= stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE);
+  removed |= stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WRITABLE_BULK);
+  return removed;
 }
 
 bool grpc_chttp2_list_add_writing_stream(grpc_chttp2_transport *t,
@@ -163,32 +221,66 @@ void grpc_chttp2_list_remove_waiting_for_concurrency(grpc_chttp2_transport *t,
   stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_WAITING_FOR_CONCURRENCY);
 }
 
+/* record how long a stream sat on a stalled list: called when it leaves,
+   with \a since holding the entry timestamp (zero if it was never on the
+   list - remove is called unconditionally in places) */
+static void record_stall_time(gpr_histogram_striped *hist,
+                              gpr_timespec *since) {
+  if (since->tv_sec == 0 && since->tv_nsec == 0) return;
+  gpr_timespec blocked = gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), *since);
+  gpr_histogram_striped_add(
+      hist, (double)blocked.tv_sec * 1e6 + (double)blocked.tv_nsec * 1e-3);
+  since->tv_sec = 0;
+  since->tv_nsec = 0;
+}
+
 void grpc_chttp2_list_add_stalled_by_transport(grpc_chttp2_transport *t,
                                                grpc_chttp2_stream *s) {
-  stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  if (stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT)) {
+    s->stalled_by_transport_since = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
 }
 
 bool grpc_chttp2_list_pop_stalled_by_transport(grpc_chttp2_transport *t,
                                                grpc_chttp2_stream **s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  if (!stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT)) {
+    return false;
+  }
+  record_stall_time(t->stalled_by_transport_hist,
+                    &(*s)->stalled_by_transport_since);
+  return true;
 }
 
 void grpc_chttp2_list_remove_stalled_by_transport(grpc_chttp2_transport *t,
                                                   grpc_chttp2_stream *s) {
-  stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT);
+  if (stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_TRANSPORT)) {
+    record_stall_time(t->stalled_by_transport_hist,
+                      &s->stalled_by_transport_since);
+  }
 }
 
 void grpc_chttp2_list_add_stalled_by_stream(grpc_chttp2_transport *t,
                                             grpc_chttp2_stream *s) {
-  stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  if (stream_list_add(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    s->stalled_by_stream_since = gpr_now(GPR_CLOCK_MONOTONIC);
+  }
 }
 
 bool grpc_chttp2_list_pop_stalled_by_stream(grpc_chttp2_transport *t,
                                             grpc_chttp2_stream **s) {
-  return stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  if (!stream_list_pop(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    return false;
+  }
+  record_stall_time(t->stalled_by_stream_hist,
+                    &(*s)->stalled_by_stream_since);
+  return true;
 }
 
 bool grpc_chttp2_list_remove_stalled_by_stream(grpc_chttp2_transport *t,
                                                grpc_chttp2_stream *s) {
-  return stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM);
+  if (stream_list_maybe_remove(t, s, GRPC_CHTTP2_LIST_STALLED_BY_STREAM)) {
+    record_stall_time(t->stalled_by_stream_hist, &s->stalled_by_stream_since);
+    return true;
+  }
+  return false;
 }
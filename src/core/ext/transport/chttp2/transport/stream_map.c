@@ -33,20 +33,41 @@
 
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/useful.h>
 
+static size_t round_up_to_power_of_two(size_t x) {
+  size_t pow2 = 1;
+  while (pow2 < x) pow2 <<= 1;
+  return pow2;
+}
+
+/* multiplicative hash of a stream id into a bucket index */
+static size_t bucket_of(grpc_chttp2_stream_map *map, uint32_t key) {
+  return (size_t)(key * 2654435761u) & (map->capacity - 1);
+}
+
+/* how far \a idx is from the key's home bucket, accounting for wrap-around */
+static size_t probe_distance(grpc_chttp2_stream_map *map, uint32_t key,
+                             size_t idx) {
+  return (idx - bucket_of(map, key)) & (map->capacity - 1);
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map *map,
                                  size_t initial_capacity) {
   GPR_ASSERT(initial_capacity > 1);
-  map->keys = gpr_malloc(sizeof(uint32_t) * initial_capacity);
-  map->values = gpr_malloc(sizeof(void *) * initial_capacity);
+  initial_capacity = round_up_to_power_of_two(initial_capacity);
+  map->keys = gpr_zalloc(sizeof(uint32_t) * initial_capacity);
+  map->values = gpr_zalloc(sizeof(void *) * initial_capacity);
   map->count = 0;
-  map->free = 0;
   map->capacity = initial_capacity;
+  map->max_key = 0;
+  map->last_key = 0;
+  map->last_value = NULL;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map *map) {
@@ -54,123 +75,183 @@ void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map *map) {
   gpr_free(map->values);
 }
 
-static size_t compact(uint32_t *keys, void **values, size_t count) {
-  size_t i, out;
-
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
+/* robin-hood insertion: probe linearly from the home bucket, displacing any
+   resident entry that is closer to its own home bucket than we are to ours */
+static void place(grpc_chttp2_stream_map *map, uint32_t key, void *value) {
+  size_t mask = map->capacity - 1;
+  size_t idx = bucket_of(map, key);
+  size_t dist = 0;
+  while (map->keys[idx] != 0) {
+    size_t resident_dist = probe_distance(map, map->keys[idx], idx);
+    if (resident_dist < dist) {
+      uint32_t tmp_key = map->keys[idx];
+      void *tmp_value = map->values[idx];
+      map->keys[idx] = key;
+      map->values[idx] = value;
+      key = tmp_key;
+      value = tmp_value;
+      dist = resident_dist;
     }
+    idx = (idx + 1) & mask;
+    dist++;
   }
+  map->keys[idx] = key;
+  map->values[idx] = value;
+}
 
-  return out;
+static void grow(grpc_chttp2_stream_map *map) {
+  uint32_t *old_keys = map->keys;
+  void **old_values = map->values;
+  size_t old_capacity = map->capacity;
+  size_t i;
+
+  map->capacity = old_capacity * 2;
+  map->keys = gpr_zalloc(sizeof(uint32_t) * map->capacity);
+  map->values = gpr_zalloc(sizeof(void *) * map->capacity);
+  for (i = 0; i < old_capacity; i++) {
+    if (old_keys[i] != 0) {
+      place(map, old_keys[i], old_values[i]);
+    }
+  }
+  gpr_free(old_keys);
+  gpr_free(old_values);
 }
 
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map *map, uint32_t key,
                                 void *value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t *keys = map->keys;
-  void **values = map->values;
-
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  GPR_ASSERT(key != 0);
+  GPR_ASSERT(key > map->max_key);
   GPR_ASSERT(value);
-  GPR_ASSERT(grpc_chttp2_stream_map_find(map, key) == NULL);
-
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 3 * capacity / 2;
-      map->keys = keys = gpr_realloc(keys, capacity * sizeof(uint32_t));
-      map->values = values = gpr_realloc(values, capacity * sizeof(void *));
-    }
-  }
 
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  /* grow at 3/4 load to keep probe sequences short */
+  if (4 * (map->count + 1) > 3 * map->capacity) {
+    grow(map);
+  }
+  place(map, key, value);
+  map->count++;
+  map->max_key = key;
 }
 
 static void **find(grpc_chttp2_stream_map *map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t *keys = map->keys;
-  void **values = map->values;
-  uint32_t mid_key;
-
-  if (max_idx == 0) return NULL;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
+  size_t mask = map->capacity - 1;
+  size_t idx = bucket_of(map, key);
+  size_t dist = 0;
+
+  if (map->count == 0) return NULL;
+
+  for (;;) {
+    uint32_t resident = map->keys[idx];
+    if (resident == key) {
+      return &map->values[idx];
+    }
+    /* an empty bucket, or a resident closer to home than we are, proves the
+       key is absent: it would have displaced such a resident on insertion */
+    if (resident == 0 || probe_distance(map, resident, idx) < dist) {
+      return NULL;
     }
+    idx = (idx + 1) & mask;
+    dist++;
   }
-
-  return NULL;
 }
 
 void *grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map *map, uint32_t key) {
   void **pvalue = find(map, key);
   void *out = NULL;
   if (pvalue != NULL) {
+    size_t mask = map->capacity - 1;
+    size_t idx = (size_t)(pvalue - map->values);
     out = *pvalue;
-    *pvalue = NULL;
-    map->free += (out != NULL);
-    /* recognize complete emptyness and ensure we can skip
-     * defragmentation later */
-    if (map->free == map->count) {
-      map->free = map->count = 0;
+    /* backward-shift deletion: pull displaced successors one bucket closer to
+       their home buckets, leaving no tombstone behind */
+    for (;;) {
+      size_t next = (idx + 1) & mask;
+      uint32_t resident = map->keys[next];
+      if (resident == 0 || probe_distance(map, resident, next) == 0) {
+        break;
+      }
+      map->keys[idx] = resident;
+      map->values[idx] = map->values[next];
+      idx = next;
+    }
+    map->keys[idx] = 0;
+    map->values[idx] = NULL;
+    map->count--;
+    if (map->last_key == key) {
+      map->last_key = 0;
+      map->last_value = NULL;
     }
-    GPR_ASSERT(grpc_chttp2_stream_map_find(map, key) == NULL);
   }
   return out;
 }
 
 void *grpc_chttp2_stream_map_find(grpc_chttp2_stream_map *map, uint32_t key) {
-  void **pvalue = find(map, key);
-  return pvalue != NULL ? *pvalue : NULL;
+  void **pvalue;
+  if (key != 0 && key == map->last_key) {
+    return map->last_value;
+  }
+  pvalue = find(map, key);
+  if (pvalue == NULL) return NULL;
+  map->last_key = key;
+  map->last_value = *pvalue;
+  return *pvalue;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map *map) {
-  return map->count - map->free;
+  return map->count;
 }
 
 void *grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map *map) {
-  if (map->count == map->free) {
+  size_t i;
+  size_t n;
+  if (map->count == 0) {
     return NULL;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
+  n = ((size_t)rand()) % map->count;
+  for (i = 0; i < map->capacity; i++) {
+    if (map->keys[i] != 0) {
+      if (n == 0) return map->values[i];
+      n--;
+    }
   }
-  return map->values[((size_t)rand()) % map->count];
+  GPR_UNREACHABLE_CODE(return NULL);
+}
+
+typedef struct {
+  uint32_t key;
+  void *value;
+} stream_map_entry;
+
+static int entry_compare(const void *a, const void *b) {
+  uint32_t ka = ((const stream_map_entry *)a)->key;
+  uint32_t kb = ((const stream_map_entry *)b)->key;
+  if (ka < kb) return -1;
+  if (ka > kb) return 1;
+  return 0;
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map *map,
                                      void (*f)(void *user_data, uint32_t key,
                                                void *value),
                                      void *user_data) {
-  size_t i;
+  /* snapshot and sort the entries so that callbacks observe ascending stream
+     ids (as the sorted-array representation used to guarantee), and so that
+     they may safely mutate the map */
+  stream_map_entry *entries;
+  size_t i, n = 0;
 
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  if (map->count == 0) return;
+  entries = gpr_malloc(sizeof(*entries) * map->count);
+  for (i = 0; i < map->capacity; i++) {
+    if (map->keys[i] != 0) {
+      entries[n].key = map->keys[i];
+      entries[n].value = map->values[i];
+      n++;
     }
   }
+  GPR_ASSERT(n == map->count);
+  qsort(entries, n, sizeof(*entries), entry_compare);
+  for (i = 0; i < n; i++) {
+    f(user_data, entries[i].key, entries[i].value);
+  }
+  gpr_free(entries);
 }
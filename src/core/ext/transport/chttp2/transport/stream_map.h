@@ -40,16 +40,26 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
+   Represented as a robin-hood open-addressing hash table keyed by stream id.
+   Stream id 0 is reserved by http2 for the connection, so a zero key marks an
+   empty bucket and deletion needs no tombstones (entries displaced past a
+   deleted bucket are shifted backwards instead).
    Adds are restricted to strictly higher keys than previously seen (this is
    guaranteed by http2). */
 typedef struct {
+  /* bucket keys; 0 means the bucket is empty */
   uint32_t *keys;
+  /* bucket values; parallel to keys */
   void **values;
+  /* number of populated buckets */
   size_t count;
-  size_t free;
+  /* total bucket count: always a power of two */
   size_t capacity;
+  /* highest key added so far */
+  uint32_t max_key;
+  /* single-entry cache of the last successful lookup; 0 if invalid */
+  uint32_t last_key;
+  void *last_value;
 } grpc_chttp2_stream_map;
 
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map *map,
@@ -34,6 +34,7 @@
 #include "src/core/ext/transport/chttp2/transport/internal.h"
 
 #include <limits.h>
+#include <string.h>
 
 #include <grpc/support/log.h>
 
@@ -41,6 +42,13 @@
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/transport/http2_errors.h"
 
+/* Slices below this size are copied into a contiguous assembly slice when the
+   write buffer is finalized; larger slices pass through untouched so big
+   payloads are never copied. */
+#define MAX_COALESCE_SLICE_SIZE 1024
+/* Target size of each assembled contiguous slice. */
+#define COALESCED_SLICE_SIZE 4096
+
 static void add_to_write_list(grpc_chttp2_write_cb **list,
                               grpc_chttp2_write_cb *cb) {
   cb->next = *list;
@@ -174,9 +182,87 @@ uint32_t grpc_chttp2_target_incoming_window(grpc_chttp2_transport *t) {
 
 /* How many bytes would we like to put on the wire during a single syscall */
 static uint32_t target_write_size(grpc_chttp2_transport *t) {
+  /* adapt the per-write target to the measured bandwidth: aim for roughly
+     10ms of data per write, so slow connections don't pile up a kernel
+     backlog that adds head-of-line latency for interleaved streams while
+     fast pipes still get big, syscall-efficient writes. Until the bdp
+     estimator has a bandwidth sample, fall back to the old fixed 1MB. */
+  double bw = -1;
+  if (t->enable_bdp_probe &&
+      grpc_bdp_estimator_get_bw(&t->bdp_estimator, &bw) && bw > 0) {
+    uint32_t target =
+        (uint32_t)GPR_CLAMP(bw / 100.0, 32.0 * 1024, 1024.0 * 1024);
+    if (GRPC_TRACER_ON(grpc_bdp_estimator_trace)) {
+      gpr_log(GPR_DEBUG, "%s: target_write_size %u (bw %.0f bytes/s)",
+              t->peer_string, target, bw);
+    }
+    return target;
+  }
   return 1024 * 1024;
 }
 
+/* Rewrite \a buf so that runs of small slices (frame headers, small data
+   frames, window updates, ...) are copied into contiguous assembly slices,
+   shortening the iovec chain the endpoint has to walk. Slices of at least
+   MAX_COALESCE_SLICE_SIZE keep their identity and are never copied. */
+static void coalesce_outbuf(grpc_exec_ctx *exec_ctx, grpc_slice_buffer *buf) {
+  /* only worth doing if some pair of adjacent slices would merge */
+  bool any_to_merge = false;
+  bool prev_small = false;
+  for (size_t i = 0; i < buf->count; i++) {
+    bool small = GRPC_SLICE_LENGTH(buf->slices[i]) < MAX_COALESCE_SLICE_SIZE;
+    if (small && prev_small) {
+      any_to_merge = true;
+      break;
+    }
+    prev_small = small;
+  }
+  if (!any_to_merge) return;
+
+  grpc_slice_buffer assembled;
+  grpc_slice_buffer_init(&assembled);
+  grpc_slice assembly = grpc_empty_slice();
+  size_t assembly_length = 0;
+  for (size_t i = 0; i < buf->count; i++) {
+    grpc_slice slice = buf->slices[i];
+    size_t slice_length = GRPC_SLICE_LENGTH(slice);
+    if (slice_length >= MAX_COALESCE_SLICE_SIZE) {
+      /* pass large slices through, flushing any partial assembly first to
+         preserve byte order */
+      if (assembly_length > 0) {
+        GRPC_SLICE_SET_LENGTH(assembly, assembly_length);
+        grpc_slice_buffer_add(&assembled, assembly);
+        assembly_length = 0;
+      }
+      grpc_slice_buffer_add(&assembled, slice);
+    } else {
+      if (assembly_length + slice_length > COALESCED_SLICE_SIZE) {
+        GRPC_SLICE_SET_LENGTH(assembly, assembly_length);
+        grpc_slice_buffer_add(&assembled, assembly);
+        assembly_length = 0;
+      }
+      if (assembly_length == 0) {
+        assembly = grpc_slice_malloc_internal(exec_ctx, COALESCED_SLICE_SIZE);
+      }
+      memcpy(GRPC_SLICE_START_PTR(assembly) + assembly_length,
+             GRPC_SLICE_START_PTR(slice), slice_length);
+      assembly_length += slice_length;
+      grpc_slice_unref_internal(exec_ctx, slice);
+    }
+  }
+  if (assembly_length > 0) {
+    GRPC_SLICE_SET_LENGTH(assembly, assembly_length);
+    grpc_slice_buffer_add(&assembled, assembly);
+  }
+
+  /* ownership of every original slice has been transferred or dropped above:
+     empty \a buf without unreffing and move the assembled slices back in */
+  buf->count = 0;
+  buf->length = 0;
+  grpc_slice_buffer_move_into(&assembled, buf);
+  grpc_slice_buffer_destroy_internal(exec_ctx, &assembled);
+}
+
 grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
     grpc_exec_ctx *exec_ctx, grpc_chttp2_transport *t) {
   grpc_chttp2_stream *s;
@@ -236,21 +322,41 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
 
     /* send initial metadata if it's available */
     if (!sent_initial_metadata && s->send_initial_metadata) {
+      /* on the server, a response that carries no message and already has
+         its trailers queued (a rejection, typically) collapses into a
+         single trailers-only HEADERS frame with END_STREAM */
+      grpc_metadata_batch *trailers_only =
+          (!t->is_client && s->send_trailing_metadata != NULL &&
+           !grpc_metadata_batch_is_empty(s->send_trailing_metadata) &&
+           s->fetching_send_message == NULL &&
+           s->flow_controlled_buffer.length == 0)
+              ? s->send_trailing_metadata
+              : NULL;
       grpc_encode_header_options hopt = {
           .stream_id = s->id,
-          .is_eof = false,
+          .is_eof = trailers_only != NULL,
           .use_true_binary_metadata =
               t->settings
                   [GRPC_PEER_SETTINGS]
                   [GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_TRUE_BINARY_METADATA] != 0,
           .max_frame_size = t->settings[GRPC_PEER_SETTINGS]
                                        [GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE],
-          .stats = &s->stats.outgoing};
+          .stats = &s->stats.outgoing,
+          .extra_metadata = trailers_only};
       grpc_chttp2_encode_header(exec_ctx, &t->hpack_compressor,
                                 s->send_initial_metadata, &hopt, &t->outbuf);
       s->send_initial_metadata = NULL;
       s->sent_initial_metadata = true;
       sent_initial_metadata = true;
+      if (trailers_only != NULL) {
+        s->send_trailing_metadata = NULL;
+        s->sent_trailing_metadata = true;
+        if (!s->read_closed) {
+          grpc_slice_buffer_add(
+              &t->outbuf, grpc_chttp2_rst_stream_create(
+                              s->id, GRPC_HTTP2_NO_ERROR, &s->stats.outgoing));
+        }
+      }
       now_writing = true;
       t->ping_state.pings_before_data_required =
           t->ping_policy.max_pings_without_data;
@@ -260,8 +366,20 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
         t->ping_recv_state.ping_strikes = 0;
       }
     }
-    /* send any window updates */
-    if (s->announce_window > 0) {
+    /* send any window updates: tiny updates are held back while the peer
+       still has more than half its window left, so that credit accumulates
+       into fewer, larger WINDOW_UPDATE frames. parsing initiates a write as
+       soon as the peer's view of the window drops to half, so deferred
+       credit always gets flushed before the peer can stall. */
+    uint32_t stream_initial_window =
+        t->settings[GRPC_SENT_SETTINGS]
+                   [GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE];
+    bool peer_window_is_ample =
+        (int64_t)s->incoming_window_delta - (int64_t)s->announce_window >
+        -(int64_t)stream_initial_window / 2;
+    if (s->announce_window > 0 &&
+        (!peer_window_is_ample ||
+         s->announce_window >= stream_initial_window / 8)) {
       uint32_t announce = s->announce_window;
       grpc_slice_buffer_add(&t->outbuf,
                             grpc_chttp2_window_update_create(
@@ -380,10 +498,19 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
   /* if the grpc_chttp2_transport is ready to send a window update, do so here
      also; 3/4 is a magic number that will likely get tuned soon */
   uint32_t target_incoming_window = grpc_chttp2_target_incoming_window(t);
+  bool writing_data = t->outbuf.count > 0;
   uint32_t threshold_to_send_transport_window_update =
-      t->outbuf.count > 0 ? 3 * target_incoming_window / 4
-                          : target_incoming_window / 2;
-  if (t->incoming_window <= threshold_to_send_transport_window_update &&
+      writing_data ? 3 * target_incoming_window / 4
+                   : target_incoming_window / 2;
+  /* when a write is going out anyway, top the window up opportunistically
+     once at least a frame's worth of credit has accumulated: a piggybacked
+     WINDOW_UPDATE is nearly free and staves off a later write dedicated to
+     flow control */
+  bool piggyback_window_update =
+      writing_data &&
+      (int64_t)target_incoming_window - t->incoming_window >= 4096;
+  if ((t->incoming_window <= threshold_to_send_transport_window_update ||
+       piggyback_window_update) &&
       t->incoming_window != target_incoming_window) {
     maybe_initiate_ping(exec_ctx, t,
                         GRPC_CHTTP2_PING_BEFORE_TRANSPORT_WINDOW_UPDATE);
@@ -410,6 +537,10 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
 
   maybe_initiate_ping(exec_ctx, t, GRPC_CHTTP2_PING_ON_NEXT_WRITE);
 
+  if (t->outbuf.count > 0) {
+    coalesce_outbuf(exec_ctx, &t->outbuf);
+  }
+
   GPR_TIMER_END("grpc_chttp2_begin_write", 0);
 
   return t->outbuf.count > 0 ? (partial_write ? GRPC_CHTTP2_PARTIAL_WRITE
@@ -0,0 +1,739 @@
+/*
+ *
+ * Copyright 2017, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/api_trace.h"
+#include "src/core/lib/surface/channel.h"
+#include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/connectivity_state.h"
+#include "src/core/lib/transport/transport_impl.h"
+
+/*******************************************************************************
+ * In-process transport
+ *
+ * Connects a client channel stack directly to a server in the same process:
+ * metadata batches and message slices move between the two call stacks under
+ * a shared mutex with slice/mdelem refs only - no framing, no hpack, no fds.
+ * Both sides of a pair share one mutex, so every stream operation is a plain
+ * state-machine step; completions are always signalled through scheduled
+ * closures, never inline, which keeps the lock non-reentrant.
+ */
+
+typedef struct inproc_shared {
+  gpr_mu mu;
+  gpr_refcount refs;
+} inproc_shared;
+
+typedef struct inproc_transport {
+  grpc_transport base;
+  inproc_shared *shared;
+  gpr_refcount refs;
+  bool is_client;
+  bool shutdown;
+  grpc_connectivity_state_tracker connectivity;
+  void (*accept_stream_cb)(grpc_exec_ctx *exec_ctx, void *user_data,
+                           grpc_transport *transport, const void *server_data);
+  void *accept_stream_data;
+  struct inproc_transport *other;
+  struct inproc_stream *stream_list;
+} inproc_transport;
+
+/* a message in flight between the two sides; slices carry refs only */
+typedef struct inproc_msg {
+  grpc_slice_buffer data;
+  uint32_t flags;
+  struct inproc_msg *next;
+} inproc_msg;
+
+typedef struct inproc_stream {
+  inproc_transport *t;
+  gpr_arena *arena;
+  struct inproc_stream *other; /* NULL until both sides are linked */
+  bool other_closed;           /* the peer stream has been destroyed */
+
+  /* inbox: what the peer has sent us, awaiting a matching recv op */
+  grpc_metadata_batch inbox_initial_md;
+  uint32_t inbox_initial_md_flags;
+  bool inbox_initial_md_filled;
+  inproc_msg *inbox_msgs_head;
+  inproc_msg *inbox_msgs_tail;
+  grpc_metadata_batch inbox_trailing_md;
+  bool inbox_trailing_md_filled;
+
+  /* write buffer: sends issued before the server side stream exists; moved
+     into the peer's inbox when the sides are linked in init_stream */
+  grpc_metadata_batch wb_initial_md;
+  uint32_t wb_initial_md_flags;
+  bool wb_initial_md_filled;
+  inproc_msg *wb_msgs_head;
+  inproc_msg *wb_msgs_tail;
+  grpc_metadata_batch wb_trailing_md;
+  bool wb_trailing_md_filled;
+  grpc_error *wb_cancel_error;
+
+  /* recv ops parked until matching inbox entries arrive */
+  grpc_transport_stream_op_batch *recv_initial_md_op;
+  grpc_transport_stream_op_batch *recv_message_op;
+  grpc_transport_stream_op_batch *recv_trailing_md_op;
+
+  /* backing storage for the byte stream handed to a completed recv_message;
+     reused for each delivered message */
+  grpc_slice_buffer recv_message_buffer;
+  grpc_slice_buffer_stream recv_stream;
+
+  bool initial_md_recvd;
+  bool trailing_md_recvd;
+  bool trailing_md_sent;
+
+  /* once set the stream is dead: all pending and future ops fail with it */
+  grpc_error *cancel_error;
+
+  bool listed;
+  struct inproc_stream *list_next;
+  struct inproc_stream *list_prev;
+} inproc_stream;
+
+static void inproc_transport_ref(inproc_transport *t) { gpr_ref(&t->refs); }
+
+static void inproc_transport_unref(grpc_exec_ctx *exec_ctx,
+                                   inproc_transport *t) {
+  if (!gpr_unref(&t->refs)) return;
+  grpc_connectivity_state_destroy(exec_ctx, &t->connectivity);
+  if (gpr_unref(&t->shared->refs)) {
+    gpr_mu_destroy(&t->shared->mu);
+    gpr_free(t->shared);
+  }
+  gpr_free(t);
+}
+
+/* Copy a metadata batch elementwise, allocating linked list storage from the
+   receiving stream's arena and taking mdelem refs */
+static grpc_error *inproc_fill_md_locked(grpc_exec_ctx *exec_ctx,
+                                         grpc_metadata_batch *src,
+                                         grpc_metadata_batch *dest,
+                                         gpr_arena *arena) {
+  grpc_error *error = GRPC_ERROR_NONE;
+  for (grpc_linked_mdelem *elem = src->list.head;
+       elem != NULL && error == GRPC_ERROR_NONE; elem = elem->next) {
+    grpc_linked_mdelem *nelem =
+        (grpc_linked_mdelem *)gpr_arena_alloc(arena, sizeof(*nelem));
+    error = grpc_metadata_batch_add_tail(exec_ctx, dest, nelem,
+                                         GRPC_MDELEM_REF(elem->md));
+  }
+  dest->deadline = src->deadline;
+  return error;
+}
+
+static inproc_msg *inproc_msg_from_byte_stream(grpc_exec_ctx *exec_ctx,
+                                               grpc_byte_stream *bs,
+                                               grpc_error **error) {
+  inproc_msg *msg = (inproc_msg *)gpr_malloc(sizeof(*msg));
+  grpc_slice_buffer_init(&msg->data);
+  msg->flags = bs->flags;
+  msg->next = NULL;
+  *error = GRPC_ERROR_NONE;
+  while (msg->data.length < bs->length) {
+    grpc_slice slice;
+    /* in-process senders hand us slice buffer streams, which always have
+       their bytes available immediately */
+    GPR_ASSERT(grpc_byte_stream_next(exec_ctx, bs, ~(size_t)0, NULL));
+    *error = grpc_byte_stream_pull(exec_ctx, bs, &slice);
+    if (*error != GRPC_ERROR_NONE) break;
+    grpc_slice_buffer_add(&msg->data, slice);
+  }
+  grpc_byte_stream_destroy(exec_ctx, bs);
+  return msg;
+}
+
+static void inproc_msg_list_free(grpc_exec_ctx *exec_ctx, inproc_msg *head) {
+  while (head != NULL) {
+    inproc_msg *next = head->next;
+    grpc_slice_buffer_destroy_internal(exec_ctx, &head->data);
+    gpr_free(head);
+    head = next;
+  }
+}
+
+/* Schedule op->on_complete iff the slot being completed right now is the last
+   recv op of its batch still pending on this stream. Must be called before
+   the completing slot is cleared. */
+static void inproc_complete_if_batch_end_locked(
+    grpc_exec_ctx *exec_ctx, inproc_stream *s, grpc_error *error,
+    grpc_transport_stream_op_batch *op) {
+  int pending = (op == s->recv_initial_md_op) + (op == s->recv_message_op) +
+                (op == s->recv_trailing_md_op);
+  if (pending == 1 && op->on_complete != NULL) {
+    grpc_closure_sched(exec_ctx, op->on_complete, GRPC_ERROR_REF(error));
+  }
+}
+
+/* Match parked recv ops against the inbox (or against stream failure).
+   Called with the pair mutex held whenever either could have changed. */
+static void inproc_maybe_deliver_locked(grpc_exec_ctx *exec_ctx,
+                                        inproc_stream *s) {
+  grpc_transport_stream_op_batch *op;
+
+  if (s->cancel_error != GRPC_ERROR_NONE) {
+    grpc_error *err = s->cancel_error;
+    if ((op = s->recv_initial_md_op) != NULL) {
+      grpc_closure_sched(
+          exec_ctx,
+          op->payload->recv_initial_metadata.recv_initial_metadata_ready,
+          GRPC_ERROR_REF(err));
+      inproc_complete_if_batch_end_locked(exec_ctx, s, err, op);
+      s->recv_initial_md_op = NULL;
+    }
+    if ((op = s->recv_message_op) != NULL) {
+      *op->payload->recv_message.recv_message = NULL;
+      grpc_closure_sched(exec_ctx, op->payload->recv_message.recv_message_ready,
+                         GRPC_ERROR_REF(err));
+      inproc_complete_if_batch_end_locked(exec_ctx, s, err, op);
+      s->recv_message_op = NULL;
+    }
+    if ((op = s->recv_trailing_md_op) != NULL) {
+      inproc_complete_if_batch_end_locked(exec_ctx, s, err, op);
+      s->recv_trailing_md_op = NULL;
+    }
+    return;
+  }
+
+  if ((op = s->recv_initial_md_op) != NULL && s->inbox_initial_md_filled) {
+    grpc_error *err = inproc_fill_md_locked(
+        exec_ctx, &s->inbox_initial_md,
+        op->payload->recv_initial_metadata.recv_initial_metadata, s->arena);
+    if (op->payload->recv_initial_metadata.recv_flags != NULL) {
+      *op->payload->recv_initial_metadata.recv_flags =
+          s->inbox_initial_md_flags;
+    }
+    grpc_metadata_batch_destroy(exec_ctx, &s->inbox_initial_md);
+    grpc_metadata_batch_init(&s->inbox_initial_md);
+    s->inbox_initial_md_filled = false;
+    s->initial_md_recvd = true;
+    grpc_closure_sched(
+        exec_ctx,
+        op->payload->recv_initial_metadata.recv_initial_metadata_ready,
+        GRPC_ERROR_REF(err));
+    inproc_complete_if_batch_end_locked(exec_ctx, s, err, op);
+    s->recv_initial_md_op = NULL;
+    GRPC_ERROR_UNREF(err);
+  }
+
+  if ((op = s->recv_message_op) != NULL) {
+    if (s->inbox_msgs_head != NULL) {
+      inproc_msg *msg = s->inbox_msgs_head;
+      s->inbox_msgs_head = msg->next;
+      if (s->inbox_msgs_head == NULL) s->inbox_msgs_tail = NULL;
+      grpc_slice_buffer_reset_and_unref_internal(exec_ctx,
+                                                 &s->recv_message_buffer);
+      grpc_slice_buffer_swap(&msg->data, &s->recv_message_buffer);
+      grpc_slice_buffer_stream_init(&s->recv_stream, &s->recv_message_buffer,
+                                    msg->flags);
+      grpc_slice_buffer_destroy_internal(exec_ctx, &msg->data);
+      gpr_free(msg);
+      *op->payload->recv_message.recv_message = &s->recv_stream.base;
+      grpc_closure_sched(exec_ctx, op->payload->recv_message.recv_message_ready,
+                         GRPC_ERROR_NONE);
+      inproc_complete_if_batch_end_locked(exec_ctx, s, GRPC_ERROR_NONE, op);
+      s->recv_message_op = NULL;
+    } else if (s->inbox_trailing_md_filled || s->trailing_md_recvd ||
+               s->other_closed) {
+      /* no further messages can arrive: signal end of stream */
+      *op->payload->recv_message.recv_message = NULL;
+      grpc_closure_sched(exec_ctx, op->payload->recv_message.recv_message_ready,
+                         GRPC_ERROR_NONE);
+      inproc_complete_if_batch_end_locked(exec_ctx, s, GRPC_ERROR_NONE, op);
+      s->recv_message_op = NULL;
+    }
+  }
+
+  if ((op = s->recv_trailing_md_op) != NULL && s->inbox_trailing_md_filled &&
+      s->inbox_msgs_head == NULL && s->recv_message_op == NULL) {
+    if (s->recv_initial_md_op != NULL && !s->inbox_initial_md_filled) {
+      /* trailers-only response: no initial metadata is coming, deliver the
+         pending recv empty so the batch can finish */
+      grpc_transport_stream_op_batch *imop = s->recv_initial_md_op;
+      if (imop->payload->recv_initial_metadata.recv_flags != NULL) {
+        *imop->payload->recv_initial_metadata.recv_flags = 0;
+      }
+      s->initial_md_recvd = true;
+      grpc_closure_sched(
+          exec_ctx,
+          imop->payload->recv_initial_metadata.recv_initial_metadata_ready,
+          GRPC_ERROR_NONE);
+      inproc_complete_if_batch_end_locked(exec_ctx, s, GRPC_ERROR_NONE, imop);
+      s->recv_initial_md_op = NULL;
+    }
+    grpc_error *err = inproc_fill_md_locked(
+        exec_ctx, &s->inbox_trailing_md,
+        op->payload->recv_trailing_metadata.recv_trailing_metadata, s->arena);
+    grpc_metadata_batch_destroy(exec_ctx, &s->inbox_trailing_md);
+    grpc_metadata_batch_init(&s->inbox_trailing_md);
+    s->inbox_trailing_md_filled = false;
+    s->trailing_md_recvd = true;
+    inproc_complete_if_batch_end_locked(exec_ctx, s, err, op);
+    s->recv_trailing_md_op = NULL;
+    GRPC_ERROR_UNREF(err);
+  }
+}
+
+/* Takes ownership of error. Fails this side's pending ops and propagates the
+   failure to the peer, mirroring an RST_STREAM. */
+static void inproc_cancel_stream_locked(grpc_exec_ctx *exec_ctx,
+                                        inproc_stream *s, grpc_error *error) {
+  if (s->cancel_error != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  s->cancel_error = error;
+  inproc_maybe_deliver_locked(exec_ctx, s);
+  if (s->other != NULL) {
+    if (s->other->cancel_error == GRPC_ERROR_NONE) {
+      s->other->cancel_error = GRPC_ERROR_REF(error);
+      inproc_maybe_deliver_locked(exec_ctx, s->other);
+    }
+  } else if (!s->other_closed) {
+    s->wb_cancel_error = GRPC_ERROR_REF(error);
+  }
+}
+
+static int inproc_init_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
+                              grpc_stream *gs, grpc_stream_refcount *refcount,
+                              const void *server_data, gpr_arena *arena) {
+  inproc_transport *t = (inproc_transport *)gt;
+  inproc_stream *s = (inproc_stream *)gs;
+  memset(s, 0, sizeof(*s));
+  s->t = t;
+  s->arena = arena;
+  s->cancel_error = GRPC_ERROR_NONE;
+  s->wb_cancel_error = GRPC_ERROR_NONE;
+  grpc_metadata_batch_init(&s->inbox_initial_md);
+  grpc_metadata_batch_init(&s->inbox_trailing_md);
+  grpc_metadata_batch_init(&s->wb_initial_md);
+  grpc_metadata_batch_init(&s->wb_trailing_md);
+  grpc_slice_buffer_init(&s->recv_message_buffer);
+  inproc_transport_ref(t);
+
+  gpr_mu_lock(&t->shared->mu);
+  s->list_next = t->stream_list;
+  if (t->stream_list != NULL) t->stream_list->list_prev = s;
+  t->stream_list = s;
+  s->listed = true;
+
+  if (server_data != NULL) {
+    /* server side: link up with the initiating client stream and absorb
+       anything it wrote before we existed */
+    inproc_stream *cs = (inproc_stream *)server_data;
+    s->other = cs;
+    cs->other = s;
+    if (cs->wb_initial_md_filled) {
+      GRPC_LOG_IF_ERROR("inproc_link_initial_md",
+                        inproc_fill_md_locked(exec_ctx, &cs->wb_initial_md,
+                                              &s->inbox_initial_md, s->arena));
+      grpc_metadata_batch_destroy(exec_ctx, &cs->wb_initial_md);
+      grpc_metadata_batch_init(&cs->wb_initial_md);
+      s->inbox_initial_md_flags = cs->wb_initial_md_flags;
+      s->inbox_initial_md_filled = true;
+      cs->wb_initial_md_filled = false;
+    }
+    s->inbox_msgs_head = cs->wb_msgs_head;
+    s->inbox_msgs_tail = cs->wb_msgs_tail;
+    cs->wb_msgs_head = cs->wb_msgs_tail = NULL;
+    if (cs->wb_trailing_md_filled) {
+      GRPC_LOG_IF_ERROR("inproc_link_trailing_md",
+                        inproc_fill_md_locked(exec_ctx, &cs->wb_trailing_md,
+                                              &s->inbox_trailing_md, s->arena));
+      grpc_metadata_batch_destroy(exec_ctx, &cs->wb_trailing_md);
+      grpc_metadata_batch_init(&cs->wb_trailing_md);
+      s->inbox_trailing_md_filled = true;
+      cs->wb_trailing_md_filled = false;
+    }
+    if (cs->wb_cancel_error != GRPC_ERROR_NONE) {
+      s->cancel_error = cs->wb_cancel_error;
+      cs->wb_cancel_error = GRPC_ERROR_NONE;
+    }
+    gpr_mu_unlock(&t->shared->mu);
+  } else {
+    /* client side: hand the new stream to the server transport so it can
+       construct its half. The accept callback re-enters this transport via
+       init_stream, so it must run unlocked; ref the server transport across
+       the call. */
+    inproc_transport *st = t->other;
+    bool accepting = !t->shutdown && st != NULL && !st->shutdown &&
+                     st->accept_stream_cb != NULL;
+    if (accepting) inproc_transport_ref(st);
+    gpr_mu_unlock(&t->shared->mu);
+    if (accepting) {
+      (*st->accept_stream_cb)(exec_ctx, st->accept_stream_data, &st->base,
+                              (const void *)s);
+      inproc_transport_unref(exec_ctx, st);
+    } else {
+      gpr_mu_lock(&t->shared->mu);
+      inproc_cancel_stream_locked(
+          exec_ctx, s,
+          grpc_error_set_int(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING("inproc server shut down"),
+              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+      gpr_mu_unlock(&t->shared->mu);
+    }
+  }
+  return 0;
+}
+
+static void inproc_set_pollset(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
+                               grpc_stream *gs, grpc_pollset *pollset) {
+  /* nothing to poll */
+}
+
+static void inproc_set_pollset_set(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
+                                   grpc_stream *gs,
+                                   grpc_pollset_set *pollset_set) {
+  /* nothing to poll */
+}
+
+static void inproc_perform_stream_op(grpc_exec_ctx *exec_ctx,
+                                     grpc_transport *gt, grpc_stream *gs,
+                                     grpc_transport_stream_op_batch *op) {
+  inproc_stream *s = (inproc_stream *)gs;
+  gpr_mu *mu = &s->t->shared->mu;
+  grpc_error *error = GRPC_ERROR_NONE;
+
+  gpr_mu_lock(mu);
+
+  if (op->cancel_stream) {
+    inproc_cancel_stream_locked(
+        exec_ctx, s, GRPC_ERROR_REF(op->payload->cancel_stream.cancel_error));
+    if (op->on_complete != NULL) {
+      grpc_closure_sched(exec_ctx, op->on_complete, GRPC_ERROR_NONE);
+    }
+    gpr_mu_unlock(mu);
+    return;
+  }
+
+  if (s->cancel_error != GRPC_ERROR_NONE) {
+    error = GRPC_ERROR_REF(s->cancel_error);
+  }
+
+  if (error == GRPC_ERROR_NONE &&
+      (op->send_initial_metadata || op->send_message ||
+       op->send_trailing_metadata)) {
+    if (s->other_closed) {
+      error = grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("inproc peer stream closed"),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    } else {
+      /* destination: the peer's inbox, or our write buffer until linked */
+      inproc_stream *other = s->other;
+      if (op->send_initial_metadata) {
+        error = inproc_fill_md_locked(
+            exec_ctx, op->payload->send_initial_metadata.send_initial_metadata,
+            other != NULL ? &other->inbox_initial_md : &s->wb_initial_md,
+            other != NULL ? other->arena : s->arena);
+        uint32_t flags =
+            op->payload->send_initial_metadata.send_initial_metadata_flags;
+        if (other != NULL) {
+          other->inbox_initial_md_flags = flags;
+          other->inbox_initial_md_filled = true;
+        } else {
+          s->wb_initial_md_flags = flags;
+          s->wb_initial_md_filled = true;
+        }
+      }
+      if (error == GRPC_ERROR_NONE && op->send_message) {
+        inproc_msg *msg = inproc_msg_from_byte_stream(
+            exec_ctx, op->payload->send_message.send_message, &error);
+        inproc_msg **tail =
+            other != NULL ? &other->inbox_msgs_tail : &s->wb_msgs_tail;
+        inproc_msg **head =
+            other != NULL ? &other->inbox_msgs_head : &s->wb_msgs_head;
+        if (*tail != NULL) {
+          (*tail)->next = msg;
+        } else {
+          *head = msg;
+        }
+        *tail = msg;
+      }
+      if (error == GRPC_ERROR_NONE && op->send_trailing_metadata) {
+        error = inproc_fill_md_locked(
+            exec_ctx,
+            op->payload->send_trailing_metadata.send_trailing_metadata,
+            other != NULL ? &other->inbox_trailing_md : &s->wb_trailing_md,
+            other != NULL ? other->arena : s->arena);
+        if (other != NULL) {
+          other->inbox_trailing_md_filled = true;
+        } else {
+          s->wb_trailing_md_filled = true;
+        }
+        s->trailing_md_sent = true;
+      }
+      if (error != GRPC_ERROR_NONE) {
+        inproc_cancel_stream_locked(exec_ctx, s, GRPC_ERROR_REF(error));
+      } else if (other != NULL) {
+        inproc_maybe_deliver_locked(exec_ctx, other);
+      }
+    }
+  }
+
+  bool has_recv = op->recv_initial_metadata || op->recv_message ||
+                  op->recv_trailing_metadata;
+
+  if (error != GRPC_ERROR_NONE) {
+    /* fail the whole batch */
+    if (op->recv_initial_metadata) {
+      grpc_closure_sched(
+          exec_ctx,
+          op->payload->recv_initial_metadata.recv_initial_metadata_ready,
+          GRPC_ERROR_REF(error));
+    }
+    if (op->recv_message) {
+      *op->payload->recv_message.recv_message = NULL;
+      grpc_closure_sched(exec_ctx, op->payload->recv_message.recv_message_ready,
+                         GRPC_ERROR_REF(error));
+    }
+    if (op->on_complete != NULL) {
+      grpc_closure_sched(exec_ctx, op->on_complete, GRPC_ERROR_REF(error));
+    }
+    GRPC_ERROR_UNREF(error);
+    gpr_mu_unlock(mu);
+    return;
+  }
+
+  if (has_recv) {
+    if (op->recv_initial_metadata) {
+      GPR_ASSERT(s->recv_initial_md_op == NULL);
+      s->recv_initial_md_op = op;
+    }
+    if (op->recv_message) {
+      GPR_ASSERT(s->recv_message_op == NULL);
+      s->recv_message_op = op;
+    }
+    if (op->recv_trailing_metadata) {
+      GPR_ASSERT(s->recv_trailing_md_op == NULL);
+      s->recv_trailing_md_op = op;
+    }
+    /* on_complete fires from the delivery path once all recvs are done */
+    inproc_maybe_deliver_locked(exec_ctx, s);
+  } else if (op->on_complete != NULL) {
+    grpc_closure_sched(exec_ctx, op->on_complete, GRPC_ERROR_NONE);
+  }
+
+  gpr_mu_unlock(mu);
+}
+
+/* Takes ownership of error */
+static void inproc_close_transport_locked(grpc_exec_ctx *exec_ctx,
+                                          inproc_transport *t,
+                                          grpc_error *error) {
+  if (!t->shutdown) {
+    t->shutdown = true;
+    grpc_connectivity_state_set(exec_ctx, &t->connectivity,
+                                GRPC_CHANNEL_SHUTDOWN, GRPC_ERROR_REF(error),
+                                "inproc_close");
+  }
+  if (t->other != NULL && !t->other->shutdown) {
+    t->other->shutdown = true;
+    grpc_connectivity_state_set(exec_ctx, &t->other->connectivity,
+                                GRPC_CHANNEL_SHUTDOWN, GRPC_ERROR_REF(error),
+                                "inproc_peer_closed");
+  }
+  for (inproc_stream *s = t->stream_list; s != NULL; s = s->list_next) {
+    inproc_cancel_stream_locked(exec_ctx, s, GRPC_ERROR_REF(error));
+  }
+  GRPC_ERROR_UNREF(error);
+}
+
+static void inproc_perform_op(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
+                              grpc_transport_op *op) {
+  inproc_transport *t = (inproc_transport *)gt;
+  gpr_mu_lock(&t->shared->mu);
+  if (op->on_connectivity_state_change != NULL) {
+    grpc_connectivity_state_notify_on_state_change(
+        exec_ctx, &t->connectivity, op->connectivity_state,
+        op->on_connectivity_state_change);
+  }
+  if (op->set_accept_stream) {
+    t->accept_stream_cb = op->set_accept_stream_fn;
+    t->accept_stream_data = op->set_accept_stream_user_data;
+  }
+  if (op->send_ping != NULL) {
+    /* there is no wire to probe: a ping succeeds trivially */
+    grpc_closure_sched(exec_ctx, op->send_ping, GRPC_ERROR_NONE);
+  }
+  if (op->goaway_error != GRPC_ERROR_NONE ||
+      op->disconnect_with_error != GRPC_ERROR_NONE) {
+    grpc_error *err;
+    if (op->disconnect_with_error != GRPC_ERROR_NONE) {
+      err = op->disconnect_with_error;
+      GRPC_ERROR_UNREF(op->goaway_error);
+    } else {
+      err = op->goaway_error;
+    }
+    inproc_close_transport_locked(exec_ctx, t, err);
+  }
+  gpr_mu_unlock(&t->shared->mu);
+  if (op->on_consumed != NULL) {
+    grpc_closure_sched(exec_ctx, op->on_consumed, GRPC_ERROR_NONE);
+  }
+}
+
+static void inproc_destroy_stream(grpc_exec_ctx *exec_ctx, grpc_transport *gt,
+                                  grpc_stream *gs,
+                                  grpc_closure *then_schedule_closure) {
+  inproc_stream *s = (inproc_stream *)gs;
+  inproc_transport *t = s->t;
+
+  gpr_mu_lock(&t->shared->mu);
+  if (s->listed) {
+    if (s->list_prev != NULL) {
+      s->list_prev->list_next = s->list_next;
+    } else {
+      t->stream_list = s->list_next;
+    }
+    if (s->list_next != NULL) s->list_next->list_prev = s->list_prev;
+    s->listed = false;
+  }
+  if (s->other != NULL) {
+    inproc_stream *other = s->other;
+    other->other = NULL;
+    other->other_closed = true;
+    if (!s->trailing_md_sent && other->cancel_error == GRPC_ERROR_NONE &&
+        !other->inbox_trailing_md_filled && !other->trailing_md_recvd) {
+      /* going away mid-conversation: the peer can never finish normally */
+      other->cancel_error = grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("inproc peer stream closed"),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE);
+    }
+    inproc_maybe_deliver_locked(exec_ctx, other);
+  }
+  grpc_metadata_batch_destroy(exec_ctx, &s->inbox_initial_md);
+  grpc_metadata_batch_destroy(exec_ctx, &s->inbox_trailing_md);
+  grpc_metadata_batch_destroy(exec_ctx, &s->wb_initial_md);
+  grpc_metadata_batch_destroy(exec_ctx, &s->wb_trailing_md);
+  inproc_msg_list_free(exec_ctx, s->inbox_msgs_head);
+  inproc_msg_list_free(exec_ctx, s->wb_msgs_head);
+  grpc_slice_buffer_destroy_internal(exec_ctx, &s->recv_message_buffer);
+  GRPC_ERROR_UNREF(s->cancel_error);
+  GRPC_ERROR_UNREF(s->wb_cancel_error);
+  gpr_mu_unlock(&t->shared->mu);
+
+  inproc_transport_unref(exec_ctx, t);
+  grpc_closure_sched(exec_ctx, then_schedule_closure, GRPC_ERROR_NONE);
+}
+
+static void inproc_destroy_transport(grpc_exec_ctx *exec_ctx,
+                                     grpc_transport *gt) {
+  inproc_transport *t = (inproc_transport *)gt;
+  gpr_mu_lock(&t->shared->mu);
+  inproc_close_transport_locked(
+      exec_ctx, t,
+      grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("inproc transport destroyed"),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+  inproc_transport *other = t->other;
+  t->other = NULL;
+  if (other != NULL) other->other = NULL;
+  gpr_mu_unlock(&t->shared->mu);
+  if (other != NULL) inproc_transport_unref(exec_ctx, other);
+  inproc_transport_unref(exec_ctx, t);
+}
+
+static char *inproc_get_peer(grpc_exec_ctx *exec_ctx, grpc_transport *gt) {
+  return gpr_strdup("inproc");
+}
+
+static grpc_endpoint *inproc_get_endpoint(grpc_exec_ctx *exec_ctx,
+                                          grpc_transport *gt) {
+  return NULL;
+}
+
+static const grpc_transport_vtable inproc_vtable = {
+    sizeof(inproc_stream),    "inproc",
+    inproc_init_stream,       inproc_set_pollset,
+    inproc_set_pollset_set,   inproc_perform_stream_op,
+    inproc_perform_op,        inproc_destroy_stream,
+    inproc_destroy_transport, inproc_get_peer,
+    inproc_get_endpoint};
+
+static void inproc_transports_create(grpc_transport **server_transport,
+                                     grpc_transport **client_transport) {
+  inproc_shared *shared = (inproc_shared *)gpr_malloc(sizeof(*shared));
+  gpr_mu_init(&shared->mu);
+  gpr_ref_init(&shared->refs, 2);
+
+  inproc_transport *st = (inproc_transport *)gpr_zalloc(sizeof(*st));
+  inproc_transport *ct = (inproc_transport *)gpr_zalloc(sizeof(*ct));
+  st->base.vtable = &inproc_vtable;
+  ct->base.vtable = &inproc_vtable;
+  st->shared = shared;
+  ct->shared = shared;
+  /* one ref for the owning channel stack, one held by the peer transport */
+  gpr_ref_init(&st->refs, 2);
+  gpr_ref_init(&ct->refs, 2);
+  ct->is_client = true;
+  grpc_connectivity_state_init(&st->connectivity, GRPC_CHANNEL_READY,
+                               "inproc_server");
+  grpc_connectivity_state_init(&ct->connectivity, GRPC_CHANNEL_READY,
+                               "inproc_client");
+  st->other = ct;
+  ct->other = st;
+  *server_transport = &st->base;
+  *client_transport = &ct->base;
+}
+
+grpc_channel *grpc_inproc_channel_create(grpc_server *server,
+                                         grpc_channel_args *args,
+                                         void *reserved) {
+  GRPC_API_TRACE("grpc_inproc_channel_create(server=%p, args=%p)", 2,
+                 (server, args));
+  GPR_ASSERT(reserved == NULL);
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  const grpc_channel_args *server_args = grpc_server_get_channel_args(server);
+  grpc_transport *server_transport;
+  grpc_transport *client_transport;
+  inproc_transports_create(&server_transport, &client_transport);
+
+  grpc_server_setup_transport(&exec_ctx, server, server_transport, NULL,
+                              server_args);
+  grpc_channel *channel = grpc_channel_create(
+      &exec_ctx, "inproc", args, GRPC_CLIENT_DIRECT_CHANNEL, client_transport);
+
+  grpc_exec_ctx_finish(&exec_ctx);
+  return channel;
+}
@@ -41,9 +41,11 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/useful.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/support/murmur_hash.h"
 #include "src/core/lib/support/string.h"
 
 static grpc_arg copy_arg(const grpc_arg *src) {
@@ -187,6 +189,155 @@ grpc_channel_args *grpc_channel_args_normalize(const grpc_channel_args *a) {
   return b;
 }
 
+static uint32_t hash_arg(uint32_t h, const grpc_arg *arg) {
+  h = gpr_murmur_hash3(arg->key, strlen(arg->key), h ^ (uint32_t)arg->type);
+  switch (arg->type) {
+    case GRPC_ARG_STRING:
+      h = gpr_murmur_hash3(arg->value.string, strlen(arg->value.string), h);
+      break;
+    case GRPC_ARG_INTEGER:
+      h = gpr_murmur_hash3(&arg->value.integer, sizeof(arg->value.integer), h);
+      break;
+    case GRPC_ARG_POINTER:
+      /* pointer args are compared via their vtable's cmp, under which
+         distinct pointers may be equal: only the arg's key (hashed above)
+         can safely contribute to the digest */
+      break;
+  }
+  return h;
+}
+
+uint32_t grpc_channel_args_hash(const grpc_channel_args *a) {
+  uint32_t h = 0;
+  if (a != NULL) {
+    for (size_t i = 0; i < a->num_args; i++) {
+      h = hash_arg(h, &a->args[i]);
+    }
+  }
+  return h;
+}
+
+/* The intern table: a fixed number of chained buckets guarded by one mutex.
+   Channels are built far too rarely for anything fancier to pay off. */
+#define INTERN_BUCKET_COUNT 64
+
+typedef struct interned_channel_args {
+  struct interned_channel_args *next;
+  gpr_refcount refs;
+  uint32_t hash;
+  grpc_channel_args *args;
+} interned_channel_args;
+
+static gpr_mu g_intern_mu;
+static interned_channel_args *g_intern_buckets[INTERN_BUCKET_COUNT];
+
+void grpc_channel_args_intern_init(void) { gpr_mu_init(&g_intern_mu); }
+
+void grpc_channel_args_intern_shutdown(void) {
+  for (size_t i = 0; i < INTERN_BUCKET_COUNT; i++) {
+    GPR_ASSERT(g_intern_buckets[i] == NULL);
+  }
+  gpr_mu_destroy(&g_intern_mu);
+}
+
+/* Compare the normalized view of \a src - \a sorted holds its args in
+   normalized order - against the (already normalized) interned args \a b,
+   without materializing a copy of \a src. */
+static int cmp_sorted_view(grpc_arg *const *sorted, size_t num_args,
+                           const grpc_channel_args *b) {
+  int c = GPR_ICMP(num_args, b->num_args);
+  if (c != 0) return c;
+  for (size_t i = 0; i < num_args; i++) {
+    c = cmp_arg(sorted[i], &b->args[i]);
+    if (c != 0) return c;
+  }
+  return 0;
+}
+
+const grpc_channel_args *grpc_channel_args_intern(
+    const grpc_channel_args *src) {
+  size_t num_args = src == NULL ? 0 : src->num_args;
+  grpc_arg **sorted = gpr_malloc(sizeof(grpc_arg *) * num_args);
+  uint32_t hash = 0;
+  interned_channel_args *e;
+
+  for (size_t i = 0; i < num_args; i++) {
+    sorted[i] = &src->args[i];
+  }
+  if (num_args > 1) {
+    qsort(sorted, num_args, sizeof(grpc_arg *), cmp_key_stable);
+  }
+  for (size_t i = 0; i < num_args; i++) {
+    hash = hash_arg(hash, sorted[i]);
+  }
+
+  gpr_mu_lock(&g_intern_mu);
+  for (e = g_intern_buckets[hash % INTERN_BUCKET_COUNT]; e != NULL;
+       e = e->next) {
+    if (e->hash == hash && cmp_sorted_view(sorted, num_args, e->args) == 0) {
+      gpr_ref(&e->refs);
+      gpr_mu_unlock(&g_intern_mu);
+      gpr_free(sorted);
+      return e->args;
+    }
+  }
+
+  /* not seen before: materialize a normalized copy and publish it */
+  e = gpr_malloc(sizeof(*e));
+  gpr_ref_init(&e->refs, 1);
+  e->hash = hash;
+  e->args = gpr_malloc(sizeof(grpc_channel_args));
+  e->args->num_args = num_args;
+  e->args->args =
+      num_args == 0 ? NULL : gpr_malloc(sizeof(grpc_arg) * num_args);
+  for (size_t i = 0; i < num_args; i++) {
+    e->args->args[i] = copy_arg(sorted[i]);
+  }
+  e->next = g_intern_buckets[hash % INTERN_BUCKET_COUNT];
+  g_intern_buckets[hash % INTERN_BUCKET_COUNT] = e;
+  gpr_mu_unlock(&g_intern_mu);
+  gpr_free(sorted);
+  return e->args;
+}
+
+/** Returns the location of the entry owning \a args within its bucket;
+    aborts if \a args was never interned. */
+static interned_channel_args **intern_find_locked(
+    const grpc_channel_args *args) {
+  interned_channel_args **pe =
+      &g_intern_buckets[grpc_channel_args_hash(args) % INTERN_BUCKET_COUNT];
+  while (*pe != NULL && (*pe)->args != args) {
+    pe = &(*pe)->next;
+  }
+  GPR_ASSERT(*pe != NULL);
+  return pe;
+}
+
+const grpc_channel_args *grpc_channel_args_intern_ref(
+    const grpc_channel_args *args) {
+  gpr_mu_lock(&g_intern_mu);
+  gpr_ref(&(*intern_find_locked(args))->refs);
+  gpr_mu_unlock(&g_intern_mu);
+  return args;
+}
+
+void grpc_channel_args_intern_unref(grpc_exec_ctx *exec_ctx,
+                                    const grpc_channel_args *args) {
+  interned_channel_args **pe;
+  interned_channel_args *e;
+  gpr_mu_lock(&g_intern_mu);
+  pe = intern_find_locked(args);
+  e = *pe;
+  if (!gpr_unref(&e->refs)) {
+    gpr_mu_unlock(&g_intern_mu);
+    return;
+  }
+  *pe = e->next;
+  gpr_mu_unlock(&g_intern_mu);
+  grpc_channel_args_destroy(exec_ctx, e->args);
+  gpr_free(e);
+}
+
 void grpc_channel_args_destroy(grpc_exec_ctx *exec_ctx, grpc_channel_args *a) {
   size_t i;
   if (!a) return;
@@ -70,6 +70,30 @@ grpc_channel_args *grpc_channel_args_merge(const grpc_channel_args *a,
 /** Destroy arguments created by \a grpc_channel_args_copy */
 void grpc_channel_args_destroy(grpc_exec_ctx *exec_ctx, grpc_channel_args *a);
 
+/** Hash the contents of \a a. Pointer args contribute only their keys: their
+    cmp vtables can equate distinct pointers, and equal values must never
+    hash differently. */
+uint32_t grpc_channel_args_hash(const grpc_channel_args *a);
+
+/** Return a normalized, refcounted copy of \a src shared with every other
+    caller that interned equal args: equal interned args are
+    pointer-identical, so comparing them is a pointer compare. The result is
+    immutable and lives until the last grpc_channel_args_intern_unref. */
+const grpc_channel_args *grpc_channel_args_intern(const grpc_channel_args *src);
+
+/** Take an additional reference on args returned by
+    \a grpc_channel_args_intern. */
+const grpc_channel_args *grpc_channel_args_intern_ref(
+    const grpc_channel_args *args);
+
+/** Release a reference taken by \a grpc_channel_args_intern or
+    \a grpc_channel_args_intern_ref. */
+void grpc_channel_args_intern_unref(grpc_exec_ctx *exec_ctx,
+                                    const grpc_channel_args *args);
+
+void grpc_channel_args_intern_init(void);
+void grpc_channel_args_intern_shutdown(void);
+
 /** Returns the compression algorithm set in \a a. */
 grpc_compression_algorithm grpc_channel_args_get_compression_algorithm(
     const grpc_channel_args *a);
@@ -36,6 +36,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
 grpc_tracer_flag grpc_trace_channel_stack_builder =
@@ -173,26 +174,24 @@ const grpc_channel_args *grpc_channel_stack_builder_get_channel_arguments(
   return builder->args;
 }
 
+static void add_after(filter_node *before, const grpc_channel_filter *filter,
+                      grpc_post_filter_create_init_func post_init_func,
+                      void *user_data);
+
+/* append/prepend run once per filter per channel: insert at the sentinels
+   directly rather than allocating a throwaway iterator */
 bool grpc_channel_stack_builder_append_filter(
     grpc_channel_stack_builder *builder, const grpc_channel_filter *filter,
     grpc_post_filter_create_init_func post_init_func, void *user_data) {
-  grpc_channel_stack_builder_iterator *it =
-      grpc_channel_stack_builder_create_iterator_at_last(builder);
-  bool ok = grpc_channel_stack_builder_add_filter_before(
-      it, filter, post_init_func, user_data);
-  grpc_channel_stack_builder_iterator_destroy(it);
-  return ok;
+  add_after(builder->end.prev, filter, post_init_func, user_data);
+  return true;
 }
 
 bool grpc_channel_stack_builder_prepend_filter(
     grpc_channel_stack_builder *builder, const grpc_channel_filter *filter,
     grpc_post_filter_create_init_func post_init_func, void *user_data) {
-  grpc_channel_stack_builder_iterator *it =
-      grpc_channel_stack_builder_create_iterator_at_first(builder);
-  bool ok = grpc_channel_stack_builder_add_filter_after(
-      it, filter, post_init_func, user_data);
-  grpc_channel_stack_builder_iterator_destroy(it);
-  return ok;
+  add_after(&builder->begin, filter, post_init_func, user_data);
+  return true;
 }
 
 static void add_after(filter_node *before, const grpc_channel_filter *filter,
@@ -225,6 +224,39 @@ bool grpc_channel_stack_builder_add_filter_after(
   return true;
 }
 
+bool grpc_channel_stack_builder_fuse_filters(
+    grpc_channel_stack_builder *builder,
+    const grpc_channel_filter *const *filters, size_t num_filters,
+    const grpc_channel_filter *replacement) {
+  if (num_filters == 0) return false;
+  filter_node *p = builder->begin.next;
+  for (size_t i = 0; i < num_filters; i++, p = p->next) {
+    if (p == &builder->end) return false;
+    if (p->filter != filters[i]) return false;
+    /* a post-creation callback is written against this filter's element and
+       would not survive the element disappearing into the fused one */
+    if (p->init != NULL) return false;
+  }
+  /* anything after the run must be a transport-binding element, otherwise
+     this is a different stack shape than the one the fusion was written
+     for */
+  for (filter_node *q = p; q != &builder->end; q = q->next) {
+    if (q->init == NULL) return false;
+  }
+  /* unlink and free the matched run, then plant the fused filter where it
+     started */
+  filter_node *first = builder->begin.next;
+  builder->begin.next = p;
+  p->prev = &builder->begin;
+  while (first != p) {
+    filter_node *next = first->next;
+    gpr_free(first);
+    first = next;
+  }
+  add_after(&builder->begin, replacement, NULL, NULL);
+  return true;
+}
+
 void grpc_channel_stack_builder_destroy(grpc_exec_ctx *exec_ctx,
                                         grpc_channel_stack_builder *builder) {
   filter_node *p = builder->begin.next;
@@ -277,6 +309,12 @@ grpc_error *grpc_channel_stack_builder_finish(
     gpr_free(*result);
     *result = NULL;
   } else {
+    if (GRPC_TRACER_ON(grpc_trace_channel)) {
+      gpr_log(GPR_DEBUG,
+              "channel stack '%s': %" PRIuPTR " filters, %" PRIuPTR
+              " bytes per call",
+              builder->name, num_filters, channel_stack->call_stack_size);
+    }
     // run post-initialization functions
     i = 0;
     for (filter_node *p = builder->begin.next; p != &builder->end;
@@ -147,6 +147,17 @@ bool grpc_channel_stack_builder_append_filter(
     grpc_post_filter_create_init_func post_init_func,
     void *user_data) GRPC_MUST_USE_RESULT;
 
+/// If the filter list is exactly \a filters (same filters, same order),
+/// optionally followed by filters that carry a post-creation callback (in
+/// practice the transport-bound connected filter, which cannot be fused),
+/// replace the matching run with the single \a replacement filter and return
+/// true. Returns false, leaving the builder untouched, on any mismatch -
+/// including a matching filter that carries a post-creation callback.
+bool grpc_channel_stack_builder_fuse_filters(
+    grpc_channel_stack_builder *builder,
+    const grpc_channel_filter *const *filters, size_t num_filters,
+    const grpc_channel_filter *replacement);
+
 /// Terminate iteration and destroy \a iterator
 void grpc_channel_stack_builder_iterator_destroy(
     grpc_channel_stack_builder_iterator *iterator);
@@ -36,6 +36,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 
 #include <zlib.h>
@@ -44,6 +45,31 @@
 
 #define OUTPUT_BLOCK_SIZE 1024
 
+struct grpc_msg_compress_context {
+  grpc_compression_algorithm algorithm;
+  z_stream zs;
+  int zs_initialized;
+};
+
+/* Process-wide per-algorithm counters, see grpc_msg_compress_get_stats. */
+static gpr_atm g_bytes_in[GRPC_COMPRESS_ALGORITHMS_COUNT];
+static gpr_atm g_bytes_out[GRPC_COMPRESS_ALGORITHMS_COUNT];
+static gpr_atm g_msgs_compressed[GRPC_COMPRESS_ALGORITHMS_COUNT];
+static gpr_atm g_msgs_uncompressed[GRPC_COMPRESS_ALGORITHMS_COUNT];
+
+static void record_compress_stats(grpc_compression_algorithm algorithm,
+                                  size_t bytes_in, size_t bytes_out,
+                                  int did_compress) {
+  if (algorithm >= GRPC_COMPRESS_ALGORITHMS_COUNT) return;
+  if (did_compress) {
+    gpr_atm_no_barrier_fetch_add(&g_bytes_in[algorithm], (gpr_atm)bytes_in);
+    gpr_atm_no_barrier_fetch_add(&g_bytes_out[algorithm], (gpr_atm)bytes_out);
+    gpr_atm_no_barrier_fetch_add(&g_msgs_compressed[algorithm], 1);
+  } else {
+    gpr_atm_no_barrier_fetch_add(&g_msgs_uncompressed[algorithm], 1);
+  }
+}
+
 static int zlib_body(grpc_exec_ctx* exec_ctx, z_stream* zs,
                      grpc_slice_buffer* input, grpc_slice_buffer* output,
                      int (*flate)(z_stream* zs, int flush)) {
@@ -99,21 +125,17 @@ static void* zalloc_gpr(void* opaque, unsigned int items, unsigned int size) {
 
 static void zfree_gpr(void* opaque, void* address) { gpr_free(address); }
 
-static int zlib_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
-                         grpc_slice_buffer* output, int gzip) {
-  z_stream zs;
+/* Runs a single deflate pass over input with an already initialized stream,
+   rolling output back if compression was not beneficial or failed. */
+static int zlib_compress_run(grpc_exec_ctx* exec_ctx, z_stream* zs,
+                             grpc_slice_buffer* input,
+                             grpc_slice_buffer* output) {
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(exec_ctx, &zs, input, output, deflate) &&
-      output->length < input->length;
+  r = zlib_body(exec_ctx, zs, input, output, deflate) &&
+      output->length - length_before < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_slice_unref_internal(exec_ctx, output->slices[i]);
@@ -121,6 +143,25 @@ static int zlib_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
     output->count = count_before;
     output->length = length_before;
   }
+  return r;
+}
+
+static void zlib_compress_init(z_stream* zs, int gzip) {
+  int r;
+  memset(zs, 0, sizeof(*zs));
+  zs->zalloc = zalloc_gpr;
+  zs->zfree = zfree_gpr;
+  r = deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
+                   8, Z_DEFAULT_STRATEGY);
+  GPR_ASSERT(r == Z_OK);
+}
+
+static int zlib_compress(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                         grpc_slice_buffer* output, int gzip) {
+  z_stream zs;
+  int r;
+  zlib_compress_init(&zs, gzip);
+  r = zlib_compress_run(exec_ctx, &zs, input, output);
   deflateEnd(&zs);
   return r;
 }
@@ -157,9 +198,32 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   return 1;
 }
 
+static const grpc_compression_engine* g_engines[GRPC_COMPRESS_ALGORITHMS_COUNT];
+
+void grpc_compression_engine_register(grpc_compression_algorithm algorithm,
+                                      const grpc_compression_engine* engine) {
+  GPR_ASSERT(algorithm != GRPC_COMPRESS_NONE &&
+             algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT);
+  if (engine != NULL) {
+    GPR_ASSERT(engine->name != NULL && engine->compress != NULL &&
+               engine->decompress != NULL);
+  }
+  g_engines[algorithm] = engine;
+}
+
+const grpc_compression_engine* grpc_compression_engine_lookup(
+    grpc_compression_algorithm algorithm) {
+  GPR_ASSERT(algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT);
+  return g_engines[algorithm];
+}
+
 static int compress_inner(grpc_exec_ctx* exec_ctx,
                           grpc_compression_algorithm algorithm,
                           grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  if (algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT &&
+      g_engines[algorithm] != NULL) {
+    return g_engines[algorithm]->compress(exec_ctx, input, output);
+  }
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       /* the fallback path always needs to be send uncompressed: we simply
@@ -179,16 +243,98 @@ static int compress_inner(grpc_exec_ctx* exec_ctx,
 int grpc_msg_compress(grpc_exec_ctx* exec_ctx,
                       grpc_compression_algorithm algorithm,
                       grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  size_t length_before = output->length;
   if (!compress_inner(exec_ctx, algorithm, input, output)) {
     copy(input, output);
+    record_compress_stats(algorithm, input->length, input->length, 0);
     return 0;
   }
+  record_compress_stats(algorithm, input->length,
+                        output->length - length_before, 1);
   return 1;
 }
 
+grpc_msg_compress_context* grpc_msg_compress_context_create(
+    grpc_compression_algorithm algorithm) {
+  grpc_msg_compress_context* ctx = gpr_zalloc(sizeof(*ctx));
+  ctx->algorithm = algorithm;
+  return ctx;
+}
+
+void grpc_msg_compress_context_destroy(grpc_msg_compress_context* ctx) {
+  if (ctx == NULL) return;
+  if (ctx->zs_initialized) deflateEnd(&ctx->zs);
+  gpr_free(ctx);
+}
+
+int grpc_msg_compress_ctx(grpc_exec_ctx* exec_ctx,
+                          grpc_msg_compress_context* ctx,
+                          grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  size_t length_before = output->length;
+  int r = 0;
+  if (ctx->algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT &&
+      g_engines[ctx->algorithm] != NULL) {
+    /* engines manage their own state; the context is just a dispatcher */
+    return grpc_msg_compress(exec_ctx, ctx->algorithm, input, output);
+  }
+  switch (ctx->algorithm) {
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+      if (!ctx->zs_initialized) {
+        zlib_compress_init(&ctx->zs, ctx->algorithm == GRPC_COMPRESS_GZIP);
+        ctx->zs_initialized = 1;
+      } else {
+        GPR_ASSERT(deflateReset(&ctx->zs) == Z_OK);
+      }
+      r = zlib_compress_run(exec_ctx, &ctx->zs, input, output);
+      break;
+    default:
+      /* same fallback as grpc_msg_compress for non-compressing algorithms */
+      break;
+  }
+  if (!r) {
+    copy(input, output);
+    record_compress_stats(ctx->algorithm, input->length, input->length, 0);
+    return 0;
+  }
+  record_compress_stats(ctx->algorithm, input->length,
+                        output->length - length_before, 1);
+  return 1;
+}
+
+void grpc_msg_compress_get_stats(grpc_compression_algorithm algorithm,
+                                 size_t* bytes_in, size_t* bytes_out,
+                                 size_t* messages_compressed,
+                                 size_t* messages_uncompressed) {
+  GPR_ASSERT(algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT);
+  if (bytes_in != NULL) {
+    *bytes_in = (size_t)gpr_atm_no_barrier_load(&g_bytes_in[algorithm]);
+  }
+  if (bytes_out != NULL) {
+    *bytes_out = (size_t)gpr_atm_no_barrier_load(&g_bytes_out[algorithm]);
+  }
+  if (messages_compressed != NULL) {
+    *messages_compressed =
+        (size_t)gpr_atm_no_barrier_load(&g_msgs_compressed[algorithm]);
+  }
+  if (messages_uncompressed != NULL) {
+    *messages_uncompressed =
+        (size_t)gpr_atm_no_barrier_load(&g_msgs_uncompressed[algorithm]);
+  }
+}
+
+void grpc_msg_compress_record_uncompressed(
+    grpc_compression_algorithm algorithm) {
+  record_compress_stats(algorithm, 0, 0, 0);
+}
+
 int grpc_msg_decompress(grpc_exec_ctx* exec_ctx,
                         grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  if (algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT &&
+      g_engines[algorithm] != NULL) {
+    return g_engines[algorithm]->decompress(exec_ctx, input, output);
+  }
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       return copy(input, output);
@@ -51,4 +51,64 @@ int grpc_msg_decompress(grpc_exec_ctx* exec_ctx,
                         grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+/* A compression engine supplies the compress/decompress implementation for
+   one grpc_compression_algorithm, overriding the built-in zlib paths (e.g.
+   to plug in a hardware-accelerated codec). Engines operate directly on
+   slice buffers, so they are free to scatter/gather rather than flatten.
+   The contract matches the built-in implementations: compress appends
+   compressed slices to output and returns 1 only when compression was
+   beneficial (returning 0 makes the caller send uncompressed); decompress
+   appends slices on success and returns 1, or leaves output unchanged and
+   returns 0 on corrupt input. */
+typedef struct {
+  const char* name;
+  int (*compress)(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                  grpc_slice_buffer* output);
+  int (*decompress)(grpc_exec_ctx* exec_ctx, grpc_slice_buffer* input,
+                    grpc_slice_buffer* output);
+} grpc_compression_engine;
+
+/* Register \a engine as the implementation of \a algorithm, replacing any
+   previously registered engine; NULL restores the built-in implementation.
+   The registered algorithm keeps its existing wire name, so it is still
+   negotiated through the usual grpc-accept-encoding machinery. Registration
+   is not thread-safe and must happen before the algorithm is used. */
+void grpc_compression_engine_register(grpc_compression_algorithm algorithm,
+                                      const grpc_compression_engine* engine);
+
+/* Returns the engine registered for \a algorithm, or NULL if the built-in
+   implementation is in effect. */
+const grpc_compression_engine* grpc_compression_engine_lookup(
+    grpc_compression_algorithm algorithm);
+
+/* A reusable compression context, meant to be kept for the lifetime of a
+   stream and fed every message sent on it. Compressing through a context
+   produces exactly the same framing as grpc_msg_compress - every message
+   stays independently decompressible - but the compressor state is allocated
+   once and reset between messages instead of being rebuilt for each one.
+   A context may only be used by one message at a time. */
+typedef struct grpc_msg_compress_context grpc_msg_compress_context;
+
+grpc_msg_compress_context* grpc_msg_compress_context_create(
+    grpc_compression_algorithm algorithm);
+void grpc_msg_compress_context_destroy(grpc_msg_compress_context* ctx);
+
+/* Like grpc_msg_compress, using (and reusing) ctx's compressor state. */
+int grpc_msg_compress_ctx(grpc_exec_ctx* exec_ctx,
+                          grpc_msg_compress_context* ctx,
+                          grpc_slice_buffer* input, grpc_slice_buffer* output);
+
+/* Process-wide per-algorithm compression counters: bytes in/out of messages
+   that were actually compressed, and how many messages were compressed vs.
+   sent uncompressed (not beneficial, or bypassed). Any out-param may be
+   NULL. */
+void grpc_msg_compress_get_stats(grpc_compression_algorithm algorithm,
+                                 size_t* bytes_in, size_t* bytes_out,
+                                 size_t* messages_compressed,
+                                 size_t* messages_uncompressed);
+
+/* Accounts a message that was sent uncompressed without going through
+   grpc_msg_compress (e.g. an adaptive compression bypass). */
+void grpc_msg_compress_record_uncompressed(grpc_compression_algorithm algorithm);
+
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
@@ -36,6 +36,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include "src/core/lib/support/env.h"
 
@@ -145,3 +146,43 @@ int grpc_tracer_set_enabled(const char *name, int enabled) {
   }
   return 1;
 }
+
+/* --- Stats. --- */
+
+#define STATS_MAX_SHARDS 32
+
+/* Each shard lives on its own set of cachelines so that cores incrementing
+   different shards never contend. */
+typedef struct {
+  gpr_atm counters[GRPC_STATS_COUNTER_COUNT];
+  char padding[1 << GPR_CACHELINE_SIZE_LOG];
+} stats_shard;
+
+static stats_shard g_stats_shards[STATS_MAX_SHARDS];
+
+static const char *g_stats_counter_names[GRPC_STATS_COUNTER_COUNT] = {
+    "tcp_reads", "tcp_writes", "pollset_work", "combiner_locks", "hpack_hits"};
+
+void grpc_stats_inc_counter(grpc_stats_counter_id counter) {
+  stats_shard *shard =
+      &g_stats_shards[gpr_cpu_current_cpu() % STATS_MAX_SHARDS];
+  gpr_atm_no_barrier_fetch_add(&shard->counters[counter], 1);
+}
+
+size_t grpc_stats_counter_count(void) { return GRPC_STATS_COUNTER_COUNT; }
+
+const char *grpc_stats_counter_name(size_t which) {
+  return which < GRPC_STATS_COUNTER_COUNT ? g_stats_counter_names[which]
+                                          : NULL;
+}
+
+void grpc_stats_collect(uint64_t *counters) {
+  size_t i, j;
+  for (i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) counters[i] = 0;
+  for (j = 0; j < STATS_MAX_SHARDS; j++) {
+    for (i = 0; i < GRPC_STATS_COUNTER_COUNT; i++) {
+      counters[i] +=
+          (uint64_t)gpr_atm_no_barrier_load(&g_stats_shards[j].counters[i]);
+    }
+  }
+}
@@ -66,4 +66,24 @@ void grpc_register_tracer(const char *name, grpc_tracer_flag *flag);
 void grpc_tracer_init(const char *env_var_name);
 void grpc_tracer_shutdown(void);
 
+/* --- Stats. ---
+
+   Always-on event counters for core hot paths. Incrementing is one relaxed
+   add on a per-cpu shard (no shared cachelines, no locks), cheap enough to
+   stay enabled in production builds; aggregation sums the shards on demand
+   via grpc_stats_collect() in grpc.h. */
+
+typedef enum {
+  GRPC_STATS_COUNTER_TCP_READS = 0,
+  GRPC_STATS_COUNTER_TCP_WRITES,
+  GRPC_STATS_COUNTER_POLLSET_WORK,
+  GRPC_STATS_COUNTER_COMBINER_LOCKS,
+  GRPC_STATS_COUNTER_HPACK_HITS,
+  GRPC_STATS_COUNTER_COUNT
+} grpc_stats_counter_id;
+
+void grpc_stats_inc_counter(grpc_stats_counter_id counter);
+
+#define GRPC_STATS_INC_COUNTER(counter) grpc_stats_inc_counter(counter)
+
 #endif /* GRPC_CORE_LIB_DEBUG_TRACE_H */
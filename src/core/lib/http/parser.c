@@ -253,7 +253,8 @@ static grpc_error *finish_line(grpc_http_parser *parser,
   return GRPC_ERROR_NONE;
 }
 
-static grpc_error *addbyte_body(grpc_http_parser *parser, uint8_t byte) {
+static grpc_error *addbytes_body(grpc_http_parser *parser,
+                                 const uint8_t *bytes, size_t length) {
   size_t *body_length = NULL;
   char **body = NULL;
 
@@ -268,62 +269,30 @@ static grpc_error *addbyte_body(grpc_http_parser *parser, uint8_t byte) {
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING("Should never reach here"));
   }
 
-  if (*body_length == parser->body_capacity) {
-    parser->body_capacity = GPR_MAX(8, parser->body_capacity * 3 / 2);
+  if (*body_length + length > parser->body_capacity) {
+    while (*body_length + length > parser->body_capacity) {
+      parser->body_capacity = GPR_MAX(8, parser->body_capacity * 3 / 2);
+    }
     *body = gpr_realloc((void *)*body, parser->body_capacity);
   }
-  (*body)[*body_length] = (char)byte;
-  (*body_length)++;
+  memcpy(*body + *body_length, bytes, length);
+  *body_length += length;
 
   return GRPC_ERROR_NONE;
 }
 
-static bool check_line(grpc_http_parser *parser) {
-  if (parser->cur_line_length >= 2 &&
-      parser->cur_line[parser->cur_line_length - 2] == '\r' &&
-      parser->cur_line[parser->cur_line_length - 1] == '\n') {
-    return true;
-  }
-
-  // HTTP request with \n\r line termiantors.
-  else if (parser->cur_line_length >= 2 &&
-           parser->cur_line[parser->cur_line_length - 2] == '\n' &&
-           parser->cur_line[parser->cur_line_length - 1] == '\r') {
-    return true;
-  }
-
-  // HTTP request with only \n line terminators.
-  else if (parser->cur_line_length >= 1 &&
-           parser->cur_line[parser->cur_line_length - 1] == '\n') {
-    parser->cur_line_end_length = 1;
-    return true;
-  }
-
-  return false;
-}
-
-static grpc_error *addbyte(grpc_http_parser *parser, uint8_t byte,
-                           bool *found_body_start) {
-  switch (parser->state) {
-    case GRPC_HTTP_FIRST_LINE:
-    case GRPC_HTTP_HEADERS:
-      if (parser->cur_line_length >= GRPC_HTTP_PARSER_MAX_HEADER_LENGTH) {
-        if (GRPC_TRACER_ON(grpc_http1_trace))
-          gpr_log(GPR_ERROR, "HTTP header max line length (%d) exceeded",
-                  GRPC_HTTP_PARSER_MAX_HEADER_LENGTH);
-        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
-            "HTTP header max line length exceeded");
-      }
-      parser->cur_line[parser->cur_line_length] = byte;
-      parser->cur_line_length++;
-      if (check_line(parser)) {
-        return finish_line(parser, found_body_start);
-      }
-      return GRPC_ERROR_NONE;
-    case GRPC_HTTP_BODY:
-      return addbyte_body(parser, byte);
+static grpc_error *addbytes_header(grpc_http_parser *parser,
+                                   const uint8_t *bytes, size_t length) {
+  if (parser->cur_line_length + length > GRPC_HTTP_PARSER_MAX_HEADER_LENGTH) {
+    if (GRPC_TRACER_ON(grpc_http1_trace))
+      gpr_log(GPR_ERROR, "HTTP header max line length (%d) exceeded",
+              GRPC_HTTP_PARSER_MAX_HEADER_LENGTH);
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "HTTP header max line length exceeded");
   }
-  GPR_UNREACHABLE_CODE(return GRPC_ERROR_NONE);
+  memcpy(parser->cur_line + parser->cur_line_length, bytes, length);
+  parser->cur_line_length += length;
+  return GRPC_ERROR_NONE;
 }
 
 void grpc_http_parser_init(grpc_http_parser *parser, grpc_http_type type,
@@ -361,12 +330,51 @@ void grpc_http_response_destroy(grpc_http_response *response) {
 
 grpc_error *grpc_http_parser_parse(grpc_http_parser *parser, grpc_slice slice,
                                    size_t *start_of_body) {
-  for (size_t i = 0; i < GRPC_SLICE_LENGTH(slice); i++) {
-    bool found_body_start = false;
-    grpc_error *err =
-        addbyte(parser, GRPC_SLICE_START_PTR(slice)[i], &found_body_start);
+  const uint8_t *beg = GRPC_SLICE_START_PTR(slice);
+  const uint8_t *end = beg + GRPC_SLICE_LENGTH(slice);
+  const uint8_t *cur = beg;
+
+  /* Rather than feeding the state machine a byte at a time, scan whole
+     chunks: every header line ends at its first LF, and memchr compiles to
+     a word-at-a-time/vectorized scan on every platform we care about. Body
+     bytes need no scanning at all and are appended in one memcpy. */
+  while (cur != end) {
+    grpc_error *err;
+    const uint8_t *lf;
+
+    if (parser->state == GRPC_HTTP_BODY) {
+      err = addbytes_body(parser, cur, (size_t)(end - cur));
+      if (err != GRPC_ERROR_NONE) return err;
+      break;
+    }
+
+    lf = memchr(cur, '\n', (size_t)(end - cur));
+    if (lf == NULL) {
+      /* no line end in this slice: buffer everything and wait for more */
+      err = addbytes_header(parser, cur, (size_t)(end - cur));
+      if (err != GRPC_ERROR_NONE) return err;
+      break;
+    }
+
+    err = addbytes_header(parser, cur, (size_t)(lf + 1 - cur));
     if (err != GRPC_ERROR_NONE) return err;
-    if (found_body_start && start_of_body != NULL) *start_of_body = i + 1;
+    cur = lf + 1;
+
+    /* the line is complete; classify its terminator the same way the old
+       byte-wise check did: CRLF keeps the current terminator length, a
+       lone LF switches the parser to 1 byte terminators */
+    if (!(parser->cur_line_length >= 2 &&
+          parser->cur_line[parser->cur_line_length - 2] == '\r')) {
+      parser->cur_line_end_length = 1;
+    }
+    {
+      bool found_body_start = false;
+      err = finish_line(parser, &found_body_start);
+      if (err != GRPC_ERROR_NONE) return err;
+      if (found_body_start && start_of_body != NULL) {
+        *start_of_body = (size_t)(cur - beg);
+      }
+    }
   }
   return GRPC_ERROR_NONE;
 }
@@ -39,6 +39,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/workqueue.h"
 #include "src/core/lib/profiling/timers.h"
 
@@ -54,6 +55,11 @@ grpc_tracer_flag grpc_combiner_trace = GRPC_TRACER_INITIALIZER(false);
 #define STATE_UNORPHANED 1
 #define STATE_ELEM_COUNT_LOW_BIT 2
 
+/* Maximum closures run per combiner acquisition before the combiner
+   reschedules itself (via its workqueue) so other fds on the poller get a
+   turn. */
+#define COMBINER_RUN_QUANTUM 32
+
 struct grpc_combiner {
   grpc_combiner *next_combiner_on_this_exec_ctx;
   grpc_workqueue *optional_workqueue;
@@ -62,18 +68,29 @@ struct grpc_combiner {
   grpc_closure_scheduler uncovered_finally_scheduler;
   grpc_closure_scheduler covered_finally_scheduler;
   gpr_mpscq queue;
+  // remainder of the last gpr_mpscq_pop_all batch: drained one closure at a
+  // time without touching the queue's atomics again
+  gpr_mpscq_node *popped;
   // state is:
   // lower bit - zero if orphaned (STATE_UNORPHANED)
   // other bits - number of items queued on the lock (STATE_ELEM_COUNT_LOW_BIT)
-  gpr_atm state;
+  // padded: every producer fetch_adds it, and it must not share a line with
+  // the consumer-owned fields around it
+  gpr_atm_padded state;
   // number of elements in the list that are covered by a poller: if >0, we can
   // offload safely
-  gpr_atm elements_covered_by_poller;
+  gpr_atm_padded elements_covered_by_poller;
   bool time_to_execute_final_list;
   bool final_list_covered_by_poller;
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+  // closures run since this combiner was last pushed onto an exec_ctx;
+  // bounded by COMBINER_RUN_QUANTUM
+  size_t elems_this_acquisition;
+  // monotonic counters for spotting hot combiners
+  gpr_atm items_scheduled;
+  gpr_atm quantum_offloads;
 };
 
 static void combiner_exec_uncovered(grpc_exec_ctx *exec_ctx,
@@ -117,17 +134,18 @@ static error_data unpack_error_data(uintptr_t p) {
 
 static bool is_covered_by_poller(grpc_combiner *lock) {
   return lock->final_list_covered_by_poller ||
-         gpr_atm_acq_load(&lock->elements_covered_by_poller) > 0;
+         gpr_atm_acq_load(&lock->elements_covered_by_poller.counter) > 0;
 }
 
 #define IS_COVERED_BY_POLLER_FMT "(final=%d elems=%" PRIdPTR ")->%d"
 #define IS_COVERED_BY_POLLER_ARGS(lock)                      \
   (lock)->final_list_covered_by_poller,                      \
-      gpr_atm_acq_load(&(lock)->elements_covered_by_poller), \
+      gpr_atm_acq_load(&(lock)->elements_covered_by_poller.counter), \
       is_covered_by_poller((lock))
 
 grpc_combiner *grpc_combiner_create(grpc_workqueue *optional_workqueue) {
-  grpc_combiner *lock = gpr_malloc(sizeof(*lock));
+  grpc_combiner *lock =
+      gpr_malloc_aligned(sizeof(*lock), GPR_CACHELINE_SIZE_LOG);
   gpr_ref_init(&lock->refs, 1);
   lock->next_combiner_on_this_exec_ctx = NULL;
   lock->time_to_execute_final_list = false;
@@ -137,9 +155,13 @@ grpc_combiner *grpc_combiner_create(grpc_workqueue *optional_workqueue) {
   lock->covered_scheduler.vtable = &scheduler_covered;
   lock->uncovered_finally_scheduler.vtable = &finally_scheduler_uncovered;
   lock->covered_finally_scheduler.vtable = &finally_scheduler_covered;
-  gpr_atm_no_barrier_store(&lock->state, STATE_UNORPHANED);
-  gpr_atm_no_barrier_store(&lock->elements_covered_by_poller, 0);
+  gpr_atm_no_barrier_store(&lock->state.counter, STATE_UNORPHANED);
+  gpr_atm_no_barrier_store(&lock->elements_covered_by_poller.counter, 0);
+  lock->elems_this_acquisition = 0;
+  gpr_atm_no_barrier_store(&lock->items_scheduled, 0);
+  gpr_atm_no_barrier_store(&lock->quantum_offloads, 0);
   gpr_mpscq_init(&lock->queue);
+  lock->popped = NULL;
   grpc_closure_list_init(&lock->final_list);
   grpc_closure_init(&lock->offload, offload, lock,
                     grpc_workqueue_scheduler(lock->optional_workqueue));
@@ -149,14 +171,15 @@ grpc_combiner *grpc_combiner_create(grpc_workqueue *optional_workqueue) {
 
 static void really_destroy(grpc_exec_ctx *exec_ctx, grpc_combiner *lock) {
   GRPC_COMBINER_TRACE(gpr_log(GPR_DEBUG, "C:%p really_destroy", lock));
-  GPR_ASSERT(gpr_atm_no_barrier_load(&lock->state) == 0);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&lock->state.counter) == 0);
+  GPR_ASSERT(lock->popped == NULL);
   gpr_mpscq_destroy(&lock->queue);
   GRPC_WORKQUEUE_UNREF(exec_ctx, lock->optional_workqueue, "combiner");
-  gpr_free(lock);
+  gpr_free_aligned(lock);
 }
 
 static void start_destroy(grpc_exec_ctx *exec_ctx, grpc_combiner *lock) {
-  gpr_atm old_state = gpr_atm_full_fetch_add(&lock->state, -STATE_UNORPHANED);
+  gpr_atm old_state = gpr_atm_full_fetch_add(&lock->state.counter, -STATE_UNORPHANED);
   GRPC_COMBINER_TRACE(gpr_log(
       GPR_DEBUG, "C:%p really_destroy old_state=%" PRIdPTR, lock, old_state));
   if (old_state == 1) {
@@ -191,6 +214,7 @@ grpc_combiner *grpc_combiner_ref(grpc_combiner *lock GRPC_COMBINER_DEBUG_ARGS) {
 static void push_last_on_exec_ctx(grpc_exec_ctx *exec_ctx,
                                   grpc_combiner *lock) {
   lock->next_combiner_on_this_exec_ctx = NULL;
+  lock->elems_this_acquisition = 0;
   if (exec_ctx->active_combiner == NULL) {
     exec_ctx->active_combiner = exec_ctx->last_combiner = lock;
   } else {
@@ -212,16 +236,18 @@ static void combiner_exec(grpc_exec_ctx *exec_ctx, grpc_combiner *lock,
                           grpc_closure *cl, grpc_error *error,
                           bool covered_by_poller) {
   GPR_TIMER_BEGIN("combiner.execute", 0);
-  gpr_atm last = gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS);
+  gpr_atm last = gpr_atm_full_fetch_add(&lock->state.counter, STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(gpr_log(
       GPR_DEBUG, "C:%p grpc_combiner_execute c=%p cov=%d last=%" PRIdPTR, lock,
       cl, covered_by_poller, last));
   GPR_ASSERT(last & STATE_UNORPHANED);  // ensure lock has not been destroyed
   assert(cl->cb);
+  gpr_atm_no_barrier_fetch_add(&lock->items_scheduled, 1);
   cl->error_data.scratch =
       pack_error_data((error_data){error, covered_by_poller});
   if (covered_by_poller) {
-    gpr_atm_no_barrier_fetch_add(&lock->elements_covered_by_poller, 1);
+    gpr_atm_no_barrier_fetch_add(&lock->elements_covered_by_poller.counter, 1);
   }
   gpr_mpscq_push(&lock->queue, &cl->next_data.atm_next);
   if (last == 1) {
@@ -299,16 +325,38 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
     return true;
   }
 
+  if (lock->elems_this_acquisition >= COMBINER_RUN_QUANTUM &&
+      lock->optional_workqueue != NULL && is_covered_by_poller(lock)) {
+    // This combiner has used up its run quantum on this thread; hand the
+    // remaining backlog to the workqueue so other work on this poller is not
+    // starved.
+    GPR_TIMER_MARK("offload_quantum_exhausted", 0);
+    gpr_atm_no_barrier_fetch_add(&lock->quantum_offloads, 1);
+    queue_offload(exec_ctx, lock);
+    GPR_TIMER_END("combiner.continue_exec_ctx", 0);
+    return true;
+  }
+  lock->elems_this_acquisition++;
+
   if (!lock->time_to_execute_final_list ||
       // peek to see if something new has shown up, and execute that with
       // priority
-      (gpr_atm_acq_load(&lock->state) >> 1) > 1) {
-    gpr_mpscq_node *n = gpr_mpscq_pop(&lock->queue);
+      (gpr_atm_acq_load(&lock->state.counter) >> 1) > 1) {
+    // drain from the last detached batch if one remains; otherwise detach
+    // everything queued so far with one atomic exchange
+    gpr_mpscq_node *n = lock->popped;
+    if (n == NULL) {
+      n = gpr_mpscq_pop_all(&lock->queue);
+    }
+    if (n != NULL) {
+      lock->popped = (gpr_mpscq_node *)gpr_atm_no_barrier_load(&n->next);
+    }
     GRPC_COMBINER_TRACE(
         gpr_log(GPR_DEBUG, "C:%p maybe_finish_one n=%p", lock, n));
     if (n == NULL) {
-      // queue is in an inconsistent state: use this as a cue that we should
-      // go off and do something else for a while (and come back later)
+      // a producer has bumped our state but not yet pushed its node: use this
+      // as a cue that we should go off and do something else for a while (and
+      // come back later)
       GPR_TIMER_MARK("delay_busy", 0);
       if (lock->optional_workqueue != NULL && is_covered_by_poller(lock)) {
         queue_offload(exec_ctx, lock);
@@ -324,7 +372,7 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
 #endif
     cl->cb(exec_ctx, cl->cb_arg, err.error);
     if (err.covered_by_poller) {
-      gpr_atm_no_barrier_fetch_add(&lock->elements_covered_by_poller, -1);
+      gpr_atm_no_barrier_fetch_add(&lock->elements_covered_by_poller.counter, -1);
     }
     GRPC_ERROR_UNREF(err.error);
     GPR_TIMER_END("combiner.exec1", 0);
@@ -354,7 +402,7 @@ bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx) {
   move_next(exec_ctx);
   lock->time_to_execute_final_list = false;
   gpr_atm old_state =
-      gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
+      gpr_atm_full_fetch_add(&lock->state.counter, -STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(
       gpr_log(GPR_DEBUG, "C:%p finish old_state=%" PRIdPTR, lock, old_state));
 // Define a macro to ease readability of the following switch statement.
@@ -417,7 +465,7 @@ static void combiner_execute_finally(grpc_exec_ctx *exec_ctx,
   }
 
   if (grpc_closure_list_empty(lock->final_list)) {
-    gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
+    gpr_atm_full_fetch_add(&lock->state.counter, STATE_ELEM_COUNT_LOW_BIT);
   }
   if (covered_by_poller) {
     lock->final_list_covered_by_poller = true;
@@ -447,6 +495,14 @@ static void combiner_finally_exec_covered(grpc_exec_ctx *exec_ctx,
       cl, error, true);
 }
 
+gpr_atm grpc_combiner_items_scheduled(grpc_combiner *lock) {
+  return gpr_atm_no_barrier_load(&lock->items_scheduled);
+}
+
+gpr_atm grpc_combiner_quantum_offloads(grpc_combiner *lock) {
+  return gpr_atm_no_barrier_load(&lock->quantum_offloads);
+}
+
 grpc_closure_scheduler *grpc_combiner_scheduler(grpc_combiner *combiner,
                                                 bool covered_by_poller) {
   return covered_by_poller ? &combiner->covered_scheduler
@@ -79,6 +79,12 @@ grpc_closure_scheduler *grpc_combiner_finally_scheduler(grpc_combiner *lock,
 
 bool grpc_combiner_continue_exec_ctx(grpc_exec_ctx *exec_ctx);
 
+// Contention visibility: total closures ever scheduled on this combiner, and
+// the number of times it exhausted its run quantum and rescheduled itself to
+// avoid starving its poller thread.
+gpr_atm grpc_combiner_items_scheduled(grpc_combiner *lock);
+gpr_atm grpc_combiner_quantum_offloads(grpc_combiner *lock);
+
 extern grpc_tracer_flag grpc_combiner_trace;
 
 #endif /* GRPC_CORE_LIB_IOMGR_COMBINER_H */
@@ -48,6 +48,7 @@
 #include "src/core/lib/iomgr/error_internal.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/string.h"
 
 static const char *error_int_name(grpc_error_ints key) {
   switch (key) {
@@ -130,8 +131,9 @@ static const char *error_time_name(grpc_error_times key) {
 }
 
 bool grpc_error_is_special(grpc_error *err) {
-  return err == GRPC_ERROR_NONE || err == GRPC_ERROR_OOM ||
-         err == GRPC_ERROR_CANCELLED;
+  /* the special errors occupy the lowest (even) pointer values; see the
+     definitions in error.h */
+  return (uintptr_t)err <= (uintptr_t)GRPC_ERROR_RESOURCE_EXHAUSTED;
 }
 
 #ifdef GRPC_ERROR_REFCOUNT_DEBUG
@@ -265,24 +267,6 @@ static void internal_set_str(grpc_error **err, grpc_error_strs which,
   memcpy((*err)->arena + slot, &value, sizeof(value));
 }
 
-static char *fmt_time(gpr_timespec tm);
-static void internal_set_time(grpc_error **err, grpc_error_times which,
-                              gpr_timespec value) {
-  uint8_t slot = (*err)->times[which];
-  if (slot == UINT8_MAX) {
-    slot = get_placement(err, sizeof(value));
-    if (slot == UINT8_MAX) {
-      const char *time_str = fmt_time(value);
-      gpr_log(GPR_ERROR, "Error %p is full, dropping \"%s\":\"%s\"}", *err,
-              error_time_name(which), time_str);
-      gpr_free((void *)time_str);
-      return;
-    }
-  }
-  (*err)->times[which] = slot;
-  memcpy((*err)->arena + slot, &value, sizeof(value));
-}
-
 static void internal_add_error(grpc_error **err, grpc_error *new) {
   grpc_linked_error new_last = {new, UINT8_MAX};
   uint8_t slot = get_placement(err, sizeof(grpc_linked_error));
@@ -311,10 +295,9 @@ static void internal_add_error(grpc_error **err, grpc_error *new) {
 #define SLOTS_PER_TIME (sizeof(gpr_timespec) / sizeof(intptr_t))
 #define SLOTS_PER_LINKED_ERROR (sizeof(grpc_linked_error) / sizeof(intptr_t))
 
-// size of storing one int and two slices and a timespec. For line, desc, file,
-// and time created
-#define DEFAULT_ERROR_CAPACITY \
-  (SLOTS_PER_INT + (SLOTS_PER_STR * 2) + SLOTS_PER_TIME)
+// size of storing one slice: only the description lands in the arena at
+// creation; file, line and creation time live in the fixed inline footprint
+#define DEFAULT_ERROR_CAPACITY SLOTS_PER_STR
 
 // It is very common to include and extra int and string in an error
 #define SURPLUS_CAPACITY (2 * SLOTS_PER_INT + SLOTS_PER_TIME)
@@ -344,9 +327,10 @@ grpc_error *grpc_error_create(const char *file, int line, grpc_slice desc,
   memset(err->strs, UINT8_MAX, GRPC_ERROR_STR_MAX);
   memset(err->times, UINT8_MAX, GRPC_ERROR_TIME_MAX);
 
-  internal_set_int(&err, GRPC_ERROR_INT_FILE_LINE, line);
-  internal_set_str(&err, GRPC_ERROR_STR_FILE,
-                   grpc_slice_from_static_string(file));
+  err->file = file;
+  err->line = line;
+  err->time_created = gpr_now(GPR_CLOCK_REALTIME);
+
   internal_set_str(&err, GRPC_ERROR_STR_DESCRIPTION, desc);
 
   for (size_t i = 0; i < num_referencing; ++i) {
@@ -357,8 +341,6 @@ grpc_error *grpc_error_create(const char *file, int line, grpc_slice desc,
             referencing[i]));  // TODO(ncteisen), change ownership semantics
   }
 
-  internal_set_time(&err, GRPC_ERROR_TIME_CREATED, gpr_now(GPR_CLOCK_REALTIME));
-
   gpr_atm_no_barrier_store(&err->atomics.error_string, 0);
   gpr_ref_init(&err->atomics.refs, 1);
   GPR_TIMER_END("grpc_error_create", 0);
@@ -399,6 +381,21 @@ static grpc_error *copy_error_and_unref(grpc_error *in) {
       internal_set_str(&out, GRPC_ERROR_STR_DESCRIPTION,
                        grpc_slice_from_static_string("cancelled"));
       internal_set_int(&out, GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED);
+    } else if (in == GRPC_ERROR_DEADLINE_EXCEEDED) {
+      internal_set_str(&out, GRPC_ERROR_STR_DESCRIPTION,
+                       grpc_slice_from_static_string("deadline exceeded"));
+      internal_set_int(&out, GRPC_ERROR_INT_GRPC_STATUS,
+                       GRPC_STATUS_DEADLINE_EXCEEDED);
+    } else if (in == GRPC_ERROR_UNAVAILABLE) {
+      internal_set_str(&out, GRPC_ERROR_STR_DESCRIPTION,
+                       grpc_slice_from_static_string("unavailable"));
+      internal_set_int(&out, GRPC_ERROR_INT_GRPC_STATUS,
+                       GRPC_STATUS_UNAVAILABLE);
+    } else if (in == GRPC_ERROR_RESOURCE_EXHAUSTED) {
+      internal_set_str(&out, GRPC_ERROR_STR_DESCRIPTION,
+                       grpc_slice_from_static_string("resource exhausted"));
+      internal_set_int(&out, GRPC_ERROR_INT_GRPC_STATUS,
+                       GRPC_STATUS_RESOURCE_EXHAUSTED);
     }
   } else if (gpr_ref_is_unique(&in->atomics.refs)) {
     out = in;
@@ -447,6 +444,11 @@ static special_error_status_map error_status_map[] = {
     {GRPC_ERROR_NONE, GRPC_STATUS_OK, ""},
     {GRPC_ERROR_CANCELLED, GRPC_STATUS_CANCELLED, "Cancelled"},
     {GRPC_ERROR_OOM, GRPC_STATUS_RESOURCE_EXHAUSTED, "Out of memory"},
+    {GRPC_ERROR_DEADLINE_EXCEEDED, GRPC_STATUS_DEADLINE_EXCEEDED,
+     "Deadline Exceeded"},
+    {GRPC_ERROR_UNAVAILABLE, GRPC_STATUS_UNAVAILABLE, "Unavailable"},
+    {GRPC_ERROR_RESOURCE_EXHAUSTED, GRPC_STATUS_RESOURCE_EXHAUSTED,
+     "Resource exhausted"},
 };
 
 bool grpc_error_get_int(grpc_error *err, grpc_error_ints which, intptr_t *p) {
@@ -470,6 +472,12 @@ bool grpc_error_get_int(grpc_error *err, grpc_error_ints which, intptr_t *p) {
     GPR_TIMER_END("grpc_error_get_int", 0);
     return true;
   }
+  if (which == GRPC_ERROR_INT_FILE_LINE) {
+    // captured inline at creation; never materialized unless overwritten
+    if (p != NULL) *p = err->line;
+    GPR_TIMER_END("grpc_error_get_int", 0);
+    return true;
+  }
   GPR_TIMER_END("grpc_error_get_int", 0);
   return false;
 }
@@ -500,9 +508,13 @@ bool grpc_error_get_str(grpc_error *err, grpc_error_strs which,
   if (slot != UINT8_MAX) {
     *str = *(grpc_slice *)(err->arena + slot);
     return true;
-  } else {
-    return false;
   }
+  if (which == GRPC_ERROR_STR_FILE) {
+    // captured inline at creation; never materialized unless overwritten
+    *str = grpc_slice_from_static_string(err->file);
+    return true;
+  }
+  return false;
 }
 
 grpc_error *grpc_error_add_child(grpc_error *src, grpc_error *child) {
@@ -516,6 +528,9 @@ grpc_error *grpc_error_add_child(grpc_error *src, grpc_error *child) {
 static const char *no_error_string = "\"No Error\"";
 static const char *oom_error_string = "\"Out of memory\"";
 static const char *cancelled_error_string = "\"Cancelled\"";
+static const char *deadline_exceeded_error_string = "\"Deadline Exceeded\"";
+static const char *unavailable_error_string = "\"Unavailable\"";
+static const char *resource_exhausted_error_string = "\"Resource exhausted\"";
 
 typedef struct {
   char *key;
@@ -595,9 +610,11 @@ static char *key_int(grpc_error_ints which) {
 }
 
 static char *fmt_int(intptr_t p) {
-  char *s;
-  gpr_asprintf(&s, "%" PRIdPTR, p);
-  return s;
+  char backing[3 * sizeof(intptr_t)];
+  gpr_strbuf sb;
+  gpr_strbuf_init(&sb, backing, sizeof(backing));
+  gpr_strbuf_printf(&sb, "%" PRIdPTR, p);
+  return gpr_strbuf_take(&sb);
 }
 
 static void collect_ints_kvs(grpc_error *err, kv_pairs *kvs) {
@@ -639,7 +656,8 @@ static char *key_time(grpc_error_times which) {
 }
 
 static char *fmt_time(gpr_timespec tm) {
-  char *out;
+  char backing[64];
+  gpr_strbuf sb;
   char *pfx = "!!";
   switch (tm.clock_type) {
     case GPR_CLOCK_MONOTONIC:
@@ -655,8 +673,9 @@ static char *fmt_time(gpr_timespec tm) {
       pfx = "";
       break;
   }
-  gpr_asprintf(&out, "\"%s%" PRId64 ".%09d\"", pfx, tm.tv_sec, tm.tv_nsec);
-  return out;
+  gpr_strbuf_init(&sb, backing, sizeof(backing));
+  gpr_strbuf_printf(&sb, "\"%s%" PRId64 ".%09d\"", pfx, tm.tv_sec, tm.tv_nsec);
+  return gpr_strbuf_take(&sb);
 }
 
 static void collect_times_kvs(grpc_error *err, kv_pairs *kvs) {
@@ -728,6 +747,13 @@ const char *grpc_error_string(grpc_error *err) {
   if (err == GRPC_ERROR_NONE) return no_error_string;
   if (err == GRPC_ERROR_OOM) return oom_error_string;
   if (err == GRPC_ERROR_CANCELLED) return cancelled_error_string;
+  if (err == GRPC_ERROR_DEADLINE_EXCEEDED) {
+    return deadline_exceeded_error_string;
+  }
+  if (err == GRPC_ERROR_UNAVAILABLE) return unavailable_error_string;
+  if (err == GRPC_ERROR_RESOURCE_EXHAUSTED) {
+    return resource_exhausted_error_string;
+  }
 
   void *p = (void *)gpr_atm_acq_load(&err->atomics.error_string);
   if (p != NULL) {
@@ -741,6 +767,19 @@ const char *grpc_error_string(grpc_error *err) {
   collect_ints_kvs(err, &kvs);
   collect_strs_kvs(err, &kvs);
   collect_times_kvs(err, &kvs);
+  // the inline-captured creation attributes render exactly as if they had
+  // been stored in the arena, unless an arena slot has overwritten them
+  if (err->ints[GRPC_ERROR_INT_FILE_LINE] == UINT8_MAX) {
+    append_kv(&kvs, key_int(GRPC_ERROR_INT_FILE_LINE), fmt_int(err->line));
+  }
+  if (err->strs[GRPC_ERROR_STR_FILE] == UINT8_MAX) {
+    append_kv(&kvs, key_str(GRPC_ERROR_STR_FILE),
+              fmt_str(grpc_slice_from_static_string(err->file)));
+  }
+  if (err->times[GRPC_ERROR_TIME_CREATED] == UINT8_MAX) {
+    append_kv(&kvs, key_time(GRPC_ERROR_TIME_CREATED),
+              fmt_time(err->time_created));
+  }
   if (err->first_err != UINT8_MAX) {
     append_kv(&kvs, gpr_strdup("referenced_errors"), errs_string(err));
   }
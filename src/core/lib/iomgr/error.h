@@ -134,6 +134,13 @@ typedef enum {
 #define GRPC_ERROR_NONE ((grpc_error *)NULL)
 #define GRPC_ERROR_OOM ((grpc_error *)2)
 #define GRPC_ERROR_CANCELLED ((grpc_error *)4)
+/// Singletons for common terminal call failures. Each carries a fixed
+/// (grpc-status, message) pair, so converting one to a call status requires
+/// no attribute lookup. Prefer these over allocating an error whenever no
+/// per-failure detail needs to be attached.
+#define GRPC_ERROR_DEADLINE_EXCEEDED ((grpc_error *)6)
+#define GRPC_ERROR_UNAVAILABLE ((grpc_error *)8)
+#define GRPC_ERROR_RESOURCE_EXHAUSTED ((grpc_error *)10)
 
 const char *grpc_error_string(grpc_error *error);
 
@@ -55,6 +55,13 @@ struct grpc_error {
     gpr_refcount refs;
     gpr_atm error_string;
   } atomics;
+  // Call site and creation time, captured into this fixed footprint at
+  // creation and only materialized into arena slots if somebody overwrites
+  // them: most errors are consumed as a boolean and die without ever being
+  // rendered, so they never pay for the three arena writes.
+  const char *file;
+  int line;
+  gpr_timespec time_created;
   // These arrays index into dynamic arena at the bottom of the struct.
   // UINT8_MAX is used as a sentinel value.
   uint8_t ints[GRPC_ERROR_INT_MAX];
@@ -58,6 +58,7 @@
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
+#include "src/core/lib/support/spinlock.h"
 #include "src/core/lib/iomgr/workqueue.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/support/block_annotate.h"
@@ -65,6 +66,44 @@
 static grpc_wakeup_fd global_wakeup_fd;
 static int g_epfd;
 
+/* High-priority polling tier: fds marked via fd_set_priority() live in this
+   second epoll set instead of g_epfd. g_priority_epfd itself is registered in
+   g_epfd level-triggered, so pending priority events keep the main wait
+   readable; the designated poller drains the priority set ahead of every
+   batch of ordinary events (see process_epoll_events). g_priority_fd_count
+   gates the extra epoll_wait syscall so the common no-priority-fds case pays
+   nothing. */
+static int g_priority_epfd;
+static gpr_atm g_priority_fd_count;
+
+/* Busy-poll spin tier: fds given a budget via fd_set_busy_poll() let the
+   designated poller spin (non-blocking epoll_waits) for a bounded time
+   before committing to a blocking wait. g_busy_poll_fd_count gates the spin
+   so unflagged workloads pay nothing; g_busy_poll_max_usec is the largest
+   budget any live flagged fd asked for and caps the spin. It is only ever
+   raised - a stale high cap after flagged fds churn merely costs spin time
+   while other flagged fds remain, and clears with the engine. */
+static gpr_atm g_busy_poll_fd_count;
+static gpr_atm g_busy_poll_max_usec;
+
+/* Kick coalescing: a cross-thread kick of the designated poller only needs an
+   eventfd write if one is not already in flight. g_wakeup_fd_pending tracks
+   that in-flight state; the elided/delivered counters quantify how many
+   syscalls coalescing saves (reported under the 'polling' tracer at engine
+   shutdown). */
+static gpr_atm g_wakeup_fd_pending;
+static gpr_atm g_kicks_delivered;
+static gpr_atm g_kicks_elided;
+
+static grpc_error *wakeup_fd_kick(void) {
+  if (!gpr_atm_full_cas(&g_wakeup_fd_pending, 0, 1)) {
+    gpr_atm_no_barrier_fetch_add(&g_kicks_elided, 1);
+    return GRPC_ERROR_NONE;
+  }
+  gpr_atm_no_barrier_fetch_add(&g_kicks_delivered, 1);
+  return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+}
+
 /*******************************************************************************
  * Fd Declarations
  */
@@ -77,6 +116,14 @@ struct grpc_fd {
 
   struct grpc_fd *freelist_next;
 
+  /* True while the fd is registered in g_priority_epfd rather than g_epfd.
+     Only mutated by fd_set_priority(). */
+  bool high_priority;
+
+  /* Microseconds of poller spin this fd is worth before a blocking wait;
+     0 means unflagged. Only mutated by fd_set_busy_poll(). */
+  int busy_poll_usec;
+
   /* The pollset that last noticed that the fd is readable. The actual type
    * stored in this is (grpc_pollset *) */
   gpr_atm read_notifier_pollset;
@@ -168,31 +215,63 @@ static bool append_error(grpc_error **composite, grpc_error *error,
  * alarm 'epoch'). This wakeup_fd gives us something to alert on when such a
  * case occurs. */
 
-static grpc_fd *fd_freelist = NULL;
-static gpr_mu fd_freelist_mu;
+/* The freelist is sharded by CPU: at high accept/close rates a single
+   mutex-protected list is a contention point, and LIFO reuse within the CPU
+   that just closed a connection hands back an object whose cachelines are
+   still warm. Objects stay type-stable for the lifetime of the engine (see
+   above), just as with the single list. */
+typedef struct {
+  gpr_spinlock mu;
+  grpc_fd *freelist;
+  GPR_CACHELINE_PAD(0);
+} fd_freelist_shard;
 
-static void fd_global_init(void) { gpr_mu_init(&fd_freelist_mu); }
+#define MAX_FD_FREELIST_SHARDS 32
+
+static fd_freelist_shard *g_fd_freelist_shards;
+static size_t g_fd_freelist_nshards;
+
+static fd_freelist_shard *fd_freelist_for_this_cpu(void) {
+  return &g_fd_freelist_shards[gpr_cpu_current_cpu() % g_fd_freelist_nshards];
+}
+
+static void fd_global_init(void) {
+  g_fd_freelist_nshards =
+      GPR_MIN(GPR_MAX(1, gpr_cpu_num_cores()), MAX_FD_FREELIST_SHARDS);
+  g_fd_freelist_shards =
+      gpr_malloc_aligned(sizeof(fd_freelist_shard) * g_fd_freelist_nshards,
+                         GPR_CACHELINE_SIZE_LOG);
+  for (size_t i = 0; i < g_fd_freelist_nshards; i++) {
+    g_fd_freelist_shards[i].mu = GPR_SPINLOCK_INITIALIZER;
+    g_fd_freelist_shards[i].freelist = NULL;
+  }
+}
 
 static void fd_global_shutdown(void) {
-  gpr_mu_lock(&fd_freelist_mu);
-  gpr_mu_unlock(&fd_freelist_mu);
-  while (fd_freelist != NULL) {
-    grpc_fd *fd = fd_freelist;
-    fd_freelist = fd_freelist->freelist_next;
-    gpr_free(fd);
+  for (size_t i = 0; i < g_fd_freelist_nshards; i++) {
+    fd_freelist_shard *shard = &g_fd_freelist_shards[i];
+    gpr_spinlock_lock(&shard->mu);
+    gpr_spinlock_unlock(&shard->mu);
+    while (shard->freelist != NULL) {
+      grpc_fd *fd = shard->freelist;
+      shard->freelist = fd->freelist_next;
+      gpr_free(fd);
+    }
   }
-  gpr_mu_destroy(&fd_freelist_mu);
+  gpr_free_aligned(g_fd_freelist_shards);
+  g_fd_freelist_shards = NULL;
 }
 
 static grpc_fd *fd_create(int fd, const char *name) {
   grpc_fd *new_fd = NULL;
 
-  gpr_mu_lock(&fd_freelist_mu);
-  if (fd_freelist != NULL) {
-    new_fd = fd_freelist;
-    fd_freelist = fd_freelist->freelist_next;
+  fd_freelist_shard *shard = fd_freelist_for_this_cpu();
+  gpr_spinlock_lock(&shard->mu);
+  if (shard->freelist != NULL) {
+    new_fd = shard->freelist;
+    shard->freelist = new_fd->freelist_next;
   }
-  gpr_mu_unlock(&fd_freelist_mu);
+  gpr_spinlock_unlock(&shard->mu);
 
   if (new_fd == NULL) {
     new_fd = gpr_malloc(sizeof(grpc_fd));
@@ -204,6 +283,8 @@ static grpc_fd *fd_create(int fd, const char *name) {
   gpr_atm_no_barrier_store(&new_fd->read_notifier_pollset, (gpr_atm)NULL);
 
   new_fd->freelist_next = NULL;
+  new_fd->high_priority = false;
+  new_fd->busy_poll_usec = 0;
 
   char *fd_name;
   gpr_asprintf(&fd_name, "%s fd=%d", name, fd);
@@ -257,10 +338,21 @@ static void fd_orphan(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
   grpc_lfev_destroy(&fd->read_closure);
   grpc_lfev_destroy(&fd->write_closure);
 
-  gpr_mu_lock(&fd_freelist_mu);
-  fd->freelist_next = fd_freelist;
-  fd_freelist = fd;
-  gpr_mu_unlock(&fd_freelist_mu);
+  if (fd->high_priority) {
+    fd->high_priority = false;
+    gpr_atm_no_barrier_fetch_add(&g_priority_fd_count, -1);
+  }
+
+  if (fd->busy_poll_usec > 0) {
+    fd->busy_poll_usec = 0;
+    gpr_atm_no_barrier_fetch_add(&g_busy_poll_fd_count, -1);
+  }
+
+  fd_freelist_shard *shard = fd_freelist_for_this_cpu();
+  gpr_spinlock_lock(&shard->mu);
+  fd->freelist_next = shard->freelist;
+  shard->freelist = fd;
+  gpr_spinlock_unlock(&shard->mu);
 }
 
 static grpc_pollset *fd_get_read_notifier_pollset(grpc_exec_ctx *exec_ctx,
@@ -287,6 +379,43 @@ static grpc_workqueue *fd_get_workqueue(grpc_fd *fd) {
   return (grpc_workqueue *)0xb0b51ed;
 }
 
+static void fd_set_priority(grpc_fd *fd, bool high_priority) {
+  if (fd->high_priority == high_priority) return;
+  int from_epfd = high_priority ? g_epfd : g_priority_epfd;
+  int to_epfd = high_priority ? g_priority_epfd : g_epfd;
+  struct epoll_event ev = {.events = (uint32_t)(EPOLLIN | EPOLLOUT | EPOLLET),
+                           .data.ptr = fd};
+  if (epoll_ctl(from_epfd, EPOLL_CTL_DEL, fd->fd, NULL) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    return;
+  }
+  /* EPOLL_CTL_ADD reports the current readiness level even under
+     EPOLLET, so an edge that fired between the DEL and the ADD is
+     re-observed rather than lost. */
+  if (epoll_ctl(to_epfd, EPOLL_CTL_ADD, fd->fd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
+    return;
+  }
+  fd->high_priority = high_priority;
+  gpr_atm_no_barrier_fetch_add(&g_priority_fd_count, high_priority ? 1 : -1);
+}
+
+static void fd_set_busy_poll(grpc_fd *fd, int usec) {
+  if (usec < 0) usec = 0;
+  if ((fd->busy_poll_usec > 0) != (usec > 0)) {
+    gpr_atm_no_barrier_fetch_add(&g_busy_poll_fd_count, usec > 0 ? 1 : -1);
+  }
+  fd->busy_poll_usec = usec;
+  if (usec > 0) {
+    gpr_atm cur;
+    while ((cur = gpr_atm_no_barrier_load(&g_busy_poll_max_usec)) <
+               (gpr_atm)usec &&
+           !gpr_atm_no_barrier_cas(&g_busy_poll_max_usec, cur,
+                                   (gpr_atm)usec)) {
+    }
+  }
+}
+
 static void fd_become_readable(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
                                grpc_pollset *notifier) {
   grpc_lfev_set_ready(exec_ctx, &fd->read_closure);
@@ -371,6 +500,14 @@ static grpc_error *pollset_global_init(void) {
   if (epoll_ctl(g_epfd, EPOLL_CTL_ADD, global_wakeup_fd.read_fd, &ev) != 0) {
     return GRPC_OS_ERROR(errno, "epoll_ctl");
   }
+  /* Nest the priority epoll set inside the main one, level-triggered: while
+     any priority event is pending, g_epfd stays readable so a blocked
+     designated poller wakes promptly. */
+  struct epoll_event priority_ev = {.events = (uint32_t)(EPOLLIN),
+                                    .data.ptr = &g_priority_epfd};
+  if (epoll_ctl(g_epfd, EPOLL_CTL_ADD, g_priority_epfd, &priority_ev) != 0) {
+    return GRPC_OS_ERROR(errno, "epoll_ctl");
+  }
   g_num_neighbourhoods = GPR_CLAMP(gpr_cpu_num_cores(), 1, MAX_NEIGHBOURHOODS);
   g_neighbourhoods =
       gpr_zalloc(sizeof(*g_neighbourhoods) * g_num_neighbourhoods);
@@ -464,6 +601,18 @@ static void pollset_shutdown(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
 }
 
 #define MAX_EPOLL_EVENTS 100
+#define MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION 16
+
+/* The designated poller drains epoll_wait results into this flat array in one
+   shot; workers then consume them in bounded batches. Only one thread calls
+   epoll_wait at any time (the designated poller), so the array itself needs no
+   locking - the cursor/num_events pair hands leftover events from one
+   pollset_work iteration to the next. Scheduling the ready closures from a
+   tight loop appends them contiguously onto the exec_ctx closure list instead
+   of interleaving list links with epoll bookkeeping. */
+static struct epoll_event g_epoll_events[MAX_EPOLL_EVENTS];
+static gpr_atm g_epoll_event_cursor;
+static gpr_atm g_epoll_num_events;
 
 static int poll_deadline_to_millis_timeout(gpr_timespec deadline,
                                            gpr_timespec now) {
@@ -483,50 +632,176 @@ static int poll_deadline_to_millis_timeout(gpr_timespec deadline,
   return millis >= 1 ? millis : 1;
 }
 
-static grpc_error *pollset_epoll(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
-                                 gpr_timespec now, gpr_timespec deadline) {
-  struct epoll_event events[MAX_EPOLL_EVENTS];
-  static const char *err_desc = "pollset_poll";
-
-  int timeout = poll_deadline_to_millis_timeout(deadline, now);
-
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+/* Process the epoll events found by do_epoll_wait() function.
+   - g_epoll_events contains the epoll events that were found (and waiting to
+     be processed) by the last call to do_epoll_wait()
+   - At most MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION events are processed per
+     call so that a burst of ready fds cannot starve the worker of its own
+     closure list; leftover events are picked up by the next iteration. */
+/* At most this many priority events are handled per drain; a misbehaving
+   priority fd therefore cannot monopolize the poller either. */
+#define MAX_PRIORITY_EPOLL_EVENTS 16
+
+static void handle_epoll_event(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
+                               struct epoll_event *ev) {
+  grpc_fd *fd = (grpc_fd *)(ev->data.ptr);
+  bool cancel = (ev->events & (EPOLLERR | EPOLLHUP)) != 0;
+  bool read_ev = (ev->events & (EPOLLIN | EPOLLPRI)) != 0;
+  bool write_ev = (ev->events & EPOLLOUT) != 0;
+
+  if (read_ev || cancel) {
+    fd_become_readable(exec_ctx, fd, pollset);
+  }
+  if (write_ev || cancel) {
+    fd_become_writable(exec_ctx, fd);
   }
+}
+
+/* Drain pending events from the priority epoll set. Called ahead of each
+   batch of ordinary events, so a priority fd waits behind at most
+   MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION bulk events. Only the designated
+   poller calls this (same exclusivity as do_epoll_wait). */
+static grpc_error *drain_priority_events(grpc_exec_ctx *exec_ctx,
+                                         grpc_pollset *pollset) {
+  struct epoll_event events[MAX_PRIORITY_EPOLL_EVENTS];
   int r;
   do {
-    r = epoll_wait(g_epfd, events, MAX_EPOLL_EVENTS, timeout);
+    r = epoll_wait(g_priority_epfd, events, MAX_PRIORITY_EPOLL_EVENTS, 0);
   } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
-  }
-
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
+  for (int i = 0; i < r; i++) {
+    handle_epoll_event(exec_ctx, pollset, &events[i]);
+  }
+  return GRPC_ERROR_NONE;
+}
 
+static grpc_error *process_epoll_events(grpc_exec_ctx *exec_ctx,
+                                        grpc_pollset *pollset) {
+  static const char *err_desc = "process_events";
   grpc_error *error = GRPC_ERROR_NONE;
-  for (int i = 0; i < r; i++) {
-    void *data_ptr = events[i].data.ptr;
+
+  if (gpr_atm_acq_load(&g_priority_fd_count) > 0) {
+    append_error(&error, drain_priority_events(exec_ctx, pollset), err_desc);
+  }
+
+  long num_events = (long)gpr_atm_acq_load(&g_epoll_num_events);
+  long cursor = (long)gpr_atm_acq_load(&g_epoll_event_cursor);
+  for (int idx = 0;
+       (idx < MAX_EPOLL_EVENTS_HANDLED_PER_ITERATION) && cursor != num_events;
+       idx++) {
+    long c = cursor++;
+    struct epoll_event *ev = &g_epoll_events[c];
+    void *data_ptr = ev->data.ptr;
+
     if (data_ptr == &global_wakeup_fd) {
       gpr_mu_lock(&g_wq_mu);
       grpc_closure_list_move(&g_wq_items, &exec_ctx->closure_list);
       gpr_mu_unlock(&g_wq_mu);
+      /* allow the next kick to write the eventfd again before consuming, so a
+         kick raced against this consume is never lost */
+      gpr_atm_rel_store(&g_wakeup_fd_pending, 0);
       append_error(&error, grpc_wakeup_fd_consume_wakeup(&global_wakeup_fd),
                    err_desc);
+    } else if (data_ptr == &g_priority_epfd) {
+      /* the priority set was already drained on entry; being level-triggered
+         it stays readable while events remain pending, so anything that
+         arrived since is picked up on the next iteration */
     } else {
-      grpc_fd *fd = (grpc_fd *)(data_ptr);
-      bool cancel = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
-      bool read_ev = (events[i].events & (EPOLLIN | EPOLLPRI)) != 0;
-      bool write_ev = (events[i].events & EPOLLOUT) != 0;
-      if (read_ev || cancel) {
-        fd_become_readable(exec_ctx, fd, pollset);
-      }
-      if (write_ev || cancel) {
-        fd_become_writable(exec_ctx, fd);
+      handle_epoll_event(exec_ctx, pollset, ev);
+    }
+  }
+  gpr_atm_rel_store(&g_epoll_event_cursor, (gpr_atm)cursor);
+  return error;
+}
+
+/* Inter-arrival EWMA for the busy-poll spin decision. Only the designated
+   poller reads or writes these, so plain statics suffice. Samples are capped
+   so one long idle gap does not take many events to forget. */
+#define BUSY_POLL_EWMA_SAMPLE_CAP_USEC (1000 * 1000)
+
+static int64_t g_spin_ewma_usec;
+static gpr_timespec g_spin_last_event;
+static bool g_spin_last_event_valid;
+
+static void busy_poll_observe_events(gpr_timespec now) {
+  if (g_spin_last_event_valid) {
+    gpr_timespec delta = gpr_time_sub(now, g_spin_last_event);
+    int64_t usec = delta.tv_sec * 1000000 + delta.tv_nsec / 1000;
+    if (usec > BUSY_POLL_EWMA_SAMPLE_CAP_USEC) {
+      usec = BUSY_POLL_EWMA_SAMPLE_CAP_USEC;
+    }
+    g_spin_ewma_usec += (usec - g_spin_ewma_usec) / 8;
+  }
+  g_spin_last_event = now;
+  g_spin_last_event_valid = true;
+}
+
+/* How long the designated poller should spin before blocking: the largest
+   budget any flagged fd asked for, or 0 when there are no flagged fds or
+   recent inter-arrival times say a spin of that length would almost
+   certainly come up empty. */
+static int busy_poll_spin_usec(void) {
+  if (gpr_atm_no_barrier_load(&g_busy_poll_fd_count) == 0) return 0;
+  int cap = (int)gpr_atm_no_barrier_load(&g_busy_poll_max_usec);
+  if (g_spin_ewma_usec > 8 * (int64_t)cap) return 0;
+  return cap;
+}
+
+/* Do epoll_wait and store the events in g_epoll_events. The caller must be
+   the designated poller, which guarantees no concurrent epoll_wait and hence
+   exclusive write access to the event array. */
+static grpc_error *do_epoll_wait(grpc_exec_ctx *exec_ctx, gpr_timespec now,
+                                 gpr_timespec deadline) {
+  int timeout = poll_deadline_to_millis_timeout(deadline, now);
+  int r = 0;
+
+  int spin_usec = timeout != 0 ? busy_poll_spin_usec() : 0;
+  if (spin_usec > 0) {
+    /* Spin-then-block: repeat non-blocking waits for up to spin_usec before
+       committing to a blocking one, so events arriving within the spin
+       window skip the sleep/wakeup round trip entirely. */
+    gpr_timespec spin_deadline = gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_micros(spin_usec, GPR_TIMESPAN));
+    if (gpr_time_cmp(spin_deadline, deadline) > 0) spin_deadline = deadline;
+    for (;;) {
+      do {
+        r = epoll_wait(g_epfd, g_epoll_events, MAX_EPOLL_EVENTS, 0);
+      } while (r < 0 && errno == EINTR);
+      if (r != 0) break;
+      if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), spin_deadline) >= 0) {
+        break;
       }
     }
   }
 
-  return error;
+  if (r == 0) {
+    if (spin_usec > 0) {
+      /* part of the wait budget was spent spinning */
+      timeout = poll_deadline_to_millis_timeout(deadline,
+                                                gpr_now(GPR_CLOCK_MONOTONIC));
+    }
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      r = epoll_wait(g_epfd, g_epoll_events, MAX_EPOLL_EVENTS, timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
+  }
+
+  if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
+
+  if (r > 0 && gpr_atm_no_barrier_load(&g_busy_poll_fd_count) != 0) {
+    busy_poll_observe_events(gpr_now(GPR_CLOCK_MONOTONIC));
+  }
+
+  gpr_atm_rel_store(&g_epoll_num_events, (gpr_atm)r);
+  gpr_atm_rel_store(&g_epoll_event_cursor, 0);
+
+  return GRPC_ERROR_NONE;
 }
 
 static bool begin_worker(grpc_pollset *pollset, grpc_pollset_worker *worker,
@@ -732,8 +1007,15 @@ static grpc_error *pollset_work(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
     GPR_ASSERT(!pollset->shutdown_closure);
     GPR_ASSERT(!pollset->seen_inactive);
     gpr_mu_unlock(&pollset->mu);
-    append_error(&error, pollset_epoll(exec_ctx, pollset, now, deadline),
-                 err_desc);
+
+    /* Only refill the event array once the previous batch has been fully
+       consumed; otherwise keep draining what the last epoll_wait returned. */
+    if (gpr_atm_acq_load(&g_epoll_event_cursor) ==
+        gpr_atm_acq_load(&g_epoll_num_events)) {
+      append_error(&error, do_epoll_wait(exec_ctx, now, deadline), err_desc);
+    }
+    append_error(&error, process_epoll_events(exec_ctx, pollset), err_desc);
+
     gpr_mu_lock(&pollset->mu);
     gpr_tls_set(&g_current_thread_worker, 0);
   }
@@ -755,8 +1037,12 @@ static grpc_error *pollset_kick(grpc_pollset *pollset,
       if (root_worker == next_worker &&
           root_worker == (grpc_pollset_worker *)gpr_atm_no_barrier_load(
                              &g_active_poller)) {
+        if (root_worker->kick_state == KICKED) {
+          gpr_atm_no_barrier_fetch_add(&g_kicks_elided, 1);
+          return GRPC_ERROR_NONE;
+        }
         root_worker->kick_state = KICKED;
-        return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+        return wakeup_fd_kick();
       } else if (next_worker->kick_state == UNKICKED) {
         GPR_ASSERT(next_worker->initialized_cv);
         next_worker->kick_state = KICKED;
@@ -777,7 +1063,7 @@ static grpc_error *pollset_kick(grpc_pollset *pollset,
   } else if (specific_worker ==
              (grpc_pollset_worker *)gpr_atm_no_barrier_load(&g_active_poller)) {
     specific_worker->kick_state = KICKED;
-    return grpc_wakeup_fd_wakeup(&global_wakeup_fd);
+    return wakeup_fd_kick();
   } else if (specific_worker->initialized_cv) {
     specific_worker->kick_state = KICKED;
     gpr_cv_signal(&specific_worker->cv);
@@ -853,8 +1139,7 @@ static void wq_sched(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
     gpr_mu_lock(&g_wq_mu);
     grpc_closure_list_append(&g_wq_items, closure, error);
     gpr_mu_unlock(&g_wq_mu);
-    GRPC_LOG_IF_ERROR("workqueue_scheduler",
-                      grpc_wakeup_fd_wakeup(&global_wakeup_fd));
+    GRPC_LOG_IF_ERROR("workqueue_scheduler", wakeup_fd_kick());
   }
 }
 
@@ -905,6 +1190,12 @@ static void pollset_set_del_pollset_set(grpc_exec_ctx *exec_ctx,
  */
 
 static void shutdown_engine(void) {
+  if (GRPC_TRACER_ON(grpc_polling_trace)) {
+    gpr_log(GPR_INFO, "ev_epoll1 kicks: delivered=%" PRIdPTR
+                      " elided=%" PRIdPTR,
+            gpr_atm_no_barrier_load(&g_kicks_delivered),
+            gpr_atm_no_barrier_load(&g_kicks_elided));
+  }
   fd_global_shutdown();
   pollset_global_shutdown();
 }
@@ -921,6 +1212,8 @@ static const grpc_event_engine_vtable vtable = {
     .fd_notify_on_write = fd_notify_on_write,
     .fd_get_read_notifier_pollset = fd_get_read_notifier_pollset,
     .fd_get_workqueue = fd_get_workqueue,
+    .fd_set_priority = fd_set_priority,
+    .fd_set_busy_poll = fd_set_busy_poll,
 
     .pollset_init = pollset_init,
     .pollset_shutdown = pollset_shutdown,
@@ -948,9 +1241,6 @@ static const grpc_event_engine_vtable vtable = {
 /* It is possible that GLIBC has epoll but the underlying kernel doesn't.
  * Create a dummy epoll_fd to make sure epoll support is available */
 const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
-  /* TODO(ctiller): temporary, until this stabilizes */
-  if (!explicit_request) return NULL;
-
   if (!grpc_has_wakeup_fd()) {
     return NULL;
   }
@@ -961,9 +1251,22 @@ const grpc_event_engine_vtable *grpc_init_epoll1_linux(bool explicit_request) {
     return NULL;
   }
 
+  g_priority_epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (g_priority_epfd < 0) {
+    gpr_log(GPR_ERROR, "epoll unavailable");
+    close(g_epfd);
+    return NULL;
+  }
+  gpr_atm_no_barrier_store(&g_priority_fd_count, 0);
+  gpr_atm_no_barrier_store(&g_busy_poll_fd_count, 0);
+  gpr_atm_no_barrier_store(&g_busy_poll_max_usec, 0);
+  g_spin_ewma_usec = 0;
+  g_spin_last_event_valid = false;
+
   fd_global_init();
 
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
+    close(g_priority_epfd);
     close(g_epfd);
     fd_global_shutdown();
     return NULL;
@@ -75,8 +75,11 @@ typedef struct {
 
 static const event_engine_factory g_factories[] = {
     {"epollex", grpc_init_epollex_linux},
-    {"epollsig", grpc_init_epollsig_linux},
+    /* epoll1 precedes epollsig: its single process-wide epoll set makes
+       pollset/pollset_set membership changes free of per-fd syscalls, where
+       epollsig's polling-island merges re-register every fd */
     {"epoll1", grpc_init_epoll1_linux},
+    {"epollsig", grpc_init_epollsig_linux},
     {"epoll-threadpool", grpc_init_epoll_thread_pool_linux},
     {"epoll-limited", grpc_init_epoll_limited_pollers_linux},
     {"poll", grpc_init_poll_posix},
@@ -202,6 +205,18 @@ void grpc_fd_notify_on_write(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
   g_event_engine->fd_notify_on_write(exec_ctx, fd, closure);
 }
 
+void grpc_fd_set_priority(grpc_fd *fd, bool high_priority) {
+  if (g_event_engine->fd_set_priority != NULL) {
+    g_event_engine->fd_set_priority(fd, high_priority);
+  }
+}
+
+void grpc_fd_set_busy_poll(grpc_fd *fd, int usec) {
+  if (g_event_engine->fd_set_busy_poll != NULL) {
+    g_event_engine->fd_set_busy_poll(fd, usec);
+  }
+}
+
 size_t grpc_pollset_size(void) { return g_event_engine->pollset_size; }
 
 void grpc_pollset_init(grpc_pollset *pollset, gpr_mu **mu) {
@@ -220,6 +235,7 @@ void grpc_pollset_destroy(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset) {
 grpc_error *grpc_pollset_work(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
                               grpc_pollset_worker **worker, gpr_timespec now,
                               gpr_timespec deadline) {
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_WORK);
   return g_event_engine->pollset_work(exec_ctx, pollset, worker, now, deadline);
 }
 
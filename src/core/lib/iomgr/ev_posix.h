@@ -63,6 +63,12 @@ typedef struct grpc_event_engine_vtable {
   grpc_workqueue *(*fd_get_workqueue)(grpc_fd *fd);
   grpc_pollset *(*fd_get_read_notifier_pollset)(grpc_exec_ctx *exec_ctx,
                                                 grpc_fd *fd);
+  /* Optional: engines with a high-priority polling tier implement this to
+     move an fd in/out of that tier. NULL when the engine has no such tier. */
+  void (*fd_set_priority)(grpc_fd *fd, bool high_priority);
+  /* Optional: engines that can spin before blocking implement this to set
+     an fd's busy-poll budget (0 clears it). NULL when unsupported. */
+  void (*fd_set_busy_poll)(grpc_fd *fd, int usec);
 
   void (*pollset_init)(grpc_pollset *pollset, gpr_mu **mu);
   void (*pollset_shutdown)(grpc_exec_ctx *exec_ctx, grpc_pollset *pollset,
@@ -167,6 +173,16 @@ void grpc_fd_notify_on_write(grpc_exec_ctx *exec_ctx, grpc_fd *fd,
 grpc_pollset *grpc_fd_get_read_notifier_pollset(grpc_exec_ctx *exec_ctx,
                                                 grpc_fd *fd);
 
+/* Mark (or unmark) an fd as high-priority: its events are checked ahead of
+   ordinary fds on every polling iteration. A hint only - engines without a
+   priority tier ignore it. */
+void grpc_fd_set_priority(grpc_fd *fd, bool high_priority);
+
+/* Give an fd a busy-poll budget: the polling engine may spin for up to usec
+   microseconds before blocking while this (or any flagged) fd is live; 0
+   clears the budget. A hint only - engines without spin support ignore it. */
+void grpc_fd_set_busy_poll(grpc_fd *fd, int usec);
+
 /* pollset_posix functions */
 
 /* Add an fd to a pollset */
@@ -38,8 +38,10 @@
 #include <grpc/support/thd.h>
 
 #include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/workqueue.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/slice/slice_internal.h"
 
 bool grpc_exec_ctx_ready_to_finish(grpc_exec_ctx *exec_ctx) {
   if ((exec_ctx->flags & GRPC_EXEC_CTX_FLAG_IS_FINISHED) == 0) {
@@ -64,25 +66,77 @@ bool grpc_always_ready_to_finish(grpc_exec_ctx *exec_ctx, void *arg_ignored) {
 
 bool grpc_exec_ctx_has_work(grpc_exec_ctx *exec_ctx) {
   return exec_ctx->active_combiner != NULL ||
-         !grpc_closure_list_empty(exec_ctx->closure_list);
+         !grpc_closure_list_empty(exec_ctx->closure_list) ||
+         !grpc_closure_list_empty(exec_ctx->urgent_list) ||
+         !grpc_closure_list_empty(exec_ctx->bulk_list);
+}
+
+/* bulk-class closures run per grpc_exec_ctx_flush before the rest of the
+   bulk list respills to the executor */
+#define BULK_CLOSURES_PER_FLUSH 32
+
+static bool drain_list(grpc_exec_ctx *exec_ctx, grpc_closure_list *list) {
+  bool did_something = false;
+  grpc_closure *c = list->head;
+  list->head = list->tail = NULL;
+  while (c != NULL) {
+    grpc_closure *next = c->next_data.next;
+    grpc_error *error = c->error_data.error;
+    did_something = true;
+#ifndef NDEBUG
+    c->scheduled = false;
+#endif
+    c->cb(exec_ctx, c->cb_arg, error);
+    GRPC_ERROR_UNREF(error);
+    c = next;
+  }
+  return did_something;
+}
+
+gpr_timespec grpc_exec_ctx_now(grpc_exec_ctx *exec_ctx) {
+  if (!exec_ctx->now_is_valid) {
+    exec_ctx->now = gpr_now(GPR_CLOCK_MONOTONIC);
+    exec_ctx->now_is_valid = true;
+  }
+  return exec_ctx->now;
+}
+
+void grpc_exec_ctx_invalidate_now(grpc_exec_ctx *exec_ctx) {
+  exec_ctx->now_is_valid = false;
 }
 
 bool grpc_exec_ctx_flush(grpc_exec_ctx *exec_ctx) {
   bool did_something = 0;
+  size_t bulk_budget = BULK_CLOSURES_PER_FLUSH;
   GPR_TIMER_BEGIN("grpc_exec_ctx_flush", 0);
+  /* a clock captured before this flush must not leak into the closures run
+     by it: polling or other blocking may have happened in between */
+  grpc_exec_ctx_invalidate_now(exec_ctx);
   for (;;) {
-    if (!grpc_closure_list_empty(exec_ctx->closure_list)) {
-      grpc_closure *c = exec_ctx->closure_list.head;
-      exec_ctx->closure_list.head = exec_ctx->closure_list.tail = NULL;
+    if (!grpc_closure_list_empty(exec_ctx->urgent_list)) {
+      did_something |= drain_list(exec_ctx, &exec_ctx->urgent_list);
+    } else if (!grpc_closure_list_empty(exec_ctx->closure_list)) {
+      did_something |= drain_list(exec_ctx, &exec_ctx->closure_list);
+    } else if (!grpc_closure_list_empty(exec_ctx->bulk_list)) {
+      grpc_closure *c = exec_ctx->bulk_list.head;
+      exec_ctx->bulk_list.head = exec_ctx->bulk_list.tail = NULL;
       while (c != NULL) {
         grpc_closure *next = c->next_data.next;
         grpc_error *error = c->error_data.error;
         did_something = true;
+        if (bulk_budget == 0) {
+          /* budget spent: hand the remainder to the executor threads so this
+             flush (and whatever latency-sensitive work follows it) is not
+             stuck behind an arbitrarily long bulk backlog */
+          grpc_executor_scheduler->vtable->sched(exec_ctx, c, error);
+        } else {
+          bulk_budget--;
 #ifndef NDEBUG
-        c->scheduled = false;
+          c->scheduled = false;
 #endif
-        c->cb(exec_ctx, c->cb_arg, error);
-        GRPC_ERROR_UNREF(error);
+          c->cb(exec_ctx, c->cb_arg, error);
+          GRPC_ERROR_UNREF(error);
+        }
         c = next;
       }
     } else if (!grpc_combiner_continue_exec_ctx(exec_ctx)) {
@@ -97,6 +151,7 @@ bool grpc_exec_ctx_flush(grpc_exec_ctx *exec_ctx) {
 void grpc_exec_ctx_finish(grpc_exec_ctx *exec_ctx) {
   exec_ctx->flags |= GRPC_EXEC_CTX_FLAG_IS_FINISHED;
   grpc_exec_ctx_flush(exec_ctx);
+  grpc_slice_exec_ctx_cache_flush(exec_ctx);
 }
 
 static void exec_ctx_run(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
@@ -116,7 +171,31 @@ static void exec_ctx_sched(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
 void grpc_exec_ctx_global_init(void) {}
 void grpc_exec_ctx_global_shutdown(void) {}
 
+static void exec_ctx_sched_urgent(grpc_exec_ctx *exec_ctx,
+                                  grpc_closure *closure, grpc_error *error) {
+  grpc_closure_list_append(&exec_ctx->urgent_list, closure, error);
+}
+
+static void exec_ctx_sched_bulk(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
+                                grpc_error *error) {
+  grpc_closure_list_append(&exec_ctx->bulk_list, closure, error);
+}
+
 static const grpc_closure_scheduler_vtable exec_ctx_scheduler_vtable = {
     exec_ctx_run, exec_ctx_sched, "exec_ctx"};
 static grpc_closure_scheduler exec_ctx_scheduler = {&exec_ctx_scheduler_vtable};
 grpc_closure_scheduler *grpc_schedule_on_exec_ctx = &exec_ctx_scheduler;
+
+static const grpc_closure_scheduler_vtable exec_ctx_urgent_scheduler_vtable = {
+    exec_ctx_run, exec_ctx_sched_urgent, "exec_ctx_urgent"};
+static grpc_closure_scheduler exec_ctx_urgent_scheduler = {
+    &exec_ctx_urgent_scheduler_vtable};
+grpc_closure_scheduler *grpc_schedule_on_exec_ctx_urgent =
+    &exec_ctx_urgent_scheduler;
+
+static const grpc_closure_scheduler_vtable exec_ctx_bulk_scheduler_vtable = {
+    exec_ctx_run, exec_ctx_sched_bulk, "exec_ctx_bulk"};
+static grpc_closure_scheduler exec_ctx_bulk_scheduler = {
+    &exec_ctx_bulk_scheduler_vtable};
+grpc_closure_scheduler *grpc_schedule_on_exec_ctx_bulk =
+    &exec_ctx_bulk_scheduler;
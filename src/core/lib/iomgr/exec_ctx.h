@@ -34,6 +34,8 @@
 #ifndef GRPC_CORE_LIB_IOMGR_EXEC_CTX_H
 #define GRPC_CORE_LIB_IOMGR_EXEC_CTX_H
 
+#include <grpc/support/time.h>
+
 #include "src/core/lib/iomgr/closure.h"
 
 /* #define GRPC_EXECUTION_CONTEXT_SANITIZER 1 */
@@ -72,6 +74,13 @@ typedef struct grpc_combiner grpc_combiner;
  */
 struct grpc_exec_ctx {
   grpc_closure_list closure_list;
+  /** closures scheduled with grpc_schedule_on_exec_ctx_urgent: drained ahead
+      of closure_list on every flush pass */
+  grpc_closure_list urgent_list;
+  /** closures scheduled with grpc_schedule_on_exec_ctx_bulk: drained last,
+      and only up to a per-flush budget - the excess respills to the
+      executor so bulk work cannot convoy latency-critical closures */
+  grpc_closure_list bulk_list;
   /** currently active combiner: updated only via combiner.c */
   grpc_combiner *active_combiner;
   /** last active combiner in the active combiner list */
@@ -79,12 +88,24 @@ struct grpc_exec_ctx {
   uintptr_t flags;
   void *check_ready_to_finish_arg;
   bool (*check_ready_to_finish)(grpc_exec_ctx *exec_ctx, void *arg);
+  /** block reclaimed from the last slice freed on this exec_ctx, kept around
+      for reuse by grpc_slice_malloc_internal: updated only via slice.c */
+  void *cached_slice_block;
+  size_t cached_slice_block_capacity;
+  /** monotonic clock captured by the first grpc_exec_ctx_now call of a flush
+      pass and reused until invalidated: see grpc_exec_ctx_now */
+  gpr_timespec now;
+  bool now_is_valid;
 };
 
 /* initializer for grpc_exec_ctx:
    prefer to use GRPC_EXEC_CTX_INIT whenever possible */
-#define GRPC_EXEC_CTX_INITIALIZER(flags, finish_check, finish_check_arg) \
-  { GRPC_CLOSURE_LIST_INIT, NULL, NULL, flags, finish_check_arg, finish_check }
+#define GRPC_EXEC_CTX_INITIALIZER(flags, finish_check, finish_check_arg)      \
+  {                                                                           \
+    GRPC_CLOSURE_LIST_INIT, GRPC_CLOSURE_LIST_INIT, GRPC_CLOSURE_LIST_INIT,   \
+        NULL, NULL, flags, finish_check_arg, finish_check, NULL, 0,           \
+        {0, 0, GPR_CLOCK_MONOTONIC}, false                                    \
+  }
 
 /* initialize an execution context at the top level of an API call into grpc
    (this is safe to use elsewhere, though possibly not as efficient) */
@@ -92,6 +113,14 @@ struct grpc_exec_ctx {
   GRPC_EXEC_CTX_INITIALIZER(GRPC_EXEC_CTX_FLAG_IS_FINISHED, NULL, NULL)
 
 extern grpc_closure_scheduler *grpc_schedule_on_exec_ctx;
+/** as grpc_schedule_on_exec_ctx, but the closure runs ahead of
+    default-priority work on every flush: for closures on an RPC's latency
+    path (e.g. recv-complete notifications) */
+extern grpc_closure_scheduler *grpc_schedule_on_exec_ctx_urgent;
+/** as grpc_schedule_on_exec_ctx, but the closure runs after all other work
+    and only within a bounded per-flush budget; excess respills to the
+    executor threads */
+extern grpc_closure_scheduler *grpc_schedule_on_exec_ctx_bulk;
 
 bool grpc_exec_ctx_has_work(grpc_exec_ctx *exec_ctx);
 
@@ -111,6 +140,18 @@ bool grpc_never_ready_to_finish(grpc_exec_ctx *exec_ctx, void *arg_ignored);
 /** A finish check that is always ready to finish */
 bool grpc_always_ready_to_finish(grpc_exec_ctx *exec_ctx, void *arg_ignored);
 
+/** The monotonic clock, cached on the exec_ctx: the first call of a flush
+    pass reads gpr_now(GPR_CLOCK_MONOTONIC), subsequent calls reuse that
+    value. Use wherever jitter of up to one flush pass is acceptable -
+    deadline checks, timer arming, bookkeeping timestamps - to avoid
+    repeated clock reads on the call path. */
+gpr_timespec grpc_exec_ctx_now(grpc_exec_ctx *exec_ctx);
+/** Force the next grpc_exec_ctx_now call to re-read the clock: call after
+    anything that can block the thread. grpc_exec_ctx_flush invalidates on
+    entry, so work enqueued across a blocking point never observes a clock
+    captured before it. */
+void grpc_exec_ctx_invalidate_now(grpc_exec_ctx *exec_ctx);
+
 void grpc_exec_ctx_global_init(void);
 
 void grpc_exec_ctx_global_init(void);
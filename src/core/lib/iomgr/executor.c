@@ -36,132 +36,194 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd.h>
+#include <grpc/support/tls.h>
+#include <grpc/support/useful.h>
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/support/spinlock.h"
 
-typedef struct grpc_executor_data {
-  int busy;          /**< is the thread currently running? */
-  int shutting_down; /**< has \a grpc_shutdown() been invoked? */
-  int pending_join;  /**< has the thread finished but not been joined? */
-  grpc_closure_list closures; /**< collection of pending work */
-  gpr_thd_id tid; /**< thread id of the thread, only valid if \a busy or \a
-                     pending_join are true */
-  gpr_thd_options options;
+/* The executor runs one queue per thread rather than a single shared list:
+   enqueues from an executor thread stay on that thread's queue (affinity, no
+   cross-thread traffic), enqueues from elsewhere are spread round-robin over
+   the currently running threads, and a thread whose own queue drains steals
+   the whole backlog of a busy sibling before going to sleep. Threads are
+   spawned on demand up to one per CPU core. */
+
+typedef struct {
   gpr_mu mu;
-} grpc_executor;
+  gpr_cv cv;
+  grpc_closure_list elems;
+  bool shutdown;
+  gpr_thd_id id;
+  /* padded (and the array below cacheline-aligned) so neighboring workers
+     never share a cacheline */
+  GPR_CACHELINE_PAD(0);
+} thread_state;
+
+static thread_state *g_thread_state;
+static size_t g_max_threads;
+static gpr_atm g_cur_threads;
+static gpr_spinlock g_adding_thread_lock = GPR_SPINLOCK_STATIC_INITIALIZER;
+
+GPR_TLS_DECL(g_this_thread_state);
+
+static void executor_thread(void *arg);
 
-static grpc_executor g_executor;
+static void run_closure_list(grpc_exec_ctx *exec_ctx, grpc_closure_list list) {
+  grpc_closure *c = list.head;
+  while (c != NULL) {
+    grpc_closure *next = c->next_data.next;
+    grpc_error *error = c->error_data.error;
+#ifndef NDEBUG
+    c->scheduled = false;
+#endif
+    c->cb(exec_ctx, c->cb_arg, error);
+    GRPC_ERROR_UNREF(error);
+    c = next;
+  }
+  grpc_exec_ctx_flush(exec_ctx);
+}
 
 void grpc_executor_init() {
-  memset(&g_executor, 0, sizeof(grpc_executor));
-  gpr_mu_init(&g_executor.mu);
-  g_executor.options = gpr_thd_options_default();
-  gpr_thd_options_set_joinable(&g_executor.options);
+  g_max_threads = GPR_MAX(1, gpr_cpu_num_cores());
+  gpr_atm_no_barrier_store(&g_cur_threads, 1);
+  gpr_tls_init(&g_this_thread_state);
+  g_thread_state = gpr_malloc_aligned(sizeof(thread_state) * g_max_threads,
+                                      GPR_CACHELINE_SIZE_LOG);
+  memset(g_thread_state, 0, sizeof(thread_state) * g_max_threads);
+  for (size_t i = 0; i < g_max_threads; i++) {
+    gpr_mu_init(&g_thread_state[i].mu);
+    gpr_cv_init(&g_thread_state[i].cv);
+    g_thread_state[i].elems = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+  }
+
+  gpr_thd_options opt = gpr_thd_options_default();
+  gpr_thd_options_set_joinable(&opt);
+  gpr_thd_new(&g_thread_state[0].id, executor_thread, &g_thread_state[0],
+              &opt);
 }
 
-/* thread body */
-static void closure_exec_thread_func(void *ignored) {
-  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
-  while (1) {
-    gpr_mu_lock(&g_executor.mu);
-    if (g_executor.shutting_down != 0) {
-      gpr_mu_unlock(&g_executor.mu);
-      break;
+/* Try to take the entire backlog of some other executor thread.
+   Returns true (with *stolen filled in) on success. */
+static bool steal_work(thread_state *thief, grpc_closure_list *stolen) {
+  size_t n = (size_t)gpr_atm_no_barrier_load(&g_cur_threads);
+  for (size_t i = 0; i < n; i++) {
+    thread_state *victim = &g_thread_state[i];
+    if (victim == thief) continue;
+    if (!gpr_mu_trylock(&victim->mu)) continue;
+    if (!grpc_closure_list_empty(victim->elems)) {
+      *stolen = victim->elems;
+      victim->elems = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+      gpr_mu_unlock(&victim->mu);
+      return true;
     }
-    if (grpc_closure_list_empty(g_executor.closures)) {
-      /* no more work, time to die */
-      GPR_ASSERT(g_executor.busy == 1);
-      g_executor.busy = 0;
-      gpr_mu_unlock(&g_executor.mu);
-      break;
-    } else {
-      grpc_closure *c = g_executor.closures.head;
-      grpc_closure_list_init(&g_executor.closures);
-      gpr_mu_unlock(&g_executor.mu);
-      while (c != NULL) {
-        grpc_closure *next = c->next_data.next;
-        grpc_error *error = c->error_data.error;
-#ifndef NDEBUG
-        c->scheduled = false;
-#endif
-        c->cb(&exec_ctx, c->cb_arg, error);
-        GRPC_ERROR_UNREF(error);
-        c = next;
+    gpr_mu_unlock(&victim->mu);
+  }
+  return false;
+}
+
+static void executor_thread(void *arg) {
+  thread_state *ts = arg;
+  gpr_tls_set(&g_this_thread_state, (intptr_t)ts);
+
+  grpc_exec_ctx exec_ctx =
+      GRPC_EXEC_CTX_INITIALIZER(0, grpc_never_ready_to_finish, NULL);
+
+  for (;;) {
+    gpr_mu_lock(&ts->mu);
+    while (grpc_closure_list_empty(ts->elems) && !ts->shutdown) {
+      grpc_closure_list stolen;
+      gpr_mu_unlock(&ts->mu);
+      if (steal_work(ts, &stolen)) {
+        run_closure_list(&exec_ctx, stolen);
+        gpr_mu_lock(&ts->mu);
+        continue;
       }
-      grpc_exec_ctx_flush(&exec_ctx);
+      gpr_mu_lock(&ts->mu);
+      if (!grpc_closure_list_empty(ts->elems) || ts->shutdown) break;
+      gpr_cv_wait(&ts->cv, &ts->mu, gpr_inf_future(GPR_CLOCK_REALTIME));
+    }
+    if (ts->shutdown && grpc_closure_list_empty(ts->elems)) {
+      gpr_mu_unlock(&ts->mu);
+      break;
     }
+    grpc_closure_list exec = ts->elems;
+    ts->elems = (grpc_closure_list)GRPC_CLOSURE_LIST_INIT;
+    gpr_mu_unlock(&ts->mu);
+
+    run_closure_list(&exec_ctx, exec);
   }
+
   grpc_exec_ctx_finish(&exec_ctx);
 }
 
-/* Spawn the thread if new work has arrived a no thread is up */
-static void maybe_spawn_locked() {
-  if (grpc_closure_list_empty(g_executor.closures) == 1) {
+static void executor_push(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
+                          grpc_error *error) {
+  size_t cur_thread_count = (size_t)gpr_atm_no_barrier_load(&g_cur_threads);
+  if (cur_thread_count == 0) {
+    /* executor not running (pre-init or post-shutdown): run on the caller */
+    grpc_closure_list_append(&exec_ctx->closure_list, closure, error);
     return;
   }
-  if (g_executor.shutting_down == 1) {
-    return;
+
+  thread_state *ts = (thread_state *)gpr_tls_get(&g_this_thread_state);
+  if (ts == NULL) {
+    /* not an executor thread: round-robin over the running threads */
+    ts = &g_thread_state[GPR_HASH_POINTER(exec_ctx, cur_thread_count)];
   }
 
-  if (g_executor.busy != 0) {
-    /* Thread still working. New work will be picked up by already running
-     * thread. Not spawning anything. */
+  gpr_mu_lock(&ts->mu);
+  if (ts->shutdown) {
+    gpr_mu_unlock(&ts->mu);
+    grpc_closure_list_append(&exec_ctx->closure_list, closure, error);
     return;
-  } else if (g_executor.pending_join != 0) {
-    /* Pickup the remains of the previous incarnations of the thread. */
-    gpr_thd_join(g_executor.tid);
-    g_executor.pending_join = 0;
   }
+  bool was_empty = grpc_closure_list_empty(ts->elems);
+  grpc_closure_list_append(&ts->elems, closure, error);
+  gpr_cv_signal(&ts->cv);
+  gpr_mu_unlock(&ts->mu);
 
-  /* All previous instances of the thread should have been joined at this point.
-   * Spawn time! */
-  g_executor.busy = 1;
-  GPR_ASSERT(gpr_thd_new(&g_executor.tid, closure_exec_thread_func, NULL,
-                         &g_executor.options));
-  g_executor.pending_join = 1;
-}
-
-static void executor_push(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
-                          grpc_error *error) {
-  gpr_mu_lock(&g_executor.mu);
-  if (g_executor.shutting_down == 0) {
-    grpc_closure_list_append(&g_executor.closures, closure, error);
-    maybe_spawn_locked();
+  /* If the target already had a backlog, bring another core online (up to one
+     thread per core). */
+  if (!was_empty && cur_thread_count < g_max_threads) {
+    if (gpr_spinlock_trylock(&g_adding_thread_lock)) {
+      if ((size_t)gpr_atm_no_barrier_load(&g_cur_threads) <
+          g_max_threads) {
+        size_t new_idx =
+            (size_t)gpr_atm_no_barrier_load(&g_cur_threads);
+        gpr_thd_options opt = gpr_thd_options_default();
+        gpr_thd_options_set_joinable(&opt);
+        gpr_thd_new(&g_thread_state[new_idx].id, executor_thread,
+                    &g_thread_state[new_idx], &opt);
+        gpr_atm_rel_store(&g_cur_threads, (gpr_atm)(new_idx + 1));
+      }
+      gpr_spinlock_unlock(&g_adding_thread_lock);
+    }
   }
-  gpr_mu_unlock(&g_executor.mu);
 }
 
 void grpc_executor_shutdown(grpc_exec_ctx *exec_ctx) {
-  int pending_join;
-
-  gpr_mu_lock(&g_executor.mu);
-  pending_join = g_executor.pending_join;
-  g_executor.shutting_down = 1;
-  gpr_mu_unlock(&g_executor.mu);
-  /* we can release the lock at this point despite the access to the closure
-   * list below because we aren't accepting new work */
-
-  /* Execute pending callbacks, some may be performing cleanups */
-  grpc_closure *c = g_executor.closures.head;
-  grpc_closure_list_init(&g_executor.closures);
-  while (c != NULL) {
-    grpc_closure *next = c->next_data.next;
-    grpc_error *error = c->error_data.error;
-#ifndef NDEBUG
-    c->scheduled = false;
-#endif
-    c->cb(exec_ctx, c->cb_arg, error);
-    GRPC_ERROR_UNREF(error);
-    c = next;
+  size_t n = (size_t)gpr_atm_no_barrier_load(&g_cur_threads);
+  for (size_t i = 0; i < n; i++) {
+    gpr_mu_lock(&g_thread_state[i].mu);
+    g_thread_state[i].shutdown = true;
+    gpr_cv_signal(&g_thread_state[i].cv);
+    gpr_mu_unlock(&g_thread_state[i].mu);
   }
-  grpc_exec_ctx_flush(exec_ctx);
-  GPR_ASSERT(grpc_closure_list_empty(g_executor.closures));
-  if (pending_join) {
-    gpr_thd_join(g_executor.tid);
+  for (size_t i = 0; i < n; i++) {
+    gpr_thd_join(g_thread_state[i].id);
+  }
+  gpr_atm_no_barrier_store(&g_cur_threads, 0);
+  for (size_t i = 0; i < g_max_threads; i++) {
+    GPR_ASSERT(grpc_closure_list_empty(g_thread_state[i].elems));
+    gpr_mu_destroy(&g_thread_state[i].mu);
+    gpr_cv_destroy(&g_thread_state[i].cv);
   }
-  gpr_mu_destroy(&g_executor.mu);
+  gpr_free_aligned(g_thread_state);
+  gpr_tls_destroy(&g_this_thread_state);
 }
 
 static const grpc_closure_scheduler_vtable executor_vtable = {
@@ -46,6 +46,7 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/network_status_tracker.h"
+#include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/iomgr/timer_manager.h"
 #include "src/core/lib/support/env.h"
@@ -68,7 +69,109 @@ void grpc_iomgr_init(void) {
   grpc_iomgr_platform_init();
 }
 
-void grpc_iomgr_start(void) { grpc_timer_manager_init(); }
+/* Background poller service: an opt-in set of dedicated threads that drive
+   I/O progress independently of application threads. Without it, transport
+   closures only run while some thread sits in completion-queue pollset work,
+   so when every application thread is busy computing, ready sockets and BDP
+   probes stall. Each background thread polls a private pollset; with event
+   engines that share a single event set across pollsets (epoll1, the Linux
+   default) this drives every registered fd in the process. Under engines
+   with strictly per-pollset fd sets the threads are idle but harmless.
+
+   Enabled by setting GRPC_BACKGROUND_POLLERS to the number of threads. */
+
+typedef struct background_poller {
+  grpc_pollset *pollset;
+  gpr_mu *pollset_mu;
+  gpr_thd_id thd;
+  bool shutdown;
+  gpr_event shutdown_done;
+  grpc_closure shutdown_closure;
+} background_poller;
+
+static background_poller *g_background_pollers;
+static int g_num_background_pollers;
+
+/* Bound each pollset_work call so the shutdown flag is observed even if a
+   kick is lost */
+#define BACKGROUND_POLLER_MAX_WAIT_SECONDS 1
+
+static void background_poller_loop(void *arg) {
+  background_poller *p = (background_poller *)arg;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  gpr_mu_lock(p->pollset_mu);
+  while (!p->shutdown) {
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    gpr_timespec deadline = gpr_time_add(
+        now, gpr_time_from_seconds(BACKGROUND_POLLER_MAX_WAIT_SECONDS,
+                                   GPR_TIMESPAN));
+    GRPC_LOG_IF_ERROR(
+        "background_poller_work",
+        grpc_pollset_work(&exec_ctx, p->pollset, NULL, now, deadline));
+    gpr_mu_unlock(p->pollset_mu);
+    grpc_exec_ctx_flush(&exec_ctx);
+    gpr_mu_lock(p->pollset_mu);
+  }
+  gpr_mu_unlock(p->pollset_mu);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
+static void background_poller_shutdown_done(grpc_exec_ctx *exec_ctx, void *arg,
+                                            grpc_error *error) {
+  background_poller *p = (background_poller *)arg;
+  gpr_event_set(&p->shutdown_done, (void *)1);
+}
+
+static void background_pollers_start(void) {
+  char *s = gpr_getenv("GRPC_BACKGROUND_POLLERS");
+  if (s == NULL) return;
+  g_num_background_pollers = (int)strtol(s, NULL, 10);
+  gpr_free(s);
+  if (g_num_background_pollers <= 0) {
+    g_num_background_pollers = 0;
+    return;
+  }
+  g_background_pollers = gpr_zalloc(sizeof(*g_background_pollers) *
+                                    (size_t)g_num_background_pollers);
+  for (int i = 0; i < g_num_background_pollers; i++) {
+    background_poller *p = &g_background_pollers[i];
+    p->pollset = gpr_zalloc(grpc_pollset_size());
+    grpc_pollset_init(p->pollset, &p->pollset_mu);
+    gpr_event_init(&p->shutdown_done);
+    gpr_thd_options opt = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&opt);
+    gpr_thd_new(&p->thd, background_poller_loop, p, &opt);
+  }
+}
+
+static void background_pollers_shutdown(grpc_exec_ctx *exec_ctx) {
+  for (int i = 0; i < g_num_background_pollers; i++) {
+    background_poller *p = &g_background_pollers[i];
+    gpr_mu_lock(p->pollset_mu);
+    p->shutdown = true;
+    GRPC_LOG_IF_ERROR("background_poller_kick",
+                      grpc_pollset_kick(p->pollset, NULL));
+    gpr_mu_unlock(p->pollset_mu);
+    gpr_thd_join(p->thd);
+    grpc_closure_init(&p->shutdown_closure, background_poller_shutdown_done, p,
+                      grpc_schedule_on_exec_ctx);
+    gpr_mu_lock(p->pollset_mu);
+    grpc_pollset_shutdown(exec_ctx, p->pollset, &p->shutdown_closure);
+    gpr_mu_unlock(p->pollset_mu);
+    grpc_exec_ctx_flush(exec_ctx);
+    gpr_event_wait(&p->shutdown_done, gpr_inf_future(GPR_CLOCK_REALTIME));
+    grpc_pollset_destroy(exec_ctx, p->pollset);
+    gpr_free(p->pollset);
+  }
+  gpr_free(g_background_pollers);
+  g_background_pollers = NULL;
+  g_num_background_pollers = 0;
+}
+
+void grpc_iomgr_start(void) {
+  grpc_timer_manager_init();
+  background_pollers_start();
+}
 
 static size_t count_objects(void) {
   grpc_iomgr_object *obj;
@@ -91,6 +194,7 @@ void grpc_iomgr_shutdown(grpc_exec_ctx *exec_ctx) {
       gpr_now(GPR_CLOCK_REALTIME), gpr_time_from_seconds(10, GPR_TIMESPAN));
   gpr_timespec last_warning_time = gpr_now(GPR_CLOCK_REALTIME);
 
+  background_pollers_shutdown(exec_ctx);
   grpc_timer_manager_shutdown();
   grpc_iomgr_platform_flush();
 
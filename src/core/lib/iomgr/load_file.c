@@ -39,10 +39,20 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
 
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/support/block_annotate.h"
 #include "src/core/lib/support/string.h"
 
+#ifdef GRPC_POSIX_MMAP_FILE
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 grpc_error *grpc_load_file(const char *filename, int add_null_terminator,
                            grpc_slice *output) {
   unsigned char *contents = NULL;
@@ -90,3 +100,158 @@ end:
   GRPC_SCHEDULING_END_BLOCKING_REGION;
   return error;
 }
+
+#ifdef GRPC_POSIX_MMAP_FILE
+
+/* A process-wide cache of loaded files. Each entry holds one reference on
+   its slice; callers get additional references, so flushing the cache never
+   invalidates slices already handed out. */
+typedef struct file_cache_entry {
+  struct file_cache_entry *next;
+  char *filename;
+  int add_null_terminator;
+  /* identity of the bytes we cached: if any of these change on disk the
+     entry is considered stale and reloaded. Stored as fixed-width copies of
+     the stat fields - dev_t/ino_t are not exposed under -std=c99 */
+  uint64_t dev;
+  uint64_t ino;
+  int64_t mtime;
+  int64_t size;
+  grpc_slice slice;
+} file_cache_entry;
+
+static gpr_once g_file_cache_once = GPR_ONCE_INIT;
+static gpr_mu g_file_cache_mu;
+static file_cache_entry *g_file_cache = NULL;
+
+static void file_cache_init(void) { gpr_mu_init(&g_file_cache_mu); }
+
+static void mmap_destroy(void *ptr, size_t len) { munmap(ptr, len); }
+
+/* Map the file rather than copying it. Bytes of the last mapped page past
+   the end of the file read as zero, which doubles as the NUL terminator
+   when one was requested; when the mapping cannot provide that guarantee
+   (empty file, or a size that is an exact multiple of the page size) we
+   fall back to the copying loader. \a st is refreshed from the opened fd
+   so the cached identity always matches the mapped bytes. */
+static grpc_error *load_file_mmap(const char *filename,
+                                  int add_null_terminator, struct stat *st,
+                                  grpc_slice *output) {
+  int fd;
+  void *mapped;
+
+  GRPC_SCHEDULING_START_BLOCKING_REGION;
+  fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    GRPC_SCHEDULING_END_BLOCKING_REGION;
+    return grpc_load_file(filename, add_null_terminator, output);
+  }
+  if (fstat(fd, st) != 0 || st->st_size <= 0 ||
+      (add_null_terminator &&
+       st->st_size % (off_t)sysconf(_SC_PAGESIZE) == 0)) {
+    close(fd);
+    GRPC_SCHEDULING_END_BLOCKING_REGION;
+    return grpc_load_file(filename, add_null_terminator, output);
+  }
+  mapped = mmap(NULL, (size_t)st->st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (mapped == MAP_FAILED) {
+    return grpc_load_file(filename, add_null_terminator, output);
+  }
+  *output = grpc_slice_new_with_len(
+      mapped, (size_t)st->st_size + (add_null_terminator ? 1 : 0),
+      mmap_destroy);
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error *grpc_load_file_cached(const char *filename,
+                                  int add_null_terminator,
+                                  grpc_slice *output) {
+  struct stat st;
+  file_cache_entry *e;
+  grpc_error *error;
+  grpc_slice slice;
+
+  if (stat(filename, &st) != 0) {
+    /* missing file: let grpc_load_file produce the error */
+    return grpc_load_file(filename, add_null_terminator, output);
+  }
+
+  gpr_once_init(&g_file_cache_once, file_cache_init);
+  gpr_mu_lock(&g_file_cache_mu);
+  for (e = g_file_cache; e != NULL; e = e->next) {
+    if (e->add_null_terminator == add_null_terminator &&
+        0 == strcmp(e->filename, filename)) {
+      if (e->dev == (uint64_t)st.st_dev && e->ino == (uint64_t)st.st_ino &&
+          e->mtime == (int64_t)st.st_mtime && e->size == (int64_t)st.st_size) {
+        *output = grpc_slice_ref(e->slice);
+        gpr_mu_unlock(&g_file_cache_mu);
+        return GRPC_ERROR_NONE;
+      }
+      break; /* stale entry: reload and refresh it below */
+    }
+  }
+  gpr_mu_unlock(&g_file_cache_mu);
+
+  error = load_file_mmap(filename, add_null_terminator, &st, &slice);
+  if (error != GRPC_ERROR_NONE) {
+    *output = slice;
+    return error;
+  }
+
+  gpr_mu_lock(&g_file_cache_mu);
+  /* the list may have changed while we were loading */
+  for (e = g_file_cache; e != NULL; e = e->next) {
+    if (e->add_null_terminator == add_null_terminator &&
+        0 == strcmp(e->filename, filename)) {
+      break;
+    }
+  }
+  if (e == NULL) {
+    e = gpr_malloc(sizeof(*e));
+    e->filename = gpr_strdup(filename);
+    e->add_null_terminator = add_null_terminator;
+    e->next = g_file_cache;
+    g_file_cache = e;
+  } else {
+    grpc_slice_unref(e->slice);
+  }
+  e->dev = (uint64_t)st.st_dev;
+  e->ino = (uint64_t)st.st_ino;
+  e->mtime = (int64_t)st.st_mtime;
+  e->size = (int64_t)st.st_size;
+  e->slice = grpc_slice_ref(slice);
+  gpr_mu_unlock(&g_file_cache_mu);
+
+  *output = slice;
+  return GRPC_ERROR_NONE;
+}
+
+void grpc_load_file_cache_flush(void) {
+  file_cache_entry *e;
+  gpr_once_init(&g_file_cache_once, file_cache_init);
+  gpr_mu_lock(&g_file_cache_mu);
+  e = g_file_cache;
+  g_file_cache = NULL;
+  gpr_mu_unlock(&g_file_cache_mu);
+  while (e != NULL) {
+    file_cache_entry *next = e->next;
+    grpc_slice_unref(e->slice);
+    gpr_free(e->filename);
+    gpr_free(e);
+    e = next;
+  }
+}
+
+#else /* !GRPC_POSIX_MMAP_FILE */
+
+grpc_error *grpc_load_file_cached(const char *filename,
+                                  int add_null_terminator,
+                                  grpc_slice *output) {
+  return grpc_load_file(filename, add_null_terminator, output);
+}
+
+void grpc_load_file_cache_flush(void) {}
+
+#endif
@@ -49,6 +49,21 @@ extern "C" {
 grpc_error *grpc_load_file(const char *filename, int add_null_terminator,
                            grpc_slice *slice);
 
+/* Like grpc_load_file, but backed by a process-wide cache keyed on the
+   file's identity (device, inode, mtime, size): repeated loads of an
+   unchanged file hand out new references to the same bytes - mmap backed
+   on platforms that support it - instead of re-reading the file. Intended
+   for contents that are loaded over and over, like TLS certificate and
+   key files on credential reloads. Files must be updated by atomic
+   replacement (write to a temporary name, then rename); rewriting a file
+   in place can change bytes under mmap-backed slices already handed
+   out. */
+grpc_error *grpc_load_file_cached(const char *filename,
+                                  int add_null_terminator, grpc_slice *slice);
+
+/* Drops every cached file. Slices already handed out remain valid. */
+void grpc_load_file_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,11 +43,19 @@
 #include <grpc/support/useful.h>
 
 #include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/slice/slice_internal.h"
 
 grpc_tracer_flag grpc_resource_quota_trace = GRPC_TRACER_INITIALIZER(false);
 
 #define MEMORY_USAGE_ESTIMATION_MAX 65536
 
+/* How many bytes (beyond the immediate deficit) to grant a resource user when
+   it asks the quota for memory. Handing out quota in bulk lets subsequent
+   allocations be satisfied from the user's cached free pool without another
+   trip through the quota combiner; the surplus remains visible to the
+   reclamation machinery and is pulled back under memory pressure. */
+#define RESOURCE_USER_FREE_POOL_CACHE_SIZE (64 * 1024)
+
 /* Internal linked list pointers for a resource user */
 typedef struct {
   grpc_resource_user *next;
@@ -254,6 +262,60 @@ static bool rq_reclaim_from_per_user_free_pool(
 static bool rq_reclaim(grpc_exec_ctx *exec_ctx,
                        grpc_resource_quota *resource_quota, bool destructive);
 
+/* registry of process-global caches that shed memory under quota pressure
+   (see grpc_resource_quota_register_cache_shedder) */
+typedef struct cache_shedder {
+  grpc_cache_shed_func shed;
+  void *arg;
+  struct cache_shedder *next;
+} cache_shedder;
+
+static gpr_once g_cache_shedder_once = GPR_ONCE_INIT;
+static gpr_mu g_cache_shedder_mu;
+static cache_shedder *g_cache_shedders = NULL;
+
+static void cache_shedder_init(void) { gpr_mu_init(&g_cache_shedder_mu); }
+
+void grpc_resource_quota_register_cache_shedder(grpc_cache_shed_func shed,
+                                                void *arg) {
+  cache_shedder *cs = gpr_malloc(sizeof(*cs));
+  cs->shed = shed;
+  cs->arg = arg;
+  gpr_once_init(&g_cache_shedder_once, cache_shedder_init);
+  gpr_mu_lock(&g_cache_shedder_mu);
+  cs->next = g_cache_shedders;
+  g_cache_shedders = cs;
+  gpr_mu_unlock(&g_cache_shedder_mu);
+}
+
+void grpc_resource_quota_unregister_cache_shedder(grpc_cache_shed_func shed,
+                                                  void *arg) {
+  gpr_once_init(&g_cache_shedder_once, cache_shedder_init);
+  gpr_mu_lock(&g_cache_shedder_mu);
+  cache_shedder **prev = &g_cache_shedders;
+  for (cache_shedder *cs = *prev; cs != NULL; cs = *prev) {
+    if (cs->shed == shed && cs->arg == arg) {
+      *prev = cs->next;
+      gpr_free(cs);
+      break;
+    }
+    prev = &cs->next;
+  }
+  gpr_mu_unlock(&g_cache_shedder_mu);
+}
+
+/* caches are asked to shed before resource users are asked to reclaim:
+   dropping cold cache entries is strictly cheaper than tearing down live
+   buffers or connections */
+static void shed_registered_caches(grpc_exec_ctx *exec_ctx, bool destructive) {
+  gpr_once_init(&g_cache_shedder_once, cache_shedder_init);
+  gpr_mu_lock(&g_cache_shedder_mu);
+  for (cache_shedder *cs = g_cache_shedders; cs != NULL; cs = cs->next) {
+    cs->shed(exec_ctx, cs->arg, destructive);
+  }
+  gpr_mu_unlock(&g_cache_shedder_mu);
+}
+
 static void rq_step(grpc_exec_ctx *exec_ctx, void *rq, grpc_error *error) {
   grpc_resource_quota *resource_quota = rq;
   resource_quota->step_scheduled = false;
@@ -261,7 +323,9 @@ static void rq_step(grpc_exec_ctx *exec_ctx, void *rq, grpc_error *error) {
     if (rq_alloc(exec_ctx, resource_quota)) goto done;
   } while (rq_reclaim_from_per_user_free_pool(exec_ctx, resource_quota));
 
+  shed_registered_caches(exec_ctx, false);
   if (!rq_reclaim(exec_ctx, resource_quota, false)) {
+    shed_registered_caches(exec_ctx, true);
     rq_reclaim(exec_ctx, resource_quota, true);
   }
 
@@ -304,7 +368,22 @@ static bool rq_alloc(grpc_exec_ctx *exec_ctx,
     if (resource_user->free_pool < 0 &&
         -resource_user->free_pool <= resource_quota->free_pool) {
       int64_t amt = -resource_user->free_pool;
-      resource_user->free_pool = 0;
+      /* Grant a bulk chunk beyond the deficit when the quota has headroom, so
+         that the user's next allocations hit its cached free pool instead of
+         re-entering the combiner. Publish the surplus for reclamation so the
+         quota can take it back if memory gets tight. */
+      int64_t cache = GPR_MIN((int64_t)RESOURCE_USER_FREE_POOL_CACHE_SIZE,
+                              resource_quota->free_pool - amt);
+      if (cache > 0) {
+        amt += cache;
+        resource_user->free_pool = cache;
+        if (!resource_user->added_to_free_pool) {
+          resource_user->added_to_free_pool = true;
+          rulist_add_tail(resource_user, GRPC_RULIST_NON_EMPTY_FREE_POOL);
+        }
+      } else {
+        resource_user->free_pool = 0;
+      }
       resource_quota->free_pool -= amt;
       rq_update_estimate(resource_quota);
       if (GRPC_TRACER_ON(grpc_resource_quota_trace)) {
@@ -425,6 +504,59 @@ static grpc_slice ru_slice_create(grpc_resource_user *resource_user,
   return slice;
 }
 
+/*******************************************************************************
+ * ru_plugin_slice: a quota-accounted wrapper around a slice produced by an
+ * application slice-allocator plugin. The payload bytes belong to the
+ * application; the wrapper keeps them charged to the resource user until the
+ * last reference drops, then returns them by unreffing the inner slice.
+ */
+
+typedef struct {
+  grpc_slice_refcount base;
+  gpr_refcount refs;
+  grpc_resource_user *resource_user;
+  grpc_slice wrapped;
+  size_t size;
+} ru_plugin_slice_refcount;
+
+static void ru_plugin_slice_ref(void *p) {
+  ru_plugin_slice_refcount *rc = p;
+  gpr_ref(&rc->refs);
+}
+
+static void ru_plugin_slice_unref(grpc_exec_ctx *exec_ctx, void *p) {
+  ru_plugin_slice_refcount *rc = p;
+  if (gpr_unref(&rc->refs)) {
+    grpc_resource_user_free(exec_ctx, rc->resource_user, rc->size);
+    grpc_slice_unref_internal(exec_ctx, rc->wrapped);
+    gpr_free(rc);
+  }
+}
+
+static const grpc_slice_refcount_vtable ru_plugin_slice_vtable = {
+    ru_plugin_slice_ref, ru_plugin_slice_unref, grpc_slice_default_eq_impl,
+    grpc_slice_default_hash_impl};
+
+static grpc_slice ru_plugin_slice_create(grpc_resource_user *resource_user,
+                                         grpc_slice_allocator_plugin *plugin,
+                                         size_t size) {
+  grpc_slice wrapped = plugin->vtable->alloc_slice(plugin, size);
+  GPR_ASSERT(GRPC_SLICE_LENGTH(wrapped) >= size);
+  ru_plugin_slice_refcount *rc = gpr_malloc(sizeof(*rc));
+  rc->base.vtable = &ru_plugin_slice_vtable;
+  rc->base.sub_refcount = &rc->base;
+  gpr_ref_init(&rc->refs, 1);
+  rc->resource_user = resource_user;
+  rc->wrapped = wrapped;
+  rc->size = size;
+  grpc_slice slice;
+  slice.refcount = &rc->base;
+  /* rc owns the inner slice, so inlined storage stays valid too */
+  slice.data.refcounted.bytes = GRPC_SLICE_START_PTR(rc->wrapped);
+  slice.data.refcounted.length = size;
+  return slice;
+}
+
 /*******************************************************************************
  * grpc_resource_quota internal implementation: resource user manipulation under
  * the combiner
@@ -535,9 +667,14 @@ static void ru_allocated_slices(grpc_exec_ctx *exec_ctx, void *arg,
   grpc_resource_user_slice_allocator *slice_allocator = arg;
   if (error == GRPC_ERROR_NONE) {
     for (size_t i = 0; i < slice_allocator->count; i++) {
-      grpc_slice_buffer_add_indexed(
-          slice_allocator->dest, ru_slice_create(slice_allocator->resource_user,
-                                                 slice_allocator->length));
+      grpc_slice slice =
+          slice_allocator->plugin != NULL
+              ? ru_plugin_slice_create(slice_allocator->resource_user,
+                                       slice_allocator->plugin,
+                                       slice_allocator->length)
+              : ru_slice_create(slice_allocator->resource_user,
+                                slice_allocator->length);
+      grpc_slice_buffer_add_indexed(slice_allocator->dest, slice);
     }
   }
   grpc_closure_run(exec_ctx, &slice_allocator->on_done, GRPC_ERROR_REF(error));
@@ -693,6 +830,63 @@ const grpc_arg_pointer_vtable *grpc_resource_quota_arg_vtable(void) {
   return &vtable;
 }
 
+/*******************************************************************************
+ * grpc_slice_allocator_plugin api
+ */
+
+void grpc_slice_allocator_plugin_init(
+    grpc_slice_allocator_plugin *plugin,
+    const grpc_slice_allocator_plugin_vtable *vtable) {
+  plugin->vtable = vtable;
+  gpr_ref_init(&plugin->refs, 1);
+}
+
+grpc_slice_allocator_plugin *grpc_slice_allocator_plugin_ref(
+    grpc_slice_allocator_plugin *plugin) {
+  gpr_ref(&plugin->refs);
+  return plugin;
+}
+
+void grpc_slice_allocator_plugin_unref(grpc_slice_allocator_plugin *plugin) {
+  if (gpr_unref(&plugin->refs)) {
+    plugin->vtable->destroy(plugin);
+  }
+}
+
+static void *plugin_arg_copy(void *p) {
+  return grpc_slice_allocator_plugin_ref(p);
+}
+
+static void plugin_arg_destroy(grpc_exec_ctx *exec_ctx, void *p) {
+  grpc_slice_allocator_plugin_unref(p);
+}
+
+static int plugin_arg_cmp(void *a, void *b) { return GPR_ICMP(a, b); }
+
+grpc_arg grpc_slice_allocator_plugin_arg(grpc_slice_allocator_plugin *plugin) {
+  static const grpc_arg_pointer_vtable vtable = {
+      plugin_arg_copy, plugin_arg_destroy, plugin_arg_cmp};
+  grpc_arg arg;
+  arg.type = GRPC_ARG_POINTER;
+  arg.key = GRPC_ARG_READ_SLICE_ALLOCATOR;
+  arg.value.pointer.p = plugin;
+  arg.value.pointer.vtable = &vtable;
+  return arg;
+}
+
+grpc_slice_allocator_plugin *grpc_slice_allocator_plugin_from_channel_args(
+    const grpc_channel_args *args) {
+  for (size_t i = 0; i < args->num_args; i++) {
+    if (0 == strcmp(args->args[i].key, GRPC_ARG_READ_SLICE_ALLOCATOR)) {
+      if (args->args[i].type == GRPC_ARG_POINTER) {
+        return args->args[i].value.pointer.p;
+      }
+      gpr_log(GPR_DEBUG, GRPC_ARG_READ_SLICE_ALLOCATOR " should be a pointer");
+    }
+  }
+  return NULL;
+}
+
 /*******************************************************************************
  * grpc_resource_user api
  */
@@ -857,6 +1051,7 @@ void grpc_resource_user_slice_allocator_init(
   grpc_closure_init(&slice_allocator->on_done, cb, p,
                     grpc_schedule_on_exec_ctx);
   slice_allocator->resource_user = resource_user;
+  slice_allocator->plugin = NULL;
 }
 
 void grpc_resource_user_alloc_slices(
@@ -93,6 +93,21 @@ double grpc_resource_quota_get_memory_pressure(
 
 size_t grpc_resource_quota_peek_size(grpc_resource_quota *resource_quota);
 
+/* Process-global caches (metadata table and the like) can register to shed
+   reclaimable memory whenever any resource quota comes under pressure. The
+   hook runs before the quota turns to its resource users: the benign stage
+   fires as soon as an allocation cannot be satisfied from the free pool,
+   the destructive stage only when benign user reclamation had nothing left
+   to offer. Shed memory goes back to the allocator (it is not
+   quota-accounted), so this lowers process footprint rather than refilling
+   the quota. Hooks must be cheap when there is nothing to shed. */
+typedef void (*grpc_cache_shed_func)(grpc_exec_ctx *exec_ctx, void *arg,
+                                     bool destructive);
+void grpc_resource_quota_register_cache_shedder(grpc_cache_shed_func shed,
+                                                void *arg);
+void grpc_resource_quota_unregister_cache_shedder(grpc_cache_shed_func shed,
+                                                  void *arg);
+
 typedef struct grpc_resource_user grpc_resource_user;
 
 grpc_resource_user *grpc_resource_user_create(
@@ -131,6 +146,43 @@ void grpc_resource_user_post_reclaimer(grpc_exec_ctx *exec_ctx,
 void grpc_resource_user_finish_reclamation(grpc_exec_ctx *exec_ctx,
                                            grpc_resource_user *resource_user);
 
+/* An application-supplied allocator for the slices handed out by a
+   grpc_resource_user_slice_allocator. Endpoints pick one up from channel
+   args (GRPC_ARG_READ_SLICE_ALLOCATOR), so bytes read from the wire land
+   directly in application-owned pooled memory instead of the heap and are
+   handed back through grpc_byte_buffer without a copy. Quota accounting is
+   unchanged: allocated bytes stay charged to the endpoint's resource user
+   until the last reference to the slice is dropped, at which point the
+   underlying slice is returned to the plugin. */
+typedef struct grpc_slice_allocator_plugin grpc_slice_allocator_plugin;
+
+typedef struct grpc_slice_allocator_plugin_vtable {
+  /* Return a slice with at least \a length bytes of capacity. Called from
+     polling threads: must be thread-safe and must not block. */
+  grpc_slice (*alloc_slice)(grpc_slice_allocator_plugin *plugin,
+                            size_t length);
+  /* Called when the last reference to the plugin is dropped */
+  void (*destroy)(grpc_slice_allocator_plugin *plugin);
+} grpc_slice_allocator_plugin_vtable;
+
+struct grpc_slice_allocator_plugin {
+  const grpc_slice_allocator_plugin_vtable *vtable;
+  gpr_refcount refs;
+};
+
+void grpc_slice_allocator_plugin_init(
+    grpc_slice_allocator_plugin *plugin,
+    const grpc_slice_allocator_plugin_vtable *vtable);
+grpc_slice_allocator_plugin *grpc_slice_allocator_plugin_ref(
+    grpc_slice_allocator_plugin *plugin);
+void grpc_slice_allocator_plugin_unref(grpc_slice_allocator_plugin *plugin);
+
+/* Wrap \a plugin in a channel arg (key GRPC_ARG_READ_SLICE_ALLOCATOR) */
+grpc_arg grpc_slice_allocator_plugin_arg(grpc_slice_allocator_plugin *plugin);
+/* Returns a borrowed reference to the plugin in \a args, or NULL */
+grpc_slice_allocator_plugin *grpc_slice_allocator_plugin_from_channel_args(
+    const grpc_channel_args *args);
+
 /* Helper to allocate slices from a resource user */
 typedef struct grpc_resource_user_slice_allocator {
   /* Closure for when a resource user allocation completes */
@@ -145,6 +197,9 @@ typedef struct grpc_resource_user_slice_allocator {
   grpc_slice_buffer *dest;
   /* Parent resource user */
   grpc_resource_user *resource_user;
+  /* Optional application-supplied slice allocator (borrowed reference,
+     owned by the endpoint); NULL means allocate from the heap */
+  grpc_slice_allocator_plugin *plugin;
 } grpc_resource_user_slice_allocator;
 
 /* Initialize a slice allocator.
@@ -0,0 +1,558 @@
+/*
+ *
+ * Copyright 2017, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/* Shared-memory endpoint.
+
+   A pair of single-producer single-consumer byte rings lives in a shared
+   segment mapped by both processes; payload moves with one memcpy into the
+   ring and one out of it, never through the kernel. The only kernel
+   involvement is the doorbell: a connected socketpair whose bytes mean
+   "look at the rings again". Each ring carries armed flags so a doorbell
+   is only rung when the other side declared it was about to sleep - the
+   streaming fast path stays entirely in userspace.
+
+   The doorbell socket doubles as the liveness signal: when the peer
+   process exits or closes its end we observe EOF and fail pending
+   operations, which a raw futex in the segment could not give us.
+
+   Setup is expected to run over a unix control connection using
+   grpc_send_fd_over_unix_socket: the initiator creates the segment with
+   grpc_shm_segment_create, builds its endpoint (which initializes the
+   ring headers), and only then passes the segment fd and its socketpair
+   peer fd across; the acceptor therefore never maps an uninitialized
+   segment. */
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET
+
+#include "src/core/lib/iomgr/shm_endpoint_posix.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef GPR_LINUX
+#include <sys/syscall.h>
+#endif
+
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#define GRPC_SHM_MAGIC 0x73686d31 /* "shm1" */
+#define GRPC_SHM_MIN_RING_CAPACITY 4096
+
+typedef struct {
+  /* head/tail are free-running byte counters (they never wrap in
+     practice); each sits on its own cacheline since they are written by
+     different processes */
+  gpr_atm head; /* bytes produced; written by the ring's writer */
+  char pad_head[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+  gpr_atm tail; /* bytes consumed; written by the ring's reader */
+  char pad_tail[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+  /* doorbell arming: a stalled side stores 1 before sleeping and the
+     peer takes the token with an exchange when it rings, so each stall
+     costs at most one doorbell byte */
+  gpr_atm reader_armed;
+  gpr_atm writer_armed;
+  char pad_armed[GPR_CACHELINE_SIZE - 2 * sizeof(gpr_atm)];
+} grpc_shm_ring;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t ring_capacity; /* bytes per direction; a power of two */
+  grpc_shm_ring rings[2]; /* [0] initiator->acceptor, [1] the reverse */
+  /* ring data follows: ring_capacity bytes for rings[0], then rings[1] */
+} grpc_shm_segment;
+
+typedef struct {
+  grpc_endpoint base;
+  gpr_mu mu;
+  gpr_refcount refcount;
+  bool shutdown;
+
+  grpc_shm_segment *seg;
+  size_t map_size;
+  int shm_fd;
+  uint32_t capacity;
+  grpc_shm_ring *in_ring;
+  grpc_shm_ring *out_ring;
+  uint8_t *in_data;
+  uint8_t *out_data;
+
+  int doorbell_fd;
+  grpc_fd *em_fd;
+  bool doorbell_armed;
+  grpc_closure doorbell_closure;
+
+  grpc_slice_buffer *incoming_buffer;
+  grpc_closure *read_cb;
+  grpc_slice_buffer *outgoing_buffer;
+  size_t outgoing_slice_idx;
+  size_t outgoing_byte_idx;
+  grpc_closure *write_cb;
+
+  grpc_resource_user *resource_user;
+  char *peer_string;
+} grpc_shm;
+
+int grpc_shm_segment_create(size_t size) {
+  int fd = -1;
+#ifdef __NR_memfd_create
+  fd = (int)syscall(__NR_memfd_create, "grpc-shm", 0);
+#endif
+  if (fd < 0) {
+    /* pre-memfd kernels and other unices: an unlinked file on a tmpfs (or
+       failing that, wherever tmp files live) maps just as well */
+    char shm_path[] = "/dev/shm/grpc-shm-XXXXXX";
+    char tmp_path[] = "/tmp/grpc-shm-XXXXXX";
+    fd = mkstemp(shm_path);
+    if (fd >= 0) {
+      unlink(shm_path);
+    } else {
+      fd = mkstemp(tmp_path);
+      if (fd < 0) return -1;
+      unlink(tmp_path);
+    }
+  }
+  if (ftruncate(fd, (off_t)size) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static uint32_t shm_ring_capacity_for(size_t shm_size) {
+  if (shm_size <= sizeof(grpc_shm_segment)) return 0;
+  size_t per_ring = (shm_size - sizeof(grpc_shm_segment)) / 2;
+  uint32_t cap = 1;
+  while ((size_t)cap * 2 <= per_ring && cap < (1u << 30)) cap *= 2;
+  return cap >= GRPC_SHM_MIN_RING_CAPACITY ? cap : 0;
+}
+
+static void shm_free(grpc_exec_ctx *exec_ctx, grpc_shm *shm) {
+  grpc_fd_orphan(exec_ctx, shm->em_fd, NULL, NULL, "shm_unref_orphan");
+  munmap(shm->seg, shm->map_size);
+  close(shm->shm_fd);
+  grpc_resource_user_unref(exec_ctx, shm->resource_user);
+  gpr_free(shm->peer_string);
+  gpr_mu_destroy(&shm->mu);
+  gpr_free(shm);
+}
+
+static void shm_ref(grpc_shm *shm) { gpr_ref(&shm->refcount); }
+
+static void shm_unref(grpc_exec_ctx *exec_ctx, grpc_shm *shm) {
+  if (gpr_unref(&shm->refcount)) {
+    shm_free(exec_ctx, shm);
+  }
+}
+
+static void shm_ring_doorbell(grpc_shm *shm) {
+  char byte = 1;
+  ssize_t r;
+  do {
+    r = write(shm->doorbell_fd, &byte, 1);
+  } while (r < 0 && errno == EINTR);
+  /* EAGAIN means undrained doorbell bytes already queue a wakeup; other
+     errors surface as EOF on the peer's side */
+}
+
+/* Move everything available in the incoming ring into shm->incoming_buffer
+   as one slice. Requires the lock and a non-empty ring. */
+static void shm_consume_locked(grpc_shm *shm) {
+  uintptr_t head = (uintptr_t)gpr_atm_acq_load(&shm->in_ring->head);
+  uintptr_t tail = (uintptr_t)gpr_atm_no_barrier_load(&shm->in_ring->tail);
+  size_t avail = head - tail;
+  GPR_ASSERT(avail > 0 && avail <= shm->capacity);
+  grpc_slice slice = grpc_slice_malloc(avail);
+  uint8_t *dst = GRPC_SLICE_START_PTR(slice);
+  size_t off = tail & (shm->capacity - 1);
+  size_t first = GPR_MIN(avail, shm->capacity - off);
+  memcpy(dst, shm->in_data + off, first);
+  memcpy(dst + first, shm->in_data, avail - first);
+  gpr_atm_rel_store(&shm->in_ring->tail, (gpr_atm)(tail + avail));
+  grpc_slice_buffer_add(shm->incoming_buffer, slice);
+  if (gpr_atm_full_xchg(&shm->in_ring->writer_armed, 0) != 0) {
+    shm_ring_doorbell(shm);
+  }
+}
+
+/* Copy as much of the outgoing buffer as fits into the outgoing ring.
+   Returns true when the whole buffer has been flushed. */
+static bool shm_flush_locked(grpc_shm *shm) {
+  grpc_slice_buffer *buf = shm->outgoing_buffer;
+  bool produced = false;
+  bool complete;
+  for (;;) {
+    if (shm->outgoing_slice_idx == buf->count) {
+      complete = true;
+      break;
+    }
+    uintptr_t head = (uintptr_t)gpr_atm_no_barrier_load(&shm->out_ring->head);
+    uintptr_t tail = (uintptr_t)gpr_atm_acq_load(&shm->out_ring->tail);
+    size_t space = shm->capacity - (head - tail);
+    grpc_slice slice = buf->slices[shm->outgoing_slice_idx];
+    size_t remaining = GRPC_SLICE_LENGTH(slice) - shm->outgoing_byte_idx;
+    if (space == 0 && remaining > 0) {
+      complete = false;
+      break;
+    }
+    size_t n = GPR_MIN(remaining, space);
+    const uint8_t *src = GRPC_SLICE_START_PTR(slice) + shm->outgoing_byte_idx;
+    size_t off = head & (shm->capacity - 1);
+    size_t first = GPR_MIN(n, shm->capacity - off);
+    memcpy(shm->out_data + off, src, first);
+    memcpy(shm->out_data, src + first, n - first);
+    gpr_atm_rel_store(&shm->out_ring->head, (gpr_atm)(head + n));
+    if (n > 0) produced = true;
+    shm->outgoing_byte_idx += n;
+    if (shm->outgoing_byte_idx == GRPC_SLICE_LENGTH(slice)) {
+      shm->outgoing_slice_idx++;
+      shm->outgoing_byte_idx = 0;
+    }
+  }
+  if (produced &&
+      gpr_atm_full_xchg(&shm->out_ring->reader_armed, 0) != 0) {
+    shm_ring_doorbell(shm);
+  }
+  return complete;
+}
+
+/* Flush, arming the ring's writer doorbell if the ring fills. Returns true
+   when the whole outgoing buffer made it into the ring. */
+static bool shm_try_write_locked(grpc_shm *shm) {
+  for (;;) {
+    if (shm_flush_locked(shm)) return true;
+    gpr_atm_rel_store(&shm->out_ring->writer_armed, 1);
+    /* re-check so a consume between the failed flush and the arming above
+       cannot strand us without a doorbell */
+    uintptr_t head = (uintptr_t)gpr_atm_no_barrier_load(&shm->out_ring->head);
+    uintptr_t tail = (uintptr_t)gpr_atm_acq_load(&shm->out_ring->tail);
+    if (shm->capacity - (head - tail) == 0) return false;
+    if (gpr_atm_full_xchg(&shm->out_ring->writer_armed, 0) == 0) {
+      /* the peer took the token and rang; let the doorbell handler retry */
+      return false;
+    }
+  }
+}
+
+static bool shm_in_ring_nonempty(grpc_shm *shm) {
+  return gpr_atm_acq_load(&shm->in_ring->head) !=
+         gpr_atm_no_barrier_load(&shm->in_ring->tail);
+}
+
+static void shm_arm_doorbell_locked(grpc_exec_ctx *exec_ctx, grpc_shm *shm) {
+  if (!shm->doorbell_armed) {
+    shm->doorbell_armed = true;
+    shm_ref(shm);
+    grpc_fd_notify_on_read(exec_ctx, shm->em_fd, &shm->doorbell_closure);
+  }
+}
+
+static void shm_handle_doorbell(grpc_exec_ctx *exec_ctx, void *arg,
+                                grpc_error *error) {
+  grpc_shm *shm = (grpc_shm *)arg;
+  bool eof = false;
+  if (error == GRPC_ERROR_NONE) {
+    char drain[64];
+    for (;;) {
+      ssize_t r = read(shm->doorbell_fd, drain, sizeof(drain));
+      if (r == 0) {
+        eof = true;
+        break;
+      }
+      if (r < 0) {
+        if (errno == EINTR) continue;
+        break; /* EAGAIN: drained */
+      }
+      if (r < (ssize_t)sizeof(drain)) break;
+    }
+  }
+  gpr_mu_lock(&shm->mu);
+  shm->doorbell_armed = false;
+  if (error != GRPC_ERROR_NONE || eof || shm->shutdown) {
+    grpc_error *why =
+        error != GRPC_ERROR_NONE
+            ? GRPC_ERROR_REF(error)
+            : GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                  "Shared memory peer disconnected");
+    if (shm->read_cb != NULL) {
+      grpc_closure_sched(exec_ctx, shm->read_cb, GRPC_ERROR_REF(why));
+      shm->read_cb = NULL;
+      shm->incoming_buffer = NULL;
+    }
+    if (shm->write_cb != NULL) {
+      grpc_closure_sched(exec_ctx, shm->write_cb, GRPC_ERROR_REF(why));
+      shm->write_cb = NULL;
+      shm->outgoing_buffer = NULL;
+    }
+    GRPC_ERROR_UNREF(why);
+    gpr_mu_unlock(&shm->mu);
+    shm_unref(exec_ctx, shm);
+    return;
+  }
+  if (shm->read_cb != NULL) {
+    if (shm_in_ring_nonempty(shm)) {
+      shm_consume_locked(shm);
+      grpc_closure_sched(exec_ctx, shm->read_cb, GRPC_ERROR_NONE);
+      shm->read_cb = NULL;
+      shm->incoming_buffer = NULL;
+    } else {
+      gpr_atm_rel_store(&shm->in_ring->reader_armed, 1);
+      if (shm_in_ring_nonempty(shm)) {
+        gpr_atm_full_xchg(&shm->in_ring->reader_armed, 0);
+        shm_consume_locked(shm);
+        grpc_closure_sched(exec_ctx, shm->read_cb, GRPC_ERROR_NONE);
+        shm->read_cb = NULL;
+        shm->incoming_buffer = NULL;
+      }
+    }
+  }
+  if (shm->write_cb != NULL && shm_try_write_locked(shm)) {
+    grpc_closure_sched(exec_ctx, shm->write_cb, GRPC_ERROR_NONE);
+    shm->write_cb = NULL;
+    shm->outgoing_buffer = NULL;
+  }
+  if (shm->read_cb != NULL || shm->write_cb != NULL) {
+    shm_arm_doorbell_locked(exec_ctx, shm);
+  }
+  gpr_mu_unlock(&shm->mu);
+  shm_unref(exec_ctx, shm);
+}
+
+static void shm_read(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
+                     grpc_slice_buffer *incoming_buffer, grpc_closure *cb) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  gpr_mu_lock(&shm->mu);
+  GPR_ASSERT(shm->read_cb == NULL);
+  grpc_slice_buffer_reset_and_unref_internal(exec_ctx, incoming_buffer);
+  if (shm->shutdown) {
+    gpr_mu_unlock(&shm->mu);
+    grpc_closure_sched(
+        exec_ctx, cb,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory endpoint closed"));
+    return;
+  }
+  shm->incoming_buffer = incoming_buffer;
+  if (shm_in_ring_nonempty(shm)) {
+    shm_consume_locked(shm);
+    shm->incoming_buffer = NULL;
+    gpr_mu_unlock(&shm->mu);
+    grpc_closure_sched(exec_ctx, cb, GRPC_ERROR_NONE);
+    return;
+  }
+  gpr_atm_rel_store(&shm->in_ring->reader_armed, 1);
+  if (shm_in_ring_nonempty(shm)) {
+    /* data raced in while arming; a stray doorbell byte at worst */
+    gpr_atm_full_xchg(&shm->in_ring->reader_armed, 0);
+    shm_consume_locked(shm);
+    shm->incoming_buffer = NULL;
+    gpr_mu_unlock(&shm->mu);
+    grpc_closure_sched(exec_ctx, cb, GRPC_ERROR_NONE);
+    return;
+  }
+  shm->read_cb = cb;
+  shm_arm_doorbell_locked(exec_ctx, shm);
+  gpr_mu_unlock(&shm->mu);
+}
+
+static void shm_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
+                      grpc_slice_buffer *buf, grpc_closure *cb) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  gpr_mu_lock(&shm->mu);
+  GPR_ASSERT(shm->write_cb == NULL);
+  if (shm->shutdown) {
+    gpr_mu_unlock(&shm->mu);
+    grpc_closure_sched(
+        exec_ctx, cb,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shared memory endpoint closed"));
+    return;
+  }
+  shm->outgoing_buffer = buf;
+  shm->outgoing_slice_idx = 0;
+  shm->outgoing_byte_idx = 0;
+  if (shm_try_write_locked(shm)) {
+    shm->outgoing_buffer = NULL;
+    gpr_mu_unlock(&shm->mu);
+    grpc_closure_sched(exec_ctx, cb, GRPC_ERROR_NONE);
+    return;
+  }
+  shm->write_cb = cb;
+  shm_arm_doorbell_locked(exec_ctx, shm);
+  gpr_mu_unlock(&shm->mu);
+}
+
+static void shm_add_to_pollset(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
+                               grpc_pollset *pollset) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  grpc_pollset_add_fd(exec_ctx, pollset, shm->em_fd);
+}
+
+static void shm_add_to_pollset_set(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
+                                   grpc_pollset_set *pollset_set) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  grpc_pollset_set_add_fd(exec_ctx, pollset_set, shm->em_fd);
+}
+
+static void shm_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
+                         grpc_error *why) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  gpr_mu_lock(&shm->mu);
+  shm->shutdown = true;
+  gpr_mu_unlock(&shm->mu);
+  grpc_fd_shutdown(exec_ctx, shm->em_fd, why);
+  grpc_resource_user_shutdown(exec_ctx, shm->resource_user);
+}
+
+static void shm_destroy(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  shm_unref(exec_ctx, shm);
+}
+
+static char *shm_get_peer(grpc_endpoint *ep) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  return gpr_strdup(shm->peer_string);
+}
+
+static int shm_get_fd(grpc_endpoint *ep) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  return shm->doorbell_fd;
+}
+
+static grpc_workqueue *shm_get_workqueue(grpc_endpoint *ep) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  return grpc_fd_get_workqueue(shm->em_fd);
+}
+
+static grpc_resource_user *shm_get_resource_user(grpc_endpoint *ep) {
+  grpc_shm *shm = (grpc_shm *)ep;
+  return shm->resource_user;
+}
+
+static const grpc_endpoint_vtable shm_vtable = {shm_read,
+                                                shm_write,
+                                                shm_get_workqueue,
+                                                shm_add_to_pollset,
+                                                shm_add_to_pollset_set,
+                                                shm_shutdown,
+                                                shm_destroy,
+                                                shm_get_resource_user,
+                                                shm_get_peer,
+                                                shm_get_fd};
+
+grpc_endpoint *grpc_shm_endpoint_create(grpc_exec_ctx *exec_ctx, int shm_fd,
+                                        size_t shm_size, int doorbell_fd,
+                                        bool is_initiator,
+                                        const grpc_channel_args *channel_args,
+                                        const char *peer_string) {
+  /* we own both fds even on failure: every early return must close them */
+  uint32_t capacity = shm_ring_capacity_for(shm_size);
+  if (capacity == 0) {
+    gpr_log(GPR_ERROR, "shm segment of %" PRIuPTR " bytes is too small",
+            shm_size);
+    close(shm_fd);
+    close(doorbell_fd);
+    return NULL;
+  }
+  void *mapped =
+      mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+  if (mapped == MAP_FAILED) {
+    gpr_log(GPR_ERROR, "mmap of shm segment failed: %s", strerror(errno));
+    close(shm_fd);
+    close(doorbell_fd);
+    return NULL;
+  }
+  grpc_shm_segment *seg = (grpc_shm_segment *)mapped;
+  if (is_initiator) {
+    memset(seg, 0, sizeof(*seg));
+    seg->ring_capacity = capacity;
+    seg->magic = GRPC_SHM_MAGIC;
+  } else if (seg->magic != GRPC_SHM_MAGIC || seg->ring_capacity != capacity) {
+    gpr_log(GPR_ERROR, "shm segment header mismatch; dropping endpoint");
+    munmap(mapped, shm_size);
+    close(shm_fd);
+    close(doorbell_fd);
+    return NULL;
+  }
+
+  grpc_resource_quota *resource_quota = grpc_resource_quota_create(NULL);
+  if (channel_args != NULL) {
+    for (size_t i = 0; i < channel_args->num_args; i++) {
+      if (0 == strcmp(channel_args->args[i].key, GRPC_ARG_RESOURCE_QUOTA)) {
+        grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
+        resource_quota = grpc_resource_quota_ref_internal(
+            channel_args->args[i].value.pointer.p);
+      }
+    }
+  }
+
+  grpc_shm *shm = (grpc_shm *)gpr_zalloc(sizeof(grpc_shm));
+  shm->base.vtable = &shm_vtable;
+  gpr_mu_init(&shm->mu);
+  /* paired with unref in shm_destroy */
+  gpr_ref_init(&shm->refcount, 1);
+  shm->seg = seg;
+  shm->map_size = shm_size;
+  shm->shm_fd = shm_fd;
+  shm->capacity = capacity;
+  uint8_t *ring_data = (uint8_t *)(seg + 1);
+  shm->out_ring = &seg->rings[is_initiator ? 0 : 1];
+  shm->in_ring = &seg->rings[is_initiator ? 1 : 0];
+  shm->out_data = is_initiator ? ring_data : ring_data + capacity;
+  shm->in_data = is_initiator ? ring_data + capacity : ring_data;
+  shm->doorbell_fd = doorbell_fd;
+  GRPC_LOG_IF_ERROR("shm doorbell nonblocking",
+                    grpc_set_socket_nonblocking(doorbell_fd, 1));
+  shm->em_fd = grpc_fd_create(doorbell_fd, "shm-doorbell");
+  grpc_closure_init(&shm->doorbell_closure, shm_handle_doorbell, shm,
+                    grpc_schedule_on_exec_ctx);
+  shm->peer_string = gpr_strdup(peer_string);
+  shm->resource_user = grpc_resource_user_create(resource_quota, peer_string);
+  grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
+  return &shm->base;
+}
+
+#endif /* GRPC_POSIX_SOCKET */
@@ -0,0 +1,65 @@
+/*
+ *
+ * Copyright 2017, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_SHM_ENDPOINT_POSIX_H
+#define GRPC_CORE_LIB_IOMGR_SHM_ENDPOINT_POSIX_H
+
+#include "src/core/lib/iomgr/port.h"
+
+#include <stdbool.h>
+
+#include "src/core/lib/iomgr/endpoint.h"
+
+/* Create an anonymous shared-memory segment of \a size bytes suitable for
+   grpc_shm_endpoint_create and for passing to another process with
+   grpc_send_fd_over_unix_socket. Returns -1 on failure. */
+int grpc_shm_segment_create(size_t size);
+
+/* Create an endpoint over a shared-memory ring pair in the segment behind
+   \a shm_fd (mapped as \a shm_size bytes in both processes). Payload bytes
+   travel through the segment with no kernel copies; \a doorbell_fd must be
+   one end of a connected socketpair whose other end belongs to the peer's
+   endpoint, and is only written when a side has declared itself idle.
+
+   The initiator creates the segment and its endpoint first (initializing
+   the ring headers), then passes the segment fd and the peer doorbell fd
+   over a unix control connection; the acceptor calls this with
+   is_initiator=false after receiving them. Takes ownership of both fds.
+   Returns NULL if the segment cannot be mapped or validated. */
+grpc_endpoint *grpc_shm_endpoint_create(grpc_exec_ctx *exec_ctx, int shm_fd,
+                                        size_t shm_size, int doorbell_fd,
+                                        bool is_initiator,
+                                        const grpc_channel_args *channel_args,
+                                        const char *peer_string);
+
+#endif /* GRPC_CORE_LIB_IOMGR_SHM_ENDPOINT_POSIX_H */
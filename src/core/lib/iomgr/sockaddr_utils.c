@@ -215,7 +215,12 @@ char *grpc_sockaddr_to_uri(const grpc_resolved_address *resolved_addr) {
   if (grpc_sockaddr_to_string(&path, resolved_addr,
                               false /* suppress errors */) &&
       scheme != NULL) {
-    gpr_asprintf(&uri_str, "%s:%s", scheme, path);
+    /* single-pass into a stack buffer: even bracketed ipv6 URIs fit */
+    char backing[16 + INET6_ADDRSTRLEN + 16];
+    gpr_strbuf sb;
+    gpr_strbuf_init(&sb, backing, sizeof(backing));
+    gpr_strbuf_printf(&sb, "%s:%s", scheme, path);
+    uri_str = gpr_strbuf_take(&sb);
   }
   gpr_free(path);
   return uri_str != NULL ? uri_str : NULL;
@@ -132,6 +132,70 @@ grpc_error *grpc_set_socket_rcvbuf(int fd, int buffer_size_bytes) {
              : GRPC_OS_ERROR(errno, "setsockopt(SO_RCVBUF)");
 }
 
+grpc_error *grpc_set_socket_tcp_keepalive(int fd, int idle_seconds,
+                                          int interval_seconds,
+                                          int probe_count) {
+  int on = 1;
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_KEEPALIVE)");
+  }
+#ifdef TCP_KEEPIDLE
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle_seconds,
+                      sizeof(idle_seconds))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_KEEPIDLE)");
+  }
+#endif
+#ifdef TCP_KEEPINTVL
+  if (interval_seconds > 0 &&
+      0 != setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval_seconds,
+                      sizeof(interval_seconds))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_KEEPINTVL)");
+  }
+#endif
+#ifdef TCP_KEEPCNT
+  if (probe_count > 0 && 0 != setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT,
+                                         &probe_count, sizeof(probe_count))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_KEEPCNT)");
+  }
+#endif
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error *grpc_set_socket_tcp_user_timeout(int fd, int timeout_ms) {
+#ifdef TCP_USER_TIMEOUT
+  return 0 == setsockopt(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &timeout_ms,
+                         sizeof(timeout_ms))
+             ? GRPC_ERROR_NONE
+             : GRPC_OS_ERROR(errno, "setsockopt(TCP_USER_TIMEOUT)");
+#else
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_USER_TIMEOUT unavailable on this platform");
+#endif
+}
+
+grpc_error *grpc_set_socket_busy_poll(int fd, int usec) {
+#ifdef SO_BUSY_POLL
+  return 0 == setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec))
+             ? GRPC_ERROR_NONE
+             : GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+#else
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_BUSY_POLL unavailable on this platform");
+#endif
+}
+
+grpc_error *grpc_set_socket_notsent_lowat(int fd, int bytes) {
+#ifdef TCP_NOTSENT_LOWAT
+  return 0 == setsockopt(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &bytes,
+                         sizeof(bytes))
+             ? GRPC_ERROR_NONE
+             : GRPC_OS_ERROR(errno, "setsockopt(TCP_NOTSENT_LOWAT)");
+#else
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_NOTSENT_LOWAT unavailable on this platform");
+#endif
+}
+
 /* set a socket to close on exec */
 grpc_error *grpc_set_socket_cloexec(int fd, int close_on_exec) {
   int oldflags = fcntl(fd, F_GETFD, 0);
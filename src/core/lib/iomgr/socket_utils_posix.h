@@ -91,6 +91,27 @@ grpc_error *grpc_set_socket_sndbuf(int fd, int buffer_size_bytes);
 /* Tries to set the socket's receive buffer to given size. */
 grpc_error *grpc_set_socket_rcvbuf(int fd, int buffer_size_bytes);
 
+/* Tries to set TCP_NOTSENT_LOWAT to the given number of bytes, so the socket
+   polls writable only once the unsent queue drains below that point. Fails on
+   platforms without the option. */
+grpc_error *grpc_set_socket_notsent_lowat(int fd, int bytes);
+
+/* Arms kernel TCP keepalive: SO_KEEPALIVE plus TCP_KEEPIDLE=idle_seconds.
+   interval_seconds (TCP_KEEPINTVL) and probe_count (TCP_KEEPCNT) are applied
+   only when positive; 0 keeps the kernel defaults. */
+grpc_error *grpc_set_socket_tcp_keepalive(int fd, int idle_seconds,
+                                          int interval_seconds,
+                                          int probe_count);
+
+/* Tries to set TCP_USER_TIMEOUT so unacknowledged transmitted data kills the
+   connection after timeout_ms. Fails on platforms without the option. */
+grpc_error *grpc_set_socket_tcp_user_timeout(int fd, int timeout_ms);
+
+/* Tries to set SO_BUSY_POLL so blocking reads on the socket busy-poll the
+   device queue for up to usec microseconds before sleeping. Needs
+   CAP_NET_ADMIN on most kernels; fails on platforms without the option. */
+grpc_error *grpc_set_socket_busy_poll(int fd, int usec);
+
 /* Tries to set the socket using a grpc_socket_mutator */
 grpc_error *grpc_set_socket_with_mutator(int fd, grpc_socket_mutator *mutator);
 
@@ -52,4 +52,21 @@ void grpc_tcp_client_connect(grpc_exec_ctx *exec_ctx, grpc_closure *on_connect,
                              const grpc_resolved_address *addr,
                              gpr_timespec deadline);
 
+/* Asynchronously connect to any of addrs, racing attempts RFC 8305 style:
+   attempts are started GRPC_TCP_CLIENT_CONNECT_STAGGER_MS apart (a failure
+   starts the next attempt immediately), the first endpoint to establish wins
+   and the losers are shut down. On success *endpoint holds the winner; once
+   every attempt has failed, on_connect runs with an error referencing each
+   attempt's failure and *endpoint is NULL. addrs and channel_args are copied
+   and may be destroyed as soon as this returns. */
+void grpc_tcp_client_connect_list(grpc_exec_ctx *exec_ctx,
+                                  grpc_closure *on_connect,
+                                  grpc_endpoint **endpoint,
+                                  grpc_pollset_set *interested_parties,
+                                  const grpc_channel_args *channel_args,
+                                  const grpc_resolved_addresses *addrs,
+                                  gpr_timespec deadline);
+
+#define GRPC_TCP_CLIENT_CONNECT_STAGGER_MS 250
+
 #endif /* GRPC_CORE_LIB_IOMGR_TCP_CLIENT_H */
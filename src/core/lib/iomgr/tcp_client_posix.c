@@ -88,6 +88,9 @@ static grpc_error *prepare_socket(const grpc_resolved_address *addr, int fd,
   if (!grpc_is_unix_socket(addr)) {
     err = grpc_set_socket_low_latency(fd, 1);
     if (err != GRPC_ERROR_NONE) goto error;
+  } else {
+    err = grpc_tune_unix_socket_buffers(fd);
+    if (err != GRPC_ERROR_NONE) goto error;
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
@@ -339,7 +342,7 @@ static void tcp_client_connect_impl(grpc_exec_ctx *exec_ctx,
   grpc_closure_init(&ac->on_alarm, tc_on_alarm, ac, grpc_schedule_on_exec_ctx);
   grpc_timer_init(exec_ctx, &ac->alarm,
                   gpr_convert_clock_type(deadline, GPR_CLOCK_MONOTONIC),
-                  &ac->on_alarm, gpr_now(GPR_CLOCK_MONOTONIC));
+                  &ac->on_alarm, grpc_exec_ctx_now(exec_ctx));
   grpc_fd_notify_on_write(exec_ctx, ac->fd, &ac->write_closure);
   gpr_mu_unlock(&ac->mu);
 
@@ -366,3 +369,199 @@ void grpc_tcp_client_connect(grpc_exec_ctx *exec_ctx, grpc_closure *closure,
 }
 
 #endif
+
+/* The happy-eyeballs racing layer below is built purely on
+   grpc_tcp_client_connect and grpc_timer, so it is platform independent. It
+   lives outside the port guard: every platform compiles this file, and this
+   section is its only contribution on non-POSIX builds. */
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/tcp_client.h"
+#include "src/core/lib/iomgr/timer.h"
+
+typedef struct connect_race connect_race;
+
+typedef struct {
+  connect_race *race;
+  grpc_endpoint *endpoint;
+  grpc_closure on_connected;
+} connect_attempt;
+
+struct connect_race {
+  gpr_mu mu;
+  gpr_refcount refs;
+  grpc_closure *on_connect;
+  grpc_endpoint **endpoint;
+  grpc_pollset_set *interested_parties;
+  grpc_channel_args *channel_args;
+  gpr_timespec deadline;
+  connect_attempt *attempts;
+  grpc_resolved_address *addrs;
+  size_t naddrs;
+  /** index of the next attempt to launch */
+  size_t next_attempt;
+  /** attempts launched and not yet completed */
+  size_t pending;
+  /** set once the race has been decided (either way) */
+  bool done;
+  bool stagger_armed;
+  grpc_timer stagger_timer;
+  grpc_closure on_stagger;
+  /** failures gathered so far, reported if every attempt loses */
+  grpc_error *error;
+};
+
+static void race_on_connected(grpc_exec_ctx *exec_ctx, void *arg,
+                              grpc_error *error);
+
+static void race_unref(grpc_exec_ctx *exec_ctx, connect_race *race) {
+  if (gpr_unref(&race->refs)) {
+    gpr_mu_destroy(&race->mu);
+    grpc_channel_args_destroy(exec_ctx, race->channel_args);
+    GRPC_ERROR_UNREF(race->error);
+    gpr_free(race);
+  }
+}
+
+static void race_start_next_locked(grpc_exec_ctx *exec_ctx,
+                                   connect_race *race) {
+  connect_attempt *attempt = &race->attempts[race->next_attempt];
+  attempt->race = race;
+  attempt->endpoint = NULL;
+  grpc_closure_init(&attempt->on_connected, race_on_connected, attempt,
+                    grpc_schedule_on_exec_ctx);
+  race->pending++;
+  gpr_ref(&race->refs);
+  grpc_tcp_client_connect(exec_ctx, &attempt->on_connected,
+                          &attempt->endpoint, race->interested_parties,
+                          race->channel_args,
+                          &race->addrs[race->next_attempt], race->deadline);
+  race->next_attempt++;
+}
+
+static void race_arm_stagger_locked(grpc_exec_ctx *exec_ctx,
+                                    connect_race *race) {
+  if (race->next_attempt >= race->naddrs) return;
+  gpr_timespec now = grpc_exec_ctx_now(exec_ctx);
+  race->stagger_armed = true;
+  gpr_ref(&race->refs);
+  grpc_timer_init(
+      exec_ctx, &race->stagger_timer,
+      gpr_time_add(now, gpr_time_from_millis(
+                            GRPC_TCP_CLIENT_CONNECT_STAGGER_MS, GPR_TIMESPAN)),
+      &race->on_stagger, now);
+}
+
+static void race_on_stagger(grpc_exec_ctx *exec_ctx, void *arg,
+                            grpc_error *error) {
+  connect_race *race = arg;
+  gpr_mu_lock(&race->mu);
+  race->stagger_armed = false;
+  if (error == GRPC_ERROR_NONE && !race->done &&
+      race->next_attempt < race->naddrs) {
+    race_start_next_locked(exec_ctx, race);
+    race_arm_stagger_locked(exec_ctx, race);
+  }
+  gpr_mu_unlock(&race->mu);
+  race_unref(exec_ctx, race);
+}
+
+static void race_cancel_stagger_locked(grpc_exec_ctx *exec_ctx,
+                                       connect_race *race) {
+  if (race->stagger_armed) {
+    race->stagger_armed = false;
+    grpc_timer_cancel(exec_ctx, &race->stagger_timer);
+  }
+}
+
+static void race_on_connected(grpc_exec_ctx *exec_ctx, void *arg,
+                              grpc_error *error) {
+  connect_attempt *attempt = arg;
+  connect_race *race = attempt->race;
+  gpr_mu_lock(&race->mu);
+  race->pending--;
+  if (error == GRPC_ERROR_NONE && attempt->endpoint != NULL) {
+    if (!race->done) {
+      race->done = true;
+      race_cancel_stagger_locked(exec_ctx, race);
+      *race->endpoint = attempt->endpoint;
+      grpc_closure_sched(exec_ctx, race->on_connect, GRPC_ERROR_NONE);
+    } else {
+      /* lost the race: the winner has already been handed off */
+      grpc_endpoint_shutdown(exec_ctx, attempt->endpoint,
+                             GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                 "Connection attempt lost the race"));
+      grpc_endpoint_destroy(exec_ctx, attempt->endpoint);
+    }
+  } else {
+    race->error = grpc_error_add_child(race->error, GRPC_ERROR_REF(error));
+    if (!race->done) {
+      if (race->next_attempt < race->naddrs) {
+        /* a failure starts the next attempt immediately; restart the stagger
+           clock behind it */
+        race_cancel_stagger_locked(exec_ctx, race);
+        race_start_next_locked(exec_ctx, race);
+        race_arm_stagger_locked(exec_ctx, race);
+      } else if (race->pending == 0) {
+        race->done = true;
+        *race->endpoint = NULL;
+        grpc_closure_sched(exec_ctx, race->on_connect, race->error);
+        race->error = GRPC_ERROR_NONE;
+      }
+    }
+  }
+  gpr_mu_unlock(&race->mu);
+  race_unref(exec_ctx, race);
+}
+
+void grpc_tcp_client_connect_list(grpc_exec_ctx *exec_ctx,
+                                  grpc_closure *on_connect,
+                                  grpc_endpoint **endpoint,
+                                  grpc_pollset_set *interested_parties,
+                                  const grpc_channel_args *channel_args,
+                                  const grpc_resolved_addresses *addrs,
+                                  gpr_timespec deadline) {
+  if (addrs == NULL || addrs->naddrs == 0) {
+    *endpoint = NULL;
+    grpc_closure_sched(
+        exec_ctx, on_connect,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("No addresses to connect to"));
+    return;
+  }
+  if (addrs->naddrs == 1) {
+    grpc_tcp_client_connect(exec_ctx, on_connect, endpoint, interested_parties,
+                            channel_args, &addrs->addrs[0], deadline);
+    return;
+  }
+  connect_race *race =
+      gpr_zalloc(sizeof(*race) +
+                 addrs->naddrs * (sizeof(connect_attempt) +
+                                  sizeof(grpc_resolved_address)));
+  race->attempts = (connect_attempt *)(race + 1);
+  race->addrs = (grpc_resolved_address *)(race->attempts + addrs->naddrs);
+  memcpy(race->addrs, addrs->addrs,
+         addrs->naddrs * sizeof(grpc_resolved_address));
+  race->naddrs = addrs->naddrs;
+  gpr_mu_init(&race->mu);
+  gpr_ref_init(&race->refs, 1);
+  race->on_connect = on_connect;
+  race->endpoint = endpoint;
+  race->interested_parties = interested_parties;
+  race->channel_args = grpc_channel_args_copy(channel_args);
+  race->deadline = deadline;
+  race->error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Failed to connect to all addresses");
+  grpc_closure_init(&race->on_stagger, race_on_stagger, race,
+                    grpc_schedule_on_exec_ctx);
+  gpr_mu_lock(&race->mu);
+  race_start_next_locked(exec_ctx, race);
+  race_arm_stagger_locked(exec_ctx, race);
+  gpr_mu_unlock(&race->mu);
+  race_unref(exec_ctx, race);
+}
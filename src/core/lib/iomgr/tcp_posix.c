@@ -39,6 +39,7 @@
 #include "src/core/lib/iomgr/tcp_posix.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
@@ -57,10 +58,12 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/support/string.h"
+#include "src/core/lib/iomgr/unix_sockets_posix.h"
 
 #ifdef GRPC_HAVE_MSG_NOSIGNAL
 #define SENDMSG_FLAGS MSG_NOSIGNAL
@@ -68,6 +71,18 @@
 #define SENDMSG_FLAGS 0
 #endif
 
+#ifdef GRPC_LINUX_ERRQUEUE
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+
+/* default for GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD */
+#define TCP_TX_ZEROCOPY_DEFAULT_SEND_BYTES_THRESHOLD (16 * 1024)
+/* maximum number of zero-copy sends awaiting a kernel completion; must be a
+   power of two so the kernel's 32 bit sequence numbers index the ring cleanly
+   across wraparound */
+#define TCP_TX_ZEROCOPY_MAX_SENDS 64
+#endif
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -76,6 +91,17 @@ typedef size_t msg_iovlen_type;
 
 grpc_tracer_flag grpc_tcp_trace = GRPC_TRACER_INITIALIZER(false);
 
+#ifdef GRPC_LINUX_ERRQUEUE
+/* One zero-copy sendmsg whose pages the kernel still references. We hold refs
+   on the sent slices until the corresponding MSG_ERRQUEUE completion arrives.
+   The kernel numbers zero-copy sends on a socket sequentially from zero, so
+   record N lives at slot N % TCP_TX_ZEROCOPY_MAX_SENDS. */
+typedef struct {
+  grpc_slice_buffer slices;
+  bool in_use;
+} tcp_zerocopy_send_record;
+#endif
+
 typedef struct {
   grpc_endpoint base;
   grpc_fd *em_fd;
@@ -84,12 +110,28 @@ typedef struct {
   msg_iovlen_type iov_size; /* Number of slices to allocate per read attempt */
   double target_length;
   double bytes_read_this_round;
+  /* refcount and shutdown_count are poked from arbitrary threads; keep them
+     off the cachelines carrying the read/write hot path state */
+  GPR_CACHELINE_PAD(0);
   gpr_refcount refcount;
   gpr_atm shutdown_count;
+  GPR_CACHELINE_PAD(1);
 
   int min_read_chunk_size;
   int max_read_chunk_size;
 
+  /* low-watermark write admission: when non-zero, TCP_NOTSENT_LOWAT is set on
+     the socket and each flush stops after roughly this many bytes instead of
+     writing until EAGAIN, so queued frames wait here (where the transport can
+     still reorder them) rather than in the kernel */
+  int notsent_lowat;
+
+  /* pooled-slab read mode: read into fixed-size slabs with one scatter
+     recvmsg; slabs the kernel did not fill are recycled via last_read_buffer
+     so steady-state reads need no fresh allocation */
+  bool pooled_read_slabs;
+  int read_slab_size;
+
   /* garbage after the last read */
   grpc_slice_buffer last_read_buffer;
 
@@ -112,6 +154,16 @@ typedef struct {
 
   grpc_resource_user *resource_user;
   grpc_resource_user_slice_allocator slice_allocator;
+  /* application-supplied read-slice allocator; owns a plugin ref */
+  grpc_slice_allocator_plugin *slice_plugin;
+
+#ifdef GRPC_LINUX_ERRQUEUE
+  bool tx_zerocopy_enabled;
+  int tx_zerocopy_send_threshold;
+  uint32_t tx_zerocopy_next_seq;
+  int tx_zerocopy_outstanding;
+  tcp_zerocopy_send_record tx_zerocopy_sends[TCP_TX_ZEROCOPY_MAX_SENDS];
+#endif
 } grpc_tcp;
 
 static void add_to_estimate(grpc_tcp *tcp, size_t bytes) {
@@ -161,6 +213,10 @@ static void tcp_handle_read(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
                             grpc_error *error);
 static void tcp_handle_write(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
                              grpc_error *error);
+#ifdef GRPC_LINUX_ERRQUEUE
+static void tcp_drain_zerocopy_completions(grpc_exec_ctx *exec_ctx,
+                                           grpc_tcp *tcp);
+#endif
 
 static void tcp_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
                          grpc_error *why) {
@@ -172,8 +228,19 @@ static void tcp_shutdown(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
 static void tcp_free(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   grpc_fd_orphan(exec_ctx, tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
+#ifdef GRPC_LINUX_ERRQUEUE
+  /* Completions for sends still in flight will never be read now; closing the
+     fd releases the kernel's page references, so dropping ours is safe. */
+  for (size_t i = 0; i < TCP_TX_ZEROCOPY_MAX_SENDS; i++) {
+    grpc_slice_buffer_destroy_internal(exec_ctx,
+                                       &tcp->tx_zerocopy_sends[i].slices);
+  }
+#endif
   grpc_slice_buffer_destroy_internal(exec_ctx, &tcp->last_read_buffer);
   grpc_resource_user_unref(exec_ctx, tcp->resource_user);
+  if (tcp->slice_plugin != NULL) {
+    grpc_slice_allocator_plugin_unref(tcp->slice_plugin);
+  }
   gpr_free(tcp->peer_string);
   gpr_free(tcp);
 }
@@ -239,7 +306,7 @@ static void call_read_cb(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp,
   grpc_closure_run(exec_ctx, cb, error);
 }
 
-#define MAX_READ_IOVEC 4
+#define MAX_READ_IOVEC 64
 static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   struct msghdr msg;
   struct iovec iov[MAX_READ_IOVEC];
@@ -259,7 +326,7 @@ static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   msg.msg_name = NULL;
   msg.msg_namelen = 0;
   msg.msg_iov = iov;
-  msg.msg_iovlen = tcp->iov_size;
+  msg.msg_iovlen = (msg_iovlen_type)tcp->incoming_buffer->count;
   msg.msg_control = NULL;
   msg.msg_controllen = 0;
   msg.msg_flags = 0;
@@ -269,6 +336,7 @@ static void tcp_do_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
     read_bytes = recvmsg(tcp->fd, &msg, 0);
   } while (read_bytes < 0 && errno == EINTR);
   GPR_TIMER_END("recvmsg", read_bytes >= 0);
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_READS);
 
   if (read_bytes < 0) {
     /* NB: After calling call_read_cb a parallel call of the read handler may
@@ -327,8 +395,24 @@ static void tcp_continue_read(grpc_exec_ctx *exec_ctx, grpc_tcp *tcp) {
   size_t target_read_size = get_target_read_size(tcp);
   if (tcp->incoming_buffer->length < target_read_size &&
       tcp->incoming_buffer->count < MAX_READ_IOVEC) {
-    grpc_resource_user_alloc_slices(exec_ctx, &tcp->slice_allocator,
-                                    target_read_size, 1, tcp->incoming_buffer);
+    if (tcp->pooled_read_slabs) {
+      /* Top up the iovec ring with slabs in one allocator call; any slabs
+         recycled from the previous read are already in incoming_buffer. The
+         slab count tracks the same moving-average target as the single-slice
+         path. */
+      size_t slab_size = (size_t)tcp->read_slab_size;
+      size_t needed =
+          (target_read_size - tcp->incoming_buffer->length + slab_size - 1) /
+          slab_size;
+      size_t room = MAX_READ_IOVEC - tcp->incoming_buffer->count;
+      if (needed > room) needed = room;
+      grpc_resource_user_alloc_slices(exec_ctx, &tcp->slice_allocator,
+                                      slab_size, needed, tcp->incoming_buffer);
+    } else {
+      grpc_resource_user_alloc_slices(exec_ctx, &tcp->slice_allocator,
+                                      target_read_size, 1,
+                                      tcp->incoming_buffer);
+    }
   } else {
     tcp_do_read(exec_ctx, tcp);
   }
@@ -367,8 +451,73 @@ static void tcp_read(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
   }
 }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+/* Reap zero-copy send completions from the socket error queue, releasing the
+   slice refs held for the acknowledged sends. Called ONLY from the write
+   path (grpc_tcp_write/tcp_handle_write), which the endpoint contract
+   serializes - at most one write is outstanding at a time and successive
+   writes are ordered through the write closure - so the completion records
+   need no locking. The read path must not drain: it runs concurrently on a
+   different pollset thread. Completions that arrive while no write is
+   pending stay queued until the next write (or until tcp_free), which only
+   delays the memory release. */
+static void tcp_drain_zerocopy_completions(grpc_exec_ctx *exec_ctx,
+                                           grpc_tcp *tcp) {
+  struct msghdr msg;
+  char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+
+  while (tcp->tx_zerocopy_outstanding > 0) {
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t r;
+    do {
+      r = recvmsg(tcp->fd, &msg, MSG_ERRQUEUE);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) return; /* EAGAIN: the error queue is drained */
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+            (cmsg->cmsg_level == SOL_IPV6 &&
+             cmsg->cmsg_type == IPV6_RECVERR))) {
+        continue;
+      }
+      struct sock_extended_err *serr =
+          (struct sock_extended_err *)CMSG_DATA(cmsg);
+      if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      /* ee_info..ee_data is an inclusive range of completed send sequence
+         numbers (mod 2^32) */
+      uint32_t seq = serr->ee_info;
+      for (;;) {
+        tcp_zerocopy_send_record *record =
+            &tcp->tx_zerocopy_sends[seq % TCP_TX_ZEROCOPY_MAX_SENDS];
+        if (record->in_use) {
+          grpc_slice_buffer_reset_and_unref_internal(exec_ctx,
+                                                     &record->slices);
+          record->in_use = false;
+          tcp->tx_zerocopy_outstanding--;
+        }
+        if (seq == serr->ee_data) break;
+        seq++;
+      }
+    }
+  }
+}
+#endif
+
 /* returns true if done, false if pending; if returning true, *error is set */
 #define MAX_WRITE_IOVEC 1000
+#ifdef GRPC_HAVE_SENDMMSG
+/* when a write spans more slices than one iovec array can carry, submit up to
+   this many msghdr chunks in a single sendmmsg call instead of looping one
+   sendmsg per chunk */
+#define MAX_WRITE_MSGS 4
+#define EXTRA_WRITE_IOVEC 256
+#endif
 static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
   struct msghdr msg;
   struct iovec iov[MAX_WRITE_IOVEC];
@@ -378,6 +527,7 @@ static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
   size_t trailing;
   size_t unwind_slice_idx;
   size_t unwind_byte_idx;
+  size_t sent_this_flush = 0;
 
   for (;;) {
     sending_length = 0;
@@ -400,22 +550,104 @@ static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
     }
     GPR_ASSERT(iov_size > 0);
 
-    msg.msg_name = NULL;
-    msg.msg_namelen = 0;
-    msg.msg_iov = iov;
-    msg.msg_iovlen = iov_size;
-    msg.msg_control = NULL;
-    msg.msg_controllen = 0;
-    msg.msg_flags = 0;
+    int sendmsg_flags = SENDMSG_FLAGS;
+#ifdef GRPC_LINUX_ERRQUEUE
+    size_t iov_end_slice_idx = tcp->outgoing_slice_idx;
+    tcp_zerocopy_send_record *zc_record = NULL;
+    if (tcp->tx_zerocopy_enabled &&
+        sending_length >= (size_t)tcp->tx_zerocopy_send_threshold) {
+      zc_record = &tcp->tx_zerocopy_sends[tcp->tx_zerocopy_next_seq %
+                                          TCP_TX_ZEROCOPY_MAX_SENDS];
+      if (zc_record->in_use) {
+        /* too many sends awaiting completions: copy rather than stall */
+        zc_record = NULL;
+      } else {
+        sendmsg_flags |= MSG_ZEROCOPY;
+      }
+    }
+#endif
 
-    GPR_TIMER_BEGIN("sendmsg", 1);
-    do {
-      /* TODO(klempner): Cork if this is a partial write */
-      sent_length = sendmsg(tcp->fd, &msg, SENDMSG_FLAGS);
-    } while (sent_length < 0 && errno == EINTR);
-    GPR_TIMER_END("sendmsg", 0);
+#ifdef GRPC_HAVE_SENDMMSG
+    bool batch_msgs = tcp->outgoing_slice_idx != tcp->outgoing_buffer->count &&
+                      iov_size == MAX_WRITE_IOVEC;
+#ifdef GRPC_LINUX_ERRQUEUE
+    /* each zero-copy send needs its own completion record; don't batch */
+    if (zc_record != NULL) batch_msgs = false;
+#endif
+    if (batch_msgs) {
+      struct mmsghdr msgs[MAX_WRITE_MSGS];
+      struct iovec extra_iov[MAX_WRITE_MSGS - 1][EXTRA_WRITE_IOVEC];
+      unsigned nmsgs = 1;
+      memset(msgs, 0, sizeof(msgs));
+      msgs[0].msg_hdr.msg_iov = iov;
+      msgs[0].msg_hdr.msg_iovlen = iov_size;
+      while (nmsgs < MAX_WRITE_MSGS &&
+             tcp->outgoing_slice_idx != tcp->outgoing_buffer->count) {
+        struct iovec *eiov = extra_iov[nmsgs - 1];
+        msg_iovlen_type eiov_size = 0;
+        for (; tcp->outgoing_slice_idx != tcp->outgoing_buffer->count &&
+               eiov_size != EXTRA_WRITE_IOVEC;
+             eiov_size++) {
+          eiov[eiov_size].iov_base = GRPC_SLICE_START_PTR(
+              tcp->outgoing_buffer->slices[tcp->outgoing_slice_idx]);
+          eiov[eiov_size].iov_len = GRPC_SLICE_LENGTH(
+              tcp->outgoing_buffer->slices[tcp->outgoing_slice_idx]);
+          sending_length += eiov[eiov_size].iov_len;
+          tcp->outgoing_slice_idx++;
+        }
+        msgs[nmsgs].msg_hdr.msg_iov = eiov;
+        msgs[nmsgs].msg_hdr.msg_iovlen = eiov_size;
+        nmsgs++;
+      }
+
+      int nsent;
+      GPR_TIMER_BEGIN("sendmmsg", 1);
+      do {
+        nsent = sendmmsg(tcp->fd, msgs, nmsgs, sendmsg_flags);
+      } while (nsent < 0 && errno == EINTR);
+      GPR_TIMER_END("sendmmsg", 0);
+
+      if (nsent < 0) {
+        sent_length = -1;
+      } else {
+        sent_length = 0;
+        for (int mi = 0; mi < nsent; mi++) {
+          sent_length += (ssize_t)msgs[mi].msg_len;
+        }
+      }
+    } else {
+#endif
+      msg.msg_name = NULL;
+      msg.msg_namelen = 0;
+      msg.msg_iov = iov;
+      msg.msg_iovlen = iov_size;
+      msg.msg_control = NULL;
+      msg.msg_controllen = 0;
+      msg.msg_flags = 0;
+
+      GPR_TIMER_BEGIN("sendmsg", 1);
+      do {
+        /* TODO(klempner): Cork if this is a partial write */
+        sent_length = sendmsg(tcp->fd, &msg, sendmsg_flags);
+      } while (sent_length < 0 && errno == EINTR);
+      GPR_TIMER_END("sendmsg", 0);
+      GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_WRITES);
+#ifdef GRPC_HAVE_SENDMMSG
+    }
+#endif
 
     if (sent_length < 0) {
+#ifdef GRPC_LINUX_ERRQUEUE
+      if (errno == ENOBUFS && zc_record != NULL) {
+        /* The kernel cannot pin more pages (commonly the locked-memory
+           rlimit): give up on zero-copy for this endpoint and retry the same
+           bytes down the copying path. */
+        tcp->tx_zerocopy_enabled = false;
+        tcp->outgoing_slice_idx = unwind_slice_idx;
+        tcp->outgoing_byte_idx = unwind_byte_idx;
+        continue;
+      }
+#endif
       if (errno == EAGAIN) {
         tcp->outgoing_slice_idx = unwind_slice_idx;
         tcp->outgoing_byte_idx = unwind_byte_idx;
@@ -431,6 +663,22 @@ static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
       }
     }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+    if (zc_record != NULL) {
+      /* The kernel now references the pages behind these slices: hold refs on
+         everything the iov covered (a superset of the bytes actually sent)
+         until the completion for this sequence number arrives. */
+      for (size_t i = unwind_slice_idx; i < iov_end_slice_idx; i++) {
+        grpc_slice_buffer_add(
+            &zc_record->slices,
+            grpc_slice_ref_internal(tcp->outgoing_buffer->slices[i]));
+      }
+      zc_record->in_use = true;
+      tcp->tx_zerocopy_next_seq++;
+      tcp->tx_zerocopy_outstanding++;
+    }
+#endif
+
     GPR_ASSERT(tcp->outgoing_byte_idx == 0);
     trailing = sending_length - (size_t)sent_length;
     while (trailing > 0) {
@@ -451,6 +699,16 @@ static bool tcp_flush(grpc_tcp *tcp, grpc_error **error) {
       *error = GRPC_ERROR_NONE;
       return true;
     }
+
+    /* low-watermark admission: with TCP_NOTSENT_LOWAT set, EPOLLOUT arrives
+       only once the unsent queue drains below the watermark, so handing the
+       kernel ~one watermark's worth per wakeup keeps total queued bytes
+       shallow. Report "not flushed" as if we had hit EAGAIN. */
+    sent_this_flush += (size_t)sent_length;
+    if (tcp->notsent_lowat > 0 &&
+        sent_this_flush >= (size_t)tcp->notsent_lowat) {
+      return false;
+    }
   };
 }
 
@@ -467,6 +725,10 @@ static void tcp_handle_write(grpc_exec_ctx *exec_ctx, void *arg /* grpc_tcp */,
     return;
   }
 
+#ifdef GRPC_LINUX_ERRQUEUE
+  tcp_drain_zerocopy_completions(exec_ctx, tcp);
+#endif
+
   if (!tcp_flush(tcp, &error)) {
     if (GRPC_TRACER_ON(grpc_tcp_trace)) {
       gpr_log(GPR_DEBUG, "write: delayed");
@@ -514,6 +776,10 @@ static void tcp_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *ep,
             : GRPC_ERROR_NONE);
     return;
   }
+#ifdef GRPC_LINUX_ERRQUEUE
+  tcp_drain_zerocopy_completions(exec_ctx, tcp);
+#endif
+
   tcp->outgoing_buffer = buf;
   tcp->outgoing_slice_idx = 0;
   tcp->outgoing_byte_idx = 0;
@@ -581,13 +847,36 @@ static const grpc_endpoint_vtable vtable = {tcp_read,
 
 #define MAX_CHUNK_SIZE 32 * 1024 * 1024
 
+/* Default read target for unix sockets: there is no wire to pace against
+   and the peer is a local process, so much larger reads amortize syscall
+   and slice overhead without any bufferbloat risk. Channel args still
+   override this. */
+#define UDS_DEFAULT_READ_SLICE_SIZE (64 * 1024)
+
 grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
                                const grpc_channel_args *channel_args,
                                const char *peer_string) {
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
+  int tcp_pooled_read_slabs = 0;
+  int tcp_notsent_lowat = 0;
+  int tcp_keepalive_time = 0;
+  int tcp_keepalive_interval = 0;
+  int tcp_keepalive_probes = 0;
+  int tcp_user_timeout = 0;
+  int tcp_priority_polling = 0;
+  int tcp_busy_poll_usec = 0;
+#ifdef GRPC_LINUX_ERRQUEUE
+  int tcp_tx_zerocopy_enabled = 0;
+  int tcp_tx_zerocopy_send_threshold =
+      TCP_TX_ZEROCOPY_DEFAULT_SEND_BYTES_THRESHOLD;
+#endif
   grpc_resource_quota *resource_quota = grpc_resource_quota_create(NULL);
+  grpc_slice_allocator_plugin *slice_plugin = NULL;
+  if (grpc_is_unix_socket_fd(grpc_fd_wrapped_fd(em_fd))) {
+    tcp_read_chunk_size = UDS_DEFAULT_READ_SLICE_SIZE;
+  }
   if (channel_args != NULL) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
       if (0 ==
@@ -608,11 +897,64 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
                                         MAX_CHUNK_SIZE};
         tcp_max_read_chunk_size =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_POOLED_READ_SLABS)) {
+        tcp_pooled_read_slabs =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_NOTSENT_LOWAT)) {
+        grpc_integer_options options = {0, 0, MAX_CHUNK_SIZE};
+        tcp_notsent_lowat =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_KEEPALIVE_TIME_S)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_keepalive_time =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_KEEPALIVE_INTERVAL_S)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_keepalive_interval =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_KEEPALIVE_PROBES)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_keepalive_probes =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_USER_TIMEOUT_MS)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_user_timeout =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_PRIORITY_POLLING)) {
+        tcp_priority_polling =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_BUSY_POLL_US)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        tcp_busy_poll_usec =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+#ifdef GRPC_LINUX_ERRQUEUE
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED)) {
+        tcp_tx_zerocopy_enabled =
+            grpc_channel_arg_get_bool(&channel_args->args[i], false);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_TX_ZEROCOPY_SEND_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {
+            TCP_TX_ZEROCOPY_DEFAULT_SEND_BYTES_THRESHOLD, 0, MAX_CHUNK_SIZE};
+        tcp_tx_zerocopy_send_threshold =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+#endif
       } else if (0 ==
                  strcmp(channel_args->args[i].key, GRPC_ARG_RESOURCE_QUOTA)) {
         grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
         resource_quota = grpc_resource_quota_ref_internal(
             channel_args->args[i].value.pointer.p);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_READ_SLICE_ALLOCATOR)) {
+        slice_plugin = channel_args->args[i].value.pointer.p;
       }
     }
   }
@@ -636,12 +978,68 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   tcp->min_read_chunk_size = tcp_min_read_chunk_size;
   tcp->max_read_chunk_size = tcp_max_read_chunk_size;
   tcp->bytes_read_this_round = 0;
+  tcp->pooled_read_slabs = tcp_pooled_read_slabs != 0;
+  tcp->read_slab_size = tcp_read_chunk_size;
+  tcp->notsent_lowat = 0;
+  if (tcp_notsent_lowat > 0) {
+    grpc_error *err =
+        grpc_set_socket_notsent_lowat(tcp->fd, tcp_notsent_lowat);
+    if (err == GRPC_ERROR_NONE) {
+      tcp->notsent_lowat = tcp_notsent_lowat;
+    } else {
+      /* without the socket option the flush cap would only add wakeups */
+      GRPC_LOG_IF_ERROR("setting TCP_NOTSENT_LOWAT", err);
+    }
+  }
+  if (tcp_keepalive_time > 0 && !grpc_is_unix_socket_fd(tcp->fd)) {
+    GRPC_LOG_IF_ERROR(
+        "arming kernel tcp keepalive",
+        grpc_set_socket_tcp_keepalive(tcp->fd, tcp_keepalive_time,
+                                      tcp_keepalive_interval,
+                                      tcp_keepalive_probes));
+  }
+  if (tcp_user_timeout > 0 && !grpc_is_unix_socket_fd(tcp->fd)) {
+    GRPC_LOG_IF_ERROR(
+        "setting TCP_USER_TIMEOUT",
+        grpc_set_socket_tcp_user_timeout(tcp->fd, tcp_user_timeout));
+  }
   tcp->iov_size = 1;
   tcp->finished_edge = true;
   /* paired with unref in grpc_tcp_destroy */
   gpr_ref_init(&tcp->refcount, 1);
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
   tcp->em_fd = em_fd;
+  if (tcp_priority_polling) {
+    grpc_fd_set_priority(em_fd, true);
+  }
+  if (tcp_busy_poll_usec > 0) {
+    if (!grpc_is_unix_socket_fd(tcp->fd)) {
+      /* kernel-side busy poll is best-effort: most kernels demand
+         CAP_NET_ADMIN, and the poller-side spin still helps without it */
+      GRPC_LOG_IF_ERROR(
+          "setting SO_BUSY_POLL",
+          grpc_set_socket_busy_poll(tcp->fd, tcp_busy_poll_usec));
+    }
+    grpc_fd_set_busy_poll(em_fd, tcp_busy_poll_usec);
+  }
+#ifdef GRPC_LINUX_ERRQUEUE
+  tcp->tx_zerocopy_next_seq = 0;
+  tcp->tx_zerocopy_outstanding = 0;
+  for (size_t i = 0; i < TCP_TX_ZEROCOPY_MAX_SENDS; i++) {
+    grpc_slice_buffer_init(&tcp->tx_zerocopy_sends[i].slices);
+    tcp->tx_zerocopy_sends[i].in_use = false;
+  }
+  if (tcp_tx_zerocopy_enabled) {
+    const int enable = 1;
+    if (setsockopt(tcp->fd, SOL_SOCKET, SO_ZEROCOPY, &enable,
+                   sizeof(enable)) != 0) {
+      /* pre-4.14 kernel: silently fall back to the copying path */
+      tcp_tx_zerocopy_enabled = 0;
+    }
+  }
+  tcp->tx_zerocopy_enabled = tcp_tx_zerocopy_enabled != 0;
+  tcp->tx_zerocopy_send_threshold = tcp_tx_zerocopy_send_threshold;
+#endif
   grpc_closure_init(&tcp->read_closure, tcp_handle_read, tcp,
                     grpc_schedule_on_exec_ctx);
   grpc_closure_init(&tcp->write_closure, tcp_handle_write, tcp,
@@ -650,6 +1048,11 @@ grpc_endpoint *grpc_tcp_create(grpc_exec_ctx *exec_ctx, grpc_fd *em_fd,
   tcp->resource_user = grpc_resource_user_create(resource_quota, peer_string);
   grpc_resource_user_slice_allocator_init(
       &tcp->slice_allocator, tcp->resource_user, tcp_read_allocation_done, tcp);
+  tcp->slice_plugin = NULL;
+  if (slice_plugin != NULL) {
+    tcp->slice_plugin = grpc_slice_allocator_plugin_ref(slice_plugin);
+    tcp->slice_allocator.plugin = tcp->slice_plugin;
+  }
   /* Tell network status tracker about new endpoint */
   grpc_network_status_register_endpoint(&tcp->base);
   grpc_resource_quota_unref_internal(exec_ctx, resource_quota);
@@ -53,6 +53,7 @@
 #include <unistd.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
@@ -102,6 +103,15 @@ grpc_error *grpc_tcp_server_create(grpc_exec_ctx *exec_ctx,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(GRPC_ARG_ALLOW_REUSEPORT
                                                     " must be an integer");
       }
+    } else if (0 ==
+               strcmp(GRPC_ARG_SERVER_CPU_POLLSET_AFFINITY, args->args[i].key)) {
+      if (args->args[i].type == GRPC_ARG_INTEGER) {
+        s->cpu_pollset_affinity = (args->args[i].value.integer != 0);
+      } else {
+        gpr_free(s);
+        return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            GRPC_ARG_SERVER_CPU_POLLSET_AFFINITY " must be an integer");
+      }
     } else if (0 == strcmp(GRPC_ARG_EXPAND_WILDCARD_ADDRS, args->args[i].key)) {
       if (args->args[i].type == GRPC_ARG_INTEGER) {
         s->expand_wildcard_addrs = (args->args[i].value.integer != 0);
@@ -218,10 +228,17 @@ static void on_read(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *err) {
     goto error;
   }
 
+  /* With cpu_pollset_affinity, key the pollset choice on the CPU running this
+     accept: with SO_REUSEPORT cloned listeners the kernel already steered the
+     connection to a local poller, so this keeps its polling on the same
+     core/node instead of bouncing it round-robin across sockets. */
   grpc_pollset *read_notifier_pollset =
-      sp->server->pollsets[(size_t)gpr_atm_no_barrier_fetch_add(
-                               &sp->server->next_pollset_to_assign, 1) %
-                           sp->server->pollset_count];
+      sp->server->cpu_pollset_affinity
+          ? sp->server
+                ->pollsets[gpr_cpu_current_cpu() % sp->server->pollset_count]
+          : sp->server->pollsets[(size_t)gpr_atm_no_barrier_fetch_add(
+                                     &sp->server->next_pollset_to_assign, 1) %
+                                 sp->server->pollset_count];
 
   /* loop until accept4 returns EAGAIN, and then re-arm notification */
   for (;;) {
@@ -83,6 +83,9 @@ struct grpc_tcp_server {
   bool so_reuseport;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs;
+  /* key accepted connections to the accepting CPU's pollset rather than
+     round-robin */
+  bool cpu_pollset_affinity;
 
   /* linked list of server ports */
   grpc_tcp_listener *head;
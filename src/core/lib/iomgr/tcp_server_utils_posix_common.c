@@ -179,6 +179,10 @@ grpc_error *grpc_tcp_server_prepare_socket(int fd,
     if (err != GRPC_ERROR_NONE) goto error;
     err = grpc_set_socket_reuse_addr(fd, 1);
     if (err != GRPC_ERROR_NONE) goto error;
+  } else {
+    /* accepted sockets inherit the listener's buffer sizes */
+    err = grpc_tune_unix_socket_buffers(fd);
+    if (err != GRPC_ERROR_NONE) goto error;
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
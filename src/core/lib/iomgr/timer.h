@@ -106,6 +106,10 @@ void grpc_timer_consume_kick(void);
 
 /* the following must be implemented by each iomgr implementation */
 
-void grpc_kick_poller(void);
+/* Wake whichever thread services timer deadlines, because the earliest
+   deadline just moved to next_deadline. Implementations that park a thread
+   until the previous earliest deadline may skip the wakeup when that thread
+   would wake in time anyway. */
+void grpc_kick_poller(gpr_timespec next_deadline);
 
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
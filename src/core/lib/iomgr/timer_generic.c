@@ -49,6 +49,21 @@
 #include "src/core/lib/support/spinlock.h"
 
 #define INVALID_HEAP_INDEX 0xffffffffu
+/* heap_index value marking a timer as parked in a shard's timer wheel */
+#define WHEEL_TIMER_INDEX 0xfffffffeu
+
+/* Each shard carries a two-level hierarchical timer wheel in front of its
+   heap: level 0 is WHEEL_SLOTS ticks of 2^LOG2_WHEEL_TICK_MS ms each (~2s),
+   level 1 is WHEEL_SLOTS level-0 windows (~2min). Timers inside the wheel
+   horizon get O(1) insert/cancel (they are just list links) and are extracted
+   in batches as the wheel turns; only timers beyond the horizon take the
+   O(log n) heap path. */
+#define LOG2_WHEEL_TICK_MS 5
+#define LOG2_WHEEL_SLOTS 6
+#define WHEEL_SLOTS (1 << LOG2_WHEEL_SLOTS)
+/* keep the last level-1 window free so a slot never holds timers from two
+   different wheel revolutions */
+#define WHEEL_HORIZON_TICKS (WHEEL_SLOTS * (WHEEL_SLOTS - 1))
 
 #define LOG2_NUM_SHARDS 5
 #define NUM_SHARDS (1 << LOG2_NUM_SHARDS)
@@ -72,6 +87,15 @@ typedef struct {
   grpc_timer_heap heap;
   /* This holds timers whose deadline is >= queue_deadline_cap. */
   grpc_timer list;
+  /* Hierarchical timer wheel for timers within WHEEL_HORIZON_TICKS of
+     wheel_last_tick; all fields require mu. */
+  grpc_timer wheel[2][WHEEL_SLOTS];
+  gpr_atm wheel_last_tick;
+  size_t wheel_count;
+  /* Monotone lower bound on the earliest wheel deadline, refreshed by
+     compute_min_deadline; used to decide whether an insert must update the
+     master shard queue. */
+  gpr_atm wheel_min_tracked;
 } shard_type;
 
 struct shared_mutables {
@@ -135,10 +159,15 @@ static gpr_timespec atm_to_timespec(gpr_atm x) {
   return gpr_time_add(g_start_time, dbl_to_ts((double)x / 1000.0));
 }
 
+static gpr_atm wheel_min_deadline(shard_type *shard);
+
 static gpr_atm compute_min_deadline(shard_type *shard) {
-  return grpc_timer_heap_is_empty(&shard->heap)
-             ? saturating_add(shard->queue_deadline_cap, 1)
-             : grpc_timer_heap_top(&shard->heap)->deadline;
+  gpr_atm heap_min = grpc_timer_heap_is_empty(&shard->heap)
+                         ? saturating_add(shard->queue_deadline_cap, 1)
+                         : grpc_timer_heap_top(&shard->heap)->deadline;
+  gpr_atm wheel_min = wheel_min_deadline(shard);
+  shard->wheel_min_tracked = wheel_min;
+  return GPR_MIN(heap_min, wheel_min);
 }
 
 void grpc_timer_list_init(gpr_timespec now) {
@@ -163,6 +192,16 @@ void grpc_timer_list_init(gpr_timespec now) {
     shard->shard_queue_index = i;
     grpc_timer_heap_init(&shard->heap);
     shard->list.next = shard->list.prev = &shard->list;
+    for (int level = 0; level < 2; level++) {
+      for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+        shard->wheel[level][slot].next = shard->wheel[level][slot].prev =
+            &shard->wheel[level][slot];
+      }
+    }
+    shard->wheel_last_tick =
+        g_shared_mutables.min_timer >> LOG2_WHEEL_TICK_MS;
+    shard->wheel_count = 0;
+    shard->wheel_min_tracked = GPR_ATM_MAX;
     shard->min_deadline = compute_min_deadline(shard);
     g_shard_queue[i] = shard;
   }
@@ -199,6 +238,101 @@ static void list_remove(grpc_timer *timer) {
   timer->prev->next = timer->next;
 }
 
+/* Park a timer whose tick is within WHEEL_HORIZON_TICKS of
+   shard->wheel_last_tick. REQUIRES: shard->mu locked */
+static void wheel_insert(shard_type *shard, grpc_timer *timer, gpr_atm tick) {
+  grpc_timer *slot;
+  if (tick - shard->wheel_last_tick < WHEEL_SLOTS) {
+    slot = &shard->wheel[0][tick & (WHEEL_SLOTS - 1)];
+  } else {
+    slot = &shard->wheel[1][(tick >> LOG2_WHEEL_SLOTS) & (WHEEL_SLOTS - 1)];
+  }
+  timer->heap_index = WHEEL_TIMER_INDEX;
+  list_join(slot, timer);
+  shard->wheel_count++;
+}
+
+/* Lower bound on the earliest wheel deadline, or GPR_ATM_MAX if the wheel is
+   empty. Slots other than the current one only need their start-of-slot bound;
+   the current slot (which may hold timers later than now) is walked for its
+   true minimum so that expired-timer extraction always makes the advertised
+   minimum advance. REQUIRES: shard->mu locked */
+static gpr_atm wheel_min_deadline(shard_type *shard) {
+  if (shard->wheel_count == 0) return GPR_ATM_MAX;
+  gpr_atm cur = shard->wheel_last_tick;
+  for (gpr_atm i = 0; i < WHEEL_SLOTS; i++) {
+    gpr_atm tick = cur + i;
+    grpc_timer *slot = &shard->wheel[0][tick & (WHEEL_SLOTS - 1)];
+    if (slot->next != slot) {
+      if (i == 0) {
+        gpr_atm min = GPR_ATM_MAX;
+        for (grpc_timer *t = slot->next; t != slot; t = t->next) {
+          min = GPR_MIN(min, t->deadline);
+        }
+        return min;
+      }
+      return tick << LOG2_WHEEL_TICK_MS;
+    }
+  }
+  for (gpr_atm i = 1; i < WHEEL_SLOTS; i++) {
+    gpr_atm window = (cur >> LOG2_WHEEL_SLOTS) + i;
+    grpc_timer *slot = &shard->wheel[1][window & (WHEEL_SLOTS - 1)];
+    if (slot->next != slot) {
+      return window << (LOG2_WHEEL_SLOTS + LOG2_WHEEL_TICK_MS);
+    }
+  }
+  return GPR_ATM_MAX;
+}
+
+/* Turn the wheel forward to 'now', scheduling every parked timer whose
+   deadline has passed and cascading each level-1 slot down into level 0 as its
+   window becomes current. REQUIRES: shard->mu locked */
+static size_t wheel_advance(grpc_exec_ctx *exec_ctx, shard_type *shard,
+                            gpr_atm now, grpc_error *error) {
+  size_t n = 0;
+  gpr_atm now_tick = now >> LOG2_WHEEL_TICK_MS;
+  while (shard->wheel_last_tick <= now_tick) {
+    if (shard->wheel_count == 0) {
+      shard->wheel_last_tick = now_tick;
+      break;
+    }
+    gpr_atm tick = shard->wheel_last_tick;
+    if ((tick & (WHEEL_SLOTS - 1)) == 0) {
+      /* entering a new level-0 window: pull its level-1 slot down */
+      grpc_timer *up =
+          &shard->wheel[1][(tick >> LOG2_WHEEL_SLOTS) & (WHEEL_SLOTS - 1)];
+      grpc_timer *t = up->next;
+      while (t != up) {
+        grpc_timer *next = t->next;
+        list_remove(t);
+        shard->wheel_count--;
+        wheel_insert(shard, t, t->deadline >> LOG2_WHEEL_TICK_MS);
+        t = next;
+      }
+    }
+    grpc_timer *slot = &shard->wheel[0][tick & (WHEEL_SLOTS - 1)];
+    grpc_timer *timer = slot->next;
+    while (timer != slot) {
+      grpc_timer *next = timer->next;
+      if (timer->deadline <= now) {
+        if (GRPC_TRACER_ON(grpc_timer_trace)) {
+          gpr_log(GPR_DEBUG, "TIMER %p: FIRE from wheel %" PRIdPTR "ms late",
+                  timer, now - timer->deadline);
+        }
+        list_remove(timer);
+        shard->wheel_count--;
+        timer->pending = false;
+        grpc_closure_sched(exec_ctx, timer->closure, GRPC_ERROR_REF(error));
+        n++;
+      }
+      timer = next;
+    }
+    if (shard->wheel_last_tick == now_tick) break;
+    shard->wheel_last_tick++;
+  }
+  return n;
+}
+
 static void swap_adjacent_shards_in_queue(uint32_t first_shard_queue_index) {
   shard_type *temp;
   temp = g_shard_queue[first_shard_queue_index];
@@ -261,7 +395,14 @@ void grpc_timer_init(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
 
   grpc_time_averaged_stats_add_sample(&shard->stats,
                                       ts_to_dbl(gpr_time_sub(deadline, now)));
-  if (deadline_atm < shard->queue_deadline_cap) {
+  gpr_atm deadline_tick = deadline_atm >> LOG2_WHEEL_TICK_MS;
+  if (deadline_tick >= shard->wheel_last_tick &&
+      deadline_tick - shard->wheel_last_tick < WHEEL_HORIZON_TICKS) {
+    /* short deadline (the common per-call case): O(1) wheel insert */
+    wheel_insert(shard, timer, deadline_tick);
+    is_first_timer = deadline_atm < shard->wheel_min_tracked;
+    shard->wheel_min_tracked = GPR_MIN(shard->wheel_min_tracked, deadline_atm);
+  } else if (deadline_atm < shard->queue_deadline_cap) {
     is_first_timer = grpc_timer_heap_add(&shard->heap, timer);
   } else {
     timer->heap_index = INVALID_HEAP_INDEX;
@@ -298,7 +439,7 @@ void grpc_timer_init(grpc_exec_ctx *exec_ctx, grpc_timer *timer,
       note_deadline_change(shard);
       if (shard->shard_queue_index == 0 && deadline_atm < old_min_deadline) {
         gpr_atm_no_barrier_store(&g_shared_mutables.min_timer, deadline_atm);
-        grpc_kick_poller();
+        grpc_kick_poller(atm_to_timespec(deadline_atm));
       }
     }
     gpr_mu_unlock(&g_shared_mutables.mu);
@@ -325,7 +466,10 @@ void grpc_timer_cancel(grpc_exec_ctx *exec_ctx, grpc_timer *timer) {
   if (timer->pending) {
     grpc_closure_sched(exec_ctx, timer->closure, GRPC_ERROR_CANCELLED);
     timer->pending = false;
-    if (timer->heap_index == INVALID_HEAP_INDEX) {
+    if (timer->heap_index == WHEEL_TIMER_INDEX) {
+      list_remove(timer);
+      shard->wheel_count--;
+    } else if (timer->heap_index == INVALID_HEAP_INDEX) {
       list_remove(timer);
     } else {
       grpc_timer_heap_remove(&shard->heap, timer);
@@ -412,6 +556,7 @@ static size_t pop_timers(grpc_exec_ctx *exec_ctx, shard_type *shard,
   size_t n = 0;
   grpc_timer *timer;
   gpr_mu_lock(&shard->mu);
+  n += wheel_advance(exec_ctx, shard, now, error);
   while ((timer = pop_one(shard, now))) {
     grpc_closure_sched(exec_ctx, timer->closure, GRPC_ERROR_REF(error));
     n++;
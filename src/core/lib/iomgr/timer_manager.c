@@ -67,6 +67,9 @@ static bool g_kicked;
 static bool g_has_timed_waiter;
 // generation counter to track which thread is waiting for the next timer
 static uint64_t g_timed_waiter_generation;
+// deadline the timed waiter is parked until (inf_future when there is none);
+// lets kicks for timers at-or-after this point be absorbed without a wakeup
+static gpr_timespec g_timed_waiter_deadline;
 
 static void timer_thread(void *unused);
 
@@ -151,8 +154,14 @@ static void timer_thread(void *unused) {
       // only until the next timer should expire
       // all other timers wait forever
       uint64_t my_timed_waiter_generation = g_timed_waiter_generation - 1;
-      if (!g_has_timed_waiter) {
+      // take over as the timed waiter if there is none, or if our check
+      // produced an earlier deadline than the one currently parked on (the
+      // current holder will wake, find the generation moved on, and park
+      // untimed)
+      if (!g_has_timed_waiter ||
+          gpr_time_cmp(next, g_timed_waiter_deadline) < 0) {
         g_has_timed_waiter = true;
+        g_timed_waiter_deadline = next;
         // we use a generation counter to track the timed waiter so we can
         // cancel an existing one quickly (and when it actually times out it'll
         // figure stuff out instead of incurring a wakeup)
@@ -177,6 +186,7 @@ static void timer_thread(void *unused) {
       // there's work to do after checking timers (code above)
       if (my_timed_waiter_generation == g_timed_waiter_generation) {
         g_has_timed_waiter = false;
+        g_timed_waiter_deadline = inf_future;
       }
       // if this was a kick from the timer system, consume it (and don't stop
       // this thread yet)
@@ -224,6 +234,7 @@ void grpc_timer_manager_init(void) {
   g_thread_count = 0;
   g_waiter_count = 0;
   g_completed_threads = NULL;
+  g_timed_waiter_deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
 
   start_threads();
 }
@@ -266,10 +277,18 @@ void grpc_timer_manager_set_threading(bool threaded) {
   }
 }
 
-void grpc_kick_poller(void) {
+void grpc_kick_poller(gpr_timespec next_deadline) {
   gpr_mu_lock(&g_mu);
+  if (g_has_timed_waiter &&
+      gpr_time_cmp(next_deadline, g_timed_waiter_deadline) >= 0) {
+    // the parked waiter already wakes in time for this timer: absorb the kick
+    // instead of paying a wakeup/re-park cycle to learn nothing
+    gpr_mu_unlock(&g_mu);
+    return;
+  }
   g_kicked = true;
   g_has_timed_waiter = false;
+  g_timed_waiter_deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   ++g_timed_waiter_generation;
   gpr_cv_signal(&g_cv_wait);
   gpr_mu_unlock(&g_mu);
@@ -391,6 +391,117 @@ static void on_write(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
   gpr_mu_unlock(&sp->server->mu);
 }
 
+int grpc_udp_server_recv_batch(int fd, unsigned char *slab, size_t slab_size,
+                               grpc_udp_datagram *datagrams,
+                               size_t max_datagrams) {
+  size_t chunk_size;
+  size_t i;
+
+  GPR_ASSERT(max_datagrams > 0 &&
+             max_datagrams <= GRPC_UDP_SERVER_MAX_BATCH_SIZE);
+  chunk_size = slab_size / max_datagrams;
+  GPR_ASSERT(chunk_size > 0);
+
+#ifdef GRPC_HAVE_RECVMMSG
+  {
+    struct mmsghdr msgs[GRPC_UDP_SERVER_MAX_BATCH_SIZE];
+    struct iovec iovs[GRPC_UDP_SERVER_MAX_BATCH_SIZE];
+    int nrecvd;
+
+    for (i = 0; i < max_datagrams; i++) {
+      iovs[i].iov_base = slab + i * chunk_size;
+      iovs[i].iov_len = chunk_size;
+      memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+      msgs[i].msg_hdr.msg_name = datagrams[i].peer.addr;
+      msgs[i].msg_hdr.msg_namelen = sizeof(datagrams[i].peer.addr);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    do {
+      nrecvd = recvmmsg(fd, msgs, (unsigned int)max_datagrams, 0, NULL);
+    } while (nrecvd < 0 && errno == EINTR);
+    if (nrecvd < 0) {
+      return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+
+    for (i = 0; i < (size_t)nrecvd; i++) {
+      datagrams[i].data = slab + i * chunk_size;
+      datagrams[i].length = msgs[i].msg_len;
+      datagrams[i].peer.len = msgs[i].msg_hdr.msg_namelen;
+    }
+    return nrecvd;
+  }
+#else
+  for (i = 0; i < max_datagrams; i++) {
+    socklen_t addr_len = sizeof(datagrams[i].peer.addr);
+    ssize_t received;
+
+    do {
+      received = recvfrom(fd, slab + i * chunk_size, chunk_size, 0,
+                          (struct sockaddr *)datagrams[i].peer.addr, &addr_len);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return i > 0 ? (int)i : -1;
+    }
+
+    datagrams[i].data = slab + i * chunk_size;
+    datagrams[i].length = (size_t)received;
+    datagrams[i].peer.len = addr_len;
+  }
+  return (int)i;
+#endif
+}
+
+int grpc_udp_server_send_batch(int fd, const grpc_udp_datagram *datagrams,
+                               size_t count) {
+  size_t i;
+
+  GPR_ASSERT(count > 0 && count <= GRPC_UDP_SERVER_MAX_BATCH_SIZE);
+
+#ifdef GRPC_HAVE_SENDMMSG
+  {
+    struct mmsghdr msgs[GRPC_UDP_SERVER_MAX_BATCH_SIZE];
+    struct iovec iovs[GRPC_UDP_SERVER_MAX_BATCH_SIZE];
+    int nsent;
+
+    for (i = 0; i < count; i++) {
+      iovs[i].iov_base = datagrams[i].data;
+      iovs[i].iov_len = datagrams[i].length;
+      memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+      msgs[i].msg_hdr.msg_name = (void *)datagrams[i].peer.addr;
+      msgs[i].msg_hdr.msg_namelen = (socklen_t)datagrams[i].peer.len;
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    do {
+      nsent = sendmmsg(fd, msgs, (unsigned int)count, 0);
+    } while (nsent < 0 && errno == EINTR);
+    if (nsent < 0) {
+      return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    return nsent;
+  }
+#else
+  for (i = 0; i < count; i++) {
+    ssize_t sent;
+
+    do {
+      sent = sendto(fd, datagrams[i].data, datagrams[i].length, 0,
+                    (const struct sockaddr *)datagrams[i].peer.addr,
+                    (socklen_t)datagrams[i].peer.len);
+    } while (sent < 0 && errno == EINTR);
+    if (sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return i > 0 ? (int)i : -1;
+    }
+  }
+  return (int)i;
+#endif
+}
+
 static int add_socket_to_server(grpc_udp_server *s, int fd,
                                 const grpc_resolved_address *addr,
                                 grpc_udp_server_read_cb read_cb,
@@ -49,6 +49,36 @@ typedef struct grpc_udp_server grpc_udp_server;
 typedef void (*grpc_udp_server_read_cb)(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
                                         void *user_data);
 
+/* One datagram moved by a batch call. For receives, \a data points into the
+   slab handed to grpc_udp_server_recv_batch. */
+typedef struct grpc_udp_datagram {
+  grpc_resolved_address peer;
+  unsigned char *data;
+  size_t length;
+} grpc_udp_datagram;
+
+/* Upper bound on the number of datagrams moved by one batch call. */
+#define GRPC_UDP_SERVER_MAX_BATCH_SIZE 32
+
+/* Drain up to \a max_datagrams datagrams from \a fd in a single syscall
+   (recvmmsg where the platform has it, a recvfrom loop otherwise). \a slab
+   provides the packet storage: it is split evenly between the datagrams and
+   each received datagram's data pointer refers into it, so the contents are
+   only valid until the slab is reused. Intended to be called from a
+   grpc_udp_server_read_cb until it reports an empty socket. Returns the
+   number of datagrams received, 0 if the socket is drained, or -1 on
+   error. */
+int grpc_udp_server_recv_batch(int fd, unsigned char *slab, size_t slab_size,
+                               grpc_udp_datagram *datagrams,
+                               size_t max_datagrams);
+
+/* Send \a count datagrams on \a fd in a single syscall (sendmmsg where the
+   platform has it). Returns the number of datagrams handed to the kernel -
+   possibly fewer than \a count if the socket stops accepting data - or -1
+   on error. */
+int grpc_udp_server_send_batch(int fd, const grpc_udp_datagram *datagrams,
+                               size_t count);
+
 /* Called when the socket is writeable. */
 typedef void (*grpc_udp_server_write_cb)(grpc_exec_ctx *exec_ctx, grpc_fd *emfd,
                                          void *user_data);
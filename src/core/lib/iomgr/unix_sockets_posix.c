@@ -43,10 +43,15 @@
 
 #include "src/core/lib/iomgr/unix_sockets_posix.h"
 
+#include <errno.h>
+#include <sys/socket.h>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/useful.h>
 
+#include "src/core/lib/iomgr/socket_utils_posix.h"
+
 void grpc_create_socketpair_if_unix(int sv[2]) {
   GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
 }
@@ -105,4 +110,96 @@ char *grpc_sockaddr_to_uri_unix_if_possible(
   return result;
 }
 
+int grpc_is_unix_socket_fd(int fd) {
+  struct sockaddr_storage addr;
+  socklen_t len = sizeof(addr);
+  if (getsockname(fd, (struct sockaddr *)&addr, &len) != 0) {
+    return 0;
+  }
+  return addr.ss_family == AF_UNIX;
+}
+
+/* Match the 1MB the UDP server asks for: large enough that neither side of
+   a local hop stalls on a full socket buffer under bursty load. */
+#define UNIX_SOCKET_BUFFER_SIZE_BYTES (1024 * 1024)
+
+grpc_error *grpc_tune_unix_socket_buffers(int fd) {
+  grpc_error *err;
+  err = grpc_set_socket_sndbuf(fd, UNIX_SOCKET_BUFFER_SIZE_BYTES);
+  if (err != GRPC_ERROR_NONE) return err;
+  return grpc_set_socket_rcvbuf(fd, UNIX_SOCKET_BUFFER_SIZE_BYTES);
+}
+
+grpc_error *grpc_send_fd_over_unix_socket(int fd, int fd_to_send) {
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  struct iovec iov;
+  char payload = 0;
+  char control[CMSG_SPACE(sizeof(int))];
+  ssize_t sent;
+
+  memset(&msg, 0, sizeof(msg));
+  memset(control, 0, sizeof(control));
+  iov.iov_base = &payload;
+  iov.iov_len = 1;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cmsg), &fd_to_send, sizeof(int));
+
+  do {
+    sent = sendmsg(fd, &msg, 0);
+  } while (sent < 0 && errno == EINTR);
+  if (sent < 0) {
+    return GRPC_OS_ERROR(errno, "sendmsg");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error *grpc_recv_fd_over_unix_socket(int fd, int *out_fd) {
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  struct iovec iov;
+  char payload;
+  char control[CMSG_SPACE(sizeof(int))];
+  ssize_t received;
+
+  *out_fd = -1;
+  memset(&msg, 0, sizeof(msg));
+  iov.iov_base = &payload;
+  iov.iov_len = 1;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  do {
+    received = recvmsg(fd, &msg, 0);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0) {
+    return GRPC_OS_ERROR(errno, "recvmsg");
+  }
+  if (received == 0) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Peer closed before passing a file descriptor");
+  }
+
+  for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+        cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
+      memcpy(out_fd, CMSG_DATA(cmsg), sizeof(int));
+      return GRPC_ERROR_NONE;
+    }
+  }
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "No file descriptor in SCM_RIGHTS message");
+}
+
 #endif
@@ -53,4 +53,22 @@ void grpc_unlink_if_unix_domain_socket(
 char *grpc_sockaddr_to_uri_unix_if_possible(
     const grpc_resolved_address *resolved_addr);
 
+/* Returns true if \a fd is an AF_UNIX socket. */
+int grpc_is_unix_socket_fd(int fd);
+
+/* Size the kernel socket buffers of a unix socket for local bulk transfer.
+   There is no wire to pace against, so large buffers cost nothing but
+   memory and let a sidecar-to-app hop run at memcpy speed. */
+grpc_error *grpc_tune_unix_socket_buffers(int fd);
+
+/* Pass \a fd_to_send over the connected unix socket \a fd via SCM_RIGHTS,
+   so an established connection can be handed to another process without
+   re-handshaking. The receiver gets an independent descriptor for the same
+   open file description. */
+grpc_error *grpc_send_fd_over_unix_socket(int fd, int fd_to_send);
+
+/* Receive a file descriptor passed with grpc_send_fd_over_unix_socket.
+   On success *out_fd holds the new descriptor. */
+grpc_error *grpc_recv_fd_over_unix_socket(int fd, int *out_fd);
+
 #endif /* GRPC_CORE_LIB_IOMGR_UNIX_SOCKETS_POSIX_H */
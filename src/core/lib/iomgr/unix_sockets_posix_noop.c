@@ -59,4 +59,19 @@ char *grpc_sockaddr_to_uri_unix_if_possible(const grpc_resolved_address *addr) {
   return NULL;
 }
 
+int grpc_is_unix_socket_fd(int fd) { return false; }
+
+grpc_error *grpc_tune_unix_socket_buffers(int fd) { return GRPC_ERROR_NONE; }
+
+grpc_error *grpc_send_fd_over_unix_socket(int fd, int fd_to_send) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SCM_RIGHTS fd passing requires unix sockets");
+}
+
+grpc_error *grpc_recv_fd_over_unix_socket(int fd, int *out_fd) {
+  *out_fd = -1;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SCM_RIGHTS fd passing requires unix sockets");
+}
+
 #endif
@@ -36,6 +36,8 @@
 
 #include <stdlib.h>
 
+#include <grpc/slice.h>
+
 #include "src/core/lib/json/json_common.h"
 
 /* A tree-like structure to hold json values. The key and value pointers
@@ -85,4 +87,35 @@ char* grpc_json_dump_to_string(grpc_json* json, int indent);
 grpc_json* grpc_json_create(grpc_json_type type);
 void grpc_json_destroy(grpc_json* json);
 
+/* A streaming alternative to the tree parser above: events are delivered
+ * to the caller's vtable as they are decoded, the input is consumed
+ * directly from a slice (no flatten, no copy, no NUL termination needed),
+ * and all scratch memory comes from a single internal arena - there is no
+ * per-node allocation at all.
+ *
+ * Keys and values handed to the callbacks are NUL terminated UTF-8 and
+ * only valid for the duration of the callback; copy them if they need to
+ * outlive it.
+ */
+typedef struct grpc_json_sax_vtable {
+  /* Starts a container of type GRPC_JSON_ARRAY or GRPC_JSON_OBJECT. */
+  void (*container_begins)(void* userdata, grpc_json_type type);
+  /* Ends the innermost open container of type \a type. */
+  void (*container_ends)(void* userdata, grpc_json_type type);
+  /* An object key. The matching value event follows. */
+  void (*set_key)(void* userdata, const char* key);
+  /* A string value. */
+  void (*set_string)(void* userdata, const char* value);
+  /* A numeric value, still in its textual form. Return 1 if valid. */
+  int (*set_number)(void* userdata, const char* value);
+  /* A GRPC_JSON_TRUE, GRPC_JSON_FALSE or GRPC_JSON_NULL value. */
+  void (*set_value)(void* userdata, grpc_json_type type);
+} grpc_json_sax_vtable;
+
+/* Parses \a input in a single pass. Returns 1 on success, 0 on parse error
+ * (by which point the callbacks may have seen a prefix of the document).
+ * Does not take ownership of \a input. */
+int grpc_json_parse_slice(grpc_slice input, const grpc_json_sax_vtable* vtable,
+                          void* userdata);
+
 #endif /* GRPC_CORE_LIB_JSON_JSON_H */
@@ -40,6 +40,7 @@
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/json/json_reader.h"
 #include "src/core/lib/json/json_writer.h"
+#include "src/core/lib/support/arena.h"
 
 /* The json reader will construct a bunch of grpc_json objects and
  * link them all up together in a tree-like structure that will represent
@@ -129,36 +130,41 @@ static void json_reader_string_add_char(void *userdata, uint32_t c) {
   *state->string_ptr++ = (uint8_t)c;
 }
 
-/* We are converting a UTF-32 character into UTF-8 here,
- * as described by RFC3629.
+/* We are converting a UTF-32 character into UTF-8 here, as described by
+ * RFC3629. \a add_char appends one byte to \a userdata's scratchpad.
  */
-static void json_reader_string_add_utf32(void *userdata, uint32_t c) {
+static void json_utf32_to_utf8(void *userdata, uint32_t c,
+                               void (*add_char)(void *, uint32_t)) {
   if (c <= 0x7f) {
-    json_reader_string_add_char(userdata, c);
+    add_char(userdata, c);
   } else if (c <= 0x7ff) {
     uint32_t b1 = 0xc0 | ((c >> 6) & 0x1f);
     uint32_t b2 = 0x80 | (c & 0x3f);
-    json_reader_string_add_char(userdata, b1);
-    json_reader_string_add_char(userdata, b2);
+    add_char(userdata, b1);
+    add_char(userdata, b2);
   } else if (c <= 0xffff) {
     uint32_t b1 = 0xe0 | ((c >> 12) & 0x0f);
     uint32_t b2 = 0x80 | ((c >> 6) & 0x3f);
     uint32_t b3 = 0x80 | (c & 0x3f);
-    json_reader_string_add_char(userdata, b1);
-    json_reader_string_add_char(userdata, b2);
-    json_reader_string_add_char(userdata, b3);
+    add_char(userdata, b1);
+    add_char(userdata, b2);
+    add_char(userdata, b3);
   } else if (c <= 0x1fffff) {
     uint32_t b1 = 0xf0 | ((c >> 18) & 0x07);
     uint32_t b2 = 0x80 | ((c >> 12) & 0x3f);
     uint32_t b3 = 0x80 | ((c >> 6) & 0x3f);
     uint32_t b4 = 0x80 | (c & 0x3f);
-    json_reader_string_add_char(userdata, b1);
-    json_reader_string_add_char(userdata, b2);
-    json_reader_string_add_char(userdata, b3);
-    json_reader_string_add_char(userdata, b4);
+    add_char(userdata, b1);
+    add_char(userdata, b2);
+    add_char(userdata, b3);
+    add_char(userdata, b4);
   }
 }
 
+static void json_reader_string_add_utf32(void *userdata, uint32_t c) {
+  json_utf32_to_utf8(userdata, c, json_reader_string_add_char);
+}
+
 /* We consider that the input may be a zero-terminated string. So we
  * can end up hitting eof before the end of the alleged string length.
  */
@@ -323,6 +329,130 @@ grpc_json *grpc_json_parse_string(char *input) {
   return grpc_json_parse_string_with_len(input, UNBOUND_JSON_STRING_LENGTH);
 }
 
+/* Adapter between the reader's internal vtable and the public streaming
+ * grpc_json_sax_vtable. The input is consumed in place from the slice, and
+ * decoded strings go to an arena backed scratchpad; since unescaping only
+ * ever shrinks text, one block the size of the input is always enough.
+ */
+typedef struct {
+  const grpc_json_sax_vtable *vtable;
+  void *userdata;
+  const uint8_t *cur;
+  const uint8_t *end;
+  uint8_t *scratch;
+  uint8_t *scratch_ptr;
+  /* the reader expects to be told the type of the container enclosing the
+   * one that just ended, so we keep our own stack of open containers */
+  grpc_json_type *container_stack;
+  size_t depth;
+} json_sax_userdata;
+
+static void json_sax_string_clear(void *userdata) {
+  json_sax_userdata *state = userdata;
+  state->scratch_ptr = state->scratch;
+}
+
+static void json_sax_string_add_char(void *userdata, uint32_t c) {
+  json_sax_userdata *state = userdata;
+  *state->scratch_ptr++ = (uint8_t)c;
+}
+
+static void json_sax_string_add_utf32(void *userdata, uint32_t c) {
+  json_utf32_to_utf8(userdata, c, json_sax_string_add_char);
+}
+
+static uint32_t json_sax_read_char(void *userdata) {
+  json_sax_userdata *state = userdata;
+  if (state->cur == state->end) return GRPC_JSON_READ_CHAR_EOF;
+  return *state->cur++;
+}
+
+/* NUL terminate the current scratchpad string before handing it out. */
+static const char *json_sax_string(json_sax_userdata *state) {
+  *state->scratch_ptr = 0;
+  return (const char *)state->scratch;
+}
+
+static void json_sax_container_begins(void *userdata, grpc_json_type type) {
+  json_sax_userdata *state = userdata;
+  state->container_stack[state->depth++] = type;
+  state->vtable->container_begins(state->userdata, type);
+}
+
+static grpc_json_type json_sax_container_ends(void *userdata) {
+  json_sax_userdata *state = userdata;
+  grpc_json_type ended = state->container_stack[--state->depth];
+  state->vtable->container_ends(state->userdata, ended);
+  return state->depth == 0 ? GRPC_JSON_TOP_LEVEL
+                           : state->container_stack[state->depth - 1];
+}
+
+static void json_sax_set_key(void *userdata) {
+  json_sax_userdata *state = userdata;
+  state->vtable->set_key(state->userdata, json_sax_string(state));
+}
+
+static void json_sax_set_string(void *userdata) {
+  json_sax_userdata *state = userdata;
+  state->vtable->set_string(state->userdata, json_sax_string(state));
+}
+
+static int json_sax_set_number(void *userdata) {
+  json_sax_userdata *state = userdata;
+  return state->vtable->set_number(state->userdata, json_sax_string(state));
+}
+
+static void json_sax_set_true(void *userdata) {
+  json_sax_userdata *state = userdata;
+  state->vtable->set_value(state->userdata, GRPC_JSON_TRUE);
+}
+
+static void json_sax_set_false(void *userdata) {
+  json_sax_userdata *state = userdata;
+  state->vtable->set_value(state->userdata, GRPC_JSON_FALSE);
+}
+
+static void json_sax_set_null(void *userdata) {
+  json_sax_userdata *state = userdata;
+  state->vtable->set_value(state->userdata, GRPC_JSON_NULL);
+}
+
+static grpc_json_reader_vtable sax_reader_vtable = {
+    json_sax_string_clear,     json_sax_string_add_char,
+    json_sax_string_add_utf32, json_sax_read_char,
+    json_sax_container_begins, json_sax_container_ends,
+    json_sax_set_key,          json_sax_set_string,
+    json_sax_set_number,       json_sax_set_true,
+    json_sax_set_false,        json_sax_set_null};
+
+int grpc_json_parse_slice(grpc_slice input, const grpc_json_sax_vtable *vtable,
+                          void *userdata) {
+  grpc_json_reader reader;
+  json_sax_userdata state;
+  size_t len = GRPC_SLICE_LENGTH(input);
+  /* one arena block for the scratchpad (a decoded string is never longer
+   * than its encoded form), one for the container stack (every container
+   * consumes at least one input byte) */
+  gpr_arena *arena =
+      gpr_arena_create(len + 1 + (len + 1) * sizeof(grpc_json_type));
+  grpc_json_reader_status status;
+
+  state.vtable = vtable;
+  state.userdata = userdata;
+  state.cur = GRPC_SLICE_START_PTR(input);
+  state.end = state.cur + len;
+  state.scratch = gpr_arena_alloc(arena, len + 1);
+  state.scratch_ptr = state.scratch;
+  state.container_stack =
+      gpr_arena_alloc(arena, (len + 1) * sizeof(grpc_json_type));
+  state.depth = 0;
+  grpc_json_reader_init(&reader, &sax_reader_vtable, &state);
+
+  status = grpc_json_reader_run(&reader);
+  gpr_arena_destroy(arena);
+  return status == GRPC_JSON_DONE;
+}
+
 static void json_dump_recursive(grpc_json_writer *writer, grpc_json *json,
                                 int in_object) {
   while (json) {
@@ -34,6 +34,8 @@
 #ifndef GRPC_CORE_LIB_PROFILING_TIMERS_H
 #define GRPC_CORE_LIB_PROFILING_TIMERS_H
 
+#include <grpc/support/time.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -52,7 +54,25 @@ void gpr_timers_set_log_filename(const char *filename);
 
 void gpr_timer_set_enabled(int enabled);
 
-#if !(defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER))
+/* Flight recorder (GRPC_RING_PROFILER): instead of streaming every mark to a
+   file, each thread records compact (tag, timestamp) events into a
+   fixed-size in-memory ring, cheap enough to leave on in production. */
+typedef struct gpr_timer_ring_entry {
+  gpr_timespec tm;
+  const char *tagstr;
+  int thd;
+  char type; /* '{' begin, '}' end, '.' mark */
+} gpr_timer_ring_entry;
+
+/* Copies the most recent events (up to \a max_entries, oldest first within
+   each thread) into \a entries and returns how many were written. May run
+   while recording continues; entries being overwritten concurrently can be
+   lost. Returns 0 unless compiled with GRPC_RING_PROFILER. */
+size_t gpr_timer_ring_snapshot(gpr_timer_ring_entry *entries,
+                               size_t max_entries);
+
+#if !(defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER) + \
+      defined(GRPC_RING_PROFILER))
 /* No profiling. No-op all the things. */
 #define GPR_TIMER_MARK(tag, important) \
   do {                                 \
@@ -68,8 +88,10 @@ void gpr_timer_set_enabled(int enabled);
 
 #else /* at least one profiler requested... */
 /* ... hopefully only one. */
-#if defined(GRPC_STAP_PROFILER) && defined(GRPC_BASIC_PROFILER)
-#error "GRPC_STAP_PROFILER and GRPC_BASIC_PROFILER are mutually exclusive."
+#if (defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER) + \
+     defined(GRPC_RING_PROFILER)) > 1
+#error "GRPC_STAP_PROFILER, GRPC_BASIC_PROFILER and GRPC_RING_PROFILER are " \
+       "mutually exclusive."
 #endif
 
 /* Generic profiling interface. */
@@ -95,7 +117,8 @@ void gpr_timer_set_enabled(int enabled);
 #ifdef __cplusplus
 }
 
-#if (defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER))
+#if (defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER) + \
+     defined(GRPC_RING_PROFILER))
 namespace grpc {
 class ProfileScope {
  public:
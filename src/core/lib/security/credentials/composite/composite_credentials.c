@@ -128,7 +128,7 @@ static void composite_call_get_request_metadata(
 }
 
 static grpc_call_credentials_vtable composite_call_credentials_vtable = {
-    composite_call_destruct, composite_call_get_request_metadata};
+    composite_call_destruct, composite_call_get_request_metadata, NULL};
 
 static grpc_call_credentials_array get_creds_array(
     grpc_call_credentials **creds_addr) {
@@ -133,6 +133,14 @@ void grpc_call_credentials_get_request_metadata(
                                       user_data);
 }
 
+gpr_timespec grpc_call_credentials_get_metadata_valid_until(
+    grpc_call_credentials *creds) {
+  if (creds == NULL || creds->vtable->get_metadata_valid_until == NULL) {
+    return gpr_inf_past(GPR_CLOCK_REALTIME);
+  }
+  return creds->vtable->get_metadata_valid_until(creds);
+}
+
 grpc_security_status grpc_channel_credentials_create_security_connector(
     grpc_exec_ctx *exec_ctx, grpc_channel_credentials *channel_creds,
     const char *target, const grpc_channel_args *args,
@@ -195,6 +195,13 @@ typedef struct {
                                grpc_auth_metadata_context context,
                                grpc_credentials_metadata_cb cb,
                                void *user_data);
+  /* Optional (may be NULL). Returns the time until which the metadata last
+     produced by get_request_metadata stays valid for any call, regardless of
+     the auth metadata context. Returning a time in the future lets callers
+     cache that metadata instead of re-running get_request_metadata; returning
+     a past time (or leaving this NULL) means the metadata must not be
+     cached.  */
+  gpr_timespec (*get_metadata_valid_until)(grpc_call_credentials *c);
 } grpc_call_credentials_vtable;
 
 struct grpc_call_credentials {
@@ -211,6 +218,12 @@ void grpc_call_credentials_get_request_metadata(
     grpc_polling_entity *pollent, grpc_auth_metadata_context context,
     grpc_credentials_metadata_cb cb, void *user_data);
 
+/* Returns the time until which the metadata last produced by creds is valid
+   for any call, or a time in the past if it may not be cached (see the
+   get_metadata_valid_until vtable method). */
+gpr_timespec grpc_call_credentials_get_metadata_valid_until(
+    grpc_call_credentials *creds);
+
 /* Metadata-only credentials with the specified key and value where
    asynchronicity can be simulated for testing. */
 grpc_call_credentials *grpc_md_only_test_credentials_create(
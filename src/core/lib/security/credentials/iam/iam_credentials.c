@@ -59,8 +59,8 @@ static void iam_get_request_metadata(grpc_exec_ctx *exec_ctx,
      GRPC_CREDENTIALS_OK, NULL);
 }
 
-static grpc_call_credentials_vtable iam_vtable = {iam_destruct,
-                                                  iam_get_request_metadata};
+static grpc_call_credentials_vtable iam_vtable = {
+    iam_destruct, iam_get_request_metadata, NULL};
 
 grpc_call_credentials *grpc_google_iam_credentials_create(
     const char *token, const char *authority_selector, void *reserved) {
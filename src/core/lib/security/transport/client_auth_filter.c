@@ -74,6 +74,16 @@ typedef struct {
 typedef struct {
   grpc_channel_security_connector *security_connector;
   grpc_auth_context *auth_context;
+  /* Cache of the interned mdelems produced by the channel credentials, for
+     credentials whose metadata does not depend on the call (see
+     grpc_call_credentials_get_metadata_valid_until). Calls ref these prebuilt
+     elements instead of re-running the async metadata fetch and re-interning
+     the result. Guarded by creds_cache_mu. */
+  gpr_mu creds_cache_mu;
+  grpc_mdelem cached_md[MAX_CREDENTIALS_METADATA_COUNT];
+  size_t cached_md_count;
+  gpr_timespec cached_md_valid_until;
+  bool cache_refresh_in_flight;
 } channel_data;
 
 static void reset_auth_metadata_context(
@@ -140,6 +150,123 @@ static void on_credentials_metadata(grpc_exec_ctx *exec_ctx, void *user_data,
   }
 }
 
+/* Variant of on_credentials_metadata used when the metadata comes from the
+   channel credentials alone: additionally rebuilds the channel's prebuilt
+   mdelem cache so that subsequent calls skip the async fetch machinery. */
+static void on_channel_credentials_metadata(grpc_exec_ctx *exec_ctx,
+                                            void *user_data,
+                                            grpc_credentials_md *md_elems,
+                                            size_t num_md,
+                                            grpc_credentials_status status,
+                                            const char *error_details) {
+  grpc_call_element *elem = (grpc_call_element *)user_data;
+  call_data *calld = elem->call_data;
+  channel_data *chand = elem->channel_data;
+  grpc_transport_stream_op_batch *op = &calld->op;
+  grpc_mdelem md[MAX_CREDENTIALS_METADATA_COUNT];
+  grpc_metadata_batch *mdb;
+  size_t i;
+  reset_auth_metadata_context(&calld->auth_md_context);
+  grpc_error *error = GRPC_ERROR_NONE;
+  if (status != GRPC_CREDENTIALS_OK) {
+    gpr_mu_lock(&chand->creds_cache_mu);
+    chand->cache_refresh_in_flight = false;
+    gpr_mu_unlock(&chand->creds_cache_mu);
+    error = grpc_error_set_int(
+        GRPC_ERROR_CREATE_FROM_COPIED_STRING(
+            error_details != NULL && strlen(error_details) > 0
+                ? error_details
+                : "Credentials failed to get metadata."),
+        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAUTHENTICATED);
+  } else {
+    GPR_ASSERT(num_md <= MAX_CREDENTIALS_METADATA_COUNT);
+    GPR_ASSERT(op->send_initial_metadata);
+    /* Intern the mdelems once; the cache keeps its own refs so that other
+       calls can append them without going through grpc_mdelem_from_slices. */
+    for (i = 0; i < num_md; i++) {
+      md[i] = grpc_mdelem_from_slices(
+          exec_ctx, grpc_slice_ref_internal(md_elems[i].key),
+          grpc_slice_ref_internal(md_elems[i].value));
+    }
+    gpr_timespec valid_until =
+        grpc_call_credentials_get_metadata_valid_until(calld->creds);
+    gpr_mu_lock(&chand->creds_cache_mu);
+    for (i = 0; i < chand->cached_md_count; i++) {
+      GRPC_MDELEM_UNREF(exec_ctx, chand->cached_md[i]);
+    }
+    chand->cached_md_count = 0;
+    if (gpr_time_cmp(valid_until, gpr_now(GPR_CLOCK_REALTIME)) > 0) {
+      for (i = 0; i < num_md; i++) {
+        chand->cached_md[i] = GRPC_MDELEM_REF(md[i]);
+      }
+      chand->cached_md_count = num_md;
+      chand->cached_md_valid_until = valid_until;
+    }
+    chand->cache_refresh_in_flight = false;
+    gpr_mu_unlock(&chand->creds_cache_mu);
+    mdb = op->payload->send_initial_metadata.send_initial_metadata;
+    for (i = 0; i < num_md; i++) {
+      add_error(&error, grpc_metadata_batch_add_tail(exec_ctx, mdb,
+                                                     &calld->md_links[i],
+                                                     md[i]));
+    }
+  }
+  if (error == GRPC_ERROR_NONE) {
+    grpc_call_next_op(exec_ctx, elem, op);
+  } else {
+    grpc_transport_stream_op_batch_finish_with_failure(exec_ctx, op, error);
+  }
+}
+
+/* Tries to serve the channel credentials metadata from the channel's cache
+   of prebuilt mdelems. Returns true if op was handled. When the cached
+   metadata is close to expiry, one call is elected to refresh it through the
+   normal fetch path while the others keep using the cache. */
+static bool send_cached_security_metadata(grpc_exec_ctx *exec_ctx,
+                                          grpc_call_element *elem,
+                                          grpc_transport_stream_op_batch *op) {
+  call_data *calld = elem->call_data;
+  channel_data *chand = elem->channel_data;
+  grpc_mdelem md[MAX_CREDENTIALS_METADATA_COUNT];
+  size_t num_md;
+  size_t i;
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  gpr_timespec refresh_threshold = gpr_time_from_seconds(
+      GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS, GPR_TIMESPAN);
+  gpr_mu_lock(&chand->creds_cache_mu);
+  if (chand->cached_md_count == 0 ||
+      gpr_time_cmp(now, chand->cached_md_valid_until) >= 0) {
+    gpr_mu_unlock(&chand->creds_cache_mu);
+    return false;
+  }
+  if (!chand->cache_refresh_in_flight &&
+      gpr_time_cmp(gpr_time_sub(chand->cached_md_valid_until, now),
+                   refresh_threshold) <= 0) {
+    /* Elect this call to refresh the cache ahead of expiry. */
+    chand->cache_refresh_in_flight = true;
+    gpr_mu_unlock(&chand->creds_cache_mu);
+    return false;
+  }
+  num_md = chand->cached_md_count;
+  for (i = 0; i < num_md; i++) {
+    md[i] = GRPC_MDELEM_REF(chand->cached_md[i]);
+  }
+  gpr_mu_unlock(&chand->creds_cache_mu);
+  grpc_error *error = GRPC_ERROR_NONE;
+  grpc_metadata_batch *mdb =
+      op->payload->send_initial_metadata.send_initial_metadata;
+  for (i = 0; i < num_md; i++) {
+    add_error(&error, grpc_metadata_batch_add_tail(exec_ctx, mdb,
+                                                   &calld->md_links[i], md[i]));
+  }
+  if (error == GRPC_ERROR_NONE) {
+    grpc_call_next_op(exec_ctx, elem, op);
+  } else {
+    grpc_transport_stream_op_batch_finish_with_failure(exec_ctx, op, error);
+  }
+  return true;
+}
+
 void build_auth_metadata_context(grpc_security_connector *sc,
                                  grpc_auth_context *auth_context,
                                  call_data *calld) {
@@ -202,6 +329,10 @@ static void send_security_metadata(grpc_exec_ctx *exec_ctx,
       return;
     }
   } else {
+    if (!call_creds_has_md &&
+        send_cached_security_metadata(exec_ctx, elem, op)) {
+      return;
+    }
     calld->creds = grpc_call_credentials_ref(
         call_creds_has_md ? ctx->creds : channel_call_creds);
   }
@@ -210,9 +341,13 @@ static void send_security_metadata(grpc_exec_ctx *exec_ctx,
                               chand->auth_context, calld);
   calld->op = *op; /* Copy op (originates from the caller's stack). */
   GPR_ASSERT(calld->pollent != NULL);
+  /* Metadata from the channel credentials alone is the same for every call,
+     so that path repopulates the channel's mdelem cache on completion. */
   grpc_call_credentials_get_request_metadata(
       exec_ctx, calld->creds, calld->pollent, calld->auth_md_context,
-      on_credentials_metadata, elem);
+      call_creds_has_md ? on_credentials_metadata
+                        : on_channel_credentials_metadata,
+      elem);
 }
 
 static void on_host_checked(grpc_exec_ctx *exec_ctx, void *user_data,
@@ -368,6 +503,10 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
           sc, "client_auth_filter");
   chand->auth_context =
       GRPC_AUTH_CONTEXT_REF(auth_context, "client_auth_filter");
+  gpr_mu_init(&chand->creds_cache_mu);
+  chand->cached_md_count = 0;
+  chand->cached_md_valid_until = gpr_inf_past(GPR_CLOCK_REALTIME);
+  chand->cache_refresh_in_flight = false;
   return GRPC_ERROR_NONE;
 }
 
@@ -377,6 +516,11 @@ static void destroy_channel_elem(grpc_exec_ctx *exec_ctx,
   /* grab pointers to our data from the channel element */
   channel_data *chand = elem->channel_data;
   grpc_channel_security_connector *sc = chand->security_connector;
+  size_t i;
+  for (i = 0; i < chand->cached_md_count; i++) {
+    GRPC_MDELEM_UNREF(exec_ctx, chand->cached_md[i]);
+  }
+  gpr_mu_destroy(&chand->creds_cache_mu);
   if (sc != NULL) {
     GRPC_SECURITY_CONNECTOR_UNREF(exec_ctx, &sc->base, "client_auth_filter");
   }
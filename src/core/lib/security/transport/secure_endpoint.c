@@ -42,6 +42,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
@@ -52,11 +53,19 @@
 #include "src/core/tsi/transport_security_interface.h"
 
 #define STAGING_BUFFER_SIZE 8192
+/* Write-side staging is sized to the default maximum TLS record (16KB) so
+   that each flush hands the wrapped endpoint record-aligned slices and the
+   protector is driven in max-size-record batches. */
+#define WRITE_STAGING_BUFFER_SIZE 16384
+/* Writes with at most this many slices assemble their protect vector on the
+   stack. */
+#define WRITE_VEC_STACK_SLICES 32
 
 typedef struct {
   grpc_endpoint base;
   grpc_endpoint *wrapped_ep;
   struct tsi_frame_protector *protector;
+  struct tsi_zero_copy_grpc_protector *zero_copy_protector;
   gpr_mu protector_mu;
   /* saved upper level callbacks and user_data. */
   grpc_closure *read_cb;
@@ -81,6 +90,7 @@ static void destroy(grpc_exec_ctx *exec_ctx, secure_endpoint *secure_ep) {
   secure_endpoint *ep = secure_ep;
   grpc_endpoint_destroy(exec_ctx, ep->wrapped_ep);
   tsi_frame_protector_destroy(ep->protector);
+  tsi_zero_copy_grpc_protector_destroy(ep->zero_copy_protector);
   grpc_slice_buffer_destroy_internal(exec_ctx, &ep->leftover_bytes);
   grpc_slice_unref_internal(exec_ctx, ep->read_staging_buffer);
   grpc_slice_unref_internal(exec_ctx, ep->write_staging_buffer);
@@ -167,6 +177,26 @@ static void on_read(grpc_exec_ctx *exec_ctx, void *user_data,
     return;
   }
 
+  if (ep->zero_copy_protector != NULL) {
+    /* Decrypted frames are moved straight into the read buffer; bytes of an
+       incomplete trailing frame stay buffered in the protector until the
+       next read. */
+    gpr_mu_lock(&ep->protector_mu);
+    result = tsi_zero_copy_grpc_protector_unprotect(
+        ep->zero_copy_protector, &ep->source_buffer, ep->read_buffer);
+    gpr_mu_unlock(&ep->protector_mu);
+    if (result != TSI_OK) {
+      grpc_slice_buffer_reset_and_unref_internal(exec_ctx, ep->read_buffer);
+      call_read_cb(
+          exec_ctx, ep,
+          grpc_set_tsi_error_result(
+              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Unwrap failed"), result));
+      return;
+    }
+    call_read_cb(exec_ctx, ep, GRPC_ERROR_NONE);
+    return;
+  }
+
   /* TODO(yangg) check error, maybe bail out early */
   for (i = 0; i < ep->source_buffer.count; i++) {
     grpc_slice encrypted = ep->source_buffer.slices[i];
@@ -252,7 +282,7 @@ static void endpoint_read(grpc_exec_ctx *exec_ctx, grpc_endpoint *secure_ep,
 static void flush_write_staging_buffer(secure_endpoint *ep, uint8_t **cur,
                                        uint8_t **end) {
   grpc_slice_buffer_add(&ep->output_buffer, ep->write_staging_buffer);
-  ep->write_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
+  ep->write_staging_buffer = GRPC_SLICE_MALLOC(WRITE_STAGING_BUFFER_SIZE);
   *cur = GRPC_SLICE_START_PTR(ep->write_staging_buffer);
   *end = GRPC_SLICE_END_PTR(ep->write_staging_buffer);
 }
@@ -278,54 +308,87 @@ static void endpoint_write(grpc_exec_ctx *exec_ctx, grpc_endpoint *secure_ep,
     }
   }
 
-  for (i = 0; i < slices->count; i++) {
-    grpc_slice plain = slices->slices[i];
-    uint8_t *message_bytes = GRPC_SLICE_START_PTR(plain);
-    size_t message_size = GRPC_SLICE_LENGTH(plain);
-    while (message_size > 0) {
+  if (ep->zero_copy_protector != NULL) {
+    /* Frames move straight from the caller's slices into the output
+       buffer. */
+    gpr_mu_lock(&ep->protector_mu);
+    result = tsi_zero_copy_grpc_protector_protect(ep->zero_copy_protector,
+                                                  slices, &ep->output_buffer);
+    gpr_mu_unlock(&ep->protector_mu);
+  } else {
+    /* Hand the whole pending write to the protector as one vector: sealing
+       proceeds in max-size-record batches regardless of how the plaintext is
+       sliced, and the protector lock is taken once per staging buffer filled
+       rather than once per slice. */
+    tsi_iovec vec_stack[WRITE_VEC_STACK_SLICES];
+    tsi_iovec *vec = vec_stack;
+    size_t vec_count = slices->count;
+    size_t vec_offset = 0;
+    if (vec_count > GPR_ARRAY_SIZE(vec_stack)) {
+      vec = (tsi_iovec *)gpr_malloc(vec_count * sizeof(*vec));
+    }
+    for (i = 0; i < slices->count; i++) {
+      vec[i].data = GRPC_SLICE_START_PTR(slices->slices[i]);
+      vec[i].size = GRPC_SLICE_LENGTH(slices->slices[i]);
+    }
+    while (vec_offset < vec_count) {
       size_t protected_buffer_size_to_send = (size_t)(end - cur);
-      size_t processed_message_size = message_size;
+      size_t consumed = 0;
       gpr_mu_lock(&ep->protector_mu);
-      result = tsi_frame_protector_protect(ep->protector, message_bytes,
-                                           &processed_message_size, cur,
-                                           &protected_buffer_size_to_send);
+      result = tsi_frame_protector_protect_vectored(
+          ep->protector, vec + vec_offset, vec_count - vec_offset, &consumed,
+          cur, &protected_buffer_size_to_send);
       gpr_mu_unlock(&ep->protector_mu);
       if (result != TSI_OK) {
         gpr_log(GPR_ERROR, "Encryption error: %s",
                 tsi_result_to_string(result));
         break;
       }
-      message_bytes += processed_message_size;
-      message_size -= processed_message_size;
+      if (consumed == 0 && protected_buffer_size_to_send == 0) {
+        gpr_log(GPR_ERROR, "Encryption error: protector made no progress");
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
       cur += protected_buffer_size_to_send;
-
+      /* Skip past fully consumed chunks; trim the first partial one. */
+      while (consumed > 0) {
+        if (vec[vec_offset].size <= consumed) {
+          consumed -= vec[vec_offset].size;
+          vec_offset++;
+        } else {
+          vec[vec_offset].data += consumed;
+          vec[vec_offset].size -= consumed;
+          consumed = 0;
+        }
+      }
       if (cur == end) {
         flush_write_staging_buffer(ep, &cur, &end);
       }
     }
-    if (result != TSI_OK) break;
-  }
-  if (result == TSI_OK) {
-    size_t still_pending_size;
-    do {
-      size_t protected_buffer_size_to_send = (size_t)(end - cur);
-      gpr_mu_lock(&ep->protector_mu);
-      result = tsi_frame_protector_protect_flush(ep->protector, cur,
-                                                 &protected_buffer_size_to_send,
-                                                 &still_pending_size);
-      gpr_mu_unlock(&ep->protector_mu);
-      if (result != TSI_OK) break;
-      cur += protected_buffer_size_to_send;
-      if (cur == end) {
-        flush_write_staging_buffer(ep, &cur, &end);
+    if (vec != vec_stack) gpr_free(vec);
+    if (result == TSI_OK) {
+      size_t still_pending_size;
+      do {
+        size_t protected_buffer_size_to_send = (size_t)(end - cur);
+        gpr_mu_lock(&ep->protector_mu);
+        result = tsi_frame_protector_protect_flush(
+            ep->protector, cur, &protected_buffer_size_to_send,
+            &still_pending_size);
+        gpr_mu_unlock(&ep->protector_mu);
+        if (result != TSI_OK) break;
+        cur += protected_buffer_size_to_send;
+        if (cur == end) {
+          flush_write_staging_buffer(ep, &cur, &end);
+        }
+      } while (still_pending_size > 0);
+      if (cur != GRPC_SLICE_START_PTR(ep->write_staging_buffer)) {
+        grpc_slice_buffer_add(
+            &ep->output_buffer,
+            grpc_slice_split_head(
+                &ep->write_staging_buffer,
+                (size_t)(cur -
+                         GRPC_SLICE_START_PTR(ep->write_staging_buffer))));
       }
-    } while (still_pending_size > 0);
-    if (cur != GRPC_SLICE_START_PTR(ep->write_staging_buffer)) {
-      grpc_slice_buffer_add(
-          &ep->output_buffer,
-          grpc_slice_split_head(
-              &ep->write_staging_buffer,
-              (size_t)(cur - GRPC_SLICE_START_PTR(ep->write_staging_buffer))));
     }
   }
 
@@ -403,19 +466,22 @@ static const grpc_endpoint_vtable vtable = {endpoint_read,
                                             endpoint_get_fd};
 
 grpc_endpoint *grpc_secure_endpoint_create(
-    struct tsi_frame_protector *protector, grpc_endpoint *transport,
-    grpc_slice *leftover_slices, size_t leftover_nslices) {
+    struct tsi_frame_protector *protector,
+    struct tsi_zero_copy_grpc_protector *zero_copy_protector,
+    grpc_endpoint *transport, grpc_slice *leftover_slices,
+    size_t leftover_nslices) {
   size_t i;
   secure_endpoint *ep = (secure_endpoint *)gpr_malloc(sizeof(secure_endpoint));
   ep->base.vtable = &vtable;
   ep->wrapped_ep = transport;
   ep->protector = protector;
+  ep->zero_copy_protector = zero_copy_protector;
   grpc_slice_buffer_init(&ep->leftover_bytes);
   for (i = 0; i < leftover_nslices; i++) {
     grpc_slice_buffer_add(&ep->leftover_bytes,
                           grpc_slice_ref_internal(leftover_slices[i]));
   }
-  ep->write_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
+  ep->write_staging_buffer = GRPC_SLICE_MALLOC(WRITE_STAGING_BUFFER_SIZE);
   ep->read_staging_buffer = GRPC_SLICE_MALLOC(STAGING_BUFFER_SIZE);
   grpc_slice_buffer_init(&ep->output_buffer);
   grpc_slice_buffer_init(&ep->source_buffer);
@@ -53,6 +53,7 @@
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/security_handshaker.h"
 #include "src/core/lib/support/env.h"
+#include "src/core/lib/support/murmur_hash.h"
 #include "src/core/lib/support/string.h"
 #include "src/core/tsi/fake_transport_security.h"
 #include "src/core/tsi/ssl_transport_security.h"
@@ -444,11 +445,36 @@ grpc_server_security_connector *grpc_fake_server_security_connector_create(
 
 /* --- Ssl implementation. --- */
 
+/* The ALPN protocol list never changes for the lifetime of the process:
+   compute it once and share it read-only across all connectors. */
+static const char **g_alpn_protocol_strings = NULL;
+static size_t g_num_alpn_protocols = 0;
+
+static void init_alpn_protocol_strings(void) {
+  size_t i;
+  g_num_alpn_protocols = grpc_chttp2_num_alpn_versions();
+  g_alpn_protocol_strings =
+      gpr_malloc(sizeof(const char *) * g_num_alpn_protocols);
+  for (i = 0; i < g_num_alpn_protocols; i++) {
+    g_alpn_protocol_strings[i] = grpc_chttp2_get_alpn_version_index(i);
+  }
+}
+
+static const char **alpn_protocol_strings(size_t *num_alpn_protocols) {
+  static gpr_once once = GPR_ONCE_INIT;
+  gpr_once_init(&once, init_alpn_protocol_strings);
+  *num_alpn_protocols = g_num_alpn_protocols;
+  return g_alpn_protocol_strings;
+}
+
 typedef struct {
   grpc_channel_security_connector base;
   tsi_ssl_client_handshaker_factory *handshaker_factory;
   char *target_name;
   char *overridden_target_name;
+  /* The (port-stripped) name every handshake checks the peer certificate
+     against, precomputed so the per-handshake path does not re-parse it. */
+  char *verified_peer_name;
 } grpc_ssl_channel_security_connector;
 
 typedef struct {
@@ -466,6 +492,7 @@ static void ssl_channel_destroy(grpc_exec_ctx *exec_ctx,
   }
   if (c->target_name != NULL) gpr_free(c->target_name);
   if (c->overridden_target_name != NULL) gpr_free(c->overridden_target_name);
+  if (c->verified_peer_name != NULL) gpr_free(c->verified_peer_name);
   gpr_free(sc);
 }
 
@@ -580,6 +607,107 @@ grpc_auth_context *tsi_ssl_peer_to_auth_context(const tsi_peer *peer) {
   return ctx;
 }
 
+/* --- Auth context interning. ---
+
+   Connections from the same peer present the same certificate, so instead of
+   rebuilding an auth context from the tsi peer for each of them, the context
+   is interned: a small cache keyed by the peer certificate maps to one
+   immutable shared context, and each connection gets a cheap mutable wrapper
+   chained onto it. Property additions made by auth processors land in the
+   wrapper and never leak into the shared context. */
+
+#define AUTH_CONTEXT_CACHE_MAX_ENTRIES 64
+
+typedef struct auth_context_cache_entry {
+  uint32_t hash;
+  char *key; /* the peer certificate in PEM format */
+  size_t key_length;
+  grpc_auth_context *auth_context;
+  struct auth_context_cache_entry *next;
+} auth_context_cache_entry;
+
+static gpr_mu g_auth_context_cache_mu;
+static auth_context_cache_entry *g_auth_context_cache = NULL;
+static size_t g_auth_context_cache_size = 0;
+
+static void auth_context_cache_init(void) {
+  gpr_mu_init(&g_auth_context_cache_mu);
+}
+
+static auth_context_cache_entry *auth_context_cache_find_locked(
+    uint32_t hash, const char *key, size_t key_length) {
+  auth_context_cache_entry *e;
+  for (e = g_auth_context_cache; e != NULL; e = e->next) {
+    if (e->hash == hash && e->key_length == key_length &&
+        memcmp(e->key, key, key_length) == 0) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+static void auth_context_cache_evict_tail_locked(void) {
+  auth_context_cache_entry **prev = &g_auth_context_cache;
+  auth_context_cache_entry *e = g_auth_context_cache;
+  if (e == NULL) return;
+  while (e->next != NULL) {
+    prev = &e->next;
+    e = e->next;
+  }
+  *prev = NULL;
+  GRPC_AUTH_CONTEXT_UNREF(e->auth_context, "auth_context_cache");
+  gpr_free(e->key);
+  gpr_free(e);
+  g_auth_context_cache_size--;
+}
+
+static grpc_auth_context *ssl_peer_to_interned_auth_context(
+    const tsi_peer *peer) {
+  static gpr_once once = GPR_ONCE_INIT;
+  const tsi_peer_property *cert =
+      tsi_peer_get_property_by_name(peer, TSI_X509_PEM_CERT_PROPERTY);
+  if (cert == NULL) {
+    /* No certificate to key on (e.g. server did not request one). */
+    return tsi_ssl_peer_to_auth_context(peer);
+  }
+  gpr_once_init(&once, auth_context_cache_init);
+  uint32_t hash =
+      gpr_murmur_hash3(cert->value.data, cert->value.length, 0xa5a5a5a5);
+  gpr_mu_lock(&g_auth_context_cache_mu);
+  auth_context_cache_entry *e = auth_context_cache_find_locked(
+      hash, cert->value.data, cert->value.length);
+  if (e == NULL) {
+    gpr_mu_unlock(&g_auth_context_cache_mu);
+    grpc_auth_context *built = tsi_ssl_peer_to_auth_context(peer);
+    gpr_mu_lock(&g_auth_context_cache_mu);
+    /* Someone may have raced us here; their copy is as good as ours. */
+    e = auth_context_cache_find_locked(hash, cert->value.data,
+                                       cert->value.length);
+    if (e == NULL) {
+      if (g_auth_context_cache_size == AUTH_CONTEXT_CACHE_MAX_ENTRIES) {
+        auth_context_cache_evict_tail_locked();
+      }
+      e = gpr_malloc(sizeof(*e));
+      e->hash = hash;
+      e->key_length = cert->value.length;
+      e->key = gpr_malloc(cert->value.length);
+      memcpy(e->key, cert->value.data, cert->value.length);
+      e->auth_context = built;
+      e->next = g_auth_context_cache;
+      g_auth_context_cache = e;
+      g_auth_context_cache_size++;
+    } else {
+      GRPC_AUTH_CONTEXT_UNREF(built, "auth_context_cache");
+    }
+  }
+  grpc_auth_context *shared =
+      GRPC_AUTH_CONTEXT_REF(e->auth_context, "auth_context_wrapper");
+  gpr_mu_unlock(&g_auth_context_cache_mu);
+  grpc_auth_context *wrapper = grpc_auth_context_create(shared);
+  GRPC_AUTH_CONTEXT_UNREF(shared, "auth_context_wrapper");
+  return wrapper;
+}
+
 static grpc_error *ssl_check_peer(grpc_security_connector *sc,
                                   const char *peer_name, const tsi_peer *peer,
                                   grpc_auth_context **auth_context) {
@@ -603,7 +731,7 @@ static grpc_error *ssl_check_peer(grpc_security_connector *sc,
     gpr_free(msg);
     return error;
   }
-  *auth_context = tsi_ssl_peer_to_auth_context(peer);
+  *auth_context = ssl_peer_to_interned_auth_context(peer);
   return GRPC_ERROR_NONE;
 }
 
@@ -613,10 +741,8 @@ static void ssl_channel_check_peer(grpc_exec_ctx *exec_ctx,
                                    grpc_closure *on_peer_checked) {
   grpc_ssl_channel_security_connector *c =
       (grpc_ssl_channel_security_connector *)sc;
-  grpc_error *error = ssl_check_peer(sc, c->overridden_target_name != NULL
-                                             ? c->overridden_target_name
-                                             : c->target_name,
-                                     &peer, auth_context);
+  grpc_error *error =
+      ssl_check_peer(sc, c->verified_peer_name, &peer, auth_context);
   grpc_closure_sched(exec_ctx, on_peer_checked, error);
   tsi_peer_destruct(&peer);
 }
@@ -709,8 +835,8 @@ static grpc_slice compute_default_pem_root_certs_once(void) {
   char *default_root_certs_path =
       gpr_getenv(GRPC_DEFAULT_SSL_ROOTS_FILE_PATH_ENV_VAR);
   if (default_root_certs_path != NULL) {
-    GRPC_LOG_IF_ERROR("load_file",
-                      grpc_load_file(default_root_certs_path, 1, &result));
+    GRPC_LOG_IF_ERROR(
+        "load_file", grpc_load_file_cached(default_root_certs_path, 1, &result));
     gpr_free(default_root_certs_path);
   }
 
@@ -732,7 +858,7 @@ static grpc_slice compute_default_pem_root_certs_once(void) {
   if (GRPC_SLICE_IS_EMPTY(result) &&
       ovrd_res != GRPC_SSL_ROOTS_OVERRIDE_FAIL_PERMANENTLY) {
     GRPC_LOG_IF_ERROR("load_file",
-                      grpc_load_file(installed_roots_path, 1, &result));
+                      grpc_load_file_cached(installed_roots_path, 1, &result));
   }
   return result;
 }
@@ -786,28 +912,22 @@ grpc_security_status grpc_ssl_channel_security_connector_create(
     grpc_exec_ctx *exec_ctx, grpc_call_credentials *request_metadata_creds,
     const grpc_ssl_config *config, const char *target_name,
     const char *overridden_target_name, grpc_channel_security_connector **sc) {
-  size_t num_alpn_protocols = grpc_chttp2_num_alpn_versions();
-  const char **alpn_protocol_strings =
-      gpr_malloc(sizeof(const char *) * num_alpn_protocols);
+  size_t num_alpn_protocols;
+  const char **alpn_protocols = alpn_protocol_strings(&num_alpn_protocols);
   tsi_result result = TSI_OK;
   grpc_ssl_channel_security_connector *c;
-  size_t i;
   const char *pem_root_certs;
   char *port;
 
-  for (i = 0; i < num_alpn_protocols; i++) {
-    alpn_protocol_strings[i] = grpc_chttp2_get_alpn_version_index(i);
-  }
-
   if (config == NULL || target_name == NULL) {
     gpr_log(GPR_ERROR, "An ssl channel needs a config and a target name.");
-    goto error;
+    return GRPC_SECURITY_ERROR;
   }
   if (config->pem_root_certs == NULL) {
     pem_root_certs = grpc_get_default_ssl_roots();
     if (pem_root_certs == NULL) {
       gpr_log(GPR_ERROR, "Could not get default pem root certs.");
-      goto error;
+      return GRPC_SECURITY_ERROR;
     }
   } else {
     pem_root_certs = config->pem_root_certs;
@@ -826,47 +946,40 @@ grpc_security_status grpc_ssl_channel_security_connector_create(
   gpr_free(port);
   if (overridden_target_name != NULL) {
     c->overridden_target_name = gpr_strdup(overridden_target_name);
+    gpr_split_host_port(overridden_target_name, &c->verified_peer_name, &port);
+    gpr_free(port);
+  } else {
+    c->verified_peer_name = gpr_strdup(c->target_name);
   }
 
   bool has_key_cert_pair = config->pem_key_cert_pair.private_key != NULL &&
                            config->pem_key_cert_pair.cert_chain != NULL;
   result = tsi_create_ssl_client_handshaker_factory(
       has_key_cert_pair ? &config->pem_key_cert_pair : NULL, pem_root_certs,
-      ssl_cipher_suites(), alpn_protocol_strings, (uint16_t)num_alpn_protocols,
+      ssl_cipher_suites(), alpn_protocols, (uint16_t)num_alpn_protocols,
       &c->handshaker_factory);
   if (result != TSI_OK) {
     gpr_log(GPR_ERROR, "Handshaker factory creation failed with %s.",
             tsi_result_to_string(result));
     ssl_channel_destroy(exec_ctx, &c->base.base);
     *sc = NULL;
-    goto error;
+    return GRPC_SECURITY_ERROR;
   }
   *sc = &c->base;
-  gpr_free((void *)alpn_protocol_strings);
   return GRPC_SECURITY_OK;
-
-error:
-  gpr_free((void *)alpn_protocol_strings);
-  return GRPC_SECURITY_ERROR;
 }
 
 grpc_security_status grpc_ssl_server_security_connector_create(
     grpc_exec_ctx *exec_ctx, const grpc_ssl_server_config *config,
     grpc_server_security_connector **sc) {
-  size_t num_alpn_protocols = grpc_chttp2_num_alpn_versions();
-  const char **alpn_protocol_strings =
-      gpr_malloc(sizeof(const char *) * num_alpn_protocols);
+  size_t num_alpn_protocols;
+  const char **alpn_protocols = alpn_protocol_strings(&num_alpn_protocols);
   tsi_result result = TSI_OK;
   grpc_ssl_server_security_connector *c;
-  size_t i;
-
-  for (i = 0; i < num_alpn_protocols; i++) {
-    alpn_protocol_strings[i] = grpc_chttp2_get_alpn_version_index(i);
-  }
 
   if (config == NULL || config->num_key_cert_pairs == 0) {
     gpr_log(GPR_ERROR, "An SSL server needs a key and a cert.");
-    goto error;
+    return GRPC_SECURITY_ERROR;
   }
   c = gpr_zalloc(sizeof(grpc_ssl_server_security_connector));
 
@@ -877,21 +990,16 @@ grpc_security_status grpc_ssl_server_security_connector_create(
       config->pem_key_cert_pairs, config->num_key_cert_pairs,
       config->pem_root_certs, get_tsi_client_certificate_request_type(
                                   config->client_certificate_request),
-      ssl_cipher_suites(), alpn_protocol_strings, (uint16_t)num_alpn_protocols,
+      ssl_cipher_suites(), alpn_protocols, (uint16_t)num_alpn_protocols,
       &c->handshaker_factory);
   if (result != TSI_OK) {
     gpr_log(GPR_ERROR, "Handshaker factory creation failed with %s.",
             tsi_result_to_string(result));
     ssl_server_destroy(exec_ctx, &c->base.base);
     *sc = NULL;
-    goto error;
+    return GRPC_SECURITY_ERROR;
   }
   c->base.add_handshakers = ssl_server_add_handshakers;
   *sc = &c->base;
-  gpr_free((void *)alpn_protocol_strings);
   return GRPC_SECURITY_OK;
-
-error:
-  gpr_free((void *)alpn_protocol_strings);
-  return GRPC_SECURITY_ERROR;
 }
@@ -43,6 +43,7 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/handshaker.h"
 #include "src/core/lib/channel/handshaker_registry.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
@@ -50,7 +51,9 @@
 
 #define GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE 256
 
-typedef struct {
+#define GRPC_SECURITY_HANDSHAKE_DEFAULT_MAX_CONCURRENT 100
+
+typedef struct security_handshaker {
   grpc_handshaker base;
 
   // State set at creation time.
@@ -72,13 +75,90 @@ typedef struct {
   unsigned char *handshake_buffer;
   size_t handshake_buffer_size;
   grpc_slice_buffer outgoing;
+  grpc_closure begin_handshake;
   grpc_closure on_handshake_data_sent_to_peer;
   grpc_closure on_handshake_data_received_from_peer;
   grpc_closure on_peer_checked;
   grpc_auth_context *auth_context;
   tsi_handshaker_result *handshaker_result;
+
+  // Handshake pool state: whether this handshake holds one of the
+  // concurrency slots, and the link used while waiting for one.
+  bool pool_slot_held;
+  struct security_handshaker *next_pending;
 } security_handshaker;
 
+// Pool limiting how many handshakes run their CPU-bound TSI steps
+// concurrently. Those steps are scheduled on the executor so that poller
+// threads only perform the handshake I/O; the cap (with a FIFO of waiting
+// handshakes) keeps a reconnect storm from saturating the executor threads.
+static gpr_once g_handshake_pool_once = GPR_ONCE_INIT;
+static gpr_mu g_handshake_pool_mu;
+static size_t g_handshake_pool_max_concurrent =
+    GRPC_SECURITY_HANDSHAKE_DEFAULT_MAX_CONCURRENT;
+static size_t g_handshake_pool_in_flight = 0;
+static security_handshaker *g_handshake_pool_pending_head = NULL;
+static security_handshaker *g_handshake_pool_pending_tail = NULL;
+
+static void handshake_pool_init(void) { gpr_mu_init(&g_handshake_pool_mu); }
+
+// Schedules h's begin_handshake closure if a concurrency slot is available,
+// and queues h otherwise. Requires h->mu.
+static void handshake_pool_acquire_locked(grpc_exec_ctx *exec_ctx,
+                                          security_handshaker *h) {
+  gpr_once_init(&g_handshake_pool_once, handshake_pool_init);
+  gpr_mu_lock(&g_handshake_pool_mu);
+  if (g_handshake_pool_in_flight < g_handshake_pool_max_concurrent) {
+    g_handshake_pool_in_flight++;
+    gpr_mu_unlock(&g_handshake_pool_mu);
+    h->pool_slot_held = true;
+    grpc_closure_sched(exec_ctx, &h->begin_handshake, GRPC_ERROR_NONE);
+  } else {
+    if (g_handshake_pool_pending_tail == NULL) {
+      g_handshake_pool_pending_head = h;
+    } else {
+      g_handshake_pool_pending_tail->next_pending = h;
+    }
+    g_handshake_pool_pending_tail = h;
+    gpr_mu_unlock(&g_handshake_pool_mu);
+  }
+}
+
+// Hands h's concurrency slot to the longest-waiting queued handshake, or
+// frees it if none are waiting. Called exactly once per started handshake,
+// when its outcome is known. Requires h->mu (taken before the pool mutex, as
+// in handshake_pool_acquire_locked).
+static void handshake_pool_release_locked(grpc_exec_ctx *exec_ctx,
+                                          security_handshaker *h) {
+  if (!h->pool_slot_held) return;
+  h->pool_slot_held = false;
+  gpr_mu_lock(&g_handshake_pool_mu);
+  security_handshaker *next = g_handshake_pool_pending_head;
+  if (next == NULL) {
+    g_handshake_pool_in_flight--;
+    gpr_mu_unlock(&g_handshake_pool_mu);
+    return;
+  }
+  g_handshake_pool_pending_head = next->next_pending;
+  if (g_handshake_pool_pending_head == NULL) {
+    g_handshake_pool_pending_tail = NULL;
+  }
+  next->next_pending = NULL;
+  gpr_mu_unlock(&g_handshake_pool_mu);
+  // The slot is transferred to next, whose begin_handshake closure has not
+  // run yet (nothing else touches pool_slot_held until it does).
+  next->pool_slot_held = true;
+  grpc_closure_sched(exec_ctx, &next->begin_handshake, GRPC_ERROR_NONE);
+}
+
+void grpc_security_handshaker_set_max_concurrent_handshakes(size_t max) {
+  GPR_ASSERT(max >= 1);
+  gpr_once_init(&g_handshake_pool_once, handshake_pool_init);
+  gpr_mu_lock(&g_handshake_pool_mu);
+  g_handshake_pool_max_concurrent = max;
+  gpr_mu_unlock(&g_handshake_pool_mu);
+}
+
 static void security_handshaker_unref(grpc_exec_ctx *exec_ctx,
                                       security_handshaker *h) {
   if (gpr_unref(&h->refs)) {
@@ -138,6 +218,7 @@ static void security_handshake_failed_locked(grpc_exec_ctx *exec_ctx,
     // security_handshaker_shutdown() do nothing.
     h->shutdown = true;
   }
+  handshake_pool_release_locked(exec_ctx, h);
   // Invoke callback.
   grpc_closure_sched(exec_ctx, h->on_handshake_done, error);
 }
@@ -150,17 +231,31 @@ static void on_peer_checked(grpc_exec_ctx *exec_ctx, void *arg,
     security_handshake_failed_locked(exec_ctx, h, GRPC_ERROR_REF(error));
     goto done;
   }
-  // Create frame protector.
-  tsi_frame_protector *protector;
-  tsi_result result = tsi_handshaker_result_create_frame_protector(
-      h->handshaker_result, NULL, &protector);
-  if (result != TSI_OK) {
+  // Create zero-copy frame protector, if implemented.
+  tsi_zero_copy_grpc_protector *zero_copy_protector = NULL;
+  tsi_result result = tsi_handshaker_result_create_zero_copy_grpc_protector(
+      h->handshaker_result, NULL, &zero_copy_protector);
+  if (result != TSI_OK && result != TSI_UNIMPLEMENTED) {
     error = grpc_set_tsi_error_result(
-        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Frame protector creation failed"),
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Zero-copy frame protector creation failed"),
         result);
     security_handshake_failed_locked(exec_ctx, h, error);
     goto done;
   }
+  // Create frame protector if zero-copy is unavailable.
+  tsi_frame_protector *protector = NULL;
+  if (zero_copy_protector == NULL) {
+    result = tsi_handshaker_result_create_frame_protector(h->handshaker_result,
+                                                          NULL, &protector);
+    if (result != TSI_OK) {
+      error = grpc_set_tsi_error_result(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                            "Frame protector creation failed"),
+                                        result);
+      security_handshake_failed_locked(exec_ctx, h, error);
+      goto done;
+    }
+  }
   // Get unused bytes.
   unsigned char *unused_bytes = NULL;
   size_t unused_bytes_size = 0;
@@ -170,12 +265,12 @@ static void on_peer_checked(grpc_exec_ctx *exec_ctx, void *arg,
   if (unused_bytes_size > 0) {
     grpc_slice slice =
         grpc_slice_from_copied_buffer((char *)unused_bytes, unused_bytes_size);
-    h->args->endpoint =
-        grpc_secure_endpoint_create(protector, h->args->endpoint, &slice, 1);
+    h->args->endpoint = grpc_secure_endpoint_create(
+        protector, zero_copy_protector, h->args->endpoint, &slice, 1);
     grpc_slice_unref_internal(exec_ctx, slice);
   } else {
-    h->args->endpoint =
-        grpc_secure_endpoint_create(protector, h->args->endpoint, NULL, 0);
+    h->args->endpoint = grpc_secure_endpoint_create(
+        protector, zero_copy_protector, h->args->endpoint, NULL, 0);
   }
   tsi_handshaker_result_destroy(h->handshaker_result);
   h->handshaker_result = NULL;
@@ -187,6 +282,7 @@ static void on_peer_checked(grpc_exec_ctx *exec_ctx, void *arg,
   h->args->args =
       grpc_channel_args_copy_and_add(tmp_args, &auth_context_arg, 1);
   grpc_channel_args_destroy(exec_ctx, tmp_args);
+  handshake_pool_release_locked(exec_ctx, h);
   // Invoke callback.
   grpc_closure_sched(exec_ctx, h->on_handshake_done, GRPC_ERROR_NONE);
   // Set shutdown to true so that subsequent calls to
@@ -294,6 +390,28 @@ static grpc_error *do_handshaker_next_locked(
                                        bytes_to_send_size, handshaker_result);
 }
 
+// Runs the first TSI handshake step once a concurrency slot has been
+// obtained. Scheduled on the executor so the crypto runs off poller threads.
+static void begin_handshake(grpc_exec_ctx *exec_ctx, void *arg,
+                            grpc_error *error) {
+  security_handshaker *h = arg;
+  gpr_mu_lock(&h->mu);
+  if (h->shutdown) {
+    security_handshake_failed_locked(exec_ctx, h, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&h->mu);
+    security_handshaker_unref(exec_ctx, h);
+    return;
+  }
+  error = do_handshaker_next_locked(exec_ctx, h, NULL, 0);
+  if (error != GRPC_ERROR_NONE) {
+    security_handshake_failed_locked(exec_ctx, h, error);
+    gpr_mu_unlock(&h->mu);
+    security_handshaker_unref(exec_ctx, h);
+    return;
+  }
+  gpr_mu_unlock(&h->mu);
+}
+
 static void on_handshake_data_received_from_peer(grpc_exec_ctx *exec_ctx,
                                                  void *arg, grpc_error *error) {
   security_handshaker *h = arg;
@@ -398,13 +516,8 @@ static void security_handshaker_do_handshake(grpc_exec_ctx *exec_ctx,
   h->args = args;
   h->on_handshake_done = on_handshake_done;
   gpr_ref(&h->refs);
-  grpc_error *error = do_handshaker_next_locked(exec_ctx, h, NULL, 0);
-  if (error != GRPC_ERROR_NONE) {
-    security_handshake_failed_locked(exec_ctx, h, error);
-    gpr_mu_unlock(&h->mu);
-    security_handshaker_unref(exec_ctx, h);
-    return;
-  }
+  // The TSI steps run on the executor, gated by the handshake pool.
+  handshake_pool_acquire_locked(exec_ctx, h);
   gpr_mu_unlock(&h->mu);
 }
 
@@ -423,12 +536,16 @@ static grpc_handshaker *security_handshaker_create(
   gpr_ref_init(&h->refs, 1);
   h->handshake_buffer_size = GRPC_INITIAL_HANDSHAKE_BUFFER_SIZE;
   h->handshake_buffer = gpr_malloc(h->handshake_buffer_size);
+  grpc_closure_init(&h->begin_handshake, begin_handshake, h,
+                    grpc_executor_scheduler);
   grpc_closure_init(&h->on_handshake_data_sent_to_peer,
                     on_handshake_data_sent_to_peer, h,
                     grpc_schedule_on_exec_ctx);
+  // Received-data processing is where the CPU-bound crypto happens; run it
+  // on the executor so poller threads only do the reads and writes.
   grpc_closure_init(&h->on_handshake_data_received_from_peer,
                     on_handshake_data_received_from_peer, h,
-                    grpc_schedule_on_exec_ctx);
+                    grpc_executor_scheduler);
   grpc_closure_init(&h->on_peer_checked, on_peer_checked, h,
                     grpc_schedule_on_exec_ctx);
   grpc_slice_buffer_init(&h->outgoing);
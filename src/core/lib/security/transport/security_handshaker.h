@@ -46,4 +46,11 @@ grpc_handshaker *grpc_security_handshaker_create(
 /// Registers security handshaker factories.
 void grpc_security_register_handshaker_factories();
 
+/// Sets the maximum number of security handshakes allowed to run their
+/// CPU-bound crypto steps concurrently (default 100). Handshakes started
+/// beyond the cap are queued and begin as running handshakes complete, so a
+/// reconnect storm cannot monopolize the executor threads. \a max must be at
+/// least 1.
+void grpc_security_handshaker_set_max_concurrent_handshakes(size_t max);
+
 #endif /* GRPC_CORE_LIB_SECURITY_TRANSPORT_SECURITY_HANDSHAKER_H */
@@ -33,9 +33,12 @@
 
 #include "src/core/lib/slice/percent_encoding.h"
 
+#include <string.h>
+
 #include <grpc/support/log.h>
 
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/swar.h"
 
 const uint8_t grpc_url_percent_encoding_unreserved_bytes[256 / 8] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0xff, 0x03, 0xfe, 0xff, 0xff,
@@ -51,6 +54,43 @@ static bool is_unreserved_character(uint8_t c,
   return ((unreserved_bytes[c / 8] >> (c % 8)) & 1) != 0;
 }
 
+/* 0x80 in each unreserved byte of \a w for the url table:
+   alphanumerics plus '-' '.' '_' '~' */
+static uint64_t url_unreserved_word(uint64_t w) {
+  return gpr_swar_bytes_in_range(w, '-', '.') |
+         gpr_swar_bytes_in_range(w, '0', '9') |
+         gpr_swar_bytes_in_range(w, 'A', 'Z') |
+         gpr_swar_bytes_in_range(w, '_', '_') |
+         gpr_swar_bytes_in_range(w, 'a', 'z') |
+         gpr_swar_bytes_in_range(w, '~', '~');
+}
+
+/* 0x80 in each unreserved byte of \a w for the compatible table:
+   all printable ascii except '%' */
+static uint64_t compatible_unreserved_word(uint64_t w) {
+  return gpr_swar_bytes_in_range(w, 0x20, 0x7e) &
+         ~gpr_swar_bytes_in_range(w, '%', '%');
+}
+
+typedef uint64_t (*unreserved_word_fn)(uint64_t w);
+
+static unreserved_word_fn word_classifier_for(const uint8_t *unreserved_bytes) {
+  if (unreserved_bytes == grpc_url_percent_encoding_unreserved_bytes) {
+    return url_unreserved_word;
+  }
+  if (unreserved_bytes == grpc_compatible_percent_encoding_unreserved_bytes) {
+    return compatible_unreserved_word;
+  }
+  return NULL;
+}
+
+/* returns true if the 8 bytes at \a p are all unreserved */
+static bool word_is_unreserved(const uint8_t *p, unreserved_word_fn classify) {
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  return (w & GPR_SWAR_HIGHS) == 0 && classify(w) == GPR_SWAR_HIGHS;
+}
+
 grpc_slice grpc_percent_encode_slice(grpc_slice slice,
                                      const uint8_t *unreserved_bytes) {
   static const uint8_t hex[] = "0123456789ABCDEF";
@@ -59,12 +99,20 @@ grpc_slice grpc_percent_encode_slice(grpc_slice slice,
   size_t output_length = 0;
   const uint8_t *slice_start = GRPC_SLICE_START_PTR(slice);
   const uint8_t *slice_end = GRPC_SLICE_END_PTR(slice);
-  const uint8_t *p;
+  const uint8_t *p = slice_start;
   bool any_reserved_bytes = false;
-  for (p = slice_start; p < slice_end; p++) {
+  unreserved_word_fn classify = word_classifier_for(unreserved_bytes);
+  while (p < slice_end) {
+    if (classify != NULL && (size_t)(slice_end - p) >= sizeof(uint64_t) &&
+        word_is_unreserved(p, classify)) {
+      output_length += sizeof(uint64_t);
+      p += sizeof(uint64_t);
+      continue;
+    }
     bool unres = is_unreserved_character(*p, unreserved_bytes);
     output_length += unres ? 1 : 3;
     any_reserved_bytes |= !unres;
+    p++;
   }
   // no unreserved bytes: return the string unmodified
   if (!any_reserved_bytes) {
@@ -73,7 +121,15 @@ grpc_slice grpc_percent_encode_slice(grpc_slice slice,
   // second pass: actually encode
   grpc_slice out = GRPC_SLICE_MALLOC(output_length);
   uint8_t *q = GRPC_SLICE_START_PTR(out);
-  for (p = slice_start; p < slice_end; p++) {
+  p = slice_start;
+  while (p < slice_end) {
+    if (classify != NULL && (size_t)(slice_end - p) >= sizeof(uint64_t) &&
+        word_is_unreserved(p, classify)) {
+      memcpy(q, p, sizeof(uint64_t));
+      q += sizeof(uint64_t);
+      p += sizeof(uint64_t);
+      continue;
+    }
     if (is_unreserved_character(*p, unreserved_bytes)) {
       *q++ = *p;
     } else {
@@ -81,6 +137,7 @@ grpc_slice grpc_percent_encode_slice(grpc_slice slice,
       *q++ = hex[*p >> 4];
       *q++ = hex[*p & 15];
     }
+    p++;
   }
   GPR_ASSERT(q == GRPC_SLICE_END_PTR(out));
   return out;
@@ -106,7 +163,14 @@ bool grpc_strict_percent_decode_slice(grpc_slice slice_in,
   const uint8_t *in_end = GRPC_SLICE_END_PTR(slice_in);
   size_t out_length = 0;
   bool any_percent_encoded_stuff = false;
+  unreserved_word_fn classify = word_classifier_for(unreserved_bytes);
   while (p != in_end) {
+    if (classify != NULL && (size_t)(in_end - p) >= sizeof(uint64_t) &&
+        word_is_unreserved(p, classify)) {
+      p += sizeof(uint64_t);
+      out_length += sizeof(uint64_t);
+      continue;
+    }
     if (*p == '%') {
       if (!valid_hex(++p, in_end)) return false;
       if (!valid_hex(++p, in_end)) return false;
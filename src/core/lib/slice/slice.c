@@ -35,6 +35,7 @@
 
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 
 #include <string.h>
@@ -217,8 +218,22 @@ grpc_slice grpc_slice_from_copied_string(const char *source) {
 typedef struct {
   grpc_slice_refcount base;
   gpr_refcount refs;
+  size_t capacity;
+  /* length of the slice handed out at allocation time: the memoized hash
+     below is only valid for slices covering exactly these bytes */
+  size_t length;
+  /* memoized hash of the full-allocation slice, biased by one so that zero
+     means "not yet computed". Relies on slices being filled before they are
+     first hashed and treated as immutable afterwards - the same assumption
+     interning makes */
+  gpr_atm hash_plus_one;
 } malloc_refcount;
 
+/* largest block malloc_unref will park on an exec_ctx for reuse: big enough
+   to cover transport scratch slices, small enough that an idle exec_ctx never
+   pins much memory */
+#define MAX_CACHED_BLOCK_CAPACITY 16384
+
 static void malloc_ref(void *p) {
   malloc_refcount *r = p;
   gpr_ref(&r->refs);
@@ -227,13 +242,38 @@ static void malloc_ref(void *p) {
 static void malloc_unref(grpc_exec_ctx *exec_ctx, void *p) {
   malloc_refcount *r = p;
   if (gpr_unref(&r->refs)) {
-    gpr_free(r);
+    if (exec_ctx != NULL && exec_ctx->cached_slice_block == NULL &&
+        r->capacity <= MAX_CACHED_BLOCK_CAPACITY) {
+      /* park the block on the exec_ctx instead of freeing it: paths that
+         allocate and release a scratch slice on every flush (eg. the chttp2
+         write coalescer) get the same block back via
+         grpc_slice_malloc_internal without an allocator round trip */
+      exec_ctx->cached_slice_block = r;
+      exec_ctx->cached_slice_block_capacity = r->capacity;
+    } else {
+      gpr_free(r);
+    }
   }
 }
 
+static uint32_t malloc_hash(grpc_slice slice) {
+  malloc_refcount *r = (malloc_refcount *)slice.refcount;
+  /* only the full-allocation slice can use the memoized hash: sub-slices
+     share this refcount but cover different bytes */
+  if (slice.data.refcounted.bytes == (uint8_t *)(r + 1) &&
+      slice.data.refcounted.length == r->length) {
+    gpr_atm h = gpr_atm_no_barrier_load(&r->hash_plus_one);
+    if (h == 0) {
+      h = (gpr_atm)grpc_slice_default_hash_impl(slice) + 1;
+      gpr_atm_no_barrier_store(&r->hash_plus_one, h);
+    }
+    return (uint32_t)(h - 1);
+  }
+  return grpc_slice_default_hash_impl(slice);
+}
+
 static const grpc_slice_refcount_vtable malloc_vtable = {
-    malloc_ref, malloc_unref, grpc_slice_default_eq_impl,
-    grpc_slice_default_hash_impl};
+    malloc_ref, malloc_unref, grpc_slice_default_eq_impl, malloc_hash};
 
 grpc_slice grpc_slice_malloc_large(size_t length) {
   grpc_slice slice;
@@ -255,6 +295,9 @@ grpc_slice grpc_slice_malloc_large(size_t length) {
 
   rc->base.vtable = &malloc_vtable;
   rc->base.sub_refcount = &rc->base;
+  rc->capacity = length;
+  rc->length = length;
+  gpr_atm_no_barrier_store(&rc->hash_plus_one, 0);
 
   /* Build up the slice to be returned. */
   /* The slices refcount points back to the allocated block. */
@@ -279,6 +322,38 @@ grpc_slice grpc_slice_malloc(size_t length) {
   return slice;
 }
 
+grpc_slice grpc_slice_malloc_internal(grpc_exec_ctx *exec_ctx, size_t length) {
+  grpc_slice slice;
+
+  if (length <= sizeof(slice.data.inlined.bytes)) {
+    return grpc_slice_malloc(length);
+  }
+  if (exec_ctx != NULL && exec_ctx->cached_slice_block != NULL &&
+      exec_ctx->cached_slice_block_capacity >= length) {
+    /* reuse the block parked by malloc_unref: its vtable, sub_refcount and
+       capacity are still valid, only the reference needs re-arming */
+    malloc_refcount *rc = exec_ctx->cached_slice_block;
+    exec_ctx->cached_slice_block = NULL;
+    exec_ctx->cached_slice_block_capacity = 0;
+    gpr_ref_init(&rc->refs, 1);
+    rc->length = length;
+    gpr_atm_no_barrier_store(&rc->hash_plus_one, 0);
+    slice.refcount = &rc->base;
+    slice.data.refcounted.bytes = (uint8_t *)(rc + 1);
+    slice.data.refcounted.length = length;
+    return slice;
+  }
+  return grpc_slice_malloc_large(length);
+}
+
+void grpc_slice_exec_ctx_cache_flush(grpc_exec_ctx *exec_ctx) {
+  if (exec_ctx->cached_slice_block != NULL) {
+    gpr_free(exec_ctx->cached_slice_block);
+    exec_ctx->cached_slice_block = NULL;
+    exec_ctx->cached_slice_block_capacity = 0;
+  }
+}
+
 grpc_slice grpc_slice_sub_no_ref(grpc_slice source, size_t begin, size_t end) {
   grpc_slice subset;
 
@@ -55,12 +55,13 @@ static bool is_empty(grpc_slice_hash_table_entry* entry) {
 static void grpc_slice_hash_table_add(grpc_slice_hash_table* table,
                                       grpc_slice key, void* value) {
   GPR_ASSERT(value != NULL);
-  const size_t hash = grpc_slice_hash(key);
+  const uint32_t hash = grpc_slice_hash(key);
   for (size_t offset = 0; offset < table->size; ++offset) {
     const size_t idx = (hash + offset) % table->size;
     if (is_empty(&table->entries[idx])) {
       table->entries[idx].key = key;
       table->entries[idx].value = value;
+      table->entries[idx].hash = hash;
       // Keep track of the maximum number of probes needed, since this
       // provides an upper bound for lookups.
       if (offset > table->max_num_probes) table->max_num_probes = offset;
@@ -109,13 +110,16 @@ void grpc_slice_hash_table_unref(grpc_exec_ctx* exec_ctx,
 
 void* grpc_slice_hash_table_get(const grpc_slice_hash_table* table,
                                 const grpc_slice key) {
-  const size_t hash = grpc_slice_hash(key);
+  const uint32_t hash = grpc_slice_hash(key);
   // We cap the number of probes at the max number recorded when
   // populating the table.
   for (size_t offset = 0; offset <= table->max_num_probes; ++offset) {
     const size_t idx = (hash + offset) % table->size;
     if (is_empty(&table->entries[idx])) break;
-    if (grpc_slice_eq(table->entries[idx].key, key)) {
+    // compare the stored hash first: probe misses are rejected without
+    // touching the key's bytes
+    if (table->entries[idx].hash == hash &&
+        grpc_slice_eq(table->entries[idx].key, key)) {
       return table->entries[idx].value;
     }
   }
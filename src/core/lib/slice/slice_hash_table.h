@@ -51,6 +51,10 @@ typedef struct grpc_slice_hash_table grpc_slice_hash_table;
 typedef struct grpc_slice_hash_table_entry {
   grpc_slice key;
   void *value; /* Must not be NULL. */
+  /* the key's hash, stored inline so probing compares a word before touching
+     the key bytes: populated by the table during creation, callers need not
+     set it */
+  uint32_t hash;
 } grpc_slice_hash_table_entry;
 
 /** Creates a new hash table of containing \a entries, which is an array
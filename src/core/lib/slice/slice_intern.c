@@ -57,30 +57,44 @@ typedef struct interned_slice_refcount {
   size_t length;
   gpr_atm refcnt;
   uint32_t hash;
-  struct interned_slice_refcount *bucket_next;
+  /* interned_slice_refcount*: next entry in this bucket; loaded without the
+     shard lock by the lock-free lookup path */
+  gpr_atm bucket_next;
 } interned_slice_refcount;
 
+/* bucket array for one shard: capacity and buckets are allocated together so
+   that a single atomic load of the table pointer yields a consistent pair.
+   bucket storage (gpr_atm holding interned_slice_refcount*) follows the
+   header. */
+typedef struct slice_table {
+  size_t capacity;
+} slice_table;
+
+#define TABLE_BUCKETS(tbl) ((gpr_atm *)((tbl) + 1))
+
 typedef struct slice_shard {
+  /* guards insertion, deletion and growth; lookups of already-interned
+     slices do not take it */
   gpr_mu mu;
-  interned_slice_refcount **strs;
+  /* slice_table*: swapped wholesale on growth */
+  gpr_atm table;
+  /* number of lock-free lookups in flight; unlinked entries and retired
+     tables are freed only once this drains to zero */
+  gpr_atm readers;
   size_t count;
-  size_t capacity;
 } slice_shard;
 
+#ifdef GPR_LOW_LEVEL_COUNTERS
+gpr_atm grpc_slice_intern_hits = 0;
+gpr_atm grpc_slice_intern_inserts = 0;
+#endif
+
 /* hash seed: decided at initialization time */
 static uint32_t g_hash_seed;
 static int g_forced_hash_seed = 0;
 
 static slice_shard g_shards[SHARD_COUNT];
 
-typedef struct {
-  uint32_t hash;
-  uint32_t idx;
-} static_metadata_hash_ent;
-
-static static_metadata_hash_ent
-    static_metadata_hash[4 * GRPC_STATIC_MDSTR_COUNT];
-static uint32_t max_static_metadata_hash_probe;
 static uint32_t static_metadata_hash_values[GRPC_STATIC_MDSTR_COUNT];
 
 static void interned_slice_ref(void *p) {
@@ -88,18 +102,40 @@ static void interned_slice_ref(void *p) {
   GPR_ASSERT(gpr_atm_no_barrier_fetch_add(&s->refcnt, 1) > 0);
 }
 
+static slice_table *table_create(size_t capacity) {
+  slice_table *table = gpr_zalloc(sizeof(*table) + capacity * sizeof(gpr_atm));
+  table->capacity = capacity;
+  return table;
+}
+
+/* Wait until no lock-free lookup is in flight: once this returns, memory
+   unlinked (or a table retired) before the call can no longer be referenced
+   by any reader and is safe to free. Lookups are short and never block, so a
+   spin suffices. */
+static void wait_for_readers(slice_shard *shard) {
+  gpr_atm_full_barrier();
+  while (gpr_atm_acq_load(&shard->readers) != 0)
+    ;
+}
+
 static void interned_slice_destroy(interned_slice_refcount *s) {
   slice_shard *shard = &g_shards[SHARD_IDX(s->hash)];
   gpr_mu_lock(&shard->mu);
   GPR_ASSERT(0 == gpr_atm_no_barrier_load(&s->refcnt));
-  interned_slice_refcount **prev_next;
-  interned_slice_refcount *cur;
-  for (prev_next = &shard->strs[TABLE_IDX(s->hash, shard->capacity)],
-      cur = *prev_next;
-       cur != s; prev_next = &cur->bucket_next, cur = cur->bucket_next)
-    ;
-  *prev_next = cur->bucket_next;
+  slice_table *table = (slice_table *)gpr_atm_no_barrier_load(&shard->table);
+  gpr_atm *prev_next =
+      &TABLE_BUCKETS(table)[TABLE_IDX(s->hash, table->capacity)];
+  interned_slice_refcount *cur =
+      (interned_slice_refcount *)gpr_atm_no_barrier_load(prev_next);
+  while (cur != s) {
+    prev_next = &cur->bucket_next;
+    cur = (interned_slice_refcount *)gpr_atm_no_barrier_load(prev_next);
+  }
+  gpr_atm_rel_store(prev_next, gpr_atm_no_barrier_load(&cur->bucket_next));
   shard->count--;
+  /* a lock-free lookup may still hold a pointer to s: let readers drain
+     before freeing it */
+  wait_for_readers(shard);
   gpr_free(s);
   gpr_mu_unlock(&shard->mu);
 }
@@ -136,28 +172,39 @@ static const grpc_slice_refcount_vtable interned_slice_sub_vtable = {
     interned_slice_sub_ref, interned_slice_sub_unref,
     grpc_slice_default_eq_impl, grpc_slice_default_hash_impl};
 
+/* Called under the shard lock. Relinking mutates bucket_next in place, so a
+   concurrent lock-free lookup may wander onto the wrong chain and miss its
+   target; it then falls back to the locked path, which serializes against us
+   and finds the entry. The old bucket array stays valid until readers drain.
+ */
 static void grow_shard(slice_shard *shard) {
-  size_t capacity = shard->capacity * 2;
+  slice_table *table = (slice_table *)gpr_atm_no_barrier_load(&shard->table);
+  size_t capacity = table->capacity * 2;
   size_t i;
-  interned_slice_refcount **strtab;
+  slice_table *newtab;
   interned_slice_refcount *s, *next;
 
   GPR_TIMER_BEGIN("grow_strtab", 0);
 
-  strtab = gpr_zalloc(sizeof(interned_slice_refcount *) * capacity);
+  newtab = table_create(capacity);
 
-  for (i = 0; i < shard->capacity; i++) {
-    for (s = shard->strs[i]; s; s = next) {
+  for (i = 0; i < table->capacity; i++) {
+    for (s = (interned_slice_refcount *)gpr_atm_no_barrier_load(
+             &TABLE_BUCKETS(table)[i]);
+         s; s = next) {
       size_t idx = TABLE_IDX(s->hash, capacity);
-      next = s->bucket_next;
-      s->bucket_next = strtab[idx];
-      strtab[idx] = s;
+      next = (interned_slice_refcount *)gpr_atm_no_barrier_load(
+          &s->bucket_next);
+      gpr_atm_no_barrier_store(&s->bucket_next,
+                               gpr_atm_no_barrier_load(&TABLE_BUCKETS(
+                                   newtab)[idx]));
+      gpr_atm_rel_store(&TABLE_BUCKETS(newtab)[idx], (gpr_atm)s);
     }
   }
 
-  gpr_free(shard->strs);
-  shard->strs = strtab;
-  shard->capacity = capacity;
+  gpr_atm_rel_store(&shard->table, (gpr_atm)newtab);
+  wait_for_readers(shard);
+  gpr_free(table);
 
   GPR_TIMER_END("grow_strtab", 0);
 }
@@ -171,8 +218,13 @@ static grpc_slice materialize(interned_slice_refcount *s) {
 }
 
 uint32_t grpc_slice_default_hash_impl(grpc_slice s) {
-  return gpr_murmur_hash3(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
-                          g_hash_seed);
+  /* runtime-dispatched: CRC32C based where the CPU supports it. All consumers
+     of slice hashes (interning, mdelem tables, the hpack encoder indices)
+     funnel through here, so they stay mutually consistent. The generated
+     static metadata perfect-hash table is the one murmur holdout: its keys
+     were precomputed with gpr_murmur_hash3 */
+  return gpr_hash_bytes(GRPC_SLICE_START_PTR(s), GRPC_SLICE_LENGTH(s),
+                        g_hash_seed);
 }
 
 uint32_t grpc_static_slice_hash(grpc_slice s) {
@@ -194,15 +246,10 @@ grpc_slice grpc_slice_maybe_static_intern(grpc_slice slice,
     return slice;
   }
 
-  uint32_t hash = grpc_slice_hash(slice);
-  for (uint32_t i = 0; i <= max_static_metadata_hash_probe; i++) {
-    static_metadata_hash_ent ent =
-        static_metadata_hash[(hash + i) % GPR_ARRAY_SIZE(static_metadata_hash)];
-    if (ent.hash == hash && ent.idx < GRPC_STATIC_MDSTR_COUNT &&
-        grpc_slice_eq(grpc_static_slice_table[ent.idx], slice)) {
-      *returned_slice_is_different = true;
-      return grpc_static_slice_table[ent.idx];
-    }
+  int static_idx = grpc_static_slice_table_lookup(slice);
+  if (static_idx >= 0) {
+    *returned_slice_is_different = true;
+    return grpc_static_slice_table[static_idx];
   }
 
   return slice;
@@ -220,25 +267,55 @@ grpc_slice grpc_slice_intern(grpc_slice slice) {
     return slice;
   }
 
-  uint32_t hash = grpc_slice_hash(slice);
-  for (uint32_t i = 0; i <= max_static_metadata_hash_probe; i++) {
-    static_metadata_hash_ent ent =
-        static_metadata_hash[(hash + i) % GPR_ARRAY_SIZE(static_metadata_hash)];
-    if (ent.hash == hash && ent.idx < GRPC_STATIC_MDSTR_COUNT &&
-        grpc_slice_eq(grpc_static_slice_table[ent.idx], slice)) {
-      GPR_TIMER_END("grpc_slice_intern", 0);
-      return grpc_static_slice_table[ent.idx];
-    }
+  int static_idx = grpc_static_slice_table_lookup(slice);
+  if (static_idx >= 0) {
+    GPR_TIMER_END("grpc_slice_intern", 0);
+    return grpc_static_slice_table[static_idx];
   }
 
+  uint32_t hash = grpc_slice_hash(slice);
   interned_slice_refcount *s;
   slice_shard *shard = &g_shards[SHARD_IDX(hash)];
 
+  /* lock-free fast path: look for an already-interned copy without taking
+     the shard lock. Bumping shard->readers keeps concurrently unlinked
+     entries (and retired bucket arrays) alive until we are done walking. */
+  gpr_atm_full_fetch_add(&shard->readers, 1);
+  slice_table *table = (slice_table *)gpr_atm_acq_load(&shard->table);
+  size_t idx = TABLE_IDX(hash, table->capacity);
+  for (s = (interned_slice_refcount *)gpr_atm_acq_load(
+           &TABLE_BUCKETS(table)[idx]);
+       s; s = (interned_slice_refcount *)gpr_atm_acq_load(&s->bucket_next)) {
+    if (s->hash == hash && grpc_slice_eq(slice, materialize(s))) {
+      /* take a ref, but refuse to resurrect an entry whose last ref has been
+         dropped: its owner is already committed to unlinking it */
+      gpr_atm refcnt = gpr_atm_acq_load(&s->refcnt);
+      while (refcnt > 0) {
+        if (gpr_atm_full_cas(&s->refcnt, refcnt, refcnt + 1)) {
+          gpr_atm_full_fetch_add(&shard->readers, -1);
+#ifdef GPR_LOW_LEVEL_COUNTERS
+          GPR_ATM_INC_COUNTER(grpc_slice_intern_hits);
+#endif
+          GPR_TIMER_END("grpc_slice_intern", 0);
+          return materialize(s);
+        }
+        refcnt = gpr_atm_acq_load(&s->refcnt);
+      }
+      break;
+    }
+  }
+  gpr_atm_full_fetch_add(&shard->readers, -1);
+
   gpr_mu_lock(&shard->mu);
 
-  /* search for an existing string */
-  size_t idx = TABLE_IDX(hash, shard->capacity);
-  for (s = shard->strs[idx]; s; s = s->bucket_next) {
+  /* search again under the lock: we may have raced with an insertion, or
+     been diverted onto the wrong chain by a concurrent grow_shard */
+  table = (slice_table *)gpr_atm_no_barrier_load(&shard->table);
+  idx = TABLE_IDX(hash, table->capacity);
+  for (s = (interned_slice_refcount *)gpr_atm_no_barrier_load(
+           &TABLE_BUCKETS(table)[idx]);
+       s; s = (interned_slice_refcount *)gpr_atm_no_barrier_load(
+              &s->bucket_next)) {
     if (s->hash == hash && grpc_slice_eq(slice, materialize(s))) {
       if (gpr_atm_no_barrier_fetch_add(&s->refcnt, 1) == 0) {
         /* If we get here, we've added a ref to something that was about to
@@ -249,6 +326,9 @@ grpc_slice grpc_slice_intern(grpc_slice slice) {
         /* and treat this as if we were never here... sshhh */
       } else {
         gpr_mu_unlock(&shard->mu);
+#ifdef GPR_LOW_LEVEL_COUNTERS
+        GPR_ATM_INC_COUNTER(grpc_slice_intern_hits);
+#endif
         GPR_TIMER_END("grpc_slice_intern", 0);
         return materialize(s);
       }
@@ -265,13 +345,19 @@ grpc_slice grpc_slice_intern(grpc_slice slice) {
   s->base.sub_refcount = &s->sub;
   s->sub.vtable = &interned_slice_sub_vtable;
   s->sub.sub_refcount = &s->sub;
-  s->bucket_next = shard->strs[idx];
-  shard->strs[idx] = s;
   memcpy(s + 1, GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice));
+  gpr_atm_no_barrier_store(&s->bucket_next,
+                           gpr_atm_no_barrier_load(&TABLE_BUCKETS(table)[idx]));
+  /* release so a lock-free lookup that wins the race sees an initialized
+     entry */
+  gpr_atm_rel_store(&TABLE_BUCKETS(table)[idx], (gpr_atm)s);
 
   shard->count++;
+#ifdef GPR_LOW_LEVEL_COUNTERS
+  GPR_ATM_INC_COUNTER(grpc_slice_intern_inserts);
+#endif
 
-  if (shard->count > shard->capacity * 2) {
+  if (shard->count > table->capacity * 2) {
     grow_shard(shard);
   }
 
@@ -294,29 +380,13 @@ void grpc_slice_intern_init(void) {
     slice_shard *shard = &g_shards[i];
     gpr_mu_init(&shard->mu);
     shard->count = 0;
-    shard->capacity = INITIAL_SHARD_CAPACITY;
-    shard->strs = gpr_zalloc(sizeof(*shard->strs) * shard->capacity);
-  }
-  for (size_t i = 0; i < GPR_ARRAY_SIZE(static_metadata_hash); i++) {
-    static_metadata_hash[i].hash = 0;
-    static_metadata_hash[i].idx = GRPC_STATIC_MDSTR_COUNT;
+    gpr_atm_no_barrier_store(&shard->readers, 0);
+    gpr_atm_no_barrier_store(&shard->table,
+                             (gpr_atm)table_create(INITIAL_SHARD_CAPACITY));
   }
-  max_static_metadata_hash_probe = 0;
   for (size_t i = 0; i < GRPC_STATIC_MDSTR_COUNT; i++) {
     static_metadata_hash_values[i] =
         grpc_slice_default_hash_impl(grpc_static_slice_table[i]);
-    for (size_t j = 0; j < GPR_ARRAY_SIZE(static_metadata_hash); j++) {
-      size_t slot = (static_metadata_hash_values[i] + j) %
-                    GPR_ARRAY_SIZE(static_metadata_hash);
-      if (static_metadata_hash[slot].idx == GRPC_STATIC_MDSTR_COUNT) {
-        static_metadata_hash[slot].hash = static_metadata_hash_values[i];
-        static_metadata_hash[slot].idx = (uint32_t)i;
-        if (j > max_static_metadata_hash_probe) {
-          max_static_metadata_hash_probe = (uint32_t)j;
-        }
-        break;
-      }
-    }
   }
 }
 
@@ -324,13 +394,17 @@ void grpc_slice_intern_shutdown(void) {
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     slice_shard *shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
+    slice_table *table = (slice_table *)gpr_atm_no_barrier_load(&shard->table);
     /* TODO(ctiller): GPR_ASSERT(shard->count == 0); */
     if (shard->count != 0) {
       gpr_log(GPR_DEBUG, "WARNING: %" PRIuPTR " metadata strings were leaked",
               shard->count);
-      for (size_t j = 0; j < shard->capacity; j++) {
-        for (interned_slice_refcount *s = shard->strs[j]; s;
-             s = s->bucket_next) {
+      for (size_t j = 0; j < table->capacity; j++) {
+        for (interned_slice_refcount *s =
+                 (interned_slice_refcount *)gpr_atm_no_barrier_load(
+                     &TABLE_BUCKETS(table)[j]);
+             s; s = (interned_slice_refcount *)gpr_atm_no_barrier_load(
+                    &s->bucket_next)) {
           char *text =
               grpc_dump_slice(materialize(s), GPR_DUMP_HEX | GPR_DUMP_ASCII);
           gpr_log(GPR_DEBUG, "LEAKED: %s", text);
@@ -341,6 +415,6 @@ void grpc_slice_intern_shutdown(void) {
         abort();
       }
     }
-    gpr_free(shard->strs);
+    gpr_free(table);
   }
 }
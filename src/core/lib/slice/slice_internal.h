@@ -46,6 +46,13 @@ void grpc_slice_buffer_reset_and_unref_internal(grpc_exec_ctx *exec_ctx,
 void grpc_slice_buffer_destroy_internal(grpc_exec_ctx *exec_ctx,
                                         grpc_slice_buffer *sb);
 
+/* As per grpc_slice_malloc, but may reuse a block cached on \a exec_ctx by an
+   earlier final unref instead of hitting the allocator (see slice.c) */
+grpc_slice grpc_slice_malloc_internal(grpc_exec_ctx *exec_ctx, size_t length);
+/* Release any slice block cached on \a exec_ctx: called as the exec_ctx
+   finishes */
+void grpc_slice_exec_ctx_cache_flush(grpc_exec_ctx *exec_ctx);
+
 /* Check if a slice is interned */
 bool grpc_slice_is_interned(grpc_slice slice);
 
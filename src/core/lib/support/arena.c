@@ -32,6 +32,8 @@
  */
 
 #include "src/core/lib/support/arena.h"
+#include <string.h>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
@@ -48,16 +50,63 @@ typedef struct zone {
 
 struct gpr_arena {
   gpr_atm size_so_far;
+  /* while set the owner has exclusive access and gpr_arena_alloc skips
+     atomics entirely; see gpr_arena_set_single_threaded */
+  bool single_threaded;
   zone initial_zone;
 };
 
+/* overflow blocks are rounded up to a power of two (including the zone
+   header) so they land cleanly in allocator size classes */
+#define MIN_OVERFLOW_BLOCK_SIZE 1024
+
+/* zone payloads start on an alignment boundary after their header: the
+   initial zone's header is the whole gpr_arena, overflow zones carry just
+   a zone */
+static char *zone_data(gpr_arena *arena, zone *z) {
+  return z == &arena->initial_zone
+             ? (char *)arena + ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(gpr_arena))
+             : (char *)z + ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(zone));
+}
+
 gpr_arena *gpr_arena_create(size_t initial_size) {
   initial_size = ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  gpr_arena *a = gpr_zalloc(sizeof(gpr_arena) + initial_size);
+  gpr_arena *a =
+      gpr_zalloc(ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(gpr_arena)) + initial_size);
   a->initial_zone.size_end = initial_size;
   return a;
 }
 
+void gpr_arena_set_single_threaded(gpr_arena *arena, bool single_threaded) {
+  arena->single_threaded = single_threaded;
+}
+
+size_t gpr_arena_reset(gpr_arena *arena) {
+  gpr_atm size = gpr_atm_no_barrier_load(&arena->size_so_far);
+  zone *z = (zone *)gpr_atm_no_barrier_load(&arena->initial_zone.next_atm);
+  while (z) {
+    zone *next_z = (zone *)gpr_atm_no_barrier_load(&z->next_atm);
+    gpr_free(z);
+    z = next_z;
+  }
+  gpr_atm_no_barrier_store(&arena->initial_zone.next_atm, (gpr_atm)NULL);
+  /* allocations rely on arena memory being zeroed; re-zero up to the
+     high-water mark of the initial zone (memory beyond it is still clean
+     from creation or the previous reset) */
+  size_t used = (size_t)size;
+  if (used > arena->initial_zone.size_end) {
+    used = arena->initial_zone.size_end;
+  }
+  memset(zone_data(arena, &arena->initial_zone), 0, used);
+  gpr_atm_no_barrier_store(&arena->size_so_far, 0);
+  arena->single_threaded = false;
+  return (size_t)size;
+}
+
+size_t gpr_arena_initial_capacity(const gpr_arena *arena) {
+  return arena->initial_zone.size_end;
+}
+
 size_t gpr_arena_destroy(gpr_arena *arena) {
   gpr_atm size = gpr_atm_no_barrier_load(&arena->size_so_far);
   zone *z = (zone *)gpr_atm_no_barrier_load(&arena->initial_zone.next_atm);
@@ -72,17 +121,36 @@ size_t gpr_arena_destroy(gpr_arena *arena) {
 
 void *gpr_arena_alloc(gpr_arena *arena, size_t size) {
   size = ROUND_UP_TO_ALIGNMENT_SIZE(size);
-  size_t start =
-      (size_t)gpr_atm_no_barrier_fetch_add(&arena->size_so_far, size);
+  size_t start;
+  if (arena->single_threaded) {
+    start = (size_t)arena->size_so_far;
+    arena->size_so_far = (gpr_atm)(start + size);
+  } else {
+    start = (size_t)gpr_atm_no_barrier_fetch_add(&arena->size_so_far, size);
+  }
   zone *z = &arena->initial_zone;
   while (start > z->size_end) {
-    zone *next_z = (zone *)gpr_atm_acq_load(&z->next_atm);
+    zone *next_z = (zone *)(arena->single_threaded
+                                ? gpr_atm_no_barrier_load(&z->next_atm)
+                                : gpr_atm_acq_load(&z->next_atm));
     if (next_z == NULL) {
       size_t next_z_size = (size_t)gpr_atm_no_barrier_load(&arena->size_so_far);
-      next_z = gpr_zalloc(sizeof(zone) + next_z_size);
+      if (next_z_size < size) next_z_size = size;
+      /* round the whole block (header included) up to a power-of-two size
+         class; a too-small initial zone then costs O(log growth) mallocs
+         instead of one per allocation */
+      size_t block_size =
+          ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(zone)) + next_z_size;
+      size_t class_size = MIN_OVERFLOW_BLOCK_SIZE;
+      while (class_size < block_size) class_size *= 2;
+      next_z = gpr_zalloc(class_size);
       next_z->size_begin = z->size_end;
-      next_z->size_end = z->size_end + next_z_size;
-      if (!gpr_atm_rel_cas(&z->next_atm, (gpr_atm)NULL, (gpr_atm)next_z)) {
+      next_z->size_end = next_z->size_begin + class_size -
+                         ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(zone));
+      if (arena->single_threaded) {
+        gpr_atm_no_barrier_store(&z->next_atm, (gpr_atm)next_z);
+      } else if (!gpr_atm_rel_cas(&z->next_atm, (gpr_atm)NULL,
+                                  (gpr_atm)next_z)) {
         gpr_free(next_z);
         next_z = (zone *)gpr_atm_acq_load(&z->next_atm);
       }
@@ -94,5 +162,5 @@ void *gpr_arena_alloc(gpr_arena *arena, size_t size) {
   }
   GPR_ASSERT(start >= z->size_begin);
   GPR_ASSERT(start + size <= z->size_end);
-  return ((char *)(z + 1)) + start - z->size_begin;
+  return zone_data(arena, z) + start - z->size_begin;
 }
@@ -40,6 +40,7 @@
 #ifndef GRPC_CORE_LIB_SUPPORT_ARENA_H
 #define GRPC_CORE_LIB_SUPPORT_ARENA_H
 
+#include <stdbool.h>
 #include <stddef.h>
 
 typedef struct gpr_arena gpr_arena;
@@ -50,5 +51,20 @@ gpr_arena *gpr_arena_create(size_t initial_size);
 void *gpr_arena_alloc(gpr_arena *arena, size_t size);
 // Destroy an arena, returning the total number of bytes allocated
 size_t gpr_arena_destroy(gpr_arena *arena);
+// Reset an arena for reuse: overflow buffers are freed, the initial buffer
+// is re-zeroed and the allocation cursor rewinds to the start. Returns the
+// total number of bytes that had been allocated. The caller must guarantee
+// that no allocations are in flight
+size_t gpr_arena_reset(gpr_arena *arena);
+// Capacity of the arena's initial buffer (the creation size rounded up to
+// alignment); allocations beyond it spill into malloc'd overflow buffers
+size_t gpr_arena_initial_capacity(const gpr_arena *arena);
+// Toggle single-threaded allocation: while set, gpr_arena_alloc uses plain
+// loads and stores instead of atomics. The caller must guarantee exclusive
+// access to the arena for the whole time the flag is set, and must clear it
+// before the arena is shared (sharing must itself synchronize, e.g. via a
+// scheduled closure). Arenas are created (and reset) in the default,
+// thread-safe mode
+void gpr_arena_set_single_threaded(gpr_arena *arena, bool single_threaded);
 
 #endif /* GRPC_CORE_LIB_SUPPORT_ARENA_H */
@@ -35,6 +35,7 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/string_util.h>
@@ -297,3 +298,175 @@ gpr_avl gpr_avl_ref(gpr_avl avl) {
 void gpr_avl_unref(gpr_avl avl) { unref_node(avl.vtable, avl.root); }
 
 int gpr_avl_is_empty(gpr_avl avl) { return avl.root == NULL; }
+
+/*
+ * gpr_flatmap
+ */
+
+static gpr_flatmap_snapshot *snapshot_alloc(size_t count) {
+  gpr_flatmap_snapshot *snapshot =
+      gpr_malloc(sizeof(*snapshot) +
+                 (count > 1 ? count - 1 : 0) * sizeof(gpr_flatmap_entry));
+  snapshot->count = count;
+  return snapshot;
+}
+
+static void snapshot_destroy(const gpr_avl_vtable *vtable,
+                             gpr_flatmap_snapshot *snapshot) {
+  size_t i;
+  for (i = 0; i < snapshot->count; i++) {
+    vtable->destroy_key(snapshot->entries[i].key);
+    vtable->destroy_value(snapshot->entries[i].value);
+  }
+  gpr_free(snapshot);
+}
+
+/* binary search entries for key; on a miss *idx is the insertion point */
+static gpr_flatmap_entry *entries_search(const gpr_avl_vtable *vtable,
+                                         gpr_flatmap_entry *entries,
+                                         size_t count, void *key,
+                                         size_t *idx) {
+  size_t lo = 0;
+  size_t hi = count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    long cmp = vtable->compare_keys(entries[mid].key, key);
+    if (cmp == 0) {
+      *idx = mid;
+      return &entries[mid];
+    } else if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  *idx = lo;
+  return NULL;
+}
+
+void gpr_flatmap_init(gpr_flatmap *map, const gpr_avl_vtable *vtable) {
+  map->vtable = vtable;
+  gpr_atm_no_barrier_store(&map->snapshot, (gpr_atm)snapshot_alloc(0));
+  gpr_atm_no_barrier_store(&map->epoch, 0);
+  gpr_atm_no_barrier_store(&map->readers[0], 0);
+  gpr_atm_no_barrier_store(&map->readers[1], 0);
+}
+
+void gpr_flatmap_destroy(gpr_flatmap *map) {
+  assert(gpr_atm_no_barrier_load(&map->readers[0]) == 0);
+  assert(gpr_atm_no_barrier_load(&map->readers[1]) == 0);
+  snapshot_destroy(
+      map->vtable,
+      (gpr_flatmap_snapshot *)gpr_atm_no_barrier_load(&map->snapshot));
+}
+
+void *gpr_flatmap_get(gpr_flatmap *map, void *key) {
+  void *result = NULL;
+  /* announce ourselves on the current epoch's reader count before loading the
+     snapshot: a mutator retires a snapshot only after this parity drains, so
+     everything we can see stays alive until we leave */
+  gpr_atm epoch = gpr_atm_acq_load(&map->epoch);
+  gpr_atm *readers = &map->readers[epoch & 1];
+  gpr_atm_full_fetch_add(readers, 1);
+  {
+    gpr_flatmap_snapshot *snapshot =
+        (gpr_flatmap_snapshot *)gpr_atm_acq_load(&map->snapshot);
+    size_t idx;
+    gpr_flatmap_entry *entry = entries_search(
+        map->vtable, snapshot->entries, snapshot->count, key, &idx);
+    if (entry != NULL) {
+      result = map->vtable->copy_value(entry->value);
+    }
+  }
+  gpr_atm_full_fetch_add(readers, -1);
+  return result;
+}
+
+/* swap next in as the live snapshot, then retire the previous one once every
+   reader that could still hold it has drained out of the old epoch parity */
+static void flatmap_publish(gpr_flatmap *map, gpr_flatmap_snapshot *next) {
+  gpr_flatmap_snapshot *prev =
+      (gpr_flatmap_snapshot *)gpr_atm_no_barrier_load(&map->snapshot);
+  gpr_atm epoch = gpr_atm_no_barrier_load(&map->epoch);
+  gpr_atm_rel_store(&map->snapshot, (gpr_atm)next);
+  gpr_atm_rel_store(&map->epoch, epoch + 1);
+  while (gpr_atm_acq_load(&map->readers[epoch & 1]) != 0) {
+    /* readers are a handful of instructions; this drains almost instantly */
+  }
+  snapshot_destroy(map->vtable, prev);
+}
+
+void gpr_flatmap_batch_begin(gpr_flatmap *map, gpr_flatmap_batch *batch) {
+  gpr_flatmap_snapshot *snapshot =
+      (gpr_flatmap_snapshot *)gpr_atm_no_barrier_load(&map->snapshot);
+  size_t i;
+  batch->map = map;
+  batch->count = snapshot->count;
+  batch->capacity = snapshot->count < 8 ? 8 : snapshot->count;
+  batch->entries = gpr_malloc(batch->capacity * sizeof(*batch->entries));
+  for (i = 0; i < snapshot->count; i++) {
+    batch->entries[i].key = map->vtable->copy_key(snapshot->entries[i].key);
+    batch->entries[i].value =
+        map->vtable->copy_value(snapshot->entries[i].value);
+  }
+}
+
+void gpr_flatmap_batch_add(gpr_flatmap_batch *batch, void *key, void *value) {
+  const gpr_avl_vtable *vtable = batch->map->vtable;
+  size_t idx;
+  gpr_flatmap_entry *entry =
+      entries_search(vtable, batch->entries, batch->count, key, &idx);
+  if (entry != NULL) {
+    vtable->destroy_key(entry->key);
+    vtable->destroy_value(entry->value);
+    entry->key = key;
+    entry->value = value;
+    return;
+  }
+  if (batch->count == batch->capacity) {
+    batch->capacity *= 2;
+    batch->entries =
+        gpr_realloc(batch->entries, batch->capacity * sizeof(*batch->entries));
+  }
+  memmove(batch->entries + idx + 1, batch->entries + idx,
+          (batch->count - idx) * sizeof(*batch->entries));
+  batch->entries[idx].key = key;
+  batch->entries[idx].value = value;
+  batch->count++;
+}
+
+void gpr_flatmap_batch_remove(gpr_flatmap_batch *batch, void *key) {
+  const gpr_avl_vtable *vtable = batch->map->vtable;
+  size_t idx;
+  gpr_flatmap_entry *entry =
+      entries_search(vtable, batch->entries, batch->count, key, &idx);
+  if (entry == NULL) return;
+  vtable->destroy_key(entry->key);
+  vtable->destroy_value(entry->value);
+  memmove(batch->entries + idx, batch->entries + idx + 1,
+          (batch->count - idx - 1) * sizeof(*batch->entries));
+  batch->count--;
+}
+
+void gpr_flatmap_batch_commit(gpr_flatmap_batch *batch) {
+  gpr_flatmap_snapshot *next = snapshot_alloc(batch->count);
+  memcpy(next->entries, batch->entries,
+         batch->count * sizeof(*batch->entries));
+  gpr_free(batch->entries);
+  batch->entries = NULL;
+  flatmap_publish(batch->map, next);
+}
+
+void gpr_flatmap_add(gpr_flatmap *map, void *key, void *value) {
+  gpr_flatmap_batch batch;
+  gpr_flatmap_batch_begin(map, &batch);
+  gpr_flatmap_batch_add(&batch, key, value);
+  gpr_flatmap_batch_commit(&batch);
+}
+
+void gpr_flatmap_remove(gpr_flatmap *map, void *key) {
+  gpr_flatmap_batch batch;
+  gpr_flatmap_batch_begin(map, &batch);
+  gpr_flatmap_batch_remove(&batch, key);
+  gpr_flatmap_batch_commit(&batch);
+}
@@ -38,10 +38,13 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
 #include <grpc/support/useful.h>
 
+#include "src/core/lib/support/spinlock.h"
+
 /* Histograms are stored with exponentially increasing bucket sizes.
    The first bucket is [0, m) where m = 1 + resolution
    Bucket n (n>=1) contains [m**n, m**(n+1))
@@ -241,3 +244,69 @@ const uint32_t *gpr_histogram_get_contents(gpr_histogram *h, size_t *size) {
   *size = h->num_buckets;
   return h->buckets;
 }
+
+/* --- Striped histogram --- */
+
+/* Each stripe is a plain histogram behind its own spinlock, padded onto its
+   own cachelines. Recorders pick the stripe for their current cpu, so the
+   lock is effectively uncontended and an add is one cas + the plain add. */
+typedef struct {
+  gpr_spinlock lock;
+  gpr_histogram *histogram;
+  char padding[GPR_CACHELINE_SIZE];
+} histogram_stripe;
+
+struct gpr_histogram_striped {
+  size_t num_stripes;
+  histogram_stripe *stripes;
+};
+
+#define MAX_HISTOGRAM_STRIPES 32
+
+gpr_histogram_striped *gpr_histogram_striped_create(double resolution,
+                                                    double max_bucket_start) {
+  size_t i;
+  gpr_histogram_striped *h =
+      (gpr_histogram_striped *)gpr_malloc(sizeof(gpr_histogram_striped));
+  h->num_stripes = GPR_MIN(gpr_cpu_num_cores(), MAX_HISTOGRAM_STRIPES);
+  if (h->num_stripes == 0) h->num_stripes = 1;
+  h->stripes = (histogram_stripe *)gpr_malloc(sizeof(histogram_stripe) *
+                                              h->num_stripes);
+  for (i = 0; i < h->num_stripes; i++) {
+    h->stripes[i].lock = (gpr_spinlock)GPR_SPINLOCK_STATIC_INITIALIZER;
+    h->stripes[i].histogram =
+        gpr_histogram_create(resolution, max_bucket_start);
+  }
+  return h;
+}
+
+void gpr_histogram_striped_destroy(gpr_histogram_striped *h) {
+  size_t i;
+  for (i = 0; i < h->num_stripes; i++) {
+    gpr_histogram_destroy(h->stripes[i].histogram);
+  }
+  gpr_free(h->stripes);
+  gpr_free(h);
+}
+
+void gpr_histogram_striped_add(gpr_histogram_striped *h, double x) {
+  histogram_stripe *stripe =
+      &h->stripes[gpr_cpu_current_cpu() % h->num_stripes];
+  gpr_spinlock_lock(&stripe->lock);
+  gpr_histogram_add(stripe->histogram, x);
+  gpr_spinlock_unlock(&stripe->lock);
+}
+
+int gpr_histogram_striped_snapshot(gpr_histogram_striped *h,
+                                   gpr_histogram *dst) {
+  size_t i;
+  for (i = 0; i < h->num_stripes; i++) {
+    histogram_stripe *stripe = &h->stripes[i];
+    int ok;
+    gpr_spinlock_lock(&stripe->lock);
+    ok = gpr_histogram_merge(dst, stripe->histogram);
+    gpr_spinlock_unlock(&stripe->lock);
+    if (!ok) return 0;
+  }
+  return 1;
+}
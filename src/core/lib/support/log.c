@@ -35,8 +35,13 @@
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include <grpc/support/time.h>
 
 #include "src/core/lib/support/env.h"
+#include "src/core/lib/support/mpscq.h"
 #include "src/core/lib/support/string.h"
 
 #include <stdio.h>
@@ -46,6 +51,170 @@ extern void gpr_default_log(gpr_log_func_args *args);
 static gpr_log_func g_log_func = gpr_default_log;
 static gpr_atm g_min_severity_to_print = GPR_LOG_VERBOSITY_UNSET;
 
+/* asynchronous logging: bound the work done on the calling thread to a
+   severity check, a token-bucket probe and a queue push; a background thread
+   owns the (potentially blocking) write */
+
+/* number of token buckets log sites hash into */
+#define ASYNC_LOG_SITES 256
+/* messages allowed per site per refill interval */
+#define ASYNC_LOG_SITE_BURST 32
+#define ASYNC_LOG_REFILL_INTERVAL_MS 1000
+/* bound on formatted-but-unwritten messages before we start dropping */
+#define ASYNC_LOG_MAX_QUEUED 8192
+/* drain thread wakeup period */
+#define ASYNC_LOG_POLL_INTERVAL_MS 20
+
+typedef struct log_record {
+  gpr_mpscq_node node;
+  gpr_log_func_args args;
+  char *message;
+} log_record;
+
+static struct {
+  gpr_atm active;
+  gpr_mpscq queue;
+  gpr_atm queued;
+  gpr_atm dropped;       /* since the last periodic report */
+  gpr_atm dropped_total; /* never reset */
+  gpr_atm site_tokens[ASYNC_LOG_SITES];
+  gpr_mu mu;
+  gpr_cv cv;
+  int shutdown;
+  gpr_thd_id thd;
+} g_async_log;
+
+static void async_log_dispatch_chain(gpr_mpscq_node *n) {
+  while (n != NULL) {
+    log_record *record = (log_record *)n;
+    n = (gpr_mpscq_node *)gpr_atm_no_barrier_load(&n->next);
+    gpr_atm_no_barrier_fetch_add(&g_async_log.queued, -1);
+    g_log_func(&record->args);
+    gpr_free(record->message);
+    gpr_free(record);
+  }
+}
+
+static void async_log_refill_and_report(void) {
+  size_t i;
+  gpr_atm dropped;
+  for (i = 0; i < ASYNC_LOG_SITES; i++) {
+    gpr_atm_rel_store(&g_async_log.site_tokens[i], ASYNC_LOG_SITE_BURST);
+  }
+  dropped = gpr_atm_full_xchg(&g_async_log.dropped, 0);
+  if (dropped > 0) {
+    char *message;
+    gpr_log_func_args lfargs;
+    gpr_asprintf(&message,
+                 "dropped %" PRIdPTR " log messages (rate limit/queue full)",
+                 dropped);
+    memset(&lfargs, 0, sizeof(lfargs));
+    lfargs.file = __FILE__;
+    lfargs.line = __LINE__;
+    lfargs.severity = GPR_LOG_SEVERITY_ERROR;
+    lfargs.message = message;
+    g_log_func(&lfargs);
+    gpr_free(message);
+  }
+}
+
+static void async_log_thread(void *arg) {
+  gpr_timespec next_refill = gpr_time_add(
+      gpr_now(GPR_CLOCK_MONOTONIC),
+      gpr_time_from_millis(ASYNC_LOG_REFILL_INTERVAL_MS, GPR_TIMESPAN));
+  int shutdown = 0;
+  while (!shutdown) {
+    gpr_mu_lock(&g_async_log.mu);
+    if (!g_async_log.shutdown) {
+      gpr_cv_wait(&g_async_log.cv, &g_async_log.mu,
+                  gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                               gpr_time_from_millis(ASYNC_LOG_POLL_INTERVAL_MS,
+                                                    GPR_TIMESPAN)));
+    }
+    shutdown = g_async_log.shutdown;
+    gpr_mu_unlock(&g_async_log.mu);
+    async_log_dispatch_chain(gpr_mpscq_pop_all(&g_async_log.queue));
+    if (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), next_refill) >= 0) {
+      async_log_refill_and_report();
+      next_refill = gpr_time_add(
+          gpr_now(GPR_CLOCK_MONOTONIC),
+          gpr_time_from_millis(ASYNC_LOG_REFILL_INTERVAL_MS, GPR_TIMESPAN));
+    }
+  }
+  /* final drain + report so no accepted message is lost */
+  async_log_dispatch_chain(gpr_mpscq_pop_all(&g_async_log.queue));
+  async_log_refill_and_report();
+}
+
+/* returns 1 if the message was queued; 0 if async mode is off or the message
+   was dropped (in which case it is counted, not written) */
+static int async_log_enqueue(const char *file, int line,
+                             gpr_log_severity severity, const char *message) {
+  size_t site;
+  log_record *record;
+  if (!gpr_atm_acq_load(&g_async_log.active)) return 0;
+  site = (((size_t)(uintptr_t)file) >> 4 ^ (size_t)line) % ASYNC_LOG_SITES;
+  if (gpr_atm_no_barrier_fetch_add(&g_async_log.site_tokens[site], -1) <= 0) {
+    gpr_atm_no_barrier_fetch_add(&g_async_log.dropped, 1);
+    gpr_atm_no_barrier_fetch_add(&g_async_log.dropped_total, 1);
+    return 1; /* dropped, but handled */
+  }
+  if (gpr_atm_no_barrier_fetch_add(&g_async_log.queued, 1) >=
+      ASYNC_LOG_MAX_QUEUED) {
+    gpr_atm_no_barrier_fetch_add(&g_async_log.queued, -1);
+    gpr_atm_no_barrier_fetch_add(&g_async_log.dropped, 1);
+    gpr_atm_no_barrier_fetch_add(&g_async_log.dropped_total, 1);
+    return 1; /* dropped, but handled */
+  }
+  record = gpr_malloc(sizeof(*record));
+  record->message = gpr_strdup(message);
+  record->args.file = file; /* always a string literal */
+  record->args.line = line;
+  record->args.severity = severity;
+  record->args.message = record->message;
+  gpr_mpscq_push(&g_async_log.queue, &record->node);
+  return 1;
+}
+
+void gpr_log_async_init(void) {
+  gpr_thd_options options = gpr_thd_options_default();
+  GPR_ASSERT(!gpr_atm_no_barrier_load(&g_async_log.active));
+  gpr_mpscq_init(&g_async_log.queue);
+  gpr_atm_no_barrier_store(&g_async_log.queued, 0);
+  gpr_atm_no_barrier_store(&g_async_log.dropped, 0);
+  gpr_atm_no_barrier_store(&g_async_log.dropped_total, 0);
+  gpr_mu_init(&g_async_log.mu);
+  gpr_cv_init(&g_async_log.cv);
+  g_async_log.shutdown = 0;
+  {
+    size_t i;
+    for (i = 0; i < ASYNC_LOG_SITES; i++) {
+      gpr_atm_no_barrier_store(&g_async_log.site_tokens[i],
+                               ASYNC_LOG_SITE_BURST);
+    }
+  }
+  gpr_thd_options_set_joinable(&options);
+  GPR_ASSERT(gpr_thd_new(&g_async_log.thd, async_log_thread, NULL, &options));
+  gpr_atm_rel_store(&g_async_log.active, 1);
+}
+
+void gpr_log_async_shutdown(void) {
+  if (!gpr_atm_no_barrier_load(&g_async_log.active)) return;
+  gpr_atm_rel_store(&g_async_log.active, 0);
+  gpr_mu_lock(&g_async_log.mu);
+  g_async_log.shutdown = 1;
+  gpr_cv_signal(&g_async_log.cv);
+  gpr_mu_unlock(&g_async_log.mu);
+  gpr_thd_join(g_async_log.thd);
+  gpr_mpscq_destroy(&g_async_log.queue);
+  gpr_cv_destroy(&g_async_log.cv);
+  gpr_mu_destroy(&g_async_log.mu);
+}
+
+size_t gpr_log_async_messages_dropped(void) {
+  return (size_t)gpr_atm_no_barrier_load(&g_async_log.dropped_total);
+}
+
 const char *gpr_log_severity_string(gpr_log_severity severity) {
   switch (severity) {
     case GPR_LOG_SEVERITY_DEBUG:
@@ -64,6 +233,10 @@ void gpr_log_message(const char *file, int line, gpr_log_severity severity,
     return;
   }
 
+  if (async_log_enqueue(file, line, severity, message)) {
+    return;
+  }
+
   gpr_log_func_args lfargs;
   memset(&lfargs, 0, sizeof(lfargs));
   lfargs.file = file;
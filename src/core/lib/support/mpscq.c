@@ -36,14 +36,15 @@
 #include <grpc/support/log.h>
 
 void gpr_mpscq_init(gpr_mpscq *q) {
-  gpr_atm_no_barrier_store(&q->head, (gpr_atm)&q->stub);
-  q->tail = &q->stub;
-  gpr_atm_no_barrier_store(&q->stub.next, (gpr_atm)NULL);
+  q->stub = &q->stubs[0];
+  gpr_atm_no_barrier_store(&q->head, (gpr_atm)q->stub);
+  q->tail = q->stub;
+  gpr_atm_no_barrier_store(&q->stub->next, (gpr_atm)NULL);
 }
 
 void gpr_mpscq_destroy(gpr_mpscq *q) {
-  GPR_ASSERT(gpr_atm_no_barrier_load(&q->head) == (gpr_atm)&q->stub);
-  GPR_ASSERT(q->tail == &q->stub);
+  GPR_ASSERT(gpr_atm_no_barrier_load(&q->head) == (gpr_atm)q->stub);
+  GPR_ASSERT(q->tail == q->stub);
 }
 
 bool gpr_mpscq_push(gpr_mpscq *q, gpr_mpscq_node *n) {
@@ -51,7 +52,10 @@ bool gpr_mpscq_push(gpr_mpscq *q, gpr_mpscq_node *n) {
   gpr_mpscq_node *prev =
       (gpr_mpscq_node *)gpr_atm_full_xchg(&q->head, (gpr_atm)n);
   gpr_atm_rel_store(&prev->next, (gpr_atm)n);
-  return prev == &q->stub;
+  // compare against both stubs (not the q->stub pointer, which the consumer
+  // may be swapping concurrently in gpr_mpscq_pop_all): a stub is only ever
+  // ahead of us if we are the first real node
+  return prev == &q->stubs[0] || prev == &q->stubs[1];
 }
 
 gpr_mpscq_node *gpr_mpscq_pop(gpr_mpscq *q) {
@@ -62,7 +66,7 @@ gpr_mpscq_node *gpr_mpscq_pop(gpr_mpscq *q) {
 gpr_mpscq_node *gpr_mpscq_pop_and_check_end(gpr_mpscq *q, bool *empty) {
   gpr_mpscq_node *tail = q->tail;
   gpr_mpscq_node *next = (gpr_mpscq_node *)gpr_atm_acq_load(&tail->next);
-  if (tail == &q->stub) {
+  if (tail == q->stub) {
     // indicates the list is actually (ephemerally) empty
     if (next == NULL) {
       *empty = true;
@@ -83,7 +87,7 @@ gpr_mpscq_node *gpr_mpscq_pop_and_check_end(gpr_mpscq *q, bool *empty) {
     // indicates a retry is in order: we're still adding
     return NULL;
   }
-  gpr_mpscq_push(q, &q->stub);
+  gpr_mpscq_push(q, q->stub);
   next = (gpr_mpscq_node *)gpr_atm_acq_load(&tail->next);
   if (next != NULL) {
     q->tail = next;
@@ -94,6 +98,55 @@ gpr_mpscq_node *gpr_mpscq_pop_and_check_end(gpr_mpscq *q, bool *empty) {
   return NULL;
 }
 
+gpr_mpscq_node *gpr_mpscq_pop_all(gpr_mpscq *q) {
+  gpr_mpscq_node *old_stub = q->stub;
+  gpr_mpscq_node *fresh_stub =
+      old_stub == &q->stubs[0] ? &q->stubs[1] : &q->stubs[0];
+  gpr_mpscq_node *tail = q->tail;
+  gpr_mpscq_node *head;
+  gpr_mpscq_node *first = NULL;
+  gpr_mpscq_node *last = NULL;
+  gpr_mpscq_node *n;
+
+  // swap a fresh stub into the queue: everything pushed before the exchange
+  // is ours, everything after lands behind the fresh stub. Producers that
+  // raced past the exchange write fresh_stub->next, never a link inside the
+  // detached chain - which may contain old_stub at any position
+  gpr_atm_no_barrier_store(&fresh_stub->next, (gpr_atm)NULL);
+  head = (gpr_mpscq_node *)gpr_atm_full_xchg(&q->head, (gpr_atm)fresh_stub);
+  q->tail = fresh_stub;
+  q->stub = fresh_stub;
+
+  // relink the detached chain (tail..head, oldest first) dropping old_stub;
+  // a producer between its exchange and its rel_store leaves a momentarily
+  // NULL link, which we simply wait out - unlike gpr_mpscq_pop there is no
+  // spurious empty result
+  n = tail;
+  while (n != NULL) {
+    gpr_mpscq_node *next;
+    if (n == head) {
+      next = NULL;
+    } else {
+      do {
+        next = (gpr_mpscq_node *)gpr_atm_acq_load(&n->next);
+      } while (next == NULL);
+    }
+    if (n != old_stub) {
+      if (last == NULL) {
+        first = n;
+      } else {
+        gpr_atm_no_barrier_store(&last->next, (gpr_atm)n);
+      }
+      last = n;
+    }
+    n = next;
+  }
+  if (last != NULL) {
+    gpr_atm_no_barrier_store(&last->next, (gpr_atm)NULL);
+  }
+  return first;
+}
+
 void gpr_locked_mpscq_init(gpr_locked_mpscq *q) {
   gpr_mpscq_init(&q->queue);
   q->read_lock = GPR_SPINLOCK_INITIALIZER;
@@ -107,7 +160,7 @@ bool gpr_locked_mpscq_push(gpr_locked_mpscq *q, gpr_mpscq_node *n) {
   return gpr_mpscq_push(&q->queue, n);
 }
 
-gpr_mpscq_node *gpr_locked_mpscq_pop(gpr_locked_mpscq *q) {
+gpr_mpscq_node *gpr_locked_mpscq_try_pop(gpr_locked_mpscq *q) {
   if (gpr_spinlock_trylock(&q->read_lock)) {
     gpr_mpscq_node *n = gpr_mpscq_pop(&q->queue);
     gpr_spinlock_unlock(&q->read_lock);
@@ -115,3 +168,14 @@ gpr_mpscq_node *gpr_locked_mpscq_pop(gpr_locked_mpscq *q) {
   }
   return NULL;
 }
+
+gpr_mpscq_node *gpr_locked_mpscq_pop(gpr_locked_mpscq *q) {
+  gpr_spinlock_lock(&q->read_lock);
+  bool empty = false;
+  gpr_mpscq_node *n;
+  do {
+    n = gpr_mpscq_pop_and_check_end(&q->queue, &empty);
+  } while (n == NULL && !empty);
+  gpr_spinlock_unlock(&q->read_lock);
+  return n;
+}
@@ -53,7 +53,11 @@ typedef struct gpr_mpscq {
   // make sure head & tail don't share a cacheline
   char padding[GPR_CACHELINE_SIZE];
   gpr_mpscq_node *tail;
-  gpr_mpscq_node stub;
+  // two stub nodes: gpr_mpscq_pop_all swaps a fresh stub into the queue so
+  // that producers racing with the drain can never clobber links inside the
+  // detached chain; stub points at whichever one is currently in the queue
+  gpr_mpscq_node stubs[2];
+  gpr_mpscq_node *stub;
 } gpr_mpscq;
 
 void gpr_mpscq_init(gpr_mpscq *q);
@@ -69,6 +73,14 @@ bool gpr_mpscq_push(gpr_mpscq *q, gpr_mpscq_node *n);
 gpr_mpscq_node *gpr_mpscq_pop(gpr_mpscq *q);
 // Pop a node; sets *empty to true if the queue is empty, or false if it is not
 gpr_mpscq_node *gpr_mpscq_pop_and_check_end(gpr_mpscq *q, bool *empty);
+// Detach every queued node with a single atomic exchange and return them as a
+// chain in push order (oldest first), linked through ->next and
+// NULL-terminated. Returns NULL if the queue was empty at the point of the
+// exchange. Unlike gpr_mpscq_pop this never reports a spurious empty: a push
+// whose exchange preceded ours is always included (we wait out its brief
+// linking window)
+// Thread compatible - can only be called from one thread at a time
+gpr_mpscq_node *gpr_mpscq_pop_all(gpr_mpscq *q);
 
 // An mpscq with a spinlock: it's safe to pop from multiple threads, but doing
 // only one thread will succeed concurrently
@@ -87,6 +99,10 @@ bool gpr_locked_mpscq_push(gpr_locked_mpscq *q, gpr_mpscq_node *n);
 // Pop a node (returns NULL if no node is ready - which doesn't indicate that
 // the queue is empty!!)
 // Thread safe - can be called from multiple threads concurrently
+gpr_mpscq_node *gpr_locked_mpscq_try_pop(gpr_locked_mpscq *q);
+// Pop a node.  Returns NULL only if the queue was empty at some point after
+// calling this function
+// Thread safe - can be called from multiple threads concurrently
 gpr_mpscq_node *gpr_locked_mpscq_pop(gpr_locked_mpscq *q);
 
 #endif /* GRPC_CORE_LIB_SUPPORT_MPSCQ_H */
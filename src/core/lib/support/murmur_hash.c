@@ -35,6 +35,8 @@
 
 #include <string.h>
 
+#include <grpc/support/sync.h>
+
 #define ROTL32(x, r) ((x) << (r)) | ((x) >> (32 - (r)))
 
 #define FMIX32(h)    \
@@ -92,3 +94,64 @@ uint32_t gpr_murmur_hash3(const void *key, size_t len, uint32_t seed) {
   FMIX32(h1);
   return h1;
 }
+
+/* gpr_hash_bytes: like gpr_murmur_hash3, but dispatched at first use to a
+   CRC32C instruction based implementation when the CPU supports SSE4.2.
+   Raw CRC32C is linear and a poor table hash on its own, so the accumulated
+   value is run through the murmur finalizer to restore avalanche behavior. */
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define GPR_HAS_HARDWARE_CRC32C 1
+#endif
+
+#ifdef GPR_HAS_HARDWARE_CRC32C
+__attribute__((target("sse4.2"))) static uint32_t crc32c_hash(const void *key,
+                                                              size_t len,
+                                                              uint32_t seed) {
+  const uint8_t *data = (const uint8_t *)key;
+  size_t n = len;
+  uint64_t crc = seed;
+  uint64_t chunk64;
+  uint32_t chunk32;
+  uint32_t h1;
+
+  while (n >= sizeof(chunk64)) {
+    memcpy(&chunk64, data, sizeof(chunk64));
+    crc = __builtin_ia32_crc32di(crc, chunk64);
+    data += sizeof(chunk64);
+    n -= sizeof(chunk64);
+  }
+  if (n >= sizeof(chunk32)) {
+    memcpy(&chunk32, data, sizeof(chunk32));
+    crc = __builtin_ia32_crc32si((uint32_t)crc, chunk32);
+    data += sizeof(chunk32);
+    n -= sizeof(chunk32);
+  }
+  while (n > 0) {
+    crc = __builtin_ia32_crc32qi((uint32_t)crc, *data++);
+    n--;
+  }
+
+  h1 = (uint32_t)crc ^ (uint32_t)len;
+  FMIX32(h1);
+  return h1;
+}
+#endif /* GPR_HAS_HARDWARE_CRC32C */
+
+static uint32_t (*g_hash_impl)(const void *key, size_t len, uint32_t seed);
+static gpr_once g_choose_hash_impl = GPR_ONCE_INIT;
+
+static void choose_hash_impl(void) {
+#ifdef GPR_HAS_HARDWARE_CRC32C
+  if (__builtin_cpu_supports("sse4.2")) {
+    g_hash_impl = crc32c_hash;
+    return;
+  }
+#endif
+  g_hash_impl = gpr_murmur_hash3;
+}
+
+uint32_t gpr_hash_bytes(const void *key, size_t len, uint32_t seed) {
+  gpr_once_init(&g_choose_hash_impl, choose_hash_impl);
+  return g_hash_impl(key, len, seed);
+}
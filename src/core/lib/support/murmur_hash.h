@@ -41,4 +41,11 @@
 /* compute the hash of key (length len) */
 uint32_t gpr_murmur_hash3(const void *key, size_t len, uint32_t seed);
 
+/* compute the hash of key (length len) with the fastest implementation
+   available on this machine: CRC32C instruction based where the CPU supports
+   it (with a murmur-style finalizer to preserve distribution quality),
+   gpr_murmur_hash3 otherwise. Values are stable within a process but NOT
+   across processes or machines: use only for in-memory tables */
+uint32_t gpr_hash_bytes(const void *key, size_t len, uint32_t seed);
+
 #endif /* GRPC_CORE_LIB_SUPPORT_MURMUR_HASH_H */
@@ -40,6 +40,8 @@
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/tls.h>
 
 /* The lockfree node structure is a single architecture-level
    word that allows for an atomic CAS to set it up. */
@@ -150,3 +152,122 @@ int gpr_stack_lockfree_pop(gpr_stack_lockfree *stack) {
 
   return head.contents.index;
 }
+
+/* -- Epoch based reclamation ---------------------------------------------- */
+
+/* Threads register themselves in a fixed slot array on first use; a slot
+   holds (observed_epoch << 1) | 1 while its thread is inside a critical
+   section, 0 while quiescent.  The global epoch may only advance when every
+   active slot has observed the current epoch, at which point everything
+   deferred two epochs ago is unreachable and can be destroyed. */
+
+#define EBR_MAX_THREADS 256
+#define EBR_EPOCH_BUCKETS 3
+
+typedef struct ebr_deferred {
+  struct ebr_deferred *next;
+  void (*destroy)(void *arg);
+  void *arg;
+} ebr_deferred;
+
+typedef struct ebr_thread_slot {
+  gpr_atm active_epoch;
+  char padding[GPR_CACHELINE_SIZE - sizeof(gpr_atm)];
+} ebr_thread_slot;
+
+static gpr_atm g_ebr_epoch;
+static ebr_thread_slot g_ebr_slots[EBR_MAX_THREADS];
+static gpr_atm g_ebr_num_slots;
+/* guards the limbo lists and epoch advancement (the write side only) */
+static gpr_mu g_ebr_mu;
+static ebr_deferred *g_ebr_limbo[EBR_EPOCH_BUCKETS];
+GPR_TLS_DECL(g_ebr_my_slot); /* slot index + 1; 0 = not yet registered */
+
+void gpr_ebr_global_init(void) {
+  gpr_tls_init(&g_ebr_my_slot);
+  gpr_mu_init(&g_ebr_mu);
+  gpr_atm_no_barrier_store(&g_ebr_epoch, 1);
+  gpr_atm_no_barrier_store(&g_ebr_num_slots, 0);
+  memset(g_ebr_slots, 0, sizeof(g_ebr_slots));
+  memset(g_ebr_limbo, 0, sizeof(g_ebr_limbo));
+}
+
+static void ebr_run_deferred(ebr_deferred *d) {
+  while (d != NULL) {
+    ebr_deferred *next = d->next;
+    d->destroy(d->arg);
+    gpr_free(d);
+    d = next;
+  }
+}
+
+void gpr_ebr_global_shutdown(void) {
+  size_t i;
+  for (i = 0; i < EBR_EPOCH_BUCKETS; i++) {
+    ebr_run_deferred(g_ebr_limbo[i]);
+    g_ebr_limbo[i] = NULL;
+  }
+  gpr_mu_destroy(&g_ebr_mu);
+  gpr_tls_destroy(&g_ebr_my_slot);
+}
+
+void gpr_ebr_enter(void) {
+  intptr_t slot = gpr_tls_get(&g_ebr_my_slot);
+  ebr_thread_slot *s;
+  if (slot == 0) {
+    slot = (intptr_t)gpr_atm_no_barrier_fetch_add(&g_ebr_num_slots, 1) + 1;
+    GPR_ASSERT(slot <= EBR_MAX_THREADS);
+    gpr_tls_set(&g_ebr_my_slot, slot);
+  }
+  s = &g_ebr_slots[slot - 1];
+  /* announce the epoch we observed with a full barrier, then make sure it is
+     still current: if an advance raced past us, re-announce, so that by the
+     time we read the protected structure our slot pins either the current
+     epoch or its immediate predecessor */
+  for (;;) {
+    gpr_atm epoch = gpr_atm_acq_load(&g_ebr_epoch);
+    gpr_atm_full_xchg(&s->active_epoch, (epoch << 1) | 1);
+    if (gpr_atm_acq_load(&g_ebr_epoch) == epoch) break;
+  }
+}
+
+void gpr_ebr_exit(void) {
+  intptr_t slot = gpr_tls_get(&g_ebr_my_slot);
+  GPR_ASSERT(slot != 0);
+  gpr_atm_rel_store(&g_ebr_slots[slot - 1].active_epoch, 0);
+}
+
+/* returns the limbo list that became unreachable, to be run outside the
+   lock (a destroyer may itself call gpr_ebr_defer) */
+static ebr_deferred *ebr_try_advance_locked(gpr_atm epoch) {
+  ebr_deferred *stale;
+  size_t n = (size_t)gpr_atm_no_barrier_load(&g_ebr_num_slots);
+  size_t i;
+  if (n > EBR_MAX_THREADS) n = EBR_MAX_THREADS;
+  for (i = 0; i < n; i++) {
+    gpr_atm a = gpr_atm_acq_load(&g_ebr_slots[i].active_epoch);
+    if ((a & 1) && (a >> 1) != epoch) return NULL;
+  }
+  epoch++;
+  /* everything deferred two epochs ago is now unobservable: the bucket the
+     new epoch wraps onto is exactly that one */
+  stale = g_ebr_limbo[epoch % EBR_EPOCH_BUCKETS];
+  g_ebr_limbo[epoch % EBR_EPOCH_BUCKETS] = NULL;
+  gpr_atm_rel_store(&g_ebr_epoch, epoch);
+  return stale;
+}
+
+void gpr_ebr_defer(void (*destroy)(void *arg), void *arg) {
+  ebr_deferred *stale;
+  gpr_atm epoch;
+  ebr_deferred *d = gpr_malloc(sizeof(*d));
+  d->destroy = destroy;
+  d->arg = arg;
+  gpr_mu_lock(&g_ebr_mu);
+  epoch = gpr_atm_no_barrier_load(&g_ebr_epoch);
+  d->next = g_ebr_limbo[epoch % EBR_EPOCH_BUCKETS];
+  g_ebr_limbo[epoch % EBR_EPOCH_BUCKETS] = d;
+  stale = ebr_try_advance_locked(epoch);
+  gpr_mu_unlock(&g_ebr_mu);
+  ebr_run_deferred(stale);
+}
@@ -50,4 +50,26 @@ int gpr_stack_lockfree_push(gpr_stack_lockfree *, int entry);
 /* Returns -1 on empty or the actual entry number */
 int gpr_stack_lockfree_pop(gpr_stack_lockfree *stack);
 
+/* -- Epoch based reclamation ------------------------------------------------
+   Safe memory reclamation for lock free data structures. Readers bracket
+   their accesses with gpr_ebr_enter/gpr_ebr_exit; a writer that unlinks a
+   node hands it to gpr_ebr_defer, which runs the destroyer only once every
+   reader that could still observe the node has left its critical section.
+   Deferred destructions are batched by epoch; the epoch advances when every
+   active reader has caught up to the current one, so readers never block
+   and never touch a lock. */
+
+void gpr_ebr_global_init(void);
+/* Runs every outstanding deferred destruction. No thread may be inside a
+   critical section, and threads that ever entered one must be quiesced
+   before the library can be initialized again. */
+void gpr_ebr_global_shutdown(void);
+/* Enter/exit a read-side critical section. Sections are cheap (two atomic
+   ops on a thread-private cacheline) but must not nest. */
+void gpr_ebr_enter(void);
+void gpr_ebr_exit(void);
+/* Arrange for destroy(arg) to run once all current readers have exited.
+   Safe to call from inside a critical section. */
+void gpr_ebr_defer(void (*destroy)(void *arg), void *arg);
+
 #endif /* GRPC_CORE_LIB_SUPPORT_STACK_LOCKFREE_H */
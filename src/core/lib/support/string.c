@@ -35,7 +35,9 @@
 
 #include <ctype.h>
 #include <limits.h>
+#include <stdarg.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -265,6 +267,72 @@ char *gpr_strvec_flatten(gpr_strvec *sv, size_t *final_length) {
   return gpr_strjoin((const char **)sv->strs, sv->count, final_length);
 }
 
+void gpr_strbuf_init(gpr_strbuf *sb, char *backing, size_t backing_size) {
+  GPR_ASSERT(backing_size > 0);
+  sb->data = backing;
+  sb->length = 0;
+  sb->capacity = backing_size;
+  sb->owned = false;
+  backing[0] = 0;
+}
+
+void gpr_strbuf_destroy(gpr_strbuf *sb) {
+  if (sb->owned) gpr_free(sb->data);
+  sb->data = NULL;
+}
+
+/* guarantee room for \a needed more characters plus the NUL terminator,
+   moving off the backing buffer on first overflow */
+static void strbuf_reserve(gpr_strbuf *sb, size_t needed) {
+  if (sb->length + needed + 1 <= sb->capacity) return;
+  size_t new_capacity = GPR_MAX(sb->capacity * 2, sb->length + needed + 1);
+  if (sb->owned) {
+    sb->data = (char *)gpr_realloc(sb->data, new_capacity);
+  } else {
+    char *heap = (char *)gpr_malloc(new_capacity);
+    memcpy(heap, sb->data, sb->length + 1);
+    sb->data = heap;
+    sb->owned = true;
+  }
+  sb->capacity = new_capacity;
+}
+
+void gpr_strbuf_append(gpr_strbuf *sb, const char *str) {
+  size_t len = strlen(str);
+  strbuf_reserve(sb, len);
+  memcpy(sb->data + sb->length, str, len + 1);
+  sb->length += len;
+}
+
+void gpr_strbuf_printf(gpr_strbuf *sb, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int ret = vsnprintf(sb->data + sb->length, sb->capacity - sb->length, format,
+                      args);
+  va_end(args);
+  if (ret < 0) return;
+  if ((size_t)ret + 1 > sb->capacity - sb->length) {
+    /* did not fit: grow and format again (the only double-pass case) */
+    strbuf_reserve(sb, (size_t)ret);
+    va_start(args, format);
+    vsnprintf(sb->data + sb->length, sb->capacity - sb->length, format, args);
+    va_end(args);
+  }
+  sb->length += (size_t)ret;
+}
+
+char *gpr_strbuf_take(gpr_strbuf *sb) {
+  char *out;
+  if (sb->owned) {
+    out = sb->data;
+  } else {
+    out = (char *)gpr_malloc(sb->length + 1);
+    memcpy(out, sb->data, sb->length + 1);
+  }
+  sb->data = NULL;
+  return out;
+}
+
 int gpr_stricmp(const char *a, const char *b) {
   int ca, cb;
   do {
@@ -34,6 +34,7 @@
 #ifndef GRPC_CORE_LIB_SUPPORT_STRING_H
 #define GRPC_CORE_LIB_SUPPORT_STRING_H
 
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <grpc/support/port_platform.h>
@@ -115,6 +116,31 @@ void gpr_strvec_add(gpr_strvec *strs, char *add);
    total_length as per gpr_strjoin */
 char *gpr_strvec_flatten(gpr_strvec *strs, size_t *total_length);
 
+/* A string builder over a caller-provided (typically stack-resident) buffer.
+   Pieces are formatted into the buffer in a single pass - unlike
+   gpr_asprintf, which formats once to size and once to fill - and the
+   builder spills to the heap only if the buffer overflows. data is always
+   NUL terminated */
+typedef struct {
+  char *data;
+  size_t length;   /* excludes the NUL terminator */
+  size_t capacity; /* total bytes available at data */
+  bool owned;      /* data is heap allocated (the backing overflowed) */
+} gpr_strbuf;
+
+/* Initialize over \a backing, which must hold at least one byte */
+void gpr_strbuf_init(gpr_strbuf *sb, char *backing, size_t backing_size);
+/* Free any heap backing; no use of the builder is legal afterwards */
+void gpr_strbuf_destroy(gpr_strbuf *sb);
+/* Append a NUL terminated string */
+void gpr_strbuf_append(gpr_strbuf *sb, const char *str);
+/* Append printf-style formatted output */
+void gpr_strbuf_printf(gpr_strbuf *sb, const char *format, ...)
+    GPR_PRINT_FORMAT_CHECK(2, 3);
+/* Return the contents as a heap string owned by the caller, destroying the
+   builder */
+char *gpr_strbuf_take(gpr_strbuf *sb);
+
 /** Case insensitive string comparison... return <0 if lower(a)<lower(b), ==0 if
     lower(a)==lower(b), >0 if lower(a)>lower(b) */
 int gpr_stricmp(const char *a, const char *b);
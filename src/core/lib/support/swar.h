@@ -0,0 +1,58 @@
+/*
+ *
+ * Copyright 2017, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_SUPPORT_SWAR_H
+#define GRPC_CORE_LIB_SUPPORT_SWAR_H
+
+#include <stdint.h>
+
+/* SWAR ("SIMD within a register") byte classification, operating on 8 bytes
+   per iteration. All of these require every byte in \a w to be < 0x80 (check
+   against GPR_SWAR_HIGHS first); under that precondition the per-byte adds
+   cannot carry and each test is exact. */
+
+#define GPR_SWAR_ONES 0x0101010101010101ull
+#define GPR_SWAR_HIGHS 0x8080808080808080ull
+
+/* 0x80 in each byte of \a w that is >= \a b */
+static inline uint64_t gpr_swar_bytes_ge(uint64_t w, uint8_t b) {
+  return (w + GPR_SWAR_ONES * ((uint64_t)0x80u - b)) & GPR_SWAR_HIGHS;
+}
+
+/* 0x80 in each byte of \a w in [\a lo, \a hi]; requires hi < 0x7f */
+static inline uint64_t gpr_swar_bytes_in_range(uint64_t w, uint8_t lo,
+                                               uint8_t hi) {
+  return gpr_swar_bytes_ge(w, lo) & ~gpr_swar_bytes_ge(w, (uint8_t)(hi + 1));
+}
+
+#endif /* GRPC_CORE_LIB_SUPPORT_SWAR_H */
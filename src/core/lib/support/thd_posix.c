@@ -33,6 +33,10 @@
 
 /* Posix implementation for gpr threads. */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* for pthread_setaffinity_np */
+#endif
+
 #include <grpc/support/port_platform.h>
 
 #ifdef GPR_POSIX_SYNC
@@ -88,6 +92,26 @@ int gpr_thd_new(gpr_thd_id *t, void (*thd_body)(void *arg), void *arg,
   return thread_started;
 }
 
+int gpr_thd_bind_cpus(const int *cpus, size_t ncpus) {
+#ifdef GPR_LINUX
+  cpu_set_t cpuset;
+  size_t i;
+  if (ncpus == 0) return 0;
+  CPU_ZERO(&cpuset);
+  for (i = 0; i < ncpus; i++) {
+    if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE) {
+      CPU_SET((unsigned)cpus[i], &cpuset);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0;
+#else
+  /* No portable thread affinity interface on this platform */
+  (void)cpus;
+  (void)ncpus;
+  return 0;
+#endif
+}
+
 gpr_thd_id gpr_thd_currentid(void) { return (gpr_thd_id)pthread_self(); }
 
 void gpr_thd_join(gpr_thd_id t) { pthread_join((pthread_t)t, NULL); }
@@ -105,6 +105,13 @@ int gpr_thd_new(gpr_thd_id *t, void (*thd_body)(void *arg), void *arg,
   return handle != NULL;
 }
 
+int gpr_thd_bind_cpus(const int *cpus, size_t ncpus) {
+  /* Thread affinity is not supported here; leave the thread unbound */
+  (void)cpus;
+  (void)ncpus;
+  return 0;
+}
+
 gpr_thd_id gpr_thd_currentid(void) { return (gpr_thd_id)g_thd_info; }
 
 void gpr_thd_join(gpr_thd_id t) {
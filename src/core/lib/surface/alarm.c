@@ -33,9 +33,14 @@
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/sync.h>
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/support/env.h"
+#include "src/core/lib/support/string.h"
 #include "src/core/lib/surface/completion_queue.h"
 
+typedef struct alarm_bucket alarm_bucket;
+
 struct grpc_alarm {
   grpc_timer alarm;
   grpc_closure on_alarm;
@@ -44,8 +49,47 @@ struct grpc_alarm {
   grpc_completion_queue *cq;
   /** user supplied tag */
   void *tag;
+  /** whether this alarm went through the coalescing path (and so never
+      initialized its own timer) */
+  bool coalesced;
+  /** bucket this alarm is queued in, or NULL if it has fired or been
+      cancelled; guarded by g_bucket_mu */
+  alarm_bucket *bucket;
+  struct grpc_alarm *bucket_next;
+  struct grpc_alarm *bucket_prev;
+};
+
+/* Alarms with deadlines in the same granularity-sized quantum share one
+   grpc_timer; firing the bucket posts every member's completion. Enabled by
+   setting $GRPC_ALARM_COALESCING_MS to the granularity (in milliseconds):
+   applications that keep very large numbers of alarms live can trade that
+   much deadline slop for an order of magnitude fewer timer heap operations.
+   Off by default, preserving exact per-alarm timers. */
+struct alarm_bucket {
+  gpr_timespec deadline; /* quantized, monotonic */
+  grpc_timer timer;
+  grpc_closure on_timer;
+  grpc_alarm *alarms;
+  alarm_bucket *next;
 };
 
+static gpr_once g_init_once = GPR_ONCE_INIT;
+static gpr_mu g_bucket_mu;
+static alarm_bucket *g_buckets = NULL;
+static int64_t g_coalesce_ns = 0;
+
+static void alarm_global_init(void) {
+  gpr_mu_init(&g_bucket_mu);
+  char *env = gpr_getenv("GRPC_ALARM_COALESCING_MS");
+  if (env != NULL) {
+    int ms = gpr_parse_nonnegative_int(env);
+    if (ms > 0) {
+      g_coalesce_ns = (int64_t)ms * GPR_NS_PER_MS;
+    }
+    gpr_free(env);
+  }
+}
+
 static void do_nothing_end_completion(grpc_exec_ctx *exec_ctx, void *arg,
                                       grpc_cq_completion *c) {}
 
@@ -55,28 +99,139 @@ static void alarm_cb(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
                  do_nothing_end_completion, NULL, &alarm->completion);
 }
 
+static void bucket_cb(grpc_exec_ctx *exec_ctx, void *arg, grpc_error *error) {
+  alarm_bucket *bucket = arg;
+  grpc_alarm *alarm;
+
+  gpr_mu_lock(&g_bucket_mu);
+  alarm_bucket **pb = &g_buckets;
+  while (*pb != bucket) pb = &(*pb)->next;
+  *pb = bucket->next;
+  alarm = bucket->alarms;
+  for (grpc_alarm *a = alarm; a != NULL; a = a->bucket_next) {
+    a->bucket = NULL;
+  }
+  gpr_mu_unlock(&g_bucket_mu);
+
+  while (alarm != NULL) {
+    grpc_alarm *next = alarm->bucket_next;
+    grpc_cq_end_op(exec_ctx, alarm->cq, alarm->tag, GRPC_ERROR_REF(error),
+                   do_nothing_end_completion, NULL, &alarm->completion);
+    alarm = next;
+  }
+  gpr_free(bucket);
+}
+
+/* Round \a deadline up to the next quantum boundary, so a bucket never fires
+   before the deadlines of the alarms it holds */
+static gpr_timespec quantize_deadline(gpr_timespec deadline) {
+  int64_t ns = deadline.tv_sec * GPR_NS_PER_SEC + deadline.tv_nsec;
+  ns = ((ns + g_coalesce_ns - 1) / g_coalesce_ns) * g_coalesce_ns;
+  gpr_timespec out;
+  out.tv_sec = ns / GPR_NS_PER_SEC;
+  out.tv_nsec = (int32_t)(ns % GPR_NS_PER_SEC);
+  out.clock_type = deadline.clock_type;
+  return out;
+}
+
+static void coalesced_alarm_init(grpc_exec_ctx *exec_ctx, grpc_alarm *alarm,
+                                 gpr_timespec deadline, gpr_timespec now) {
+  gpr_timespec quantized = quantize_deadline(deadline);
+  gpr_mu_lock(&g_bucket_mu);
+  alarm_bucket *bucket = g_buckets;
+  while (bucket != NULL &&
+         gpr_time_cmp(bucket->deadline, quantized) != 0) {
+    bucket = bucket->next;
+  }
+  if (bucket == NULL) {
+    bucket = gpr_malloc(sizeof(*bucket));
+    bucket->deadline = quantized;
+    bucket->alarms = NULL;
+    bucket->next = g_buckets;
+    g_buckets = bucket;
+    grpc_closure_init(&bucket->on_timer, bucket_cb, bucket,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(exec_ctx, &bucket->timer, quantized, &bucket->on_timer,
+                    now);
+  }
+  alarm->bucket = bucket;
+  alarm->bucket_prev = NULL;
+  alarm->bucket_next = bucket->alarms;
+  if (bucket->alarms != NULL) {
+    bucket->alarms->bucket_prev = alarm;
+  }
+  bucket->alarms = alarm;
+  gpr_mu_unlock(&g_bucket_mu);
+}
+
+/* Posts the cancelled completion if the alarm is still queued in its bucket;
+   does nothing if it already fired or was cancelled */
+static void coalesced_alarm_cancel(grpc_exec_ctx *exec_ctx,
+                                   grpc_alarm *alarm) {
+  gpr_mu_lock(&g_bucket_mu);
+  alarm_bucket *bucket = alarm->bucket;
+  if (bucket == NULL) {
+    gpr_mu_unlock(&g_bucket_mu);
+    return;
+  }
+  if (alarm->bucket_prev != NULL) {
+    alarm->bucket_prev->bucket_next = alarm->bucket_next;
+  } else {
+    bucket->alarms = alarm->bucket_next;
+  }
+  if (alarm->bucket_next != NULL) {
+    alarm->bucket_next->bucket_prev = alarm->bucket_prev;
+  }
+  alarm->bucket = NULL;
+  if (bucket->alarms == NULL) {
+    /* the bucket's timer callback runs regardless and frees the (now empty)
+       bucket */
+    grpc_timer_cancel(exec_ctx, &bucket->timer);
+  }
+  gpr_mu_unlock(&g_bucket_mu);
+  grpc_cq_end_op(exec_ctx, alarm->cq, alarm->tag, GRPC_ERROR_CANCELLED,
+                 do_nothing_end_completion, NULL, &alarm->completion);
+}
+
 grpc_alarm *grpc_alarm_create(grpc_completion_queue *cq, gpr_timespec deadline,
                               void *tag) {
   grpc_alarm *alarm = gpr_malloc(sizeof(grpc_alarm));
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
 
+  gpr_once_init(&g_init_once, alarm_global_init);
+
   GRPC_CQ_INTERNAL_REF(cq, "alarm");
   alarm->cq = cq;
   alarm->tag = tag;
+  alarm->bucket = NULL;
 
   grpc_cq_begin_op(cq, tag);
-  grpc_closure_init(&alarm->on_alarm, alarm_cb, alarm,
-                    grpc_schedule_on_exec_ctx);
-  grpc_timer_init(&exec_ctx, &alarm->alarm,
-                  gpr_convert_clock_type(deadline, GPR_CLOCK_MONOTONIC),
-                  &alarm->on_alarm, gpr_now(GPR_CLOCK_MONOTONIC));
+  deadline = gpr_convert_clock_type(deadline, GPR_CLOCK_MONOTONIC);
+  /* deadlines too distant to quantize without overflow get their own timer;
+     in practice that's only the infinite ones */
+  alarm->coalesced =
+      g_coalesce_ns > 0 && deadline.tv_sec < INT64_MAX / GPR_NS_PER_SEC;
+  if (alarm->coalesced) {
+    coalesced_alarm_init(&exec_ctx, alarm, deadline,
+                         grpc_exec_ctx_now(&exec_ctx));
+  } else {
+    grpc_closure_init(&alarm->on_alarm, alarm_cb, alarm,
+                      grpc_schedule_on_exec_ctx);
+    grpc_timer_init(&exec_ctx, &alarm->alarm, deadline, &alarm->on_alarm,
+                    grpc_exec_ctx_now(&exec_ctx));
+  }
   grpc_exec_ctx_finish(&exec_ctx);
   return alarm;
 }
 
 void grpc_alarm_cancel(grpc_alarm *alarm) {
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
-  grpc_timer_cancel(&exec_ctx, &alarm->alarm);
+  if (alarm->coalesced) {
+    /* a no-op if the alarm already fired or was cancelled */
+    coalesced_alarm_cancel(&exec_ctx, alarm);
+  } else {
+    grpc_timer_cancel(&exec_ctx, &alarm->alarm);
+  }
   grpc_exec_ctx_finish(&exec_ctx);
 }
 
@@ -32,6 +32,99 @@
  */
 
 #include "src/core/lib/surface/api_trace.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/tls.h>
+
 #include "src/core/lib/debug/trace.h"
 
 grpc_tracer_flag grpc_api_trace = GRPC_TRACER_INITIALIZER(false);
+grpc_tracer_flag grpc_api_ring_trace = GRPC_TRACER_INITIALIZER(false);
+
+/* Deferred api tracing: each thread records compact (code, arg0, arg1)
+   events into its own fixed-size ring; nothing is formatted until the rings
+   are dumped. The rings are chained into a global list so a dump can walk
+   every thread's history. */
+
+typedef struct {
+  gpr_atm seq; /* global order; zero marks a never-written slot */
+  grpc_api_ring_trace_code code;
+  void *arg0;
+  void *arg1;
+} ring_event;
+
+typedef struct api_trace_ring {
+  struct api_trace_ring *next;
+  uint32_t head; /* next write index; only the owning thread writes it */
+  ring_event events[GRPC_API_RING_TRACE_EVENTS];
+} api_trace_ring;
+
+static gpr_mu g_ring_mu;
+static api_trace_ring *g_rings = NULL;
+static gpr_atm g_ring_seq = 0;
+GPR_TLS_DECL(g_thread_ring);
+
+static const char *const g_ring_code_names[] = {
+    "call_start_batch", "cq_begin_op", "cq_end_op", "cq_return_event"};
+
+void grpc_api_ring_trace_init(void) {
+  gpr_mu_init(&g_ring_mu);
+  gpr_tls_init(&g_thread_ring);
+  gpr_tls_set(&g_thread_ring, 0);
+}
+
+void grpc_api_ring_trace_shutdown(void) {
+  if (GRPC_TRACER_ON(grpc_api_ring_trace)) {
+    grpc_api_ring_trace_dump();
+  }
+  gpr_mu_lock(&g_ring_mu);
+  while (g_rings != NULL) {
+    api_trace_ring *ring = g_rings;
+    g_rings = ring->next;
+    gpr_free(ring);
+  }
+  gpr_mu_unlock(&g_ring_mu);
+  gpr_tls_destroy(&g_thread_ring);
+  gpr_mu_destroy(&g_ring_mu);
+}
+
+void grpc_api_ring_trace_record(grpc_api_ring_trace_code code, void *arg0,
+                                void *arg1) {
+  api_trace_ring *ring = (api_trace_ring *)gpr_tls_get(&g_thread_ring);
+  if (ring == NULL) {
+    ring = gpr_zalloc(sizeof(*ring));
+    gpr_mu_lock(&g_ring_mu);
+    ring->next = g_rings;
+    g_rings = ring;
+    gpr_mu_unlock(&g_ring_mu);
+    gpr_tls_set(&g_thread_ring, (intptr_t)ring);
+  }
+  ring_event *ev =
+      &ring->events[ring->head++ & (GRPC_API_RING_TRACE_EVENTS - 1)];
+  ev->code = code;
+  ev->arg0 = arg0;
+  ev->arg1 = arg1;
+  /* written last so a concurrent dump seeing the new seq sees a mostly
+     consistent event; this is a best-effort postmortem facility, not a
+     synchronized log */
+  gpr_atm_no_barrier_store(&ev->seq,
+                           gpr_atm_no_barrier_fetch_add(&g_ring_seq, 1) + 1);
+}
+
+void grpc_api_ring_trace_dump(void) {
+  gpr_mu_lock(&g_ring_mu);
+  int thread = 0;
+  for (api_trace_ring *ring = g_rings; ring != NULL;
+       ring = ring->next, thread++) {
+    for (size_t i = 0; i < GRPC_API_RING_TRACE_EVENTS; i++) {
+      ring_event *ev = &ring->events[i];
+      gpr_atm seq = gpr_atm_no_barrier_load(&ev->seq);
+      if (seq == 0) continue;
+      gpr_log(GPR_INFO, "api_ring thd=%d seq=%" PRIdPTR " %s(%p, %p)", thread,
+              seq, g_ring_code_names[ev->code], ev->arg0, ev->arg1);
+    }
+  }
+  gpr_mu_unlock(&g_ring_mu);
+}
@@ -62,4 +62,33 @@ extern grpc_tracer_flag grpc_api_trace;
     gpr_log(GPR_INFO, fmt GRPC_API_TRACE_UNWRAP##nargs args); \
   }
 
+/* Deferred api tracing ('api_ring' tracer): hot paths record a compact
+   (code, arg0, arg1) event into a per-thread ring buffer and formatting is
+   deferred until the rings are dumped - cheap enough to leave enabled in
+   production for postmortems. The rings are dumped (via gpr_log) at
+   grpc_shutdown, or on demand with grpc_api_ring_trace_dump(). */
+
+extern grpc_tracer_flag grpc_api_ring_trace;
+
+typedef enum {
+  GRPC_API_RING_TRACE_CALL_START_BATCH,
+  GRPC_API_RING_TRACE_CQ_BEGIN_OP,
+  GRPC_API_RING_TRACE_CQ_END_OP,
+  GRPC_API_RING_TRACE_CQ_RETURN_EVENT,
+} grpc_api_ring_trace_code;
+
+/* events retained per thread; must be a power of two */
+#define GRPC_API_RING_TRACE_EVENTS 4096
+
+void grpc_api_ring_trace_init(void);
+void grpc_api_ring_trace_shutdown(void);
+void grpc_api_ring_trace_record(grpc_api_ring_trace_code code, void *arg0,
+                                void *arg1);
+void grpc_api_ring_trace_dump(void);
+
+#define GRPC_API_RING_TRACE(code, arg0, arg1)                           \
+  if (GRPC_TRACER_ON(grpc_api_ring_trace)) {                            \
+    grpc_api_ring_trace_record((code), (void *)(arg0), (void *)(arg1)); \
+  }
+
 #endif /* GRPC_CORE_LIB_SURFACE_API_TRACE_H */
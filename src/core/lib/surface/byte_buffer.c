@@ -101,3 +101,11 @@ size_t grpc_byte_buffer_length(grpc_byte_buffer *bb) {
   }
   GPR_UNREACHABLE_CODE(return 0);
 }
+
+grpc_compression_algorithm grpc_byte_buffer_compression(grpc_byte_buffer *bb) {
+  switch (bb->type) {
+    case GRPC_BB_RAW:
+      return bb->data.raw.compression;
+  }
+  GPR_UNREACHABLE_CODE(return GRPC_COMPRESS_NONE);
+}
@@ -115,6 +115,15 @@ static received_status unpack_received_status(gpr_atm atm) {
 
 #define MAX_ERRORS_PER_BATCH 4
 
+/* One message read ahead of application demand, fully drained from its
+   transport byte stream (so the transport's flow control credit was already
+   returned) and queued until the application asks for it. */
+typedef struct prefetched_message {
+  struct prefetched_message *next;
+  grpc_slice_buffer payload;
+  uint32_t flags;
+} prefetched_message;
+
 typedef struct batch_control {
   grpc_call *call;
   /* Share memory for cq_completion and notify_tag as they are never needed
@@ -162,6 +171,7 @@ typedef struct {
 struct grpc_call {
   gpr_refcount ext_ref;
   gpr_arena *arena;
+  gpr_atm *method_size_estimate;
   grpc_completion_queue *cq;
   grpc_polling_entity pollent;
   grpc_channel *channel;
@@ -223,7 +233,6 @@ struct grpc_call {
 
   grpc_byte_stream *receiving_stream;
   grpc_byte_buffer **receiving_buffer;
-  grpc_slice receiving_slice;
   grpc_closure receiving_slice_ready;
   grpc_closure receiving_stream_ready;
   grpc_closure receiving_initial_metadata_ready;
@@ -231,6 +240,34 @@ struct grpc_call {
 
   grpc_closure release_call;
 
+  /* Receive-message read-ahead (GRPC_ARG_RECV_MESSAGE_PREFETCH). When the
+     budget is non-zero the call layer owns every transport recv_message op:
+     from the application's first recv onward it keeps one internal recv op
+     in flight whenever the ready queue is below budget, drains arriving
+     streams eagerly, and satisfies application recv_message ops from the
+     queue. receiving_message still serializes application demand. */
+  int recv_prefetch_budget;
+  /* guards the queue and flags below; leaf lock, never held across
+     transport calls or closure runs */
+  gpr_mu prefetch_mu;
+  bool prefetch_op_outstanding;
+  bool prefetch_eos;
+  prefetched_message *prefetch_head;
+  prefetched_message *prefetch_tail;
+  int prefetch_count;
+  /* message currently being drained from prefetch_incoming */
+  prefetched_message *prefetch_filling;
+  /* message delivered to the application, freed on the next delivery (its
+     payload backs prefetch_delivery_stream until then) */
+  prefetched_message *prefetch_delivering;
+  grpc_byte_stream *prefetch_incoming;
+  batch_control *prefetch_waiting_bctl;
+  grpc_slice_buffer_stream prefetch_delivery_stream;
+  grpc_closure prefetch_stream_ready_closure;
+  grpc_closure prefetch_slice_ready_closure;
+  grpc_closure prefetch_batch_done_closure;
+  grpc_transport_stream_op_batch prefetch_batch;
+
   union {
     struct {
       grpc_status_code *status;
@@ -314,20 +351,31 @@ grpc_error *grpc_call_create(grpc_exec_ctx *exec_ctx,
       grpc_channel_get_channel_stack(args->channel);
   grpc_call *call;
   GPR_TIMER_BEGIN("grpc_call_create", 0);
-  gpr_arena *arena =
-      gpr_arena_create(grpc_channel_get_call_size_estimate(args->channel));
+  gpr_arena *arena = grpc_channel_take_call_arena(
+      args->channel, grpc_channel_get_call_size_estimate(
+                         args->channel, args->method_size_estimate));
+  /* the arena is exclusively ours until this function returns (closures
+     scheduled below only run once the exec_ctx is flushed), so allocations
+     during call and stack initialization can skip atomics */
+  gpr_arena_set_single_threaded(arena, true);
   call = gpr_arena_alloc(arena,
                          sizeof(grpc_call) + channel_stack->call_stack_size);
   gpr_ref_init(&call->ext_ref, 1);
   call->arena = arena;
+  call->method_size_estimate = args->method_size_estimate;
   *out_call = call;
   call->channel = args->channel;
   call->cq = args->cq;
-  call->start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+  call->start_time = grpc_exec_ctx_now(exec_ctx);
   /* Always support no compression */
   GPR_BITSET(&call->encodings_accepted_by_peer, GRPC_COMPRESS_NONE);
   call->is_client = args->server_transport_data == NULL;
   call->stream_op_payload.context = call->context;
+  /* arena memory is zeroed, so the rest of the read-ahead state needs no
+     initialization */
+  call->recv_prefetch_budget =
+      grpc_channel_get_recv_message_prefetch(args->channel);
+  gpr_mu_init(&call->prefetch_mu);
   grpc_slice path = grpc_empty_slice();
   if (call->is_client) {
     GPR_ASSERT(args->add_initial_metadata_count <
@@ -453,6 +501,8 @@ grpc_error *grpc_call_create(grpc_exec_ctx *exec_ctx,
 
   grpc_slice_unref_internal(exec_ctx, path);
 
+  gpr_arena_set_single_threaded(arena, false);
+
   GPR_TIMER_END("grpc_call_create", 0);
   return error;
 }
@@ -490,7 +540,12 @@ static void release_call(grpc_exec_ctx *exec_ctx, void *call,
                          grpc_error *error) {
   grpc_call *c = call;
   grpc_channel *channel = c->channel;
-  grpc_channel_update_call_size_estimate(channel, gpr_arena_destroy(c->arena));
+  gpr_atm *method_size_estimate = c->method_size_estimate;
+  /* returning the arena re-zeroes the memory the call lives in, so pull
+     everything out of c first */
+  size_t allocated = grpc_channel_return_call_arena(channel, c->arena);
+  grpc_channel_update_call_size_estimate(channel, method_size_estimate,
+                                         allocated);
   GRPC_CHANNEL_INTERNAL_UNREF(exec_ctx, channel, "call");
 }
 
@@ -508,6 +563,18 @@ static void destroy_call(grpc_exec_ctx *exec_ctx, void *call,
   if (c->receiving_stream != NULL) {
     grpc_byte_stream_destroy(exec_ctx, c->receiving_stream);
   }
+  while (c->prefetch_head != NULL) {
+    prefetched_message *msg = c->prefetch_head;
+    c->prefetch_head = msg->next;
+    grpc_slice_buffer_destroy_internal(exec_ctx, &msg->payload);
+    gpr_free(msg);
+  }
+  if (c->prefetch_delivering != NULL) {
+    grpc_slice_buffer_destroy_internal(exec_ctx,
+                                       &c->prefetch_delivering->payload);
+    gpr_free(c->prefetch_delivering);
+  }
+  gpr_mu_destroy(&c->prefetch_mu);
   parent_call *pc = get_parent_call(c);
   if (pc != NULL) {
     gpr_mu_destroy(&pc->child_list_mu);
@@ -527,7 +594,7 @@ static void destroy_call(grpc_exec_ctx *exec_ctx, void *call,
   get_final_status(call, set_status_value_directly, &c->final_info.final_status,
                    NULL);
   c->final_info.stats.latency =
-      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), c->start_time);
+      gpr_time_sub(grpc_exec_ctx_now(exec_ctx), c->start_time);
 
   for (i = 0; i < STATUS_SOURCE_COUNT; i++) {
     GRPC_ERROR_UNREF(
@@ -871,7 +938,8 @@ static int prepare_application_metadata(
                    grpc_validate_header_nonbin_value_is_legal(md->value))) {
       break;
     }
-    l->md = grpc_mdelem_from_grpc_metadata(exec_ctx, (grpc_metadata *)md);
+    l->md = grpc_mdelem_from_grpc_metadata(exec_ctx, (grpc_metadata *)md,
+                                           call->arena);
   }
   if (i != total_count) {
     for (int j = 0; j < i; j++) {
@@ -1039,41 +1107,57 @@ static void set_cancelled_value(grpc_status_code status, void *dest) {
   *(int *)dest = (status != GRPC_STATUS_OK);
 }
 
-static bool are_write_flags_valid(uint32_t flags) {
-  /* check that only bits in GRPC_WRITE_(INTERNAL?)_USED_MASK are set */
-  const uint32_t allowed_write_positions =
-      (GRPC_WRITE_USED_MASK | GRPC_WRITE_INTERNAL_USED_MASK);
-  const uint32_t invalid_positions = ~allowed_write_positions;
-  return !(flags & invalid_positions);
-}
+/* Precompiled validation descriptors, one per op type: the batch shape
+   checks (flag masks, which side may start the op) are data rather than
+   per-op branch chains, so call_start_batch can validate a batch with a
+   single table-driven pass before mutating any call state */
+typedef struct {
+  /* flags that may legally be set on this op, per side */
+  uint32_t valid_flags_client;
+  uint32_t valid_flags_server;
+  /* error returned when the op is started from that side;
+     GRPC_CALL_OK when the side is allowed */
+  grpc_call_error client_error;
+  grpc_call_error server_error;
+} batch_op_descriptor;
+
+static const batch_op_descriptor g_op_descriptors[] = {
+    [GRPC_OP_SEND_INITIAL_METADATA] =
+        {GRPC_INITIAL_METADATA_USED_MASK,
+         GRPC_INITIAL_METADATA_USED_MASK &
+             ~(uint32_t)GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST,
+         GRPC_CALL_OK, GRPC_CALL_OK},
+    [GRPC_OP_SEND_MESSAGE] = {GRPC_WRITE_USED_MASK |
+                                  GRPC_WRITE_INTERNAL_USED_MASK,
+                              GRPC_WRITE_USED_MASK |
+                                  GRPC_WRITE_INTERNAL_USED_MASK,
+                              GRPC_CALL_OK, GRPC_CALL_OK},
+    [GRPC_OP_SEND_CLOSE_FROM_CLIENT] = {0, 0, GRPC_CALL_OK,
+                                        GRPC_CALL_ERROR_NOT_ON_SERVER},
+    [GRPC_OP_SEND_STATUS_FROM_SERVER] = {0, 0, GRPC_CALL_ERROR_NOT_ON_CLIENT,
+                                         GRPC_CALL_OK},
+    [GRPC_OP_RECV_INITIAL_METADATA] = {0, 0, GRPC_CALL_OK, GRPC_CALL_OK},
+    [GRPC_OP_RECV_MESSAGE] = {0, 0, GRPC_CALL_OK, GRPC_CALL_OK},
+    [GRPC_OP_RECV_STATUS_ON_CLIENT] = {0, 0, GRPC_CALL_OK,
+                                       GRPC_CALL_ERROR_NOT_ON_SERVER},
+    [GRPC_OP_RECV_CLOSE_ON_SERVER] = {0, 0, GRPC_CALL_ERROR_NOT_ON_CLIENT,
+                                      GRPC_CALL_OK},
+};
 
-static bool are_initial_metadata_flags_valid(uint32_t flags, bool is_client) {
-  /* check that only bits in GRPC_WRITE_(INTERNAL?)_USED_MASK are set */
-  uint32_t invalid_positions = ~GRPC_INITIAL_METADATA_USED_MASK;
-  if (!is_client) {
-    invalid_positions |= GRPC_INITIAL_METADATA_IDEMPOTENT_REQUEST;
-  }
-  return !(flags & invalid_positions);
-}
+static const uint8_t g_batch_slots[] = {
+    [GRPC_OP_SEND_INITIAL_METADATA] = 0,
+    [GRPC_OP_SEND_MESSAGE] = 1,
+    [GRPC_OP_SEND_CLOSE_FROM_CLIENT] = 2,
+    [GRPC_OP_SEND_STATUS_FROM_SERVER] = 2,
+    [GRPC_OP_RECV_INITIAL_METADATA] = 3,
+    [GRPC_OP_RECV_MESSAGE] = 4,
+    [GRPC_OP_RECV_STATUS_ON_CLIENT] = 5,
+    [GRPC_OP_RECV_CLOSE_ON_SERVER] = 5,
+};
 
 static int batch_slot_for_op(grpc_op_type type) {
-  switch (type) {
-    case GRPC_OP_SEND_INITIAL_METADATA:
-      return 0;
-    case GRPC_OP_SEND_MESSAGE:
-      return 1;
-    case GRPC_OP_SEND_CLOSE_FROM_CLIENT:
-    case GRPC_OP_SEND_STATUS_FROM_SERVER:
-      return 2;
-    case GRPC_OP_RECV_INITIAL_METADATA:
-      return 3;
-    case GRPC_OP_RECV_MESSAGE:
-      return 4;
-    case GRPC_OP_RECV_CLOSE_ON_SERVER:
-    case GRPC_OP_RECV_STATUS_ON_CLIENT:
-      return 5;
-  }
-  GPR_UNREACHABLE_CODE(return 123456789);
+  GPR_ASSERT((size_t)type < GPR_ARRAY_SIZE(g_batch_slots));
+  return g_batch_slots[type];
 }
 
 static batch_control *allocate_batch_control(grpc_call *call,
@@ -1205,36 +1289,42 @@ static void continue_receiving_slices(grpc_exec_ctx *exec_ctx,
                                       batch_control *bctl) {
   grpc_error *error;
   grpc_call *call = bctl->call;
-  for (;;) {
-    size_t remaining = call->receiving_stream->length -
-                       (*call->receiving_buffer)->data.raw.slice_buffer.length;
-    if (remaining == 0) {
-      call->receiving_message = 0;
+  grpc_slice_buffer *sb = &(*call->receiving_buffer)->data.raw.slice_buffer;
+  if (sb->length < call->receiving_stream->length) {
+    if (!grpc_byte_stream_pull_buffer(exec_ctx, call->receiving_stream, sb,
+                                      &call->receiving_slice_ready, &error)) {
+      /* receiving_slice_ready resumes us when the next bytes land */
+      return;
+    }
+    if (error != GRPC_ERROR_NONE) {
+      GRPC_ERROR_UNREF(error);
       grpc_byte_stream_destroy(exec_ctx, call->receiving_stream);
       call->receiving_stream = NULL;
+      grpc_byte_buffer_destroy(*call->receiving_buffer);
+      *call->receiving_buffer = NULL;
+      call->receiving_message = 0;
       finish_batch_step(exec_ctx, bctl);
       return;
     }
-    if (grpc_byte_stream_next(exec_ctx, call->receiving_stream, remaining,
-                              &call->receiving_slice_ready)) {
-      error = grpc_byte_stream_pull(exec_ctx, call->receiving_stream,
-                                    &call->receiving_slice);
-      if (error == GRPC_ERROR_NONE) {
-        grpc_slice_buffer_add(&(*call->receiving_buffer)->data.raw.slice_buffer,
-                              call->receiving_slice);
-      } else {
-        grpc_byte_stream_destroy(exec_ctx, call->receiving_stream);
-        call->receiving_stream = NULL;
-        grpc_byte_buffer_destroy(*call->receiving_buffer);
-        *call->receiving_buffer = NULL;
-        call->receiving_message = 0;
-        finish_batch_step(exec_ctx, bctl);
-        return;
-      }
-    } else {
-      return;
+  }
+  if (grpc_channel_contiguous_recv_messages(call->channel) && sb->count > 1) {
+    /* assemble the message into one contiguous slice: a single
+       sequential copy here spares the deserializer a multi-slice
+       traversal */
+    grpc_slice assembled = GRPC_SLICE_MALLOC(sb->length);
+    uint8_t *dst = GRPC_SLICE_START_PTR(assembled);
+    for (size_t i = 0; i < sb->count; i++) {
+      memcpy(dst, GRPC_SLICE_START_PTR(sb->slices[i]),
+             GRPC_SLICE_LENGTH(sb->slices[i]));
+      dst += GRPC_SLICE_LENGTH(sb->slices[i]);
     }
+    grpc_slice_buffer_reset_and_unref_internal(exec_ctx, sb);
+    grpc_slice_buffer_add(sb, assembled);
   }
+  call->receiving_message = 0;
+  grpc_byte_stream_destroy(exec_ctx, call->receiving_stream);
+  call->receiving_stream = NULL;
+  finish_batch_step(exec_ctx, bctl);
 }
 
 static void receiving_slice_ready(grpc_exec_ctx *exec_ctx, void *bctlp,
@@ -1300,6 +1390,25 @@ static void receiving_stream_ready(grpc_exec_ctx *exec_ctx, void *bctlp,
                                    grpc_error *error) {
   batch_control *bctl = bctlp;
   grpc_call *call = bctl->call;
+  grpc_error *size_error = GRPC_ERROR_NONE;
+  /* Enforce the flat receive size limit inline; see the matching send-side
+     check in call_start_batch. */
+  if (error == GRPC_ERROR_NONE && call->receiving_stream != NULL) {
+    const int max_recv_size =
+        grpc_channel_get_max_recv_message_size(call->channel);
+    if (max_recv_size >= 0 &&
+        call->receiving_stream->length > (size_t)max_recv_size) {
+      char *message_string;
+      gpr_asprintf(&message_string,
+                   "Received message larger than max (%u vs. %d)",
+                   call->receiving_stream->length, max_recv_size);
+      size_error = grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_COPIED_STRING(message_string),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED);
+      gpr_free(message_string);
+      error = size_error;
+    }
+  }
   if (error != GRPC_ERROR_NONE) {
     if (call->receiving_stream != NULL) {
       grpc_byte_stream_destroy(exec_ctx, call->receiving_stream);
@@ -1315,6 +1424,231 @@ static void receiving_stream_ready(grpc_exec_ctx *exec_ctx, void *bctlp,
   } else {
     call->saved_receiving_stream_ready_bctlp = bctlp;
   }
+  GRPC_ERROR_UNREF(size_error);
+}
+
+/* Receive-message read-ahead engine: see the field block in grpc_call.
+   Application threads (call_start_batch) and transport callbacks touch the
+   engine concurrently, so queue/flag state is guarded by prefetch_mu - a
+   leaf lock, never held across transport calls or closure runs: each site
+   mutates state under the lock and carries out the resulting transport op
+   or delivery after dropping it. */
+
+static void prefetch_issue_op(grpc_exec_ctx *exec_ctx, grpc_call *call);
+
+/* decide, under prefetch_mu, whether a new transport recv op is needed;
+   the caller issues it after unlocking. prefetch_op_outstanding makes the
+   reservation exclusive. */
+static bool prefetch_reserve_op_locked(grpc_call *call) {
+  if (call->prefetch_op_outstanding || call->prefetch_eos) return false;
+  if (call->prefetch_waiting_bctl == NULL &&
+      call->prefetch_count >= call->recv_prefetch_budget) {
+    return false;
+  }
+  call->prefetch_op_outstanding = true;
+  return true;
+}
+
+static void prefetch_free_delivered(grpc_exec_ctx *exec_ctx, grpc_call *call) {
+  if (call->prefetch_delivering == NULL) return;
+  grpc_slice_buffer_destroy_internal(exec_ctx,
+                                     &call->prefetch_delivering->payload);
+  gpr_free(call->prefetch_delivering);
+  call->prefetch_delivering = NULL;
+}
+
+/* deliver a drained message to the demand represented by bctl: re-present
+   the buffered payload as a byte stream so delivery shares the regular path
+   (size check, compression handling, contiguity) */
+static void prefetch_deliver_queued(grpc_exec_ctx *exec_ctx,
+                                    batch_control *bctl,
+                                    prefetched_message *msg) {
+  grpc_call *call = bctl->call;
+  call->prefetch_delivering = msg;
+  grpc_slice_buffer_stream_init(&call->prefetch_delivery_stream, &msg->payload,
+                                msg->flags);
+  call->receiving_stream = &call->prefetch_delivery_stream.base;
+  grpc_closure_run(exec_ctx,
+                   grpc_closure_create(receiving_stream_ready, bctl,
+                                       grpc_schedule_on_exec_ctx),
+                   GRPC_ERROR_NONE);
+}
+
+static void prefetch_finish_filling(grpc_exec_ctx *exec_ctx, grpc_call *call,
+                                    grpc_error *error) {
+  prefetched_message *msg = call->prefetch_filling;
+  call->prefetch_filling = NULL;
+  grpc_byte_stream_destroy(exec_ctx, call->prefetch_incoming);
+  call->prefetch_incoming = NULL;
+  batch_control *waiting = NULL;
+  bool issue = false;
+  gpr_mu_lock(&call->prefetch_mu);
+  if (error != GRPC_ERROR_NONE) {
+    /* the stream broke mid-message: drop the partial payload; the failure
+       reaches the application through the call's status ops */
+    call->prefetch_eos = true;
+  } else if (call->prefetch_waiting_bctl != NULL) {
+    /* demand arrived while we were draining: the queue is empty, so this
+       message is what it is waiting for */
+    waiting = call->prefetch_waiting_bctl;
+    call->prefetch_waiting_bctl = NULL;
+  } else {
+    if (call->prefetch_head == NULL) {
+      call->prefetch_head = msg;
+    } else {
+      call->prefetch_tail->next = msg;
+    }
+    call->prefetch_tail = msg;
+    call->prefetch_count++;
+  }
+  issue = prefetch_reserve_op_locked(call);
+  gpr_mu_unlock(&call->prefetch_mu);
+  if (error != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(error);
+    grpc_slice_buffer_destroy_internal(exec_ctx, &msg->payload);
+    gpr_free(msg);
+  } else if (waiting != NULL) {
+    prefetch_deliver_queued(exec_ctx, waiting, msg);
+  }
+  if (issue) prefetch_issue_op(exec_ctx, call);
+  GRPC_CALL_INTERNAL_UNREF(exec_ctx, call, "prefetch_drain");
+}
+
+static void prefetch_continue_filling(grpc_exec_ctx *exec_ctx,
+                                      grpc_call *call) {
+  grpc_error *error;
+  if (!grpc_byte_stream_pull_buffer(exec_ctx, call->prefetch_incoming,
+                                    &call->prefetch_filling->payload,
+                                    &call->prefetch_slice_ready_closure,
+                                    &error)) {
+    /* prefetch_slice_ready resumes us when the next bytes land */
+    return;
+  }
+  prefetch_finish_filling(exec_ctx, call, error);
+}
+
+static void prefetch_slice_ready(grpc_exec_ctx *exec_ctx, void *callp,
+                                 grpc_error *error) {
+  grpc_call *call = callp;
+  if (error == GRPC_ERROR_NONE) {
+    grpc_slice slice;
+    /* an error returned by grpc_byte_stream_pull is owned by us, exactly
+       what prefetch_finish_filling consumes */
+    error = grpc_byte_stream_pull(exec_ctx, call->prefetch_incoming, &slice);
+    if (error == GRPC_ERROR_NONE) {
+      grpc_slice_buffer_add(&call->prefetch_filling->payload, slice);
+      prefetch_continue_filling(exec_ctx, call);
+      return;
+    }
+  } else {
+    error = GRPC_ERROR_REF(error);
+  }
+  prefetch_finish_filling(exec_ctx, call, error);
+}
+
+static void prefetch_stream_ready(grpc_exec_ctx *exec_ctx, void *callp,
+                                  grpc_error *error) {
+  grpc_call *call = callp;
+  if (error != GRPC_ERROR_NONE && call->prefetch_incoming != NULL) {
+    grpc_byte_stream_destroy(exec_ctx, call->prefetch_incoming);
+    call->prefetch_incoming = NULL;
+  }
+  bool terminal =
+      error != GRPC_ERROR_NONE || call->prefetch_incoming == NULL;
+  gpr_mu_lock(&call->prefetch_mu);
+  if (terminal) {
+    /* failure or end of stream: whichever read gets here next observes the
+       regular NULL-message end; status ops carry any error */
+    call->prefetch_eos = true;
+  }
+  batch_control *waiting = call->prefetch_waiting_bctl;
+  if (waiting != NULL) call->prefetch_waiting_bctl = NULL;
+  gpr_mu_unlock(&call->prefetch_mu);
+  if (waiting != NULL) {
+    /* hand the stream straight to the waiting application demand, exactly
+       as if the transport had completed the application's own recv op */
+    call->receiving_stream = call->prefetch_incoming;
+    call->prefetch_incoming = NULL;
+    grpc_closure_run(exec_ctx,
+                     grpc_closure_create(receiving_stream_ready, waiting,
+                                         grpc_schedule_on_exec_ctx),
+                     GRPC_ERROR_REF(error));
+  } else if (call->prefetch_incoming != NULL) {
+    /* no demand yet: drain the stream now so its flow-control credit goes
+       back to the peer immediately, and queue the payload */
+    prefetched_message *msg = gpr_malloc(sizeof(*msg));
+    msg->next = NULL;
+    msg->flags = call->prefetch_incoming->flags;
+    grpc_slice_buffer_init(&msg->payload);
+    call->prefetch_filling = msg;
+    GRPC_CALL_INTERNAL_REF(call, "prefetch_drain");
+    grpc_closure_init(&call->prefetch_slice_ready_closure, prefetch_slice_ready,
+                      call, grpc_schedule_on_exec_ctx);
+    prefetch_continue_filling(exec_ctx, call);
+  }
+}
+
+static void prefetch_batch_done(grpc_exec_ctx *exec_ctx, void *callp,
+                                grpc_error *error) {
+  grpc_call *call = callp;
+  gpr_mu_lock(&call->prefetch_mu);
+  call->prefetch_op_outstanding = false;
+  if (error != GRPC_ERROR_NONE) {
+    call->prefetch_eos = true;
+  }
+  bool issue = prefetch_reserve_op_locked(call);
+  gpr_mu_unlock(&call->prefetch_mu);
+  if (issue) prefetch_issue_op(exec_ctx, call);
+  GRPC_CALL_INTERNAL_UNREF(exec_ctx, call, "prefetch_op");
+}
+
+static void prefetch_issue_op(grpc_exec_ctx *exec_ctx, grpc_call *call) {
+  GRPC_CALL_INTERNAL_REF(call, "prefetch_op");
+  memset(&call->prefetch_batch, 0, sizeof(call->prefetch_batch));
+  call->prefetch_batch.payload = &call->stream_op_payload;
+  call->prefetch_batch.covered_by_poller = true;
+  call->prefetch_batch.recv_message = true;
+  call->stream_op_payload.recv_message.recv_message = &call->prefetch_incoming;
+  grpc_closure_init(&call->prefetch_stream_ready_closure, prefetch_stream_ready,
+                    call, grpc_schedule_on_exec_ctx_urgent);
+  call->stream_op_payload.recv_message.recv_message_ready =
+      &call->prefetch_stream_ready_closure;
+  grpc_closure_init(&call->prefetch_batch_done_closure, prefetch_batch_done,
+                    call, grpc_schedule_on_exec_ctx);
+  call->prefetch_batch.on_complete = &call->prefetch_batch_done_closure;
+  execute_op(exec_ctx, call, &call->prefetch_batch);
+}
+
+static void prefetch_satisfy_demand(grpc_exec_ctx *exec_ctx,
+                                    batch_control *bctl) {
+  grpc_call *call = bctl->call;
+  prefetch_free_delivered(exec_ctx, call);
+  prefetched_message *msg = NULL;
+  bool eos = false;
+  gpr_mu_lock(&call->prefetch_mu);
+  if (call->prefetch_head != NULL) {
+    msg = call->prefetch_head;
+    call->prefetch_head = msg->next;
+    if (call->prefetch_head == NULL) call->prefetch_tail = NULL;
+    call->prefetch_count--;
+    msg->next = NULL;
+  } else if (call->prefetch_eos) {
+    eos = true;
+  } else {
+    call->prefetch_waiting_bctl = bctl;
+  }
+  bool issue = prefetch_reserve_op_locked(call);
+  gpr_mu_unlock(&call->prefetch_mu);
+  if (issue) prefetch_issue_op(exec_ctx, call);
+  if (msg != NULL) {
+    prefetch_deliver_queued(exec_ctx, bctl, msg);
+  } else if (eos) {
+    call->receiving_stream = NULL;
+    grpc_closure_run(exec_ctx,
+                     grpc_closure_create(receiving_stream_ready, bctl,
+                                         grpc_schedule_on_exec_ctx),
+                     GRPC_ERROR_NONE);
+  }
 }
 
 static void validate_filtered_metadata(grpc_exec_ctx *exec_ctx,
@@ -1437,6 +1771,7 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
   batch_control *bctl;
   int num_completion_callbacks_needed = 1;
   grpc_call_error error = GRPC_CALL_OK;
+  bool prefetch_recv_demand = false;
 
   // sent_initial_metadata guards against variable reuse.
   grpc_metadata compression_md;
@@ -1470,20 +1805,32 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
       &call->stream_op_payload;
   stream_op->covered_by_poller = true;
 
-  /* rewrite batch ops into a transport op */
+  /* validate the batch shape in one table-driven pass before mutating any
+     call state */
   for (i = 0; i < nops; i++) {
     op = &ops[i];
     if (op->reserved != NULL) {
       error = GRPC_CALL_ERROR;
       goto done_with_error;
     }
+    if ((size_t)op->op >= GPR_ARRAY_SIZE(g_op_descriptors)) continue;
+    const batch_op_descriptor *desc = &g_op_descriptors[op->op];
+    if (op->flags & ~(call->is_client ? desc->valid_flags_client
+                                      : desc->valid_flags_server)) {
+      error = GRPC_CALL_ERROR_INVALID_FLAGS;
+      goto done_with_error;
+    }
+    error = call->is_client ? desc->client_error : desc->server_error;
+    if (error != GRPC_CALL_OK) {
+      goto done_with_error;
+    }
+  }
+
+  /* rewrite batch ops into a transport op */
+  for (i = 0; i < nops; i++) {
+    op = &ops[i];
     switch (op->op) {
       case GRPC_OP_SEND_INITIAL_METADATA:
-        /* Flag validation: currently allow no flags */
-        if (!are_initial_metadata_flags_valid(op->flags, call->is_client)) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
         if (call->sent_initial_metadata) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
@@ -1538,10 +1885,6 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
             op->flags;
         break;
       case GRPC_OP_SEND_MESSAGE:
-        if (!are_write_flags_valid(op->flags)) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
         if (op->data.send_message.send_message == NULL) {
           error = GRPC_CALL_ERROR_INVALID_MESSAGE;
           goto done_with_error;
@@ -1558,24 +1901,29 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
             op->flags);
         /* If the outgoing buffer is already compressed, mark it as so in the
            flags. These will be picked up by the compression filter and further
-           (wasteful) attempts at compression skipped. */
+           (wasteful) attempts at compression skipped. Refuse the passthrough
+           up front if the algorithm is disabled on this channel or the peer
+           has declared it does not accept it: the bytes would be framed as
+           compressed and be undecodable on the other side. */
         if (op->data.send_message.send_message->data.raw.compression >
             GRPC_COMPRESS_NONE) {
+          const grpc_compression_algorithm calgo =
+              op->data.send_message.send_message->data.raw.compression;
+          const grpc_compression_options copts =
+              grpc_channel_compression_options(call->channel);
+          if (!GPR_BITGET(copts.enabled_algorithms_bitset, calgo) ||
+              (call->encodings_accepted_by_peer !=
+                   (1u << GRPC_COMPRESS_NONE) &&
+               !GPR_BITGET(call->encodings_accepted_by_peer, calgo))) {
+            error = GRPC_CALL_ERROR_INVALID_MESSAGE;
+            goto done_with_error;
+          }
           call->sending_stream.base.flags |= GRPC_WRITE_INTERNAL_COMPRESS;
         }
         stream_op_payload->send_message.send_message =
             &call->sending_stream.base;
         break;
       case GRPC_OP_SEND_CLOSE_FROM_CLIENT:
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
-        if (!call->is_client) {
-          error = GRPC_CALL_ERROR_NOT_ON_SERVER;
-          goto done_with_error;
-        }
         if (call->sent_final_op) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
@@ -1586,15 +1934,6 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
             &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */];
         break;
       case GRPC_OP_SEND_STATUS_FROM_SERVER:
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
-        if (call->is_client) {
-          error = GRPC_CALL_ERROR_NOT_ON_CLIENT;
-          goto done_with_error;
-        }
         if (call->sent_final_op) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
@@ -1648,11 +1987,6 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
             &call->metadata_batch[0 /* is_receiving */][1 /* is_trailing */];
         break;
       case GRPC_OP_RECV_INITIAL_METADATA:
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
         if (call->received_initial_metadata) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
@@ -1666,7 +2000,7 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
             op->data.recv_initial_metadata.recv_initial_metadata;
         grpc_closure_init(&call->receiving_initial_metadata_ready,
                           receiving_initial_metadata_ready, bctl,
-                          grpc_schedule_on_exec_ctx);
+                          grpc_schedule_on_exec_ctx_urgent);
         stream_op->recv_initial_metadata = true;
         stream_op_payload->recv_initial_metadata.recv_initial_metadata =
             &call->metadata_batch[1 /* is_receiving */][0 /* is_trailing */];
@@ -1675,35 +2009,29 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
         num_completion_callbacks_needed++;
         break;
       case GRPC_OP_RECV_MESSAGE:
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
         if (call->receiving_message) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
         }
         call->receiving_message = true;
+        if (call->recv_prefetch_budget > 0) {
+          /* the read-ahead engine owns the transport recv op; this demand
+             is satisfied from its queue once the batch is armed below */
+          prefetch_recv_demand = true;
+          call->receiving_buffer = op->data.recv_message.recv_message;
+          num_completion_callbacks_needed++;
+          break;
+        }
         stream_op->recv_message = true;
         call->receiving_buffer = op->data.recv_message.recv_message;
         stream_op_payload->recv_message.recv_message = &call->receiving_stream;
         grpc_closure_init(&call->receiving_stream_ready, receiving_stream_ready,
-                          bctl, grpc_schedule_on_exec_ctx);
+                          bctl, grpc_schedule_on_exec_ctx_urgent);
         stream_op_payload->recv_message.recv_message_ready =
             &call->receiving_stream_ready;
         num_completion_callbacks_needed++;
         break;
       case GRPC_OP_RECV_STATUS_ON_CLIENT:
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
-        if (!call->is_client) {
-          error = GRPC_CALL_ERROR_NOT_ON_SERVER;
-          goto done_with_error;
-        }
         if (call->requested_final_op) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
@@ -1722,15 +2050,6 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
             &call->final_info.stats.transport_stream_stats;
         break;
       case GRPC_OP_RECV_CLOSE_ON_SERVER:
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
-          error = GRPC_CALL_ERROR_INVALID_FLAGS;
-          goto done_with_error;
-        }
-        if (call->is_client) {
-          error = GRPC_CALL_ERROR_NOT_ON_CLIENT;
-          goto done_with_error;
-        }
         if (call->requested_final_op) {
           error = GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
           goto done_with_error;
@@ -1759,7 +2078,42 @@ static grpc_call_error call_start_batch(grpc_exec_ctx *exec_ctx,
   stream_op->on_complete = &bctl->finish_batch;
   gpr_atm_rel_store(&call->any_ops_sent_atm, 1);
 
-  execute_op(exec_ctx, call, stream_op);
+  if (prefetch_recv_demand) {
+    prefetch_satisfy_demand(exec_ctx, bctl);
+  }
+
+  /* Flat message size limits are enforced here rather than by the
+     message_size filter (which is only present in stacks that carry
+     per-method service config).  Failing the assembled batch through the
+     transport failure path preserves the filter's semantics: the batch
+     completes with RESOURCE_EXHAUSTED and nothing reaches the wire. */
+  if (stream_op->send_message) {
+    const int max_send_size =
+        grpc_channel_get_max_send_message_size(call->channel);
+    if (max_send_size >= 0 &&
+        call->sending_stream.base.length > (size_t)max_send_size) {
+      char *message_string;
+      gpr_asprintf(&message_string, "Sent message larger than max (%u vs. %d)",
+                   call->sending_stream.base.length, max_send_size);
+      grpc_transport_stream_op_batch_finish_with_failure(
+          exec_ctx, stream_op,
+          grpc_error_set_int(
+              GRPC_ERROR_CREATE_FROM_COPIED_STRING(message_string),
+              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_RESOURCE_EXHAUSTED));
+      gpr_free(message_string);
+      goto done;
+    }
+  }
+
+  if (stream_op->send_initial_metadata || stream_op->send_message ||
+      stream_op->send_trailing_metadata || stream_op->recv_initial_metadata ||
+      stream_op->recv_message || stream_op->recv_trailing_metadata ||
+      stream_op->cancel_stream || stream_op->collect_stats) {
+    execute_op(exec_ctx, call, stream_op);
+  } else {
+    /* every op in the batch was absorbed by the read-ahead engine */
+    grpc_closure_sched(exec_ctx, &bctl->finish_batch, GRPC_ERROR_NONE);
+  }
 
 done:
   GPR_TIMER_END("grpc_call_start_batch", 0);
@@ -1782,7 +2136,7 @@ done_with_error:
   if (stream_op->recv_initial_metadata) {
     call->received_initial_metadata = false;
   }
-  if (stream_op->recv_message) {
+  if (stream_op->recv_message || prefetch_recv_demand) {
     call->receiving_message = false;
   }
   if (stream_op->recv_trailing_metadata) {
@@ -1800,6 +2154,7 @@ grpc_call_error grpc_call_start_batch(grpc_call *call, const grpc_op *ops,
       "grpc_call_start_batch(call=%p, ops=%p, nops=%lu, tag=%p, "
       "reserved=%p)",
       5, (call, ops, (unsigned long)nops, tag, reserved));
+  GRPC_API_RING_TRACE(GRPC_API_RING_TRACE_CALL_START_BATCH, call, tag);
 
   if (reserved != NULL) {
     err = GRPC_CALL_ERROR;
@@ -1811,6 +2166,14 @@ grpc_call_error grpc_call_start_batch(grpc_call *call, const grpc_op *ops,
   return err;
 }
 
+grpc_call_error grpc_call_start_batch_internal(grpc_exec_ctx *exec_ctx,
+                                               grpc_call *call,
+                                               const grpc_op *ops, size_t nops,
+                                               void *tag) {
+  GRPC_API_RING_TRACE(GRPC_API_RING_TRACE_CALL_START_BATCH, call, tag);
+  return call_start_batch(exec_ctx, call, ops, nops, tag, 0);
+}
+
 grpc_call_error grpc_call_start_batch_and_execute(grpc_exec_ctx *exec_ctx,
                                                   grpc_call *call,
                                                   const grpc_op *ops,
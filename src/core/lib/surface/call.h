@@ -64,6 +64,10 @@ typedef struct grpc_call_create_args {
   grpc_mdelem *add_initial_metadata;
   size_t add_initial_metadata_count;
 
+  /* if not NULL, the learned arena size estimate for the call's method
+     (owned by the channel, so it outlives the call) */
+  gpr_atm *method_size_estimate;
+
   gpr_timespec send_deadline;
 } grpc_call_create_args;
 
@@ -101,6 +105,13 @@ grpc_call_error grpc_call_start_batch_and_execute(grpc_exec_ctx *exec_ctx,
                                                   size_t nops,
                                                   grpc_closure *closure);
 
+/* As grpc_call_start_batch, but on a caller-provided exec_ctx: completion is
+   delivered to the call's cq against tag as usual */
+grpc_call_error grpc_call_start_batch_internal(grpc_exec_ctx *exec_ctx,
+                                               grpc_call *call,
+                                               const grpc_op *ops, size_t nops,
+                                               void *tag);
+
 /* Given the top call_element, get the call object. */
 grpc_call *grpc_call_from_top_element(grpc_call_element *surface_element);
 
@@ -33,6 +33,7 @@
 
 #include "src/core/lib/surface/channel.h"
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -60,15 +61,28 @@
 typedef struct registered_call {
   grpc_mdelem path;
   grpc_mdelem authority;
+  /* arena size estimate learned from completed calls to this method; zero
+     until the first such call completes */
+  gpr_atm call_size_estimate;
   struct registered_call *next;
 } registered_call;
 
 struct grpc_channel {
   int is_client;
+  bool contiguous_recv_messages;
+  // Flat (non-per-method) message size limits, resolved once from channel
+  // args so that call.c can enforce them inline; -1 means no limit.
+  int max_send_message_size;
+  int max_recv_message_size;
+  /* messages the call layer may read ahead of application demand; 0 off */
+  int recv_message_prefetch;
   grpc_compression_options compression_options;
   grpc_mdelem default_authority;
 
   gpr_atm call_size_estimate;
+  /* single-slot cache of a reset call arena; see
+     grpc_channel_take_call_arena */
+  gpr_atm arena_cache;
 
   gpr_mu registered_call_mu;
   registered_call *registered_calls;
@@ -108,12 +122,19 @@ grpc_channel *grpc_channel_create_with_builder(
   channel->is_client = grpc_channel_stack_type_is_client(channel_stack_type);
   gpr_mu_init(&channel->registered_call_mu);
   channel->registered_calls = NULL;
+  gpr_atm_no_barrier_store(&channel->arena_cache, (gpr_atm)NULL);
 
   gpr_atm_no_barrier_store(
       &channel->call_size_estimate,
       (gpr_atm)CHANNEL_STACK_FROM_CHANNEL(channel)->call_stack_size);
 
   grpc_compression_options_init(&channel->compression_options);
+  channel->max_send_message_size = grpc_channel_args_want_minimal_stack(args)
+                                       ? -1
+                                       : GRPC_DEFAULT_MAX_SEND_MESSAGE_LENGTH;
+  channel->max_recv_message_size = grpc_channel_args_want_minimal_stack(args)
+                                       ? -1
+                                       : GRPC_DEFAULT_MAX_RECV_MESSAGE_LENGTH;
   for (size_t i = 0; i < args->num_args; i++) {
     if (0 == strcmp(args->args[i].key, GRPC_ARG_DEFAULT_AUTHORITY)) {
       if (args->args[i].type != GRPC_ARG_STRING) {
@@ -170,6 +191,24 @@ grpc_channel *grpc_channel_create_with_builder(
       channel->compression_options.enabled_algorithms_bitset =
           (uint32_t)args->args[i].value.integer |
           0x1; /* always support no compression */
+    } else if (0 ==
+               strcmp(args->args[i].key, GRPC_ARG_CONTIGUOUS_RECV_MESSAGES)) {
+      channel->contiguous_recv_messages =
+          grpc_channel_arg_get_bool(&args->args[i], false);
+    } else if (0 ==
+               strcmp(args->args[i].key, GRPC_ARG_MAX_SEND_MESSAGE_LENGTH)) {
+      channel->max_send_message_size = grpc_channel_arg_get_integer(
+          &args->args[i],
+          (grpc_integer_options){channel->max_send_message_size, -1, INT_MAX});
+    } else if (0 == strcmp(args->args[i].key,
+                           GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH)) {
+      channel->max_recv_message_size = grpc_channel_arg_get_integer(
+          &args->args[i],
+          (grpc_integer_options){channel->max_recv_message_size, -1, INT_MAX});
+    } else if (0 ==
+               strcmp(args->args[i].key, GRPC_ARG_RECV_MESSAGE_PREFETCH)) {
+      channel->recv_message_prefetch = grpc_channel_arg_get_integer(
+          &args->args[i], (grpc_integer_options){0, 0, INT_MAX});
     }
   }
 
@@ -195,7 +234,8 @@ grpc_channel *grpc_channel_create(grpc_exec_ctx *exec_ctx, const char *target,
                                           channel_stack_type);
 }
 
-size_t grpc_channel_get_call_size_estimate(grpc_channel *channel) {
+size_t grpc_channel_get_call_size_estimate(grpc_channel *channel,
+                                           gpr_atm *method_estimate) {
 #define ROUND_UP_SIZE 256
   /* We round up our current estimate to the NEXT value of ROUND_UP_SIZE.
      This ensures:
@@ -203,30 +243,70 @@ size_t grpc_channel_get_call_size_estimate(grpc_channel *channel) {
          (which is common) - which tends to help most allocators reuse memory
       2. a small amount of allowed growth over the estimate without hitting
          the arena size doubling case, reducing overall memory usage */
-  return ((size_t)gpr_atm_no_barrier_load(&channel->call_size_estimate) +
-          2 * ROUND_UP_SIZE) &
-         ~(size_t)(ROUND_UP_SIZE - 1);
+  size_t estimate = 0;
+  if (method_estimate != NULL) {
+    /* per-method estimates start at zero: fall back to the channel-wide
+       estimate until the first call to this method completes */
+    estimate = (size_t)gpr_atm_no_barrier_load(method_estimate);
+  }
+  if (estimate == 0) {
+    estimate = (size_t)gpr_atm_no_barrier_load(&channel->call_size_estimate);
+  }
+  return (estimate + 2 * ROUND_UP_SIZE) & ~(size_t)(ROUND_UP_SIZE - 1);
 }
 
-void grpc_channel_update_call_size_estimate(grpc_channel *channel,
-                                            size_t size) {
-  size_t cur = (size_t)gpr_atm_no_barrier_load(&channel->call_size_estimate);
+static void update_call_size_estimate(gpr_atm *estimate, size_t size) {
+  size_t cur = (size_t)gpr_atm_no_barrier_load(estimate);
   if (cur < size) {
     /* size grew: update estimate */
-    gpr_atm_no_barrier_cas(&channel->call_size_estimate, (gpr_atm)cur,
-                           (gpr_atm)size);
+    gpr_atm_no_barrier_cas(estimate, (gpr_atm)cur, (gpr_atm)size);
     /* if we lose: never mind, something else will likely update soon enough */
   } else if (cur == size) {
     /* no change: holding pattern */
   } else if (cur > 0) {
     /* size shrank: decrease estimate */
     gpr_atm_no_barrier_cas(
-        &channel->call_size_estimate, (gpr_atm)cur,
+        estimate, (gpr_atm)cur,
         (gpr_atm)(GPR_MIN(cur - 1, (255 * cur + size) / 256)));
     /* if we lose: never mind, something else will likely update soon enough */
   }
 }
 
+void grpc_channel_update_call_size_estimate(grpc_channel *channel,
+                                            gpr_atm *method_estimate,
+                                            size_t size) {
+  if (method_estimate != NULL) {
+    update_call_size_estimate(method_estimate, size);
+  }
+  /* the channel-wide estimate still sees all traffic, so unregistered (and
+     first-time registered) calls get a sensible starting point */
+  update_call_size_estimate(&channel->call_size_estimate, size);
+}
+
+gpr_arena *grpc_channel_take_call_arena(grpc_channel *channel,
+                                        size_t initial_size) {
+  gpr_arena *arena = (gpr_arena *)gpr_atm_full_xchg(&channel->arena_cache, 0);
+  if (arena != NULL && gpr_arena_initial_capacity(arena) < initial_size) {
+    /* the size estimate outgrew the cached arena: let it go, so the next
+       return repopulates the cache at the new size */
+    gpr_arena_destroy(arena);
+    arena = NULL;
+  }
+  return arena != NULL ? arena : gpr_arena_create(initial_size);
+}
+
+size_t grpc_channel_return_call_arena(grpc_channel *channel,
+                                      gpr_arena *arena) {
+  size_t allocated = gpr_arena_reset(arena);
+  /* release ordering publishes the re-zeroed memory to whichever thread
+     takes the arena next; concurrent calls simply fall through to the
+     allocator when the slot is occupied */
+  if (!gpr_atm_rel_cas(&channel->arena_cache, 0, (gpr_atm)arena)) {
+    gpr_arena_destroy(arena);
+  }
+  return allocated;
+}
+
 char *grpc_channel_get_target(grpc_channel *channel) {
   GRPC_API_TRACE("grpc_channel_get_target(channel=%p)", 1, (channel));
   return gpr_strdup(channel->target);
@@ -245,7 +325,8 @@ static grpc_call *grpc_channel_create_call_internal(
     grpc_exec_ctx *exec_ctx, grpc_channel *channel, grpc_call *parent_call,
     uint32_t propagation_mask, grpc_completion_queue *cq,
     grpc_pollset_set *pollset_set_alternative, grpc_mdelem path_mdelem,
-    grpc_mdelem authority_mdelem, gpr_timespec deadline) {
+    grpc_mdelem authority_mdelem, gpr_atm *method_size_estimate,
+    gpr_timespec deadline) {
   grpc_mdelem send_metadata[2];
   size_t num_metadata = 0;
 
@@ -269,6 +350,7 @@ static grpc_call *grpc_channel_create_call_internal(
   args.server_transport_data = NULL;
   args.add_initial_metadata = send_metadata;
   args.add_initial_metadata_count = num_metadata;
+  args.method_size_estimate = method_size_estimate;
   args.send_deadline = deadline;
 
   grpc_call *call;
@@ -276,6 +358,24 @@ static grpc_call *grpc_channel_create_call_internal(
   return call;
 }
 
+grpc_call *grpc_channel_create_cq_call(grpc_exec_ctx *exec_ctx,
+                                       grpc_channel *channel,
+                                       grpc_call *parent_call,
+                                       uint32_t propagation_mask,
+                                       grpc_completion_queue *cq,
+                                       grpc_slice method,
+                                       const grpc_slice *host,
+                                       gpr_timespec deadline) {
+  return grpc_channel_create_call_internal(
+      exec_ctx, channel, parent_call, propagation_mask, cq, NULL,
+      grpc_mdelem_from_slices(exec_ctx, GRPC_MDSTR_PATH,
+                              grpc_slice_ref_internal(method)),
+      host != NULL ? grpc_mdelem_from_slices(exec_ctx, GRPC_MDSTR_AUTHORITY,
+                                             grpc_slice_ref_internal(*host))
+                   : GRPC_MDNULL,
+      NULL, deadline);
+}
+
 grpc_call *grpc_channel_create_call(grpc_channel *channel,
                                     grpc_call *parent_call,
                                     uint32_t propagation_mask,
@@ -284,18 +384,44 @@ grpc_call *grpc_channel_create_call(grpc_channel *channel,
                                     gpr_timespec deadline, void *reserved) {
   GPR_ASSERT(!reserved);
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
-  grpc_call *call = grpc_channel_create_call_internal(
-      &exec_ctx, channel, parent_call, propagation_mask, cq, NULL,
-      grpc_mdelem_from_slices(&exec_ctx, GRPC_MDSTR_PATH,
-                              grpc_slice_ref_internal(method)),
-      host != NULL ? grpc_mdelem_from_slices(&exec_ctx, GRPC_MDSTR_AUTHORITY,
-                                             grpc_slice_ref_internal(*host))
-                   : GRPC_MDNULL,
-      deadline);
+  grpc_call *call =
+      grpc_channel_create_cq_call(&exec_ctx, channel, parent_call,
+                                  propagation_mask, cq, method, host, deadline);
   grpc_exec_ctx_finish(&exec_ctx);
   return call;
 }
 
+grpc_call_error grpc_start_scatter_calls(grpc_completion_queue *cq,
+                                         grpc_scatter_call_entry *entries,
+                                         size_t num_entries, void *reserved) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_call_error err = GRPC_CALL_OK;
+  GRPC_API_TRACE(
+      "grpc_start_scatter_calls(cq=%p, entries=%p, num_entries=%lu, "
+      "reserved=%p)",
+      4, (cq, entries, (unsigned long)num_entries, reserved));
+  if (reserved != NULL) {
+    err = GRPC_CALL_ERROR;
+    num_entries = 0;
+  }
+  for (size_t i = 0; i < num_entries; i++) {
+    grpc_scatter_call_entry *entry = &entries[i];
+    entry->call = grpc_channel_create_cq_call(
+        &exec_ctx, entry->channel, entry->parent_call, entry->propagation_mask,
+        cq, entry->method, entry->host, entry->deadline);
+    err = grpc_call_start_batch_internal(&exec_ctx, entry->call, entry->ops,
+                                         entry->num_ops, entry->tag);
+    if (err != GRPC_CALL_OK) {
+      /* earlier entries are already in flight; later entries were never
+         reached */
+      for (size_t j = i + 1; j < num_entries; j++) entries[j].call = NULL;
+      break;
+    }
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  return err;
+}
+
 grpc_call *grpc_channel_create_pollset_set_call(
     grpc_exec_ctx *exec_ctx, grpc_channel *channel, grpc_call *parent_call,
     uint32_t propagation_mask, grpc_pollset_set *pollset_set, grpc_slice method,
@@ -308,7 +434,7 @@ grpc_call *grpc_channel_create_pollset_set_call(
       host != NULL ? grpc_mdelem_from_slices(exec_ctx, GRPC_MDSTR_AUTHORITY,
                                              grpc_slice_ref_internal(*host))
                    : GRPC_MDNULL,
-      deadline);
+      NULL, deadline);
 }
 
 void *grpc_channel_register_call(grpc_channel *channel, const char *method,
@@ -328,6 +454,7 @@ void *grpc_channel_register_call(grpc_channel *channel, const char *method,
                  &exec_ctx, GRPC_MDSTR_AUTHORITY,
                  grpc_slice_intern(grpc_slice_from_static_string(host)))
            : GRPC_MDNULL;
+  gpr_atm_no_barrier_store(&rc->call_size_estimate, 0);
   gpr_mu_lock(&channel->registered_call_mu);
   rc->next = channel->registered_calls;
   channel->registered_calls = rc;
@@ -355,7 +482,8 @@ grpc_call *grpc_channel_create_registered_call(
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
   grpc_call *call = grpc_channel_create_call_internal(
       &exec_ctx, channel, parent_call, propagation_mask, completion_queue, NULL,
-      GRPC_MDELEM_REF(rc->path), GRPC_MDELEM_REF(rc->authority), deadline);
+      GRPC_MDELEM_REF(rc->path), GRPC_MDELEM_REF(rc->authority),
+      &rc->call_size_estimate, deadline);
   grpc_exec_ctx_finish(&exec_ctx);
   return call;
 }
@@ -388,6 +516,11 @@ static void destroy_channel(grpc_exec_ctx *exec_ctx, void *arg,
     gpr_free(rc);
   }
   GRPC_MDELEM_UNREF(exec_ctx, channel->default_authority);
+  gpr_arena *cached_arena =
+      (gpr_arena *)gpr_atm_full_xchg(&channel->arena_cache, 0);
+  if (cached_arena != NULL) {
+    gpr_arena_destroy(cached_arena);
+  }
   gpr_mu_destroy(&channel->registered_call_mu);
   gpr_free(channel->target);
   gpr_free(channel);
@@ -417,6 +550,22 @@ grpc_compression_options grpc_channel_compression_options(
   return channel->compression_options;
 }
 
+bool grpc_channel_contiguous_recv_messages(const grpc_channel *channel) {
+  return channel->contiguous_recv_messages;
+}
+
+int grpc_channel_get_max_send_message_size(const grpc_channel *channel) {
+  return channel->max_send_message_size;
+}
+
+int grpc_channel_get_max_recv_message_size(const grpc_channel *channel) {
+  return channel->max_recv_message_size;
+}
+
+int grpc_channel_get_recv_message_prefetch(const grpc_channel *channel) {
+  return channel->recv_message_prefetch;
+}
+
 grpc_mdelem grpc_channel_get_reffed_status_elem(grpc_exec_ctx *exec_ctx,
                                                 grpc_channel *channel, int i) {
   char tmp[GPR_LTOA_MIN_BUFSIZE];
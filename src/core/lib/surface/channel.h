@@ -36,6 +36,7 @@
 
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/support/arena.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 grpc_channel *grpc_channel_create(grpc_exec_ctx *exec_ctx, const char *target,
@@ -60,6 +61,17 @@ grpc_call *grpc_channel_create_pollset_set_call(
     uint32_t propagation_mask, grpc_pollset_set *pollset_set, grpc_slice method,
     const grpc_slice *host, gpr_timespec deadline, void *reserved);
 
+/** As grpc_channel_create_call, but on a caller-provided exec_ctx: lets
+    callers creating many calls at once share one context and one flush */
+grpc_call *grpc_channel_create_cq_call(grpc_exec_ctx *exec_ctx,
+                                       grpc_channel *channel,
+                                       grpc_call *parent_call,
+                                       uint32_t propagation_mask,
+                                       grpc_completion_queue *cq,
+                                       grpc_slice method,
+                                       const grpc_slice *host,
+                                       gpr_timespec deadline);
+
 /** Get a (borrowed) pointer to this channels underlying channel stack */
 grpc_channel_stack *grpc_channel_get_channel_stack(grpc_channel *channel);
 
@@ -71,8 +83,23 @@ grpc_mdelem grpc_channel_get_reffed_status_elem(grpc_exec_ctx *exec_ctx,
                                                 grpc_channel *channel,
                                                 int status_code);
 
-size_t grpc_channel_get_call_size_estimate(grpc_channel *channel);
-void grpc_channel_update_call_size_estimate(grpc_channel *channel, size_t size);
+/* \a method_estimate, if non-NULL, points at the learned per-method arena
+   size estimate for the call (owned by the channel, so it outlives any call);
+   it takes precedence over the channel-wide estimate once populated */
+size_t grpc_channel_get_call_size_estimate(grpc_channel *channel,
+                                           gpr_atm *method_estimate);
+void grpc_channel_update_call_size_estimate(grpc_channel *channel,
+                                            gpr_atm *method_estimate,
+                                            size_t size);
+
+/* Single-slot cache recycling call arenas across sequential calls on a
+   channel: take returns a reset arena of at least \a initial_size bytes
+   (creating a fresh one on a cache miss or if the estimate outgrew the
+   cached arena); return resets the arena and offers it back, reporting
+   the number of bytes that were allocated from it */
+gpr_arena *grpc_channel_take_call_arena(grpc_channel *channel,
+                                        size_t initial_size);
+size_t grpc_channel_return_call_arena(grpc_channel *channel, gpr_arena *arena);
 
 #ifdef GRPC_STREAM_REFCOUNT_DEBUG
 void grpc_channel_internal_ref(grpc_channel *channel, const char *reason);
@@ -96,4 +123,17 @@ void grpc_channel_internal_unref(grpc_exec_ctx *exec_ctx,
 grpc_compression_options grpc_channel_compression_options(
     const grpc_channel *channel);
 
+/** Was GRPC_ARG_CONTIGUOUS_RECV_MESSAGES set on this channel? */
+bool grpc_channel_contiguous_recv_messages(const grpc_channel *channel);
+
+/** Flat message size limits from channel args (-1 means no limit).
+    Per-method limits from service config are enforced separately by the
+    message_size filter. */
+int grpc_channel_get_max_send_message_size(const grpc_channel *channel);
+int grpc_channel_get_max_recv_message_size(const grpc_channel *channel);
+
+/** Messages the call layer may read ahead of application demand
+    (GRPC_ARG_RECV_MESSAGE_PREFETCH); 0 disables read-ahead. */
+int grpc_channel_get_recv_message_prefetch(const grpc_channel *channel);
+
 #endif /* GRPC_CORE_LIB_SURFACE_CHANNEL_H */
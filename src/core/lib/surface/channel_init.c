@@ -36,6 +36,8 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/useful.h>
 
+#include "src/core/lib/surface/init.h"
+
 typedef struct stage_slot {
   grpc_channel_init_stage fn;
   void *arg;
@@ -49,7 +51,20 @@ typedef struct stage_slots {
   size_t cap_slots;
 } stage_slots;
 
+typedef struct fused_slot {
+  const grpc_channel_filter *const *filters;
+  size_t num_filters;
+  const grpc_channel_filter *fused;
+} fused_slot;
+
+typedef struct fused_slots {
+  fused_slot *slots;
+  size_t num_slots;
+  size_t cap_slots;
+} fused_slots;
+
 static stage_slots g_slots[GRPC_NUM_CHANNEL_STACK_TYPES];
+static fused_slots g_fused[GRPC_NUM_CHANNEL_STACK_TYPES];
 static bool g_finalized;
 
 void grpc_channel_init_init(void) {
@@ -57,6 +72,9 @@ void grpc_channel_init_init(void) {
     g_slots[i].slots = NULL;
     g_slots[i].num_slots = 0;
     g_slots[i].cap_slots = 0;
+    g_fused[i].slots = NULL;
+    g_fused[i].num_slots = 0;
+    g_fused[i].cap_slots = 0;
   }
   g_finalized = false;
 }
@@ -79,6 +97,23 @@ void grpc_channel_init_register_stage(grpc_channel_stack_type type,
   s->arg = stage_arg;
 }
 
+void grpc_channel_init_register_fused_stack(
+    grpc_channel_stack_type type, const grpc_channel_filter *const *filters,
+    size_t num_filters, const grpc_channel_filter *fused_filter) {
+  GPR_ASSERT(!g_finalized);
+  GPR_ASSERT(num_filters > 0);
+  if (g_fused[type].cap_slots == g_fused[type].num_slots) {
+    g_fused[type].cap_slots = GPR_MAX(8, 3 * g_fused[type].cap_slots / 2);
+    g_fused[type].slots =
+        gpr_realloc(g_fused[type].slots,
+                    g_fused[type].cap_slots * sizeof(*g_fused[type].slots));
+  }
+  fused_slot *s = &g_fused[type].slots[g_fused[type].num_slots++];
+  s->filters = filters;
+  s->num_filters = num_filters;
+  s->fused = fused_filter;
+}
+
 static int compare_slots(const void *a, const void *b) {
   const stage_slot *sa = a;
   const stage_slot *sb = b;
@@ -101,12 +136,17 @@ void grpc_channel_init_shutdown(void) {
   for (int i = 0; i < GRPC_NUM_CHANNEL_STACK_TYPES; i++) {
     gpr_free(g_slots[i].slots);
     g_slots[i].slots = (void *)(uintptr_t)0xdeadbeef;
+    gpr_free(g_fused[i].slots);
+    g_fused[i].slots = (void *)(uintptr_t)0xdeadbeef;
   }
 }
 
 bool grpc_channel_init_create_stack(grpc_exec_ctx *exec_ctx,
                                     grpc_channel_stack_builder *builder,
                                     grpc_channel_stack_type type) {
+  /* under GRPC_LAZY_PLUGIN_INIT the plugin stage (and hence finalization)
+     is deferred to this point; a no-op once it has run */
+  grpc_maybe_init_plugins();
   GPR_ASSERT(g_finalized);
 
   grpc_channel_stack_builder_set_name(builder,
@@ -119,5 +159,20 @@ bool grpc_channel_init_create_stack(grpc_exec_ctx *exec_ctx,
     }
   }
 
+  /* with the final filter list known, substitute a registered fused stack
+     if one matches exactly; first registered match wins */
+  for (size_t i = 0; i < g_fused[type].num_slots; i++) {
+    const fused_slot *slot = &g_fused[type].slots[i];
+    if (grpc_channel_stack_builder_fuse_filters(
+            builder, slot->filters, slot->num_filters, slot->fused)) {
+      if (GRPC_TRACER_ON(grpc_trace_channel_stack_builder)) {
+        gpr_log(GPR_DEBUG, "%s: fused %" PRIuPTR " filters into '%s'",
+                grpc_channel_stack_type_string(type), slot->num_filters,
+                slot->fused->name);
+      }
+      break;
+    }
+  }
+
   return true;
 }
@@ -68,6 +68,19 @@ void grpc_channel_init_register_stage(grpc_channel_stack_type type,
                                       grpc_channel_init_stage stage_fn,
                                       void *stage_arg);
 
+/// Register a fused replacement for a known filter configuration.
+/// After all stages have run for a stack of \a type, if the resulting filter
+/// list is exactly \a filters (see grpc_channel_stack_builder_fuse_filters
+/// for the precise matching rule), the whole run is replaced by the single
+/// \a fused_filter - a hand-written filter combining the behavior of the
+/// sequence into one element, saving a vtable hop and a call-data allocation
+/// per fused filter on every call. \a filters must point to storage that
+/// outlives the process (e.g. a static array). Fusions are tried in
+/// registration order; the first match wins.
+void grpc_channel_init_register_fused_stack(
+    grpc_channel_stack_type type, const grpc_channel_filter *const *filters,
+    size_t num_filters, const grpc_channel_filter *fused_filter);
+
 /// Finalize registration. No more calls to grpc_channel_init_register_stage are
 /// allowed.
 void grpc_channel_init_finalize(void);
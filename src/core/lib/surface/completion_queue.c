@@ -40,6 +40,8 @@
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/time.h>
+#include <grpc/support/tls.h>
+#include <grpc/support/useful.h>
 
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/timer.h"
@@ -55,6 +57,24 @@ grpc_tracer_flag grpc_trace_operation_failures = GRPC_TRACER_INITIALIZER(false);
 grpc_tracer_flag grpc_trace_pending_tags = GRPC_TRACER_INITIALIZER(false);
 #endif
 
+/* A thread-local cache of a single completion: armed by cq_next around the
+   poller, so that a completion produced by a closure running on the polling
+   thread itself is handed straight back to that thread instead of going
+   through the event queue, the cq lock and a pollset kick.
+   Only used for completion queues of type GRPC_CQ_NEXT */
+GPR_TLS_DECL(g_cached_event);
+GPR_TLS_DECL(g_cached_cq);
+
+void grpc_cq_global_init(void) {
+  gpr_tls_init(&g_cached_event);
+  gpr_tls_init(&g_cached_cq);
+}
+
+void grpc_cq_global_shutdown(void) {
+  gpr_tls_destroy(&g_cached_event);
+  gpr_tls_destroy(&g_cached_cq);
+}
+
 typedef struct {
   grpc_pollset_worker **worker;
   void *tag;
@@ -228,8 +248,9 @@ typedef struct grpc_cq_event_queue {
 
   /* A lazy counter of number of items in the queue. This is NOT atomically
      incremented/decremented along with push/pop operations and hence is only
-     eventually consistent */
-  gpr_atm num_queue_items;
+     eventually consistent. Padded so producer updates do not thrash the line
+     holding the queue head/tail. */
+  gpr_atm_padded num_queue_items;
 } grpc_cq_event_queue;
 
 /* TODO: sreek Refactor this based on the completion_type. Put completion-type
@@ -252,8 +273,9 @@ typedef struct cq_data {
   gpr_refcount owning_refs;
 
   /** Counter of how many things have ever been queued on this completion queue
-      useful for avoiding locks to check the queue */
-  gpr_atm things_queued_ever;
+      useful for avoiding locks to check the queue. Padded: bumped on every
+      completion while pollers spin re-reading it. */
+  gpr_atm_padded things_queued_ever;
 
   /** 0 initially, 1 once we've begun shutting down */
   gpr_atm shutdown;
@@ -334,14 +356,20 @@ static const cq_vtable g_cq_vtable[] = {
 grpc_tracer_flag grpc_cq_pluck_trace = GRPC_TRACER_INITIALIZER(true);
 grpc_tracer_flag grpc_cq_event_timeout_trace = GRPC_TRACER_INITIALIZER(true);
 
-#define GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, event)    \
-  if (GRPC_TRACER_ON(grpc_api_trace) &&                 \
-      (GRPC_TRACER_ON(grpc_cq_pluck_trace) ||           \
-       (event)->type != GRPC_QUEUE_TIMEOUT)) {          \
-    char *_ev = grpc_event_string(event);               \
-    gpr_log(GPR_INFO, "RETURN_EVENT[%p]: %s", cq, _ev); \
-    gpr_free(_ev);                                      \
-  }
+#define GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, event)             \
+  do {                                                           \
+    if ((event)->type != GRPC_QUEUE_TIMEOUT) {                   \
+      GRPC_API_RING_TRACE(GRPC_API_RING_TRACE_CQ_RETURN_EVENT,   \
+                          (cq), (event)->tag);                   \
+    }                                                            \
+    if (GRPC_TRACER_ON(grpc_api_trace) &&                        \
+        (GRPC_TRACER_ON(grpc_cq_pluck_trace) ||                  \
+         (event)->type != GRPC_QUEUE_TIMEOUT)) {                 \
+      char *_ev = grpc_event_string(event);                      \
+      gpr_log(GPR_INFO, "RETURN_EVENT[%p]: %s", cq, _ev);        \
+      gpr_free(_ev);                                             \
+    }                                                            \
+  } while (0)
 
 static void on_pollset_shutdown_done(grpc_exec_ctx *exec_ctx, void *cc,
                                      grpc_error *error);
@@ -349,7 +377,7 @@ static void on_pollset_shutdown_done(grpc_exec_ctx *exec_ctx, void *cc,
 static void cq_event_queue_init(grpc_cq_event_queue *q) {
   gpr_mpscq_init(&q->queue);
   q->queue_lock = GPR_SPINLOCK_INITIALIZER;
-  gpr_atm_no_barrier_store(&q->num_queue_items, 0);
+  gpr_atm_no_barrier_store(&q->num_queue_items.counter, 0);
 }
 
 static void cq_event_queue_destroy(grpc_cq_event_queue *q) {
@@ -358,7 +386,7 @@ static void cq_event_queue_destroy(grpc_cq_event_queue *q) {
 
 static void cq_event_queue_push(grpc_cq_event_queue *q, grpc_cq_completion *c) {
   gpr_mpscq_push(&q->queue, (gpr_mpscq_node *)c);
-  gpr_atm_no_barrier_fetch_add(&q->num_queue_items, 1);
+  gpr_atm_no_barrier_fetch_add(&q->num_queue_items.counter, 1);
 }
 
 static grpc_cq_completion *cq_event_queue_pop(grpc_cq_event_queue *q) {
@@ -369,16 +397,40 @@ static grpc_cq_completion *cq_event_queue_pop(grpc_cq_event_queue *q) {
   }
 
   if (c) {
-    gpr_atm_no_barrier_fetch_add(&q->num_queue_items, -1);
+    gpr_atm_no_barrier_fetch_add(&q->num_queue_items.counter, -1);
   }
 
   return c;
 }
 
+/* Pop up to 'max' completions under a single acquisition of the consumer
+   spinlock. Returns the number of completions written to 'out'. May return
+   fewer than are actually queued (including 0) if the queue is contended or
+   in a transient inconsistent state; as with cq_event_queue_pop() that only
+   affects tail latency, not correctness */
+static size_t cq_event_queue_pop_batch(grpc_cq_event_queue *q,
+                                       grpc_cq_completion **out, size_t max) {
+  size_t n = 0;
+  if (gpr_spinlock_trylock(&q->queue_lock)) {
+    while (n < max) {
+      grpc_cq_completion *c = (grpc_cq_completion *)gpr_mpscq_pop(&q->queue);
+      if (c == NULL) break;
+      out[n++] = c;
+    }
+    gpr_spinlock_unlock(&q->queue_lock);
+  }
+
+  if (n > 0) {
+    gpr_atm_no_barrier_fetch_add(&q->num_queue_items.counter, -(gpr_atm)n);
+  }
+
+  return n;
+}
+
 /* Note: The counter is not incremented/decremented atomically with push/pop.
  * The count is only eventually consistent */
 static long cq_event_queue_num_items(grpc_cq_event_queue *q) {
-  return (long)gpr_atm_no_barrier_load(&q->num_queue_items);
+  return (long)gpr_atm_no_barrier_load(&q->num_queue_items.counter);
 }
 
 static size_t cq_size(grpc_completion_queue *cc) {
@@ -427,7 +479,7 @@ grpc_completion_queue *grpc_completion_queue_create_internal(
   cqd->is_server_cq = 0;
   cqd->num_pluckers = 0;
   cqd->num_polls = 0;
-  gpr_atm_no_barrier_store(&cqd->things_queued_ever, 0);
+  gpr_atm_no_barrier_store(&cqd->things_queued_ever.counter, 0);
 #ifndef NDEBUG
   cqd->outstanding_tag_count = 0;
 #endif
@@ -512,6 +564,7 @@ static void cq_begin_op(grpc_completion_queue *cc, void *tag) {
 }
 
 void grpc_cq_begin_op(grpc_completion_queue *cc, void *tag) {
+  GRPC_API_RING_TRACE(GRPC_API_RING_TRACE_CQ_BEGIN_OP, cc, tag);
   cc->vtable->begin_op(cc, tag);
 }
 
@@ -554,6 +607,7 @@ static void cq_end_op_for_next(grpc_exec_ctx *exec_ctx,
                                void *done_arg, grpc_cq_completion *storage) {
   GPR_TIMER_BEGIN("cq_end_op_for_next", 0);
 
+  GRPC_API_RING_TRACE(GRPC_API_RING_TRACE_CQ_END_OP, cc, tag);
   if (GRPC_TRACER_ON(grpc_api_trace) ||
       (GRPC_TRACER_ON(grpc_trace_operation_failures) &&
        error != GRPC_ERROR_NONE)) {
@@ -578,26 +632,39 @@ static void cq_end_op_for_next(grpc_exec_ctx *exec_ctx,
 
   cq_check_tag(cc, tag, true); /* Used in debug builds only */
 
-  /* Add the completion to the queue */
-  cq_event_queue_push(&cqd->queue, storage);
-  gpr_atm_no_barrier_fetch_add(&cqd->things_queued_ever, 1);
+  if ((grpc_completion_queue *)gpr_tls_get(&g_cached_cq) == cc &&
+      (grpc_cq_completion *)gpr_tls_get(&g_cached_event) == NULL) {
+    /* this thread is the one polling in cq_next: hand the completion straight
+       back to it - no queue push, no kick */
+    gpr_tls_set(&g_cached_event, (intptr_t)storage);
+    if (gpr_unref(&cqd->pending_events)) {
+      gpr_mu_lock(cqd->mu);
+      cq_finish_shutdown(exec_ctx, cc);
+      gpr_mu_unlock(cqd->mu);
+    }
+  } else {
+    /* Add the completion to the queue */
+    cq_event_queue_push(&cqd->queue, storage);
+    gpr_atm_no_barrier_fetch_add(&cqd->things_queued_ever.counter, 1);
 
-  gpr_mu_lock(cqd->mu);
+    gpr_mu_lock(cqd->mu);
 
-  int shutdown = gpr_unref(&cqd->pending_events);
-  if (!shutdown) {
-    grpc_error *kick_error = cc->poller_vtable->kick(POLLSET_FROM_CQ(cc), NULL);
-    gpr_mu_unlock(cqd->mu);
+    int shutdown = gpr_unref(&cqd->pending_events);
+    if (!shutdown) {
+      grpc_error *kick_error =
+          cc->poller_vtable->kick(POLLSET_FROM_CQ(cc), NULL);
+      gpr_mu_unlock(cqd->mu);
 
-    if (kick_error != GRPC_ERROR_NONE) {
-      const char *msg = grpc_error_string(kick_error);
-      gpr_log(GPR_ERROR, "Kick failed: %s", msg);
+      if (kick_error != GRPC_ERROR_NONE) {
+        const char *msg = grpc_error_string(kick_error);
+        gpr_log(GPR_ERROR, "Kick failed: %s", msg);
 
-      GRPC_ERROR_UNREF(kick_error);
+        GRPC_ERROR_UNREF(kick_error);
+      }
+    } else {
+      cq_finish_shutdown(exec_ctx, cc);
+      gpr_mu_unlock(cqd->mu);
     }
-  } else {
-    cq_finish_shutdown(exec_ctx, cc);
-    gpr_mu_unlock(cqd->mu);
   }
 
   GPR_TIMER_END("cq_end_op_for_next", 0);
@@ -619,6 +686,7 @@ static void cq_end_op_for_pluck(grpc_exec_ctx *exec_ctx,
 
   GPR_TIMER_BEGIN("cq_end_op_for_pluck", 0);
 
+  GRPC_API_RING_TRACE(GRPC_API_RING_TRACE_CQ_END_OP, cc, tag);
   if (GRPC_TRACER_ON(grpc_api_trace) ||
       (GRPC_TRACER_ON(grpc_trace_operation_failures) &&
        error != GRPC_ERROR_NONE)) {
@@ -642,7 +710,7 @@ static void cq_end_op_for_pluck(grpc_exec_ctx *exec_ctx,
   cq_check_tag(cc, tag, false); /* Used in debug builds only */
 
   /* Add to the list of completions */
-  gpr_atm_no_barrier_fetch_add(&cqd->things_queued_ever, 1);
+  gpr_atm_no_barrier_fetch_add(&cqd->things_queued_ever.counter, 1);
   cqd->completed_tail->next =
       ((uintptr_t)storage) | (1u & (uintptr_t)cqd->completed_tail->next);
   cqd->completed_tail = storage;
@@ -702,11 +770,11 @@ static bool cq_is_next_finished(grpc_exec_ctx *exec_ctx, void *arg) {
   GPR_ASSERT(a->stolen_completion == NULL);
 
   gpr_atm current_last_seen_things_queued_ever =
-      gpr_atm_no_barrier_load(&cqd->things_queued_ever);
+      gpr_atm_no_barrier_load(&cqd->things_queued_ever.counter);
 
   if (current_last_seen_things_queued_ever != a->last_seen_things_queued_ever) {
     a->last_seen_things_queued_ever =
-        gpr_atm_no_barrier_load(&cqd->things_queued_ever);
+        gpr_atm_no_barrier_load(&cqd->things_queued_ever.counter);
 
     /* Pop a cq_completion from the queue. Returns NULL if the queue is empty
      * might return NULL in some cases even if the queue is not empty; but that
@@ -772,7 +840,7 @@ static grpc_event cq_next(grpc_completion_queue *cc, gpr_timespec deadline,
 
   cq_is_finished_arg is_finished_arg = {
       .last_seen_things_queued_ever =
-          gpr_atm_no_barrier_load(&cqd->things_queued_ever),
+          gpr_atm_no_barrier_load(&cqd->things_queued_ever.counter),
       .cq = cc,
       .deadline = deadline,
       .stolen_completion = NULL,
@@ -838,6 +906,15 @@ static grpc_event cq_next(grpc_completion_queue *cc, gpr_timespec deadline,
       break;
     }
 
+    /* Arm the thread-local completion cache (unless some enclosing call on
+       this thread armed it already): closures run by the poller on this
+       thread hand their completion straight back to us */
+    bool cache_armed = gpr_tls_get(&g_cached_cq) == 0;
+    if (cache_armed) {
+      gpr_tls_set(&g_cached_cq, (intptr_t)cc);
+      gpr_tls_set(&g_cached_event, (intptr_t)0);
+    }
+
     /* The main polling work happens in grpc_pollset_work */
     gpr_mu_lock(cqd->mu);
     cqd->num_polls++;
@@ -845,14 +922,31 @@ static grpc_event cq_next(grpc_completion_queue *cc, gpr_timespec deadline,
                                               NULL, now, iteration_deadline);
     gpr_mu_unlock(cqd->mu);
 
+    grpc_cq_completion *cached = NULL;
+    if (cache_armed) {
+      cached = (grpc_cq_completion *)gpr_tls_get(&g_cached_event);
+      gpr_tls_set(&g_cached_cq, (intptr_t)0);
+      gpr_tls_set(&g_cached_event, (intptr_t)0);
+    }
+
     if (err != GRPC_ERROR_NONE) {
       const char *msg = grpc_error_string(err);
       gpr_log(GPR_ERROR, "Completion queue next failed: %s", msg);
 
       GRPC_ERROR_UNREF(err);
-      memset(&ret, 0, sizeof(ret));
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      dump_pending_tags(cc);
+      if (cached == NULL) {
+        memset(&ret, 0, sizeof(ret));
+        ret.type = GRPC_QUEUE_TIMEOUT;
+        dump_pending_tags(cc);
+        break;
+      }
+    }
+
+    if (cached != NULL) {
+      ret.type = GRPC_OP_COMPLETE;
+      ret.success = cached->next & 1u;
+      ret.tag = cached->tag;
+      cached->done(&exec_ctx, cached->done_arg, cached);
       break;
     }
     is_finished_arg.first_loop = false;
@@ -873,6 +967,57 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue *cc,
   return cc->vtable->next(cc, deadline, reserved);
 }
 
+size_t grpc_completion_queue_next_batch(grpc_completion_queue *cc,
+                                        grpc_event *events, size_t max_events,
+                                        gpr_timespec deadline, void *reserved) {
+  GPR_ASSERT(max_events > 0);
+  GPR_ASSERT(cc->vtable->cq_completion_type == GRPC_CQ_NEXT);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch(cc=%p, events=%p, "
+      "max_events=%" PRIuPTR
+      ", "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7, (cc, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+          (int)deadline.clock_type, reserved));
+
+  /* Wait for the first event exactly as grpc_completion_queue_next would */
+  events[0] = cc->vtable->next(cc, deadline, reserved);
+  size_t count = 1;
+  if (events[0].type != GRPC_OP_COMPLETE || max_events == 1) {
+    return count;
+  }
+
+  /* Drain whatever else is already sitting in the event queue: one spinlock
+     acquisition per chunk and no further pollset interaction */
+  cq_data *cqd = &cc->data;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_cq_completion *chunk[64];
+  while (count < max_events) {
+    size_t want = max_events - count;
+    if (want > GPR_ARRAY_SIZE(chunk)) {
+      want = GPR_ARRAY_SIZE(chunk);
+    }
+    size_t got = cq_event_queue_pop_batch(&cqd->queue, chunk, want);
+    if (got == 0) break;
+    for (size_t i = 0; i < got; i++) {
+      grpc_cq_completion *c = chunk[i];
+      events[count].type = GRPC_OP_COMPLETE;
+      events[count].success = c->next & 1u;
+      events[count].tag = c->tag;
+      GRPC_SURFACE_TRACE_RETURNED_EVENT(cc, &events[count]);
+      count++;
+      c->done(&exec_ctx, c->done_arg, c);
+    }
+    if (got < want) break;
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+
+  return count;
+}
+
 static int add_plucker(grpc_completion_queue *cc, void *tag,
                        grpc_pollset_worker **worker) {
   cq_data *cqd = &cc->data;
@@ -905,11 +1050,11 @@ static bool cq_is_pluck_finished(grpc_exec_ctx *exec_ctx, void *arg) {
 
   GPR_ASSERT(a->stolen_completion == NULL);
   gpr_atm current_last_seen_things_queued_ever =
-      gpr_atm_no_barrier_load(&cqd->things_queued_ever);
+      gpr_atm_no_barrier_load(&cqd->things_queued_ever.counter);
   if (current_last_seen_things_queued_ever != a->last_seen_things_queued_ever) {
     gpr_mu_lock(cqd->mu);
     a->last_seen_things_queued_ever =
-        gpr_atm_no_barrier_load(&cqd->things_queued_ever);
+        gpr_atm_no_barrier_load(&cqd->things_queued_ever.counter);
     grpc_cq_completion *c;
     grpc_cq_completion *prev = &cqd->completed_head;
     while ((c = (grpc_cq_completion *)(prev->next & ~(uintptr_t)1)) !=
@@ -962,7 +1107,7 @@ static grpc_event cq_pluck(grpc_completion_queue *cc, void *tag,
   gpr_mu_lock(cqd->mu);
   cq_is_finished_arg is_finished_arg = {
       .last_seen_things_queued_ever =
-          gpr_atm_no_barrier_load(&cqd->things_queued_ever),
+          gpr_atm_no_barrier_load(&cqd->things_queued_ever.counter),
       .cq = cc,
       .deadline = deadline,
       .stolen_completion = NULL,
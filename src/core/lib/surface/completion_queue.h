@@ -112,6 +112,11 @@ int grpc_get_cq_poll_num(grpc_completion_queue *cc);
 grpc_completion_queue *grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type);
 
+/* Initializes/destroys global state (thread local storage) used by
+   completion queues */
+void grpc_cq_global_init(void);
+void grpc_cq_global_shutdown(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,8 +38,11 @@
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
+#include <grpc/support/useful.h>
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/channel/handshaker_registry.h"
@@ -51,6 +54,7 @@
 #include "src/core/lib/iomgr/resource_quota.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/env.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/channel_init.h"
@@ -115,6 +119,57 @@ typedef struct grpc_plugin {
 static grpc_plugin g_all_of_the_plugins[MAX_PLUGINS];
 static int g_number_of_plugins = 0;
 
+/* set (under g_init_mu) once the plugin/channel-filter stage below has run;
+   read lock-free on the channel construction fast path */
+static gpr_atm g_plugins_initialized;
+
+/* GRPC_LAZY_PLUGIN_INIT defers plugin initialization and channel filter
+   registration from grpc_init to the first channel stack construction.
+   Short-lived processes that call grpc_init but never build a channel
+   (or fork first) then skip that work entirely */
+static bool lazy_plugin_init_enabled(void) {
+  char *env = gpr_getenv("GRPC_LAZY_PLUGIN_INIT");
+  if (env == NULL) return false;
+  static const char *truthy[] = {"yes",  "Yes",  "YES", "true",
+                                 "True", "TRUE", "1"};
+  bool enabled = false;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(truthy); i++) {
+    if (0 == strcmp(env, truthy[i])) enabled = true;
+  }
+  gpr_free(env);
+  return enabled;
+}
+
+/* second initialization stage: everything that only matters once channel
+   stacks start being built. Must hold g_init_mu */
+static void init_plugins_locked(void) {
+  int i;
+  for (i = 0; i < g_number_of_plugins; i++) {
+    if (g_all_of_the_plugins[i].init != NULL) {
+      g_all_of_the_plugins[i].init();
+    }
+  }
+  /* register channel finalization AFTER all plugins, to ensure that it's run
+   * at the appropriate time */
+  grpc_register_security_filters();
+  register_builtin_channel_init();
+  /* pick up tracers the plugins registered */
+  grpc_tracer_init("GRPC_TRACE");
+  /* no more changes to channel init pipelines */
+  grpc_channel_init_finalize();
+  gpr_atm_rel_store(&g_plugins_initialized, 1);
+}
+
+void grpc_maybe_init_plugins(void) {
+  if (gpr_atm_acq_load(&g_plugins_initialized)) return;
+  gpr_mu_lock(&g_init_mu);
+  if (!gpr_atm_no_barrier_load(&g_plugins_initialized) &&
+      g_initializations > 0) {
+    init_plugins_locked();
+  }
+  gpr_mu_unlock(&g_init_mu);
+}
+
 void grpc_register_plugin(void (*init)(void), void (*destroy)(void)) {
   GRPC_API_TRACE("grpc_register_plugin(init=%p, destroy=%p)", 2,
                  ((void *)(intptr_t)init, (void *)(intptr_t)destroy));
@@ -125,16 +180,17 @@ void grpc_register_plugin(void (*init)(void), void (*destroy)(void)) {
 }
 
 void grpc_init(void) {
-  int i;
   gpr_once_init(&g_basic_init, do_basic_init);
 
   gpr_mu_lock(&g_init_mu);
   if (++g_initializations == 1) {
     gpr_time_init();
     grpc_slice_intern_init();
+    grpc_channel_args_intern_init();
     grpc_mdctx_global_init();
     grpc_channel_init_init();
     grpc_register_tracer("api", &grpc_api_trace);
+    grpc_register_tracer("api_ring", &grpc_api_ring_trace);
     grpc_register_tracer("channel", &grpc_trace_channel);
     grpc_register_tracer("connectivity_state", &grpc_connectivity_state_trace);
     grpc_register_tracer("channel_stack_builder",
@@ -156,21 +212,20 @@ void grpc_init(void) {
     grpc_security_pre_init();
     grpc_iomgr_init();
     grpc_executor_init();
+    grpc_cq_global_init();
+    grpc_api_ring_trace_init();
     gpr_timers_global_init();
     grpc_handshaker_factory_registry_init();
     grpc_security_init();
-    for (i = 0; i < g_number_of_plugins; i++) {
-      if (g_all_of_the_plugins[i].init != NULL) {
-        g_all_of_the_plugins[i].init();
-      }
+    gpr_atm_no_barrier_store(&g_plugins_initialized, 0);
+    if (lazy_plugin_init_enabled()) {
+      /* plugin initialization and channel filter registration are deferred
+         to the first channel stack construction; still enable the tracers
+         registered above so early API calls trace as usual */
+      grpc_tracer_init("GRPC_TRACE");
+    } else {
+      init_plugins_locked();
     }
-    /* register channel finalization AFTER all plugins, to ensure that it's run
-     * at the appropriate time */
-    grpc_register_security_filters();
-    register_builtin_channel_init();
-    grpc_tracer_init("GRPC_TRACE");
-    /* no more changes to channel init pipelines */
-    grpc_channel_init_finalize();
     grpc_iomgr_start();
   }
   gpr_mu_unlock(&g_init_mu);
@@ -184,16 +239,24 @@ void grpc_shutdown(void) {
   gpr_mu_lock(&g_init_mu);
   if (--g_initializations == 0) {
     grpc_executor_shutdown(&exec_ctx);
+    grpc_api_ring_trace_shutdown();
+    grpc_cq_global_shutdown();
     grpc_iomgr_shutdown(&exec_ctx);
     gpr_timers_global_destroy();
     grpc_tracer_shutdown();
-    for (i = g_number_of_plugins; i >= 0; i--) {
-      if (g_all_of_the_plugins[i].destroy != NULL) {
-        g_all_of_the_plugins[i].destroy();
+    /* plugins that were never initialized (lazy mode, no channel was ever
+       built) must not be destroyed */
+    if (gpr_atm_no_barrier_load(&g_plugins_initialized)) {
+      for (i = g_number_of_plugins; i >= 0; i--) {
+        if (g_all_of_the_plugins[i].destroy != NULL) {
+          g_all_of_the_plugins[i].destroy();
+        }
       }
+      gpr_atm_no_barrier_store(&g_plugins_initialized, 0);
     }
     grpc_mdctx_global_shutdown(&exec_ctx);
     grpc_handshaker_factory_registry_shutdown(&exec_ctx);
+    grpc_channel_args_intern_shutdown();
     grpc_slice_intern_shutdown();
   }
   gpr_mu_unlock(&g_init_mu);
@@ -38,5 +38,10 @@ void grpc_register_security_filters(void);
 void grpc_security_pre_init(void);
 void grpc_security_init(void);
 int grpc_is_initialized(void);
+/* Run the deferred plugin/channel-filter initialization stage if it has not
+   run yet (no-op otherwise). Called on channel stack construction so that
+   GRPC_LAZY_PLUGIN_INIT processes pay for plugins on first use rather than
+   in grpc_init */
+void grpc_maybe_init_plugins(void);
 
 #endif /* GRPC_CORE_LIB_SURFACE_INIT_H */
@@ -63,6 +63,11 @@ struct CallData {
 struct ChannelData {
   grpc_status_code error_code;
   const char *error_message;
+  /* interned once at channel creation so that failing a call refs cached
+     metadata and a cached error instead of allocating per call */
+  grpc_mdelem status_md;
+  grpc_mdelem details_md;
+  grpc_error *lame_error;
 };
 
 static void fill_metadata(grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
@@ -75,13 +80,20 @@ static void fill_metadata(grpc_exec_ctx *exec_ctx, grpc_call_element *elem,
     return;
   }
   ChannelData *chand = static_cast<ChannelData *>(elem->channel_data);
-  char tmp[GPR_LTOA_MIN_BUFSIZE];
-  gpr_ltoa(chand->error_code, tmp);
-  calld->status.md = grpc_mdelem_from_slices(
-      exec_ctx, GRPC_MDSTR_GRPC_STATUS, grpc_slice_from_copied_string(tmp));
-  calld->details.md = grpc_mdelem_from_slices(
-      exec_ctx, GRPC_MDSTR_GRPC_MESSAGE,
-      grpc_slice_from_copied_string(chand->error_message));
+  if (!GRPC_MDISNULL(chand->status_md)) {
+    calld->status.md = GRPC_MDELEM_REF(chand->status_md);
+    calld->details.md = GRPC_MDELEM_REF(chand->details_md);
+  } else {
+    /* channel was built without grpc_lame_client_channel_create (e.g. by a
+       channel stack test): intern the metadata here instead */
+    char tmp[GPR_LTOA_MIN_BUFSIZE];
+    gpr_ltoa(chand->error_code, tmp);
+    calld->status.md = grpc_mdelem_from_slices(
+        exec_ctx, GRPC_MDSTR_GRPC_STATUS, grpc_slice_from_copied_string(tmp));
+    calld->details.md = grpc_mdelem_from_slices(
+        exec_ctx, GRPC_MDSTR_GRPC_MESSAGE,
+        grpc_slice_from_copied_string(chand->error_message));
+  }
   calld->status.prev = calld->details.next = NULL;
   calld->status.next = &calld->details;
   calld->details.prev = &calld->status;
@@ -101,9 +113,12 @@ static void lame_start_transport_stream_op_batch(
     fill_metadata(exec_ctx, elem,
                   op->payload->recv_trailing_metadata.recv_trailing_metadata);
   }
+  ChannelData *chand = static_cast<ChannelData *>(elem->channel_data);
   grpc_transport_stream_op_batch_finish_with_failure(
       exec_ctx, op,
-      GRPC_ERROR_CREATE_FROM_STATIC_STRING("lame client channel"));
+      chand->lame_error != GRPC_ERROR_NONE
+          ? GRPC_ERROR_REF(chand->lame_error)
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("lame client channel"));
 }
 
 static char *lame_get_peer(grpc_exec_ctx *exec_ctx, grpc_call_element *elem) {
@@ -151,11 +166,20 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
                                      grpc_channel_element_args *args) {
   GPR_ASSERT(args->is_first);
   GPR_ASSERT(args->is_last);
+  ChannelData *chand = static_cast<ChannelData *>(elem->channel_data);
+  chand->status_md = GRPC_MDNULL;
+  chand->details_md = GRPC_MDNULL;
+  chand->lame_error = GRPC_ERROR_NONE;
   return GRPC_ERROR_NONE;
 }
 
 static void destroy_channel_elem(grpc_exec_ctx *exec_ctx,
-                                 grpc_channel_element *elem) {}
+                                 grpc_channel_element *elem) {
+  ChannelData *chand = static_cast<ChannelData *>(elem->channel_data);
+  GRPC_MDELEM_UNREF(exec_ctx, chand->status_md);
+  GRPC_MDELEM_UNREF(exec_ctx, chand->details_md);
+  GRPC_ERROR_UNREF(chand->lame_error);
+}
 
 }  // namespace
 
@@ -194,6 +218,17 @@ grpc_channel *grpc_lame_client_channel_create(const char *target,
   auto chand = static_cast<grpc_core::ChannelData *>(elem->channel_data);
   chand->error_code = error_code;
   chand->error_message = error_message;
+  /* fail-path state is built once here; each failed call refs it rather
+     than interning metadata and allocating an error of its own */
+  char tmp[GPR_LTOA_MIN_BUFSIZE];
+  gpr_ltoa(error_code, tmp);
+  chand->status_md = grpc_mdelem_from_slices(
+      &exec_ctx, GRPC_MDSTR_GRPC_STATUS, grpc_slice_from_copied_string(tmp));
+  chand->details_md =
+      grpc_mdelem_from_slices(&exec_ctx, GRPC_MDSTR_GRPC_MESSAGE,
+                              grpc_slice_from_copied_string(error_message));
+  chand->lame_error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("lame client channel");
   grpc_exec_ctx_finish(&exec_ctx);
   return channel;
 }
@@ -117,8 +117,21 @@ struct channel_data {
   channel_registered_method *registered_methods;
   uint32_t registered_method_slots;
   uint32_t registered_method_max_probes;
+  /* per-bucket displacements; when a collision-free placement was found at
+     channel setup, max_probes is 0 and method match is one displacement
+     load plus a single slot compare */
+  uint32_t *registered_method_disps;
   grpc_closure finish_destroy_channel_closure;
   grpc_closure channel_connectivity_changed;
+  /* load-adaptive MAX_CONCURRENT_STREAMS advertisement (see
+     GRPC_ARG_ADAPTIVE_MAX_CONCURRENT_STREAMS); cap == 0 disables. AIMD per
+     connection: a call parked on the pending list halves the advertised
+     limit, a full window of immediately matched calls raises it one step.
+     Updates race benignly across transport callbacks - the limit is
+     advisory and converges regardless. */
+  uint32_t adaptive_streams_cap;
+  uint32_t advertised_streams;
+  uint32_t immediate_match_run;
 };
 
 typedef struct shutdown_tag {
@@ -177,6 +190,10 @@ struct request_matcher {
   grpc_server *server;
   call_data *pending_head;
   call_data *pending_tail;
+  /* count of calls on the pending list; mutated under mu_call but read
+     without it, so queue_call_request can skip the lock entirely when
+     nothing is pending */
+  gpr_atm pending_count;
   gpr_locked_mpscq *requests_per_cq;
 };
 
@@ -193,8 +210,13 @@ struct registered_method {
 typedef struct {
   grpc_channel **channels;
   size_t num_channels;
+  /* number of channels to shut down per exec_ctx flush; see
+     GRPC_ARG_SERVER_SHUTDOWN_DRAIN_BATCH_SIZE */
+  size_t drain_batch_size;
 } channel_broadcaster;
 
+#define DEFAULT_SHUTDOWN_DRAIN_BATCH_SIZE 256
+
 struct grpc_server {
   grpc_channel_args *channel_args;
 
@@ -223,6 +245,12 @@ struct grpc_server {
   /** one request matcher for unregistered methods */
   request_matcher unregistered_request_matcher;
 
+  /** recycled requested_call storage: completed or failed request slots
+      park here instead of being freed, so a server re-arming slots at a
+      steady rate reaches its peak outstanding-request count and then
+      never allocates on the request path again */
+  gpr_locked_mpscq requested_call_freelist;
+
   gpr_atm shutdown_flag;
   uint8_t shutdown_published;
   size_t num_shutdown_tags;
@@ -267,6 +295,10 @@ static void channel_broadcaster_init(grpc_server *s, channel_broadcaster *cb) {
     cb->channels[count++] = c->channel;
     GRPC_CHANNEL_INTERNAL_REF(c->channel, "broadcast");
   }
+  cb->drain_batch_size = (size_t)grpc_channel_arg_get_integer(
+      grpc_channel_args_find(s->channel_args,
+                             GRPC_ARG_SERVER_SHUTDOWN_DRAIN_BATCH_SIZE),
+      (grpc_integer_options){DEFAULT_SHUTDOWN_DRAIN_BATCH_SIZE, 1, INT_MAX});
 }
 
 struct shutdown_cleanup_args {
@@ -312,6 +344,12 @@ static void channel_broadcaster_shutdown(grpc_exec_ctx *exec_ctx,
     send_shutdown(exec_ctx, cb->channels[i], send_goaway,
                   GRPC_ERROR_REF(force_disconnect));
     GRPC_CHANNEL_INTERNAL_UNREF(exec_ctx, cb->channels[i], "broadcast");
+    /* flush periodically so that a server with many connections queues
+       bounded work per iteration instead of accumulating one combiner
+       closure per channel before any GOAWAY hits the wire */
+    if ((i + 1) % cb->drain_batch_size == 0 && i + 1 != cb->num_channels) {
+      grpc_exec_ctx_flush(exec_ctx);
+    }
   }
   gpr_free(cb->channels);
   GRPC_ERROR_UNREF(force_disconnect);
@@ -349,6 +387,7 @@ static void request_matcher_zombify_all_pending_calls(grpc_exec_ctx *exec_ctx,
   while (rm->pending_head) {
     call_data *calld = rm->pending_head;
     rm->pending_head = calld->pending_next;
+    gpr_atm_no_barrier_fetch_add(&rm->pending_count, -1);
     gpr_mu_lock(&calld->mu_state);
     calld->state = ZOMBIED;
     gpr_mu_unlock(&calld->mu_state);
@@ -410,6 +449,12 @@ static void server_delete(grpc_exec_ctx *exec_ctx, grpc_server *server) {
   for (i = 0; i < server->cq_count; i++) {
     GRPC_CQ_INTERNAL_UNREF(exec_ctx, server->cqs[i], "server");
   }
+  requested_call *rc;
+  while ((rc = (requested_call *)gpr_locked_mpscq_try_pop(
+              &server->requested_call_freelist)) != NULL) {
+    gpr_free(rc);
+  }
+  gpr_locked_mpscq_destroy(&server->requested_call_freelist);
   gpr_free(server->cqs);
   gpr_free(server->pollsets);
   gpr_free(server->shutdown_tags);
@@ -465,9 +510,26 @@ static void destroy_channel(grpc_exec_ctx *exec_ctx, channel_data *chand,
                        op);
 }
 
+/* Take a requested_call from the server's freelist, falling back to the
+   allocator only while the freelist is still growing to the server's peak
+   outstanding-request count. */
+static requested_call *requested_call_alloc(grpc_server *server) {
+  requested_call *rc = (requested_call *)gpr_locked_mpscq_try_pop(
+      &server->requested_call_freelist);
+  if (rc == NULL) {
+    rc = (requested_call *)gpr_malloc(sizeof(*rc));
+  }
+  return rc;
+}
+
+static void requested_call_release(grpc_server *server, requested_call *rc) {
+  gpr_locked_mpscq_push(&server->requested_call_freelist, &rc->request_link);
+}
+
 static void done_request_event(grpc_exec_ctx *exec_ctx, void *req,
                                grpc_cq_completion *c) {
-  gpr_free(req);
+  requested_call *rc = (requested_call *)req;
+  requested_call_release(rc->server, rc);
 }
 
 static void publish_call(grpc_exec_ctx *exec_ctx, grpc_server *server,
@@ -500,6 +562,49 @@ static void publish_call(grpc_exec_ctx *exec_ctx, grpc_server *server,
                  done_request_event, rc, &rc->completion);
 }
 
+/* Advertise a new concurrent-stream limit to this channel's client; the
+   transport pushes the SETTINGS update on its next write */
+static void advertise_max_concurrent_streams(grpc_exec_ctx *exec_ctx,
+                                             channel_data *chand,
+                                             uint32_t limit) {
+  grpc_transport_op *op = grpc_make_transport_op(NULL);
+  op->max_concurrent_streams = limit;
+  grpc_channel_next_op(exec_ctx,
+                       grpc_channel_stack_element(
+                           grpc_channel_get_channel_stack(chand->channel), 0),
+                       op);
+}
+
+/* a call was matched to a waiting application request without queueing:
+   after a full window of these, widen the advertised limit one step */
+static void observe_immediate_match(grpc_exec_ctx *exec_ctx,
+                                    channel_data *chand) {
+  if (chand->adaptive_streams_cap == 0 ||
+      chand->advertised_streams >= chand->adaptive_streams_cap) {
+    return;
+  }
+  if (++chand->immediate_match_run >= chand->advertised_streams) {
+    chand->immediate_match_run = 0;
+    chand->advertised_streams++;
+    advertise_max_concurrent_streams(exec_ctx, chand,
+                                     chand->advertised_streams);
+  }
+}
+
+/* a call had to park on the pending list: the application is not keeping
+   up, so halve the advertised limit and shed load onto the client */
+static void observe_pending_call(grpc_exec_ctx *exec_ctx,
+                                 channel_data *chand) {
+  if (chand->adaptive_streams_cap == 0) return;
+  chand->immediate_match_run = 0;
+  uint32_t halved = chand->advertised_streams / 2;
+  if (halved < 1) halved = 1;
+  if (halved != chand->advertised_streams) {
+    chand->advertised_streams = halved;
+    advertise_max_concurrent_streams(exec_ctx, chand, halved);
+  }
+}
+
 static void publish_new_rpc(grpc_exec_ctx *exec_ctx, void *arg,
                             grpc_error *error) {
   grpc_call_element *call_elem = arg;
@@ -523,21 +628,42 @@ static void publish_new_rpc(grpc_exec_ctx *exec_ctx, void *arg,
 
   for (size_t i = 0; i < server->cq_count; i++) {
     size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
-    requested_call *rc =
-        (requested_call *)gpr_locked_mpscq_pop(&rm->requests_per_cq[cq_idx]);
+    requested_call *rc = (requested_call *)gpr_locked_mpscq_try_pop(
+        &rm->requests_per_cq[cq_idx]);
     if (rc == NULL) {
       continue;
     } else {
       gpr_mu_lock(&calld->mu_state);
       calld->state = ACTIVATED;
       gpr_mu_unlock(&calld->mu_state);
+      observe_immediate_match(exec_ctx, chand);
       publish_call(exec_ctx, server, calld, cq_idx, rc);
       return; /* early out */
     }
   }
 
-  /* no cq to take the request found: queue it on the slow list */
+  /* no cq to take the request found: queue it on the slow list.
+     Publish the pending count first (full barrier), then scan the request
+     queues once more: a request pushed concurrently with the scan above
+     either sees the non-zero pending count and comes for the list, or was
+     pushed early enough for this re-scan to pop it - it cannot miss both */
   gpr_mu_lock(&server->mu_call);
+  gpr_atm_full_fetch_add(&rm->pending_count, 1);
+  for (size_t i = 0; i < server->cq_count; i++) {
+    size_t cq_idx = (chand->cq_idx + i) % server->cq_count;
+    requested_call *rc =
+        (requested_call *)gpr_locked_mpscq_pop(&rm->requests_per_cq[cq_idx]);
+    if (rc != NULL) {
+      gpr_atm_no_barrier_fetch_add(&rm->pending_count, -1);
+      gpr_mu_unlock(&server->mu_call);
+      gpr_mu_lock(&calld->mu_state);
+      calld->state = ACTIVATED;
+      gpr_mu_unlock(&calld->mu_state);
+      observe_immediate_match(exec_ctx, chand);
+      publish_call(exec_ctx, server, calld, cq_idx, rc);
+      return;
+    }
+  }
   gpr_mu_lock(&calld->mu_state);
   calld->state = PENDING;
   gpr_mu_unlock(&calld->mu_state);
@@ -549,6 +675,7 @@ static void publish_new_rpc(grpc_exec_ctx *exec_ctx, void *arg,
   }
   calld->pending_next = NULL;
   gpr_mu_unlock(&server->mu_call);
+  observe_pending_call(exec_ctx, chand);
 }
 
 static void finish_start_new_rpc(
@@ -587,6 +714,113 @@ static void finish_start_new_rpc(
   }
 }
 
+/* position of a method hash within the lookup table, before displacement.
+   taking the high half of a Fibonacci multiply decorrelates the position
+   from the bucket index (hash % slots), which a plain multiply would not:
+   multiplication commutes with the modulus, and every member of a bucket
+   would collapse into one slot */
+#define REGISTERED_METHOD_POSITION(hash) \
+  ((uint32_t)(((uint64_t)(hash)*2654435761u) >> 32))
+
+/* slot of probe i for a method hash. with a perfectly placed table
+   (max_probes == 0) this is the only slot that can hold the method */
+static uint32_t registered_method_slot(channel_data *chand, uint32_t hash,
+                                       uint32_t i) {
+  return (uint32_t)(((size_t)REGISTERED_METHOD_POSITION(hash) +
+                     chand->registered_method_disps
+                         [hash % chand->registered_method_slots] +
+                     i) %
+                    chand->registered_method_slots);
+}
+
+/* Attempt a collision-free ("perfect") placement of registered-method
+   hashes into a table with the given number of slots: hashes are grouped
+   into buckets by hash % slots, and each bucket is assigned one
+   displacement such that every hash lands in its own slot at
+   (REGISTERED_METHOD_POSITION(hash) + displacement) % slots. Returns the
+   displacement array (owned by the caller) or NULL if no placement was
+   found, in which case the caller may retry with more slots or fall back
+   to linear probing. */
+static uint32_t *build_registered_method_displacements(const uint32_t *hashes,
+                                                       size_t n,
+                                                       size_t slots) {
+  uint32_t *disps = gpr_zalloc(sizeof(*disps) * slots);
+  uint8_t *used = gpr_zalloc(slots);
+  uint8_t *placed = gpr_zalloc(slots);
+  size_t *members = gpr_malloc(sizeof(*members) * n);
+  size_t *bucket_size = gpr_zalloc(sizeof(*bucket_size) * slots);
+  bool ok = true;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    bucket_size[hashes[i] % slots]++;
+  }
+  for (;;) {
+    /* place the largest remaining bucket: big buckets are the hardest to
+       fit, so they go first while the table is still sparse */
+    size_t bucket = slots;
+    size_t size = 0;
+    size_t b;
+    for (b = 0; b < slots; b++) {
+      if (!placed[b] && bucket_size[b] > size) {
+        bucket = b;
+        size = bucket_size[b];
+      }
+    }
+    if (bucket == slots) break;
+    size_t nmembers = 0;
+    for (i = 0; i < n; i++) {
+      if (hashes[i] % slots == bucket) members[nmembers++] = i;
+    }
+    bool found = false;
+    size_t d;
+    for (d = 0; d < slots && !found; d++) {
+      bool fits = true;
+      size_t k;
+      for (k = 0; k < nmembers && fits; k++) {
+        size_t slot =
+            ((size_t)REGISTERED_METHOD_POSITION(hashes[members[k]]) + d) %
+            slots;
+        if (used[slot]) {
+          fits = false;
+          break;
+        }
+        /* two members of this bucket must not claim the same slot */
+        size_t j;
+        for (j = 0; j < k; j++) {
+          if (((size_t)REGISTERED_METHOD_POSITION(hashes[members[j]]) + d) %
+                  slots ==
+              slot) {
+            fits = false;
+            break;
+          }
+        }
+      }
+      if (fits) {
+        disps[bucket] = (uint32_t)d;
+        for (k = 0; k < nmembers; k++) {
+          used[((size_t)REGISTERED_METHOD_POSITION(hashes[members[k]]) + d) %
+               slots] = 1;
+        }
+        found = true;
+      }
+    }
+    if (!found) {
+      ok = false;
+      break;
+    }
+    placed[bucket] = 1;
+  }
+  gpr_free(used);
+  gpr_free(placed);
+  gpr_free(members);
+  gpr_free(bucket_size);
+  if (!ok) {
+    gpr_free(disps);
+    return NULL;
+  }
+  return disps;
+}
+
 static void start_new_rpc(grpc_exec_ctx *exec_ctx, grpc_call_element *elem) {
   channel_data *chand = elem->channel_data;
   call_data *calld = elem->call_data;
@@ -597,12 +831,14 @@ static void start_new_rpc(grpc_exec_ctx *exec_ctx, grpc_call_element *elem) {
 
   if (chand->registered_methods && calld->path_set && calld->host_set) {
     /* TODO(ctiller): unify these two searches */
+    /* incoming path/host slices are rarely interned, so hash each of them
+       only once for both probe rounds */
+    const uint32_t path_hash = grpc_slice_hash(calld->path);
+    const uint32_t host_hash = grpc_slice_hash(calld->host);
     /* check for an exact match with host */
-    hash = GRPC_MDSTR_KV_HASH(grpc_slice_hash(calld->host),
-                              grpc_slice_hash(calld->path));
+    hash = GRPC_MDSTR_KV_HASH(host_hash, path_hash);
     for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
+      rm = &chand->registered_methods[registered_method_slot(chand, hash, i)];
       if (!rm) break;
       if (!rm->has_host) continue;
       if (!grpc_slice_eq(rm->host, calld->host)) continue;
@@ -618,10 +854,9 @@ static void start_new_rpc(grpc_exec_ctx *exec_ctx, grpc_call_element *elem) {
       return;
     }
     /* check for a wildcard method definition (no host set) */
-    hash = GRPC_MDSTR_KV_HASH(0, grpc_slice_hash(calld->path));
+    hash = GRPC_MDSTR_KV_HASH(0, path_hash);
     for (i = 0; i <= chand->registered_method_max_probes; i++) {
-      rm = &chand->registered_methods[(hash + i) %
-                                      chand->registered_method_slots];
+      rm = &chand->registered_methods[registered_method_slot(chand, hash, i)];
       if (!rm) break;
       if (rm->has_host) continue;
       if (!grpc_slice_eq(rm->method, calld->path)) continue;
@@ -909,7 +1144,14 @@ static grpc_error *init_channel_elem(grpc_exec_ctx *exec_ctx,
   chand->channel = NULL;
   chand->next = chand->prev = chand;
   chand->registered_methods = NULL;
+  chand->registered_method_disps = NULL;
   chand->connectivity_state = GRPC_CHANNEL_IDLE;
+  chand->adaptive_streams_cap = (uint32_t)grpc_channel_arg_get_integer(
+      grpc_channel_args_find(args->channel_args,
+                             GRPC_ARG_ADAPTIVE_MAX_CONCURRENT_STREAMS),
+      (grpc_integer_options){0, 0, INT_MAX});
+  chand->advertised_streams = chand->adaptive_streams_cap;
+  chand->immediate_match_run = 0;
   grpc_closure_init(&chand->channel_connectivity_changed,
                     channel_connectivity_changed, chand,
                     grpc_schedule_on_exec_ctx);
@@ -928,6 +1170,7 @@ static void destroy_channel_elem(grpc_exec_ctx *exec_ctx,
       }
     }
     gpr_free(chand->registered_methods);
+    gpr_free(chand->registered_method_disps);
   }
   if (chand->server) {
     gpr_mu_lock(&chand->server->mu_global);
@@ -999,6 +1242,7 @@ grpc_server *grpc_server_create(const grpc_channel_args *args, void *reserved) {
   gpr_mu_init(&server->mu_global);
   gpr_mu_init(&server->mu_call);
   gpr_cv_init(&server->starting_cv);
+  gpr_locked_mpscq_init(&server->requested_call_freelist);
 
   /* decremented by grpc_server_destroy */
   gpr_ref_init(&server->internal_refcount, 1);
@@ -1146,9 +1390,12 @@ void grpc_server_setup_transport(grpc_exec_ctx *exec_ctx, grpc_server *s,
   /* build a lookup table phrased in terms of mdstr's in this channels context
      to quickly find registered methods */
   if (num_registered_methods > 0) {
-    slots = 2 * num_registered_methods;
-    alloc = sizeof(channel_registered_method) * slots;
-    chand->registered_methods = gpr_zalloc(alloc);
+    /* gather hashes and interned slices once; placement into the table is
+       decided below */
+    channel_registered_method *entries =
+        gpr_zalloc(sizeof(*entries) * num_registered_methods);
+    uint32_t *hashes = gpr_malloc(sizeof(*hashes) * num_registered_methods);
+    size_t n = 0;
     for (rm = s->registered_methods; rm; rm = rm->next) {
       grpc_slice host;
       bool has_host;
@@ -1160,25 +1407,53 @@ void grpc_server_setup_transport(grpc_exec_ctx *exec_ctx, grpc_server *s,
         has_host = false;
       }
       method = grpc_slice_intern(grpc_slice_from_static_string(rm->method));
-      hash = GRPC_MDSTR_KV_HASH(has_host ? grpc_slice_hash(host) : 0,
-                                grpc_slice_hash(method));
-      for (probes = 0; chand->registered_methods[(hash + probes) % slots]
-                           .server_registered_method != NULL;
-           probes++)
-        ;
-      if (probes > max_probes) max_probes = probes;
-      crm = &chand->registered_methods[(hash + probes) % slots];
-      crm->server_registered_method = rm;
-      crm->flags = rm->flags;
-      crm->has_host = has_host;
+      hashes[n] = GRPC_MDSTR_KV_HASH(has_host ? grpc_slice_hash(host) : 0,
+                                     grpc_slice_hash(method));
+      entries[n].server_registered_method = rm;
+      entries[n].flags = rm->flags;
+      entries[n].has_host = has_host;
       if (has_host) {
-        crm->host = host;
+        entries[n].host = host;
       }
-      crm->method = method;
+      entries[n].method = method;
+      n++;
     }
+    /* prefer a collision-free (perfect) placement, so that for services
+       with many methods match is a hash plus a single compare instead of
+       a probe chain over cold memory; grow the table a few times if
+       needed. methods whose full 32-bit hashes collide cannot be
+       separated - keep linear probing (zero displacements) for those */
+    slots = 2 * num_registered_methods;
+    uint32_t *disps = NULL;
+    while (disps == NULL && slots <= 16 * num_registered_methods) {
+      disps = build_registered_method_displacements(hashes, n, slots);
+      if (disps == NULL) slots *= 2;
+    }
+    if (disps == NULL) {
+      slots = 2 * num_registered_methods;
+      disps = gpr_zalloc(sizeof(*disps) * slots);
+    }
+    alloc = sizeof(channel_registered_method) * slots;
+    chand->registered_methods = gpr_zalloc(alloc);
+    chand->registered_method_disps = disps;
     GPR_ASSERT(slots <= UINT32_MAX);
     chand->registered_method_slots = (uint32_t)slots;
+    for (size_t j = 0; j < n; j++) {
+      hash = hashes[j];
+      for (probes = 0;
+           chand->registered_methods[registered_method_slot(chand, hash,
+                                                            probes)]
+               .server_registered_method != NULL;
+           probes++)
+        ;
+      if (probes > max_probes) max_probes = probes;
+      crm = &chand->registered_methods[registered_method_slot(chand, hash,
+                                                              probes)];
+      *crm = entries[j];
+    }
     chand->registered_method_max_probes = max_probes;
+    gpr_free(entries);
+    gpr_free(hashes);
   }
 
   gpr_mu_lock(&s->mu_global);
@@ -1194,6 +1469,9 @@ void grpc_server_setup_transport(grpc_exec_ctx *exec_ctx, grpc_server *s,
   op->set_accept_stream_user_data = chand;
   op->on_connectivity_state_change = &chand->channel_connectivity_changed;
   op->connectivity_state = &chand->connectivity_state;
+  /* advertise the adaptive controller's ceiling up front so later decreases
+     only ever tighten what the client already saw */
+  op->max_concurrent_streams = chand->adaptive_streams_cap;
   if (gpr_atm_acq_load(&s->shutdown_flag) != 0) {
     op->disconnect_with_error =
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("Server shutdown");
@@ -1353,13 +1631,20 @@ static grpc_call_error queue_call_request(grpc_exec_ctx *exec_ctx,
       break;
   }
   if (gpr_locked_mpscq_push(&rm->requests_per_cq[cq_idx], &rc->request_link)) {
-    /* this was the first queued request: we need to lock and start
-       matching calls */
+    /* this was the first queued request: if any calls are pending we need
+       to lock and start matching them; with no pending calls we're done -
+       the push above is a full barrier, so a call that failed to pop it
+       has yet to bump pending_count and will re-scan the queues after
+       doing so */
+    if (gpr_atm_acq_load(&rm->pending_count) == 0) {
+      return GRPC_CALL_OK;
+    }
     gpr_mu_lock(&server->mu_call);
     while ((calld = rm->pending_head) != NULL) {
       rc = (requested_call *)gpr_locked_mpscq_pop(&rm->requests_per_cq[cq_idx]);
       if (rc == NULL) break;
       rm->pending_head = calld->pending_next;
+      gpr_atm_no_barrier_fetch_add(&rm->pending_count, -1);
       gpr_mu_unlock(&server->mu_call);
       gpr_mu_lock(&calld->mu_state);
       if (calld->state == ZOMBIED) {
@@ -1390,7 +1675,7 @@ grpc_call_error grpc_server_request_call(
     grpc_completion_queue *cq_for_notification, void *tag) {
   grpc_call_error error;
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
-  requested_call *rc = gpr_malloc(sizeof(*rc));
+  requested_call *rc = requested_call_alloc(server);
   GRPC_API_TRACE(
       "grpc_server_request_call("
       "server=%p, call=%p, details=%p, initial_metadata=%p, "
@@ -1404,7 +1689,7 @@ grpc_call_error grpc_server_request_call(
     }
   }
   if (cq_idx == server->cq_count) {
-    gpr_free(rc);
+    requested_call_release(server, rc);
     error = GRPC_CALL_ERROR_NOT_SERVER_COMPLETION_QUEUE;
     goto done;
   }
@@ -1431,7 +1716,7 @@ grpc_call_error grpc_server_request_registered_call(
     grpc_completion_queue *cq_for_notification, void *tag) {
   grpc_call_error error;
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
-  requested_call *rc = gpr_malloc(sizeof(*rc));
+  requested_call *rc = requested_call_alloc(server);
   registered_method *rm = rmp;
   GRPC_API_TRACE(
       "grpc_server_request_registered_call("
@@ -1448,13 +1733,13 @@ grpc_call_error grpc_server_request_registered_call(
     }
   }
   if (cq_idx == server->cq_count) {
-    gpr_free(rc);
+    requested_call_release(server, rc);
     error = GRPC_CALL_ERROR_NOT_SERVER_COMPLETION_QUEUE;
     goto done;
   }
   if ((optional_payload == NULL) !=
       (rm->payload_handling == GRPC_SRM_PAYLOAD_NONE)) {
-    gpr_free(rc);
+    requested_call_release(server, rc);
     error = GRPC_CALL_ERROR_PAYLOAD_TYPE_MISMATCH;
     goto done;
   }
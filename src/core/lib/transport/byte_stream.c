@@ -51,6 +51,32 @@ grpc_error *grpc_byte_stream_pull(grpc_exec_ctx *exec_ctx,
   return byte_stream->pull(exec_ctx, byte_stream, slice);
 }
 
+bool grpc_byte_stream_pull_buffer(grpc_exec_ctx *exec_ctx,
+                                  grpc_byte_stream *byte_stream,
+                                  grpc_slice_buffer *buffer,
+                                  grpc_closure *on_complete,
+                                  grpc_error **error) {
+  *error = GRPC_ERROR_NONE;
+  if (byte_stream->pull_buffer != NULL) {
+    return byte_stream->pull_buffer(exec_ctx, byte_stream, buffer, on_complete,
+                                    error);
+  }
+  /* generic fallback: drive the one-slice API while data is ready */
+  while (buffer->length < byte_stream->length) {
+    if (!byte_stream->next(exec_ctx, byte_stream,
+                           byte_stream->length - buffer->length, on_complete)) {
+      return false;
+    }
+    grpc_slice slice;
+    *error = byte_stream->pull(exec_ctx, byte_stream, &slice);
+    if (*error != GRPC_ERROR_NONE) {
+      return true;
+    }
+    grpc_slice_buffer_add(buffer, slice);
+  }
+  return true;
+}
+
 void grpc_byte_stream_destroy(grpc_exec_ctx *exec_ctx,
                               grpc_byte_stream *byte_stream) {
   byte_stream->destroy(exec_ctx, byte_stream);
@@ -78,6 +104,24 @@ static grpc_error *slice_buffer_stream_pull(grpc_exec_ctx *exec_ctx,
   return GRPC_ERROR_NONE;
 }
 
+static bool slice_buffer_stream_pull_buffer(grpc_exec_ctx *exec_ctx,
+                                            grpc_byte_stream *byte_stream,
+                                            grpc_slice_buffer *buffer,
+                                            grpc_closure *on_complete,
+                                            grpc_error **error) {
+  grpc_slice_buffer_stream *stream = (grpc_slice_buffer_stream *)byte_stream;
+  /* everything is already buffered: ref the remaining slices across in one
+     pass, no closure ever needed */
+  while (stream->cursor < stream->backing_buffer->count) {
+    grpc_slice_buffer_add(buffer,
+                          grpc_slice_ref_internal(
+                              stream->backing_buffer->slices[stream->cursor]));
+    stream->cursor++;
+  }
+  *error = GRPC_ERROR_NONE;
+  return true;
+}
+
 static void slice_buffer_stream_destroy(grpc_exec_ctx *exec_ctx,
                                         grpc_byte_stream *byte_stream) {}
 
@@ -89,6 +133,7 @@ void grpc_slice_buffer_stream_init(grpc_slice_buffer_stream *stream,
   stream->base.flags = flags;
   stream->base.next = slice_buffer_stream_next;
   stream->base.pull = slice_buffer_stream_pull;
+  stream->base.pull_buffer = slice_buffer_stream_pull_buffer;
   stream->base.destroy = slice_buffer_stream_destroy;
   stream->backing_buffer = slice_buffer;
   stream->cursor = 0;
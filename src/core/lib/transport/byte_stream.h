@@ -53,6 +53,11 @@ struct grpc_byte_stream {
                size_t max_size_hint, grpc_closure *on_complete);
   grpc_error *(*pull)(grpc_exec_ctx *exec_ctx, grpc_byte_stream *byte_stream,
                       grpc_slice *slice);
+  /* optional fast path for grpc_byte_stream_pull_buffer; NULL if the
+   * implementation relies on the generic next/pull loop */
+  bool (*pull_buffer)(grpc_exec_ctx *exec_ctx, grpc_byte_stream *byte_stream,
+                      grpc_slice_buffer *buffer, grpc_closure *on_complete,
+                      grpc_error **error);
   void (*destroy)(grpc_exec_ctx *exec_ctx, grpc_byte_stream *byte_stream);
 };
 
@@ -77,6 +82,23 @@ grpc_error *grpc_byte_stream_pull(grpc_exec_ctx *exec_ctx,
                                   grpc_byte_stream *byte_stream,
                                   grpc_slice *slice);
 
+/* appends all currently-buffered bytes of the stream to *buffer in one call.
+ *
+ * returns true when nothing further will arrive synchronously: either
+ * *buffer now holds byte_stream->length bytes in total, or *error is set
+ * (and owned by the caller). returns false if more data is pending, in
+ * which case on_complete is registered exactly once and will be scheduled
+ * when the next bytes are ready; the caller should then pull the ready
+ * slice and call this again.
+ *
+ * assumes *buffer accumulates the whole message, i.e. no bytes pulled from
+ * the stream have been removed from it. */
+bool grpc_byte_stream_pull_buffer(grpc_exec_ctx *exec_ctx,
+                                  grpc_byte_stream *byte_stream,
+                                  grpc_slice_buffer *buffer,
+                                  grpc_closure *on_complete,
+                                  grpc_error **error);
+
 void grpc_byte_stream_destroy(grpc_exec_ctx *exec_ctx,
                               grpc_byte_stream *byte_stream);
 
@@ -65,13 +65,90 @@ void grpc_connectivity_state_init(grpc_connectivity_state_tracker *tracker,
   gpr_atm_no_barrier_store(&tracker->current_state_atm, init_state);
   tracker->current_error = GRPC_ERROR_NONE;
   tracker->watchers = NULL;
+  tracker->batch = NULL;
   tracker->name = gpr_strdup(name);
 }
 
+/* State for batched notification fan-out.  This is a separate refcounted
+   object because the flush closure may still be queued on an exec_ctx when
+   the owning tracker is destroyed; the closure checks \a destroyed under
+   \a mu before touching the tracker.  The mutex also serializes the flush
+   closure against the tracker's owner, which otherwise relies purely on
+   its own external lock. */
+typedef struct grpc_connectivity_state_batch {
+  gpr_refcount refs;
+  gpr_mu mu;
+  bool destroyed;
+  bool flush_scheduled;
+  grpc_connectivity_state_tracker *tracker;
+  grpc_closure flush_closure;
+} grpc_connectivity_state_batch;
+
+static void batch_unref(grpc_connectivity_state_batch *batch) {
+  if (gpr_unref(&batch->refs)) {
+    gpr_mu_destroy(&batch->mu);
+    gpr_free(batch);
+  }
+}
+
+static void flush_batched_watchers(grpc_exec_ctx *exec_ctx, void *arg,
+                                   grpc_error *ignored) {
+  grpc_connectivity_state_batch *batch = arg;
+  grpc_closure_list closures = GRPC_CLOSURE_LIST_INIT;
+  gpr_mu_lock(&batch->mu);
+  batch->flush_scheduled = false;
+  if (!batch->destroyed) {
+    grpc_connectivity_state_tracker *tracker = batch->tracker;
+    /* Deliver the state as it is *now*: transitions superseded before the
+       flush ran coalesce away. */
+    grpc_connectivity_state state =
+        (grpc_connectivity_state)gpr_atm_no_barrier_load(
+            &tracker->current_state_atm);
+    grpc_connectivity_state_watcher *w;
+    grpc_connectivity_state_watcher *kept = NULL;
+    while ((w = tracker->watchers) != NULL) {
+      tracker->watchers = w->next;
+      if (*w->current != state) {
+        *w->current = state;
+        if (GRPC_TRACER_ON(grpc_connectivity_state_trace)) {
+          gpr_log(GPR_DEBUG, "NOTIFY: %p %s: %p", tracker, tracker->name,
+                  w->notify);
+        }
+        grpc_closure_list_append(&closures, w->notify,
+                                 GRPC_ERROR_REF(tracker->current_error));
+        gpr_free(w);
+      } else {
+        /* The state settled back to what this watcher already believes
+           within the epoch; keep it registered. */
+        w->next = kept;
+        kept = w;
+      }
+    }
+    tracker->watchers = kept;
+  }
+  gpr_mu_unlock(&batch->mu);
+  grpc_closure_list_sched(exec_ctx, &closures);
+  batch_unref(batch);
+}
+
+void grpc_connectivity_state_enable_batched_notifications(
+    grpc_connectivity_state_tracker *tracker) {
+  GPR_ASSERT(tracker->batch == NULL);
+  GPR_ASSERT(tracker->watchers == NULL);
+  grpc_connectivity_state_batch *batch = gpr_zalloc(sizeof(*batch));
+  gpr_ref_init(&batch->refs, 1);
+  gpr_mu_init(&batch->mu);
+  batch->tracker = tracker;
+  grpc_closure_init(&batch->flush_closure, flush_batched_watchers, batch,
+                    grpc_schedule_on_exec_ctx);
+  tracker->batch = batch;
+}
+
 void grpc_connectivity_state_destroy(grpc_exec_ctx *exec_ctx,
                                      grpc_connectivity_state_tracker *tracker) {
   grpc_error *error;
   grpc_connectivity_state_watcher *w;
+  if (tracker->batch != NULL) gpr_mu_lock(&tracker->batch->mu);
   while ((w = tracker->watchers)) {
     tracker->watchers = w->next;
 
@@ -85,6 +162,11 @@ void grpc_connectivity_state_destroy(grpc_exec_ctx *exec_ctx,
     grpc_closure_sched(exec_ctx, w->notify, error);
     gpr_free(w);
   }
+  if (tracker->batch != NULL) {
+    tracker->batch->destroyed = true;
+    gpr_mu_unlock(&tracker->batch->mu);
+    batch_unref(tracker->batch);
+  }
   GRPC_ERROR_UNREF(tracker->current_error);
   gpr_free(tracker->name);
 }
@@ -137,13 +219,21 @@ bool grpc_connectivity_state_notify_on_state_change(
               grpc_connectivity_state_name(cur), notify);
     }
   }
+  // In batched mode the watcher list is shared with the flush closure, so
+  // it is guarded by the batch lock in addition to the owner's own lock.
+  if (tracker->batch != NULL) {
+    gpr_mu_lock(&tracker->batch->mu);
+    cur = (grpc_connectivity_state)gpr_atm_no_barrier_load(
+        &tracker->current_state_atm);
+  }
+  bool ret = false;
   if (current == NULL) {
     grpc_connectivity_state_watcher *w = tracker->watchers;
     if (w != NULL && w->notify == notify) {
       grpc_closure_sched(exec_ctx, notify, GRPC_ERROR_CANCELLED);
       tracker->watchers = w->next;
       gpr_free(w);
-      return false;
+      w = NULL;
     }
     while (w != NULL) {
       grpc_connectivity_state_watcher *rm_candidate = w->next;
@@ -151,11 +241,10 @@ bool grpc_connectivity_state_notify_on_state_change(
         grpc_closure_sched(exec_ctx, notify, GRPC_ERROR_CANCELLED);
         w->next = w->next->next;
         gpr_free(rm_candidate);
-        return false;
+        break;
       }
       w = w->next;
     }
-    return false;
   } else {
     if (cur != *current) {
       *current = cur;
@@ -168,8 +257,10 @@ bool grpc_connectivity_state_notify_on_state_change(
       w->next = tracker->watchers;
       tracker->watchers = w;
     }
-    return cur == GRPC_CHANNEL_IDLE;
+    ret = cur == GRPC_CHANNEL_IDLE;
   }
+  if (tracker->batch != NULL) gpr_mu_unlock(&tracker->batch->mu);
+  return ret;
 }
 
 void grpc_connectivity_state_set(grpc_exec_ctx *exec_ctx,
@@ -198,6 +289,26 @@ void grpc_connectivity_state_set(grpc_exec_ctx *exec_ctx,
       GPR_ASSERT(error != GRPC_ERROR_NONE);
       break;
   }
+  if (tracker->batch != NULL) {
+    // Batched fan-out: update the state and schedule (at most) one flush
+    // per epoch; the flush notifies all watchers with a single closure
+    // list splice, delivering only the state current at that point.
+    grpc_connectivity_state_batch *batch = tracker->batch;
+    gpr_mu_lock(&batch->mu);
+    GRPC_ERROR_UNREF(tracker->current_error);
+    tracker->current_error = error;
+    if (cur != state) {
+      GPR_ASSERT(cur != GRPC_CHANNEL_SHUTDOWN);
+      gpr_atm_no_barrier_store(&tracker->current_state_atm, state);
+      if (!batch->flush_scheduled && tracker->watchers != NULL) {
+        batch->flush_scheduled = true;
+        gpr_ref(&batch->refs);
+        grpc_closure_sched(exec_ctx, &batch->flush_closure, GRPC_ERROR_NONE);
+      }
+    }
+    gpr_mu_unlock(&batch->mu);
+    return;
+  }
   GRPC_ERROR_UNREF(tracker->current_error);
   tracker->current_error = error;
   if (cur == state) {
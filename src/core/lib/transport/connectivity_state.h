@@ -54,6 +54,9 @@ typedef struct {
   grpc_error *current_error;
   /** all our watchers */
   grpc_connectivity_state_watcher *watchers;
+  /** present iff batched notification fan-out is enabled; see
+      grpc_connectivity_state_enable_batched_notifications() */
+  struct grpc_connectivity_state_batch *batch;
   /** a name to help debugging */
   char *name;
 } grpc_connectivity_state_tracker;
@@ -69,6 +72,17 @@ void grpc_connectivity_state_init(grpc_connectivity_state_tracker *tracker,
 void grpc_connectivity_state_destroy(grpc_exec_ctx *exec_ctx,
                                      grpc_connectivity_state_tracker *tracker);
 
+/** Enable batched watcher notification for this tracker.  State changes
+    accumulate into an epoch: the first change schedules a single flush
+    closure, and when it runs all watchers are notified in bulk with one
+    closure-list splice, observing only the state current at that point
+    (intermediate transitions within the epoch coalesce away).  Useful for
+    trackers with many watchers, where per-change notification under the
+    owner's combiner serializes badly.  Must be called right after init,
+    before any watchers are added. */
+void grpc_connectivity_state_enable_batched_notifications(
+    grpc_connectivity_state_tracker *tracker);
+
 /** Set connectivity state; not thread safe; access must be serialized with an
  *  external lock */
 void grpc_connectivity_state_set(grpc_exec_ctx *exec_ctx,
@@ -33,6 +33,8 @@
 
 #include "src/core/lib/transport/error_utils.h"
 
+#include <grpc/support/useful.h>
+
 #include "src/core/lib/iomgr/error_internal.h"
 #include "src/core/lib/transport/status_conversion.h"
 
@@ -54,9 +56,49 @@ static grpc_error *recursively_find_error_with_field(grpc_error *error,
   return NULL;
 }
 
+// Precomputed conversions for the special errors: failing a call with one of
+// these takes a table hit instead of an attribute-map traversal and a message
+// allocation.
+typedef struct {
+  grpc_error *error;
+  grpc_status_code code;
+  const char *msg;
+  grpc_http2_error_code http_error;
+} special_error_status;
+static const special_error_status special_error_status_map[] = {
+    {GRPC_ERROR_NONE, GRPC_STATUS_OK, "", GRPC_HTTP2_NO_ERROR},
+    {GRPC_ERROR_OOM, GRPC_STATUS_RESOURCE_EXHAUSTED, "Out of memory",
+     GRPC_HTTP2_ENHANCE_YOUR_CALM},
+    {GRPC_ERROR_CANCELLED, GRPC_STATUS_CANCELLED, "Cancelled",
+     GRPC_HTTP2_CANCEL},
+    {GRPC_ERROR_DEADLINE_EXCEEDED, GRPC_STATUS_DEADLINE_EXCEEDED,
+     "Deadline Exceeded", GRPC_HTTP2_CANCEL},
+    {GRPC_ERROR_UNAVAILABLE, GRPC_STATUS_UNAVAILABLE, "Unavailable",
+     GRPC_HTTP2_REFUSED_STREAM},
+    {GRPC_ERROR_RESOURCE_EXHAUSTED, GRPC_STATUS_RESOURCE_EXHAUSTED,
+     "Resource exhausted", GRPC_HTTP2_ENHANCE_YOUR_CALM},
+};
+
 void grpc_error_get_status(grpc_error *error, gpr_timespec deadline,
                            grpc_status_code *code, grpc_slice *slice,
                            grpc_http2_error_code *http_error) {
+  // Fast path: the special errors convert through static pairs.
+  if (grpc_error_is_special(error)) {
+    for (size_t i = 0; i < GPR_ARRAY_SIZE(special_error_status_map); i++) {
+      if (special_error_status_map[i].error == error) {
+        if (code != NULL) *code = special_error_status_map[i].code;
+        if (slice != NULL) {
+          *slice =
+              grpc_slice_from_static_string(special_error_status_map[i].msg);
+        }
+        if (http_error != NULL) {
+          *http_error = special_error_status_map[i].http_error;
+        }
+        return;
+      }
+    }
+  }
+
   // Start with the parent error and recurse through the tree of children
   // until we find the first one that has a status code.
   grpc_error *found_error =
@@ -46,6 +46,7 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/iomgr/resource_quota.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -122,6 +123,22 @@ static mdtab_shard g_shards[SHARD_COUNT];
 
 static void gc_mdtab(grpc_exec_ctx *exec_ctx, mdtab_shard *shard);
 
+/* resource-quota pressure hook: unreferenced interned mdelems normally sit
+   in the table until the next growth triggers a gc, which under memory
+   pressure is exactly the wrong time to wait for. Sweep them out now; both
+   pressure stages behave alike since a single gc pass already frees
+   everything unreferenced. */
+static void mdtab_shed_cache(grpc_exec_ctx *exec_ctx, void *unused,
+                             bool destructive) {
+  for (size_t i = 0; i < SHARD_COUNT; i++) {
+    mdtab_shard *shard = &g_shards[i];
+    if (gpr_atm_no_barrier_load(&shard->free_estimate) == 0) continue;
+    gpr_mu_lock(&shard->mu);
+    gc_mdtab(exec_ctx, shard);
+    gpr_mu_unlock(&shard->mu);
+  }
+}
+
 void grpc_mdctx_global_init(void) {
   /* initialize shards */
   for (size_t i = 0; i < SHARD_COUNT; i++) {
@@ -132,9 +149,11 @@ void grpc_mdctx_global_init(void) {
     shard->capacity = INITIAL_SHARD_CAPACITY;
     shard->elems = gpr_zalloc(sizeof(*shard->elems) * shard->capacity);
   }
+  grpc_resource_quota_register_cache_shedder(mdtab_shed_cache, NULL);
 }
 
 void grpc_mdctx_global_shutdown(grpc_exec_ctx *exec_ctx) {
+  grpc_resource_quota_unregister_cache_shedder(mdtab_shed_cache, NULL);
   for (size_t i = 0; i < SHARD_COUNT; i++) {
     mdtab_shard *shard = &g_shards[i];
     gpr_mu_destroy(&shard->mu);
@@ -330,6 +349,55 @@ grpc_mdelem grpc_mdelem_create(
   return GRPC_MAKE_MDELEM(md, GRPC_MDELEM_STORAGE_INTERNED);
 }
 
+/* layout must match grpc_mdelem_data: storage is owned by a call arena, so
+   there is no refcount - GRPC_MDELEM_STORAGE_EXTERNAL ref/unref are no-ops
+   and everything is freed with the arena */
+typedef struct arena_metadata {
+  grpc_slice key;
+  grpc_slice value;
+} arena_metadata;
+
+grpc_mdelem grpc_mdelem_create_on_arena(
+    grpc_exec_ctx *exec_ctx, grpc_slice key, grpc_slice value,
+    grpc_mdelem_data *compatible_external_backing_store, gpr_arena *arena) {
+  if (arena == NULL ||
+      (grpc_slice_is_interned(key) && grpc_slice_is_interned(value))) {
+    /* shareable across calls: the hpack encoder may want to index these, so
+       keep them in the global table */
+    return grpc_mdelem_create(exec_ctx, key, value,
+                              compatible_external_backing_store);
+  }
+
+  if (compatible_external_backing_store != NULL) {
+    return GRPC_MAKE_MDELEM(compatible_external_backing_store,
+                            GRPC_MDELEM_STORAGE_EXTERNAL);
+  }
+
+  size_t key_len =
+      GRPC_IS_STATIC_METADATA_STRING(key) ? 0 : GRPC_SLICE_LENGTH(key);
+  size_t value_len =
+      GRPC_IS_STATIC_METADATA_STRING(value) ? 0 : GRPC_SLICE_LENGTH(value);
+  arena_metadata *md =
+      gpr_arena_alloc(arena, sizeof(*md) + key_len + value_len);
+  uint8_t *bytes = (uint8_t *)(md + 1);
+  /* static slices are immortal and kept as-is; everything else is copied so
+     the element's lifetime is exactly the arena's */
+  if (GRPC_IS_STATIC_METADATA_STRING(key)) {
+    md->key = key;
+  } else {
+    memcpy(bytes, GRPC_SLICE_START_PTR(key), key_len);
+    md->key = grpc_slice_from_static_buffer(bytes, key_len);
+    bytes += key_len;
+  }
+  if (GRPC_IS_STATIC_METADATA_STRING(value)) {
+    md->value = value;
+  } else {
+    memcpy(bytes, GRPC_SLICE_START_PTR(value), value_len);
+    md->value = grpc_slice_from_static_buffer(bytes, value_len);
+  }
+  return GRPC_MAKE_MDELEM(md, GRPC_MDELEM_STORAGE_EXTERNAL);
+}
+
 grpc_mdelem grpc_mdelem_from_slices(grpc_exec_ctx *exec_ctx, grpc_slice key,
                                     grpc_slice value) {
   grpc_mdelem out = grpc_mdelem_create(exec_ctx, key, value, NULL);
@@ -339,14 +407,16 @@ grpc_mdelem grpc_mdelem_from_slices(grpc_exec_ctx *exec_ctx, grpc_slice key,
 }
 
 grpc_mdelem grpc_mdelem_from_grpc_metadata(grpc_exec_ctx *exec_ctx,
-                                           grpc_metadata *metadata) {
+                                           grpc_metadata *metadata,
+                                           gpr_arena *arena) {
   bool changed = false;
   grpc_slice key_slice =
       grpc_slice_maybe_static_intern(metadata->key, &changed);
   grpc_slice value_slice =
       grpc_slice_maybe_static_intern(metadata->value, &changed);
-  return grpc_mdelem_create(exec_ctx, key_slice, value_slice,
-                            changed ? NULL : (grpc_mdelem_data *)metadata);
+  return grpc_mdelem_create_on_arena(
+      exec_ctx, key_slice, value_slice,
+      changed ? NULL : (grpc_mdelem_data *)metadata, arena);
 }
 
 static size_t get_base64_encoded_size(size_t raw_length) {
@@ -39,6 +39,7 @@
 #include <grpc/support/useful.h>
 
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/support/arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -124,9 +125,12 @@ grpc_mdelem grpc_mdelem_from_slices(grpc_exec_ctx *exec_ctx, grpc_slice key,
                                     grpc_slice value);
 
 /* Cheaply convert a grpc_metadata to a grpc_mdelem; may use the grpc_metadata
-   object as backing storage (so lifetimes should align) */
+   object as backing storage (so lifetimes should align). If \a arena is
+   non-NULL, elements that would otherwise be individually allocated are
+   carved from it instead (see grpc_mdelem_create_on_arena) */
 grpc_mdelem grpc_mdelem_from_grpc_metadata(grpc_exec_ctx *exec_ctx,
-                                           grpc_metadata *metadata);
+                                           grpc_metadata *metadata,
+                                           gpr_arena *arena);
 
 /* Does not unref the slices; if a new non-interned mdelem is needed, allocates
    one if compatible_external_backing_store is NULL, or uses
@@ -136,6 +140,17 @@ grpc_mdelem grpc_mdelem_create(
     grpc_exec_ctx *exec_ctx, grpc_slice key, grpc_slice value,
     grpc_mdelem_data *compatible_external_backing_store);
 
+/* As grpc_mdelem_create, but for call-scoped metadata: pairs that are not
+   shareable across calls (at least one slice not interned - so never a
+   candidate for hpack incremental indexing) get their backing storage carved
+   from \a arena, with no global table insertion and no refcount - the arena
+   owns the memory. Shareable pairs still go through grpc_mdelem_create so
+   the hpack encoder can index them. \a arena may be NULL, in which case this
+   is exactly grpc_mdelem_create */
+grpc_mdelem grpc_mdelem_create_on_arena(
+    grpc_exec_ctx *exec_ctx, grpc_slice key, grpc_slice value,
+    grpc_mdelem_data *compatible_external_backing_store, gpr_arena *arena);
+
 bool grpc_mdelem_eq(grpc_mdelem a, grpc_mdelem b);
 
 size_t grpc_mdelem_get_size_in_hpack_table(grpc_mdelem elem);
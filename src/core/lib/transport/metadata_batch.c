@@ -216,6 +216,80 @@ grpc_error *grpc_metadata_batch_link_tail(grpc_exec_ctx *exec_ctx,
   return GRPC_ERROR_NONE;
 }
 
+void grpc_mdelem_list_add_tail(grpc_mdelem_list *list,
+                               grpc_linked_mdelem *storage, grpc_mdelem md) {
+  GPR_ASSERT(!GRPC_MDISNULL(md));
+  storage->md = md;
+  link_tail(list, storage);
+}
+
+/* Claim callout slots for every element of \a to_add; on a duplicate,
+   release the slots already claimed and leave \a batch unchanged */
+static grpc_error *maybe_link_list_callouts(grpc_metadata_batch *batch,
+                                            grpc_mdelem_list *to_add) {
+  grpc_linked_mdelem *l;
+  for (l = to_add->head; l != NULL; l = l->next) {
+    grpc_error *err = maybe_link_callout(batch, l);
+    if (err != GRPC_ERROR_NONE) {
+      for (grpc_linked_mdelem *u = to_add->head; u != l; u = u->next) {
+        maybe_unlink_callout(batch, u);
+      }
+      return err;
+    }
+  }
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error *grpc_metadata_batch_link_list_head(grpc_exec_ctx *exec_ctx,
+                                               grpc_metadata_batch *batch,
+                                               grpc_mdelem_list *to_add) {
+  assert_valid_callouts(exec_ctx, batch);
+  assert_valid_list(to_add);
+  if (to_add->head == NULL) return GRPC_ERROR_NONE;
+  grpc_error *err = maybe_link_list_callouts(batch, to_add);
+  if (err != GRPC_ERROR_NONE) {
+    assert_valid_callouts(exec_ctx, batch);
+    return err;
+  }
+  to_add->tail->next = batch->list.head;
+  if (batch->list.head != NULL) {
+    batch->list.head->prev = to_add->tail;
+  } else {
+    batch->list.tail = to_add->tail;
+  }
+  batch->list.head = to_add->head;
+  batch->list.count += to_add->count;
+  memset(to_add, 0, sizeof(*to_add));
+  assert_valid_list(&batch->list);
+  assert_valid_callouts(exec_ctx, batch);
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error *grpc_metadata_batch_link_list_tail(grpc_exec_ctx *exec_ctx,
+                                               grpc_metadata_batch *batch,
+                                               grpc_mdelem_list *to_add) {
+  assert_valid_callouts(exec_ctx, batch);
+  assert_valid_list(to_add);
+  if (to_add->head == NULL) return GRPC_ERROR_NONE;
+  grpc_error *err = maybe_link_list_callouts(batch, to_add);
+  if (err != GRPC_ERROR_NONE) {
+    assert_valid_callouts(exec_ctx, batch);
+    return err;
+  }
+  to_add->head->prev = batch->list.tail;
+  if (batch->list.tail != NULL) {
+    batch->list.tail->next = to_add->head;
+  } else {
+    batch->list.head = to_add->head;
+  }
+  batch->list.tail = to_add->tail;
+  batch->list.count += to_add->count;
+  memset(to_add, 0, sizeof(*to_add));
+  assert_valid_list(&batch->list);
+  assert_valid_callouts(exec_ctx, batch);
+  return GRPC_ERROR_NONE;
+}
+
 static void unlink_storage(grpc_mdelem_list *list,
                            grpc_linked_mdelem *storage) {
   assert_valid_list(list);
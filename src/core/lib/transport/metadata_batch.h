@@ -112,6 +112,26 @@ grpc_error *grpc_metadata_batch_link_tail(
     grpc_exec_ctx *exec_ctx, grpc_metadata_batch *batch,
     grpc_linked_mdelem *storage) GRPC_MUST_USE_RESULT;
 
+/** Append \a md to \a list, using \a storage as the backing list element.
+    Ownership rules match \a grpc_metadata_batch_add_tail. Use to pre-chain
+    elements for \a grpc_metadata_batch_link_list_head/tail. */
+void grpc_mdelem_list_add_tail(grpc_mdelem_list *list,
+                               grpc_linked_mdelem *storage, grpc_mdelem md);
+
+/** Splice the pre-chained \a to_add to the beginning of \a batch. The list
+    pointer work is constant regardless of the number of elements spliced.
+    On success \a to_add is emptied; on error (duplicate callout) neither
+    list is modified. Storage ownership matches
+    \a grpc_metadata_batch_link_head. */
+grpc_error *grpc_metadata_batch_link_list_head(
+    grpc_exec_ctx *exec_ctx, grpc_metadata_batch *batch,
+    grpc_mdelem_list *to_add) GRPC_MUST_USE_RESULT;
+/** Like \a grpc_metadata_batch_link_list_head, but splices \a to_add to the
+    end of \a batch. */
+grpc_error *grpc_metadata_batch_link_list_tail(
+    grpc_exec_ctx *exec_ctx, grpc_metadata_batch *batch,
+    grpc_mdelem_list *to_add) GRPC_MUST_USE_RESULT;
+
 /** Add \a elem_to_add as the first element in \a batch, using
     \a storage as backing storage for the linked list element.
     \a storage is owned by the caller and must survive for the
@@ -42,6 +42,7 @@
 #include "src/core/lib/transport/static_metadata.h"
 
 #include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/support/murmur_hash.h"
 
 static uint8_t g_bytes[] = {
     58,  112, 97,  116, 104, 58,  109, 101, 116, 104, 111, 100, 58,  115, 116,
@@ -485,6 +486,52 @@ grpc_mdelem grpc_static_mdelem_for_static_strings(int a, int b) {
              : GRPC_MDNULL;
 }
 
+static const int8_t strs_r[] = {
+    0,   -12, -62, -12, -17, -29, 0,  1,  -46, 86,  7,   -15, -7,
+    26,  -18, -5,  58,  -3,  -9,  -41, 0,  3,   -32, -3,  -61, 28,
+    3,   0,   -28, 56,  9,   -11, 1,  26, -18, 8,   0,   30};
+static uint32_t strs_phash(uint32_t i) {
+  i -= 62;
+  uint32_t x = i % 107;
+  uint32_t y = i / 107;
+  uint32_t h = x;
+  if (y < GPR_ARRAY_SIZE(strs_r)) {
+    uint32_t delta = (uint32_t)strs_r[y];
+    h += delta;
+  }
+  return h;
+}
+
+static const uint16_t strs_keys[] = {
+    62,   1885, 183,  2451, 1888, 400,  3092, 2004, 3493, 71,   974,  349,
+    3811, 75,   1367, 825,  1270, 412,  1143, 645,  2546, 1374, 726,  1601,
+    2472, 3288, 207,  365,  90,   91,   656,  1458, 2480, 2874, 2031, 3602,
+    3835, 1921, 545,  377,  2731, 1166, 2883, 1715, 2180, 2571, 3764, 1011,
+    110,  2046, 557,  2577, 2188, 3004, 1308, 3854, 2765, 3143, 1022, 2507,
+    3146, 3546, 457,  689,  245,  1737, 1950, 2064, 1784, 250,  1648, 1424,
+    882,  580,  1746, 470,  1330, 2918, 1962, 1657, 4071, 3648, 3345, 3192,
+    3802, 3036, 3476, 149,  792,  1028, 1517, 2800, 2398, 0,    0,    0,
+    0,    801,  0,    3584, 4091, 0,    1227, 0,    0,    1821, 916};
+static const uint8_t strs_idxs[] = {
+    56, 38, 79, 2,  75, 19, 29, 15, 25, 94, 86, 18, 51, 26, 23,  82,  11,  45,
+    21, 20, 41, 83, 70, 84, 59, 14, 88, 72, 60, 48, 57, 58, 91,  73,  47,  24,
+    33, 67, 40, 7,  17, 63, 93, 78, 61, 42, 13, 87, 90, 46, 98,  76,  5,   50,
+    64, 9,  49, 1,  4,  36, 12, 3,  28, 89, 0,  44, 22, 53, 37,  68,  77,  10,
+    16, 71, 66, 65, 54, 39, 96, 55, 6,  32, 95, 31, 34, 8,  69,  97,  80,  74,
+    30, 27, 92, 255, 255, 255, 255, 43, 255, 35, 81, 255, 85, 255, 255, 52, 62};
+
+int grpc_static_slice_table_lookup(grpc_slice slice) {
+  uint32_t k = gpr_murmur_hash3(GRPC_SLICE_START_PTR(slice),
+                                GRPC_SLICE_LENGTH(slice), 4) &
+               0xfff;
+  uint32_t h = strs_phash(k);
+  return h < GPR_ARRAY_SIZE(strs_keys) && strs_keys[h] == k &&
+                 strs_idxs[h] != 255 &&
+                 grpc_slice_eq(grpc_static_slice_table[strs_idxs[h]], slice)
+             ? (int)strs_idxs[h]
+             : -1;
+}
+
 grpc_mdelem_data grpc_static_mdelem_table[GRPC_STATIC_MDELEM_COUNT] = {
     {{.refcount = &grpc_static_metadata_refcounts[7],
       .data.refcounted = {g_bytes + 50, 11}},
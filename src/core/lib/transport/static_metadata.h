@@ -507,6 +507,7 @@ extern uintptr_t grpc_static_mdelem_user_data[GRPC_STATIC_MDELEM_COUNT];
   (GRPC_MAKE_MDELEM(&grpc_static_mdelem_table[80], GRPC_MDELEM_STORAGE_STATIC))
 
 grpc_mdelem grpc_static_mdelem_for_static_strings(int a, int b);
+int grpc_static_slice_table_lookup(grpc_slice slice);
 typedef enum {
   GRPC_BATCH_PATH,
   GRPC_BATCH_METHOD,
@@ -55,82 +55,89 @@ static int64_t round_up_to_three_sig_figs(int64_t x) {
   return round_up(x, 10000000);
 }
 
-/* encode our minimum viable timeout value */
-static void enc_tiny(char *buffer) { memcpy(buffer, "1n", 3); }
-
-static void enc_ext(char *buffer, int64_t value, char ext) {
-  int n = int64_ttoa(value, buffer);
-  buffer[n] = ext;
-  buffer[n + 1] = 0;
+static grpc_http2_timeout mk_timeout(int64_t value, char unit) {
+  grpc_http2_timeout result = {value, unit};
+  return result;
 }
 
-static void enc_seconds(char *buffer, int64_t sec) {
+static grpc_http2_timeout quantize_seconds(int64_t sec) {
   if (sec % 3600 == 0) {
-    enc_ext(buffer, sec / 3600, 'H');
+    return mk_timeout(sec / 3600, 'H');
   } else if (sec % 60 == 0) {
-    enc_ext(buffer, sec / 60, 'M');
+    return mk_timeout(sec / 60, 'M');
   } else {
-    enc_ext(buffer, sec, 'S');
+    return mk_timeout(sec, 'S');
   }
 }
 
-static void enc_nanos(char *buffer, int64_t x) {
+static grpc_http2_timeout quantize_nanos(int64_t x) {
   x = round_up_to_three_sig_figs(x);
   if (x < 100000) {
     if (x % 1000 == 0) {
-      enc_ext(buffer, x / 1000, 'u');
+      return mk_timeout(x / 1000, 'u');
     } else {
-      enc_ext(buffer, x, 'n');
+      return mk_timeout(x, 'n');
     }
   } else if (x < 100000000) {
     if (x % 1000000 == 0) {
-      enc_ext(buffer, x / 1000000, 'm');
+      return mk_timeout(x / 1000000, 'm');
     } else {
-      enc_ext(buffer, x / 1000, 'u');
+      return mk_timeout(x / 1000, 'u');
     }
   } else if (x < 1000000000) {
-    enc_ext(buffer, x / 1000000, 'm');
+    return mk_timeout(x / 1000000, 'm');
   } else {
     /* note that this is only ever called with times of less than one second,
        so if we reach here the time must have been rounded up to a whole second
        (and no more) */
-    memcpy(buffer, "1S", 3);
+    return mk_timeout(1, 'S');
   }
 }
 
-static void enc_micros(char *buffer, int64_t x) {
+static grpc_http2_timeout quantize_micros(int64_t x) {
   x = round_up_to_three_sig_figs(x);
   if (x < 100000) {
     if (x % 1000 == 0) {
-      enc_ext(buffer, x / 1000, 'm');
+      return mk_timeout(x / 1000, 'm');
     } else {
-      enc_ext(buffer, x, 'u');
+      return mk_timeout(x, 'u');
     }
   } else if (x < 100000000) {
     if (x % 1000000 == 0) {
-      enc_ext(buffer, x / 1000000, 'S');
+      return mk_timeout(x / 1000000, 'S');
     } else {
-      enc_ext(buffer, x / 1000, 'm');
+      return mk_timeout(x / 1000, 'm');
     }
   } else {
-    enc_ext(buffer, x / 1000000, 'S');
+    return mk_timeout(x / 1000000, 'S');
   }
 }
 
-void grpc_http2_encode_timeout(gpr_timespec timeout, char *buffer) {
+grpc_http2_timeout grpc_http2_quantize_timeout(gpr_timespec timeout) {
   if (timeout.tv_sec < 0) {
-    enc_tiny(buffer);
+    /* our minimum viable timeout value */
+    return mk_timeout(1, 'n');
   } else if (timeout.tv_sec == 0) {
-    enc_nanos(buffer, timeout.tv_nsec);
+    return quantize_nanos(timeout.tv_nsec);
   } else if (timeout.tv_sec < 1000 && timeout.tv_nsec != 0) {
-    enc_micros(buffer,
-               (int64_t)(timeout.tv_sec * 1000000) +
-                   (timeout.tv_nsec / 1000 + (timeout.tv_nsec % 1000 != 0)));
+    return quantize_micros(
+        (int64_t)(timeout.tv_sec * 1000000) +
+        (timeout.tv_nsec / 1000 + (timeout.tv_nsec % 1000 != 0)));
   } else {
-    enc_seconds(buffer, timeout.tv_sec + (timeout.tv_nsec != 0));
+    return quantize_seconds(timeout.tv_sec + (timeout.tv_nsec != 0));
   }
 }
 
+void grpc_http2_timeout_to_string(grpc_http2_timeout timeout, char *buffer) {
+  int n = int64_ttoa(timeout.value, buffer);
+  buffer[n] = timeout.unit;
+  buffer[n + 1] = 0;
+}
+
+void grpc_http2_encode_timeout(gpr_timespec timeout, char *buffer) {
+  grpc_http2_timeout_to_string(grpc_http2_quantize_timeout(timeout), buffer);
+}
+
 static int is_all_whitespace(const char *p, const char *end) {
   while (p != end && *p == ' ') p++;
   return p == end;
@@ -41,8 +41,19 @@
 
 #define GRPC_HTTP2_TIMEOUT_ENCODE_MIN_BUFSIZE (GPR_LTOA_MIN_BUFSIZE + 1)
 
+/* A timeout quantized to its wire form: at most three significant figures in
+   \a value plus a unit character (one of 'n' 'u' 'm' 'S' 'M' 'H'). Equal
+   quantized timeouts encode to identical header strings, which makes the
+   pair a compact cache key for encoded timeouts. */
+typedef struct {
+  int64_t value;
+  char unit;
+} grpc_http2_timeout;
+
 /* Encode/decode timeouts to the GRPC over HTTP/2 format;
    encoding may round up arbitrarily */
+grpc_http2_timeout grpc_http2_quantize_timeout(gpr_timespec timeout);
+void grpc_http2_timeout_to_string(grpc_http2_timeout timeout, char *buffer);
 void grpc_http2_encode_timeout(gpr_timespec timeout, char *buffer);
 int grpc_http2_decode_timeout(grpc_slice text, gpr_timespec *timeout);
 
@@ -113,6 +113,22 @@ typedef struct {
   grpc_closure closure;
 } grpc_handler_private_op_data;
 
+/** Scheduling class for a stream's writes when several streams on one
+    connection are writable at once. Transports that multiplex writes may use
+    this to serve latency sensitive streams ahead of bulk transfers; it has no
+    wire visibility and no effect on a connection with a single writable
+    stream. */
+typedef enum {
+  /** default: fair share of the connection */
+  GRPC_STREAM_WRITE_PRIORITY_DEFAULT = 0,
+  /** served ahead of default streams: small, latency sensitive writes */
+  GRPC_STREAM_WRITE_PRIORITY_HIGH,
+  /** served behind default streams: large transfers that value throughput
+      over latency */
+  GRPC_STREAM_WRITE_PRIORITY_BULK,
+  GRPC_STREAM_WRITE_PRIORITY_COUNT /* must be last */
+} grpc_stream_write_priority;
+
 typedef struct grpc_transport_stream_op_batch_payload
     grpc_transport_stream_op_batch_payload;
 
@@ -169,6 +185,9 @@ struct grpc_transport_stream_op_batch_payload {
     /** Iff send_initial_metadata != NULL, flags associated with
         send_initial_metadata: a bitfield of GRPC_INITIAL_METADATA_xxx */
     uint32_t send_initial_metadata_flags;
+    /** Scheduling class for this stream's writes; zero initialized payloads
+        get GRPC_STREAM_WRITE_PRIORITY_DEFAULT. */
+    grpc_stream_write_priority write_priority;
   } send_initial_metadata;
 
   struct {
@@ -244,6 +263,10 @@ typedef struct grpc_transport_op {
   grpc_pollset_set *bind_pollset_set;
   /** send a ping, call this back if not NULL */
   grpc_closure *send_ping;
+  /** if non-zero, advertise at most this many concurrent incoming streams
+      to the peer (HTTP/2 transports push a SETTINGS update); affects stream
+      admission only - established streams are untouched */
+  uint32_t max_concurrent_streams;
 
   /***************************************************************************
    * remaining fields are initialized and used at the discretion of the
@@ -36,6 +36,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
@@ -86,6 +88,14 @@ typedef struct {
   size_t max_frame_size;
 } tsi_fake_frame_protector;
 
+typedef struct {
+  tsi_zero_copy_grpc_protector base;
+  grpc_slice_buffer header_sb;    /* bytes of a partially received header */
+  grpc_slice_buffer protected_sb; /* payload bytes of the frame being read */
+  size_t parsed_frame_size;       /* 0 until the current header is complete */
+  size_t max_frame_size;
+} tsi_fake_zero_copy_grpc_protector;
+
 /* --- Utils. ---*/
 
 static const char *tsi_fake_handshake_message_strings[] = {
@@ -373,6 +383,7 @@ static void fake_protector_destroy(tsi_frame_protector *self) {
 static const tsi_frame_protector_vtable frame_protector_vtable = {
     fake_protector_protect, fake_protector_protect_flush,
     fake_protector_unprotect, fake_protector_destroy,
+    NULL /* protect_vec: use the generic loop-over-protect fallback */,
 };
 
 /* --- tsi_handshaker methods implementation. ---*/
@@ -526,3 +537,112 @@ tsi_frame_protector *tsi_create_fake_protector(
   impl->base.vtable = &frame_protector_vtable;
   return &impl->base;
 }
+
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---
+
+   Emits and parses the same frames as the fake frame protector, but moves
+   payload slices between slice buffers instead of copying the bytes; the
+   only copy left is the 4-byte frame header. */
+
+static tsi_result fake_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector *self, grpc_slice_buffer *unprotected_slices,
+    grpc_slice_buffer *protected_slices) {
+  tsi_fake_zero_copy_grpc_protector *impl =
+      (tsi_fake_zero_copy_grpc_protector *)self;
+  while (unprotected_slices->length > 0) {
+    size_t frame_payload_size =
+        GPR_MIN(impl->max_frame_size - TSI_FAKE_FRAME_HEADER_SIZE,
+                unprotected_slices->length);
+    grpc_slice header = grpc_slice_malloc(TSI_FAKE_FRAME_HEADER_SIZE);
+    store32_little_endian(
+        (uint32_t)(frame_payload_size + TSI_FAKE_FRAME_HEADER_SIZE),
+        GRPC_SLICE_START_PTR(header));
+    grpc_slice_buffer_add(protected_slices, header);
+    grpc_slice_buffer_move_first(unprotected_slices, frame_payload_size,
+                                 protected_slices);
+  }
+  return TSI_OK;
+}
+
+/* Copies the 4 header bytes (possibly spread over several slices) out of
+   header_sb and decodes the frame size. */
+static size_t fake_zero_copy_grpc_protector_read_frame_size(
+    const grpc_slice_buffer *header_sb) {
+  unsigned char frame_size_buffer[TSI_FAKE_FRAME_HEADER_SIZE];
+  unsigned char *cur = frame_size_buffer;
+  size_t i;
+  GPR_ASSERT(header_sb->length == TSI_FAKE_FRAME_HEADER_SIZE);
+  for (i = 0; i < header_sb->count; i++) {
+    memcpy(cur, GRPC_SLICE_START_PTR(header_sb->slices[i]),
+           GRPC_SLICE_LENGTH(header_sb->slices[i]));
+    cur += GRPC_SLICE_LENGTH(header_sb->slices[i]);
+  }
+  return load32_little_endian(frame_size_buffer);
+}
+
+static tsi_result fake_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector *self, grpc_slice_buffer *protected_slices,
+    grpc_slice_buffer *unprotected_slices) {
+  tsi_fake_zero_copy_grpc_protector *impl =
+      (tsi_fake_zero_copy_grpc_protector *)self;
+  while (protected_slices->length > 0) {
+    if (impl->parsed_frame_size == 0) {
+      size_t needed = TSI_FAKE_FRAME_HEADER_SIZE - impl->header_sb.length;
+      if (protected_slices->length < needed) {
+        grpc_slice_buffer_move_into(protected_slices, &impl->header_sb);
+        break;
+      }
+      grpc_slice_buffer_move_first(protected_slices, needed, &impl->header_sb);
+      impl->parsed_frame_size =
+          fake_zero_copy_grpc_protector_read_frame_size(&impl->header_sb);
+      grpc_slice_buffer_reset_and_unref(&impl->header_sb);
+      if (impl->parsed_frame_size <= TSI_FAKE_FRAME_HEADER_SIZE) {
+        gpr_log(GPR_ERROR, "Invalid frame size.");
+        return TSI_DATA_CORRUPTED;
+      }
+    }
+    {
+      size_t payload_remaining = impl->parsed_frame_size -
+                                 TSI_FAKE_FRAME_HEADER_SIZE -
+                                 impl->protected_sb.length;
+      if (protected_slices->length < payload_remaining) {
+        grpc_slice_buffer_move_into(protected_slices, &impl->protected_sb);
+        break;
+      }
+      grpc_slice_buffer_move_first(protected_slices, payload_remaining,
+                                   &impl->protected_sb);
+      /* Frame complete: hand its payload to the caller without copying. */
+      grpc_slice_buffer_move_into(&impl->protected_sb, unprotected_slices);
+      impl->parsed_frame_size = 0;
+    }
+  }
+  return TSI_OK;
+}
+
+static void fake_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector *self) {
+  tsi_fake_zero_copy_grpc_protector *impl =
+      (tsi_fake_zero_copy_grpc_protector *)self;
+  grpc_slice_buffer_destroy(&impl->header_sb);
+  grpc_slice_buffer_destroy(&impl->protected_sb);
+  gpr_free(impl);
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        fake_zero_copy_grpc_protector_protect,
+        fake_zero_copy_grpc_protector_unprotect,
+        fake_zero_copy_grpc_protector_destroy,
+};
+
+tsi_zero_copy_grpc_protector *tsi_create_fake_zero_copy_grpc_protector(
+    size_t *max_protected_frame_size) {
+  tsi_fake_zero_copy_grpc_protector *impl = gpr_zalloc(sizeof(*impl));
+  grpc_slice_buffer_init(&impl->header_sb);
+  grpc_slice_buffer_init(&impl->protected_sb);
+  impl->max_frame_size = (max_protected_frame_size == NULL)
+                             ? TSI_FAKE_DEFAULT_FRAME_SIZE
+                             : *max_protected_frame_size;
+  impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  return &impl->base;
+}
@@ -50,6 +50,7 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd.h>
 #include <grpc/support/useful.h>
@@ -117,11 +118,40 @@ typedef struct {
   size_t buffer_offset;
 } tsi_ssl_frame_protector;
 
+/* An entry of the client session cache. Entries form a doubly-linked list
+   ordered from most to least recently used. Entries are keyed by the
+   (ssl_context, server_name) pair: the SSL_CTX identifies the client
+   handshaker factory (and thereby its credentials - roots, client certs),
+   so sessions are never resumed across different credentials that happen
+   to target the same hostname.  */
+typedef struct tsi_ssl_session_cache_entry {
+  /* identity of the creating factory; not owned. Entries are purged when
+     the factory is destroyed, so this never dangles. */
+  SSL_CTX *ssl_context;
+  char *server_name;
+  SSL_SESSION *session;
+  struct tsi_ssl_session_cache_entry *prev;
+  struct tsi_ssl_session_cache_entry *next;
+} tsi_ssl_session_cache_entry;
+
 /* --- Library Initialization. ---*/
 
 static gpr_once init_openssl_once = GPR_ONCE_INIT;
 static gpr_mu *openssl_mutexes = NULL;
 
+/* Client session cache state. Protected by g_session_cache_mu. */
+static gpr_mu g_session_cache_mu;
+static tsi_ssl_session_cache_entry *g_session_cache_head = NULL;
+static tsi_ssl_session_cache_entry *g_session_cache_tail = NULL;
+static size_t g_session_cache_size = 0;
+static size_t g_session_cache_capacity = TSI_SSL_SESSION_CACHE_DEFAULT_CAPACITY;
+static size_t g_session_cache_hits = 0;
+static size_t g_session_cache_misses = 0;
+
+/* SSL ex_data index under which client handshakers store the server name used
+   to key the session cache (a gpr-allocated string owned by the SSL object). */
+static int g_ssl_session_key_index = -1;
+
 static void openssl_locking_cb(int mode, int type, const char *file, int line) {
   if (mode & CRYPTO_LOCK) {
     gpr_mu_lock(&openssl_mutexes[type]);
@@ -134,6 +164,11 @@ static unsigned long openssl_thread_id_cb(void) {
   return (unsigned long)gpr_thd_currentid();
 }
 
+static void ssl_session_key_destroy(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                    int index, long argl, void *argp) {
+  gpr_free(ptr);
+}
+
 static void init_openssl(void) {
   int i;
   int num_locks;
@@ -148,6 +183,155 @@ static void init_openssl(void) {
   }
   CRYPTO_set_locking_callback(openssl_locking_cb);
   CRYPTO_set_id_callback(openssl_thread_id_cb);
+  gpr_mu_init(&g_session_cache_mu);
+  g_ssl_session_key_index =
+      SSL_get_ex_new_index(0, NULL, NULL, NULL, ssl_session_key_destroy);
+  GPR_ASSERT(g_ssl_session_key_index != -1);
+}
+
+/* --- Client session cache methods implementation. ---*/
+
+/* Unlinks an entry from the LRU list. Requires g_session_cache_mu. */
+static void session_cache_unlink_locked(tsi_ssl_session_cache_entry *entry) {
+  if (entry->prev != NULL) entry->prev->next = entry->next;
+  if (entry->next != NULL) entry->next->prev = entry->prev;
+  if (g_session_cache_head == entry) g_session_cache_head = entry->next;
+  if (g_session_cache_tail == entry) g_session_cache_tail = entry->prev;
+  entry->prev = NULL;
+  entry->next = NULL;
+}
+
+/* Links an entry at the most recently used end of the LRU list. Requires
+   g_session_cache_mu. */
+static void session_cache_push_front_locked(
+    tsi_ssl_session_cache_entry *entry) {
+  entry->next = g_session_cache_head;
+  if (g_session_cache_head != NULL) g_session_cache_head->prev = entry;
+  g_session_cache_head = entry;
+  if (g_session_cache_tail == NULL) g_session_cache_tail = entry;
+}
+
+static void session_cache_entry_destroy_locked(
+    tsi_ssl_session_cache_entry *entry) {
+  SSL_SESSION_free(entry->session);
+  gpr_free(entry->server_name);
+  gpr_free(entry);
+  g_session_cache_size--;
+}
+
+/* Looks up an entry by (ssl_context, server_name). Entries are few enough
+   (bounded by the cache capacity) that a linear scan of the LRU list is
+   adequate. Requires g_session_cache_mu. */
+static tsi_ssl_session_cache_entry *session_cache_find_locked(
+    const SSL_CTX *ssl_context, const char *server_name) {
+  tsi_ssl_session_cache_entry *entry;
+  for (entry = g_session_cache_head; entry != NULL; entry = entry->next) {
+    if (entry->ssl_context == ssl_context &&
+        strcmp(entry->server_name, server_name) == 0) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+/* Evicts least recently used entries until the cache fits the capacity.
+   Requires g_session_cache_mu. */
+static void session_cache_shrink_locked(void) {
+  while (g_session_cache_size > g_session_cache_capacity) {
+    tsi_ssl_session_cache_entry *entry = g_session_cache_tail;
+    session_cache_unlink_locked(entry);
+    session_cache_entry_destroy_locked(entry);
+  }
+}
+
+/* Stores a session under the given key, replacing any previously cached
+   session for that key. Takes ownership of a reference to session. */
+static void session_cache_put(SSL_CTX *ssl_context, const char *server_name,
+                              SSL_SESSION *session) {
+  tsi_ssl_session_cache_entry *entry;
+  gpr_mu_lock(&g_session_cache_mu);
+  if (g_session_cache_capacity == 0) {
+    gpr_mu_unlock(&g_session_cache_mu);
+    SSL_SESSION_free(session);
+    return;
+  }
+  entry = session_cache_find_locked(ssl_context, server_name);
+  if (entry != NULL) {
+    SSL_SESSION_free(entry->session);
+    entry->session = session;
+    session_cache_unlink_locked(entry);
+  } else {
+    entry = gpr_zalloc(sizeof(*entry));
+    entry->ssl_context = ssl_context;
+    entry->server_name = gpr_strdup(server_name);
+    entry->session = session;
+    g_session_cache_size++;
+  }
+  session_cache_push_front_locked(entry);
+  session_cache_shrink_locked();
+  gpr_mu_unlock(&g_session_cache_mu);
+}
+
+/* Offers the session cached under \a ssl's context and the given server name
+   (if any) to ssl for resumption. SSL_set_session takes its own reference on
+   the session so the cached session stays valid even if evicted right
+   after. */
+static void session_cache_resume(SSL *ssl, const char *server_name) {
+  tsi_ssl_session_cache_entry *entry;
+  gpr_mu_lock(&g_session_cache_mu);
+  entry = session_cache_find_locked(SSL_get_SSL_CTX(ssl), server_name);
+  if (entry != NULL) {
+    SSL_set_session(ssl, entry->session);
+    session_cache_unlink_locked(entry);
+    session_cache_push_front_locked(entry);
+    g_session_cache_hits++;
+  } else {
+    g_session_cache_misses++;
+  }
+  gpr_mu_unlock(&g_session_cache_mu);
+}
+
+/* New-session callback installed on client SSL contexts. Fires for both
+   session-ID and ticket based sessions. Returning 1 transfers ownership of
+   the session reference to the cache. */
+static int ssl_client_new_session_callback(SSL *ssl, SSL_SESSION *session) {
+  const char *server_name = SSL_get_ex_data(ssl, g_ssl_session_key_index);
+  if (server_name == NULL) return 0;
+  session_cache_put(SSL_get_SSL_CTX(ssl), server_name, session);
+  return 1;
+}
+
+/* Drops every cached session belonging to \a ssl_context; called when the
+   owning client handshaker factory is destroyed. */
+static void session_cache_purge_context(const SSL_CTX *ssl_context) {
+  tsi_ssl_session_cache_entry *entry;
+  gpr_mu_lock(&g_session_cache_mu);
+  entry = g_session_cache_head;
+  while (entry != NULL) {
+    tsi_ssl_session_cache_entry *next = entry->next;
+    if (entry->ssl_context == ssl_context) {
+      session_cache_unlink_locked(entry);
+      session_cache_entry_destroy_locked(entry);
+    }
+    entry = next;
+  }
+  gpr_mu_unlock(&g_session_cache_mu);
+}
+
+void tsi_ssl_session_cache_set_capacity(size_t capacity) {
+  gpr_once_init(&init_openssl_once, init_openssl);
+  gpr_mu_lock(&g_session_cache_mu);
+  g_session_cache_capacity = capacity;
+  session_cache_shrink_locked();
+  gpr_mu_unlock(&g_session_cache_mu);
+}
+
+void tsi_ssl_session_cache_get_stats(size_t *hits, size_t *misses) {
+  gpr_once_init(&init_openssl_once, init_openssl);
+  gpr_mu_lock(&g_session_cache_mu);
+  if (hits != NULL) *hits = g_session_cache_hits;
+  if (misses != NULL) *misses = g_session_cache_misses;
+  gpr_mu_unlock(&g_session_cache_mu);
 }
 
 /* --- Ssl utils. ---*/
@@ -778,6 +962,81 @@ static tsi_result ssl_protector_protect(tsi_frame_protector *self,
   return TSI_OK;
 }
 
+static tsi_result ssl_protector_protect_vec(
+    tsi_frame_protector *self, const tsi_iovec *unprotected_vec,
+    size_t unprotected_vec_count, size_t *unprotected_bytes_consumed,
+    unsigned char *protected_output_frames,
+    size_t *protected_output_frames_size) {
+  tsi_ssl_frame_protector *impl = (tsi_ssl_frame_protector *)self;
+  size_t output_size = *protected_output_frames_size;
+  size_t output_offset = 0;
+  size_t consumed = 0;
+  tsi_result result = TSI_OK;
+  int read_from_ssl;
+  int pending_in_ssl;
+  size_t i;
+
+  /* First drain any frames already pending in the SSL BIO. */
+  pending_in_ssl = (int)BIO_pending(impl->from_ssl);
+  if (pending_in_ssl > 0) {
+    GPR_ASSERT(output_size <= INT_MAX);
+    read_from_ssl =
+        BIO_read(impl->from_ssl, protected_output_frames, (int)output_size);
+    if (read_from_ssl < 0) {
+      gpr_log(GPR_ERROR,
+              "Could not read from BIO even though some data is pending");
+      return TSI_INTERNAL_ERROR;
+    }
+    output_offset = (size_t)read_from_ssl;
+  }
+
+  /* Then accumulate the chunks into our internal buffer, sealing a max-size
+     record each time it fills. One call consumes the whole vector, however
+     the plaintext was sliced. */
+  for (i = 0; i < unprotected_vec_count && result == TSI_OK; i++) {
+    const unsigned char *bytes = unprotected_vec[i].data;
+    size_t size = unprotected_vec[i].size;
+    while (size > 0) {
+      size_t available = impl->buffer_size - impl->buffer_offset;
+      if (available > size) {
+        /* Buffer the tail of this chunk and move on to the next one. */
+        memcpy(impl->buffer + impl->buffer_offset, bytes, size);
+        impl->buffer_offset += size;
+        consumed += size;
+        break;
+      }
+      /* We can seal a complete frame, provided there is room for it in the
+         output; otherwise stop and let the caller drain the output. */
+      if (output_size == output_offset) {
+        result = TSI_OK;
+        goto done;
+      }
+      memcpy(impl->buffer + impl->buffer_offset, bytes, available);
+      result = do_ssl_write(impl->ssl, impl->buffer, impl->buffer_size);
+      if (result != TSI_OK) goto done;
+      impl->buffer_offset = 0;
+      bytes += available;
+      size -= available;
+      consumed += available;
+      GPR_ASSERT(output_size - output_offset <= INT_MAX);
+      read_from_ssl = BIO_read(impl->from_ssl,
+                               protected_output_frames + output_offset,
+                               (int)(output_size - output_offset));
+      if (read_from_ssl < 0) {
+        gpr_log(GPR_ERROR, "Could not read from BIO after SSL_write.");
+        result = TSI_INTERNAL_ERROR;
+        goto done;
+      }
+      output_offset += (size_t)read_from_ssl;
+    }
+  }
+
+done:
+  *unprotected_bytes_consumed = consumed;
+  *protected_output_frames_size = output_offset;
+  return result;
+}
+
 static tsi_result ssl_protector_protect_flush(
     tsi_frame_protector *self, unsigned char *protected_output_frames,
     size_t *protected_output_frames_size, size_t *still_pending_size) {
@@ -862,7 +1121,7 @@ static void ssl_protector_destroy(tsi_frame_protector *self) {
 
 static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_protect, ssl_protector_protect_flush, ssl_protector_unprotect,
-    ssl_protector_destroy,
+    ssl_protector_destroy, ssl_protector_protect_vec,
 };
 
 /* --- tsi_handshaker methods implementation. ---*/
@@ -1084,6 +1343,14 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX *ctx, int is_client,
         SSL_free(ssl);
         return TSI_INTERNAL_ERROR;
       }
+      /* Key the session cache by (context, server name): offer any session
+         cached for this factory and name for resumption, and arrange for
+         the session negotiated by this handshake to be cached under the
+         same key (the string is owned by the SSL object via the ex_data
+         destructor). */
+      SSL_set_ex_data(ssl, g_ssl_session_key_index,
+                      gpr_strdup(server_name_indication));
+      session_cache_resume(ssl, server_name_indication);
     }
     ssl_result = SSL_do_handshake(ssl);
     ssl_result = SSL_get_error(ssl, ssl_result);
@@ -1145,7 +1412,12 @@ tsi_result tsi_ssl_client_handshaker_factory_create_handshaker(
 
 void tsi_ssl_client_handshaker_factory_destroy(
     tsi_ssl_client_handshaker_factory *self) {
-  if (self->ssl_context != NULL) SSL_CTX_free(self->ssl_context);
+  if (self->ssl_context != NULL) {
+    /* sessions negotiated under this factory's credentials must not outlive
+       it (a later factory could otherwise alias the same context address) */
+    session_cache_purge_context(self->ssl_context);
+    SSL_CTX_free(self->ssl_context);
+  }
   if (self->alpn_protocol_list != NULL) gpr_free(self->alpn_protocol_list);
   gpr_free(self);
 }
@@ -1306,6 +1578,15 @@ tsi_result tsi_create_ssl_client_handshaker_factory(
   impl = gpr_zalloc(sizeof(*impl));
   impl->ssl_context = ssl_context;
 
+  /* Hand negotiated sessions to the process-wide session cache instead of the
+     per-context internal cache so that later connections from this factory
+     can resume them; the cache keys on this context, so sessions never leak
+     across factories with different credentials. */
+  SSL_CTX_set_session_cache_mode(ssl_context,
+                                 SSL_SESS_CACHE_CLIENT |
+                                     SSL_SESS_CACHE_NO_INTERNAL);
+  SSL_CTX_sess_set_new_cb(ssl_context, ssl_client_new_session_callback);
+
   do {
     result =
         populate_ssl_context(ssl_context, pem_key_cert_pair, cipher_suites);
@@ -116,6 +116,29 @@ tsi_result tsi_ssl_client_handshaker_factory_create_handshaker(
 void tsi_ssl_client_handshaker_factory_destroy(
     tsi_ssl_client_handshaker_factory *self);
 
+/* --- SSL session cache. ---
+
+   Client handshakers created with a server name indication record the session
+   negotiated with the peer in a process-wide cache keyed by that name, and
+   subsequent handshakers for the same name offer the cached session for
+   resumption (abbreviated handshake). Both session-ID and session-ticket
+   resumption are supported since the cache stores whatever session object the
+   SSL library hands back. The cache is shared by all client handshaker
+   factories in the process.  */
+
+/* Default number of sessions retained by the session cache. */
+#define TSI_SSL_SESSION_CACHE_DEFAULT_CAPACITY 1024
+
+/* Sets the maximum number of sessions retained by the session cache. Least
+   recently used sessions are evicted first. A capacity of 0 disables caching
+   and flushes all currently cached sessions.  */
+void tsi_ssl_session_cache_set_capacity(size_t capacity);
+
+/* Returns the number of session cache lookups that found (resp. did not find)
+   a cached session for the requested server name. Either parameter may be
+   NULL.  */
+void tsi_ssl_session_cache_get_stats(size_t *hits, size_t *misses);
+
 /* --- tsi_ssl_server_handshaker_factory object ---
 
    This object creates a client tsi_handshaker objects implemented in terms of
@@ -102,6 +102,60 @@ tsi_result tsi_frame_protector_protect(tsi_frame_protector *self,
                                protected_output_frames_size);
 }
 
+tsi_result tsi_frame_protector_protect_vectored(
+    tsi_frame_protector *self, const tsi_iovec *unprotected_vec,
+    size_t unprotected_vec_count, size_t *unprotected_bytes_consumed,
+    unsigned char *protected_output_frames,
+    size_t *protected_output_frames_size) {
+  size_t i;
+  size_t output_size;
+  size_t output_offset = 0;
+  size_t consumed = 0;
+  tsi_result result = TSI_OK;
+  if (self == NULL || unprotected_vec == NULL ||
+      unprotected_bytes_consumed == NULL || protected_output_frames == NULL ||
+      protected_output_frames_size == NULL) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable == NULL) return TSI_UNIMPLEMENTED;
+  if (self->vtable->protect_vec != NULL) {
+    return self->vtable->protect_vec(self, unprotected_vec,
+                                     unprotected_vec_count,
+                                     unprotected_bytes_consumed,
+                                     protected_output_frames,
+                                     protected_output_frames_size);
+  }
+  if (self->vtable->protect == NULL) return TSI_UNIMPLEMENTED;
+  /* Generic fallback: drive the scalar protect over each chunk until all
+     input is consumed or the output buffer fills up. */
+  output_size = *protected_output_frames_size;
+  for (i = 0; i < unprotected_vec_count; i++) {
+    const unsigned char *bytes = unprotected_vec[i].data;
+    size_t size = unprotected_vec[i].size;
+    while (size > 0) {
+      size_t protect_output_size = output_size - output_offset;
+      size_t processed_size = size;
+      if (protect_output_size == 0) goto done;
+      result = self->vtable->protect(self, bytes, &processed_size,
+                                     protected_output_frames + output_offset,
+                                     &protect_output_size);
+      if (result != TSI_OK) goto done;
+      bytes += processed_size;
+      size -= processed_size;
+      consumed += processed_size;
+      output_offset += protect_output_size;
+      if (processed_size == 0 && protect_output_size == 0) {
+        /* No progress: the protector needs the output drained. */
+        goto done;
+      }
+    }
+  }
+done:
+  *unprotected_bytes_consumed = consumed;
+  *protected_output_frames_size = output_offset;
+  return result;
+}
+
 tsi_result tsi_frame_protector_protect_flush(
     tsi_frame_protector *self, unsigned char *protected_output_frames,
     size_t *protected_output_frames_size, size_t *still_pending_size) {
@@ -139,6 +193,39 @@ void tsi_frame_protector_destroy(tsi_frame_protector *self) {
   self->vtable->destroy(self);
 }
 
+/* --- tsi_zero_copy_grpc_protector common implementation. ---
+
+   Calls specific implementation after state/input validation. */
+
+tsi_result tsi_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector *self, grpc_slice_buffer *unprotected_slices,
+    grpc_slice_buffer *protected_slices) {
+  if (self == NULL || unprotected_slices == NULL || protected_slices == NULL) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable == NULL || self->vtable->protect == NULL) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->protect(self, unprotected_slices, protected_slices);
+}
+
+tsi_result tsi_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector *self, grpc_slice_buffer *protected_slices,
+    grpc_slice_buffer *unprotected_slices) {
+  if (self == NULL || protected_slices == NULL || unprotected_slices == NULL) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  if (self->vtable == NULL || self->vtable->unprotect == NULL) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->unprotect(self, protected_slices, unprotected_slices);
+}
+
+void tsi_zero_copy_grpc_protector_destroy(tsi_zero_copy_grpc_protector *self) {
+  if (self == NULL) return;
+  self->vtable->destroy(self);
+}
+
 /* --- tsi_handshaker common implementation. ---
 
    Calls specific implementation after state/input validation. */
@@ -254,6 +341,18 @@ tsi_result tsi_handshaker_result_create_frame_protector(
                                               protector);
 }
 
+tsi_result tsi_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result *self, size_t *max_protected_frame_size,
+    tsi_zero_copy_grpc_protector **protector) {
+  if (self == NULL || protector == NULL) return TSI_INVALID_ARGUMENT;
+  if (self->vtable == NULL ||
+      self->vtable->create_zero_copy_grpc_protector == NULL) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->create_zero_copy_grpc_protector(
+      self, max_protected_frame_size, protector);
+}
+
 tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result *self, unsigned char **bytes,
     size_t *bytes_size) {
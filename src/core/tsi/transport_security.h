@@ -63,12 +63,38 @@ typedef struct {
                           unsigned char *unprotected_bytes,
                           size_t *unprotected_bytes_size);
   void (*destroy)(tsi_frame_protector *self);
+  /* Optional native vectored protect; may be NULL (appended last so that
+     existing positional initializers leave it NULL), in which case
+     tsi_frame_protector_protect_vectored falls back to looping over
+     protect. */
+  tsi_result (*protect_vec)(tsi_frame_protector *self,
+                            const tsi_iovec *unprotected_vec,
+                            size_t unprotected_vec_count,
+                            size_t *unprotected_bytes_consumed,
+                            unsigned char *protected_output_frames,
+                            size_t *protected_output_frames_size);
 } tsi_frame_protector_vtable;
 
 struct tsi_frame_protector {
   const tsi_frame_protector_vtable *vtable;
 };
 
+/* Base for tsi_zero_copy_grpc_protector implementations.
+   See transport_security_interface.h for documentation. */
+typedef struct {
+  tsi_result (*protect)(tsi_zero_copy_grpc_protector *self,
+                        grpc_slice_buffer *unprotected_slices,
+                        grpc_slice_buffer *protected_slices);
+  tsi_result (*unprotect)(tsi_zero_copy_grpc_protector *self,
+                          grpc_slice_buffer *protected_slices,
+                          grpc_slice_buffer *unprotected_slices);
+  void (*destroy)(tsi_zero_copy_grpc_protector *self);
+} tsi_zero_copy_grpc_protector_vtable;
+
+struct tsi_zero_copy_grpc_protector {
+  const tsi_zero_copy_grpc_protector_vtable *vtable;
+};
+
 /* Base for tsi_handshaker implementations.
    See transport_security_interface.h for documentation. */
 typedef struct {
@@ -107,6 +133,13 @@ typedef struct {
   tsi_result (*get_unused_bytes)(const tsi_handshaker_result *self,
                                  unsigned char **bytes, size_t *bytes_size);
   void (*destroy)(tsi_handshaker_result *self);
+  /* Optional; may be NULL (appended last so that existing positional
+     initializers leave it NULL), in which case the dispatcher returns
+     TSI_UNIMPLEMENTED and callers fall back to create_frame_protector. */
+  tsi_result (*create_zero_copy_grpc_protector)(
+      const tsi_handshaker_result *self,
+      size_t *max_output_protected_frame_size,
+      tsi_zero_copy_grpc_protector **protector);
 } tsi_handshaker_result_vtable;
 
 struct tsi_handshaker_result {
@@ -83,6 +83,11 @@ static void adapter_result_destroy(tsi_handshaker_result *self) {
 static const tsi_handshaker_result_vtable result_vtable = {
     adapter_result_extract_peer, adapter_result_create_frame_protector,
     adapter_result_get_unused_bytes, adapter_result_destroy,
+    /* create_zero_copy_grpc_protector: the wrapped legacy handshaker only
+       knows byte-copying frame protectors, so the dispatcher's
+       TSI_UNIMPLEMENTED answer (and the caller-side fallback to
+       create_frame_protector) is the correct adaptation */
+    NULL,
 };
 
 /* Ownership of wrapped tsi_handshaker is transferred to the result object.  */
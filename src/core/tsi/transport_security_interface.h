@@ -37,6 +37,8 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <grpc/slice_buffer.h>
+
 #include "src/core/lib/debug/trace.h"
 
 #ifdef __cplusplus
@@ -143,6 +145,66 @@ tsi_result tsi_frame_protector_protect(tsi_frame_protector *self,
                                        unsigned char *protected_output_frames,
                                        size_t *protected_output_frames_size);
 
+/* A contiguous run of unprotected bytes, for vectored protect calls. */
+typedef struct {
+  const unsigned char *data;
+  size_t size;
+} tsi_iovec;
+
+/* Vectored variant of tsi_frame_protector_protect.
+   - unprotected_vec points to unprotected_vec_count chunks of data to be
+     protected, consumed in order.
+   - unprotected_bytes_consumed is an output parameter set to the total number
+     of input bytes consumed during the call, across all chunks.
+   - protected_output_frames and protected_output_frames_size behave as in
+     tsi_frame_protector_protect.
+   The call stops early when the output buffer is full; the caller should then
+   drain the output and call again with the unconsumed remainder. As with the
+   scalar variant, consumed bytes may still be buffered in the protector and
+   the caller must finish with tsi_frame_protector_protect_flush.
+   Implementations may provide a native vectored entry point consuming all
+   chunks in one pass; otherwise this loops over the scalar protect, which
+   still saves the caller from per-chunk locking and dispatch. */
+tsi_result tsi_frame_protector_protect_vectored(
+    tsi_frame_protector *self, const tsi_iovec *unprotected_vec,
+    size_t unprotected_vec_count, size_t *unprotected_bytes_consumed,
+    unsigned char *protected_output_frames,
+    size_t *protected_output_frames_size);
+
+/* --- tsi_zero_copy_grpc_protector object ---
+
+   Like tsi_frame_protector, but operates directly on grpc_slice_buffers:
+   implementations move or reference data slices instead of copying them
+   through caller-provided byte buffers. Only protocols whose wire format
+   permits it (e.g. framing the plaintext without transforming it, or
+   ciphers that can operate in place) can implement this object; others
+   keep using the byte-oriented frame protector.  */
+
+typedef struct tsi_zero_copy_grpc_protector tsi_zero_copy_grpc_protector;
+
+/* Outputs protected frames.
+   - unprotected_slices is the unprotected data to be protected. It is fully
+     drained by the call, however it is sliced.
+   - protected_slices is the protected output frames; produced slices are
+     appended. Unlike the frame protector there is no flush: every call
+     emits complete frames for all input.  */
+tsi_result tsi_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector *self, grpc_slice_buffer *unprotected_slices,
+    grpc_slice_buffer *protected_slices);
+
+/* Outputs unprotected bytes.
+   - protected_slices is the bytes of protected frames. It is fully drained
+     by the call; bytes of an incomplete trailing frame are buffered inside
+     the protector until more data arrives.
+   - unprotected_slices is the unprotected data; produced slices are
+     appended.  */
+tsi_result tsi_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector *self, grpc_slice_buffer *protected_slices,
+    grpc_slice_buffer *unprotected_slices);
+
+/* Destroys the tsi_zero_copy_grpc_protector object.  */
+void tsi_zero_copy_grpc_protector_destroy(tsi_zero_copy_grpc_protector *self);
+
 /* Indicates that we need to flush the bytes buffered in the protector and get
    the resulting frame.
    - protected_output_frames points to a buffer allocated by the caller that
@@ -231,6 +293,15 @@ tsi_result tsi_handshaker_result_create_frame_protector(
     const tsi_handshaker_result *self, size_t *max_output_protected_frame_size,
     tsi_frame_protector **protector);
 
+/* This method creates a tsi_zero_copy_grpc_protector object. It returns
+   TSI_UNIMPLEMENTED if the negotiated protocol has no zero-copy protector,
+   in which case the caller should fall back to
+   tsi_handshaker_result_create_frame_protector.
+   The caller is responsible for destroying the protector.  */
+tsi_result tsi_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result *self, size_t *max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector **protector);
+
 /* This method returns the unused bytes from the handshake. It returns TSI_OK
    assuming there is no fatal error.
    Ownership of the bytes is retained by the handshaker result. As a
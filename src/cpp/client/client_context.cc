@@ -79,6 +79,47 @@ ClientContext::~ClientContext() {
   g_client_callbacks->Destructor(this);
 }
 
+void ClientContext::Reset() {
+  std::unique_lock<std::mutex> lock(mu_);
+  if (call_) {
+    grpc_call_unref(call_);
+    call_ = nullptr;
+  }
+  call_canceled_ = false;
+  initial_metadata_received_ = false;
+  channel_.reset();
+  auth_context_.reset();
+  recv_initial_metadata_.Reset();
+  trailing_metadata_.Reset();
+  /* caller configuration (deadline, creds, send metadata, propagation,
+     wait-for-ready/idempotency bits) survives on purpose; see the header
+     for the reuse contract */
+}
+
+ClientContextPool::~ClientContextPool() {
+  for (size_t i = 0; i < free_.size(); i++) {
+    delete free_[i];
+  }
+}
+
+ClientContext* ClientContextPool::Get() {
+  {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (!free_.empty()) {
+      ClientContext* context = free_.back();
+      free_.pop_back();
+      return context;
+    }
+  }
+  return new ClientContext;
+}
+
+void ClientContextPool::Recycle(ClientContext* context) {
+  context->Reset();
+  std::unique_lock<std::mutex> lock(mu_);
+  free_.push_back(context);
+}
+
 std::unique_ptr<ClientContext> ClientContext::FromServerContext(
     const ServerContext& context, PropagationOptions options) {
   std::unique_ptr<ClientContext> ctx(new ClientContext);
@@ -31,13 +31,18 @@
  *
  */
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
 
 #include <grpc++/channel.h>
 #include <grpc++/create_channel.h>
 #include <grpc++/impl/grpc_library.h>
 #include <grpc++/support/channel_arguments.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/cpp/client/create_channel_internal.h"
 
 namespace grpc {
@@ -62,4 +67,85 @@ std::shared_ptr<Channel> CreateCustomChannel(
                                              "Invalid credentials."));
 }
 
+namespace {
+
+/// Builds a canonical key for a (target, credentials, arguments) triple.
+/// Channel args are normalized (sorted) first so that insertion order does
+/// not defeat sharing. Pointer-valued args are keyed by address: two
+/// argument sets referencing the same underlying object compare equal,
+/// anything else does not.
+grpc::string SharedChannelKey(const grpc::string& target,
+                              const std::shared_ptr<ChannelCredentials>& creds,
+                              const ChannelArguments& args) {
+  std::ostringstream key;
+  key << target << '\x01' << creds.get();
+  grpc_channel_args unordered = args.c_channel_args();
+  grpc_channel_args* normalized = grpc_channel_args_normalize(&unordered);
+  for (size_t i = 0; i < normalized->num_args; i++) {
+    const grpc_arg* arg = &normalized->args[i];
+    key << '\x01' << arg->key << '\x02' << arg->type << '\x02';
+    switch (arg->type) {
+      case GRPC_ARG_STRING:
+        key << arg->value.string;
+        break;
+      case GRPC_ARG_INTEGER:
+        key << arg->value.integer;
+        break;
+      case GRPC_ARG_POINTER:
+        key << arg->value.pointer.p;
+        break;
+    }
+  }
+  {
+    grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+    grpc_channel_args_destroy(&exec_ctx, normalized);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+  return key.str();
+}
+
+// The cache holds weak references only; entries for dead channels are swept
+// opportunistically on insertion. Leaked (never destroyed) to dodge
+// destruction-order problems at process exit, like g_callbacks in server_cc
+std::mutex g_shared_channels_mu;
+std::map<grpc::string, std::weak_ptr<Channel>>* g_shared_channels = nullptr;
+
+}  // namespace
+
+std::shared_ptr<Channel> CreateSharedChannel(
+    const grpc::string& target,
+    const std::shared_ptr<ChannelCredentials>& creds,
+    const ChannelArguments& args) {
+  if (!creds) {
+    // Nothing worth sharing: this produces a lame channel
+    return CreateCustomChannel(target, creds, args);
+  }
+  const grpc::string key = SharedChannelKey(target, creds, args);
+
+  // Holding the lock across creation also ensures concurrent calls for the
+  // same key produce one channel rather than racing to create duplicates
+  std::lock_guard<std::mutex> lock(g_shared_channels_mu);
+  if (g_shared_channels == nullptr) {
+    g_shared_channels = new std::map<grpc::string, std::weak_ptr<Channel>>();
+  }
+  auto it = g_shared_channels->find(key);
+  if (it != g_shared_channels->end()) {
+    std::shared_ptr<Channel> existing = it->second.lock();
+    if (existing) {
+      return existing;
+    }
+  }
+  std::shared_ptr<Channel> channel = CreateCustomChannel(target, creds, args);
+  (*g_shared_channels)[key] = channel;
+  for (auto sweep = g_shared_channels->begin();
+       sweep != g_shared_channels->end();) {
+    if (sweep->second.expired()) {
+      sweep = g_shared_channels->erase(sweep);
+    } else {
+      ++sweep;
+    }
+  }
+  return channel;
+}
+
 }  // namespace grpc
@@ -38,6 +38,7 @@
 #include <grpc++/support/time.h>
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/useful.h>
 
 namespace grpc {
 
@@ -86,4 +87,45 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+CompletionQueue::NextStatus CompletionQueue::NextBatchInternal(
+    Event* events, size_t max_events, size_t* num_events,
+    gpr_timespec deadline) {
+  GPR_ASSERT(max_events > 0);
+  grpc_event raw[64];
+  if (max_events > GPR_ARRAY_SIZE(raw)) {
+    max_events = GPR_ARRAY_SIZE(raw);
+  }
+  *num_events = 0;
+  for (;;) {
+    size_t n =
+        grpc_completion_queue_next_batch(cq_, raw, max_events, deadline,
+                                         nullptr);
+    size_t out = 0;
+    for (size_t i = 0; i < n; i++) {
+      switch (raw[i].type) {
+        case GRPC_QUEUE_TIMEOUT:
+          return TIMEOUT;
+        case GRPC_QUEUE_SHUTDOWN:
+          return SHUTDOWN;
+        case GRPC_OP_COMPLETE:
+          auto cq_tag = static_cast<CompletionQueueTag*>(raw[i].tag);
+          bool ok = raw[i].success != 0;
+          void* tag = cq_tag;
+          if (cq_tag->FinalizeResult(&tag, &ok)) {
+            events[out].tag = tag;
+            events[out].ok = ok;
+            out++;
+          }
+          break;
+      }
+    }
+    if (out > 0) {
+      *num_events = out;
+      return GOT_EVENT;
+    }
+    // Every completion in the batch was swallowed by FinalizeResult; go back
+    // and wait for more.
+  }
+}
+
 }  // namespace grpc
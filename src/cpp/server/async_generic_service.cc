@@ -33,10 +33,58 @@
 
 #include <grpc++/generic/async_generic_service.h>
 
+#include <grpc++/impl/codegen/slice.h>
 #include <grpc++/server.h>
+#include <grpc/slice.h>
 
 namespace grpc {
 
+GenericServerContext::~GenericServerContext() {
+  if (has_call_details_) {
+    grpc_slice_unref(method_slice_);
+    grpc_slice_unref(host_slice_);
+  }
+}
+
+void GenericServerContext::TakeCallDetails(grpc_slice method, grpc_slice host) {
+  if (has_call_details_) {
+    grpc_slice_unref(method_slice_);
+    grpc_slice_unref(host_slice_);
+  }
+  method_slice_ = method;
+  host_slice_ = host;
+  has_call_details_ = true;
+  materialized_ = false;
+}
+
+const grpc::string& GenericServerContext::method() const {
+  if (!materialized_ && has_call_details_) {
+    method_ = StringFromCopiedSlice(method_slice_);
+    host_ = StringFromCopiedSlice(host_slice_);
+    materialized_ = true;
+  }
+  return method_;
+}
+
+const grpc::string& GenericServerContext::host() const {
+  method();  // materializes both strings
+  return host_;
+}
+
+string_ref GenericServerContext::method_ref() const {
+  if (!has_call_details_) return string_ref();
+  return string_ref(
+      reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(method_slice_)),
+      GRPC_SLICE_LENGTH(method_slice_));
+}
+
+string_ref GenericServerContext::host_ref() const {
+  if (!has_call_details_) return string_ref();
+  return string_ref(
+      reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(host_slice_)),
+      GRPC_SLICE_LENGTH(host_slice_));
+}
+
 void AsyncGenericService::RequestCall(
     GenericServerContext* ctx, GenericServerAsyncReaderWriter* reader_writer,
     CompletionQueue* call_cq, ServerCompletionQueue* notification_cq,
@@ -37,11 +37,24 @@
 #include <thread>
 
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/tls.h>
 
 namespace grpc {
 
+namespace {
+
+// Points at the DynamicThread the current thread is running, if any, so
+// that Add() can push onto the local deque when called from a pool thread.
+GPR_TLS_DECL(g_this_dynamic_thread);
+gpr_once g_tls_once = GPR_ONCE_INIT;
+void InitDynamicThreadTls(void) { gpr_tls_init(&g_this_dynamic_thread); }
+
+}  // namespace
+
 DynamicThreadPool::DynamicThread::DynamicThread(DynamicThreadPool* pool)
     : pool_(pool),
+      signaled_(false),
       thd_(new std::thread(&DynamicThreadPool::DynamicThread::ThreadFunc,
                            this)) {}
 DynamicThreadPool::DynamicThread::~DynamicThread() {
@@ -50,10 +63,11 @@ DynamicThreadPool::DynamicThread::~DynamicThread() {
 }
 
 void DynamicThreadPool::DynamicThread::ThreadFunc() {
-  pool_->ThreadFunc();
+  pool_->ThreadFunc(this);
   // Now that we have killed ourselves, we should reduce the thread count
   std::unique_lock<std::mutex> lock(pool_->mu_);
   pool_->nthreads_--;
+  pool_->threads_.remove(this);
   // Move ourselves to dead list
   pool_->dead_threads_.push_back(this);
 
@@ -62,30 +76,90 @@ void DynamicThreadPool::DynamicThread::ThreadFunc() {
   }
 }
 
-void DynamicThreadPool::ThreadFunc() {
+bool DynamicThreadPool::PopWork(DynamicThread* thd, std::function<void()>* cb,
+                                bool* more) {
+  // Local deque first, from the LIFO end: the most recently pushed
+  // callback is the cache-warmest.
+  {
+    std::lock_guard<std::mutex> lock(thd->queue_mu_);
+    if (!thd->queue_.empty()) {
+      *cb = thd->queue_.back();
+      thd->queue_.pop_back();
+      *more = !thd->queue_.empty();
+      return true;
+    }
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!callbacks_.empty()) {
+    *cb = callbacks_.front();
+    callbacks_.pop();
+    *more = !callbacks_.empty();
+    return true;
+  }
+  // Steal from the FIFO end of another worker's deque.  Threads are only
+  // deleted under mu_, so scanning the live list here is safe.
+  for (auto t = threads_.begin(); t != threads_.end(); ++t) {
+    DynamicThread* victim = *t;
+    if (victim == thd) continue;
+    std::lock_guard<std::mutex> vlock(victim->queue_mu_);
+    if (!victim->queue_.empty()) {
+      *cb = victim->queue_.front();
+      victim->queue_.pop_front();
+      // Leave whatever remains to the victim; it is warm there.
+      *more = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+void DynamicThreadPool::ThreadFunc(DynamicThread* thd) {
+  gpr_tls_set(&g_this_dynamic_thread, (intptr_t)thd);
   for (;;) {
-    // Wait until work is available or we are shutting down.
-    std::unique_lock<std::mutex> lock(mu_);
-    if (!shutdown_ && callbacks_.empty()) {
-      // If there are too many threads waiting, then quit this thread
-      if (threads_waiting_ >= reserve_threads_) {
-        break;
+    std::function<void()> cb;
+    bool more = false;
+    if (PopWork(thd, &cb, &more)) {
+      if (more) {
+        // There is still queued work, so wake (at most) one parked peer
+        // to help; it will wake another in turn if work keeps coming.
+        // This propagates wakeups one at a time instead of broadcasting.
+        std::lock_guard<std::mutex> lock(mu_);
+        WakeOneIdleLocked();
       }
-      threads_waiting_++;
-      cv_.wait(lock);
-      threads_waiting_--;
+      cb();
+      continue;
     }
-    // Drain callbacks before considering shutdown to ensure all work
-    // gets completed.
+    // Nothing anywhere: park (or retire), unless we lost a race with an
+    // enqueue or we are shutting down.
+    std::unique_lock<std::mutex> lock(mu_);
     if (!callbacks_.empty()) {
-      auto cb = callbacks_.front();
-      callbacks_.pop();
-      lock.unlock();
-      cb();
-    } else if (shutdown_) {
+      continue;
+    }
+    if (shutdown_) {
+      break;
+    }
+    // If there are too many threads waiting, then quit this thread
+    if (threads_waiting_ >= reserve_threads_) {
       break;
     }
+    threads_waiting_++;
+    thd->signaled_ = false;
+    idle_.push_back(thd);
+    while (!thd->signaled_ && !shutdown_) {
+      thd->cv_.wait(lock);
+    }
+    threads_waiting_--;
+    if (!thd->signaled_) {
+      // Woken by shutdown rather than by work: drop out of the idle stack.
+      for (auto it = idle_.begin(); it != idle_.end(); ++it) {
+        if (*it == thd) {
+          idle_.erase(it);
+          break;
+        }
+      }
+    }
   }
+  gpr_tls_set(&g_this_dynamic_thread, 0);
 }
 
 DynamicThreadPool::DynamicThreadPool(int reserve_threads)
@@ -93,10 +167,10 @@ DynamicThreadPool::DynamicThreadPool(int reserve_threads)
       reserve_threads_(reserve_threads),
       nthreads_(0),
       threads_waiting_(0) {
+  gpr_once_init(&g_tls_once, InitDynamicThreadTls);
   for (int i = 0; i < reserve_threads_; i++) {
     std::lock_guard<std::mutex> lock(mu_);
-    nthreads_++;
-    new DynamicThread(this);
+    SpawnThreadLocked();
   }
 }
 
@@ -109,24 +183,52 @@ void DynamicThreadPool::ReapThreads(std::list<DynamicThread*>* tlist) {
 DynamicThreadPool::~DynamicThreadPool() {
   std::unique_lock<std::mutex> lock(mu_);
   shutdown_ = true;
-  cv_.notify_all();
+  // Wake every parked thread on its private condvar; each removes itself
+  // from the idle stack as it leaves.
+  for (auto t = idle_.begin(); t != idle_.end(); ++t) {
+    (*t)->cv_.notify_one();
+  }
   while (nthreads_ != 0) {
     shutdown_cv_.wait(lock);
   }
   ReapThreads(&dead_threads_);
 }
 
+void DynamicThreadPool::WakeOneIdleLocked() {
+  if (!idle_.empty()) {
+    DynamicThread* thd = idle_.back();
+    idle_.pop_back();
+    thd->signaled_ = true;
+    thd->cv_.notify_one();
+  }
+}
+
+void DynamicThreadPool::SpawnThreadLocked() {
+  nthreads_++;
+  threads_.push_back(new DynamicThread(this));
+}
+
 void DynamicThreadPool::Add(const std::function<void()>& callback) {
+  DynamicThread* self =
+      reinterpret_cast<DynamicThread*>(gpr_tls_get(&g_this_dynamic_thread));
+  const bool local = self != nullptr && self->pool_ == this;
+  if (local) {
+    // Called from one of our own workers: push onto its deque.  The owner
+    // pops this LIFO; an idle peer woken below can steal it if the owner
+    // stays busy.
+    std::lock_guard<std::mutex> lock(self->queue_mu_);
+    self->queue_.push_back(callback);
+  }
   std::lock_guard<std::mutex> lock(mu_);
-  // Add works to the callbacks list
-  callbacks_.push(callback);
-  // Increase pool size or notify as needed
-  if (threads_waiting_ == 0) {
+  if (!local) {
+    callbacks_.push(callback);
+  }
+  // Wake a single parked thread, or grow the pool if nobody is waiting.
+  if (!idle_.empty()) {
+    WakeOneIdleLocked();
+  } else if (threads_waiting_ == 0) {
     // Kick off a new thread
-    nthreads_++;
-    new DynamicThread(this);
-  } else {
-    cv_.notify_one();
+    SpawnThreadLocked();
   }
   // Also use this chance to harvest dead threads
   if (!dead_threads_.empty()) {
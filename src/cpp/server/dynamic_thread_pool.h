@@ -35,11 +35,13 @@
 #define GRPC_INTERNAL_CPP_DYNAMIC_THREAD_POOL_H
 
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include <grpc++/support/config.h>
 
@@ -47,6 +49,14 @@
 
 namespace grpc {
 
+// A work-stealing thread pool.  Each worker owns a deque of callbacks:
+// the owner pushes and pops at the back (LIFO, so the most recently
+// pushed - and cache-warmest - callback runs first), while idle workers
+// steal from the front.  Callbacks added from threads outside the pool
+// land on a shared injection queue.  Idle workers park on private
+// condition variables and are woken one at a time, each waking another
+// peer only if more work remains, so an enqueue never broadcasts to
+// every waiting thread.
 class DynamicThreadPool final : public ThreadPoolInterface {
  public:
   explicit DynamicThreadPool(int reserve_threads);
@@ -61,21 +71,39 @@ class DynamicThreadPool final : public ThreadPoolInterface {
     ~DynamicThread();
 
    private:
+    friend class DynamicThreadPool;
     DynamicThreadPool* pool_;
+    // Local work deque: only the owning thread pushes; other workers
+    // steal from the front.  Guarded by queue_mu_, which is virtually
+    // always uncontended.
+    std::mutex queue_mu_;
+    std::deque<std::function<void()>> queue_;
+    // Private parking spot.  signaled_ is guarded by the pool's mu_ and
+    // distinguishes a work wakeup from a shutdown wakeup.
+    std::condition_variable cv_;
+    bool signaled_;
     std::unique_ptr<std::thread> thd_;
     void ThreadFunc();
   };
   std::mutex mu_;
-  std::condition_variable cv_;
   std::condition_variable shutdown_cv_;
   bool shutdown_;
+  // Injection queue for work added from threads outside the pool.
   std::queue<std::function<void()>> callbacks_;
   int reserve_threads_;
   int nthreads_;
   int threads_waiting_;
+  // All live threads; stealing scans this list under mu_.
+  std::list<DynamicThread*> threads_;
+  // Stack of parked threads: LIFO, so the most recently active (and thus
+  // cache-warmest) thread is woken first.
+  std::vector<DynamicThread*> idle_;
   std::list<DynamicThread*> dead_threads_;
 
-  void ThreadFunc();
+  void ThreadFunc(DynamicThread* thd);
+  bool PopWork(DynamicThread* thd, std::function<void()>* cb, bool* more);
+  void WakeOneIdleLocked();
+  void SpawnThreadLocked();
   static void ReapThreads(std::list<DynamicThread*>* tlist);
 };
 
@@ -31,6 +31,7 @@
  *
  */
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 
@@ -46,25 +47,58 @@
 namespace grpc {
 namespace {
 const char kHealthCheckMethodName[] = "/grpc.health.v1.Health/Check";
+const char kHealthWatchMethodName[] = "/grpc.health.v1.Health/Watch";
+
+// How long a watcher sleeps between checking for call cancellation when no
+// status change arrives.
+const int kWatchPollIntervalMsec = 1000;
+
+// Serializes a HealthCheckResponse carrying \a status into a ByteBuffer.
+// The message is tiny (2 bytes) and encoding it cannot fail.
+ByteBuffer EncodedResponse(
+    grpc_health_v1_HealthCheckResponse_ServingStatus status) {
+  grpc_health_v1_HealthCheckResponse response_struct;
+  response_struct.has_status = true;
+  response_struct.status = status;
+  pb_ostream_t ostream;
+  memset(&ostream, 0, sizeof(ostream));
+  pb_encode(&ostream, grpc_health_v1_HealthCheckResponse_fields,
+            &response_struct);
+  grpc_slice response_slice = grpc_slice_malloc(ostream.bytes_written);
+  ostream = pb_ostream_from_buffer(GRPC_SLICE_START_PTR(response_slice),
+                                   GRPC_SLICE_LENGTH(response_slice));
+  bool encode_status = pb_encode(
+      &ostream, grpc_health_v1_HealthCheckResponse_fields, &response_struct);
+  GPR_ASSERT(encode_status);
+  Slice encoded_response(response_slice, Slice::STEAL_REF);
+  return ByteBuffer(&encoded_response, 1);
+}
 }  // namespace
 
 DefaultHealthCheckService::HealthCheckServiceImpl::HealthCheckServiceImpl(
     DefaultHealthCheckService* service)
-    : service_(service), method_(nullptr) {
+    : service_(service), method_(nullptr), watch_method_(nullptr) {
   MethodHandler* handler =
       new RpcMethodHandler<HealthCheckServiceImpl, ByteBuffer, ByteBuffer>(
           std::mem_fn(&HealthCheckServiceImpl::Check), this);
   method_ = new RpcServiceMethod(kHealthCheckMethodName, RpcMethod::NORMAL_RPC,
                                  handler);
   AddMethod(method_);
+  MethodHandler* watch_handler =
+      new ServerStreamingHandler<HealthCheckServiceImpl, ByteBuffer,
+                                 ByteBuffer>(
+          std::mem_fn(&HealthCheckServiceImpl::Watch), this);
+  watch_method_ = new RpcServiceMethod(kHealthWatchMethodName,
+                                       RpcMethod::SERVER_STREAMING,
+                                       watch_handler);
+  AddMethod(watch_method_);
 }
 
-Status DefaultHealthCheckService::HealthCheckServiceImpl::Check(
-    ServerContext* context, const ByteBuffer* request, ByteBuffer* response) {
-  // Decode request.
+bool DefaultHealthCheckService::HealthCheckServiceImpl::DecodeRequest(
+    const ByteBuffer& request, grpc::string* service_name) {
   std::vector<Slice> slices;
-  if (!request->Dump(&slices).ok()) {
-    return Status(StatusCode::INVALID_ARGUMENT, "");
+  if (!request.Dump(&slices).ok()) {
+    return false;
   }
   uint8_t* request_bytes = nullptr;
   bool request_bytes_owned = false;
@@ -77,11 +111,12 @@ Status DefaultHealthCheckService::HealthCheckServiceImpl::Check(
     request_size = slices[0].size();
   } else {
     request_bytes_owned = true;
-    request_bytes = static_cast<uint8_t*>(gpr_malloc(request->Length()));
+    request_bytes = static_cast<uint8_t*>(gpr_malloc(request.Length()));
     uint8_t* copy_to = request_bytes;
     for (size_t i = 0; i < slices.size(); i++) {
       memcpy(copy_to, slices[i].begin(), slices[i].size());
       copy_to += slices[i].size();
+      request_size += slices[i].size();
     }
   }
 
@@ -93,44 +128,75 @@ Status DefaultHealthCheckService::HealthCheckServiceImpl::Check(
       gpr_free(request_bytes);
     }
     if (!decode_status) {
-      return Status(StatusCode::INVALID_ARGUMENT, "");
+      return false;
     }
   }
 
+  *service_name = request_struct.has_service ? request_struct.service : "";
+  return true;
+}
+
+Status DefaultHealthCheckService::HealthCheckServiceImpl::Check(
+    ServerContext* context, const ByteBuffer* request, ByteBuffer* response) {
+  grpc::string service_name;
+  if (!DecodeRequest(*request, &service_name)) {
+    return Status(StatusCode::INVALID_ARGUMENT, "");
+  }
+
   // Check status from the associated default health checking service.
   DefaultHealthCheckService::ServingStatus serving_status =
-      service_->GetServingStatus(
-          request_struct.has_service ? request_struct.service : "");
+      service_->GetServingStatus(service_name);
   if (serving_status == DefaultHealthCheckService::NOT_FOUND) {
     return Status(StatusCode::NOT_FOUND, "");
   }
 
-  // Encode response
-  grpc_health_v1_HealthCheckResponse response_struct;
-  response_struct.has_status = true;
-  response_struct.status =
-      serving_status == DefaultHealthCheckService::SERVING
-          ? grpc_health_v1_HealthCheckResponse_ServingStatus_SERVING
-          : grpc_health_v1_HealthCheckResponse_ServingStatus_NOT_SERVING;
-  pb_ostream_t ostream;
-  memset(&ostream, 0, sizeof(ostream));
-  pb_encode(&ostream, grpc_health_v1_HealthCheckResponse_fields,
-            &response_struct);
-  grpc_slice response_slice = grpc_slice_malloc(ostream.bytes_written);
-  ostream = pb_ostream_from_buffer(GRPC_SLICE_START_PTR(response_slice),
-                                   GRPC_SLICE_LENGTH(response_slice));
-  bool encode_status = pb_encode(
-      &ostream, grpc_health_v1_HealthCheckResponse_fields, &response_struct);
-  if (!encode_status) {
-    return Status(StatusCode::INTERNAL, "Failed to encode response.");
+  // Hand back a reference-counted copy of the pre-serialized response; the
+  // steady-state check path performs no protobuf encoding at all.
+  *response = service_->CachedResponse(serving_status);
+  return Status::OK;
+}
+
+Status DefaultHealthCheckService::HealthCheckServiceImpl::Watch(
+    ServerContext* context, const ByteBuffer* request,
+    ServerWriter<ByteBuffer>* writer) {
+  grpc::string service_name;
+  if (!DecodeRequest(*request, &service_name)) {
+    return Status(StatusCode::INVALID_ARGUMENT, "");
+  }
+
+  uint64_t version = 0;
+  bool sent_any = false;
+  DefaultHealthCheckService::ServingStatus last_sent =
+      DefaultHealthCheckService::NOT_FOUND;
+  while (!context->IsCancelled()) {
+    DefaultHealthCheckService::ServingStatus serving_status =
+        service_->WaitForServingStatusChange(service_name, &version,
+                                             kWatchPollIntervalMsec);
+    if (serving_status == DefaultHealthCheckService::NOT_FOUND) {
+      if (!sent_any) {
+        return Status(StatusCode::NOT_FOUND, "");
+      }
+      continue;
+    }
+    // Only forward actual transitions: spurious version bumps (e.g. an
+    // update of some other service) coalesce into nothing.
+    if (!sent_any || serving_status != last_sent) {
+      if (!writer->Write(service_->CachedResponse(serving_status))) {
+        break;
+      }
+      last_sent = serving_status;
+      sent_any = true;
+    }
   }
-  Slice encoded_response(response_slice, Slice::STEAL_REF);
-  ByteBuffer response_buffer(&encoded_response, 1);
-  response->Swap(&response_buffer);
   return Status::OK;
 }
 
-DefaultHealthCheckService::DefaultHealthCheckService() {
+DefaultHealthCheckService::DefaultHealthCheckService()
+    : version_(1),
+      serving_response_(EncodedResponse(
+          grpc_health_v1_HealthCheckResponse_ServingStatus_SERVING)),
+      not_serving_response_(EncodedResponse(
+          grpc_health_v1_HealthCheckResponse_ServingStatus_NOT_SERVING)) {
   services_map_.emplace("", true);
 }
 
@@ -138,6 +204,8 @@ void DefaultHealthCheckService::SetServingStatus(
     const grpc::string& service_name, bool serving) {
   std::lock_guard<std::mutex> lock(mu_);
   services_map_[service_name] = serving;
+  version_++;
+  status_change_cv_.notify_all();
 }
 
 void DefaultHealthCheckService::SetServingStatus(bool serving) {
@@ -145,6 +213,9 @@ void DefaultHealthCheckService::SetServingStatus(bool serving) {
   for (auto iter = services_map_.begin(); iter != services_map_.end(); ++iter) {
     iter->second = serving;
   }
+  // One version bump for the whole batch: every watcher wakes exactly once.
+  version_++;
+  status_change_cv_.notify_all();
 }
 
 DefaultHealthCheckService::ServingStatus
@@ -158,6 +229,27 @@ DefaultHealthCheckService::GetServingStatus(
   return iter->second ? SERVING : NOT_SERVING;
 }
 
+const ByteBuffer& DefaultHealthCheckService::CachedResponse(
+    ServingStatus status) const {
+  return status == SERVING ? serving_response_ : not_serving_response_;
+}
+
+DefaultHealthCheckService::ServingStatus
+DefaultHealthCheckService::WaitForServingStatusChange(
+    const grpc::string& service_name, uint64_t* version,
+    int timeout_ms) const {
+  std::unique_lock<std::mutex> lock(mu_);
+  if (version_ == *version) {
+    status_change_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms));
+  }
+  *version = version_;
+  const auto& iter = services_map_.find(service_name);
+  if (iter == services_map_.end()) {
+    return NOT_FOUND;
+  }
+  return iter->second ? SERVING : NOT_SERVING;
+}
+
 DefaultHealthCheckService::HealthCheckServiceImpl*
 DefaultHealthCheckService::GetHealthCheckService() {
   GPR_ASSERT(impl_ == nullptr);
@@ -34,10 +34,12 @@
 #ifndef GRPC_INTERNAL_CPP_SERVER_DEFAULT_HEALTH_CHECK_SERVICE_H
 #define GRPC_INTERNAL_CPP_SERVER_DEFAULT_HEALTH_CHECK_SERVICE_H
 
+#include <condition_variable>
 #include <mutex>
 
 #include <grpc++/health_check_service_interface.h>
 #include <grpc++/impl/codegen/service_type.h>
+#include <grpc++/impl/codegen/sync_stream.h>
 #include <grpc++/support/byte_buffer.h>
 
 namespace grpc {
@@ -54,9 +56,21 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
     Status Check(ServerContext* context, const ByteBuffer* request,
                  ByteBuffer* response);
 
+    // Streaming variant of Check: writes the current status immediately and
+    // then a new message whenever the status changes, so load balancers can
+    // subscribe instead of polling Check.
+    Status Watch(ServerContext* context, const ByteBuffer* request,
+                 ServerWriter<ByteBuffer>* writer);
+
    private:
+    // Decodes a HealthCheckRequest into the requested service name. Returns
+    // false if the request cannot be parsed.
+    static bool DecodeRequest(const ByteBuffer& request,
+                              grpc::string* service_name);
+
     const DefaultHealthCheckService* const service_;
     RpcServiceMethod* method_;
+    RpcServiceMethod* watch_method_;
   };
 
   DefaultHealthCheckService();
@@ -67,9 +81,32 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
   ServingStatus GetServingStatus(const grpc::string& service_name) const;
   HealthCheckServiceImpl* GetHealthCheckService();
 
+  // Returns the pre-serialized HealthCheckResponse for \a status. The
+  // response payload depends only on the status (not on the service name),
+  // so two immutable buffers built at construction cover every service and
+  // never need invalidation.
+  const ByteBuffer& CachedResponse(ServingStatus status) const;
+
+  // Blocks until some SetServingStatus call has advanced the status version
+  // past \a *version or \a timeout_ms elapses, then stores the current
+  // version in \a *version and returns the current status of
+  // \a service_name. Pass *version == 0 to get the current status
+  // immediately.
+  ServingStatus WaitForServingStatusChange(const grpc::string& service_name,
+                                           uint64_t* version,
+                                           int timeout_ms) const;
+
  private:
   mutable std::mutex mu_;
+  // Signalled on every status version bump. Bulk updates (the all-services
+  // SetServingStatus overload) bump the version once, so all watchers wake
+  // a single time per batch.
+  mutable std::condition_variable status_change_cv_;
+  // Incremented under mu_ whenever any serving status may have changed.
+  uint64_t version_;
   std::map<grpc::string, bool> services_map_;
+  ByteBuffer serving_response_;
+  ByteBuffer not_serving_response_;
   std::unique_ptr<HealthCheckServiceImpl> impl_;
 };
 
@@ -134,10 +134,37 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case MAX_THREADS:
+      sync_server_settings_.max_threads = val;
+      break;
   }
   return *this;
 }
 
+ServerBuilder& ServerBuilder::SetSyncServerCpuSets(
+    const std::vector<std::vector<int>>& cpu_sets) {
+  sync_server_settings_.cpu_sets = cpu_sets;
+  return *this;
+}
+
+ServerBuilder& ServerBuilder::SetSyncMethodInlineBudget(
+    const grpc::string& method, int budget_usec) {
+  sync_inline_budgets_[method] = budget_usec;
+  return *this;
+}
+
+ServerBuilder& ServerBuilder::AddSyncMethodPool(const grpc::string& pool,
+                                                int max_threads) {
+  sync_pool_threads_[pool] = max_threads;
+  return *this;
+}
+
+ServerBuilder& ServerBuilder::SetSyncMethodPool(const grpc::string& method,
+                                                const grpc::string& pool) {
+  sync_method_pools_[method] = pool;
+  return *this;
+}
+
 ServerBuilder& ServerBuilder::SetCompressionAlgorithmSupportStatus(
     grpc_compression_algorithm algorithm, bool enabled) {
   if (enabled) {
@@ -268,10 +295,11 @@ std::unique_ptr<Server> ServerBuilder::BuildAndStart() {
     // This is a Sync server
     gpr_log(GPR_INFO,
             "Synchronous server. Num CQs: %d, Min pollers: %d, Max Pollers: "
-            "%d, CQ timeout (msec): %d",
+            "%d, CQ timeout (msec): %d, Max threads: %d",
             sync_server_settings_.num_cqs, sync_server_settings_.min_pollers,
             sync_server_settings_.max_pollers,
-            sync_server_settings_.cq_timeout_msec);
+            sync_server_settings_.cq_timeout_msec,
+            sync_server_settings_.max_threads);
 
     grpc_cq_polling_type polling_type =
         is_hybrid_server ? GRPC_CQ_NON_POLLING : GRPC_CQ_DEFAULT_POLLING;
@@ -285,10 +313,14 @@ std::unique_ptr<Server> ServerBuilder::BuildAndStart() {
   std::unique_ptr<Server> server(new Server(
       max_receive_message_size_, &args, sync_server_cqs,
       sync_server_settings_.min_pollers, sync_server_settings_.max_pollers,
-      sync_server_settings_.cq_timeout_msec));
+      sync_server_settings_.cq_timeout_msec, sync_server_settings_.max_threads,
+      sync_server_settings_.cpu_sets));
 
   ServerInitializer* initializer = server->initializer();
 
+  // Must be in place before RegisterService() walks the sync methods below
+  server->sync_method_inline_budgets_ = sync_inline_budgets_;
+
   // Register all the completion queues with the server. i.e
   //  1. sync_server_cqs: internal completion queues created IF this is a sync
   //     server
@@ -310,6 +342,26 @@ std::unique_ptr<Server> ServerBuilder::BuildAndStart() {
                                           nullptr);
   }
 
+  // Dedicated per-method execution pools (sync servers only): each pool
+  // gets its own completion queue and thread manager, and its methods are
+  // armed only there, so one slow method cannot occupy workers shared
+  // with unrelated methods
+  if (has_sync_methods) {
+    for (auto pool = sync_pool_threads_.begin();
+         pool != sync_pool_threads_.end(); ++pool) {
+      std::unique_ptr<ServerCompletionQueue> pool_cq(new ServerCompletionQueue(
+          is_hybrid_server ? GRPC_CQ_NON_POLLING : GRPC_CQ_DEFAULT_POLLING));
+      grpc_server_register_completion_queue(server->server_, pool_cq->cq(),
+                                            nullptr);
+      num_frequently_polled_cqs++;
+      server->AddSyncMethodPool(pool->first, pool->second, std::move(pool_cq),
+                                sync_server_settings_.min_pollers,
+                                sync_server_settings_.max_pollers,
+                                sync_server_settings_.cq_timeout_msec);
+    }
+    server->sync_method_pools_ = sync_method_pools_;
+  }
+
   if (num_frequently_polled_cqs == 0) {
     gpr_log(GPR_ERROR,
             "At least one of the completion queues must be frequently polled");
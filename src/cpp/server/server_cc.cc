@@ -180,6 +180,8 @@ class Server::SyncRequest final : public CompletionQueueTag {
     }
   }
 
+  RpcServiceMethod* method() const { return method_; }
+
   bool FinalizeResult(void** tag, bool* status) override {
     if (!*status) {
       grpc_completion_queue_destroy(cq_);
@@ -262,12 +264,15 @@ class Server::SyncRequestThreadManager : public ThreadManager {
   SyncRequestThreadManager(Server* server, CompletionQueue* server_cq,
                            std::shared_ptr<GlobalCallbacks> global_callbacks,
                            int min_pollers, int max_pollers,
-                           int cq_timeout_msec)
-      : ThreadManager(min_pollers, max_pollers),
+                           int cq_timeout_msec, int max_threads,
+                           const std::vector<int>& cpus)
+      : ThreadManager(min_pollers, max_pollers, max_threads),
         server_(server),
         server_cq_(server_cq),
         cq_timeout_msec_(cq_timeout_msec),
-        global_callbacks_(global_callbacks) {}
+        global_callbacks_(global_callbacks) {
+    SetWorkerCpus(cpus);
+  }
 
   WorkStatus PollForWork(void** tag, bool* ok) override {
     *tag = nullptr;
@@ -307,14 +312,43 @@ class Server::SyncRequestThreadManager : public ThreadManager {
         }
       }
 
-      GPR_TIMER_SCOPE("cd.Run()", 0);
-      cd.Run(global_callbacks_);
+      int inline_budget_usec = sync_req->method()->inline_budget_usec();
+      if (inline_budget_usec > 0) {
+        // Inline execution: no replacement poller was resumed or spawned
+        // for this call, so an overlong handler would stall polling. Time
+        // the handler and demote the method back to pool execution if it
+        // breaks its declared budget
+        gpr_timespec run_start = gpr_now(GPR_CLOCK_MONOTONIC);
+        GPR_TIMER_SCOPE("cd.Run()", 0);
+        cd.Run(global_callbacks_);
+        gpr_timespec elapsed =
+            gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), run_start);
+        int64_t usec = (int64_t)elapsed.tv_sec * GPR_US_PER_SEC +
+                       elapsed.tv_nsec / GPR_NS_PER_US;
+        if (usec > inline_budget_usec) {
+          sync_req->method()->DemoteInline();
+          gpr_log(GPR_INFO,
+                  "Sync method %s took %ldus, over its inline budget of "
+                  "%dus; demoting to pool execution",
+                  sync_req->method()->name(), (long)usec,
+                  inline_budget_usec);
+        }
+      } else {
+        GPR_TIMER_SCOPE("cd.Run()", 0);
+        cd.Run(global_callbacks_);
+      }
     }
     // TODO (sreek) If ok is false here (which it isn't in case of
     // grpc_request_registered_call), we should still re-queue the request
     // object
   }
 
+  bool IsWorkInline(void* tag, bool ok) override {
+    SyncRequest* sync_req = static_cast<SyncRequest*>(tag);
+    return ok && sync_req != nullptr &&
+           sync_req->method()->inline_budget_usec() > 0;
+  }
+
   void AddSyncMethod(RpcServiceMethod* method, void* tag) {
     sync_requests_.emplace_back(new SyncRequest(method, tag));
   }
@@ -369,7 +403,8 @@ Server::Server(
     int max_receive_message_size, ChannelArguments* args,
     std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
         sync_server_cqs,
-    int min_pollers, int max_pollers, int sync_cq_timeout_msec)
+    int min_pollers, int max_pollers, int sync_cq_timeout_msec,
+    int sync_max_threads, const std::vector<std::vector<int>>& sync_cpu_sets)
     : max_receive_message_size_(max_receive_message_size),
       sync_server_cqs_(sync_server_cqs),
       started_(false),
@@ -384,12 +419,17 @@ Server::Server(
   global_callbacks_ = g_callbacks;
   global_callbacks_->UpdateArguments(args);
 
+  const std::vector<int> no_cpus;
+  size_t cq_idx = 0;
   for (auto it = sync_server_cqs_->begin(); it != sync_server_cqs_->end();
-       it++) {
+       it++, cq_idx++) {
     sync_req_mgrs_.emplace_back(new SyncRequestThreadManager(
         this, (*it).get(), global_callbacks_, min_pollers, max_pollers,
-        sync_cq_timeout_msec));
+        sync_cq_timeout_msec, sync_max_threads,
+        sync_cpu_sets.empty() ? no_cpus
+                              : sync_cpu_sets[cq_idx % sync_cpu_sets.size()]));
   }
+  num_shared_sync_mgrs_ = sync_req_mgrs_.size();
 
   grpc_channel_args channel_args;
   args->SetChannelArgs(&channel_args);
@@ -448,6 +488,34 @@ static grpc_server_register_method_payload_handling PayloadHandlingForMethod(
   GPR_UNREACHABLE_CODE(return GRPC_SRM_PAYLOAD_NONE;);
 }
 
+void Server::AddSyncMethodPool(const grpc::string& name, int max_threads,
+                               std::unique_ptr<ServerCompletionQueue> cq,
+                               int min_pollers, int max_pollers,
+                               int cq_timeout_msec) {
+  GPR_ASSERT(!started_);
+  const std::vector<int> no_cpus;
+  sync_pool_index_[name] = sync_req_mgrs_.size();
+  sync_req_mgrs_.emplace_back(new SyncRequestThreadManager(
+      this, cq.get(), global_callbacks_, min_pollers, max_pollers,
+      cq_timeout_msec, max_threads, no_cpus));
+  sync_pool_cqs_.push_back(std::move(cq));
+}
+
+bool Server::GetSyncMethodPoolStats(const grpc::string& pool_name,
+                                    int* busy_threads, int* polling_threads,
+                                    int* max_threads) {
+  auto it = sync_pool_index_.find(pool_name);
+  if (it == sync_pool_index_.end()) {
+    return false;
+  }
+  int num_threads, num_pollers, num_parked;
+  sync_req_mgrs_[it->second]->GetThreadCounts(&num_threads, &num_pollers,
+                                              &num_parked, max_threads);
+  *busy_threads = num_threads - num_pollers - num_parked;
+  *polling_threads = num_pollers;
+  return true;
+}
+
 bool Server::RegisterService(const grpc::string* host, Service* service) {
   bool has_async_methods = service->has_async_methods();
   if (has_async_methods) {
@@ -476,8 +544,23 @@ bool Server::RegisterService(const grpc::string* host, Service* service) {
     if (method->handler() == nullptr) {  // Async method
       method->set_server_tag(tag);
     } else {
-      for (auto it = sync_req_mgrs_.begin(); it != sync_req_mgrs_.end(); it++) {
-        (*it)->AddSyncMethod(method, tag);
+      auto budget = sync_method_inline_budgets_.find(method->name());
+      if (budget != sync_method_inline_budgets_.end()) {
+        method->SetInlineExecution(budget->second);
+      }
+      auto pool = sync_method_pools_.find(method->name());
+      auto pool_idx = pool == sync_method_pools_.end()
+                          ? sync_pool_index_.end()
+                          : sync_pool_index_.find(pool->second);
+      if (pool_idx != sync_pool_index_.end()) {
+        // Pooled method: armed only on its pool's completion queue, so the
+        // shared workers never pick it up (and the pool's workers never
+        // serve anything else)
+        sync_req_mgrs_[pool_idx->second]->AddSyncMethod(method, tag);
+      } else {
+        for (size_t i = 0; i < num_shared_sync_mgrs_; i++) {
+          sync_req_mgrs_[i]->AddSyncMethod(method, tag);
+        }
       }
     }
 
@@ -533,8 +616,11 @@ void Server::Start(ServerCompletionQueue** cqs, size_t num_cqs) {
   grpc_server_start(server_);
 
   if (!has_generic_service_) {
-    for (auto it = sync_req_mgrs_.begin(); it != sync_req_mgrs_.end(); it++) {
-      (*it)->AddUnknownSyncMethod();
+    // Dedicated method pools (managers past num_shared_sync_mgrs_) serve
+    // only their own methods, so the unknown-method catch-all is armed on
+    // the shared managers alone
+    for (size_t i = 0; i < num_shared_sync_mgrs_; i++) {
+      sync_req_mgrs_[i]->AddUnknownSyncMethod();
     }
 
     for (size_t i = 0; i < num_cqs; i++) {
@@ -680,16 +766,16 @@ ServerInterface::GenericAsyncRequest::GenericAsyncRequest(
 
 bool ServerInterface::GenericAsyncRequest::FinalizeResult(void** tag,
                                                           bool* status) {
-  // TODO(yangg) remove the copy here.
   if (*status) {
-    static_cast<GenericServerContext*>(context_)->method_ =
-        StringFromCopiedSlice(call_details_.method);
-    static_cast<GenericServerContext*>(context_)->host_ =
-        StringFromCopiedSlice(call_details_.host);
+    // Hand the slices to the context; string copies are materialized only if
+    // the application asks for them
+    static_cast<GenericServerContext*>(context_)->TakeCallDetails(
+        call_details_.method, call_details_.host);
     context_->deadline_ = call_details_.deadline;
+  } else {
+    grpc_slice_unref(call_details_.method);
+    grpc_slice_unref(call_details_.host);
   }
-  grpc_slice_unref(call_details_.method);
-  grpc_slice_unref(call_details_.host);
   return BaseAsyncRequest::FinalizeResult(tag, status);
 }
 
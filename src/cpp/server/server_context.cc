@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <mutex>
+#include <new>
 #include <utility>
 
 #include <grpc++/completion_queue.h>
@@ -52,6 +53,10 @@ namespace grpc {
 
 // CompletionOp
 
+// Instances are placement-new'ed on the call's arena (see BeginCompletionOp)
+// so that starting an RPC does not hit the allocator; the storage is
+// reclaimed along with the rest of the call, so "destruction" here is just
+// running the destructor.
 class ServerContext::CompletionOp final : public CallOpSetInterface {
  public:
   // initial refs: one in the server context, one in the cq
@@ -96,7 +101,8 @@ void ServerContext::CompletionOp::Unref() {
   std::unique_lock<std::mutex> lock(mu_);
   if (--refs_ == 0) {
     lock.unlock();
-    delete this;
+    // The storage was allocated on the call arena; it is freed with the call
+    this->~CompletionOp();
   }
 }
 
@@ -120,7 +126,8 @@ bool ServerContext::CompletionOp::FinalizeResult(void** tag, bool* status) {
   if (!*status) cancelled_ = 1;
   if (--refs_ == 0) {
     lock.unlock();
-    delete this;
+    // The storage was allocated on the call arena; it is freed with the call
+    this->~CompletionOp();
   }
   return ret;
 }
@@ -151,17 +158,21 @@ ServerContext::ServerContext(gpr_timespec deadline, grpc_metadata_array* arr)
 }
 
 ServerContext::~ServerContext() {
-  if (call_) {
-    grpc_call_unref(call_);
-  }
+  // Drop the completion op ref before unreffing the call: the op lives on the
+  // call's arena, which must still be alive if this is the final unref
   if (completion_op_) {
     completion_op_->Unref();
   }
+  if (call_) {
+    grpc_call_unref(call_);
+  }
 }
 
 void ServerContext::BeginCompletionOp(Call* call) {
   GPR_ASSERT(!completion_op_);
-  completion_op_ = new CompletionOp();
+  completion_op_ =
+      new (grpc_call_arena_alloc(call->call(), sizeof(CompletionOp)))
+          CompletionOp();
   if (has_notify_when_done_tag_) {
     completion_op_->set_tag(async_notify_when_done_tag_);
   }
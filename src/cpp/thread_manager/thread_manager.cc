@@ -33,14 +33,21 @@
 
 #include "src/cpp/thread_manager/thread_manager.h"
 
+#include <chrono>
 #include <climits>
 #include <mutex>
 #include <thread>
 
 #include <grpc/support/log.h>
+#include <grpc/support/thd.h>
 
 namespace grpc {
 
+// If the moving average of DoWork() latency is below this, skip spawning a
+// replacement poller when a poller picks up work: the working thread will
+// return to polling quickly enough on its own.
+static const double kWorkLatencySpawnThresholdUsec = 500;
+
 ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
     : thd_mgr_(thd_mgr), thd_(&ThreadManager::WorkerThread::Run, this) {}
 
@@ -51,12 +58,17 @@ void ThreadManager::WorkerThread::Run() {
 
 ThreadManager::WorkerThread::~WorkerThread() { thd_.join(); }
 
-ThreadManager::ThreadManager(int min_pollers, int max_pollers)
+ThreadManager::ThreadManager(int min_pollers, int max_pollers,
+                             int max_threads)
     : shutdown_(false),
       num_pollers_(0),
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
-      num_threads_(0) {}
+      max_threads_(max_threads == -1 ? INT_MAX : max_threads),
+      num_threads_(0),
+      num_parked_(0),
+      resume_requests_(0),
+      avg_work_usec_(-1) {}
 
 ThreadManager::~ThreadManager() {
   {
@@ -77,6 +89,8 @@ void ThreadManager::Wait() {
 void ThreadManager::Shutdown() {
   std::unique_lock<std::mutex> lock(mu_);
   shutdown_ = true;
+  // Release any threads parked on the freelist so they can exit
+  park_cv_.notify_all();
 }
 
 bool ThreadManager::IsShutdown() {
@@ -84,6 +98,15 @@ bool ThreadManager::IsShutdown() {
   return shutdown_;
 }
 
+void ThreadManager::GetThreadCounts(int* num_threads, int* num_pollers,
+                                    int* num_parked, int* max_threads) {
+  std::unique_lock<std::mutex> lock(mu_);
+  *num_threads = num_threads_;
+  *num_pollers = num_pollers_;
+  *num_parked = num_parked_;
+  *max_threads = max_threads_;
+}
+
 void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     std::unique_lock<std::mutex> list_lock(list_mu_);
@@ -108,6 +131,10 @@ void ThreadManager::CleanupCompletedThreads() {
   for (auto thd : completed_threads) delete thd;
 }
 
+void ThreadManager::SetWorkerCpus(const std::vector<int>& cpus) {
+  worker_cpus_ = cpus;
+}
+
 void ThreadManager::Initialize() {
   {
     std::unique_lock<std::mutex> lock(mu_);
@@ -122,10 +149,16 @@ void ThreadManager::Initialize() {
 }
 
 void ThreadManager::MainWorkLoop() {
+  if (!worker_cpus_.empty()) {
+    gpr_thd_bind_cpus(worker_cpus_.data(), worker_cpus_.size());
+  }
+
   while (true) {
     void* tag;
     bool ok;
     WorkStatus work_status = PollForWork(&tag, &ok);
+    bool inline_work =
+        work_status == WORK_FOUND && IsWorkInline(tag, ok);
 
     std::unique_lock<std::mutex> lock(mu_);
     // Reduce the number of pollers by 1 and check what happened with the poll
@@ -142,28 +175,76 @@ void ThreadManager::MainWorkLoop() {
         done = true;
         break;
       case WORK_FOUND:
-        // If we got work and there are now insufficient pollers, start a new
-        // one
-        if (!shutdown_ && num_pollers_ < min_pollers_) {
-          num_pollers_++;
-          num_threads_++;
-          // Drop lock before spawning thread to avoid contention
-          lock.unlock();
-          new WorkerThread(this);
+        // If we got work and there are now insufficient pollers, resume a
+        // parked thread (or start a new one).  Skip the replacement when
+        // the work is declared inline (the derived class promises it is
+        // short) or when recent work latency is low: this thread will be
+        // back polling almost immediately, and spawning for every short
+        // burst is what creates the thread storms we then pay for in
+        // cq_next contention.
+        if (!shutdown_ && num_pollers_ < min_pollers_ && !inline_work &&
+            !(avg_work_usec_ >= 0 &&
+              avg_work_usec_ < kWorkLatencySpawnThresholdUsec)) {
+          if (num_parked_ > 0) {
+            // Reuse a parked thread: it becomes a poller on our behalf
+            num_pollers_++;
+            resume_requests_++;
+            park_cv_.notify_one();
+            lock.unlock();
+          } else if (num_threads_ < max_threads_ || num_pollers_ == 0) {
+            // Spawn, unless we are at the thread cap (always keep at
+            // least one poller alive, though, so the cap cannot starve
+            // polling entirely)
+            num_pollers_++;
+            num_threads_++;
+            // Drop lock before spawning thread to avoid contention
+            lock.unlock();
+            new WorkerThread(this);
+          } else {
+            lock.unlock();
+          }
         } else {
           // Drop lock for consistency with above branch
           lock.unlock();
         }
-        // Lock is always released at this point - do the application work
-        DoWork(tag, ok);
-        // Take the lock again to check post conditions
-        lock.lock();
+        {
+          // Lock is always released at this point - do the application work
+          std::chrono::steady_clock::time_point start =
+              std::chrono::steady_clock::now();
+          DoWork(tag, ok);
+          double usec = (double)std::chrono::duration_cast<
+                            std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+          // Take the lock again to check post conditions
+          lock.lock();
+          avg_work_usec_ = avg_work_usec_ < 0
+                               ? usec
+                               : 0.8 * avg_work_usec_ + 0.2 * usec;
+        }
         // If we're shutdown, we should finish at this point.
         if (shutdown_) done = true;
         break;
     }
-    // If we decided to finish the thread, break out of the while loop
-    if (done) break;
+    // If we decided to finish the thread, try parking it for reuse first:
+    // a resumed thread is much cheaper than a freshly spawned one when the
+    // next burst arrives
+    if (done) {
+      if (work_status == TIMEOUT && !shutdown_ &&
+          num_parked_ < min_pollers_) {
+        num_parked_++;
+        while (!shutdown_ && resume_requests_ == 0) {
+          park_cv_.wait(lock);
+        }
+        num_parked_--;
+        if (!shutdown_ && resume_requests_ > 0) {
+          // Resumed: the waker already counted us in num_pollers_
+          resume_requests_--;
+          continue;
+        }
+      }
+      break;
+    }
     // ... otherwise increase poller count and continue
     // There's a chance that we'll exceed the max poller count: that is
     // explicitly ok - we'll decrease after one poll timeout, and prevent
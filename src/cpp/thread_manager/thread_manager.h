@@ -39,6 +39,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <grpc++/support/config.h>
 
@@ -46,12 +47,23 @@ namespace grpc {
 
 class ThreadManager {
  public:
-  explicit ThreadManager(int min_pollers, int max_pollers);
+  // Up to max_pollers threads poll concurrently; replacement pollers are
+  // spawned when a poller moves to doing work, subject to hysteresis on
+  // the recently observed work latency and to the max_threads cap on the
+  // total thread count (-1 means no cap for both max_pollers and
+  // max_threads)
+  explicit ThreadManager(int min_pollers, int max_pollers, int max_threads);
   virtual ~ThreadManager();
 
   // Initializes and Starts the Rpc Manager threads
   void Initialize();
 
+  // Restrict all worker threads (current and future) to the given CPU ids,
+  // e.g. to keep a completion queue's threads on one NUMA node. Must be
+  // called before Initialize(). An empty vector (the default) leaves the
+  // threads unbound; on platforms without affinity support this is a no-op
+  void SetWorkerCpus(const std::vector<int>& cpus);
+
   // The return type of PollForWork() function
   enum WorkStatus { WORK_FOUND, SHUTDOWN, TIMEOUT };
 
@@ -86,6 +98,12 @@ class ThreadManager {
   // actually finds some work
   virtual void DoWork(void* tag, bool ok) = 0;
 
+  // Returns true if the work item found by PollForWork() is expected to be
+  // short enough that this thread can run it inline and return to polling
+  // without a replacement poller being resumed or spawned. Called without
+  // any locks held, before DoWork(). The default is that no work is inline
+  virtual bool IsWorkInline(void* tag, bool ok) { return false; }
+
   // Mark the ThreadManager as shutdown and begin draining the work. This is a
   // non-blocking call and the caller should call Wait(), a blocking call which
   // returns only once the shutdown is complete
@@ -94,6 +112,13 @@ class ThreadManager {
   // Has Shutdown() been called
   bool IsShutdown();
 
+  // Occupancy snapshot, e.g. for load shedding decisions: total threads,
+  // threads currently polling for work, threads parked for reuse, and the
+  // thread cap. Threads that are neither polling nor parked are running
+  // handlers
+  void GetThreadCounts(int* num_threads, int* num_pollers, int* num_parked,
+                       int* max_threads);
+
   // A blocking call that returns only after the ThreadManager has shutdown and
   // all the threads have drained all the outstanding work
   virtual void Wait();
@@ -139,10 +164,32 @@ class ThreadManager {
   int min_pollers_;
   int max_pollers_;
 
+  // Cap on num_threads_; a replacement poller is not spawned once this is
+  // reached (unless there would otherwise be no poller left at all)
+  int max_threads_;
+
   // The total number of threads (includes threads includes the threads that are
   // currently polling i.e num_pollers_)
   int num_threads_;
 
+  // Parked-thread freelist: surplus threads park here (counted in
+  // num_threads_ but not in num_pollers_) and are resumed in preference to
+  // spawning a new thread.  resume_requests_ carries wakeups across the
+  // park_cv_ waits; both are protected by mu_.
+  int num_parked_;
+  int resume_requests_;
+  std::condition_variable park_cv_;
+
+  // Exponentially weighted moving average of DoWork() latency in
+  // microseconds (-1 until the first sample), protected by mu_.  When this
+  // is low the working thread will be back polling almost immediately, so
+  // spawning a replacement poller is skipped.
+  double avg_work_usec_;
+
+  // CPU ids that worker threads bind themselves to on startup (empty means
+  // unbound). Written only before Initialize(), read by worker threads
+  std::vector<int> worker_cpus_;
+
   std::mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
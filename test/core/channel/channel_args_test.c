@@ -74,6 +74,46 @@ static void test_create(void) {
   grpc_exec_ctx_finish(&exec_ctx);
 }
 
+static void test_intern(void) {
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+
+  grpc_arg args[2];
+  grpc_channel_args unordered;
+  const grpc_channel_args *interned_a;
+  const grpc_channel_args *interned_b;
+  const grpc_channel_args *interned_c;
+
+  args[0].key = "str key";
+  args[0].type = GRPC_ARG_STRING;
+  args[0].value.string = "str value";
+  args[1].key = "int_arg";
+  args[1].type = GRPC_ARG_INTEGER;
+  args[1].value.integer = 123;
+
+  unordered.num_args = 2;
+  unordered.args = args;
+
+  /* interning equal args - in any key order - yields the same pointer */
+  interned_a = grpc_channel_args_intern(&unordered);
+  GPR_ASSERT(interned_a->num_args == 2);
+  GPR_ASSERT(strcmp(interned_a->args[0].key, "int_arg") == 0);
+  GPR_ASSERT(strcmp(interned_a->args[1].key, "str key") == 0);
+  interned_b = grpc_channel_args_intern(interned_a);
+  GPR_ASSERT(interned_a == interned_b);
+
+  /* different args get a different object */
+  args[1].value.integer = 456;
+  interned_c = grpc_channel_args_intern(&unordered);
+  GPR_ASSERT(interned_c != interned_a);
+
+  grpc_channel_args_intern_ref(interned_a);
+  grpc_channel_args_intern_unref(&exec_ctx, interned_a);
+  grpc_channel_args_intern_unref(&exec_ctx, interned_a);
+  grpc_channel_args_intern_unref(&exec_ctx, interned_b);
+  grpc_channel_args_intern_unref(&exec_ctx, interned_c);
+  grpc_exec_ctx_finish(&exec_ctx);
+}
+
 static void test_set_compression_algorithm(void) {
   grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
   grpc_channel_args *ch_args;
@@ -162,6 +202,7 @@ int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   grpc_init();
   test_create();
+  test_intern();
   test_set_compression_algorithm();
   test_compression_algorithm_states();
   test_set_socket_mutator();
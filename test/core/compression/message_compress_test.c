@@ -181,6 +181,87 @@ static void test_tiny_data_compress(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+static void test_compress_context_reuse(void) {
+  grpc_compression_algorithm algorithm;
+  int i;
+
+  for (algorithm = 0; algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT;
+       algorithm++) {
+    if (algorithm == GRPC_COMPRESS_NONE) continue;
+    grpc_msg_compress_context *ctx = grpc_msg_compress_context_create(algorithm);
+    /* Each message compressed through the same context must remain
+       independently decompressible. */
+    for (i = 0; i < 3; i++) {
+      grpc_slice_buffer input;
+      grpc_slice_buffer compressed;
+      grpc_slice_buffer output;
+      grpc_slice final;
+      grpc_slice value = create_test_value(ONE_KB_A);
+      grpc_slice_buffer_init(&input);
+      grpc_slice_buffer_init(&compressed);
+      grpc_slice_buffer_init(&output);
+      grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+      grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+      GPR_ASSERT(1 == grpc_msg_compress_ctx(&exec_ctx, ctx, &input,
+                                            &compressed));
+      GPR_ASSERT(1 ==
+                 grpc_msg_decompress(&exec_ctx, algorithm, &compressed,
+                                     &output));
+      grpc_exec_ctx_finish(&exec_ctx);
+      final = grpc_slice_merge(output.slices, output.count);
+      GPR_ASSERT(grpc_slice_eq(value, final));
+      grpc_slice_unref(final);
+      grpc_slice_unref(value);
+      grpc_slice_buffer_destroy(&input);
+      grpc_slice_buffer_destroy(&compressed);
+      grpc_slice_buffer_destroy(&output);
+    }
+    grpc_msg_compress_context_destroy(ctx);
+  }
+}
+
+static int copy_engine_compress(grpc_exec_ctx *exec_ctx,
+                                grpc_slice_buffer *input,
+                                grpc_slice_buffer *output) {
+  size_t i;
+  for (i = 0; i < input->count; i++) {
+    grpc_slice_buffer_add(output, grpc_slice_ref(input->slices[i]));
+  }
+  return 1;
+}
+
+static const grpc_compression_engine copy_engine = {
+    "copy", copy_engine_compress, copy_engine_compress};
+
+static void test_compression_engine_registry(void) {
+  grpc_slice_buffer input;
+  grpc_slice_buffer compressed;
+  grpc_slice value = create_test_value(ONE_A);
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_add(&input, grpc_slice_ref(value));
+
+  GPR_ASSERT(grpc_compression_engine_lookup(GRPC_COMPRESS_DEFLATE) == NULL);
+  grpc_compression_engine_register(GRPC_COMPRESS_DEFLATE, &copy_engine);
+  GPR_ASSERT(grpc_compression_engine_lookup(GRPC_COMPRESS_DEFLATE) ==
+             &copy_engine);
+
+  /* the copy engine "compresses" anything, even a single byte the zlib path
+     would refuse */
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  GPR_ASSERT(1 == grpc_msg_compress(&exec_ctx, GRPC_COMPRESS_DEFLATE, &input,
+                                    &compressed));
+  grpc_exec_ctx_finish(&exec_ctx);
+  GPR_ASSERT(compressed.length == input.length);
+
+  grpc_compression_engine_register(GRPC_COMPRESS_DEFLATE, NULL);
+  GPR_ASSERT(grpc_compression_engine_lookup(GRPC_COMPRESS_DEFLATE) == NULL);
+
+  grpc_slice_unref(value);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&compressed);
+}
+
 static void test_bad_decompression_data_crc(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer corrupted;
@@ -324,6 +405,8 @@ int main(int argc, char **argv) {
   }
 
   test_tiny_data_compress();
+  test_compress_context_reuse();
+  test_compression_engine_registry();
   test_bad_decompression_data_crc();
   test_bad_decompression_data_stream();
   test_bad_decompression_data_trailing_garbage();
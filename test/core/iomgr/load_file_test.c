@@ -165,11 +165,66 @@ static void test_load_big_file(void) {
   gpr_free(buffer);
 }
 
+static void test_load_cached(void) {
+  FILE *tmp = NULL;
+  grpc_slice slice_a;
+  grpc_slice slice_b;
+  grpc_slice slice_c;
+  grpc_error *error;
+  char *tmp_name;
+  char *tmp_name2;
+  const char *blah = "blah";
+  const char *longer = "something longer than blah";
+
+  LOG_TEST_NAME("test_load_cached");
+
+  tmp = gpr_tmpfile(prefix, &tmp_name);
+  GPR_ASSERT(tmp_name != NULL);
+  GPR_ASSERT(tmp != NULL);
+  GPR_ASSERT(fwrite(blah, 1, strlen(blah), tmp) == strlen(blah));
+  fclose(tmp);
+
+  /* Loading the same unchanged file twice yields the same bytes. */
+  error = grpc_load_file_cached(tmp_name, 1, &slice_a);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  GPR_ASSERT(strcmp((const char *)GRPC_SLICE_START_PTR(slice_a), blah) == 0);
+  error = grpc_load_file_cached(tmp_name, 1, &slice_b);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  GPR_ASSERT(GRPC_SLICE_START_PTR(slice_a) == GRPC_SLICE_START_PTR(slice_b));
+
+  /* Replacing the file atomically - write then rename, the way certificates
+     are rotated in practice - must be noticed. The size change also keeps us
+     from depending on mtime granularity. */
+  tmp = gpr_tmpfile(prefix, &tmp_name2);
+  GPR_ASSERT(tmp_name2 != NULL);
+  GPR_ASSERT(tmp != NULL);
+  GPR_ASSERT(fwrite(longer, 1, strlen(longer), tmp) == strlen(longer));
+  fclose(tmp);
+  GPR_ASSERT(rename(tmp_name2, tmp_name) == 0);
+  gpr_free(tmp_name2);
+
+  error = grpc_load_file_cached(tmp_name, 1, &slice_c);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  GPR_ASSERT(strcmp((const char *)GRPC_SLICE_START_PTR(slice_c), longer) == 0);
+
+  /* Previously handed out slices survive a flush. */
+  grpc_load_file_cache_flush();
+  GPR_ASSERT(strcmp((const char *)GRPC_SLICE_START_PTR(slice_a), blah) == 0);
+
+  remove(tmp_name);
+  gpr_free(tmp_name);
+  grpc_slice_unref(slice_a);
+  grpc_slice_unref(slice_b);
+  grpc_slice_unref(slice_c);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_load_empty_file();
   test_load_failure();
   test_load_small_file();
   test_load_big_file();
+  test_load_cached();
+  grpc_load_file_cache_flush();
   return 0;
 }
@@ -47,8 +47,44 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/useful.h>
 #include "src/core/lib/iomgr/socket_mutator.h"
+#include "src/core/lib/iomgr/unix_sockets_posix.h"
 #include "test/core/util/test_config.h"
 
+#ifdef GRPC_HAVE_UNIX_SOCKET
+static void test_unix_socket_fd_passing(void) {
+  int sv[2];
+  int pipefds[2];
+  int received_fd = -1;
+  char buf[6] = {0};
+
+  grpc_create_socketpair_if_unix(sv);
+  GPR_ASSERT(grpc_is_unix_socket_fd(sv[0]));
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("tune_unix_socket_buffers",
+                               grpc_tune_unix_socket_buffers(sv[0])));
+
+  /* Pass one end of a pipe across the socketpair and check that bytes
+     written to the original end come out of the received descriptor's
+     peer. */
+  GPR_ASSERT(pipe(pipefds) == 0);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("send_fd_over_unix_socket",
+                               grpc_send_fd_over_unix_socket(sv[0],
+                                                             pipefds[0])));
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "recv_fd_over_unix_socket",
+      grpc_recv_fd_over_unix_socket(sv[1], &received_fd)));
+  GPR_ASSERT(received_fd >= 0);
+  GPR_ASSERT(write(pipefds[1], "hello", 5) == 5);
+  GPR_ASSERT(read(received_fd, buf, sizeof(buf)) == 5);
+  GPR_ASSERT(strcmp(buf, "hello") == 0);
+
+  close(received_fd);
+  close(pipefds[0]);
+  close(pipefds[1]);
+  close(sv[0]);
+  close(sv[1]);
+}
+#endif
+
 struct test_socket_mutator {
   grpc_socket_mutator base;
   int option_value;
@@ -137,6 +173,11 @@ int main(int argc, char **argv) {
 
   close(sock);
 
+#ifdef GRPC_HAVE_UNIX_SOCKET
+  GPR_ASSERT(!grpc_is_unix_socket_fd(-1));
+  test_unix_socket_fd_passing();
+#endif
+
   return 0;
 }
 
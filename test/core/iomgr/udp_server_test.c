@@ -66,15 +66,22 @@ static int g_number_of_bytes_read = 0;
 static int g_number_of_orphan_calls = 0;
 
 static void on_read(grpc_exec_ctx *exec_ctx, grpc_fd *emfd, void *user_data) {
-  char read_buffer[512];
-  ssize_t byte_count;
+  unsigned char slab[512 * GRPC_UDP_SERVER_MAX_BATCH_SIZE];
+  grpc_udp_datagram datagrams[GRPC_UDP_SERVER_MAX_BATCH_SIZE];
+  int count;
+  int i;
 
   gpr_mu_lock(g_mu);
-  byte_count =
-      recv(grpc_fd_wrapped_fd(emfd), read_buffer, sizeof(read_buffer), 0);
+  /* Drain every pending datagram in one batched call. */
+  count = grpc_udp_server_recv_batch(grpc_fd_wrapped_fd(emfd), slab,
+                                     sizeof(slab), datagrams,
+                                     GRPC_UDP_SERVER_MAX_BATCH_SIZE);
+  GPR_ASSERT(count >= 0);
 
   g_number_of_reads++;
-  g_number_of_bytes_read += (int)byte_count;
+  for (i = 0; i < count; i++) {
+    g_number_of_bytes_read += (int)datagrams[i].length;
+  }
 
   GPR_ASSERT(
       GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, NULL)));
@@ -182,6 +182,75 @@ static void test_pairs() {
   }
 }
 
+/* The streaming parser is exercised by replaying its event stream into a
+ * strvec and comparing the resulting trace against what we expect. */
+typedef struct {
+  gpr_strvec trace;
+} sax_capture;
+
+static void sax_container_begins(void *userdata, grpc_json_type type) {
+  sax_capture *cap = userdata;
+  gpr_strvec_add(&cap->trace, gpr_strdup(type == GRPC_JSON_OBJECT ? "{" : "["));
+}
+
+static void sax_container_ends(void *userdata, grpc_json_type type) {
+  sax_capture *cap = userdata;
+  gpr_strvec_add(&cap->trace, gpr_strdup(type == GRPC_JSON_OBJECT ? "}" : "]"));
+}
+
+static void sax_set_key(void *userdata, const char *key) {
+  sax_capture *cap = userdata;
+  char *s;
+  gpr_asprintf(&s, "%s:", key);
+  gpr_strvec_add(&cap->trace, s);
+}
+
+static void sax_set_string(void *userdata, const char *value) {
+  sax_capture *cap = userdata;
+  char *s;
+  gpr_asprintf(&s, "\"%s\"", value);
+  gpr_strvec_add(&cap->trace, s);
+}
+
+static int sax_set_number(void *userdata, const char *value) {
+  sax_capture *cap = userdata;
+  gpr_strvec_add(&cap->trace, gpr_strdup(value));
+  return 1;
+}
+
+static void sax_set_value(void *userdata, grpc_json_type type) {
+  sax_capture *cap = userdata;
+  gpr_strvec_add(&cap->trace,
+                 gpr_strdup(type == GRPC_JSON_TRUE
+                                ? "true"
+                                : type == GRPC_JSON_FALSE ? "false" : "null"));
+}
+
+static const grpc_json_sax_vtable sax_vtable = {
+    sax_container_begins, sax_container_ends, sax_set_key,
+    sax_set_string,       sax_set_number,     sax_set_value};
+
+static void test_sax(void) {
+  /* deliberately not NUL terminated: the slice length bounds the parse */
+  static const char input[] =
+      "{\"a\":[1,\"x\\u00e9\",true],\"b\":null,\"\":{}}X";
+  grpc_slice slice = grpc_slice_from_static_buffer(input, sizeof(input) - 2);
+  sax_capture cap;
+  char *flat;
+  gpr_strvec_init(&cap.trace);
+  GPR_ASSERT(grpc_json_parse_slice(slice, &sax_vtable, &cap));
+  flat = gpr_strvec_flatten(&cap.trace, NULL);
+  GPR_ASSERT(strcmp(flat, "{a:[1\"x\xc3\xa9\"true]b:null:{}}") == 0);
+  gpr_free(flat);
+  gpr_strvec_destroy(&cap.trace);
+
+  /* errors are reported after having emitted a prefix of the events */
+  gpr_strvec_init(&cap.trace);
+  GPR_ASSERT(!grpc_json_parse_slice(grpc_slice_from_static_string("{\"a\":1"),
+                                    &sax_vtable, &cap));
+  gpr_strvec_destroy(&cap.trace);
+}
+
 static void test_atypical() {
   char *scratchpad = gpr_strdup("[[],[],[]]");
   grpc_json *json = grpc_json_parse_string(scratchpad);
@@ -201,6 +270,7 @@ int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_pairs();
   test_atypical();
+  test_sax();
   gpr_log(GPR_INFO, "json_test success");
   return 0;
 }
@@ -422,6 +422,9 @@ static void test_access_token_creds(void) {
   grpc_auth_metadata_context auth_md_ctx = {test_service_url, test_method, NULL,
                                             NULL};
   GPR_ASSERT(strcmp(creds->type, GRPC_CALL_CREDENTIALS_TYPE_OAUTH2) == 0);
+  /* The token never changes, so its metadata may be cached forever. */
+  GPR_ASSERT(gpr_time_cmp(grpc_call_credentials_get_metadata_valid_until(creds),
+                          gpr_inf_future(GPR_CLOCK_REALTIME)) == 0);
   grpc_call_credentials_get_request_metadata(
       &exec_ctx, creds, NULL, auth_md_ctx, check_access_token_metadata, creds);
   grpc_exec_ctx_finish(&exec_ctx);
@@ -38,6 +38,9 @@
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include <grpc/support/time.h>
 #include <grpc/support/useful.h>
 
 #include "test/core/util/test_config.h"
@@ -3652,6 +3655,103 @@ static void test_stress(int amount_of_stress) {
   gpr_avl_unref(avl);
 }
 
+static void check_flatmap_get(gpr_flatmap *map, int key, int value) {
+  int *k = box(key);
+  int *v = gpr_flatmap_get(map, k);
+  GPR_ASSERT(v != NULL && *v == value);
+  gpr_free(v);
+  gpr_free(k);
+}
+
+static void check_flatmap_negget(gpr_flatmap *map, int key) {
+  int *k = box(key);
+  GPR_ASSERT(gpr_flatmap_get(map, k) == NULL);
+  gpr_free(k);
+}
+
+static void flatmap_remove_int(gpr_flatmap *map, int key) {
+  int *k = box(key);
+  gpr_flatmap_remove(map, k);
+  gpr_free(k);
+}
+
+static void test_flatmap(void) {
+  gpr_flatmap map;
+  gpr_log(GPR_DEBUG, "test_flatmap");
+  gpr_flatmap_init(&map, &int_int_vtable);
+  check_flatmap_negget(&map, 1);
+  gpr_flatmap_add(&map, box(2), box(22));
+  gpr_flatmap_add(&map, box(1), box(11));
+  gpr_flatmap_add(&map, box(3), box(33));
+  check_flatmap_get(&map, 1, 11);
+  check_flatmap_get(&map, 2, 22);
+  check_flatmap_get(&map, 3, 33);
+  check_flatmap_negget(&map, 4);
+  /* replacement */
+  gpr_flatmap_add(&map, box(2), box(222));
+  check_flatmap_get(&map, 2, 222);
+  flatmap_remove_int(&map, 2);
+  check_flatmap_negget(&map, 2);
+  check_flatmap_get(&map, 1, 11);
+  check_flatmap_get(&map, 3, 33);
+  /* one rebuild for many mutations */
+  gpr_flatmap_batch batch;
+  gpr_flatmap_batch_begin(&map, &batch);
+  for (int i = 10; i < 20; i++) {
+    gpr_flatmap_batch_add(&batch, box(i), box(i * 10));
+  }
+  gpr_flatmap_batch_remove(&batch, &(int){3});
+  gpr_flatmap_batch_commit(&batch);
+  check_flatmap_negget(&map, 3);
+  for (int i = 10; i < 20; i++) {
+    check_flatmap_get(&map, i, i * 10);
+  }
+  gpr_flatmap_destroy(&map);
+}
+
+typedef struct {
+  gpr_flatmap *map;
+  gpr_event *done;
+} flatmap_reader_args;
+
+static void flatmap_reader_thread(void *arg) {
+  flatmap_reader_args *a = arg;
+  while (gpr_event_get(a->done) == NULL) {
+    /* key 0 is present for the whole test; churn happens on other keys */
+    check_flatmap_get(a->map, 0, 42);
+  }
+}
+
+static void test_flatmap_mt(void) {
+  gpr_flatmap map;
+  gpr_event done;
+  gpr_thd_id thds[4];
+  flatmap_reader_args args;
+  gpr_log(GPR_DEBUG, "test_flatmap_mt");
+  gpr_flatmap_init(&map, &int_int_vtable);
+  gpr_flatmap_add(&map, box(0), box(42));
+  gpr_event_init(&done);
+  args.map = &map;
+  args.done = &done;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_options options = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&options);
+    GPR_ASSERT(gpr_thd_new(&thds[i], flatmap_reader_thread, &args, &options));
+  }
+  /* mutate continuously under the readers: every mutation retires a snapshot
+     they may be traversing */
+  for (int i = 0; i < 3000; i++) {
+    int key = 1 + (i % 10);
+    gpr_flatmap_add(&map, box(key), box(key));
+    flatmap_remove_int(&map, key);
+  }
+  gpr_event_set(&done, (void *)1);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_join(thds[i]);
+  }
+  gpr_flatmap_destroy(&map);
+}
+
 int main(int argc, char *argv[]) {
   grpc_test_init(argc, argv);
 
@@ -3667,6 +3767,8 @@ int main(int argc, char *argv[]) {
   test_badcase2();
   test_badcase3();
   test_stress(10);
+  test_flatmap();
+  test_flatmap_mt();
 
   return 0;
 }
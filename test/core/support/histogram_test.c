@@ -169,10 +169,39 @@ static void test_merge(void) {
   gpr_histogram_destroy(h2);
 }
 
+static void test_striped(void) {
+  gpr_histogram_striped *s;
+  gpr_histogram *h;
+  int i;
+
+  LOG_TEST("test_striped");
+
+  s = gpr_histogram_striped_create(0.01, 60e9);
+  for (i = 0; i < 2; i++) {
+    gpr_histogram_striped_add(s, 10000);
+    gpr_histogram_striped_add(s, 11000);
+  }
+
+  h = gpr_histogram_create(0.01, 60e9);
+  GPR_ASSERT(gpr_histogram_striped_snapshot(s, h));
+  GPR_ASSERT(gpr_histogram_count(h) == 4);
+  GPR_ASSERT(gpr_histogram_mean(h) == 10500);
+  expect_percentile(h, 50, 10001, 10999);
+
+  /* a histogram with a different shape must be rejected */
+  gpr_histogram_destroy(h);
+  h = gpr_histogram_create(0.1, 60e9);
+  GPR_ASSERT(gpr_histogram_striped_snapshot(s, h) == 0);
+
+  gpr_histogram_destroy(h);
+  gpr_histogram_striped_destroy(s);
+}
+
 int main(void) {
   test_no_op();
   test_simple();
   test_percentile();
   test_merge();
+  test_striped();
   return 0;
 }
@@ -31,6 +31,7 @@
  *
  */
 
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 
 #include <stdbool.h>
@@ -62,6 +63,28 @@ static void test_should_not_log(gpr_log_func_args *args) { GPR_ASSERT(false); }
   gpr_log(SEVERITY, "hello %d %d %d", 1, 2, 3); \
   GPR_ASSERT(log_func_reached);
 
+static gpr_atm async_messages_seen = 0;
+
+static void test_async_counting_log(gpr_log_func_args *args) {
+  gpr_atm_no_barrier_fetch_add(&async_messages_seen, 1);
+}
+
+static void test_async_logging(void) {
+  gpr_set_log_function(test_async_counting_log);
+  gpr_log_async_init();
+  for (int i = 0; i < 1000; i++) {
+    gpr_log(GPR_ERROR, "async hello %d", i);
+  }
+  gpr_log_async_shutdown();
+  gpr_set_log_function(NULL);
+  /* every message was either written by the drain thread or counted as
+     dropped; a single hammered site must trip the rate limit */
+  GPR_ASSERT((size_t)gpr_atm_no_barrier_load(&async_messages_seen) +
+                 gpr_log_async_messages_dropped() >=
+             1000);
+  GPR_ASSERT(gpr_log_async_messages_dropped() > 0);
+}
+
 #define test_log_function_unreached(SEVERITY) \
   gpr_set_log_function(test_should_not_log);  \
   gpr_log_message(SEVERITY, "hello 1 2 3");   \
@@ -118,6 +141,8 @@ int main(int argc, char **argv) {
   test_log_function_unreached(GPR_INFO);
   test_log_function_unreached(GPR_DEBUG);
 
+  test_async_logging();
+
   /* TODO(ctiller): should we add a GPR_ASSERT failure test here */
   return 0;
 }
@@ -70,6 +70,43 @@ static void test_serial(void) {
   }
 }
 
+static void test_serial_pop_all(void) {
+  gpr_log(GPR_DEBUG, "test_serial_pop_all");
+  gpr_mpscq q;
+  gpr_mpscq_init(&q);
+  GPR_ASSERT(gpr_mpscq_pop_all(&q) == NULL);
+  for (size_t i = 0; i < 100; i++) {
+    gpr_mpscq_push(&q, &new_node(i, NULL)->node);
+  }
+  gpr_mpscq_node *n = gpr_mpscq_pop_all(&q);
+  for (size_t i = 0; i < 100; i++) {
+    GPR_ASSERT(n);
+    test_node *tn = (test_node *)n;
+    GPR_ASSERT(tn->i == i);
+    n = (gpr_mpscq_node *)gpr_atm_no_barrier_load(&n->next);
+    gpr_free(tn);
+  }
+  GPR_ASSERT(n == NULL);
+  // the queue stays usable after a drain: interleave single pops so the stub
+  // cycles through the middle of the queue
+  for (size_t i = 0; i < 10; i++) {
+    gpr_mpscq_push(&q, &new_node(i, NULL)->node);
+  }
+  test_node *tn = (test_node *)gpr_mpscq_pop(&q);
+  GPR_ASSERT(tn && tn->i == 0);
+  gpr_free(tn);
+  n = gpr_mpscq_pop_all(&q);
+  for (size_t i = 1; i < 10; i++) {
+    GPR_ASSERT(n);
+    tn = (test_node *)n;
+    GPR_ASSERT(tn->i == i);
+    n = (gpr_mpscq_node *)gpr_atm_no_barrier_load(&n->next);
+    gpr_free(tn);
+  }
+  GPR_ASSERT(n == NULL);
+  gpr_mpscq_destroy(&q);
+}
+
 typedef struct {
   size_t ctr;
   gpr_mpscq *q;
@@ -123,6 +160,46 @@ static void test_mt(void) {
   gpr_mpscq_destroy(&q);
 }
 
+static void test_mt_pop_all(void) {
+  gpr_log(GPR_DEBUG, "test_mt_pop_all");
+  gpr_event start;
+  gpr_event_init(&start);
+  gpr_thd_id thds[100];
+  thd_args ta[GPR_ARRAY_SIZE(thds)];
+  gpr_mpscq q;
+  gpr_mpscq_init(&q);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_options options = gpr_thd_options_default();
+    gpr_thd_options_set_joinable(&options);
+    ta[i].ctr = 0;
+    ta[i].q = &q;
+    ta[i].start = &start;
+    GPR_ASSERT(gpr_thd_new(&thds[i], test_thread, &ta[i], &options));
+  }
+  size_t num_done = 0;
+  size_t batches = 0;
+  gpr_event_set(&start, (void *)1);
+  while (num_done != GPR_ARRAY_SIZE(thds)) {
+    gpr_mpscq_node *n;
+    while ((n = gpr_mpscq_pop_all(&q)) == NULL)
+      ;
+    batches++;
+    while (n != NULL) {
+      test_node *tn = (test_node *)n;
+      n = (gpr_mpscq_node *)gpr_atm_no_barrier_load(&n->next);
+      GPR_ASSERT(*tn->ctr == tn->i - 1);
+      *tn->ctr = tn->i;
+      if (tn->i == THREAD_ITERATIONS) num_done++;
+      gpr_free(tn);
+    }
+  }
+  gpr_log(GPR_DEBUG, "batches: %" PRIdPTR, batches);
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(thds); i++) {
+    gpr_thd_join(thds[i]);
+  }
+  gpr_mpscq_destroy(&q);
+}
+
 typedef struct {
   thd_args *ta;
   size_t num_thds;
@@ -200,7 +277,9 @@ static void test_mt_multipop(void) {
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_serial();
+  test_serial_pop_all();
   test_mt();
+  test_mt_pop_all();
   test_mt_multipop();
   return 0;
 }
@@ -36,9 +36,11 @@
 #include <stdlib.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd.h>
+#include <grpc/support/useful.h>
 #include "test/core/util/test_config.h"
 
 /* max stack size supported */
@@ -147,9 +149,111 @@ static void test_mt() {
   }
 }
 
+/* -- epoch based reclamation tests -- */
+
+static int g_ebr_destroy_count;
+
+static void count_destroy(void *arg) {
+  (void)arg;
+  g_ebr_destroy_count++;
+}
+
+static void test_ebr_serial(void) {
+  int i;
+  g_ebr_destroy_count = 0;
+  gpr_ebr_global_init();
+  /* with no readers, each defer lets the epoch advance and earlier batches
+     get reclaimed */
+  for (i = 0; i < 10; i++) {
+    gpr_ebr_defer(count_destroy, NULL);
+  }
+  GPR_ASSERT(g_ebr_destroy_count > 0);
+  /* a reader pinned on the current epoch stalls reclamation... */
+  gpr_ebr_enter();
+  {
+    int count_at_enter;
+    gpr_ebr_defer(count_destroy, NULL);
+    count_at_enter = g_ebr_destroy_count;
+    gpr_ebr_defer(count_destroy, NULL);
+    gpr_ebr_defer(count_destroy, NULL);
+    GPR_ASSERT(g_ebr_destroy_count <= count_at_enter + 1);
+  }
+  /* ...and shutdown flushes whatever is left */
+  gpr_ebr_exit();
+  gpr_ebr_global_shutdown();
+  GPR_ASSERT(g_ebr_destroy_count == 13);
+}
+
+#define EBR_TEST_MAGIC 0x5ca1ab1e
+
+typedef struct ebr_test_node {
+  gpr_atm magic;
+  int payload;
+} ebr_test_node;
+
+static gpr_atm g_ebr_current_node;
+static gpr_atm g_ebr_readers_done;
+
+static void poison_and_free(void *arg) {
+  ebr_test_node *node = arg;
+  /* if reclamation ever runs while a reader can still see the node, the
+     reader trips on the poisoned magic below */
+  gpr_atm_no_barrier_store(&node->magic, 0);
+  gpr_free(node);
+}
+
+static void ebr_reader_body(void *arg) {
+  (void)arg;
+  while (gpr_atm_acq_load(&g_ebr_readers_done) == 0) {
+    gpr_ebr_enter();
+    {
+      ebr_test_node *node =
+          (ebr_test_node *)gpr_atm_acq_load(&g_ebr_current_node);
+      GPR_ASSERT(gpr_atm_no_barrier_load(&node->magic) == EBR_TEST_MAGIC);
+    }
+    gpr_ebr_exit();
+  }
+}
+
+static ebr_test_node *ebr_new_node(int payload) {
+  ebr_test_node *node = gpr_malloc(sizeof(*node));
+  gpr_atm_no_barrier_store(&node->magic, EBR_TEST_MAGIC);
+  node->payload = payload;
+  return node;
+}
+
+static void test_ebr_mt(void) {
+  gpr_thd_id thds[4];
+  gpr_thd_options options = gpr_thd_options_default();
+  int i;
+  size_t t;
+  gpr_ebr_global_init();
+  gpr_atm_no_barrier_store(&g_ebr_readers_done, 0);
+  gpr_atm_no_barrier_store(&g_ebr_current_node, (gpr_atm)ebr_new_node(0));
+  gpr_thd_options_set_joinable(&options);
+  for (t = 0; t < GPR_ARRAY_SIZE(thds); t++) {
+    GPR_ASSERT(gpr_thd_new(&thds[t], ebr_reader_body, NULL, &options));
+  }
+  /* churn the shared node under the readers: every retired node is poisoned
+     in its destroyer, so premature reclamation is caught by the readers */
+  for (i = 1; i <= 10000; i++) {
+    ebr_test_node *old = (ebr_test_node *)gpr_atm_full_xchg(
+        &g_ebr_current_node, (gpr_atm)ebr_new_node(i));
+    gpr_ebr_defer(poison_and_free, old);
+  }
+  gpr_atm_rel_store(&g_ebr_readers_done, 1);
+  for (t = 0; t < GPR_ARRAY_SIZE(thds); t++) {
+    gpr_thd_join(thds[t]);
+  }
+  poison_and_free((void *)gpr_atm_no_barrier_load(&g_ebr_current_node));
+  gpr_ebr_global_shutdown();
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_serial();
   test_mt();
+  test_ebr_serial();
+  test_ebr_mt();
   return 0;
 }
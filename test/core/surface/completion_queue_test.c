@@ -173,6 +173,76 @@ static void test_cq_end_op(void) {
   }
 }
 
+static void test_next_batch(void) {
+  grpc_event events[10];
+  grpc_completion_queue *cc;
+  void *tags[8];
+  grpc_cq_completion completions[GPR_ARRAY_SIZE(tags)];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  grpc_exec_ctx init_exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_exec_ctx exec_ctx;
+  size_t got;
+
+  LOG_TEST("test_next_batch");
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+    tags[i] = create_test_tag();
+  }
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  for (size_t pidx = 0; pidx < GPR_ARRAY_SIZE(polling_types); pidx++) {
+    exec_ctx = init_exec_ctx;  // Reset exec_ctx
+    attr.cq_polling_type = polling_types[pidx];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, NULL);
+
+    /* All queued completions come back in one call, in order */
+    for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+      grpc_cq_begin_op(cc, tags[i]);
+      grpc_cq_end_op(&exec_ctx, cc, tags[i], GRPC_ERROR_NONE,
+                     do_nothing_end_completion, NULL, &completions[i]);
+    }
+
+    got = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                           gpr_inf_past(GPR_CLOCK_REALTIME),
+                                           NULL);
+    GPR_ASSERT(got == GPR_ARRAY_SIZE(tags));
+    for (size_t i = 0; i < got; i++) {
+      GPR_ASSERT(events[i].type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(events[i].tag == tags[i]);
+      GPR_ASSERT(events[i].success);
+    }
+
+    /* max_events caps the batch; the remainder stays queued */
+    for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+      grpc_cq_begin_op(cc, tags[i]);
+      grpc_cq_end_op(&exec_ctx, cc, tags[i], GRPC_ERROR_NONE,
+                     do_nothing_end_completion, NULL, &completions[i]);
+    }
+
+    got = grpc_completion_queue_next_batch(
+        cc, events, 3, gpr_inf_past(GPR_CLOCK_REALTIME), NULL);
+    GPR_ASSERT(got == 3);
+    got = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                           gpr_inf_past(GPR_CLOCK_REALTIME),
+                                           NULL);
+    GPR_ASSERT(got == GPR_ARRAY_SIZE(tags) - 3);
+
+    /* An empty queue reports a timeout in events[0] */
+    got = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                           gpr_inf_past(GPR_CLOCK_REALTIME),
+                                           NULL);
+    GPR_ASSERT(got == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_TIMEOUT);
+
+    shutdown_and_destroy(cc);
+    grpc_exec_ctx_finish(&exec_ctx);
+  }
+}
+
 static void test_shutdown_then_next_polling(void) {
   grpc_cq_polling_type polling_types[] = {
       GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
@@ -313,6 +383,7 @@ int main(int argc, char **argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_next_batch();
   test_pluck();
   test_pluck_after_shutdown();
   grpc_shutdown();
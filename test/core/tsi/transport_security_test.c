@@ -361,6 +361,8 @@ static void test_result_strings(void) {
 static void test_protector_invalid_args(void) {
   GPR_ASSERT(tsi_frame_protector_protect(NULL, NULL, NULL, NULL, NULL) ==
              TSI_INVALID_ARGUMENT);
+  GPR_ASSERT(tsi_frame_protector_protect_vectored(NULL, NULL, 0, NULL, NULL,
+                                                  NULL) == TSI_INVALID_ARGUMENT);
   GPR_ASSERT(tsi_frame_protector_protect_flush(NULL, NULL, NULL, NULL) ==
              TSI_INVALID_ARGUMENT);
   GPR_ASSERT(tsi_frame_protector_unprotect(NULL, NULL, NULL, NULL, NULL) ==
@@ -380,6 +382,19 @@ static void test_handshaker_invalid_args(void) {
              TSI_INVALID_ARGUMENT);
 }
 
+static void test_ssl_session_cache(void) {
+  size_t hits;
+  size_t misses;
+  tsi_ssl_session_cache_set_capacity(16);
+  tsi_ssl_session_cache_get_stats(&hits, &misses);
+  GPR_ASSERT(hits == 0);
+  GPR_ASSERT(misses == 0);
+  tsi_ssl_session_cache_get_stats(&hits, NULL);
+  tsi_ssl_session_cache_get_stats(NULL, &misses);
+  tsi_ssl_session_cache_set_capacity(0);
+  tsi_ssl_session_cache_set_capacity(TSI_SSL_SESSION_CACHE_DEFAULT_CAPACITY);
+}
+
 static void test_handshaker_invalid_state(void) {
   tsi_handshaker *h = tsi_create_fake_handshaker(0);
   tsi_peer peer;
@@ -395,6 +410,7 @@ int main(int argc, char **argv) {
   test_peer_matches_name();
   test_result_strings();
   test_protector_invalid_args();
+  test_ssl_session_cache();
   test_handshaker_invalid_args();
   test_handshaker_invalid_state();
   return 0;
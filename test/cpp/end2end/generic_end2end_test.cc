@@ -157,6 +157,12 @@ class GenericEnd2endTest : public ::testing::Test {
       verify_ok(srv_cq_.get(), 4, true);
       EXPECT_EQ(server_host_, srv_ctx.host().substr(0, server_host_.length()));
       EXPECT_EQ(kMethodName, srv_ctx.method());
+      // The zero-copy views must agree with the materialized strings
+      EXPECT_EQ(srv_ctx.method(),
+                grpc::string(srv_ctx.method_ref().data(),
+                             srv_ctx.method_ref().length()));
+      EXPECT_EQ(srv_ctx.host(), grpc::string(srv_ctx.host_ref().data(),
+                                             srv_ctx.host_ref().length()));
 
       if (check_deadline) {
         EXPECT_TRUE(gpr_time_similar(deadline, srv_ctx.raw_deadline(),
@@ -46,14 +46,20 @@
 
 extern "C" {
 #include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/client_channel/uri_parser.h"
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 #include "src/core/ext/filters/http/client/http_client_filter.h"
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/filters/load_reporting/load_reporting_filter.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/connected_channel.h"
+#include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/transport/transport_impl.h"
@@ -856,4 +862,214 @@ static void BM_IsolatedCall_StreamingSend(benchmark::State &state) {
 }
 BENCHMARK(BM_IsolatedCall_StreamingSend);
 
+////////////////////////////////////////////////////////////////////////////////
+// LB policy picks and updates
+//
+// These benchmarks drive an LB policy directly, with real (but never
+// connecting) subchannels underneath: the factory below creates each
+// subchannel with a connector that parks the connect attempt forever, so the
+// policies see IDLE/CONNECTING subchannels and every pick takes the
+// pending-pick path. The benchmarks are single threaded, so the *_locked
+// entry points are called without going through the combiner.
+
+namespace stub_connector {
+
+typedef struct {
+  grpc_connector base;
+  gpr_refcount refs;
+  grpc_closure *notify;
+} stub_connector;
+
+static void Ref(grpc_connector *con) {
+  gpr_ref(&reinterpret_cast<stub_connector *>(con)->refs);
+}
+
+static void Unref(grpc_exec_ctx *exec_ctx, grpc_connector *con) {
+  if (gpr_unref(&reinterpret_cast<stub_connector *>(con)->refs)) {
+    gpr_free(con);
+  }
+}
+
+static void Shutdown(grpc_exec_ctx *exec_ctx, grpc_connector *con,
+                     grpc_error *why) {
+  stub_connector *c = reinterpret_cast<stub_connector *>(con);
+  if (c->notify != nullptr) {
+    grpc_closure_sched(exec_ctx, c->notify, GRPC_ERROR_REF(why));
+    c->notify = nullptr;
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+static void Connect(grpc_exec_ctx *exec_ctx, grpc_connector *con,
+                    const grpc_connect_in_args *in_args,
+                    grpc_connect_out_args *out_args, grpc_closure *notify) {
+  stub_connector *c = reinterpret_cast<stub_connector *>(con);
+  memset(out_args, 0, sizeof(*out_args));
+  GPR_ASSERT(c->notify == nullptr);
+  c->notify = notify;
+}
+
+static const grpc_connector_vtable vtable = {Ref, Unref, Shutdown, Connect};
+
+static grpc_connector *Create() {
+  stub_connector *c =
+      static_cast<stub_connector *>(gpr_zalloc(sizeof(*c)));
+  c->base.vtable = &vtable;
+  gpr_ref_init(&c->refs, 1);
+  return &c->base;
+}
+
+}  // namespace stub_connector
+
+class StubSubchannelFactory : public grpc_client_channel_factory {
+ public:
+  StubSubchannelFactory() { vtable = &vtable_; }
+
+ private:
+  static void NoRef(grpc_client_channel_factory *factory) {}
+  static void NoUnref(grpc_exec_ctx *exec_ctx,
+                      grpc_client_channel_factory *factory) {}
+  static grpc_subchannel *CreateSubchannel(grpc_exec_ctx *exec_ctx,
+                                           grpc_client_channel_factory *factory,
+                                           const grpc_subchannel_args *args) {
+    grpc_connector *connector = stub_connector::Create();
+    grpc_subchannel *subchannel =
+        grpc_subchannel_create(exec_ctx, connector, args);
+    grpc_connector_unref(exec_ctx, connector);
+    return subchannel;
+  }
+  static grpc_channel *CreateClientChannel(grpc_exec_ctx *exec_ctx,
+                                           grpc_client_channel_factory *factory,
+                                           const char *target,
+                                           grpc_client_channel_type type,
+                                           const grpc_channel_args *args) {
+    return nullptr;
+  }
+
+  static const grpc_client_channel_factory_vtable vtable_;
+};
+
+const grpc_client_channel_factory_vtable StubSubchannelFactory::vtable_ = {
+    NoRef, NoUnref, CreateSubchannel, CreateClientChannel};
+
+// \a port_seed varies the addresses between lists so that alternating updates
+// see full churn
+static grpc_lb_addresses *BuildLbAddresses(grpc_exec_ctx *exec_ctx,
+                                           size_t num_backends,
+                                           int port_seed) {
+  grpc_lb_addresses *addresses =
+      grpc_lb_addresses_create(num_backends, nullptr);
+  for (size_t i = 0; i < num_backends; i++) {
+    char *uri_str;
+    gpr_asprintf(&uri_str, "ipv4:10.%d.%d.%d:%d", (int)(i >> 16) & 0xff,
+                 (int)(i >> 8) & 0xff, (int)i & 0xff, port_seed);
+    grpc_uri *uri = grpc_uri_parse(exec_ctx, uri_str, true);
+    GPR_ASSERT(uri != nullptr);
+    GPR_ASSERT(grpc_lb_addresses_set_address_from_uri(
+        addresses, i, uri, false /* is_balancer */, nullptr, nullptr));
+    grpc_uri_destroy(uri);
+    gpr_free(uri_str);
+  }
+  return addresses;
+}
+
+static grpc_channel_args *BuildLbChannelArgs(grpc_exec_ctx *exec_ctx,
+                                             grpc_lb_addresses *addresses) {
+  grpc_arg arg = grpc_lb_addresses_create_channel_arg(addresses);
+  return grpc_channel_args_copy_and_add(nullptr, &arg, 1);
+}
+
+static void BM_LbPick(benchmark::State &state, const char *policy_name) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  StubSubchannelFactory factory;
+  grpc_combiner *combiner = grpc_combiner_create(nullptr);
+  grpc_lb_addresses *addresses =
+      BuildLbAddresses(&exec_ctx, (size_t)state.range(0), 443);
+  grpc_lb_policy_args lb_args;
+  lb_args.client_channel_factory = &factory;
+  lb_args.args = BuildLbChannelArgs(&exec_ctx, addresses);
+  lb_args.combiner = combiner;
+  grpc_lb_policy *policy =
+      grpc_lb_policy_create(&exec_ctx, policy_name, &lb_args);
+  GPR_ASSERT(policy != nullptr);
+  grpc_closure pick_closure;
+  grpc_closure_init(&pick_closure, DoNothing, nullptr,
+                    grpc_schedule_on_exec_ctx);
+  grpc_metadata_batch initial_metadata;
+  grpc_metadata_batch_init(&initial_metadata);
+  grpc_lb_policy_pick_args pick_args;
+  memset(&pick_args, 0, sizeof(pick_args));
+  pick_args.initial_metadata = &initial_metadata;
+  while (state.KeepRunning()) {
+    grpc_connected_subchannel *target = nullptr;
+    // no subchannel ever reaches READY, so each pick queues and is cancelled:
+    // this exercises the pick path's subchannel scan and queue management
+    if (grpc_lb_policy_pick_locked(&exec_ctx, policy, &pick_args, &target,
+                                   nullptr, nullptr, &pick_closure)) {
+      GRPC_CONNECTED_SUBCHANNEL_UNREF(&exec_ctx, target, "bm_lb_pick");
+    } else {
+      grpc_lb_policy_cancel_pick_locked(&exec_ctx, policy, &target,
+                                        GRPC_ERROR_CANCELLED);
+    }
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  grpc_metadata_batch_destroy(&exec_ctx, &initial_metadata);
+  GRPC_LB_POLICY_UNREF(&exec_ctx, policy, "bm_lb_pick");
+  grpc_exec_ctx_flush(&exec_ctx);
+  grpc_channel_args_destroy(&exec_ctx, lb_args.args);
+  grpc_lb_addresses_destroy(&exec_ctx, addresses);
+  GRPC_COMBINER_UNREF(&exec_ctx, combiner, "bm_lb_pick");
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+
+static void BM_LbPickFirstPick(benchmark::State &state) {
+  BM_LbPick(state, "pick_first");
+}
+BENCHMARK(BM_LbPickFirstPick)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_LbRoundRobinPick(benchmark::State &state) {
+  BM_LbPick(state, "round_robin");
+}
+BENCHMARK(BM_LbRoundRobinPick)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_LbRoundRobinUpdate(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  StubSubchannelFactory factory;
+  grpc_combiner *combiner = grpc_combiner_create(nullptr);
+  const size_t num_backends = (size_t)state.range(0);
+  // two address lists with no overlap: every update sheds the entire old
+  // subchannel set and builds a new one, the worst case for a resolver churn
+  grpc_lb_addresses *addresses[2] = {
+      BuildLbAddresses(&exec_ctx, num_backends, 443),
+      BuildLbAddresses(&exec_ctx, num_backends, 444)};
+  grpc_lb_policy_args lb_args[2];
+  for (int i = 0; i < 2; i++) {
+    lb_args[i].client_channel_factory = &factory;
+    lb_args[i].args = BuildLbChannelArgs(&exec_ctx, addresses[i]);
+    lb_args[i].combiner = combiner;
+  }
+  grpc_lb_policy *policy =
+      grpc_lb_policy_create(&exec_ctx, "round_robin", &lb_args[0]);
+  GPR_ASSERT(policy != nullptr);
+  size_t i = 1;
+  while (state.KeepRunning()) {
+    grpc_lb_policy_update_locked(&exec_ctx, policy, &lb_args[i & 1]);
+    grpc_exec_ctx_flush(&exec_ctx);
+    ++i;
+  }
+  GRPC_LB_POLICY_UNREF(&exec_ctx, policy, "bm_lb_update");
+  grpc_exec_ctx_flush(&exec_ctx);
+  for (int j = 0; j < 2; j++) {
+    grpc_channel_args_destroy(&exec_ctx, lb_args[j].args);
+    grpc_lb_addresses_destroy(&exec_ctx, addresses[j]);
+  }
+  GRPC_COMBINER_UNREF(&exec_ctx, combiner, "bm_lb_update");
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_LbRoundRobinUpdate)->Arg(100)->Arg(1000)->Arg(10000);
+
 BENCHMARK_MAIN();
@@ -38,6 +38,8 @@
 #include <string.h>
 #include <sstream>
 extern "C" {
+#include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -49,6 +51,60 @@ extern "C" {
 
 auto &force_library_initialization = Library::get();
 
+////////////////////////////////////////////////////////////////////////////////
+// Binary metadata (base64) throughput
+//
+
+static grpc_slice MakeBinaryToken(size_t length) {
+  grpc_slice s = grpc_slice_malloc(length);
+  for (size_t i = 0; i < length; i++) {
+    GRPC_SLICE_START_PTR(s)[i] = (uint8_t)(i * 31 + 7);
+  }
+  return s;
+}
+
+static void BM_Chttp2Base64Encode(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeBinaryToken((size_t)state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_encode(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Chttp2Base64Encode)->Range(64, 4096);
+
+static void BM_Chttp2Base64DecodeWithLength(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  grpc_slice raw = MakeBinaryToken((size_t)state.range(0));
+  grpc_slice input = grpc_chttp2_base64_encode(raw);
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_decode_with_length(
+        &exec_ctx, input, (size_t)state.range(0)));
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  grpc_slice_unref(input);
+  grpc_slice_unref(raw);
+  grpc_exec_ctx_finish(&exec_ctx);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Chttp2Base64DecodeWithLength)->Range(64, 4096);
+
+static void BM_Chttp2Base64EncodeAndHuffmanCompress(benchmark::State &state) {
+  TrackCounters track_counters;
+  grpc_slice input = MakeBinaryToken((size_t)state.range(0));
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(input));
+  }
+  grpc_slice_unref(input);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Chttp2Base64EncodeAndHuffmanCompress)->Range(64, 4096);
+
 ////////////////////////////////////////////////////////////////////////////////
 // HPACK encoder
 //
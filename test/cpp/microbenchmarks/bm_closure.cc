@@ -37,10 +37,13 @@
 #include <grpc/grpc.h>
 #include <sstream>
 
+#include <grpc/support/alloc.h>
+
 extern "C" {
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/support/spinlock.h"
 }
 
@@ -442,4 +445,80 @@ static void BM_ClosureReschedOnCombinerFinally(benchmark::State& state) {
 }
 BENCHMARK(BM_ClosureReschedOnCombinerFinally);
 
+// Every RPC arms a deadline timer and nearly all of them are cancelled before
+// they fire, so init+cancel is the pattern that matters most. The argument is
+// the deadline distance in milliseconds (near deadlines land in the soonest
+// timer shard window, far ones beyond it) and the thread count scales shard
+// contention.
+static void BM_TimerInitCancel(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  const gpr_timespec offset =
+      gpr_time_from_millis(state.range(0), GPR_TIMESPAN);
+  grpc_timer timer;
+  grpc_closure closure;
+  grpc_closure_init(&closure, DoNothing, NULL, grpc_schedule_on_exec_ctx);
+  while (state.KeepRunning()) {
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    grpc_timer_init(&exec_ctx, &timer, gpr_time_add(now, offset), &closure,
+                    now);
+    grpc_timer_cancel(&exec_ctx, &timer);
+    grpc_exec_ctx_flush(&exec_ctx);
+  }
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerInitCancel)
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(100000)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+static gpr_atm g_timers_fired;
+
+static void CountFired(grpc_exec_ctx* exec_ctx, void* arg, grpc_error* error) {
+  gpr_atm_no_barrier_fetch_add(&g_timers_fired, 1);
+}
+
+// Arm a batch of timers that are all about to expire and measure how fast the
+// timer list drains them.
+static void BM_TimerBatchExpiry(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_exec_ctx exec_ctx = GRPC_EXEC_CTX_INIT;
+  const size_t batch_size = (size_t)state.range(0);
+  grpc_timer* timers =
+      static_cast<grpc_timer*>(gpr_malloc(sizeof(*timers) * batch_size));
+  grpc_closure* closures =
+      static_cast<grpc_closure*>(gpr_malloc(sizeof(*closures) * batch_size));
+  for (size_t i = 0; i < batch_size; i++) {
+    grpc_closure_init(&closures[i], CountFired, NULL,
+                      grpc_schedule_on_exec_ctx);
+  }
+  while (state.KeepRunning()) {
+    gpr_atm_no_barrier_store(&g_timers_fired, 0);
+    gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    gpr_timespec deadline =
+        gpr_time_add(now, gpr_time_from_millis(1, GPR_TIMESPAN));
+    for (size_t i = 0; i < batch_size; i++) {
+      grpc_timer_init(&exec_ctx, &timers[i], deadline, &closures[i], now);
+    }
+    // drive the drain ourselves, but the timer manager threads may claim a
+    // share of the expiries: wait for every callback before the timer
+    // structures are rearmed
+    gpr_timespec drain_time =
+        gpr_time_add(deadline, gpr_time_from_millis(1, GPR_TIMESPAN));
+    while ((size_t)gpr_atm_acq_load(&g_timers_fired) < batch_size) {
+      grpc_timer_check(&exec_ctx, drain_time, NULL);
+      grpc_exec_ctx_flush(&exec_ctx);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (int64_t)batch_size);
+  gpr_free(timers);
+  gpr_free(closures);
+  grpc_exec_ctx_finish(&exec_ctx);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_TimerBatchExpiry)->Range(16, 64 * 1024);
+
 BENCHMARK_MAIN();
@@ -37,6 +37,7 @@
 #include <grpc/grpc.h>
 
 extern "C" {
+#include "src/core/lib/slice/percent_encoding.h"
 #include "src/core/lib/transport/metadata.h"
 #include "src/core/lib/transport/static_metadata.h"
 }
@@ -63,6 +64,18 @@ static void BM_SliceFromCopied(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceFromCopied);
 
+static void BM_SliceReHashCopied(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_slice slice = grpc_slice_from_copied_string(
+      "some-fairly-long-uninterned-header-value-of-the-kind-we-rehash");
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(grpc_slice_hash(slice));
+  }
+  grpc_slice_unref(slice);
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_SliceReHashCopied);
+
 static void BM_SliceIntern(benchmark::State& state) {
   TrackCounters track_counters;
   gpr_slice slice = grpc_slice_from_static_string("abc");
@@ -103,6 +116,39 @@ static void BM_SliceInternEqualToStaticMetadata(benchmark::State& state) {
 }
 BENCHMARK(BM_SliceInternEqualToStaticMetadata);
 
+static void BM_ValidateHeaderKey(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_slice slice = grpc_slice_from_static_string("x-some-tracing-header-key");
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(grpc_header_key_is_legal(slice));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ValidateHeaderKey);
+
+static void BM_ValidateHeaderNonBinValue(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_slice slice = grpc_slice_from_static_string(
+      "this-is-a-fairly-typical-tracing-value:0123456789abcdef0123456789");
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(grpc_header_nonbin_value_is_legal(slice));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_ValidateHeaderNonBinValue);
+
+static void BM_PercentEncodeSlice(benchmark::State& state) {
+  TrackCounters track_counters;
+  gpr_slice slice = grpc_slice_from_static_string(
+      "this-is-a-fairly-typical-message-that-needs-no-encoding");
+  while (state.KeepRunning()) {
+    grpc_slice_unref(grpc_percent_encode_slice(
+        slice, grpc_url_percent_encoding_unreserved_bytes));
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_PercentEncodeSlice);
+
 static void BM_MetadataFromNonInternedSlices(benchmark::State& state) {
   TrackCounters track_counters;
   gpr_slice k = grpc_slice_from_static_string("key");
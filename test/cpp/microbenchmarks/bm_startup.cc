@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright 2017, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/* Benchmark the cold-start path, phase by phase: library initialization,
+   channel-creation-to-READY, and end-to-end time-to-first-response over
+   loopback (insecure and TLS). Short-lived workers pay each of these once
+   per process, so they are reported as separate benchmarks rather than one
+   aggregate number. */
+
+#include <benchmark/benchmark.h>
+#include <grpc/grpc.h>
+#include <sstream>
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/cpp/microbenchmarks/fullstack_fixtures.h"
+
+extern "C" {
+#include "test/core/end2end/data/ssl_test_data.h"
+}
+
+namespace grpc {
+namespace testing {
+
+/* Deliberately no static Library instance in this file: BM_GrpcInitShutdown
+   must observe a library that is genuinely torn down between iterations.
+   The other benchmarks hold their own init ref for the duration of the run
+   so that they measure only their own phase. */
+
+static void* tag(intptr_t x) { return reinterpret_cast<void*>(x); }
+
+/*******************************************************************************
+ * LIBRARY INITIALIZATION
+ */
+
+/* A full grpc_init/grpc_shutdown cycle: every stage in init.c runs on each
+   iteration since no other ref is held */
+static void BM_GrpcInitShutdown(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    grpc_init();
+    grpc_shutdown();
+  }
+}
+BENCHMARK(BM_GrpcInitShutdown);
+
+/* The same cycle with another ref already held, i.e. just the refcount
+   bookkeeping. The difference against BM_GrpcInitShutdown is what init.c
+   actually rebuilds on a cold start. */
+static void BM_GrpcInitRefHeld(benchmark::State& state) {
+  grpc_init();
+  while (state.KeepRunning()) {
+    grpc_init();
+    grpc_shutdown();
+  }
+  grpc_shutdown();
+}
+BENCHMARK(BM_GrpcInitRefHeld);
+
+/*******************************************************************************
+ * CHANNEL CREATION TO READY
+ */
+
+/* Channel construction, name resolution of "localhost", connect and HTTP/2
+   handshake against an already-running local server; one fresh connection
+   per iteration */
+static void BM_ChannelCreationToReady(benchmark::State& state) {
+  grpc_init();
+  {
+    EchoTestService::AsyncService service;
+    int port = grpc_pick_unused_port_or_die();
+    std::stringstream addr;
+    addr << "localhost:" << port;
+    ServerBuilder b;
+    b.AddListeningPort(addr.str(), InsecureServerCredentials());
+    std::unique_ptr<ServerCompletionQueue> cq = b.AddCompletionQueue(true);
+    b.RegisterService(&service);
+    std::unique_ptr<Server> server = b.BuildAndStart();
+    int iteration = 0;
+    while (state.KeepRunning()) {
+      /* a unique per-iteration arg keeps the subchannel key distinct, so
+         each channel builds a fresh connection instead of picking up the
+         previous iteration's from the global subchannel index */
+      ChannelArguments args;
+      args.SetInt("grpc.bm_startup.iteration", iteration++);
+      std::shared_ptr<Channel> channel =
+          CreateCustomChannel(addr.str(), InsecureChannelCredentials(), args);
+      GPR_ASSERT(channel->WaitForConnected(
+          gpr_time_add(gpr_now(GPR_CLOCK_REALTIME),
+                       gpr_time_from_seconds(30, GPR_TIMESPAN))));
+      state.PauseTiming();
+      channel.reset();
+      state.ResumeTiming();
+    }
+    server->Shutdown();
+    cq->Shutdown();
+    void* t;
+    bool ok;
+    while (cq->Next(&t, &ok)) {
+    }
+    grpc_recycle_unused_port(port);
+  }
+  grpc_shutdown();
+}
+BENCHMARK(BM_ChannelCreationToReady);
+
+/*******************************************************************************
+ * TIME TO FIRST RESPONSE
+ */
+
+/* TCP-over-loopback fixture with TLS on both ends; mirrors the insecure
+   TCP fixture in fullstack_fixtures.h but with the test credentials */
+class SecureTCP : public BaseFixture {
+ public:
+  explicit SecureTCP(Service* service) {
+    port_ = grpc_pick_unused_port_or_die();
+    std::stringstream addr;
+    addr << "localhost:" << port_;
+    SslServerCredentialsOptions server_opts;
+    SslServerCredentialsOptions::PemKeyCertPair pkcp = {test_server1_key,
+                                                        test_server1_cert};
+    server_opts.pem_key_cert_pairs.push_back(pkcp);
+    ServerBuilder b;
+    b.AddListeningPort(addr.str(), SslServerCredentials(server_opts));
+    cq_ = b.AddCompletionQueue(true);
+    b.RegisterService(service);
+    server_ = b.BuildAndStart();
+    SslCredentialsOptions ssl_opts;
+    ssl_opts.pem_root_certs = test_root_cert;
+    ChannelArguments args;
+    args.SetSslTargetNameOverride("foo.test.google.fr");
+    channel_ = CreateCustomChannel(addr.str(), SslCredentials(ssl_opts), args);
+  }
+
+  virtual ~SecureTCP() {
+    server_->Shutdown();
+    cq_->Shutdown();
+    void* tag;
+    bool ok;
+    while (cq_->Next(&tag, &ok)) {
+    }
+    grpc_recycle_unused_port(port_);
+  }
+
+  ServerCompletionQueue* cq() { return cq_.get(); }
+  std::shared_ptr<Channel> channel() { return channel_; }
+
+ private:
+  int port_;
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<ServerCompletionQueue> cq_;
+  std::shared_ptr<Channel> channel_;
+};
+
+/* Everything between "process decides to serve" and the first response on
+   the wire: server startup, channel creation, resolution, connect (and the
+   TLS handshake for SecureTCP), and one unary echo. Teardown runs with the
+   timer paused - it is not part of startup. */
+template <class Fixture>
+static void BM_TimeToFirstResponse(benchmark::State& state) {
+  grpc_init();
+  EchoRequest send_request;
+  EchoResponse send_response;
+  while (state.KeepRunning()) {
+    {
+      EchoTestService::AsyncService service;
+      Fixture fixture(&service);
+      ServerContext svr_ctx;
+      EchoRequest recv_request;
+      grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&svr_ctx);
+      service.RequestEcho(&svr_ctx, &recv_request, &response_writer,
+                          fixture.cq(), fixture.cq(), tag(0));
+      std::unique_ptr<EchoTestService::Stub> stub(
+          EchoTestService::NewStub(fixture.channel()));
+      ClientContext cli_ctx;
+      EchoResponse recv_response;
+      Status recv_status;
+      std::unique_ptr<ClientAsyncResponseReader<EchoResponse>> response_reader(
+          stub->AsyncEcho(&cli_ctx, send_request, fixture.cq()));
+      void* t;
+      bool ok;
+      GPR_ASSERT(fixture.cq()->Next(&t, &ok));
+      GPR_ASSERT(ok && t == tag(0));
+      response_writer.Finish(send_response, Status::OK, tag(1));
+      response_reader->Finish(&recv_response, &recv_status, tag(2));
+      for (int i = (1 << 1) | (1 << 2); i != 0;) {
+        GPR_ASSERT(fixture.cq()->Next(&t, &ok));
+        GPR_ASSERT(ok);
+        int tagnum = (int)reinterpret_cast<intptr_t>(t);
+        GPR_ASSERT(i & (1 << tagnum));
+        i -= 1 << tagnum;
+      }
+      GPR_ASSERT(recv_status.ok());
+      state.PauseTiming();
+    }
+    state.ResumeTiming();
+  }
+  grpc_shutdown();
+}
+BENCHMARK_TEMPLATE(BM_TimeToFirstResponse, TCP);
+BENCHMARK_TEMPLATE(BM_TimeToFirstResponse, SecureTCP);
+
+}  // namespace testing
+}  // namespace grpc
+
+BENCHMARK_MAIN();
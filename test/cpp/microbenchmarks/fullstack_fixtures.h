@@ -44,6 +44,7 @@
 
 extern "C" {
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/inproc/inproc_transport.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
@@ -154,6 +155,49 @@ class UDS : public FullstackFixture {
   }
 };
 
+class InProcess : public BaseFixture {
+ public:
+  InProcess(Service* service, const FixtureConfiguration& fixture_configuration =
+                                  FixtureConfiguration()) {
+    ServerBuilder b;
+    cq_ = b.AddCompletionQueue(true);
+    b.RegisterService(service);
+    fixture_configuration.ApplyCommonServerBuilderConfig(&b);
+    server_ = b.BuildAndStart();
+
+    ChannelArguments args;
+    fixture_configuration.ApplyCommonChannelArguments(&args);
+    grpc_channel_args c_args = args.c_channel_args();
+    grpc_channel* channel =
+        grpc_inproc_channel_create(server_->c_server(), &c_args, NULL);
+    GPR_ASSERT(channel);
+    channel_ = CreateChannelInternal("", channel);
+  }
+
+  virtual ~InProcess() {
+    server_->Shutdown();
+    cq_->Shutdown();
+    void* tag;
+    bool ok;
+    while (cq_->Next(&tag, &ok)) {
+    }
+  }
+
+  void AddToLabel(std::ostream& out, benchmark::State& state) {
+    BaseFixture::AddToLabel(out, state);
+    out << " polls/iter:"
+        << (double)grpc_get_cq_poll_num(this->cq()->cq()) / state.iterations();
+  }
+
+  ServerCompletionQueue* cq() { return cq_.get(); }
+  std::shared_ptr<Channel> channel() { return channel_; }
+
+ private:
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<ServerCompletionQueue> cq_;
+  std::shared_ptr<Channel> channel_;
+};
+
 class EndpointPairFixture : public BaseFixture {
  public:
   EndpointPairFixture(Service* service, grpc_endpoint_pair endpoints,
@@ -295,6 +339,7 @@ class MinStackize : public Base {
 typedef MinStackize<TCP> MinTCP;
 typedef MinStackize<UDS> MinUDS;
 typedef MinStackize<SockPair> MinSockPair;
+typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
 }  // namespace testing
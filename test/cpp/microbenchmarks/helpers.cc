@@ -33,6 +33,60 @@
 
 #include "test/cpp/microbenchmarks/helpers.h"
 
+#ifdef GPR_LINUX
+#include <grpc/support/useful.h>
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int perf_event_open_for_thread(uint32_t type, uint64_t config,
+                                      int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = type;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  // only the group leader starts disabled; the others inherit its state
+  attr.disabled = group_fd == -1;
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+TrackCounters::TrackCounters() {
+#ifdef GPR_LINUX
+  static const uint64_t configs[] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  int group_fd = -1;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(configs); i++) {
+    perf_fds_[i] =
+        perf_event_open_for_thread(PERF_TYPE_HARDWARE, configs[i], group_fd);
+    if (perf_fds_[i] == -1) {
+      // all-or-nothing: a partial group would skew the derived ratios
+      while (i > 0) {
+        close(perf_fds_[--i]);
+        perf_fds_[i] = -1;
+      }
+      return;
+    }
+    if (group_fd == -1) group_fd = perf_fds_[i];
+  }
+  ioctl(group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+TrackCounters::~TrackCounters() {
+#ifdef GPR_LINUX
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(perf_fds_); i++) {
+    if (perf_fds_[i] != -1) close(perf_fds_[i]);
+  }
+#endif
+}
+
 void TrackCounters::Finish(benchmark::State &state) {
   std::ostringstream out;
   AddToLabel(out, state);
@@ -44,6 +98,28 @@ void TrackCounters::Finish(benchmark::State &state) {
 }
 
 void TrackCounters::AddToLabel(std::ostream &out, benchmark::State &state) {
+#ifdef GPR_LINUX
+  if (perf_fds_[0] != -1) {
+    ioctl(perf_fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    struct {
+      uint64_t nr;
+      uint64_t values[4];
+    } data;
+    memset(&data, 0, sizeof(data));
+    if (read(perf_fds_[0], &data, sizeof(data)) >= 0 && data.nr == 4) {
+      const double cycles = (double)data.values[0];
+      const double instructions = (double)data.values[1];
+      const double cache_misses = (double)data.values[2];
+      const double branch_misses = (double)data.values[3];
+      if (cycles > 0) {
+        out << " ipc:" << instructions / cycles;
+      }
+      out << " llc_misses/iter:" << cache_misses / (double)state.iterations()
+          << " branch_misses/iter:"
+          << branch_misses / (double)state.iterations();
+    }
+  }
+#endif
 #ifdef GPR_LOW_LEVEL_COUNTERS
   grpc_memory_counters counters_at_end = grpc_memory_counters_snapshot();
   out << " locks/iter:" << ((double)(gpr_atm_no_barrier_load(&gpr_mu_locks) -
@@ -61,6 +137,14 @@ void TrackCounters::AddToLabel(std::ostream &out, benchmark::State &state) {
       << ((double)(gpr_atm_no_barrier_load(&gpr_now_call_count) -
                    now_calls_at_start_) /
           (double)state.iterations())
+      << " intern_hits/iter:"
+      << ((double)(gpr_atm_no_barrier_load(&grpc_slice_intern_hits) -
+                   intern_hits_at_start_) /
+          (double)state.iterations())
+      << " intern_inserts/iter:"
+      << ((double)(gpr_atm_no_barrier_load(&grpc_slice_intern_inserts) -
+                   intern_inserts_at_start_) /
+          (double)state.iterations())
       << " allocs/iter:"
       << ((double)(counters_at_end.total_allocs_absolute -
                    counters_at_start_.total_allocs_absolute) /
@@ -73,14 +73,25 @@ extern "C" gpr_atm gpr_mu_locks;
 extern "C" gpr_atm gpr_counter_atm_cas;
 extern "C" gpr_atm gpr_counter_atm_add;
 extern "C" gpr_atm gpr_now_call_count;
+extern "C" gpr_atm grpc_slice_intern_hits;
+extern "C" gpr_atm grpc_slice_intern_inserts;
 #endif
 
 class TrackCounters {
  public:
+  TrackCounters();
+  virtual ~TrackCounters();
   virtual void Finish(benchmark::State& state);
   virtual void AddToLabel(std::ostream& out, benchmark::State& state);
 
  private:
+#ifdef GPR_LINUX
+  // perf_event_open group counting cycles (leader), instructions, LLC
+  // misses and branch misses for this thread, so benchmark labels carry
+  // ipc / llc_misses/iter / branch_misses/iter. All fds are -1 if the
+  // kernel refused the events (perf_event_paranoid, containers, no PMU).
+  int perf_fds_[4];
+#endif
 #ifdef GPR_LOW_LEVEL_COUNTERS
   const size_t mu_locks_at_start_ = gpr_atm_no_barrier_load(&gpr_mu_locks);
   const size_t atm_cas_at_start_ =
@@ -89,6 +100,10 @@ class TrackCounters {
       gpr_atm_no_barrier_load(&gpr_counter_atm_add);
   const size_t now_calls_at_start_ =
       gpr_atm_no_barrier_load(&gpr_now_call_count);
+  const size_t intern_hits_at_start_ =
+      gpr_atm_no_barrier_load(&grpc_slice_intern_hits);
+  const size_t intern_inserts_at_start_ =
+      gpr_atm_no_barrier_load(&grpc_slice_intern_inserts);
   grpc_memory_counters counters_at_start_ = grpc_memory_counters_snapshot();
 #endif
 };
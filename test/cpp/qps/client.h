@@ -36,6 +36,7 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
@@ -146,6 +147,90 @@ inline void MergeStatusHistogram(const StatusHistogram& from,
   }
 }
 
+// Under open-loop (Poisson) load, latency must be charged from the moment
+// the schedule intended the request to go out rather than from the moment
+// the client actually issued it; otherwise a client that falls behind (or
+// a server that stalls it) silently drops queuing delay from the histogram
+// (coordinated omission) and a saturated server looks faster than it is.
+// Returns the lateness in nanoseconds, zero if the request is on schedule.
+inline double IssueTimeLateness(const gpr_timespec& intended_time) {
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  if (gpr_time_cmp(now, intended_time) <= 0) {
+    return 0.0;
+  }
+  const gpr_timespec late = gpr_time_sub(now, intended_time);
+  return late.tv_sec * 1e9 + late.tv_nsec;
+}
+
+// Synthetic per-RPC metadata load configured through MetadataParams. Keys
+// and value variants are built once at setup so the per-RPC cost is just
+// the AddMetadata calls; value cardinality is realised by cycling through
+// the pre-built variants, which defeats hpack's dynamic table the same
+// way high-cardinality tracing keys do in production.
+class MetadataLoad {
+ public:
+  MetadataLoad() : seq_(0) {}
+
+  void Init(const MetadataParams& params) {
+    const int cardinality =
+        params.value_cardinality() > 1 ? params.value_cardinality() : 1;
+    for (int i = 0; i < params.num_ascii_entries(); i++) {
+      std::ostringstream key;
+      key << "qps-md-" << i;
+      ascii_keys_.push_back(key.str());
+    }
+    for (int i = 0; i < params.num_binary_entries(); i++) {
+      std::ostringstream key;
+      key << "qps-md-" << i << "-bin";
+      binary_keys_.push_back(key.str());
+    }
+    for (int c = 0; c < cardinality; c++) {
+      ascii_values_.push_back(BuildValue(params.ascii_value_size(), c, false));
+      binary_values_.push_back(BuildValue(params.binary_value_size(), c, true));
+    }
+  }
+
+  // Attach the configured load to an RPC (or stream) about to start.
+  // Thread safe: the only shared mutable state is the sequence counter.
+  void Apply(grpc::ClientContext* context) {
+    if (ascii_keys_.empty() && binary_keys_.empty()) {
+      return;
+    }
+    const size_t seq =
+        static_cast<size_t>(gpr_atm_no_barrier_fetch_add(&seq_, 1));
+    const size_t cardinality = ascii_values_.size();
+    for (size_t i = 0; i < ascii_keys_.size(); i++) {
+      context->AddMetadata(ascii_keys_[i],
+                           ascii_values_[(seq + i) % cardinality]);
+    }
+    for (size_t i = 0; i < binary_keys_.size(); i++) {
+      context->AddMetadata(binary_keys_[i],
+                           binary_values_[(seq + i) % cardinality]);
+    }
+  }
+
+ private:
+  static grpc::string BuildValue(int size, int variant, bool binary) {
+    if (size < 1) {
+      size = 1;
+    }
+    grpc::string value(size, binary ? '\0' : 'a');
+    // stamp the variant index so each value in the cycle is distinct
+    for (size_t i = 0; i < value.size() && variant != 0; i++) {
+      value[i] = binary ? static_cast<char>(variant & 0xff)
+                        : static_cast<char>('a' + variant % 26);
+      variant = binary ? variant >> 8 : variant / 26;
+    }
+    return value;
+  }
+
+  std::vector<grpc::string> ascii_keys_;
+  std::vector<grpc::string> binary_keys_;
+  std::vector<grpc::string> ascii_values_;
+  std::vector<grpc::string> binary_values_;
+  gpr_atm seq_;
+};
+
 class Client {
  public:
   Client()
@@ -290,26 +375,65 @@ class Client {
   class Thread {
    public:
     Thread(Client* client, size_t idx)
-        : client_(client), idx_(idx), impl_(&Thread::ThreadFunc, this) {}
+        : active_stats_(0),
+          recording_(0),
+          client_(client),
+          idx_(idx),
+          impl_(&Thread::ThreadFunc, this) {}
 
     ~Thread() { impl_.join(); }
 
     void BeginSwap(Histogram* n, StatusHistogram* s) {
-      std::lock_guard<std::mutex> g(mu_);
-      n->Swap(&histogram_);
-      s->swap(statuses_);
+      // Drain both buffers so that a reset leaves this thread with empty
+      // stats; each retirement flips which buffer the worker writes, so
+      // two passes observe every recorded entry exactly once
+      for (int i = 0; i < 2; i++) {
+        Stats* stats = RetireStats();
+        n->Merge(stats->latencies);
+        Histogram drained;
+        drained.Swap(&stats->latencies);
+        MergeStatusHistogram(stats->statuses, s);
+        stats->statuses.clear();
+      }
     }
 
     void MergeStatsInto(Histogram* hist, StatusHistogram* s) {
-      std::unique_lock<std::mutex> g(mu_);
-      hist->Merge(histogram_);
-      MergeStatusHistogram(statuses_, s);
+      // As in BeginSwap, visit both buffers, but leave their contents in
+      // place so that a non-reset mark reports a running total
+      for (int i = 0; i < 2; i++) {
+        Stats* stats = RetireStats();
+        hist->Merge(stats->latencies);
+        MergeStatusHistogram(stats->statuses, s);
+      }
     }
 
    private:
     Thread(const Thread&);
     Thread& operator=(const Thread&);
 
+    // Stats are double-buffered so that per-RPC recording is lock free:
+    // the worker records into stats_[active_stats_] while recording_ is
+    // raised, and the reporting thread takes exclusive ownership of a
+    // buffer with RetireStats(). This keeps the per-RPC cost to a pair of
+    // atomic operations instead of a mutex shared with the reporting path.
+    struct Stats {
+      Histogram latencies;
+      StatusHistogram statuses;
+    };
+
+    // Returns a buffer the worker is guaranteed not to touch again until
+    // the next retirement. Only called from the reporting thread, which is
+    // the sole writer of active_stats_.
+    Stats* RetireStats() {
+      const gpr_atm retired = gpr_atm_no_barrier_load(&active_stats_);
+      gpr_atm_full_xchg(&active_stats_, 1 - retired);
+      // wait out a worker that raised recording_ before the flip became
+      // visible to it; the critical section is a single histogram update
+      while (gpr_atm_acq_load(&recording_) != 0) {
+      }
+      return &stats_[retired];
+    }
+
     void ThreadFunc() {
       while (!gpr_event_wait(
           &client_->start_requests_,
@@ -322,13 +446,20 @@ class Client {
         // run the loop body
         HistogramEntry entry;
         const bool thread_still_ok = client_->ThreadFunc(&entry, idx_);
-        // lock, update histogram if needed and see if we're done
-        std::lock_guard<std::mutex> g(mu_);
-        if (entry.value_used()) {
-          histogram_.Add(entry.value());
-        }
-        if (entry.status_used()) {
-          statuses_[entry.status()]++;
+        // update the active stats buffer if needed: the full barrier on
+        // recording_ orders the flag ahead of the active_stats_ load, so
+        // a concurrent RetireStats either waits for us or has already
+        // directed us at the fresh buffer
+        if (entry.value_used() || entry.status_used()) {
+          gpr_atm_full_xchg(&recording_, 1);
+          Stats* stats = &stats_[gpr_atm_acq_load(&active_stats_)];
+          if (entry.value_used()) {
+            stats->latencies.Add(entry.value());
+          }
+          if (entry.status_used()) {
+            stats->statuses[entry.status()]++;
+          }
+          gpr_atm_rel_store(&recording_, 0);
         }
         if (!thread_still_ok) {
           gpr_log(GPR_ERROR, "Finishing client thread due to RPC error");
@@ -341,9 +472,9 @@ class Client {
       }
     }
 
-    std::mutex mu_;
-    Histogram histogram_;
-    StatusHistogram statuses_;
+    Stats stats_[2];
+    gpr_atm active_stats_;
+    gpr_atm recording_;
     Client* client_;
     const size_t idx_;
     std::thread impl_;
@@ -396,12 +527,14 @@ class ClientImpl : public Client {
 
     ClientRequestCreator<RequestType> create_req(&request_,
                                                  config.payload_config());
+    metadata_load_.Init(config.metadata_params());
   }
   virtual ~ClientImpl() {}
 
  protected:
   const int cores_;
   RequestType request_;
+  MetadataLoad metadata_load_;
 
   class ClientChannelInfo {
    public:
@@ -63,7 +63,9 @@ class ClientRpcContext {
   virtual ~ClientRpcContext() {}
   // next state, return false if done. Collect stats when appropriate
   virtual bool RunNextState(bool, HistogramEntry* entry) = 0;
-  virtual void StartNewClone(CompletionQueue* cq) = 0;
+  // restart this context for a fresh RPC, reusing its messages and
+  // storage so the steady state of the benchmark stays off the allocator
+  virtual void Reset() = 0;
   static void* tag(ClientRpcContext* c) { return reinterpret_cast<void*>(c); }
   static ClientRpcContext* detag(void* t) {
     return reinterpret_cast<ClientRpcContext*>(t);
@@ -77,7 +79,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
  public:
   ClientRpcContextUnaryImpl(
       BenchmarkService::Stub* stub, const RequestType& req,
-      std::function<gpr_timespec()> next_issue,
+      std::function<gpr_timespec()> next_issue, MetadataLoad* metadata_load,
       std::function<
           std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>(
               BenchmarkService::Stub*, grpc::ClientContext*, const RequestType&,
@@ -92,6 +94,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
         next_state_(State::READY),
         callback_(on_done),
         next_issue_(next_issue),
+        metadata_load_(metadata_load),
         start_req_(start_req) {}
   ~ClientRpcContextUnaryImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
@@ -101,6 +104,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
     switch (next_state_) {
       case State::READY:
         start_ = UsageTimer::Now();
+        lateness_ = next_issue_ ? IssueTimeLateness(issue_time_) : 0.0;
         response_reader_ = start_req_(stub_, &context_, req_, cq_);
         next_state_ = State::RESP_DONE;
         response_reader_->Finish(&response_, &status_,
@@ -108,7 +112,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
         return true;
       case State::RESP_DONE:
         if (status_.ok()) {
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_value((UsageTimer::Now() - start_) * 1e9 + lateness_);
         }
         callback_(status_, &response_, entry);
         next_state_ = State::INVALID;
@@ -118,10 +122,15 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
         return false;
     }
   }
-  void StartNewClone(CompletionQueue* cq) override {
-    auto* clone = new ClientRpcContextUnaryImpl(stub_, req_, next_issue_,
-                                                start_req_, callback_);
-    clone->StartInternal(cq);
+  void Reset() override {
+    // ClientContext cannot be reused across calls, so reconstruct it in
+    // place; the messages keep their storage
+    context_.~ClientContext();
+    new (&context_) ClientContext();
+    response_.Clear();
+    status_ = grpc::Status();
+    next_state_ = State::READY;
+    StartInternal(cq_);
   }
 
  private:
@@ -135,21 +144,26 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   State next_state_;
   std::function<void(grpc::Status, ResponseType*, HistogramEntry*)> callback_;
   std::function<gpr_timespec()> next_issue_;
+  MetadataLoad* metadata_load_;
   std::function<std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>(
       BenchmarkService::Stub*, grpc::ClientContext*, const RequestType&,
       CompletionQueue*)>
       start_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;  // intended issue time under open-loop load
+  double lateness_;
   std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>
       response_reader_;
 
   void StartInternal(CompletionQueue* cq) {
     cq_ = cq;
+    metadata_load_->Apply(&context_);
     if (!next_issue_) {  // ready to issue
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
-      alarm_.reset(new Alarm(cq_, next_issue_(), ClientRpcContext::tag(this)));
+      issue_time_ = next_issue_();
+      alarm_.reset(new Alarm(cq_, issue_time_, ClientRpcContext::tag(this)));
     }
   }
 };
@@ -167,10 +181,11 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
   using ClientImpl<StubType, RequestType>::cores_;
   using ClientImpl<StubType, RequestType>::channels_;
   using ClientImpl<StubType, RequestType>::request_;
+  using ClientImpl<StubType, RequestType>::metadata_load_;
   AsyncClient(const ClientConfig& config,
               std::function<ClientRpcContext*(
                   StubType*, std::function<gpr_timespec()> next_issue,
-                  const RequestType&)>
+                  MetadataLoad* metadata_load, const RequestType&)>
                   setup_ctx,
               std::function<std::unique_ptr<StubType>(std::shared_ptr<Channel>)>
                   create_stub)
@@ -188,8 +203,8 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
     for (int ch = 0; ch < config.client_channels(); ch++) {
       for (int i = 0; i < config.outstanding_rpcs_per_channel(); i++) {
         auto* cq = cli_cqs_[t].get();
-        auto ctx =
-            setup_ctx(channels_[ch].get_stub(), next_issuers_[t], request_);
+        auto ctx = setup_ctx(channels_[ch].get_stub(), next_issuers_[t],
+                             &metadata_load_, request_);
         ctx->Start(cq, config);
       }
       t = (t + 1) % cli_cqs_.size();
@@ -256,11 +271,9 @@ class AsyncClient : public ClientImpl<StubType, RequestType> {
         delete ctx;
         return true;
       } else if (!ctx->RunNextState(ok, entry)) {
-        // The RPC and callback are done, so clone the ctx
-        // and kickstart the new one
-        ctx->StartNewClone(cli_cqs_[thread_idx].get());
-        // delete the old version
-        delete ctx;
+        // The RPC and callback are done, so recycle the context for a
+        // fresh call rather than going back to the allocator
+        ctx->Reset();
       }
       return true;
     } else {
@@ -301,9 +314,10 @@ class AsyncUnaryClient final
   };
   static ClientRpcContext* SetupCtx(BenchmarkService::Stub* stub,
                                     std::function<gpr_timespec()> next_issue,
+                                    MetadataLoad* metadata_load,
                                     const SimpleRequest& req) {
     return new ClientRpcContextUnaryImpl<SimpleRequest, SimpleResponse>(
-        stub, req, next_issue, AsyncUnaryClient::StartReq,
+        stub, req, next_issue, metadata_load, AsyncUnaryClient::StartReq,
         AsyncUnaryClient::CheckDone);
   }
 };
@@ -313,7 +327,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
  public:
   ClientRpcContextStreamingPingPongImpl(
       BenchmarkService::Stub* stub, const RequestType& req,
-      std::function<gpr_timespec()> next_issue,
+      std::function<gpr_timespec()> next_issue, MetadataLoad* metadata_load,
       std::function<std::unique_ptr<
           grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>(
           BenchmarkService::Stub*, grpc::ClientContext*, CompletionQueue*,
@@ -328,6 +342,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
         next_state_(State::INVALID),
         callback_(on_done),
         next_issue_(next_issue),
+        metadata_load_(metadata_load),
         start_req_(start_req) {}
   ~ClientRpcContextStreamingPingPongImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
@@ -345,14 +360,16 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
+          issue_time_ = next_issue_();
           alarm_.reset(
-              new Alarm(cq_, next_issue_(), ClientRpcContext::tag(this)));
+              new Alarm(cq_, issue_time_, ClientRpcContext::tag(this)));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
           start_ = UsageTimer::Now();
+          lateness_ = next_issue_ ? IssueTimeLateness(issue_time_) : 0.0;
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -365,7 +382,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
           return true;
           break;
         case State::READ_DONE:
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_value((UsageTimer::Now() - start_) * 1e9 + lateness_);
           callback_(status_, &response_);
           if ((messages_per_stream_ != 0) &&
               (++messages_issued_ >= messages_per_stream_)) {
@@ -389,10 +406,12 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
       }
     }
   }
-  void StartNewClone(CompletionQueue* cq) override {
-    auto* clone = new ClientRpcContextStreamingPingPongImpl(
-        stub_, req_, next_issue_, start_req_, callback_);
-    clone->StartInternal(cq, messages_per_stream_);
+  void Reset() override {
+    context_.~ClientContext();
+    new (&context_) ClientContext();
+    response_.Clear();
+    status_ = grpc::Status();
+    StartInternal(cq_, messages_per_stream_);
   }
 
  private:
@@ -415,12 +434,15 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
   State next_state_;
   std::function<void(grpc::Status, ResponseType*)> callback_;
   std::function<gpr_timespec()> next_issue_;
+  MetadataLoad* metadata_load_;
   std::function<std::unique_ptr<
       grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>(
       BenchmarkService::Stub*, grpc::ClientContext*, CompletionQueue*, void*)>
       start_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;  // intended issue time under open-loop load
+  double lateness_;
   std::unique_ptr<grpc::ClientAsyncReaderWriter<RequestType, ResponseType>>
       stream_;
 
@@ -433,6 +455,7 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
     messages_per_stream_ = messages_per_stream;
     messages_issued_ = 0;
     next_state_ = State::STREAM_IDLE;
+    metadata_load_->Apply(&context_);
     stream_ = start_req_(stub_, &context_, cq, ClientRpcContext::tag(this));
   }
 };
@@ -459,10 +482,12 @@ class AsyncStreamingPingPongClient final
   };
   static ClientRpcContext* SetupCtx(BenchmarkService::Stub* stub,
                                     std::function<gpr_timespec()> next_issue,
+                                    MetadataLoad* metadata_load,
                                     const SimpleRequest& req) {
     return new ClientRpcContextStreamingPingPongImpl<SimpleRequest,
                                                      SimpleResponse>(
-        stub, req, next_issue, AsyncStreamingPingPongClient::StartReq,
+        stub, req, next_issue, metadata_load,
+        AsyncStreamingPingPongClient::StartReq,
         AsyncStreamingPingPongClient::CheckDone);
   }
 };
@@ -472,7 +497,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
  public:
   ClientRpcContextStreamingFromClientImpl(
       BenchmarkService::Stub* stub, const RequestType& req,
-      std::function<gpr_timespec()> next_issue,
+      std::function<gpr_timespec()> next_issue, MetadataLoad* metadata_load,
       std::function<std::unique_ptr<grpc::ClientAsyncWriter<RequestType>>(
           BenchmarkService::Stub*, grpc::ClientContext*, ResponseType*,
           CompletionQueue*, void*)>
@@ -486,6 +511,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
         next_state_(State::INVALID),
         callback_(on_done),
         next_issue_(next_issue),
+        metadata_load_(metadata_load),
         start_req_(start_req) {}
   ~ClientRpcContextStreamingFromClientImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
@@ -502,8 +528,9 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
           }
           break;  // loop around, don't return
         case State::WAIT:
+          issue_time_ = next_issue_();
           alarm_.reset(
-              new Alarm(cq_, next_issue_(), ClientRpcContext::tag(this)));
+              new Alarm(cq_, issue_time_, ClientRpcContext::tag(this)));
           next_state_ = State::READY_TO_WRITE;
           return true;
         case State::READY_TO_WRITE:
@@ -511,6 +538,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
             return false;
           }
           start_ = UsageTimer::Now();
+          lateness_ = next_issue_ ? IssueTimeLateness(issue_time_) : 0.0;
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -518,7 +546,7 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
           if (!ok) {
             return false;
           }
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_value((UsageTimer::Now() - start_) * 1e9 + lateness_);
           next_state_ = State::STREAM_IDLE;
           break;  // loop around
         default:
@@ -527,10 +555,12 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
       }
     }
   }
-  void StartNewClone(CompletionQueue* cq) override {
-    auto* clone = new ClientRpcContextStreamingFromClientImpl(
-        stub_, req_, next_issue_, start_req_, callback_);
-    clone->StartInternal(cq);
+  void Reset() override {
+    context_.~ClientContext();
+    new (&context_) ClientContext();
+    response_.Clear();
+    status_ = grpc::Status();
+    StartInternal(cq_);
   }
 
  private:
@@ -550,16 +580,20 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
   State next_state_;
   std::function<void(grpc::Status, ResponseType*)> callback_;
   std::function<gpr_timespec()> next_issue_;
+  MetadataLoad* metadata_load_;
   std::function<std::unique_ptr<grpc::ClientAsyncWriter<RequestType>>(
       BenchmarkService::Stub*, grpc::ClientContext*, ResponseType*,
       CompletionQueue*, void*)>
       start_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;  // intended issue time under open-loop load
+  double lateness_;
   std::unique_ptr<grpc::ClientAsyncWriter<RequestType>> stream_;
 
   void StartInternal(CompletionQueue* cq) {
     cq_ = cq;
+    metadata_load_->Apply(&context_);
     stream_ = start_req_(stub_, &context_, &response_, cq,
                          ClientRpcContext::tag(this));
     next_state_ = State::STREAM_IDLE;
@@ -587,10 +621,12 @@ class AsyncStreamingFromClientClient final
   };
   static ClientRpcContext* SetupCtx(BenchmarkService::Stub* stub,
                                     std::function<gpr_timespec()> next_issue,
+                                    MetadataLoad* metadata_load,
                                     const SimpleRequest& req) {
     return new ClientRpcContextStreamingFromClientImpl<SimpleRequest,
                                                        SimpleResponse>(
-        stub, req, next_issue, AsyncStreamingFromClientClient::StartReq,
+        stub, req, next_issue, metadata_load,
+        AsyncStreamingFromClientClient::StartReq,
         AsyncStreamingFromClientClient::CheckDone);
   }
 };
@@ -600,7 +636,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
  public:
   ClientRpcContextStreamingFromServerImpl(
       BenchmarkService::Stub* stub, const RequestType& req,
-      std::function<gpr_timespec()> next_issue,
+      std::function<gpr_timespec()> next_issue, MetadataLoad* metadata_load,
       std::function<std::unique_ptr<grpc::ClientAsyncReader<ResponseType>>(
           BenchmarkService::Stub*, grpc::ClientContext*, const RequestType&,
           CompletionQueue*, void*)>
@@ -614,6 +650,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
         next_state_(State::INVALID),
         callback_(on_done),
         next_issue_(next_issue),
+        metadata_load_(metadata_load),
         start_req_(start_req) {}
   ~ClientRpcContextStreamingFromServerImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
@@ -644,10 +681,12 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
       }
     }
   }
-  void StartNewClone(CompletionQueue* cq) override {
-    auto* clone = new ClientRpcContextStreamingFromServerImpl(
-        stub_, req_, next_issue_, start_req_, callback_);
-    clone->StartInternal(cq);
+  void Reset() override {
+    context_.~ClientContext();
+    new (&context_) ClientContext();
+    response_.Clear();
+    status_ = grpc::Status();
+    StartInternal(cq_);
   }
 
  private:
@@ -661,6 +700,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
   State next_state_;
   std::function<void(grpc::Status, ResponseType*)> callback_;
   std::function<gpr_timespec()> next_issue_;
+  MetadataLoad* metadata_load_;
   std::function<std::unique_ptr<grpc::ClientAsyncReader<ResponseType>>(
       BenchmarkService::Stub*, grpc::ClientContext*, const RequestType&,
       CompletionQueue*, void*)>
@@ -673,6 +713,7 @@ class ClientRpcContextStreamingFromServerImpl : public ClientRpcContext {
     // TODO(vjpai): Add support to rate-pace this
     cq_ = cq;
     next_state_ = State::STREAM_IDLE;
+    metadata_load_->Apply(&context_);
     stream_ =
         start_req_(stub_, &context_, req_, cq, ClientRpcContext::tag(this));
   }
@@ -699,10 +740,12 @@ class AsyncStreamingFromServerClient final
   };
   static ClientRpcContext* SetupCtx(BenchmarkService::Stub* stub,
                                     std::function<gpr_timespec()> next_issue,
+                                    MetadataLoad* metadata_load,
                                     const SimpleRequest& req) {
     return new ClientRpcContextStreamingFromServerImpl<SimpleRequest,
                                                        SimpleResponse>(
-        stub, req, next_issue, AsyncStreamingFromServerClient::StartReq,
+        stub, req, next_issue, metadata_load,
+        AsyncStreamingFromServerClient::StartReq,
         AsyncStreamingFromServerClient::CheckDone);
   }
 };
@@ -711,7 +754,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
  public:
   ClientRpcContextGenericStreamingImpl(
       grpc::GenericStub* stub, const ByteBuffer& req,
-      std::function<gpr_timespec()> next_issue,
+      std::function<gpr_timespec()> next_issue, MetadataLoad* metadata_load,
       std::function<std::unique_ptr<grpc::GenericClientAsyncReaderWriter>(
           grpc::GenericStub*, grpc::ClientContext*,
           const grpc::string& method_name, CompletionQueue*, void*)>
@@ -725,6 +768,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
         next_state_(State::INVALID),
         callback_(on_done),
         next_issue_(next_issue),
+        metadata_load_(metadata_load),
         start_req_(start_req) {}
   ~ClientRpcContextGenericStreamingImpl() override {}
   void Start(CompletionQueue* cq, const ClientConfig& config) override {
@@ -742,14 +786,16 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
+          issue_time_ = next_issue_();
           alarm_.reset(
-              new Alarm(cq_, next_issue_(), ClientRpcContext::tag(this)));
+              new Alarm(cq_, issue_time_, ClientRpcContext::tag(this)));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
           start_ = UsageTimer::Now();
+          lateness_ = next_issue_ ? IssueTimeLateness(issue_time_) : 0.0;
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -762,7 +808,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
           return true;
           break;
         case State::READ_DONE:
-          entry->set_value((UsageTimer::Now() - start_) * 1e9);
+          entry->set_value((UsageTimer::Now() - start_) * 1e9 + lateness_);
           callback_(status_, &response_);
           if ((messages_per_stream_ != 0) &&
               (++messages_issued_ >= messages_per_stream_)) {
@@ -786,10 +832,12 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
       }
     }
   }
-  void StartNewClone(CompletionQueue* cq) override {
-    auto* clone = new ClientRpcContextGenericStreamingImpl(
-        stub_, req_, next_issue_, start_req_, callback_);
-    clone->StartInternal(cq, messages_per_stream_);
+  void Reset() override {
+    context_.~ClientContext();
+    new (&context_) ClientContext();
+    response_.Clear();
+    status_ = grpc::Status();
+    StartInternal(cq_, messages_per_stream_);
   }
 
  private:
@@ -812,12 +860,15 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
   State next_state_;
   std::function<void(grpc::Status, ByteBuffer*)> callback_;
   std::function<gpr_timespec()> next_issue_;
+  MetadataLoad* metadata_load_;
   std::function<std::unique_ptr<grpc::GenericClientAsyncReaderWriter>(
       grpc::GenericStub*, grpc::ClientContext*, const grpc::string&,
       CompletionQueue*, void*)>
       start_req_;
   grpc::Status status_;
   double start_;
+  gpr_timespec issue_time_;  // intended issue time under open-loop load
+  double lateness_;
   std::unique_ptr<grpc::GenericClientAsyncReaderWriter> stream_;
 
   // Allow a limit on number of messages in a stream
@@ -831,6 +882,7 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
     messages_per_stream_ = messages_per_stream;
     messages_issued_ = 0;
     next_state_ = State::STREAM_IDLE;
+    metadata_load_->Apply(&context_);
     stream_ = start_req_(stub_, &context_, kMethodName, cq,
                          ClientRpcContext::tag(this));
   }
@@ -862,9 +914,11 @@ class GenericAsyncStreamingClient final
   };
   static ClientRpcContext* SetupCtx(grpc::GenericStub* stub,
                                     std::function<gpr_timespec()> next_issue,
+                                    MetadataLoad* metadata_load,
                                     const ByteBuffer& req) {
     return new ClientRpcContextGenericStreamingImpl(
-        stub, req, next_issue, GenericAsyncStreamingClient::StartReq,
+        stub, req, next_issue, metadata_load,
+        GenericAsyncStreamingClient::StartReq,
         GenericAsyncStreamingClient::CheckDone);
   }
 };
@@ -72,6 +72,7 @@ class SynchronousClient
     num_threads_ =
         config.outstanding_rpcs_per_channel() * config.client_channels();
     responses_.resize(num_threads_);
+    issue_lateness_.resize(num_threads_, 0.0);
     SetupLoadTest(config, num_threads_);
   }
 
@@ -91,6 +92,10 @@ class SynchronousClient
                          gpr_time_from_seconds(1, GPR_TIMESPAN));
         if (gpr_time_cmp(next_issue_time, one_sec_delay) <= 0) {
           gpr_sleep_until(next_issue_time);
+          // Charge any lateness in issuing (e.g. because the previous RPC
+          // on this thread ran long) to the RPC about to go out, so that
+          // open-loop latency is measured from the intended issue time
+          issue_lateness_[thread_idx] = IssueTimeLateness(next_issue_time);
           return true;
         } else {
           gpr_sleep_until(one_sec_delay);
@@ -105,6 +110,8 @@ class SynchronousClient
 
   size_t num_threads_;
   std::vector<SimpleResponse> responses_;
+  // Lateness of the last issue per thread; stays zero under closed loop
+  std::vector<double> issue_lateness_;
 
  private:
   void DestroyMultithreading() override final { EndThreads(); }
@@ -126,10 +133,12 @@ class SynchronousUnaryClient final : public SynchronousClient {
     double start = UsageTimer::Now();
     GPR_TIMER_SCOPE("SynchronousUnaryClient::ThreadFunc", 0);
     grpc::ClientContext context;
+    metadata_load_.Apply(&context);
     grpc::Status s =
         stub->UnaryCall(&context, request_, &responses_[thread_idx]);
     if (s.ok()) {
-      entry->set_value((UsageTimer::Now() - start) * 1e9);
+      entry->set_value((UsageTimer::Now() - start) * 1e9 +
+                       issue_lateness_[thread_idx]);
     }
     entry->set_status(s.error_code());
     return true;
@@ -192,6 +201,7 @@ class SynchronousStreamingPingPongClient final
       : SynchronousStreamingClient(config) {
     for (size_t thread_idx = 0; thread_idx < num_threads_; thread_idx++) {
       auto* stub = channels_[thread_idx % channels_.size()].get_stub();
+      metadata_load_.Apply(&context_[thread_idx]);
       stream_[thread_idx] = stub->StreamingCall(&context_[thread_idx]);
       messages_issued_[thread_idx] = 0;
     }
@@ -219,7 +229,8 @@ class SynchronousStreamingPingPongClient final
     double start = UsageTimer::Now();
     if (stream_[thread_idx]->Write(request_) &&
         stream_[thread_idx]->Read(&responses_[thread_idx])) {
-      entry->set_value((UsageTimer::Now() - start) * 1e9);
+      entry->set_value((UsageTimer::Now() - start) * 1e9 +
+                       issue_lateness_[thread_idx]);
       // don't set the status since there isn't one yet
       if ((messages_per_stream_ != 0) &&
           (++messages_issued_[thread_idx] < messages_per_stream_)) {
@@ -233,6 +244,7 @@ class SynchronousStreamingPingPongClient final
     stream_[thread_idx]->WritesDone();
     FinishStream(entry, thread_idx);
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
+    metadata_load_.Apply(&context_[thread_idx]);
     stream_[thread_idx] = stub->StreamingCall(&context_[thread_idx]);
     messages_issued_[thread_idx] = 0;
     return true;
@@ -246,6 +258,7 @@ class SynchronousStreamingFromClientClient final
       : SynchronousStreamingClient(config), last_issue_(num_threads_) {
     for (size_t thread_idx = 0; thread_idx < num_threads_; thread_idx++) {
       auto* stub = channels_[thread_idx % channels_.size()].get_stub();
+      metadata_load_.Apply(&context_[thread_idx]);
       stream_[thread_idx] = stub->StreamingFromClient(&context_[thread_idx],
                                                       &responses_[thread_idx]);
       last_issue_[thread_idx] = UsageTimer::Now();
@@ -281,6 +294,7 @@ class SynchronousStreamingFromClientClient final
     stream_[thread_idx]->WritesDone();
     FinishStream(entry, thread_idx);
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
+    metadata_load_.Apply(&context_[thread_idx]);
     stream_[thread_idx] = stub->StreamingFromClient(&context_[thread_idx],
                                                     &responses_[thread_idx]);
     return true;
@@ -297,6 +311,7 @@ class SynchronousStreamingFromServerClient final
       : SynchronousStreamingClient(config), last_recv_(num_threads_) {
     for (size_t thread_idx = 0; thread_idx < num_threads_; thread_idx++) {
       auto* stub = channels_[thread_idx % channels_.size()].get_stub();
+      metadata_load_.Apply(&context_[thread_idx]);
       stream_[thread_idx] =
           stub->StreamingFromServer(&context_[thread_idx], request_);
       last_recv_[thread_idx] = UsageTimer::Now();
@@ -312,6 +327,7 @@ class SynchronousStreamingFromServerClient final
     }
     FinishStream(entry, thread_idx);
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
+    metadata_load_.Apply(&context_[thread_idx]);
     stream_[thread_idx] =
         stub->StreamingFromServer(&context_[thread_idx], request_);
     return true;
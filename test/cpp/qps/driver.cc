@@ -193,7 +193,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
     const ClientConfig& initial_client_config, size_t num_clients,
     const ServerConfig& initial_server_config, size_t num_servers,
     int warmup_seconds, int benchmark_seconds, int spawn_local_worker_count,
-    const char* qps_server_target_override) {
+    const char* qps_server_target_override, bool wait_for_steady_state) {
   // Log everything from the driver
   gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
 
@@ -373,6 +373,64 @@ std::unique_ptr<ScenarioResult> RunScenario(
   gpr_sleep_until(
       gpr_time_add(start, gpr_time_from_seconds(warmup_seconds, GPR_TIMESPAN)));
 
+  if (wait_for_steady_state) {
+    // Keep warming up until client throughput converges: sample per-interval
+    // qps via reset marks and extend the warmup until recent samples agree
+    // within a few percent (or the extension budget runs out). Configurations
+    // that ramp up slowly (many channels, deep outstanding-RPC queues) would
+    // otherwise leak their ramp into the measured interval and distort
+    // scaling comparisons.
+    const int sample_period_seconds = 2;
+    const int max_samples = warmup_seconds > 3 ? warmup_seconds : 3;
+    deque<double> qps_samples;
+    for (int s = 0; s < max_samples; s++) {
+      gpr_sleep_until(gpr_time_add(
+          gpr_now(GPR_CLOCK_REALTIME),
+          gpr_time_from_seconds(sample_period_seconds, GPR_TIMESPAN)));
+      double interval_count = 0;
+      double interval_time = 0;
+      for (size_t i = 0; i < num_clients; i++) {
+        auto client = &clients[i];
+        if (!client->stream->Write(client_mark)) {
+          gpr_log(GPR_ERROR, "Couldn't write mark to client %zu", i);
+        }
+      }
+      for (size_t i = 0; i < num_clients; i++) {
+        auto client = &clients[i];
+        if (!client->stream->Read(&client_status)) {
+          gpr_log(GPR_ERROR, "Couldn't get status from client %zu", i);
+          continue;
+        }
+        interval_count += client_status.stats().latencies().count();
+        interval_time += client_status.stats().time_elapsed();
+      }
+      qps_samples.push_back(
+          interval_time > 0 ? interval_count * num_clients / interval_time
+                            : 0);
+      if (qps_samples.size() > 3) {
+        qps_samples.pop_front();
+      }
+      if (qps_samples.size() == 3) {
+        double lo = qps_samples[0];
+        double hi = qps_samples[0];
+        for (size_t i = 1; i < qps_samples.size(); i++) {
+          if (qps_samples[i] < lo) lo = qps_samples[i];
+          if (qps_samples[i] > hi) hi = qps_samples[i];
+        }
+        gpr_log(GPR_INFO, "Steady-state check: interval qps in [%.1f, %.1f]",
+                lo, hi);
+        if (hi > 0 && (hi - lo) / hi < 0.05) {
+          gpr_log(GPR_INFO, "Throughput converged");
+          break;
+        }
+      }
+    }
+    // rebase 'start' so the benchmark sleep below still measures
+    // benchmark_seconds from this point
+    start = gpr_time_sub(gpr_now(GPR_CLOCK_REALTIME),
+                         gpr_time_from_seconds(warmup_seconds, GPR_TIMESPAN));
+  }
+
   // Start a run
   gpr_log(GPR_INFO, "Starting");
   for (size_t i = 0; i < num_servers; i++) {
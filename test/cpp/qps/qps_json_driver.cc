@@ -34,6 +34,9 @@
 #include <iostream>
 #include <memory>
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <grpc++/impl/codegen/config_protobuf.h>
 
@@ -68,6 +71,15 @@ DEFINE_double(error_tolerance, 0.01,
               "range is narrower than the error_tolerance computed range, we "
               "stop the search.");
 
+DEFINE_string(sweep_params, "",
+              "Run each scenario once per point of a scaling sweep instead of "
+              "once. Comma separated <param>=<v1>:<v2>:... entries, swept as "
+              "a full cross product; supported params are 'client_channels', "
+              "'outstanding_rpcs_per_channel', 'async_client_threads' and "
+              "'async_server_threads'. Each point extends its warmup until "
+              "throughput converges, and a consolidated throughput/latency "
+              "vs. scale table is logged after the last point.");
+
 DEFINE_string(qps_server_target_override, "",
               "Override QPS server target to configure in client configs."
               "Only applicable if there is a single benchmark server.");
@@ -83,7 +95,8 @@ static std::unique_ptr<ScenarioResult> RunAndReport(const Scenario& scenario,
                   scenario.server_config(), scenario.num_servers(),
                   scenario.warmup_seconds(), scenario.benchmark_seconds(),
                   scenario.spawn_local_worker_count(),
-                  FLAGS_qps_server_target_override.c_str());
+                  FLAGS_qps_server_target_override.c_str(),
+                  FLAGS_sweep_params != "");
 
   // Amend the result with scenario config. Eventually we should adjust
   // RunScenario contract so we don't need to touch the result here.
@@ -161,6 +174,105 @@ static double SearchOfferedLoad(double initial_offered_load,
   return targeted_offered_load;
 }
 
+static void SetSweepParam(Scenario* scenario, const grpc::string& param,
+                          int value) {
+  if (param == "client_channels") {
+    scenario->mutable_client_config()->set_client_channels(value);
+  } else if (param == "outstanding_rpcs_per_channel") {
+    scenario->mutable_client_config()->set_outstanding_rpcs_per_channel(value);
+  } else if (param == "async_client_threads") {
+    scenario->mutable_client_config()->set_async_client_threads(value);
+  } else if (param == "async_server_threads") {
+    scenario->mutable_server_config()->set_async_server_threads(value);
+  } else {
+    gpr_log(GPR_ERROR, "Unknown sweep param '%s'", param.c_str());
+    abort();
+  }
+}
+
+static std::vector<std::pair<grpc::string, std::vector<int>>> ParseSweepParams(
+    const grpc::string& spec) {
+  std::vector<std::pair<grpc::string, std::vector<int>>> params;
+  size_t start = 0;
+  while (start < spec.length()) {
+    size_t comma = spec.find(',', start);
+    if (comma == grpc::string::npos) comma = spec.length();
+    grpc::string entry = spec.substr(start, comma - start);
+    start = comma + 1;
+    size_t eq = entry.find('=');
+    if (eq == grpc::string::npos || eq + 1 == entry.length()) {
+      gpr_log(GPR_ERROR, "Bad sweep entry '%s'; expected param=v1:v2:...",
+              entry.c_str());
+      abort();
+    }
+    std::pair<grpc::string, std::vector<int>> param;
+    param.first = entry.substr(0, eq);
+    size_t vstart = eq + 1;
+    while (vstart < entry.length()) {
+      size_t colon = entry.find(':', vstart);
+      if (colon == grpc::string::npos) colon = entry.length();
+      param.second.push_back(std::stoi(entry.substr(vstart, colon - vstart)));
+      vstart = colon + 1;
+    }
+    params.push_back(param);
+  }
+  return params;
+}
+
+static void SweepScenario(const Scenario& base_scenario, bool* success) {
+  auto params = ParseSweepParams(FLAGS_sweep_params);
+  GPR_ASSERT(params.size() > 0);
+  struct SweepPoint {
+    grpc::string name;
+    double qps;
+    double qps_per_server_core;
+    double latency_50;
+    double latency_99;
+  };
+  std::vector<SweepPoint> points;
+  // Walk the cross product of the requested values, odometer-style: the
+  // first listed param varies fastest.
+  std::vector<size_t> idx(params.size(), 0);
+  for (;;) {
+    Scenario scenario = base_scenario;
+    grpc::string name = base_scenario.name();
+    for (size_t p = 0; p < params.size(); p++) {
+      int value = params[p].second[idx[p]];
+      SetSweepParam(&scenario, params[p].first, value);
+      name += "_" + params[p].first + "_" + std::to_string(value);
+    }
+    scenario.set_name(name);
+    auto result = RunAndReport(scenario, success);
+    SweepPoint point;
+    point.name = name;
+    point.qps = result->summary().qps();
+    point.qps_per_server_core = result->summary().qps_per_server_core();
+    point.latency_50 = result->summary().latency_50();
+    point.latency_99 = result->summary().latency_99();
+    points.push_back(point);
+    if (!*success) {
+      gpr_log(GPR_ERROR, "Sweep aborted after failing point %s", name.c_str());
+      break;
+    }
+    size_t p = 0;
+    while (p < params.size() && ++idx[p] == params[p].second.size()) {
+      idx[p++] = 0;
+    }
+    if (p == params.size()) break;
+  }
+  // One consolidated throughput/latency vs. scale table, so scaling knees
+  // are visible without grepping per-point reports out of the log.
+  gpr_log(GPR_INFO, "Sweep results for '%s' (%zu points):",
+          base_scenario.name().c_str(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    gpr_log(GPR_INFO,
+            "  %s: qps %.1f, qps/server core %.1f, p50 %.1f us, p99 %.1f us",
+            points[i].name.c_str(), points[i].qps,
+            points[i].qps_per_server_core, points[i].latency_50 / 1000.0,
+            points[i].latency_99 / 1000.0);
+  }
+}
+
 static bool QpsDriver() {
   grpc::string json;
 
@@ -173,6 +285,11 @@ static bool QpsDriver() {
             "or --quit must be set");
     abort();
   }
+  if (FLAGS_sweep_params != "" && FLAGS_search_param != "") {
+    gpr_log(GPR_ERROR,
+            "--sweep_params and --search_param cannot be combined");
+    abort();
+  }
 
   if (scfile) {
     // Read the json data from disk
@@ -203,7 +320,11 @@ static bool QpsDriver() {
   for (int i = 0; i < scenarios.scenarios_size(); i++) {
     if (FLAGS_search_param == "") {
       const Scenario& scenario = scenarios.scenarios(i);
-      RunAndReport(scenario, &success);
+      if (FLAGS_sweep_params == "") {
+        RunAndReport(scenario, &success);
+      } else {
+        SweepScenario(scenario, &success);
+      }
     } else {
       if (FLAGS_search_param == "offered_load") {
         Scenario* scenario = scenarios.mutable_scenarios(i);
@@ -246,25 +246,28 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
             request_method,
         std::function<grpc::Status(const RequestType *, ResponseType *)>
             invoke_method)
-        : srv_ctx_(new ServerContextType),
-          next_state_(&ServerRpcContextUnaryImpl::invoker),
+        : next_state_(&ServerRpcContextUnaryImpl::invoker),
           request_method_(request_method),
           invoke_method_(invoke_method),
-          response_writer_(srv_ctx_.get()) {
-      request_method_(srv_ctx_.get(), &req_, &response_writer_,
+          response_writer_(&srv_ctx_) {
+      request_method_(&srv_ctx_, &req_, &response_writer_,
                       AsyncQpsServerTest::tag(this));
     }
     ~ServerRpcContextUnaryImpl() override {}
     bool RunNextState(bool ok) override { return (this->*next_state_)(ok); }
     void Reset() override {
-      srv_ctx_.reset(new ServerContextType);
-      req_ = RequestType();
+      // Reconstruct the server context in place and clear (rather than
+      // reassign) the request so that recycling a context performs no
+      // allocation in steady state
+      srv_ctx_.~ServerContextType();
+      new (&srv_ctx_) ServerContextType;
+      req_.Clear();
       response_writer_ =
-          grpc::ServerAsyncResponseWriter<ResponseType>(srv_ctx_.get());
+          grpc::ServerAsyncResponseWriter<ResponseType>(&srv_ctx_);
 
       // Then request the method
       next_state_ = &ServerRpcContextUnaryImpl::invoker;
-      request_method_(srv_ctx_.get(), &req_, &response_writer_,
+      request_method_(&srv_ctx_, &req_, &response_writer_,
                       AsyncQpsServerTest::tag(this));
     }
 
@@ -283,7 +286,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
       response_writer_.Finish(response_, status, AsyncQpsServerTest::tag(this));
       return true;
     }
-    std::unique_ptr<ServerContextType> srv_ctx_;
+    ServerContextType srv_ctx_;
     RequestType req_;
     ResponseType response_;
     bool (ServerRpcContextUnaryImpl::*next_state_)(bool);
@@ -304,24 +307,24 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
             request_method,
         std::function<grpc::Status(const RequestType *, ResponseType *)>
             invoke_method)
-        : srv_ctx_(new ServerContextType),
-          next_state_(&ServerRpcContextStreamingImpl::request_done),
+        : next_state_(&ServerRpcContextStreamingImpl::request_done),
           request_method_(request_method),
           invoke_method_(invoke_method),
-          stream_(srv_ctx_.get()) {
-      request_method_(srv_ctx_.get(), &stream_, AsyncQpsServerTest::tag(this));
+          stream_(&srv_ctx_) {
+      request_method_(&srv_ctx_, &stream_, AsyncQpsServerTest::tag(this));
     }
     ~ServerRpcContextStreamingImpl() override {}
     bool RunNextState(bool ok) override { return (this->*next_state_)(ok); }
     void Reset() override {
-      srv_ctx_.reset(new ServerContextType);
-      req_ = RequestType();
-      stream_ = grpc::ServerAsyncReaderWriter<ResponseType, RequestType>(
-          srv_ctx_.get());
+      srv_ctx_.~ServerContextType();
+      new (&srv_ctx_) ServerContextType;
+      req_.Clear();
+      stream_ =
+          grpc::ServerAsyncReaderWriter<ResponseType, RequestType>(&srv_ctx_);
 
       // Then request the method
       next_state_ = &ServerRpcContextStreamingImpl::request_done;
-      request_method_(srv_ctx_.get(), &stream_, AsyncQpsServerTest::tag(this));
+      request_method_(&srv_ctx_, &stream_, AsyncQpsServerTest::tag(this));
     }
 
    private:
@@ -362,7 +365,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     }
     bool finish_done(bool ok) { return false; /* reset the context */ }
 
-    std::unique_ptr<ServerContextType> srv_ctx_;
+    ServerContextType srv_ctx_;
     RequestType req_;
     ResponseType response_;
     bool (ServerRpcContextStreamingImpl::*next_state_)(bool);
@@ -385,24 +388,23 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
             request_method,
         std::function<grpc::Status(const RequestType *, ResponseType *)>
             invoke_method)
-        : srv_ctx_(new ServerContextType),
-          next_state_(&ServerRpcContextStreamingFromClientImpl::request_done),
+        : next_state_(&ServerRpcContextStreamingFromClientImpl::request_done),
           request_method_(request_method),
           invoke_method_(invoke_method),
-          stream_(srv_ctx_.get()) {
-      request_method_(srv_ctx_.get(), &stream_, AsyncQpsServerTest::tag(this));
+          stream_(&srv_ctx_) {
+      request_method_(&srv_ctx_, &stream_, AsyncQpsServerTest::tag(this));
     }
     ~ServerRpcContextStreamingFromClientImpl() override {}
     bool RunNextState(bool ok) override { return (this->*next_state_)(ok); }
     void Reset() override {
-      srv_ctx_.reset(new ServerContextType);
-      req_ = RequestType();
-      stream_ =
-          grpc::ServerAsyncReader<ResponseType, RequestType>(srv_ctx_.get());
+      srv_ctx_.~ServerContextType();
+      new (&srv_ctx_) ServerContextType;
+      req_.Clear();
+      stream_ = grpc::ServerAsyncReader<ResponseType, RequestType>(&srv_ctx_);
 
       // Then request the method
       next_state_ = &ServerRpcContextStreamingFromClientImpl::request_done;
-      request_method_(srv_ctx_.get(), &stream_, AsyncQpsServerTest::tag(this));
+      request_method_(&srv_ctx_, &stream_, AsyncQpsServerTest::tag(this));
     }
 
    private:
@@ -433,7 +435,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     }
     bool finish_done(bool ok) { return false; /* reset the context */ }
 
-    std::unique_ptr<ServerContextType> srv_ctx_;
+    ServerContextType srv_ctx_;
     RequestType req_;
     ResponseType response_;
     bool (ServerRpcContextStreamingFromClientImpl::*next_state_)(bool);
@@ -455,24 +457,24 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
             request_method,
         std::function<grpc::Status(const RequestType *, ResponseType *)>
             invoke_method)
-        : srv_ctx_(new ServerContextType),
-          next_state_(&ServerRpcContextStreamingFromServerImpl::request_done),
+        : next_state_(&ServerRpcContextStreamingFromServerImpl::request_done),
           request_method_(request_method),
           invoke_method_(invoke_method),
-          stream_(srv_ctx_.get()) {
-      request_method_(srv_ctx_.get(), &req_, &stream_,
+          stream_(&srv_ctx_) {
+      request_method_(&srv_ctx_, &req_, &stream_,
                       AsyncQpsServerTest::tag(this));
     }
     ~ServerRpcContextStreamingFromServerImpl() override {}
     bool RunNextState(bool ok) override { return (this->*next_state_)(ok); }
     void Reset() override {
-      srv_ctx_.reset(new ServerContextType);
-      req_ = RequestType();
-      stream_ = grpc::ServerAsyncWriter<ResponseType>(srv_ctx_.get());
+      srv_ctx_.~ServerContextType();
+      new (&srv_ctx_) ServerContextType;
+      req_.Clear();
+      stream_ = grpc::ServerAsyncWriter<ResponseType>(&srv_ctx_);
 
       // Then request the method
       next_state_ = &ServerRpcContextStreamingFromServerImpl::request_done;
-      request_method_(srv_ctx_.get(), &req_, &stream_,
+      request_method_(&srv_ctx_, &req_, &stream_,
                       AsyncQpsServerTest::tag(this));
     }
 
@@ -503,7 +505,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     }
     bool finish_done(bool ok) { return false; /* reset the context */ }
 
-    std::unique_ptr<ServerContextType> srv_ctx_;
+    ServerContextType srv_ctx_;
     RequestType req_;
     ResponseType response_;
     bool (ServerRpcContextStreamingFromServerImpl::*next_state_)(bool);
@@ -47,7 +47,7 @@ namespace grpc {
 class ThreadManagerTest final : public grpc::ThreadManager {
  public:
   ThreadManagerTest()
-      : ThreadManager(kMinPollers, kMaxPollers),
+      : ThreadManager(kMinPollers, kMaxPollers, kMaxThreads),
         num_do_work_(0),
         num_poll_for_work_(0),
         num_work_found_(0) {}
@@ -61,6 +61,7 @@ class ThreadManagerTest final : public grpc::ThreadManager {
 
   static const int kMinPollers = 2;
   static const int kMaxPollers = 10;
+  static const int kMaxThreads = -1;  // no limit
 
   static const int kPollingTimeoutMsec = 10;
   static const int kDoWorkDurationMsec = 1;
@@ -349,6 +349,7 @@ print >> H
 print >> C, '#include "src/core/lib/transport/static_metadata.h"'
 print >> C
 print >> C, '#include "src/core/lib/slice/slice_internal.h"'
+print >> C, '#include "src/core/lib/support/murmur_hash.h"'
 print >> C
 
 str_ofs = 0
@@ -527,6 +528,85 @@ print >> C, '  return h < GPR_ARRAY_SIZE(elem_keys) && elem_keys[h] == k ? GRPC_
 print >> C, '}'
 print >> C
 
+
+# gpr_murmur_hash3, bit-for-bit, so the static slice keys below agree with the
+# runtime hash computed in grpc_static_slice_table_lookup
+def murmur3_32(data, seed):
+
+  def fmix(h):
+    h ^= h >> 16
+    h = (h * 0x85ebca6b) & 0xffffffff
+    h ^= h >> 13
+    h = (h * 0xc2b2ae35) & 0xffffffff
+    h ^= h >> 16
+    return h
+
+  def rotl(x, r):
+    return ((x << r) | (x >> (32 - r))) & 0xffffffff
+
+  data = bytearray(data)
+  h = seed
+  nblocks = len(data) / 4
+  for i in range(nblocks):
+    k = (data[4 * i] | (data[4 * i + 1] << 8) | (data[4 * i + 2] << 16) |
+         (data[4 * i + 3] << 24))
+    k = (k * 0xcc9e2d51) & 0xffffffff
+    k = rotl(k, 15)
+    k = (k * 0x1b873593) & 0xffffffff
+    h ^= k
+    h = rotl(h, 13)
+    h = (h * 5 + 0xe6546b64) & 0xffffffff
+  tail = data[4 * nblocks:]
+  k = 0
+  if len(tail) == 3:
+    k ^= tail[2] << 16
+  if len(tail) >= 2:
+    k ^= tail[1] << 8
+  if len(tail) >= 1:
+    k ^= tail[0]
+    k = (k * 0xcc9e2d51) & 0xffffffff
+    k = rotl(k, 15)
+    k = (k * 0x1b873593) & 0xffffffff
+    h ^= k
+  h ^= len(data)
+  return fmix(h)
+
+
+# reduce each static slice to a small key via a fixed-seed murmur hash; pick
+# the first seed that keeps the masked keys distinct, then perfect-hash them
+STR_HASH_MASK = 0xfff
+str_hash_seed = 0
+while True:
+  str_keys = [murmur3_32(s, str_hash_seed) & STR_HASH_MASK for s in all_strs]
+  if len(set(str_keys)) == len(str_keys) and 0 not in str_keys:
+    break
+  str_hash_seed += 1
+
+str_hash = perfect_hash(str_keys, 'strs')
+print >> C, str_hash['code']
+
+keys = [0] * int(str_hash['PHASHRANGE'])
+idxs = [255] * int(str_hash['PHASHRANGE'])
+for i, k in enumerate(str_keys):
+  h = str_hash['pyfunc'](k)
+  assert keys[h] == 0
+  keys[h] = k
+  idxs[h] = i
+print >> C, 'static const uint16_t strs_keys[] = {%s};' % ','.join(
+    '%d' % k for k in keys)
+print >> C, 'static const uint8_t strs_idxs[] = {%s};' % ','.join(
+    '%d' % i for i in idxs)
+print >> C
+
+print >> H, 'int grpc_static_slice_table_lookup(grpc_slice slice);'
+print >> C, 'int grpc_static_slice_table_lookup(grpc_slice slice) {'
+print >> C, '  uint32_t k = gpr_murmur_hash3(GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice), %d) & 0x%x;' % (
+    str_hash_seed, STR_HASH_MASK)
+print >> C, '  uint32_t h = strs_phash(k);'
+print >> C, '  return h < GPR_ARRAY_SIZE(strs_keys) && strs_keys[h] == k && strs_idxs[h] != 255 && grpc_slice_eq(grpc_static_slice_table[strs_idxs[h]], slice) ? (int)strs_idxs[h] : -1;'
+print >> C, '}'
+print >> C
+
 print >> C, 'grpc_mdelem_data grpc_static_mdelem_table[GRPC_STATIC_MDELEM_COUNT] = {'
 for a, b in all_elems:
   print >> C, '{%s,%s},' % (slice_def(str_idx(a)), slice_def(str_idx(b)))